@@ -1,13 +1,38 @@
 using System;
 using System.Linq;
+using System.Text;
 
 namespace FastEmbed
 {
+    /// <summary>
+    /// Scoring function for <see cref="FastEmbedClient.SimilarityMatrix(float[], float[], SimilarityMetric, int)"/> (matches fastembed_metric_t)
+    /// </summary>
+    public enum SimilarityMetric
+    {
+        /// <summary>Raw dot product</summary>
+        Dot = 0,
+        /// <summary>Cosine similarity</summary>
+        Cosine = 1,
+        /// <summary>Euclidean (L2) distance</summary>
+        Euclidean = 2
+    }
+
+    /// <summary>
+    /// Half-precision storage format for <see cref="FastEmbedClient.ToHalf"/> (matches fastembed_quantization_t)
+    /// </summary>
+    public enum HalfFormat
+    {
+        /// <summary>IEEE 754 half precision</summary>
+        Fp16 = 3,
+        /// <summary>bfloat16 (upper 16 bits of a float)</summary>
+        Bf16 = 4
+    }
+
     /// <summary>
     /// High-level C# wrapper for FastEmbed native library
     /// Provides type-safe, idiomatic C# API for embedding generation
     /// </summary>
-    public class FastEmbedClient
+    public unsafe class FastEmbedClient
     {
         private readonly int _dimension;
 
@@ -28,6 +53,11 @@ namespace FastEmbed
         /// </summary>
         public int Dimension => _dimension;
 
+        /// <summary>
+        /// Gets the packed size of one binary-quantized vector (ceil(Dimension / 8))
+        /// </summary>
+        public int BinaryBytes => (_dimension + 7) / 8;
+
         /// <summary>
         /// Generate hash-based embedding for text
         /// </summary>
@@ -116,6 +146,432 @@ namespace FastEmbed
             return result;
         }
 
+        /// <summary>
+        /// Score every query against every corpus vector in one native call
+        /// </summary>
+        /// <param name="queries">Row-major queries, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="corpus">Row-major corpus, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="metric">Scoring function</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Row-major [numQueries x numCorpus] scores</returns>
+        /// <exception cref="ArgumentException">If a matrix is empty or not a multiple of the dimension</exception>
+        /// <exception cref="FastEmbedException">If scoring fails</exception>
+        public float[] SimilarityMatrix(float[] queries, float[] corpus,
+            SimilarityMetric metric = SimilarityMetric.Cosine, int threads = 1)
+        {
+            int numQueries = ValidateMatrix(queries, nameof(queries));
+            int numCorpus = ValidateMatrix(corpus, nameof(corpus));
+
+            var output = new float[(long)numQueries * numCorpus];
+            int result = FastEmbedNative.fastembed_similarity_matrix_threaded(
+                queries, numQueries, corpus, numCorpus, _dimension, output, (int)metric, threads);
+
+            if (result != 0)
+                throw new FastEmbedException($"Failed to compute similarity matrix (error code: {result})");
+
+            return output;
+        }
+
+        /// <summary>
+        /// Find the k corpus vectors most similar to a query (exact search)
+        /// </summary>
+        /// <param name="query">Query vector of <see cref="Dimension"/> floats</param>
+        /// <param name="corpus">Row-major corpus, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="k">Number of results (fewer if the corpus is smaller)</param>
+        /// <param name="metric">Scoring function (Euclidean returns the nearest vectors)</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Row indices and scores, best first</returns>
+        /// <exception cref="ArgumentException">If the query or corpus is invalid or k is not positive</exception>
+        /// <exception cref="FastEmbedException">If the search fails</exception>
+        public (int[] Ids, float[] Scores) TopK(float[] query, float[] corpus, int k,
+            SimilarityMetric metric = SimilarityMetric.Cosine, int threads = 1)
+        {
+            ValidateVector(query);
+            int numCorpus = ValidateMatrix(corpus, nameof(corpus));
+            if (k <= 0)
+                throw new ArgumentException("k must be positive", nameof(k));
+
+            int capacity = Math.Min(k, numCorpus);
+            var ids = new int[capacity];
+            var scores = new float[capacity];
+            int count = FastEmbedNative.fastembed_topk_threaded(
+                query, corpus, numCorpus, _dimension, capacity, ids, scores, (int)metric, threads);
+
+            if (count < 0)
+                throw new FastEmbedException($"Failed to compute top-k (error code: {count})");
+
+            return (ids, scores);
+        }
+
+        /// <summary>
+        /// Calculate cosine similarity between two vectors without copying them
+        /// </summary>
+        /// <param name="vectorA">First vector of <see cref="Dimension"/> floats</param>
+        /// <param name="vectorB">Second vector of <see cref="Dimension"/> floats</param>
+        /// <returns>Cosine similarity in range [-1, 1]</returns>
+        /// <exception cref="ArgumentException">If vector dimensions don't match</exception>
+        public float CosineSimilarity(ReadOnlySpan<float> vectorA, ReadOnlySpan<float> vectorB)
+        {
+            ValidateSpan(vectorA.Length, nameof(vectorA));
+            ValidateSpan(vectorB.Length, nameof(vectorB));
+            fixed (float* a = vectorA)
+            fixed (float* b = vectorB)
+                return FastEmbedNative.fastembed_cosine_similarity(a, b, _dimension);
+        }
+
+        /// <summary>
+        /// Calculate dot product of two vectors without copying them
+        /// </summary>
+        /// <param name="vectorA">First vector of <see cref="Dimension"/> floats</param>
+        /// <param name="vectorB">Second vector of <see cref="Dimension"/> floats</param>
+        /// <returns>Dot product</returns>
+        /// <exception cref="ArgumentException">If vector dimensions don't match</exception>
+        public float DotProduct(ReadOnlySpan<float> vectorA, ReadOnlySpan<float> vectorB)
+        {
+            ValidateSpan(vectorA.Length, nameof(vectorA));
+            ValidateSpan(vectorB.Length, nameof(vectorB));
+            fixed (float* a = vectorA)
+            fixed (float* b = vectorB)
+                return FastEmbedNative.fastembed_dot_product(a, b, _dimension);
+        }
+
+        /// <summary>
+        /// Calculate L2 norm of a vector without copying it
+        /// </summary>
+        /// <param name="vector">Vector of <see cref="Dimension"/> floats</param>
+        /// <returns>L2 norm</returns>
+        /// <exception cref="ArgumentException">If vector dimension doesn't match</exception>
+        public float VectorNorm(ReadOnlySpan<float> vector)
+        {
+            ValidateSpan(vector.Length, nameof(vector));
+            fixed (float* v = vector)
+                return FastEmbedNative.fastembed_vector_norm(v, _dimension);
+        }
+
+        /// <summary>
+        /// L2-normalize a vector in place
+        /// </summary>
+        /// <param name="vector">Vector of <see cref="Dimension"/> floats (overwritten)</param>
+        /// <exception cref="ArgumentException">If vector dimension doesn't match</exception>
+        public void NormalizeInPlace(Span<float> vector)
+        {
+            ValidateSpan(vector.Length, nameof(vector));
+            fixed (float* v = vector)
+                FastEmbedNative.fastembed_normalize(v, _dimension);
+        }
+
+        /// <summary>
+        /// Score every query against every corpus vector into a caller-owned buffer
+        /// </summary>
+        /// <param name="queries">Row-major queries, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="corpus">Row-major corpus, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="output">Receives row-major [numQueries x numCorpus] scores</param>
+        /// <param name="metric">Scoring function</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <exception cref="ArgumentException">If a matrix is invalid or output is too small</exception>
+        /// <exception cref="FastEmbedException">If scoring fails</exception>
+        public void SimilarityMatrix(ReadOnlySpan<float> queries, ReadOnlySpan<float> corpus, Span<float> output,
+            SimilarityMetric metric = SimilarityMetric.Cosine, int threads = 1)
+        {
+            int numQueries = ValidateMatrix(queries.Length, nameof(queries));
+            int numCorpus = ValidateMatrix(corpus.Length, nameof(corpus));
+            if (output.Length < (long)numQueries * numCorpus)
+                throw new ArgumentException($"Output must hold {(long)numQueries * numCorpus} scores",
+                    nameof(output));
+
+            int result;
+            fixed (float* q = queries)
+            fixed (float* c = corpus)
+            fixed (float* o = output)
+                result = FastEmbedNative.fastembed_similarity_matrix_threaded(
+                    q, numQueries, c, numCorpus, _dimension, o, (int)metric, threads);
+
+            if (result != 0)
+                throw new FastEmbedException($"Failed to compute similarity matrix (error code: {result})");
+        }
+
+        /// <summary>
+        /// Find the corpus vectors most similar to a query into caller-owned buffers,
+        /// scoring the whole corpus in one native call
+        /// </summary>
+        /// <param name="query">Query vector of <see cref="Dimension"/> floats</param>
+        /// <param name="corpus">Row-major corpus, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="ids">Receives row indices, best first; its length is k</param>
+        /// <param name="scores">Receives scores (at least as long as ids)</param>
+        /// <param name="metric">Scoring function (Euclidean returns the nearest vectors)</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Number of results written (fewer than k if the corpus is smaller)</returns>
+        /// <exception cref="ArgumentException">If the query, corpus or buffers are invalid</exception>
+        /// <exception cref="FastEmbedException">If the search fails</exception>
+        public int TopK(ReadOnlySpan<float> query, ReadOnlySpan<float> corpus, Span<int> ids, Span<float> scores,
+            SimilarityMetric metric = SimilarityMetric.Cosine, int threads = 1)
+        {
+            ValidateSpan(query.Length, nameof(query));
+            int numCorpus = ValidateMatrix(corpus.Length, nameof(corpus));
+            if (ids.Length == 0)
+                throw new ArgumentException("ids cannot be empty", nameof(ids));
+            if (scores.Length < ids.Length)
+                throw new ArgumentException("scores must be at least as long as ids", nameof(scores));
+
+            int count;
+            fixed (float* q = query)
+            fixed (float* c = corpus)
+            fixed (int* i = ids)
+            fixed (float* s = scores)
+                count = FastEmbedNative.fastembed_topk_threaded(
+                    q, c, numCorpus, _dimension, ids.Length, i, s, (int)metric, threads);
+
+            if (count < 0)
+                throw new FastEmbedException($"Failed to compute top-k (error code: {count})");
+
+            return count;
+        }
+
+        /// <summary>
+        /// Quantize vectors to int8 with one scale per vector (x ~ code * scale)
+        /// </summary>
+        /// <param name="vectors">Row-major vectors, a multiple of <see cref="Dimension"/> floats</param>
+        /// <returns>Row-major codes in [-127, 127] and one scale per vector</returns>
+        /// <exception cref="ArgumentException">If vectors is empty or not a multiple of the dimension</exception>
+        /// <exception cref="FastEmbedException">If quantization fails</exception>
+        public (sbyte[] Codes, float[] Scales) QuantizeInt8(float[] vectors)
+        {
+            int numVectors = ValidateMatrix(vectors, nameof(vectors));
+
+            var codes = new sbyte[vectors.Length];
+            var scales = new float[numVectors];
+            int result = FastEmbedNative.fastembed_quantize_int8(vectors, numVectors, _dimension, codes, scales);
+
+            if (result != 0)
+                throw new FastEmbedException($"Failed to quantize vectors (error code: {result})");
+
+            return (codes, scales);
+        }
+
+        /// <summary>
+        /// Binarize vectors to packed sign bits (<see cref="BinaryBytes"/> per vector)
+        /// </summary>
+        /// <param name="vectors">Row-major vectors, a multiple of <see cref="Dimension"/> floats</param>
+        /// <returns>Row-major packed bits</returns>
+        /// <exception cref="ArgumentException">If vectors is empty or not a multiple of the dimension</exception>
+        /// <exception cref="FastEmbedException">If binarization fails</exception>
+        public byte[] QuantizeBinary(float[] vectors)
+        {
+            int numVectors = ValidateMatrix(vectors, nameof(vectors));
+
+            var bits = new byte[numVectors * BinaryBytes];
+            int result = FastEmbedNative.fastembed_quantize_binary(vectors, numVectors, _dimension, bits);
+
+            if (result != 0)
+                throw new FastEmbedException($"Failed to binarize vectors (error code: {result})");
+
+            return bits;
+        }
+
+        /// <summary>
+        /// Find the k int8-quantized corpus rows with the highest dot product
+        /// </summary>
+        /// <param name="queryCodes">Query codes from <see cref="QuantizeInt8"/></param>
+        /// <param name="queryScale">Query scale</param>
+        /// <param name="corpusCodes">Row-major corpus codes</param>
+        /// <param name="corpusScales">One scale per corpus row</param>
+        /// <param name="k">Number of results (fewer if the corpus is smaller)</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Row indices and approximate dot products, best first</returns>
+        /// <exception cref="ArgumentException">If the codes or scales are inconsistent or k is not positive</exception>
+        /// <exception cref="FastEmbedException">If the search fails</exception>
+        public (int[] Ids, float[] Scores) TopKInt8(sbyte[] queryCodes, float queryScale,
+            sbyte[] corpusCodes, float[] corpusScales, int k, int threads = 1)
+        {
+            if (queryCodes == null)
+                throw new ArgumentNullException(nameof(queryCodes));
+            if (corpusCodes == null)
+                throw new ArgumentNullException(nameof(corpusCodes));
+            if (corpusScales == null)
+                throw new ArgumentNullException(nameof(corpusScales));
+            if (queryCodes.Length != _dimension)
+                throw new ArgumentException($"Length must be {_dimension}", nameof(queryCodes));
+            if (corpusScales.Length == 0 || corpusCodes.Length != (long)corpusScales.Length * _dimension)
+                throw new ArgumentException("Need one scale per corpus row", nameof(corpusScales));
+            if (k <= 0)
+                throw new ArgumentException("k must be positive", nameof(k));
+
+            int numCorpus = corpusScales.Length;
+            int capacity = Math.Min(k, numCorpus);
+            var ids = new int[capacity];
+            var scores = new float[capacity];
+            int count = FastEmbedNative.fastembed_topk_int8(
+                queryCodes, queryScale, corpusCodes, corpusScales, numCorpus, _dimension,
+                capacity, ids, scores, threads);
+
+            if (count < 0)
+                throw new FastEmbedException($"Failed to compute int8 top-k (error code: {count})");
+
+            return (ids, scores);
+        }
+
+        /// <summary>
+        /// Find the k binary-quantized corpus rows nearest in Hamming distance
+        /// </summary>
+        /// <param name="queryBits">Query bits from <see cref="QuantizeBinary"/></param>
+        /// <param name="corpusBits">Row-major corpus bits, a multiple of <see cref="BinaryBytes"/></param>
+        /// <param name="k">Number of results (fewer if the corpus is smaller)</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Row indices and Hamming distances, nearest first</returns>
+        /// <exception cref="ArgumentException">If the bits have the wrong size or k is not positive</exception>
+        /// <exception cref="FastEmbedException">If the search fails</exception>
+        public (int[] Ids, int[] Distances) TopKBinary(byte[] queryBits, byte[] corpusBits, int k,
+            int threads = 1)
+        {
+            if (queryBits == null)
+                throw new ArgumentNullException(nameof(queryBits));
+            if (corpusBits == null)
+                throw new ArgumentNullException(nameof(corpusBits));
+            if (queryBits.Length != BinaryBytes)
+                throw new ArgumentException($"Length must be {BinaryBytes}", nameof(queryBits));
+            if (corpusBits.Length == 0 || corpusBits.Length % BinaryBytes != 0)
+                throw new ArgumentException($"Length must be a non-zero multiple of {BinaryBytes}",
+                    nameof(corpusBits));
+            if (k <= 0)
+                throw new ArgumentException("k must be positive", nameof(k));
+
+            int numCorpus = corpusBits.Length / BinaryBytes;
+            int capacity = Math.Min(k, numCorpus);
+            var ids = new int[capacity];
+            var distances = new int[capacity];
+            int count = FastEmbedNative.fastembed_topk_binary(
+                queryBits, corpusBits, numCorpus, _dimension, capacity, ids, distances, threads);
+
+            if (count < 0)
+                throw new FastEmbedException($"Failed to compute binary top-k (error code: {count})");
+
+            return (ids, distances);
+        }
+
+        /// <summary>
+        /// Rerank a shortlist of corpus rows (e.g. from <see cref="TopKBinary"/>) with exact float scores
+        /// </summary>
+        /// <param name="query">Query vector of <see cref="Dimension"/> floats</param>
+        /// <param name="corpus">Row-major corpus, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="candidates">Distinct corpus row indices</param>
+        /// <param name="k">Number of results (fewer if there are fewer candidates)</param>
+        /// <param name="metric">Scoring function (Euclidean returns the nearest vectors)</param>
+        /// <returns>Row indices and scores, best first</returns>
+        /// <exception cref="ArgumentException">If an input is invalid or k is not positive</exception>
+        /// <exception cref="FastEmbedException">If a candidate is not a corpus row</exception>
+        public (int[] Ids, float[] Scores) Rescore(float[] query, float[] corpus, int[] candidates, int k,
+            SimilarityMetric metric = SimilarityMetric.Cosine)
+        {
+            ValidateVector(query);
+            int numCorpus = ValidateMatrix(corpus, nameof(corpus));
+            if (candidates == null)
+                throw new ArgumentNullException(nameof(candidates));
+            if (candidates.Length == 0)
+                throw new ArgumentException("Candidates cannot be empty", nameof(candidates));
+            if (k <= 0)
+                throw new ArgumentException("k must be positive", nameof(k));
+
+            int capacity = Math.Min(k, candidates.Length);
+            var ids = new int[capacity];
+            var scores = new float[capacity];
+            int count = FastEmbedNative.fastembed_topk_rescore(
+                query, corpus, numCorpus, _dimension, candidates, candidates.Length, capacity, ids, scores,
+                (int)metric);
+
+            if (count < 0)
+                throw new FastEmbedException($"Failed to rescore candidates (error code: {count})");
+
+            return (ids, scores);
+        }
+
+        /// <summary>
+        /// Convert vectors to half precision (round to nearest even), halving their memory
+        /// </summary>
+        /// <param name="vectors">Row-major vectors, a multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="format">Storage format</param>
+        /// <returns>One 16-bit value per float</returns>
+        /// <exception cref="ArgumentException">If vectors is empty or not a multiple of the dimension</exception>
+        /// <exception cref="FastEmbedException">If the conversion fails</exception>
+        public ushort[] ToHalf(float[] vectors, HalfFormat format = HalfFormat.Fp16)
+        {
+            ValidateMatrix(vectors, nameof(vectors));
+
+            var halves = new ushort[vectors.Length];
+            int result = format == HalfFormat.Bf16
+                ? FastEmbedNative.fastembed_f32_to_bf16(vectors, halves, vectors.Length)
+                : FastEmbedNative.fastembed_f32_to_f16(vectors, halves, vectors.Length);
+
+            if (result != 0)
+                throw new FastEmbedException($"Failed to convert to half precision (error code: {result})");
+
+            return halves;
+        }
+
+        /// <summary>
+        /// Widen half-precision values from <see cref="ToHalf"/> back to floats (exact)
+        /// </summary>
+        /// <param name="halves">Half-precision values</param>
+        /// <param name="format">Format they were converted with</param>
+        /// <returns>Floats</returns>
+        /// <exception cref="ArgumentException">If halves is empty</exception>
+        /// <exception cref="FastEmbedException">If the conversion fails</exception>
+        public float[] FromHalf(ushort[] halves, HalfFormat format = HalfFormat.Fp16)
+        {
+            if (halves == null)
+                throw new ArgumentNullException(nameof(halves));
+            if (halves.Length == 0)
+                throw new ArgumentException("Halves cannot be empty", nameof(halves));
+
+            var floats = new float[halves.Length];
+            int result = format == HalfFormat.Bf16
+                ? FastEmbedNative.fastembed_bf16_to_f32(halves, floats, halves.Length)
+                : FastEmbedNative.fastembed_f16_to_f32(halves, floats, halves.Length);
+
+            if (result != 0)
+                throw new FastEmbedException($"Failed to convert from half precision (error code: {result})");
+
+            return floats;
+        }
+
+        /// <summary>
+        /// Find the k half-precision corpus vectors most similar to a query
+        /// (same results as <see cref="TopK(float[], float[], int, SimilarityMetric, int)"/> on the widened corpus)
+        /// </summary>
+        /// <param name="query">Query vector of <see cref="Dimension"/> floats</param>
+        /// <param name="corpus">Row-major corpus from <see cref="ToHalf"/></param>
+        /// <param name="format">Format the corpus was converted with</param>
+        /// <param name="k">Number of results (fewer if the corpus is smaller)</param>
+        /// <param name="metric">Scoring function (Euclidean returns the nearest vectors)</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Row indices and scores, best first</returns>
+        /// <exception cref="ArgumentException">If the query or corpus is invalid or k is not positive</exception>
+        /// <exception cref="FastEmbedException">If the search fails</exception>
+        public (int[] Ids, float[] Scores) TopKHalf(float[] query, ushort[] corpus, HalfFormat format, int k,
+            SimilarityMetric metric = SimilarityMetric.Cosine, int threads = 1)
+        {
+            ValidateVector(query);
+            if (corpus == null)
+                throw new ArgumentNullException(nameof(corpus));
+            if (corpus.Length == 0 || corpus.Length % _dimension != 0)
+                throw new ArgumentException(
+                    $"Matrix length {corpus.Length} is not a positive multiple of dimension {_dimension}",
+                    nameof(corpus));
+            if (k <= 0)
+                throw new ArgumentException("k must be positive", nameof(k));
+
+            int numCorpus = corpus.Length / _dimension;
+            int capacity = Math.Min(k, numCorpus);
+            var ids = new int[capacity];
+            var scores = new float[capacity];
+            int count = FastEmbedNative.fastembed_topk_half(
+                query, corpus, (int)format, numCorpus, _dimension, capacity, ids, scores, (int)metric, threads);
+
+            if (count < 0)
+                throw new FastEmbedException($"Failed to compute half-precision top-k (error code: {count})");
+
+            return (ids, scores);
+        }
+
         /// <summary>
         /// Calculate semantic similarity between two texts
         /// </summary>
@@ -142,6 +598,62 @@ namespace FastEmbed
             return texts.Select(GenerateEmbedding).ToArray();
         }
 
+        /// <summary>
+        /// Generate embeddings for concatenated UTF-8 texts into one matrix in a single native call
+        /// (text i is textData[offsets[i]..offsets[i + 1]], its embedding row i of output)
+        /// </summary>
+        /// <param name="textData">Concatenated UTF-8 texts</param>
+        /// <param name="offsets">numTexts + 1 non-decreasing byte offsets into textData</param>
+        /// <param name="output">Receives row-major [numTexts x Dimension] embeddings</param>
+        /// <param name="statuses">Receives a status code per text (empty = not reported)</param>
+        /// <param name="threads">Threads to use, including the caller (0 = whole pool)</param>
+        /// <returns>Number of texts that failed (their rows are zeroed)</returns>
+        /// <exception cref="ArgumentException">If the offsets or buffers are invalid</exception>
+        /// <exception cref="FastEmbedException">If the batch cannot run</exception>
+        public int GenerateEmbeddings(ReadOnlySpan<byte> textData, ReadOnlySpan<int> offsets, Span<float> output,
+            Span<int> statuses = default, int threads = 0)
+        {
+            int numTexts = TextBatch.Validate(textData, offsets, statuses);
+            if (output.Length < (long)numTexts * _dimension)
+                throw new ArgumentException($"Output must hold {(long)numTexts * _dimension} floats",
+                    nameof(output));
+
+            int failed;
+            fixed (byte* t = TextBatch.Pinnable(textData))
+            fixed (int* o = offsets)
+            fixed (float* e = output)
+            fixed (int* s = statuses)
+                failed = FastEmbedNative.fastembed_batch_generate_contiguous(
+                    t, o, numTexts, e, _dimension, s, threads);
+
+            if (failed < 0)
+                throw new FastEmbedException($"Failed to generate embeddings (error code: {failed})");
+
+            return failed;
+        }
+
+        /// <summary>
+        /// Generate embeddings for many texts on the native thread pool
+        /// </summary>
+        /// <param name="texts">Input texts</param>
+        /// <param name="threads">Threads to use, including the caller (0 = whole pool)</param>
+        /// <returns>Row-major [texts.Length x Dimension] embeddings</returns>
+        /// <exception cref="ArgumentNullException">If texts or a text is null</exception>
+        /// <exception cref="FastEmbedException">If any text fails</exception>
+        public float[] GenerateBatch(string[] texts, int threads = 0)
+        {
+            byte[] data = TextBatch.Pack(texts, out int[] offsets);
+            var output = new float[(long)texts.Length * _dimension];
+            if (texts.Length == 0)
+                return output;
+
+            int failed = GenerateEmbeddings(data, offsets, output, default, threads);
+            if (failed != 0)
+                throw new FastEmbedException($"Failed to generate {failed} of {texts.Length} embeddings");
+
+            return output;
+        }
+
         /// <summary>
         /// Generate ONNX-based embedding for text using ML model
         /// </summary>
@@ -185,11 +697,106 @@ namespace FastEmbed
                     nameof(vector));
         }
 
+        private int ValidateMatrix(float[] matrix, string paramName)
+        {
+            if (matrix == null)
+                throw new ArgumentNullException(paramName);
+            if (matrix.Length == 0 || matrix.Length % _dimension != 0)
+                throw new ArgumentException(
+                    $"Matrix length {matrix.Length} is not a positive multiple of dimension {_dimension}",
+                    paramName);
+            return matrix.Length / _dimension;
+        }
+
         private void ValidateVectors(float[] vectorA, float[] vectorB)
         {
             ValidateVector(vectorA);
             ValidateVector(vectorB);
         }
+
+        private void ValidateSpan(int length, string paramName)
+        {
+            if (length != _dimension)
+                throw new ArgumentException(
+                    $"Vector dimension mismatch: expected {_dimension}, got {length}", paramName);
+        }
+
+        private int ValidateMatrix(int length, string paramName)
+        {
+            if (length == 0 || length % _dimension != 0)
+                throw new ArgumentException(
+                    $"Matrix length {length} is not a positive multiple of dimension {_dimension}", paramName);
+            return length / _dimension;
+        }
+    }
+
+    /// <summary>
+    /// Packing and validation of the contiguous text layout shared by the batch methods
+    /// </summary>
+    internal static class TextBatch
+    {
+        private static readonly byte[] EmptyText = { 0 };
+
+        /// <summary>
+        /// textData, or a single NUL byte when it is empty: an empty span pins to a null
+        /// pointer, which the native batch functions reject even if every text is empty
+        /// </summary>
+        internal static ReadOnlySpan<byte> Pinnable(ReadOnlySpan<byte> textData) =>
+            textData.IsEmpty ? EmptyText : textData;
+
+        /// <summary>
+        /// Encode texts as concatenated UTF-8 with texts.Length + 1 byte offsets
+        /// </summary>
+        internal static byte[] Pack(string[] texts, out int[] offsets)
+        {
+            if (texts == null)
+                throw new ArgumentNullException(nameof(texts));
+
+            offsets = new int[texts.Length + 1];
+            long total = 0;
+            for (int i = 0; i < texts.Length; i++)
+            {
+                if (texts[i] == null)
+                    throw new ArgumentNullException(nameof(texts), $"Text {i} is null");
+                total += Encoding.UTF8.GetByteCount(texts[i]);
+                if (total > int.MaxValue)
+                    throw new ArgumentException("Packed texts exceed 2 GiB", nameof(texts));
+                offsets[i + 1] = (int)total;
+            }
+
+            var data = new byte[total];
+            for (int i = 0; i < texts.Length; i++)
+                Encoding.UTF8.GetBytes(texts[i], 0, texts[i].Length, data, offsets[i]);
+            return data;
+        }
+
+        /// <summary>
+        /// Check offsets against the text buffer (the native side cannot see its length)
+        /// </summary>
+        /// <returns>Number of texts</returns>
+        internal static int Validate(ReadOnlySpan<byte> textData, ReadOnlySpan<int> offsets, ReadOnlySpan<int> statuses)
+        {
+            if (offsets.Length < 2)
+                throw new ArgumentException("Need at least one text (two offsets)", nameof(offsets));
+
+            int previous = offsets[0];
+            if (previous < 0)
+                throw new ArgumentException("Offsets must be non-negative", nameof(offsets));
+            for (int i = 1; i < offsets.Length; i++)
+            {
+                if (offsets[i] < previous)
+                    throw new ArgumentException("Offsets must be non-decreasing", nameof(offsets));
+                previous = offsets[i];
+            }
+            if (previous > textData.Length)
+                throw new ArgumentException(
+                    $"Offsets reach byte {previous} past the {textData.Length} bytes of text data", nameof(offsets));
+
+            int numTexts = offsets.Length - 1;
+            if (!statuses.IsEmpty && statuses.Length < numTexts)
+                throw new ArgumentException($"Statuses must hold {numTexts} values", nameof(statuses));
+            return numTexts;
+        }
     }
 
     /// <summary>
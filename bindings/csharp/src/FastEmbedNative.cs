@@ -1,4 +1,5 @@
 using System;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.IO;
 
@@ -7,7 +8,13 @@ namespace FastEmbed
     /// <summary>
     /// Low-level P/Invoke declarations for FastEmbed native library
     /// </summary>
-    internal static class FastEmbedNative
+    /// <remarks>
+    /// Array overloads use the runtime marshaller. Pointer overloads are
+    /// source-generated (<see cref="LibraryImportAttribute"/>) blittable stubs
+    /// for callers that pin spans themselves; the short vector ops also skip
+    /// the GC transition.
+    /// </remarks>
+    internal static unsafe partial class FastEmbedNative
     {
         // Platform-specific library names
         private const string LibraryName = "fastembed_native";
@@ -159,6 +166,366 @@ namespace FastEmbed
             int dimension
         );
 
+        /// <summary>
+        /// Score every query row against every corpus row
+        /// </summary>
+        /// <param name="queries">Row-major [num_queries x dimension] matrix</param>
+        /// <param name="num_queries">Number of query rows</param>
+        /// <param name="corpus">Row-major [num_corpus x dimension] matrix</param>
+        /// <param name="num_corpus">Number of corpus rows</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="output">Row-major [num_queries x num_corpus] output</param>
+        /// <param name="metric">fastembed_metric_t</param>
+        /// <param name="num_threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_similarity_matrix_threaded(
+            [In] float[] queries,
+            int num_queries,
+            [In] float[] corpus,
+            int num_corpus,
+            int dimension,
+            [Out] float[] output,
+            int metric,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Find the k corpus rows most similar to a query
+        /// </summary>
+        /// <param name="query">Query vector</param>
+        /// <param name="corpus">Row-major [num_corpus x dimension] matrix</param>
+        /// <param name="num_corpus">Number of corpus rows</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="k">Number of results</param>
+        /// <param name="out_ids">Output row indices [k]</param>
+        /// <param name="out_scores">Output scores [k]</param>
+        /// <param name="metric">fastembed_metric_t</param>
+        /// <param name="num_threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Number of results written, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_topk_threaded(
+            [In] float[] query,
+            [In] float[] corpus,
+            int num_corpus,
+            int dimension,
+            int k,
+            [Out] int[] out_ids,
+            [Out] float[] out_scores,
+            int metric,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Quantize float vectors to int8 with one scale per vector
+        /// </summary>
+        /// <param name="vectors">Row-major [num_vectors x dimension] matrix</param>
+        /// <param name="num_vectors">Number of vectors</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="out_codes">Output codes [num_vectors x dimension]</param>
+        /// <param name="out_scales">Output scales [num_vectors]</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_quantize_int8(
+            [In] float[] vectors,
+            int num_vectors,
+            int dimension,
+            [Out] sbyte[] out_codes,
+            [Out] float[] out_scales
+        );
+
+        /// <summary>
+        /// Pack the sign bits of float vectors
+        /// </summary>
+        /// <param name="vectors">Row-major [num_vectors x dimension] matrix</param>
+        /// <param name="num_vectors">Number of vectors</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="out_bits">Output [num_vectors x ceil(dimension / 8)] bytes</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_quantize_binary(
+            [In] float[] vectors,
+            int num_vectors,
+            int dimension,
+            [Out] byte[] out_bits
+        );
+
+        /// <summary>
+        /// Find the k int8-quantized corpus rows with the highest dot product
+        /// </summary>
+        /// <param name="query_codes">Query codes [dimension]</param>
+        /// <param name="query_scale">Query scale</param>
+        /// <param name="corpus_codes">Row-major [num_corpus x dimension] codes</param>
+        /// <param name="corpus_scales">Corpus scales [num_corpus]</param>
+        /// <param name="num_corpus">Number of corpus rows</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="k">Number of results</param>
+        /// <param name="out_ids">Output row indices [k]</param>
+        /// <param name="out_scores">Output scores [k]</param>
+        /// <param name="num_threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Number of results written, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_topk_int8(
+            [In] sbyte[] query_codes,
+            float query_scale,
+            [In] sbyte[] corpus_codes,
+            [In] float[] corpus_scales,
+            int num_corpus,
+            int dimension,
+            int k,
+            [Out] int[] out_ids,
+            [Out] float[] out_scores,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Find the k binary-quantized corpus rows nearest in Hamming distance
+        /// </summary>
+        /// <param name="query_bits">Query bits [ceil(dimension / 8)]</param>
+        /// <param name="corpus_bits">Row-major corpus bits</param>
+        /// <param name="num_corpus">Number of corpus rows</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="k">Number of results</param>
+        /// <param name="out_ids">Output row indices [k]</param>
+        /// <param name="out_distances">Output Hamming distances [k]</param>
+        /// <param name="num_threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Number of results written, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_topk_binary(
+            [In] byte[] query_bits,
+            [In] byte[] corpus_bits,
+            int num_corpus,
+            int dimension,
+            int k,
+            [Out] int[] out_ids,
+            [Out] int[] out_distances,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Rerank candidate corpus rows with exact float scores
+        /// </summary>
+        /// <param name="query">Query vector</param>
+        /// <param name="corpus">Row-major [num_corpus x dimension] matrix</param>
+        /// <param name="num_corpus">Number of corpus rows</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="candidate_ids">Distinct corpus row indices</param>
+        /// <param name="num_candidates">Number of candidates</param>
+        /// <param name="k">Number of results</param>
+        /// <param name="out_ids">Output row indices [k]</param>
+        /// <param name="out_scores">Output scores [k]</param>
+        /// <param name="metric">fastembed_metric_t</param>
+        /// <returns>Number of results written, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_topk_rescore(
+            [In] float[] query,
+            [In] float[] corpus,
+            int num_corpus,
+            int dimension,
+            [In] int[] candidate_ids,
+            int num_candidates,
+            int k,
+            [Out] int[] out_ids,
+            [Out] float[] out_scores,
+            int metric
+        );
+
+        /// <summary>
+        /// Convert floats to IEEE half precision (round to nearest even)
+        /// </summary>
+        /// <param name="input">Floats [count]</param>
+        /// <param name="output">Output half-precision values [count]</param>
+        /// <param name="count">Number of values</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_f32_to_f16([In] float[] input, [Out] ushort[] output, int count);
+
+        /// <summary>
+        /// Convert IEEE half-precision values to floats
+        /// </summary>
+        /// <param name="input">Half-precision values [count]</param>
+        /// <param name="output">Output floats [count]</param>
+        /// <param name="count">Number of values</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_f16_to_f32([In] ushort[] input, [Out] float[] output, int count);
+
+        /// <summary>
+        /// Convert floats to bfloat16 (round to nearest even)
+        /// </summary>
+        /// <param name="input">Floats [count]</param>
+        /// <param name="output">Output bfloat16 values [count]</param>
+        /// <param name="count">Number of values</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_f32_to_bf16([In] float[] input, [Out] ushort[] output, int count);
+
+        /// <summary>
+        /// Convert bfloat16 values to floats
+        /// </summary>
+        /// <param name="input">bfloat16 values [count]</param>
+        /// <param name="output">Output floats [count]</param>
+        /// <param name="count">Number of values</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_bf16_to_f32([In] ushort[] input, [Out] float[] output, int count);
+
+        /// <summary>
+        /// Find the k half-precision corpus rows most similar to a query
+        /// </summary>
+        /// <param name="query">Query vector</param>
+        /// <param name="corpus">Row-major [num_corpus x dimension] fp16 / bf16 matrix</param>
+        /// <param name="format">FASTEMBED_QUANT_FP16 (3) or FASTEMBED_QUANT_BF16 (4)</param>
+        /// <param name="num_corpus">Number of corpus rows</param>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="k">Number of results</param>
+        /// <param name="out_ids">Output row indices [k]</param>
+        /// <param name="out_scores">Output scores [k]</param>
+        /// <param name="metric">fastembed_metric_t</param>
+        /// <param name="num_threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Number of results written, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_topk_half(
+            [In] float[] query,
+            [In] ushort[] corpus,
+            int format,
+            int num_corpus,
+            int dimension,
+            int k,
+            [Out] int[] out_ids,
+            [Out] float[] out_scores,
+            int metric,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Initialize HNSW options with defaults
+        /// </summary>
+        /// <param name="options">Options to initialize</param>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void fastembed_hnsw_options_init(ref FastEmbedHnswOptions options);
+
+        /// <summary>
+        /// Create an empty HNSW index
+        /// </summary>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="options">Graph parameters</param>
+        /// <returns>Index handle, or IntPtr.Zero on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr fastembed_hnsw_create(
+            int dimension,
+            ref FastEmbedHnswOptions options
+        );
+
+        /// <summary>
+        /// Free an HNSW index
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void fastembed_hnsw_free(IntPtr index);
+
+        /// <summary>
+        /// Add many vectors to an HNSW index
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <param name="vectors">Row-major [num_vectors x dimension] matrix</param>
+        /// <param name="num_vectors">Number of vectors</param>
+        /// <param name="out_ids">Output ids [num_vectors]</param>
+        /// <param name="num_threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_hnsw_add_batch(
+            IntPtr index,
+            [In] float[] vectors,
+            int num_vectors,
+            [Out] int[] out_ids,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Remove a vector from HNSW search results
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <param name="id">Vector id</param>
+        /// <returns>0 on success, -1 if unknown, already removed or read-only</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_hnsw_remove(IntPtr index, int id);
+
+        /// <summary>
+        /// Find approximately the k nearest vectors to a query
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <param name="query">Query vector</param>
+        /// <param name="k">Number of results</param>
+        /// <param name="out_ids">Output ids [k]</param>
+        /// <param name="out_scores">Output scores [k]</param>
+        /// <returns>Number of results written, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_hnsw_search(
+            IntPtr index,
+            [In] float[] query,
+            int k,
+            [Out] int[] out_ids,
+            [Out] float[] out_scores
+        );
+
+        /// <summary>
+        /// Set the candidate list size used by HNSW searches
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <param name="ef_search">Candidate list size</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_hnsw_set_ef_search(IntPtr index, int ef_search);
+
+        /// <summary>
+        /// Get the number of vectors in an HNSW index
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <returns>Vector count (removed ones excluded), -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_hnsw_size(IntPtr index);
+
+        /// <summary>
+        /// Get the vector dimension of an HNSW index
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <returns>Dimension, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_hnsw_dimension(IntPtr index);
+
+        /// <summary>
+        /// Write an HNSW index to a file
+        /// </summary>
+        /// <param name="index">Index handle</param>
+        /// <param name="path">Destination file</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern int fastembed_hnsw_save(
+            IntPtr index,
+            [MarshalAs(UnmanagedType.LPStr)] string path
+        );
+
+        /// <summary>
+        /// Read an HNSW index file into memory
+        /// </summary>
+        /// <param name="path">File written by fastembed_hnsw_save</param>
+        /// <returns>Index handle, or IntPtr.Zero on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern IntPtr fastembed_hnsw_load(
+            [MarshalAs(UnmanagedType.LPStr)] string path
+        );
+
+        /// <summary>
+        /// Map an HNSW index file read-only
+        /// </summary>
+        /// <param name="path">File written by fastembed_hnsw_save</param>
+        /// <returns>Index handle, or IntPtr.Zero on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern IntPtr fastembed_hnsw_load_mmap(
+            [MarshalAs(UnmanagedType.LPStr)] string path
+        );
+
         /// <summary>
         /// Generate ONNX-based embedding for text using ML model
         /// </summary>
@@ -181,6 +548,277 @@ namespace FastEmbed
         /// <returns>0 on success, -1 on error</returns>
         [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
         public static extern int fastembed_onnx_unload();
+
+        /// <summary>
+        /// Initialize ONNX session options with defaults
+        /// </summary>
+        /// <param name="options">Options to initialize</param>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void fastembed_onnx_options_init(ref FastEmbedOnnxOptions options);
+
+        /// <summary>
+        /// Open a model handle with ONNX Runtime session options
+        /// </summary>
+        /// <param name="modelPath">Path to ONNX model file</param>
+        /// <param name="options">Session options</param>
+        /// <returns>Model handle, or IntPtr.Zero on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern IntPtr fastembed_model_open_with_options(
+            [MarshalAs(UnmanagedType.LPStr)] string modelPath,
+            ref FastEmbedOnnxOptions options
+        );
+
+        /// <summary>
+        /// Close a model handle
+        /// </summary>
+        /// <param name="model">Model handle</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_model_close(IntPtr model);
+
+        /// <summary>
+        /// Get output dimension of an open model
+        /// </summary>
+        /// <param name="model">Model handle</param>
+        /// <returns>Output dimension, or -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_model_get_dimension(IntPtr model);
+
+        /// <summary>
+        /// Get the execution provider an open model runs on
+        /// </summary>
+        /// <param name="model">Model handle</param>
+        /// <returns>Execution provider id, or -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_model_get_execution_provider(IntPtr model);
+
+        /// <summary>
+        /// Run warmup inferences on an open model
+        /// </summary>
+        /// <param name="model">Model handle</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_model_warmup(IntPtr model);
+
+        /// <summary>
+        /// Load a model into the session cache and run warmup inferences
+        /// </summary>
+        /// <param name="modelPath">Path to ONNX model file</param>
+        /// <param name="options">Session options</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern int fastembed_onnx_preload(
+            [MarshalAs(UnmanagedType.LPStr)] string modelPath,
+            ref FastEmbedOnnxOptions options
+        );
+
+        /// <summary>
+        /// Generate ONNX embedding with an open model
+        /// </summary>
+        /// <param name="model">Model handle</param>
+        /// <param name="text">Input text (UTF-8)</param>
+        /// <param name="output">Output buffer for embedding</param>
+        /// <param name="dimension">Embedding dimension (0 = model dimension)</param>
+        /// <returns>0 on success, -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern int fastembed_model_generate(
+            IntPtr model,
+            [MarshalAs(UnmanagedType.LPStr)] string text,
+            [Out] float[] output,
+            int dimension
+        );
+
+        /// <summary>
+        /// Get last ONNX error message for the calling thread
+        /// </summary>
+        /// <param name="errorBuffer">Buffer receiving the message</param>
+        /// <param name="bufferSize">Buffer size in bytes</param>
+        /// <returns>0 if a message was copied, -1 otherwise</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern int fastembed_onnx_get_last_error(
+            [Out] byte[] errorBuffer,
+            UIntPtr bufferSize
+        );
+
+        /// <summary>
+        /// Write the instrumentation counters as JSON
+        /// </summary>
+        /// <param name="buffer">Output buffer (null when bufferSize is 0)</param>
+        /// <param name="bufferSize">Buffer size in bytes</param>
+        /// <returns>JSON length excluding the terminator (complete only if less than bufferSize), -1 on error</returns>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int fastembed_stats_snapshot_json(
+            [Out] byte[]? buffer,
+            UIntPtr bufferSize
+        );
+
+        /// <summary>
+        /// Zero all instrumentation counters
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void fastembed_stats_reset();
+
+        /// <summary>
+        /// Turn instrumentation on (non-zero) or off (0)
+        /// </summary>
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void fastembed_stats_set_enabled(int enabled);
+
+        // Pointer-based entry points. SuppressGCTransition is only safe for
+        // calls that finish in well under a microsecond and never block, so it
+        // is limited to the O(dimension) vector ops.
+
+        /// <summary>
+        /// Calculate cosine similarity between two pinned vectors
+        /// </summary>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        [SuppressGCTransition]
+        public static partial float fastembed_cosine_similarity(float* vector_a, float* vector_b, int dimension);
+
+        /// <summary>
+        /// Calculate dot product of two pinned vectors
+        /// </summary>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        [SuppressGCTransition]
+        public static partial float fastembed_dot_product(float* vector_a, float* vector_b, int dimension);
+
+        /// <summary>
+        /// Calculate L2 norm of a pinned vector
+        /// </summary>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        [SuppressGCTransition]
+        public static partial float fastembed_vector_norm(float* vector, int dimension);
+
+        /// <summary>
+        /// Normalize a pinned vector in-place
+        /// </summary>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        [SuppressGCTransition]
+        public static partial void fastembed_normalize(float* vector, int dimension);
+
+        /// <summary>
+        /// Score pinned query rows against pinned corpus rows
+        /// </summary>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        public static partial int fastembed_similarity_matrix_threaded(
+            float* queries,
+            int num_queries,
+            float* corpus,
+            int num_corpus,
+            int dimension,
+            float* output,
+            int metric,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Find the k pinned corpus rows most similar to a query
+        /// </summary>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        public static partial int fastembed_topk_threaded(
+            float* query,
+            float* corpus,
+            int num_corpus,
+            int dimension,
+            int k,
+            int* out_ids,
+            float* out_scores,
+            int metric,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Generate hash embeddings for concatenated UTF-8 texts into one matrix
+        /// </summary>
+        /// <param name="text_data">Concatenated UTF-8 texts</param>
+        /// <param name="offsets">num_texts + 1 byte offsets into text_data</param>
+        /// <param name="num_texts">Number of texts</param>
+        /// <param name="output">Row-major [num_texts x dimension] output</param>
+        /// <param name="dimension">Embedding dimension</param>
+        /// <param name="statuses">Output fastembed_status_t per text (may be null)</param>
+        /// <param name="num_threads">Threads to use, including the caller (0 = whole pool)</param>
+        /// <returns>Number of texts that failed, -1 on invalid arguments</returns>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        public static partial int fastembed_batch_generate_contiguous(
+            byte* text_data,
+            int* offsets,
+            int num_texts,
+            float* output,
+            int dimension,
+            int* statuses,
+            int num_threads
+        );
+
+        /// <summary>
+        /// Generate ONNX embeddings for concatenated UTF-8 texts with an open model
+        /// </summary>
+        /// <param name="model">Model handle</param>
+        /// <param name="text_data">Concatenated UTF-8 texts</param>
+        /// <param name="offsets">num_texts + 1 byte offsets into text_data</param>
+        /// <param name="num_texts">Number of texts</param>
+        /// <param name="output">Row-major [num_texts x dimension] output</param>
+        /// <param name="dimension">Embedding dimension (0 = model dimension)</param>
+        /// <param name="statuses">Output fastembed_status_t per text (may be null)</param>
+        /// <param name="num_threads">Threads to use, including the caller (0 = whole pool)</param>
+        /// <returns>Number of texts that failed, -1 on invalid arguments</returns>
+        [LibraryImport(DllName)]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        public static partial int fastembed_model_batch_generate_contiguous(
+            IntPtr model,
+            byte* text_data,
+            int* offsets,
+            int num_texts,
+            float* output,
+            int dimension,
+            int* statuses,
+            int num_threads
+        );
     }
-}
 
+    /// <summary>
+    /// Native layout of fastembed_onnx_options_t
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    internal struct FastEmbedOnnxOptions
+    {
+        /// <summary>
+        /// Maximum execution providers (FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS)
+        /// </summary>
+        public const int MaxExecutionProviders = 4;
+
+        public int IntraOpThreads;
+        public int InterOpThreads;
+        public int GraphOptLevel;
+        public int EnableMemPattern;
+        public int EnableCpuMemArena;
+        public int NumExecutionProviders;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = MaxExecutionProviders)]
+        public int[] ExecutionProviders;
+        public int DeviceId;
+        [MarshalAs(UnmanagedType.LPStr)]
+        public string? OptimizedModelPath;
+        [MarshalAs(UnmanagedType.LPStr)]
+        public string? TokenizerPath;
+        public int Pooling;
+    }
+
+    /// <summary>
+    /// Native layout of fastembed_hnsw_options_t
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct FastEmbedHnswOptions
+    {
+        public int M;
+        public int EfConstruction;
+        public int EfSearch;
+        public int Metric;
+        public uint Seed;
+    }
+}
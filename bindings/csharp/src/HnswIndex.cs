@@ -0,0 +1,250 @@
+using System;
+
+namespace FastEmbed
+{
+    /// <summary>
+    /// Graph parameters for <see cref="HnswIndex"/>
+    /// Defaults match fastembed_hnsw_options_init()
+    /// </summary>
+    public class HnswIndexOptions
+    {
+        /// <summary>
+        /// Neighbours per node, 2 - 64 (the bottom level keeps 2 * M); higher
+        /// raises recall at the cost of memory and insert time
+        /// </summary>
+        public int M { get; set; } = 16;
+
+        /// <summary>
+        /// Candidate list size while inserting; larger builds a better graph more slowly
+        /// </summary>
+        public int EfConstruction { get; set; } = 200;
+
+        /// <summary>
+        /// Candidate list size while searching (see <see cref="HnswIndex.EfSearch"/>)
+        /// </summary>
+        public int EfSearch { get; set; } = 64;
+
+        /// <summary>
+        /// Distance used to order neighbours
+        /// </summary>
+        public SimilarityMetric Metric { get; set; } = SimilarityMetric.Cosine;
+
+        /// <summary>
+        /// Seed for node levels; single-threaded inserts with the same seed build the same graph
+        /// </summary>
+        public uint Seed { get; set; }
+
+        internal FastEmbedHnswOptions ToNative()
+        {
+            var native = new FastEmbedHnswOptions();
+            FastEmbedNative.fastembed_hnsw_options_init(ref native);
+            native.M = M;
+            native.EfConstruction = EfConstruction;
+            native.EfSearch = EfSearch;
+            native.Metric = (int)Metric;
+            native.Seed = Seed;
+            return native;
+        }
+    }
+
+    /// <summary>
+    /// Approximate nearest neighbour index (HNSW graph)
+    /// Vectors get ids 0, 1, 2, ... in insertion order; inserts and searches
+    /// may run from many threads at once
+    /// </summary>
+    public sealed class HnswIndex : IDisposable
+    {
+        private IntPtr _handle;
+
+        /// <summary>
+        /// Create an empty index
+        /// </summary>
+        /// <param name="dimension">Vector dimension</param>
+        /// <param name="options">Graph parameters (null = defaults)</param>
+        /// <exception cref="ArgumentException">If the dimension or options are invalid</exception>
+        public HnswIndex(int dimension, HnswIndexOptions? options = null)
+        {
+            var native = (options ?? new HnswIndexOptions()).ToNative();
+            _handle = FastEmbedNative.fastembed_hnsw_create(dimension, ref native);
+            if (_handle == IntPtr.Zero)
+                throw new ArgumentException("Invalid HNSW dimension or options");
+
+            Dimension = dimension;
+        }
+
+        private HnswIndex(IntPtr handle)
+        {
+            _handle = handle;
+            Dimension = FastEmbedNative.fastembed_hnsw_dimension(handle);
+        }
+
+        /// <summary>
+        /// Load an index written by <see cref="Save"/>
+        /// </summary>
+        /// <param name="path">Index file</param>
+        /// <param name="mmap">Map the file read-only instead of reading it
+        /// (<see cref="Add"/> and <see cref="Remove"/> then fail)</param>
+        /// <returns>Loaded index</returns>
+        /// <exception cref="ArgumentNullException">If path is null</exception>
+        /// <exception cref="FastEmbedException">If the file is missing or invalid</exception>
+        public static HnswIndex Load(string path, bool mmap = false)
+        {
+            if (path == null)
+                throw new ArgumentNullException(nameof(path));
+
+            IntPtr handle = mmap
+                ? FastEmbedNative.fastembed_hnsw_load_mmap(path)
+                : FastEmbedNative.fastembed_hnsw_load(path);
+            if (handle == IntPtr.Zero)
+                throw new FastEmbedException($"Failed to load HNSW index: {path}");
+
+            return new HnswIndex(handle);
+        }
+
+        /// <summary>
+        /// Gets the vector dimension
+        /// </summary>
+        public int Dimension { get; }
+
+        /// <summary>
+        /// Gets the number of vectors in the index (removed ones excluded)
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                EnsureOpen();
+                return FastEmbedNative.fastembed_hnsw_size(_handle);
+            }
+        }
+
+        /// <summary>
+        /// Sets the search candidate list size (larger = better recall, slower)
+        /// </summary>
+        /// <exception cref="ArgumentException">If the value is not positive</exception>
+        public int EfSearch
+        {
+            set
+            {
+                EnsureOpen();
+                if (FastEmbedNative.fastembed_hnsw_set_ef_search(_handle, value) != 0)
+                    throw new ArgumentException("EfSearch must be positive", nameof(value));
+            }
+        }
+
+        /// <summary>
+        /// Add one vector or a row-major batch of vectors
+        /// </summary>
+        /// <param name="vectors">A multiple of <see cref="Dimension"/> floats</param>
+        /// <param name="threads">Worker threads (0 = all CPUs)</param>
+        /// <returns>Assigned ids, in row order</returns>
+        /// <exception cref="ArgumentException">If vectors is not a multiple of the dimension</exception>
+        /// <exception cref="FastEmbedException">If the index is read-only or out of memory</exception>
+        public int[] Add(float[] vectors, int threads = 1)
+        {
+            EnsureOpen();
+            if (vectors == null)
+                throw new ArgumentNullException(nameof(vectors));
+            if (vectors.Length == 0 || vectors.Length % Dimension != 0)
+                throw new ArgumentException($"Length must be a non-zero multiple of {Dimension}", nameof(vectors));
+
+            var ids = new int[vectors.Length / Dimension];
+            int result = FastEmbedNative.fastembed_hnsw_add_batch(_handle, vectors, ids.Length, ids, threads);
+            if (result != 0)
+                throw new FastEmbedException("Failed to add vectors (read-only index or out of memory)");
+
+            return ids;
+        }
+
+        /// <summary>
+        /// Remove a vector from search results
+        /// </summary>
+        /// <param name="id">Id returned by <see cref="Add"/></param>
+        /// <returns>False if the id is unknown or already removed, or the index is read-only</returns>
+        public bool Remove(int id)
+        {
+            EnsureOpen();
+            return FastEmbedNative.fastembed_hnsw_remove(_handle, id) == 0;
+        }
+
+        /// <summary>
+        /// Find approximately the k nearest vectors
+        /// </summary>
+        /// <param name="query">Query vector of <see cref="Dimension"/> floats</param>
+        /// <param name="k">Number of results</param>
+        /// <returns>Ids and scores, best first (distances for Euclidean)</returns>
+        /// <exception cref="ArgumentException">If the query or k is invalid</exception>
+        /// <exception cref="FastEmbedException">If the search fails</exception>
+        public (int[] Ids, float[] Scores) Search(float[] query, int k)
+        {
+            EnsureOpen();
+            if (query == null)
+                throw new ArgumentNullException(nameof(query));
+            if (query.Length != Dimension)
+                throw new ArgumentException($"Length must be {Dimension}", nameof(query));
+            if (k <= 0)
+                throw new ArgumentException("k must be positive", nameof(k));
+
+            int capacity = Math.Min(k, Count);
+            var ids = new int[capacity];
+            var scores = new float[capacity];
+            if (capacity == 0)
+                return (ids, scores);
+
+            int count = FastEmbedNative.fastembed_hnsw_search(_handle, query, capacity, ids, scores);
+            if (count < 0)
+                throw new FastEmbedException("Failed to search HNSW index");
+            if (count < capacity)
+            {
+                Array.Resize(ref ids, count);
+                Array.Resize(ref scores, count);
+            }
+
+            return (ids, scores);
+        }
+
+        /// <summary>
+        /// Write the index to a file (replaced if it exists)
+        /// </summary>
+        /// <param name="path">Destination file</param>
+        /// <exception cref="ArgumentNullException">If path is null</exception>
+        /// <exception cref="FastEmbedException">If the file cannot be written</exception>
+        public void Save(string path)
+        {
+            EnsureOpen();
+            if (path == null)
+                throw new ArgumentNullException(nameof(path));
+
+            if (FastEmbedNative.fastembed_hnsw_save(_handle, path) != 0)
+                throw new FastEmbedException($"Failed to save HNSW index: {path}");
+        }
+
+        /// <summary>
+        /// Free the index (unmaps the file for mapped indexes)
+        /// </summary>
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                FastEmbedNative.fastembed_hnsw_free(_handle);
+                _handle = IntPtr.Zero;
+            }
+            GC.SuppressFinalize(this);
+        }
+
+        /// <summary>
+        /// Frees the index if it was not disposed
+        /// </summary>
+        ~HnswIndex()
+        {
+            if (_handle != IntPtr.Zero)
+                FastEmbedNative.fastembed_hnsw_free(_handle);
+        }
+
+        private void EnsureOpen()
+        {
+            if (_handle == IntPtr.Zero)
+                throw new ObjectDisposedException(nameof(HnswIndex));
+        }
+    }
+}
@@ -0,0 +1,394 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace FastEmbed
+{
+    /// <summary>
+    /// ONNX Runtime execution providers (matches fastembed_execution_provider_t)
+    /// </summary>
+    public enum OnnxExecutionProvider
+    {
+        /// <summary>Default CPU provider</summary>
+        Cpu = 0,
+        /// <summary>NVIDIA CUDA</summary>
+        Cuda = 1,
+        /// <summary>NVIDIA TensorRT</summary>
+        TensorRT = 2,
+        /// <summary>Apple CoreML</summary>
+        CoreML = 3,
+        /// <summary>XNNPACK (optimized CPU kernels)</summary>
+        Xnnpack = 4
+    }
+
+    /// <summary>
+    /// ONNX Runtime graph optimization levels (matches fastembed_graph_opt_level_t)
+    /// </summary>
+    public enum OnnxGraphOptimizationLevel
+    {
+        /// <summary>No graph optimizations</summary>
+        Disable = 0,
+        /// <summary>Constant folding and redundant node elimination</summary>
+        Basic = 1,
+        /// <summary>Basic plus node fusions</summary>
+        Extended = 2,
+        /// <summary>All optimizations including layout transforms</summary>
+        All = 99
+    }
+
+    /// <summary>
+    /// Pooling over [batch, seq_len, hidden] model outputs (matches fastembed_pooling_t)
+    /// </summary>
+    public enum OnnxPooling
+    {
+        /// <summary>First token ([CLS]), BERT-style</summary>
+        Cls = 0,
+        /// <summary>Mask-aware mean over tokens (sentence-transformers)</summary>
+        Mean = 1,
+        /// <summary>Element-wise max over tokens</summary>
+        Max = 2,
+        /// <summary>Last non-padding token (decoder models)</summary>
+        LastToken = 3
+    }
+
+    /// <summary>
+    /// ONNX Runtime session tuning for <see cref="OnnxModel"/>
+    /// Defaults match fastembed_onnx_options_init()
+    /// </summary>
+    public class OnnxSessionOptions
+    {
+        /// <summary>
+        /// Threads used to parallelize a single operator (0 = ORT default)
+        /// </summary>
+        public int IntraOpThreads { get; set; }
+
+        /// <summary>
+        /// Threads used to run independent graph nodes in parallel (0 = ORT default)
+        /// </summary>
+        public int InterOpThreads { get; set; }
+
+        /// <summary>
+        /// Graph optimization level
+        /// </summary>
+        public OnnxGraphOptimizationLevel GraphOptimizationLevel { get; set; } = OnnxGraphOptimizationLevel.All;
+
+        /// <summary>
+        /// Enable memory pattern planning
+        /// </summary>
+        public bool EnableMemPattern { get; set; } = true;
+
+        /// <summary>
+        /// Enable the CPU memory arena
+        /// </summary>
+        public bool EnableCpuMemArena { get; set; } = true;
+
+        /// <summary>
+        /// Execution providers in priority order; unavailable ones fall back to CPU
+        /// </summary>
+        public IList<OnnxExecutionProvider> ExecutionProviders { get; } = new List<OnnxExecutionProvider>();
+
+        /// <summary>
+        /// GPU device used by CUDA / TensorRT
+        /// </summary>
+        public int DeviceId { get; set; }
+
+        /// <summary>
+        /// Optimized graph cache path (written on first load, reused while newer than the model)
+        /// </summary>
+        public string? OptimizedModelPath { get; set; }
+
+        /// <summary>
+        /// Model vocabulary (vocab.txt or WordPiece tokenizer.json);
+        /// null = look next to the model and in its parent directory
+        /// </summary>
+        public string? TokenizerPath { get; set; }
+
+        /// <summary>
+        /// Pooling over token embeddings; ignored by models with a pooled output
+        /// </summary>
+        public OnnxPooling Pooling { get; set; } = OnnxPooling.Cls;
+
+        internal FastEmbedOnnxOptions ToNative()
+        {
+            if (ExecutionProviders.Count > FastEmbedOnnxOptions.MaxExecutionProviders)
+                throw new ArgumentException(
+                    $"At most {FastEmbedOnnxOptions.MaxExecutionProviders} execution providers are supported");
+
+            var native = new FastEmbedOnnxOptions
+            {
+                ExecutionProviders = new int[FastEmbedOnnxOptions.MaxExecutionProviders]
+            };
+            FastEmbedNative.fastembed_onnx_options_init(ref native);
+
+            native.IntraOpThreads = IntraOpThreads;
+            native.InterOpThreads = InterOpThreads;
+            native.GraphOptLevel = (int)GraphOptimizationLevel;
+            native.EnableMemPattern = EnableMemPattern ? 1 : 0;
+            native.EnableCpuMemArena = EnableCpuMemArena ? 1 : 0;
+            native.NumExecutionProviders = ExecutionProviders.Count;
+            for (int i = 0; i < ExecutionProviders.Count; i++)
+                native.ExecutionProviders[i] = (int)ExecutionProviders[i];
+            native.DeviceId = DeviceId;
+            native.OptimizedModelPath = OptimizedModelPath;
+            native.TokenizerPath = TokenizerPath;
+            native.Pooling = (int)Pooling;
+            return native;
+        }
+    }
+
+    /// <summary>
+    /// Open handle to an ONNX embedding model
+    /// Sessions are shared natively: opening the same model with the same
+    /// options reuses one session
+    /// </summary>
+    public sealed unsafe class OnnxModel : IDisposable
+    {
+        private IntPtr _handle;
+
+        /// <summary>
+        /// Open an ONNX model
+        /// </summary>
+        /// <param name="modelPath">Path to ONNX model file</param>
+        /// <param name="options">Session options (null = defaults)</param>
+        /// <exception cref="ArgumentNullException">If modelPath is null</exception>
+        /// <exception cref="ArgumentException">If options are invalid</exception>
+        /// <exception cref="FastEmbedException">If the model cannot be loaded</exception>
+        public OnnxModel(string modelPath, OnnxSessionOptions? options = null)
+        {
+            if (modelPath == null)
+                throw new ArgumentNullException(nameof(modelPath));
+
+            var native = (options ?? new OnnxSessionOptions()).ToNative();
+            _handle = FastEmbedNative.fastembed_model_open_with_options(modelPath, ref native);
+            if (_handle == IntPtr.Zero)
+                throw new FastEmbedException($"Failed to open ONNX model: {GetLastError()}");
+
+            Dimension = FastEmbedNative.fastembed_model_get_dimension(_handle);
+            if (Dimension <= 0)
+            {
+                Dispose();
+                throw new FastEmbedException($"Failed to detect ONNX model dimension: {modelPath}");
+            }
+        }
+
+        /// <summary>
+        /// Gets the model output dimension
+        /// </summary>
+        public int Dimension { get; }
+
+        /// <summary>
+        /// Gets the execution provider the session runs on
+        /// (CPU if every requested provider was unavailable)
+        /// </summary>
+        public OnnxExecutionProvider ExecutionProvider
+        {
+            get
+            {
+                EnsureOpen();
+                return (OnnxExecutionProvider)FastEmbedNative.fastembed_model_get_execution_provider(_handle);
+            }
+        }
+
+        /// <summary>
+        /// Run warmup inferences so the first request does not pay ONNX Runtime's first-run setup
+        /// </summary>
+        /// <exception cref="FastEmbedException">If inference fails</exception>
+        public void Warmup()
+        {
+            EnsureOpen();
+            if (FastEmbedNative.fastembed_model_warmup(_handle) != 0)
+                throw new FastEmbedException($"ONNX warmup failed: {GetLastError()}");
+        }
+
+        /// <summary>
+        /// Load a model into the native session cache and warm it up, so models opened later
+        /// with the same options start without the cold-start cost
+        /// </summary>
+        /// <param name="modelPath">Path to ONNX model file</param>
+        /// <param name="options">Session options (null = defaults, the session used by
+        /// path-based calls); set <see cref="OnnxSessionOptions.OptimizedModelPath"/> to also skip
+        /// graph optimization on the next process start</param>
+        /// <exception cref="ArgumentNullException">If modelPath is null</exception>
+        /// <exception cref="ArgumentException">If options are invalid</exception>
+        /// <exception cref="FastEmbedException">If the model cannot be loaded</exception>
+        public static void Preload(string modelPath, OnnxSessionOptions? options = null)
+        {
+            if (modelPath == null)
+                throw new ArgumentNullException(nameof(modelPath));
+
+            var native = (options ?? new OnnxSessionOptions()).ToNative();
+            if (FastEmbedNative.fastembed_onnx_preload(modelPath, ref native) != 0)
+                throw new FastEmbedException($"Failed to preload ONNX model: {GetLastError()}");
+        }
+
+        /// <summary>
+        /// <see cref="Preload"/> on the thread pool, e.g. started before a service begins listening
+        /// </summary>
+        /// <param name="modelPath">Path to ONNX model file</param>
+        /// <param name="options">Session options (null = defaults)</param>
+        /// <returns>Task that completes when the model is loaded and warmed up</returns>
+        public static Task PreloadAsync(string modelPath, OnnxSessionOptions? options = null)
+        {
+            if (modelPath == null)
+                throw new ArgumentNullException(nameof(modelPath));
+
+            return Task.Run(() => Preload(modelPath, options));
+        }
+
+        /// <summary>
+        /// Generate ONNX embedding for text
+        /// </summary>
+        /// <param name="text">Input text</param>
+        /// <returns>Embedding vector of <see cref="Dimension"/> floats</returns>
+        /// <exception cref="ArgumentNullException">If text is null</exception>
+        /// <exception cref="FastEmbedException">If inference fails</exception>
+        public float[] GenerateEmbedding(string text)
+        {
+            EnsureOpen();
+            if (text == null)
+                throw new ArgumentNullException(nameof(text));
+
+            var output = new float[Dimension];
+            int result = FastEmbedNative.fastembed_model_generate(_handle, text, output, Dimension);
+            if (result != 0)
+                throw new FastEmbedException($"Failed to generate ONNX embedding: {GetLastError()}");
+
+            return output;
+        }
+
+        /// <summary>
+        /// Generate embeddings for concatenated UTF-8 texts into one matrix in a single native call
+        /// (same layout as <see cref="FastEmbedClient.GenerateEmbeddings(ReadOnlySpan{byte}, ReadOnlySpan{int}, Span{float}, Span{int}, int)"/>)
+        /// </summary>
+        /// <param name="textData">Concatenated UTF-8 texts</param>
+        /// <param name="offsets">numTexts + 1 non-decreasing byte offsets into textData</param>
+        /// <param name="output">Receives row-major [numTexts x Dimension] embeddings</param>
+        /// <param name="statuses">Receives a status code per text (empty = not reported)</param>
+        /// <param name="threads">Threads to use, including the caller (0 = whole pool); open the
+        /// model with a small <see cref="OnnxSessionOptions.IntraOpThreads"/> when using several</param>
+        /// <returns>Number of texts that failed (their rows are zeroed)</returns>
+        /// <exception cref="ArgumentException">If the offsets or buffers are invalid</exception>
+        /// <exception cref="FastEmbedException">If the batch cannot run</exception>
+        public int GenerateEmbeddings(ReadOnlySpan<byte> textData, ReadOnlySpan<int> offsets, Span<float> output,
+            Span<int> statuses = default, int threads = 0)
+        {
+            EnsureOpen();
+            int numTexts = TextBatch.Validate(textData, offsets, statuses);
+            if (output.Length < (long)numTexts * Dimension)
+                throw new ArgumentException($"Output must hold {(long)numTexts * Dimension} floats",
+                    nameof(output));
+
+            int failed;
+            fixed (byte* t = TextBatch.Pinnable(textData))
+            fixed (int* o = offsets)
+            fixed (float* e = output)
+            fixed (int* s = statuses)
+                failed = FastEmbedNative.fastembed_model_batch_generate_contiguous(
+                    _handle, t, o, numTexts, e, Dimension, s, threads);
+
+            if (failed < 0)
+                throw new FastEmbedException($"Failed to generate ONNX embeddings: {GetLastError()}");
+
+            return failed;
+        }
+
+        /// <summary>
+        /// Generate ONNX embeddings for many texts on the native thread pool
+        /// </summary>
+        /// <param name="texts">Input texts</param>
+        /// <param name="threads">Threads to use, including the caller (0 = whole pool)</param>
+        /// <returns>Row-major [texts.Length x Dimension] embeddings</returns>
+        /// <exception cref="ArgumentNullException">If texts or a text is null</exception>
+        /// <exception cref="FastEmbedException">If any text fails</exception>
+        public float[] GenerateBatch(string[] texts, int threads = 0)
+        {
+            byte[] data = TextBatch.Pack(texts, out int[] offsets);
+            var output = new float[(long)texts.Length * Dimension];
+            if (texts.Length == 0)
+                return output;
+
+            int failed = GenerateEmbeddings(data, offsets, output, default, threads);
+            if (failed != 0)
+                throw new FastEmbedException($"Failed to generate {failed} of {texts.Length} ONNX embeddings");
+
+            return output;
+        }
+
+        /// <summary>
+        /// Read the native instrumentation counters of all ONNX calls as JSON: per-stage
+        /// latency histograms in nanoseconds (resolve, load, tokenize, bind, run, pool,
+        /// generate), batch sizes and padding
+        /// </summary>
+        /// <returns>JSON object text, e.g. {"enabled":1,"texts":10,...,"stages":{"run":{"count":2,...}}}</returns>
+        public static string StatsSnapshotJson()
+        {
+            // Counters may grow between the two calls: retry until the buffer fits
+            int length = FastEmbedNative.fastembed_stats_snapshot_json(null, UIntPtr.Zero);
+            while (length >= 0)
+            {
+                var buffer = new byte[length + 64];
+                int written = FastEmbedNative.fastembed_stats_snapshot_json(buffer, (UIntPtr)buffer.Length);
+                if (written >= 0 && written < buffer.Length)
+                    return Encoding.UTF8.GetString(buffer, 0, written);
+                length = written;
+            }
+            throw new FastEmbedException("Failed to format instrumentation counters");
+        }
+
+        /// <summary>
+        /// Zero the native instrumentation counters
+        /// </summary>
+        public static void StatsReset()
+        {
+            FastEmbedNative.fastembed_stats_reset();
+        }
+
+        /// <summary>
+        /// Turn native instrumentation on or off (on by default)
+        /// </summary>
+        /// <param name="enabled">Whether to record</param>
+        public static void StatsSetEnabled(bool enabled)
+        {
+            FastEmbedNative.fastembed_stats_set_enabled(enabled ? 1 : 0);
+        }
+
+        /// <summary>
+        /// Release the model handle; the session stays cached natively
+        /// </summary>
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                FastEmbedNative.fastembed_model_close(_handle);
+                _handle = IntPtr.Zero;
+            }
+            GC.SuppressFinalize(this);
+        }
+
+        /// <summary>
+        /// Releases the handle if the model was not disposed
+        /// </summary>
+        ~OnnxModel()
+        {
+            if (_handle != IntPtr.Zero)
+                FastEmbedNative.fastembed_model_close(_handle);
+        }
+
+        private void EnsureOpen()
+        {
+            if (_handle == IntPtr.Zero)
+                throw new ObjectDisposedException(nameof(OnnxModel));
+        }
+
+        private static string GetLastError()
+        {
+            var buffer = new byte[512];
+            if (FastEmbedNative.fastembed_onnx_get_last_error(buffer, (UIntPtr)buffer.Length) != 0)
+                return "unknown error";
+
+            int length = Array.IndexOf(buffer, (byte)0);
+            return Encoding.UTF8.GetString(buffer, 0, length < 0 ? buffer.Length : length);
+        }
+    }
+}
@@ -367,6 +367,94 @@ namespace FastEmbed.Tests
             Assert.NotNull(embeddings);
             Assert.Empty(embeddings);
         }
+
+        [Fact]
+        public void GenerateBatch_WithValidTexts_MatchesSingleEmbeddings()
+        {
+            // Happy path: one native call, same rows as per-text generation
+            var client = new FastEmbedClient(DefaultDimension);
+            var texts = new[] { "first text", "naïve café", "third" };
+
+            var matrix = client.GenerateBatch(texts);
+
+            Assert.Equal(texts.Length * DefaultDimension, matrix.Length);
+            for (int i = 0; i < texts.Length; i++)
+            {
+                var row = new ArraySegment<float>(matrix, i * DefaultDimension, DefaultDimension);
+                Assert.Equal(client.GenerateEmbedding(texts[i]), row);
+            }
+        }
+
+        [Fact]
+        public void GenerateEmbeddings_WithOffsetsPastData_ThrowsArgumentException()
+        {
+            // Error handling: offsets are checked against the text buffer
+            var client = new FastEmbedClient(DefaultDimension);
+            var data = new byte[] { (byte)'a', (byte)'b', (byte)'c' };
+            var output = new float[2 * DefaultDimension];
+
+            Assert.Throws<ArgumentException>(() => client.GenerateEmbeddings(data, new[] { 0, 2, 4 }, output));
+            Assert.Throws<ArgumentException>(() => client.GenerateEmbeddings(data, new[] { 0, 2, 1 }, output));
+            Assert.Throws<ArgumentException>(() => client.GenerateEmbeddings(data, new[] { 0, 3 }, new float[1]));
+        }
+
+        [Fact]
+        public void GenerateEmbeddings_WithOnlyEmptyTexts_ReportsPerTextStatuses()
+        {
+            // Edge case: an empty text buffer still reaches the native batch call
+            var client = new FastEmbedClient(DefaultDimension);
+            var output = new float[2 * DefaultDimension];
+            var statuses = new int[2];
+
+            int failed = client.GenerateEmbeddings(ReadOnlySpan<byte>.Empty, new[] { 0, 0, 0 }, output, statuses);
+
+            Assert.Equal(2, failed);
+            Assert.Equal(new[] { -3, -3 }, statuses); // FASTEMBED_STATUS_INVALID_TEXT
+        }
+
+        [Fact]
+        public void SpanOverloads_MatchArrayOverloads()
+        {
+            // Happy path: span and array entry points compute the same values
+            var client = new FastEmbedClient(DefaultDimension);
+            var corpus = client.GenerateBatch(new[] { "alpha", "beta", "gamma", "delta" });
+            var query = client.GenerateEmbedding("beta");
+
+            Assert.Equal(client.CosineSimilarity(query, client.GenerateEmbedding("alpha")),
+                client.CosineSimilarity(query.AsSpan(), corpus.AsSpan(0, DefaultDimension)));
+            Assert.Equal(client.DotProduct(query, query), client.DotProduct(query.AsSpan(), query.AsSpan()));
+            Assert.Equal(client.VectorNorm(query), client.VectorNorm(query.AsSpan()));
+
+            var normalized = (float[])query.Clone();
+            client.NormalizeInPlace(normalized);
+            Assert.Equal(client.NormalizeVector(query), normalized);
+
+            var scores = new float[4];
+            client.SimilarityMatrix(query, corpus, scores);
+            Assert.Equal(client.SimilarityMatrix(query, corpus), scores);
+
+            var ids = new int[2];
+            var topScores = new float[2];
+            int count = client.TopK(query, corpus, ids, topScores);
+            var expected = client.TopK(query, corpus, 2);
+            Assert.Equal(2, count);
+            Assert.Equal(1, ids[0]);
+            Assert.Equal(expected.Ids, ids);
+            Assert.Equal(expected.Scores, topScores);
+        }
+
+        [Fact]
+        public void SpanOverloads_WithWrongSizes_ThrowArgumentException()
+        {
+            // Error handling: spans are validated like arrays
+            var client = new FastEmbedClient(DefaultDimension);
+            var vector = new float[DefaultDimension];
+
+            Assert.Throws<ArgumentException>(() => client.CosineSimilarity(vector.AsSpan(), vector.AsSpan(1)));
+            Assert.Throws<ArgumentException>(() => client.SimilarityMatrix(vector, vector, new float[0]));
+            Assert.Throws<ArgumentException>(() =>
+                client.TopK(vector, vector, new int[2], new float[1]));
+        }
     }
 }
 
@@ -1,5 +1,6 @@
 using System;
 using System.IO;
+using System.Threading.Tasks;
 using Xunit;
 using FastEmbed;
 
@@ -161,6 +162,176 @@ namespace FastEmbed.Tests
             var similarity = client.CosineSimilarity(emb1, emb2);
             Assert.True(similarity >= 0.99f); // Should be very similar
         }
+
+        [Fact]
+        public void OnnxModel_WithNullModelPath_ThrowsArgumentNullException()
+        {
+            Assert.Throws<ArgumentNullException>(() => new OnnxModel(null!));
+        }
+
+        [Fact]
+        public void OnnxModel_WithTooManyExecutionProviders_ThrowsArgumentException()
+        {
+            var options = new OnnxSessionOptions();
+            for (int i = 0; i < 5; i++)
+                options.ExecutionProviders.Add(OnnxExecutionProvider.Cpu);
+
+            Assert.Throws<ArgumentException>(() => new OnnxModel("model.onnx", options));
+        }
+
+        [Fact]
+        public void OnnxModel_WithSessionOptions_MatchesDefaultSession()
+        {
+            // Integration test: tuned session produces the same embeddings
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            var options = new OnnxSessionOptions
+            {
+                IntraOpThreads = 2,
+                InterOpThreads = 1,
+                GraphOptimizationLevel = OnnxGraphOptimizationLevel.Basic,
+                EnableMemPattern = false
+            };
+            options.ExecutionProviders.Add(OnnxExecutionProvider.Cuda);
+
+            using var defaultModel = new OnnxModel(TestOnnxModelPath);
+            using var tunedModel = new OnnxModel(TestOnnxModelPath, options);
+
+            Assert.Equal(defaultModel.Dimension, tunedModel.Dimension);
+            Assert.Equal(OnnxExecutionProvider.Cpu, defaultModel.ExecutionProvider);
+
+            var text = "machine learning";
+            var emb1 = defaultModel.GenerateEmbedding(text);
+            var emb2 = tunedModel.GenerateEmbedding(text);
+            for (int i = 0; i < emb1.Length; i++)
+                Assert.True(Math.Abs(emb1[i] - emb2[i]) < 0.001f);
+        }
+
+        [Fact]
+        public void OnnxModel_AfterDispose_ThrowsObjectDisposedException()
+        {
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            var model = new OnnxModel(TestOnnxModelPath);
+            model.Dispose();
+            model.Dispose(); // Idempotent
+
+            Assert.Throws<ObjectDisposedException>(() => model.GenerateEmbedding("text"));
+        }
+
+        [Fact]
+        public void OnnxModel_WithMissingTokenizerPath_ThrowsFastEmbedException()
+        {
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            var options = new OnnxSessionOptions { TokenizerPath = "does_not_exist.vocab.txt" };
+            var exception = Assert.Throws<FastEmbedException>(() => new OnnxModel(TestOnnxModelPath, options));
+            Assert.Contains("tokenizer", exception.Message);
+        }
+
+        [Fact]
+        public void OnnxModel_WithMeanPooling_ReturnsNormalizedEmbedding()
+        {
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            using var cls = new OnnxModel(TestOnnxModelPath);
+            using var mean = new OnnxModel(TestOnnxModelPath, new OnnxSessionOptions { Pooling = OnnxPooling.Mean });
+
+            var clsEmbedding = cls.GenerateEmbedding("pooling modes");
+            var meanEmbedding = mean.GenerateEmbedding("pooling modes");
+
+            double norm = 0;
+            foreach (var value in meanEmbedding)
+                norm += value * value;
+            Assert.Equal(1.0, Math.Sqrt(norm), 3);
+            Assert.NotEqual(clsEmbedding, meanEmbedding);
+        }
+
+        [Fact]
+        public void OnnxModel_GenerateBatch_MatchesSingleEmbeddings()
+        {
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            using var model = new OnnxModel(TestOnnxModelPath, new OnnxSessionOptions { IntraOpThreads = 1 });
+            var texts = new[] { "first", "second text", "third" };
+
+            var matrix = model.GenerateBatch(texts, 2);
+
+            Assert.Equal(texts.Length * model.Dimension, matrix.Length);
+            var row = new ArraySegment<float>(matrix, model.Dimension, model.Dimension);
+            var single = model.GenerateEmbedding(texts[1]);
+            for (int i = 0; i < model.Dimension; i++)
+                Assert.Equal(single[i], row[i], 5);
+        }
+
+        [Fact]
+        public void OnnxModel_StatsSnapshotJson_CountsGenerateCalls()
+        {
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            using var model = new OnnxModel(TestOnnxModelPath);
+            OnnxModel.StatsReset();
+            model.GenerateBatch(new[] { "first", "second text" });
+
+            using var stats = System.Text.Json.JsonDocument.Parse(OnnxModel.StatsSnapshotJson());
+            var root = stats.RootElement;
+            Assert.Equal(2, root.GetProperty("texts").GetInt64());
+            Assert.True(root.GetProperty("padded_tokens").GetInt64() >= root.GetProperty("tokens").GetInt64());
+            Assert.True(root.GetProperty("stages").GetProperty("run").GetProperty("count").GetInt64() >= 1);
+
+            OnnxModel.StatsSetEnabled(false);
+            model.GenerateEmbedding("not recorded");
+            OnnxModel.StatsSetEnabled(true);
+            using var after = System.Text.Json.JsonDocument.Parse(OnnxModel.StatsSnapshotJson());
+            Assert.Equal(2, after.RootElement.GetProperty("texts").GetInt64());
+        }
+
+        [Fact]
+        public async Task OnnxModel_PreloadAsync_LoadsSessionBeforeOpen()
+        {
+            if (TestOnnxModelPath == null || !File.Exists(TestOnnxModelPath))
+            {
+                // Skip test if model not available
+                return;
+            }
+
+            var options = new OnnxSessionOptions { IntraOpThreads = 1 };
+            await OnnxModel.PreloadAsync(TestOnnxModelPath, options);
+
+            OnnxModel.StatsReset();
+            using var model = new OnnxModel(TestOnnxModelPath, options);
+            model.Warmup();
+            using var stats = System.Text.Json.JsonDocument.Parse(OnnxModel.StatsSnapshotJson());
+            var stages = stats.RootElement.GetProperty("stages");
+            Assert.Equal(0, stages.GetProperty("load").GetProperty("count").GetInt64());
+            Assert.True(stages.GetProperty("run").GetProperty("count").GetInt64() >= 2);
+
+            await Assert.ThrowsAsync<FastEmbedException>(() => OnnxModel.PreloadAsync("missing_model.onnx"));
+        }
     }
 }
 
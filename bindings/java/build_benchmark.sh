@@ -33,7 +33,15 @@ gcc -shared -fPIC -O3 \
     "$PROJ_ROOT/shared/build/embedding_lib.o" \
     "$PROJ_ROOT/shared/build/embedding_generator.o" \
     "$PROJ_ROOT/shared/build/embedding_lib_c.o" \
-    -lm
+    "$PROJ_ROOT/shared/build/wordpiece_tokenizer.o" \
+    "$PROJ_ROOT/shared/build/similarity.o" \
+    "$PROJ_ROOT/shared/build/hnsw_index.o" \
+    "$PROJ_ROOT/shared/build/quantize.o" \
+    "$PROJ_ROOT/shared/build/thread_pool.o" \
+    "$PROJ_ROOT/shared/build/vector_store.o" \
+    "$PROJ_ROOT/shared/build/embedding_cache.o" \
+    "$PROJ_ROOT/shared/build/fastembed_stats.o" \
+    -lm -lpthread
 
 # Compile Java classes
 echo "Compiling Java classes..."
@@ -1,8 +1,13 @@
 package com.fastembed.test;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 import java.util.Arrays;
 
 import com.fastembed.FastEmbed;
+import com.fastembed.PackedTexts;
 
 /**
  * Test program for FastEmbed Java Native Module
@@ -222,8 +227,133 @@ public class TestFastEmbedJava {
             System.out.println("    Text: " + specialText);
             System.out.println("    Embedding length: " + specialEmb.length + "\n");
 
+            // Test 17: Direct buffers match the array overloads
+            System.out.println("17. Testing direct-buffer overloads against arrays...");
+            // Offset the vectors so reads start at the buffer position
+            FloatBuffer directA = FastEmbed.allocateFloats(768 + 3);
+            FloatBuffer directB = FastEmbed.allocateFloats(768);
+            directA.position(3);
+            directA.put(embedding1).position(3);
+            directB.put(embedding2).rewind();
+            float directCosine = client.cosineSimilarity(directA, directB);
+            float directDot = client.dotProduct(directA, directB);
+            if (Math.abs(directCosine - similarity) > 1e-6f || Math.abs(directDot - dotProd) > 1e-3f
+                    || directA.position() != 3) {
+                System.err.printf("  ✗ Direct cosine/dot %.6f/%.6f differ from arrays %.6f/%.6f%n", directCosine,
+                        directDot, similarity, dotProd);
+                System.exit(1);
+            }
+            System.out.println("  ✓ cosineSimilarity / dotProduct match and positions are unchanged");
+
+            float[] corpusArray = new float[embeddings.length * 768];
+            for (int i = 0; i < embeddings.length; i++) {
+                System.arraycopy(embeddings[i], 0, corpusArray, i * 768, 768);
+            }
+            float[] queryArray = new float[2 * 768];
+            System.arraycopy(embedding1, 0, queryArray, 0, 768);
+            System.arraycopy(embedding2, 0, queryArray, 768, 768);
+            FloatBuffer corpusDirect = FastEmbed.allocateFloats(corpusArray.length);
+            FloatBuffer queryDirect = FastEmbed.allocateFloats(queryArray.length);
+            FloatBuffer scoresDirect = FastEmbed.allocateFloats(2 * embeddings.length);
+            corpusDirect.put(corpusArray).rewind();
+            queryDirect.put(queryArray).rewind();
+
+            for (FastEmbed.SimilarityMetric metric : FastEmbed.SimilarityMetric.values()) {
+                float[] scoresArray = client.similarityMatrix(queryArray, corpusArray, metric, 1);
+                client.similarityMatrix(queryDirect, 2, corpusDirect, embeddings.length, scoresDirect, metric, 1);
+                float[] scoresCopy = new float[scoresArray.length];
+                scoresDirect.get(scoresCopy).rewind();
+                if (maxAbsDiff(scoresArray, scoresCopy) > 1e-4f) {
+                    System.err.println("  ✗ Direct similarityMatrix differs from arrays (" + metric + ")");
+                    System.exit(1);
+                }
+
+                FastEmbed.TopKResult topArray = client.topK(embedding1, corpusArray, 3, metric, 1);
+                FastEmbed.TopKResult topDirect = client.topK(directA, corpusDirect, embeddings.length, 3, metric,
+                        1);
+                if (!Arrays.equals(topArray.getIds(), topDirect.getIds())
+                        || maxAbsDiff(topArray.getScores(), topDirect.getScores()) > 1e-4f) {
+                    System.err.println("  ✗ Direct topK differs from arrays (" + metric + ")");
+                    System.exit(1);
+                }
+            }
+            System.out.println("  ✓ similarityMatrix / topK match for every metric\n");
+
+            // Test 18: Buffers the native side cannot read in place are rejected
+            System.out.println("18. Testing rejected buffers...");
+            ByteOrder otherOrder = ByteOrder.nativeOrder() == ByteOrder.LITTLE_ENDIAN ? ByteOrder.BIG_ENDIAN
+                    : ByteOrder.LITTLE_ENDIAN;
+            FloatBuffer heapVector = FloatBuffer.wrap(embedding1.clone());
+            FloatBuffer swappedVector = ByteBuffer.allocateDirect(768 * Float.BYTES).order(otherOrder)
+                    .asFloatBuffer();
+            FloatBuffer shortVector = FastEmbed.allocateFloats(767);
+            FloatBuffer shortScores = FastEmbed.allocateFloats(2 * embeddings.length - 1);
+            PackedTexts packedPair = PackedTexts.of(text1, text2);
+            IntBuffer heapOffsets = IntBuffer.wrap(new int[] { 0, 1, 2 });
+            IntBuffer shortStatuses = FastEmbed.allocateInts(1);
+            FloatBuffer pairOutput = FastEmbed.allocateFloats(2 * 768);
+
+            expectRejected("heap vector", () -> client.cosineSimilarity(heapVector, directB));
+            expectRejected("non-native-order vector", () -> client.dotProduct(directB, swappedVector));
+            expectRejected("too-short vector", () -> client.cosineSimilarity(directB, shortVector));
+            expectRejected("heap corpus", () -> client.topK(directB, heapVector, 1, 1,
+                    FastEmbed.SimilarityMetric.COSINE, 1));
+            expectRejected("too-short corpus", () -> client.topK(directB, corpusDirect, embeddings.length + 1, 1,
+                    FastEmbed.SimilarityMetric.COSINE, 1));
+            expectRejected("too-short scores", () -> client.similarityMatrix(queryDirect, 2, corpusDirect,
+                    embeddings.length, shortScores, FastEmbed.SimilarityMetric.COSINE, 1));
+            expectRejected("heap text data", () -> client.generateEmbeddings(ByteBuffer.wrap(new byte[] { 'a', 'b' }),
+                    packedPair.getOffsets(), 2, pairOutput, null, 1));
+            expectRejected("heap offsets", () -> client.generateEmbeddings(packedPair.getData(), heapOffsets, 2,
+                    pairOutput, null, 1));
+            expectRejected("too-short output", () -> client.generateEmbeddings(packedPair, shortVector, null, 1));
+            expectRejected("too-short statuses", () -> client.generateEmbeddings(packedPair, pairOutput,
+                    shortStatuses, 1));
+            System.out.println("  ✓ Heap, non-native-order and too-short buffers are rejected\n");
+
+            // Test 19: Packed batch rows match per-text generation
+            System.out.println("19. Testing packed batch against generateEmbedding...");
+            // BMP-only: generateEmbedding passes modified UTF-8, which differs for supplementary characters
+            String[] batchTexts = { text1, text2, "Привет мир こんにちは 世界", specialText, "AI", "Computer Vision" };
+            PackedTexts packed = PackedTexts.of(batchTexts);
+            FloatBuffer batchOutput = FastEmbed.allocateFloats(batchTexts.length * 768);
+            IntBuffer batchStatuses = FastEmbed.allocateInts(batchTexts.length);
+            int batchFailed = client.generateEmbeddings(packed, batchOutput, batchStatuses, 0);
+            if (batchFailed != 0) {
+                System.err.println("  ✗ Packed batch reported " + batchFailed + " failed texts");
+                System.exit(1);
+            }
+            float[] row = new float[768];
+            for (int i = 0; i < batchTexts.length; i++) {
+                batchOutput.position(i * 768);
+                batchOutput.get(row);
+                if (batchStatuses.get(i) != 0 || !Arrays.equals(row, client.generateEmbedding(batchTexts[i]))) {
+                    System.err.println("  ✗ Packed row " + i + " differs from generateEmbedding");
+                    System.exit(1);
+                }
+            }
+            System.out.println("  ✓ All " + batchTexts.length + " rows match generateEmbedding");
+
+            // An empty text fails alone: its row is zeroed, its neighbours are unaffected
+            PackedTexts withEmpty = PackedTexts.of(text1, "", text2);
+            FloatBuffer emptyOutput = FastEmbed.allocateFloats(3 * 768);
+            IntBuffer emptyStatuses = FastEmbed.allocateInts(3);
+            int emptyFailed = client.generateEmbeddings(withEmpty, emptyOutput, emptyStatuses, 1);
+            float[] emptyRow = new float[768];
+            emptyOutput.position(768);
+            emptyOutput.get(emptyRow);
+            emptyOutput.position(2 * 768);
+            emptyOutput.get(row);
+            if (emptyFailed != 1 || emptyStatuses.get(0) != 0 || emptyStatuses.get(1) == 0
+                    || emptyStatuses.get(2) != 0 || !Arrays.equals(emptyRow, new float[768])
+                    || !Arrays.equals(row, embedding2)) {
+                System.err.println("  ✗ Empty text in a packed batch was not isolated");
+                System.exit(1);
+            }
+            System.out.println("  ✓ Empty text fails alone with a zeroed row\n");
+
             System.out.println("========================================");
-            System.out.println("ALL TESTS PASSED ✓ (16/16)");
+            System.out.println("ALL TESTS PASSED ✓ (19/19)");
             System.out.println("========================================\n");
             System.out.println("FastEmbed Java native module is working correctly!");
             System.out.printf("Performance: ~%.2fms per embedding (native speed)\n", avgTime);
@@ -231,6 +361,7 @@ public class TestFastEmbedJava {
             System.out.println("  • Happy path: 9 tests");
             System.out.println("  • Error handling: 4 tests");
             System.out.println("  • Edge cases: 3 tests");
+            System.out.println("  • Direct buffers and packed batches: 3 tests");
 
         } catch (Exception e) {
             System.err.println("\n✗ ERROR: " + e.getMessage());
@@ -238,4 +369,28 @@ public class TestFastEmbedJava {
             System.exit(1);
         }
     }
+
+    /** Largest element-wise difference; infinite if the lengths differ */
+    private static float maxAbsDiff(float[] a, float[] b) {
+        if (a.length != b.length) {
+            return Float.POSITIVE_INFINITY;
+        }
+        float max = 0.0f;
+        for (int i = 0; i < a.length; i++) {
+            max = Math.max(max, Math.abs(a[i] - b[i]));
+        }
+        return max;
+    }
+
+    /** Exit unless call throws IllegalArgumentException */
+    private static void expectRejected(String what, Runnable call) {
+        try {
+            call.run();
+        } catch (IllegalArgumentException e) {
+            System.out.println("    " + what + ": " + e.getMessage());
+            return;
+        }
+        System.err.println("  ✗ Should have rejected " + what);
+        System.exit(1);
+    }
 }
@@ -238,14 +238,46 @@ echo Compiling embedding_lib_c.c...
 "!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /I"%ONNX%\include" /DUSE_ONNX_RUNTIME /DFASTEMBED_BUILDING_LIB "%SHARED%\src\embedding_lib_c.c" /Fo"%BDIR%\elib.obj"
 if errorlevel 1 goto :err
 
+echo Compiling wordpiece_tokenizer.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\wordpiece_tokenizer.c" /Fo"%BDIR%\wptok.obj"
+if errorlevel 1 goto :err
+
+echo Compiling similarity.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\similarity.c" /Fo"%BDIR%\simil.obj"
+if errorlevel 1 goto :err
+
+echo Compiling hnsw_index.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\hnsw_index.c" /Fo"%BDIR%\hnsw.obj"
+if errorlevel 1 goto :err
+
+echo Compiling quantize.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\quantize.c" /Fo"%BDIR%\quant.obj"
+if errorlevel 1 goto :err
+
+echo Compiling thread_pool.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\thread_pool.c" /Fo"%BDIR%\tpool.obj"
+if errorlevel 1 goto :err
+
+echo Compiling vector_store.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\vector_store.c" /Fo"%BDIR%\vstore.obj"
+if errorlevel 1 goto :err
+
+echo Compiling embedding_cache.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\embedding_cache.c" /Fo"%BDIR%\ecache.obj"
+if errorlevel 1 goto :err
+
+echo Compiling fastembed_stats.c...
+"!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /DFASTEMBED_BUILDING_LIB "%SHARED%\src\fastembed_stats.c" /Fo"%BDIR%\fstats.obj"
+if errorlevel 1 goto :err
+
 echo Compiling onnx_embedding_loader.c...
 "!CL_CMD!" /c /O2 !MSVC_INCLUDE_FLAG! /I"!KIT_ROOT!\Include\!SDK_VERSION!\ucrt" /I"!KIT_ROOT!\Include\!SDK_VERSION!\um" /I"!KIT_ROOT!\Include\!SDK_VERSION!\shared" /I"%SHARED%\include" /I"%ONNX%\include" /DUSE_ONNX_RUNTIME /DFASTEMBED_BUILDING_LIB "%SHARED%\src\onnx_embedding_loader.c" /Fo"%BDIR%\onnx.obj"
 if errorlevel 1 goto :err
 
 echo Linking...
 REM Link WITHOUT fastembed.lib to avoid old ONNX Runtime dependency
-REM All code is already compiled into fjni.obj, elib.obj, onnx.obj
-"!LINK_CMD!" /DLL /OUT:"%BDIR%\fastembed_jni.dll" "%BDIR%\fjni.obj" "%BDIR%\elib.obj" "%BDIR%\onnx.obj" "%SHARED%\build\embedding_lib.obj" "%SHARED%\build\embedding_generator.obj" "%ONNX%\lib\onnxruntime.lib" /LIBPATH:"!MSVC_ROOT!lib\x64" /LIBPATH:"!KIT_ROOT!\Lib\!SDK_VERSION!\ucrt\x64" /LIBPATH:"!KIT_ROOT!\Lib\!SDK_VERSION!\um\x64"
+REM All code is already compiled into fjni.obj, elib.obj, wptok.obj, simil.obj, hnsw.obj, quant.obj, tpool.obj, vstore.obj, ecache.obj, fstats.obj, onnx.obj
+"!LINK_CMD!" /DLL /OUT:"%BDIR%\fastembed_jni.dll" "%BDIR%\fjni.obj" "%BDIR%\elib.obj" "%BDIR%\wptok.obj" "%BDIR%\simil.obj" "%BDIR%\hnsw.obj" "%BDIR%\quant.obj" "%BDIR%\tpool.obj" "%BDIR%\vstore.obj" "%BDIR%\ecache.obj" "%BDIR%\fstats.obj" "%BDIR%\onnx.obj" "%SHARED%\build\embedding_lib.obj" "%SHARED%\build\embedding_generator.obj" "%ONNX%\lib\onnxruntime.lib" /LIBPATH:"!MSVC_ROOT!lib\x64" /LIBPATH:"!KIT_ROOT!\Lib\!SDK_VERSION!\ucrt\x64" /LIBPATH:"!KIT_ROOT!\Lib\!SDK_VERSION!\um\x64"
 if errorlevel 1 goto :err
 
 copy /Y "%ONNX%\lib\onnxruntime.dll" "%BDIR%\" >nul
@@ -117,6 +117,70 @@ if [ $? -ne 0 ]; then
     exit 1
 fi
 
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/wordpiece_tokenizer.c" -o "$BUILD_DIR/wordpiece_tokenizer.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile wordpiece_tokenizer.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/similarity.c" -o "$BUILD_DIR/similarity.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile similarity.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/hnsw_index.c" -o "$BUILD_DIR/hnsw_index.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile hnsw_index.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/quantize.c" -o "$BUILD_DIR/quantize.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile quantize.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/thread_pool.c" -o "$BUILD_DIR/thread_pool.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile thread_pool.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/vector_store.c" -o "$BUILD_DIR/vector_store.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile vector_store.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/embedding_cache.c" -o "$BUILD_DIR/embedding_cache.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile embedding_cache.c"
+    exit 1
+fi
+
+$CC -fPIC -O2 -Wall -c \
+    -I"$SHARED_DIR/include" -DFASTEMBED_BUILDING_LIB \
+    "$SHARED_DIR/src/fastembed_stats.c" -o "$BUILD_DIR/fastembed_stats.o"
+if [ $? -ne 0 ]; then
+    echo "❌ ERROR: Failed to compile fastembed_stats.c"
+    exit 1
+fi
+
 $CC -fPIC -O2 -Wall -c \
     -I"$SHARED_DIR/include" -I"$ONNX_RUNTIME_DIR/include" \
     -DUSE_ONNX_RUNTIME -DFASTEMBED_BUILDING_LIB \
@@ -142,7 +206,7 @@ echo "Linking JNI shared library..."
 echo "========================================"
 
 # Link all objects into the JNI shared library
-LINK_OBJECTS="$BUILD_DIR/fastembed_jni.o $BUILD_DIR/embedding_lib_c.o $BUILD_DIR/onnx_embedding_loader.o"
+LINK_OBJECTS="$BUILD_DIR/fastembed_jni.o $BUILD_DIR/embedding_lib_c.o $BUILD_DIR/wordpiece_tokenizer.o $BUILD_DIR/similarity.o $BUILD_DIR/hnsw_index.o $BUILD_DIR/quantize.o $BUILD_DIR/thread_pool.o $BUILD_DIR/vector_store.o $BUILD_DIR/embedding_cache.o $BUILD_DIR/fastembed_stats.o $BUILD_DIR/onnx_embedding_loader.o"
 if [ -f "$BUILD_DIR/embedding_lib_arm64.o" ]; then
     LINK_OBJECTS="$LINK_OBJECTS $BUILD_DIR/embedding_lib_arm64.o"
 fi
@@ -1,9 +1,77 @@
 #include <jni.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "../../../shared/include/fastembed.h"
 
+/*
+ * Pinned array access for the compute-only calls below.
+ *
+ * GetPrimitiveArrayCritical normally hands out the Java heap storage itself,
+ * where Get<Type>ArrayElements usually copies the array in (and back out on
+ * release). While any array is held no JNI call may be made and the GC may be
+ * held off, so only pure native compute runs between critical_acquire() and
+ * critical_release(). Long ONNX inference keeps using non-critical access.
+ */
+#define FASTEMBED_JNI_MAX_CRITICAL 5
+
+typedef struct
+{
+    jarray arrays[FASTEMBED_JNI_MAX_CRITICAL];
+    void *data[FASTEMBED_JNI_MAX_CRITICAL];
+    int writable[FASTEMBED_JNI_MAX_CRITICAL];
+    int count;
+    int failed;
+} critical_arrays_t;
+
+/* Pin array (NULL, and every later acquire fails, if it is null or pinning
+ * fails; release the set without making other JNI calls first) */
+static void *critical_acquire(JNIEnv *env, critical_arrays_t *held, jarray array, int writable)
+{
+    if (held->failed || array == NULL || held->count == FASTEMBED_JNI_MAX_CRITICAL)
+    {
+        held->failed = 1;
+        return NULL;
+    }
+
+    void *data = (*env)->GetPrimitiveArrayCritical(env, array, NULL);
+    if (data == NULL)
+    {
+        held->failed = 1; // OutOfMemoryError pending
+        return NULL;
+    }
+    held->arrays[held->count] = array;
+    held->data[held->count] = data;
+    held->writable[held->count] = writable;
+    held->count++;
+    return data;
+}
+
+/* Unpin in reverse order; writable arrays keep their contents when commit is
+ * set (which only matters if the VM handed out a copy) */
+static void critical_release(JNIEnv *env, critical_arrays_t *held, int commit)
+{
+    while (held->count > 0)
+    {
+        held->count--;
+        jint mode = held->writable[held->count] && commit ? 0 : JNI_ABORT;
+        (*env)->ReleasePrimitiveArrayCritical(env, held->arrays[held->count], held->data[held->count], mode);
+    }
+}
+
+/* Address of element offset (of element_size bytes) of a direct NIO buffer,
+ * NULL if buffer is null or not direct */
+static void *direct_address(JNIEnv *env, jobject buffer, jint offset, size_t element_size)
+{
+    if (buffer == NULL || offset < 0)
+    {
+        return NULL;
+    }
+    char *base = (char *)(*env)->GetDirectBufferAddress(env, buffer);
+    return base != NULL ? base + (size_t)offset * element_size : NULL;
+}
+
 /*
  * Class:     com_fastembed_FastEmbed
  * Method:    nativeGenerateEmbedding
@@ -18,10 +86,12 @@ JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeGenerateEmbedding(JNIE
         return -1; // OutOfMemoryError already thrown
     }
 
-    // Get output array
-    jfloat *output_c = (*env)->GetFloatArrayElements(env, output, NULL);
+    // Get output array (pinned: hashing does not call back into the VM)
+    critical_arrays_t held = {0};
+    jfloat *output_c = critical_acquire(env, &held, output, 1);
     if (output_c == NULL)
     {
+        critical_release(env, &held, 0);
         (*env)->ReleaseStringUTFChars(env, text, text_c);
         return -1; // OutOfMemoryError already thrown
     }
@@ -30,7 +100,7 @@ JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeGenerateEmbedding(JNIE
     int result = fastembed_generate(text_c, output_c, dimension);
 
     // Release resources
-    (*env)->ReleaseFloatArrayElements(env, output, output_c, 0);
+    critical_release(env, &held, 1);
     (*env)->ReleaseStringUTFChars(env, text, text_c);
 
     return result;
@@ -43,23 +113,18 @@ JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeGenerateEmbedding(JNIE
  */
 JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeCosineSimilarity(JNIEnv *env, jobject obj, jfloatArray vectorA, jfloatArray vectorB, jint dimension)
 {
-    jfloat *vecA = (*env)->GetFloatArrayElements(env, vectorA, NULL);
-    jfloat *vecB = (*env)->GetFloatArrayElements(env, vectorB, NULL);
-
-    if (vecA == NULL || vecB == NULL)
+    critical_arrays_t held = {0};
+    jfloat *vecA = critical_acquire(env, &held, vectorA, 0);
+    jfloat *vecB = critical_acquire(env, &held, vectorB, 0);
+    if (held.failed)
     {
-        if (vecA)
-            (*env)->ReleaseFloatArrayElements(env, vectorA, vecA, JNI_ABORT);
-        if (vecB)
-            (*env)->ReleaseFloatArrayElements(env, vectorB, vecB, JNI_ABORT);
+        critical_release(env, &held, 0);
         return 0.0f;
     }
 
     float result = fastembed_cosine_similarity(vecA, vecB, dimension);
 
-    (*env)->ReleaseFloatArrayElements(env, vectorA, vecA, JNI_ABORT);
-    (*env)->ReleaseFloatArrayElements(env, vectorB, vecB, JNI_ABORT);
-
+    critical_release(env, &held, 1);
     return result;
 }
 
@@ -70,23 +135,18 @@ JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeCosineSimilarity(JNI
  */
 JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeDotProduct(JNIEnv *env, jobject obj, jfloatArray vectorA, jfloatArray vectorB, jint dimension)
 {
-    jfloat *vecA = (*env)->GetFloatArrayElements(env, vectorA, NULL);
-    jfloat *vecB = (*env)->GetFloatArrayElements(env, vectorB, NULL);
-
-    if (vecA == NULL || vecB == NULL)
+    critical_arrays_t held = {0};
+    jfloat *vecA = critical_acquire(env, &held, vectorA, 0);
+    jfloat *vecB = critical_acquire(env, &held, vectorB, 0);
+    if (held.failed)
     {
-        if (vecA)
-            (*env)->ReleaseFloatArrayElements(env, vectorA, vecA, JNI_ABORT);
-        if (vecB)
-            (*env)->ReleaseFloatArrayElements(env, vectorB, vecB, JNI_ABORT);
+        critical_release(env, &held, 0);
         return 0.0f;
     }
 
     float result = fastembed_dot_product(vecA, vecB, dimension);
 
-    (*env)->ReleaseFloatArrayElements(env, vectorA, vecA, JNI_ABORT);
-    (*env)->ReleaseFloatArrayElements(env, vectorB, vecB, JNI_ABORT);
-
+    critical_release(env, &held, 1);
     return result;
 }
 
@@ -97,16 +157,17 @@ JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeDotProduct(JNIEnv *e
  */
 JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeVectorNorm(JNIEnv *env, jobject obj, jfloatArray vector, jint dimension)
 {
-    jfloat *vec = (*env)->GetFloatArrayElements(env, vector, NULL);
-    if (vec == NULL)
+    critical_arrays_t held = {0};
+    jfloat *vec = critical_acquire(env, &held, vector, 0);
+    if (held.failed)
     {
+        critical_release(env, &held, 0);
         return 0.0f;
     }
 
     float result = fastembed_vector_norm(vec, dimension);
 
-    (*env)->ReleaseFloatArrayElements(env, vector, vec, JNI_ABORT);
-
+    critical_release(env, &held, 1);
     return result;
 }
 
@@ -117,15 +178,17 @@ JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeVectorNorm(JNIEnv *e
  */
 JNIEXPORT void JNICALL Java_com_fastembed_FastEmbed_nativeNormalizeVector(JNIEnv *env, jobject obj, jfloatArray vector, jint dimension)
 {
-    jfloat *vec = (*env)->GetFloatArrayElements(env, vector, NULL);
-    if (vec == NULL)
+    critical_arrays_t held = {0};
+    jfloat *vec = critical_acquire(env, &held, vector, 1);
+    if (held.failed)
     {
+        critical_release(env, &held, 0);
         return;
     }
 
     fastembed_normalize(vec, dimension);
 
-    (*env)->ReleaseFloatArrayElements(env, vector, vec, 0);
+    critical_release(env, &held, 1);
 }
 
 /*
@@ -135,24 +198,770 @@ JNIEXPORT void JNICALL Java_com_fastembed_FastEmbed_nativeNormalizeVector(JNIEnv
  */
 JNIEXPORT void JNICALL Java_com_fastembed_FastEmbed_nativeAddVectors(JNIEnv *env, jobject obj, jfloatArray vectorA, jfloatArray vectorB, jfloatArray result, jint dimension)
 {
-    jfloat *vecA = (*env)->GetFloatArrayElements(env, vectorA, NULL);
-    jfloat *vecB = (*env)->GetFloatArrayElements(env, vectorB, NULL);
-    jfloat *vecResult = (*env)->GetFloatArrayElements(env, result, NULL);
-
-    if (vecA == NULL || vecB == NULL || vecResult == NULL)
+    critical_arrays_t held = {0};
+    jfloat *vecA = critical_acquire(env, &held, vectorA, 0);
+    jfloat *vecB = critical_acquire(env, &held, vectorB, 0);
+    jfloat *vecResult = critical_acquire(env, &held, result, 1);
+    if (held.failed)
     {
-        if (vecA)
-            (*env)->ReleaseFloatArrayElements(env, vectorA, vecA, JNI_ABORT);
-        if (vecB)
-            (*env)->ReleaseFloatArrayElements(env, vectorB, vecB, JNI_ABORT);
-        if (vecResult)
-            (*env)->ReleaseFloatArrayElements(env, result, vecResult, JNI_ABORT);
+        critical_release(env, &held, 0);
         return;
     }
 
     fastembed_add_vectors(vecA, vecB, vecResult, dimension);
 
-    (*env)->ReleaseFloatArrayElements(env, vectorA, vecA, JNI_ABORT);
-    (*env)->ReleaseFloatArrayElements(env, vectorB, vecB, JNI_ABORT);
-    (*env)->ReleaseFloatArrayElements(env, result, vecResult, 0);
+    critical_release(env, &held, 1);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeOpen
+ * Signature: (Ljava/lang/String;IIIZZ[IILjava/lang/String;Ljava/lang/String;I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_fastembed_OnnxModel_nativeOpen(JNIEnv *env, jclass cls, jstring modelPath, jint intraOpThreads, jint interOpThreads, jint graphOptLevel, jboolean enableMemPattern, jboolean enableCpuMemArena, jintArray executionProviders, jint deviceId, jstring optimizedModelPath, jstring tokenizerPath, jint pooling)
+{
+    fastembed_onnx_options_t options;
+    fastembed_onnx_options_init(&options);
+    options.intra_op_threads = intraOpThreads;
+    options.inter_op_threads = interOpThreads;
+    options.graph_opt_level = graphOptLevel;
+    options.enable_mem_pattern = enableMemPattern ? 1 : 0;
+    options.enable_cpu_mem_arena = enableCpuMemArena ? 1 : 0;
+    options.device_id = deviceId;
+    options.pooling = pooling;
+
+    if (executionProviders != NULL)
+    {
+        jsize count = (*env)->GetArrayLength(env, executionProviders);
+        if (count > FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS)
+        {
+            return 0;
+        }
+        (*env)->GetIntArrayRegion(env, executionProviders, 0, count, (jint *)options.execution_providers);
+        options.num_execution_providers = (int)count;
+    }
+
+    const char *path_c = (*env)->GetStringUTFChars(env, modelPath, NULL);
+    if (path_c == NULL)
+    {
+        return 0; // OutOfMemoryError already thrown
+    }
+
+    const char *optimized_c = NULL;
+    if (optimizedModelPath != NULL)
+    {
+        optimized_c = (*env)->GetStringUTFChars(env, optimizedModelPath, NULL);
+        if (optimized_c == NULL)
+        {
+            (*env)->ReleaseStringUTFChars(env, modelPath, path_c);
+            return 0; // OutOfMemoryError already thrown
+        }
+        options.optimized_model_path = optimized_c;
+    }
+
+    const char *tokenizer_c = NULL;
+    if (tokenizerPath != NULL)
+    {
+        tokenizer_c = (*env)->GetStringUTFChars(env, tokenizerPath, NULL);
+        if (tokenizer_c == NULL)
+        {
+            if (optimized_c != NULL)
+                (*env)->ReleaseStringUTFChars(env, optimizedModelPath, optimized_c);
+            (*env)->ReleaseStringUTFChars(env, modelPath, path_c);
+            return 0; // OutOfMemoryError already thrown
+        }
+        options.tokenizer_path = tokenizer_c;
+    }
+
+    // The registry copies the options, so the strings can be released
+    fastembed_model_t *model = fastembed_model_open_with_options(path_c, &options);
+
+    if (tokenizer_c != NULL)
+        (*env)->ReleaseStringUTFChars(env, tokenizerPath, tokenizer_c);
+    if (optimized_c != NULL)
+        (*env)->ReleaseStringUTFChars(env, optimizedModelPath, optimized_c);
+    (*env)->ReleaseStringUTFChars(env, modelPath, path_c);
+
+    return (jlong)(intptr_t)model;
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeClose
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_fastembed_OnnxModel_nativeClose(JNIEnv *env, jclass cls, jlong handle)
+{
+    fastembed_model_close((fastembed_model_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeGetDimension
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_OnnxModel_nativeGetDimension(JNIEnv *env, jclass cls, jlong handle)
+{
+    return fastembed_model_get_dimension((const fastembed_model_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeGetExecutionProvider
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_OnnxModel_nativeGetExecutionProvider(JNIEnv *env, jclass cls, jlong handle)
+{
+    return fastembed_model_get_execution_provider((const fastembed_model_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeGenerate
+ * Signature: (JLjava/lang/String;[F)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_OnnxModel_nativeGenerate(JNIEnv *env, jclass cls, jlong handle, jstring text, jfloatArray output)
+{
+    const char *text_c = (*env)->GetStringUTFChars(env, text, NULL);
+    if (text_c == NULL)
+    {
+        return -1; // OutOfMemoryError already thrown
+    }
+
+    // Inference is too long to pin the array: run into native memory and copy
+    // the result out once
+    jint dimension = (*env)->GetArrayLength(env, output);
+    float *output_c = (float *)malloc((size_t)(dimension > 0 ? dimension : 1) * sizeof(float));
+    if (output_c == NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, text, text_c);
+        return -1;
+    }
+
+    int result = fastembed_model_generate((fastembed_model_t *)(intptr_t)handle, text_c, output_c, dimension);
+    (*env)->ReleaseStringUTFChars(env, text, text_c);
+
+    if (result == 0)
+    {
+        (*env)->SetFloatArrayRegion(env, output, 0, dimension, output_c);
+    }
+    free(output_c);
+
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeGetLastError
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_fastembed_OnnxModel_nativeGetLastError(JNIEnv *env, jclass cls)
+{
+    char error[512];
+    if (fastembed_onnx_get_last_error(error, sizeof(error)) != 0)
+    {
+        strcpy(error, "unknown error");
+    }
+    return (*env)->NewStringUTF(env, error);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeStatsSnapshotJson
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_fastembed_OnnxModel_nativeStatsSnapshotJson(JNIEnv *env, jclass cls)
+{
+    // Counters may grow between the two calls: retry until the buffer fits
+    char *json = NULL;
+    int length = fastembed_stats_snapshot_json(NULL, 0);
+    while (length >= 0)
+    {
+        size_t size = (size_t)length + 64;
+        free(json);
+        json = malloc(size);
+        if (json == NULL)
+        {
+            return NULL;
+        }
+        length = fastembed_stats_snapshot_json(json, size);
+        if (length >= 0 && (size_t)length < size)
+        {
+            break;
+        }
+    }
+    if (length < 0)
+    {
+        free(json);
+        return NULL;
+    }
+
+    jstring result = (*env)->NewStringUTF(env, json); // ASCII only
+    free(json);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeWarmup
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_OnnxModel_nativeWarmup(JNIEnv *env, jclass cls, jlong handle)
+{
+    return fastembed_model_warmup((fastembed_model_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativePreload
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_OnnxModel_nativePreload(JNIEnv *env, jclass cls, jstring modelPath)
+{
+    const char *path_c = (*env)->GetStringUTFChars(env, modelPath, NULL);
+    if (path_c == NULL)
+    {
+        return -1; // OutOfMemoryError already thrown
+    }
+
+    int result = fastembed_onnx_preload(path_c, NULL);
+    (*env)->ReleaseStringUTFChars(env, modelPath, path_c);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeStatsReset
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_com_fastembed_OnnxModel_nativeStatsReset(JNIEnv *env, jclass cls)
+{
+    fastembed_stats_reset();
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeStatsSetEnabled
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_fastembed_OnnxModel_nativeStatsSetEnabled(JNIEnv *env, jclass cls, jboolean enabled)
+{
+    fastembed_stats_set_enabled(enabled ? 1 : 0);
+}
+
+/*
+ * Class:     com_fastembed_OnnxModel
+ * Method:    nativeBatchGenerateDirect
+ * Signature: (JLjava/nio/ByteBuffer;ILjava/nio/IntBuffer;IILjava/nio/FloatBuffer;IILjava/nio/IntBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_OnnxModel_nativeBatchGenerateDirect(JNIEnv *env, jclass cls, jlong handle, jobject textData, jint textOffset, jobject offsets, jint offsetsOffset, jint numTexts, jobject output, jint outputOffset, jint dimension, jobject statuses, jint statusesOffset, jint threads)
+{
+    const char *text_c = direct_address(env, textData, textOffset, 1);
+    const int32_t *offsets_c = direct_address(env, offsets, offsetsOffset, sizeof(int32_t));
+    float *output_c = direct_address(env, output, outputOffset, sizeof(float));
+    int *statuses_c = direct_address(env, statuses, statusesOffset, sizeof(int));
+    if (text_c == NULL || offsets_c == NULL || output_c == NULL || (statuses != NULL && statuses_c == NULL))
+    {
+        return -1;
+    }
+
+    return fastembed_model_batch_generate_contiguous((fastembed_model_t *)(intptr_t)handle, text_c, offsets_c, numTexts, output_c, dimension, statuses_c, threads);
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeSimilarityMatrix
+ * Signature: ([FI[FII[FII)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeSimilarityMatrix(JNIEnv *env, jobject obj, jfloatArray queries, jint numQueries, jfloatArray corpus, jint numCorpus, jint dimension, jfloatArray output, jint metric, jint threads)
+{
+    critical_arrays_t held = {0};
+    jfloat *queries_c = critical_acquire(env, &held, queries, 0);
+    jfloat *corpus_c = critical_acquire(env, &held, corpus, 0);
+    jfloat *output_c = critical_acquire(env, &held, output, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int result = fastembed_similarity_matrix_threaded(queries_c, numQueries, corpus_c, numCorpus, dimension, output_c, metric, threads);
+
+    critical_release(env, &held, result == 0);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeTopK
+ * Signature: ([F[FIII[I[FII)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeTopK(JNIEnv *env, jobject obj, jfloatArray query, jfloatArray corpus, jint numCorpus, jint dimension, jint k, jintArray ids, jfloatArray scores, jint metric, jint threads)
+{
+    critical_arrays_t held = {0};
+    jfloat *query_c = critical_acquire(env, &held, query, 0);
+    jfloat *corpus_c = critical_acquire(env, &held, corpus, 0);
+    jint *ids_c = critical_acquire(env, &held, ids, 1);
+    jfloat *scores_c = critical_acquire(env, &held, scores, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_topk_threaded(query_c, corpus_c, numCorpus, dimension, k, (int *)ids_c, scores_c, metric, threads);
+
+    critical_release(env, &held, count >= 0);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeQuantizeInt8
+ * Signature: ([FII[B[F)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeQuantizeInt8(JNIEnv *env, jobject obj, jfloatArray vectors, jint numVectors, jint dimension, jbyteArray codes, jfloatArray scales)
+{
+    critical_arrays_t held = {0};
+    jfloat *vectors_c = critical_acquire(env, &held, vectors, 0);
+    jbyte *codes_c = critical_acquire(env, &held, codes, 1);
+    jfloat *scales_c = critical_acquire(env, &held, scales, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int result = fastembed_quantize_int8(vectors_c, numVectors, dimension, (int8_t *)codes_c, scales_c);
+
+    critical_release(env, &held, result == 0);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeQuantizeBinary
+ * Signature: ([FII[B)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeQuantizeBinary(JNIEnv *env, jobject obj, jfloatArray vectors, jint numVectors, jint dimension, jbyteArray bits)
+{
+    critical_arrays_t held = {0};
+    jfloat *vectors_c = critical_acquire(env, &held, vectors, 0);
+    jbyte *bits_c = critical_acquire(env, &held, bits, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int result = fastembed_quantize_binary(vectors_c, numVectors, dimension, (uint8_t *)bits_c);
+
+    critical_release(env, &held, result == 0);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeTopKInt8
+ * Signature: ([BF[B[FIII[I[FI)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeTopKInt8(JNIEnv *env, jobject obj, jbyteArray queryCodes, jfloat queryScale, jbyteArray corpusCodes, jfloatArray corpusScales, jint numCorpus, jint dimension, jint k, jintArray ids, jfloatArray scores, jint threads)
+{
+    critical_arrays_t held = {0};
+    jbyte *query_c = critical_acquire(env, &held, queryCodes, 0);
+    jbyte *corpus_c = critical_acquire(env, &held, corpusCodes, 0);
+    jfloat *corpus_scales_c = critical_acquire(env, &held, corpusScales, 0);
+    jint *ids_c = critical_acquire(env, &held, ids, 1);
+    jfloat *scores_c = critical_acquire(env, &held, scores, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_topk_int8((const int8_t *)query_c, queryScale, (const int8_t *)corpus_c, corpus_scales_c, numCorpus, dimension, k, (int *)ids_c, scores_c, threads);
+
+    critical_release(env, &held, count >= 0);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeTopKBinary
+ * Signature: ([B[BIII[I[II)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeTopKBinary(JNIEnv *env, jobject obj, jbyteArray queryBits, jbyteArray corpusBits, jint numCorpus, jint dimension, jint k, jintArray ids, jintArray distances, jint threads)
+{
+    critical_arrays_t held = {0};
+    jbyte *query_c = critical_acquire(env, &held, queryBits, 0);
+    jbyte *corpus_c = critical_acquire(env, &held, corpusBits, 0);
+    jint *ids_c = critical_acquire(env, &held, ids, 1);
+    jint *distances_c = critical_acquire(env, &held, distances, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_topk_binary((const uint8_t *)query_c, (const uint8_t *)corpus_c, numCorpus, dimension, k, (int *)ids_c, (int *)distances_c, threads);
+
+    critical_release(env, &held, count >= 0);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeRescore
+ * Signature: ([F[FII[IIII[I[FI)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeRescore(JNIEnv *env, jobject obj, jfloatArray query, jfloatArray corpus, jint numCorpus, jint dimension, jintArray candidates, jint numCandidates, jint k, jintArray ids, jfloatArray scores, jint metric)
+{
+    critical_arrays_t held = {0};
+    jfloat *query_c = critical_acquire(env, &held, query, 0);
+    jfloat *corpus_c = critical_acquire(env, &held, corpus, 0);
+    jint *candidates_c = critical_acquire(env, &held, candidates, 0);
+    jint *ids_c = critical_acquire(env, &held, ids, 1);
+    jfloat *scores_c = critical_acquire(env, &held, scores, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_topk_rescore(query_c, corpus_c, numCorpus, dimension, (const int *)candidates_c, numCandidates, k, (int *)ids_c, scores_c, metric);
+
+    critical_release(env, &held, count >= 0);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeToHalf
+ * Signature: ([F[SII)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeToHalf(JNIEnv *env, jobject obj, jfloatArray vectors, jshortArray halves, jint count, jint format)
+{
+    critical_arrays_t held = {0};
+    jfloat *vectors_c = critical_acquire(env, &held, vectors, 0);
+    jshort *halves_c = critical_acquire(env, &held, halves, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int result = format == FASTEMBED_QUANT_BF16
+                     ? fastembed_f32_to_bf16(vectors_c, (uint16_t *)halves_c, count)
+                     : fastembed_f32_to_f16(vectors_c, (uint16_t *)halves_c, count);
+
+    critical_release(env, &held, result == 0);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeFromHalf
+ * Signature: ([S[FII)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeFromHalf(JNIEnv *env, jobject obj, jshortArray halves, jfloatArray floats, jint count, jint format)
+{
+    critical_arrays_t held = {0};
+    jshort *halves_c = critical_acquire(env, &held, halves, 0);
+    jfloat *floats_c = critical_acquire(env, &held, floats, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int result = format == FASTEMBED_QUANT_BF16
+                     ? fastembed_bf16_to_f32((const uint16_t *)halves_c, floats_c, count)
+                     : fastembed_f16_to_f32((const uint16_t *)halves_c, floats_c, count);
+
+    critical_release(env, &held, result == 0);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeTopKHalf
+ * Signature: ([F[SIIII[I[FII)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeTopKHalf(JNIEnv *env, jobject obj, jfloatArray query, jshortArray corpus, jint format, jint numCorpus, jint dimension, jint k, jintArray ids, jfloatArray scores, jint metric, jint threads)
+{
+    critical_arrays_t held = {0};
+    jfloat *query_c = critical_acquire(env, &held, query, 0);
+    jshort *corpus_c = critical_acquire(env, &held, corpus, 0);
+    jint *ids_c = critical_acquire(env, &held, ids, 1);
+    jfloat *scores_c = critical_acquire(env, &held, scores, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_topk_half(query_c, (const uint16_t *)corpus_c, format, numCorpus, dimension, k, (int *)ids_c, scores_c, metric, threads);
+
+    critical_release(env, &held, count >= 0);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeCosineSimilarityDirect
+ * Signature: (Ljava/nio/FloatBuffer;ILjava/nio/FloatBuffer;II)F
+ */
+JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeCosineSimilarityDirect(JNIEnv *env, jobject obj, jobject vectorA, jint offsetA, jobject vectorB, jint offsetB, jint dimension)
+{
+    const float *vecA = direct_address(env, vectorA, offsetA, sizeof(float));
+    const float *vecB = direct_address(env, vectorB, offsetB, sizeof(float));
+    if (vecA == NULL || vecB == NULL)
+    {
+        return 0.0f;
+    }
+
+    return fastembed_cosine_similarity(vecA, vecB, dimension);
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeDotProductDirect
+ * Signature: (Ljava/nio/FloatBuffer;ILjava/nio/FloatBuffer;II)F
+ */
+JNIEXPORT jfloat JNICALL Java_com_fastembed_FastEmbed_nativeDotProductDirect(JNIEnv *env, jobject obj, jobject vectorA, jint offsetA, jobject vectorB, jint offsetB, jint dimension)
+{
+    const float *vecA = direct_address(env, vectorA, offsetA, sizeof(float));
+    const float *vecB = direct_address(env, vectorB, offsetB, sizeof(float));
+    if (vecA == NULL || vecB == NULL)
+    {
+        return 0.0f;
+    }
+
+    return fastembed_dot_product(vecA, vecB, dimension);
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeSimilarityMatrixDirect
+ * Signature: (Ljava/nio/FloatBuffer;IILjava/nio/FloatBuffer;IIILjava/nio/FloatBuffer;III)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeSimilarityMatrixDirect(JNIEnv *env, jobject obj, jobject queries, jint queriesOffset, jint numQueries, jobject corpus, jint corpusOffset, jint numCorpus, jint dimension, jobject output, jint outputOffset, jint metric, jint threads)
+{
+    const float *queries_c = direct_address(env, queries, queriesOffset, sizeof(float));
+    const float *corpus_c = direct_address(env, corpus, corpusOffset, sizeof(float));
+    float *output_c = direct_address(env, output, outputOffset, sizeof(float));
+    if (queries_c == NULL || corpus_c == NULL || output_c == NULL)
+    {
+        return -1;
+    }
+
+    return fastembed_similarity_matrix_threaded(queries_c, numQueries, corpus_c, numCorpus, dimension, output_c, metric, threads);
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeTopKDirect
+ * Signature: (Ljava/nio/FloatBuffer;ILjava/nio/FloatBuffer;IIII[I[FII)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeTopKDirect(JNIEnv *env, jobject obj, jobject query, jint queryOffset, jobject corpus, jint corpusOffset, jint numCorpus, jint dimension, jint k, jintArray ids, jfloatArray scores, jint metric, jint threads)
+{
+    const float *query_c = direct_address(env, query, queryOffset, sizeof(float));
+    const float *corpus_c = direct_address(env, corpus, corpusOffset, sizeof(float));
+    if (query_c == NULL || corpus_c == NULL)
+    {
+        return -1;
+    }
+
+    critical_arrays_t held = {0};
+    jint *ids_c = critical_acquire(env, &held, ids, 1);
+    jfloat *scores_c = critical_acquire(env, &held, scores, 1);
+    if (held.failed)
+    {
+        critical_release(env, &held, 0);
+        return -1; // Null array, or OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_topk_threaded(query_c, corpus_c, numCorpus, dimension, k, (int *)ids_c, scores_c, metric, threads);
+
+    critical_release(env, &held, count >= 0);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_FastEmbed
+ * Method:    nativeBatchGenerateDirect
+ * Signature: (Ljava/nio/ByteBuffer;ILjava/nio/IntBuffer;IILjava/nio/FloatBuffer;IILjava/nio/IntBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_FastEmbed_nativeBatchGenerateDirect(JNIEnv *env, jobject obj, jobject textData, jint textOffset, jobject offsets, jint offsetsOffset, jint numTexts, jobject output, jint outputOffset, jint dimension, jobject statuses, jint statusesOffset, jint threads)
+{
+    const char *text_c = direct_address(env, textData, textOffset, 1);
+    const int32_t *offsets_c = direct_address(env, offsets, offsetsOffset, sizeof(int32_t));
+    float *output_c = direct_address(env, output, outputOffset, sizeof(float));
+    int *statuses_c = direct_address(env, statuses, statusesOffset, sizeof(int));
+    if (text_c == NULL || offsets_c == NULL || output_c == NULL || (statuses != NULL && statuses_c == NULL))
+    {
+        return -1;
+    }
+
+    return fastembed_batch_generate_contiguous(text_c, offsets_c, numTexts, output_c, dimension, statuses_c, threads);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeCreate
+ * Signature: (IIIIII)J
+ */
+JNIEXPORT jlong JNICALL Java_com_fastembed_HnswIndex_nativeCreate(JNIEnv *env, jclass cls, jint dimension, jint m, jint efConstruction, jint efSearch, jint metric, jint seed)
+{
+    fastembed_hnsw_options_t options;
+    fastembed_hnsw_options_init(&options);
+    options.m = m;
+    options.ef_construction = efConstruction;
+    options.ef_search = efSearch;
+    options.metric = metric;
+    options.seed = (unsigned int)seed;
+
+    return (jlong)(intptr_t)fastembed_hnsw_create(dimension, &options);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeLoad
+ * Signature: (Ljava/lang/String;Z)J
+ */
+JNIEXPORT jlong JNICALL Java_com_fastembed_HnswIndex_nativeLoad(JNIEnv *env, jclass cls, jstring path, jboolean mmap)
+{
+    const char *path_c = (*env)->GetStringUTFChars(env, path, NULL);
+    if (path_c == NULL)
+    {
+        return 0; // OutOfMemoryError already thrown
+    }
+
+    fastembed_hnsw_t *index = mmap ? fastembed_hnsw_load_mmap(path_c) : fastembed_hnsw_load(path_c);
+
+    (*env)->ReleaseStringUTFChars(env, path, path_c);
+    return (jlong)(intptr_t)index;
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeFree
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_fastembed_HnswIndex_nativeFree(JNIEnv *env, jclass cls, jlong handle)
+{
+    fastembed_hnsw_free((fastembed_hnsw_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeAddBatch
+ * Signature: (J[FI[II)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeAddBatch(JNIEnv *env, jclass cls, jlong handle, jfloatArray vectors, jint numVectors, jintArray ids, jint threads)
+{
+    jfloat *vectors_c = (*env)->GetFloatArrayElements(env, vectors, NULL);
+    jint *ids_c = (*env)->GetIntArrayElements(env, ids, NULL);
+    if (vectors_c == NULL || ids_c == NULL)
+    {
+        if (vectors_c)
+            (*env)->ReleaseFloatArrayElements(env, vectors, vectors_c, JNI_ABORT);
+        if (ids_c)
+            (*env)->ReleaseIntArrayElements(env, ids, ids_c, JNI_ABORT);
+        return -1; // OutOfMemoryError already thrown
+    }
+
+    int result = fastembed_hnsw_add_batch((fastembed_hnsw_t *)(intptr_t)handle, vectors_c, numVectors, (int *)ids_c, threads);
+
+    (*env)->ReleaseFloatArrayElements(env, vectors, vectors_c, JNI_ABORT);
+    (*env)->ReleaseIntArrayElements(env, ids, ids_c, result == 0 ? 0 : JNI_ABORT);
+    return result;
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeRemove
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeRemove(JNIEnv *env, jclass cls, jlong handle, jint id)
+{
+    return fastembed_hnsw_remove((fastembed_hnsw_t *)(intptr_t)handle, id);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeSearch
+ * Signature: (J[FI[I[F)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeSearch(JNIEnv *env, jclass cls, jlong handle, jfloatArray query, jint k, jintArray ids, jfloatArray scores)
+{
+    jfloat *query_c = (*env)->GetFloatArrayElements(env, query, NULL);
+    jint *ids_c = (*env)->GetIntArrayElements(env, ids, NULL);
+    jfloat *scores_c = (*env)->GetFloatArrayElements(env, scores, NULL);
+    if (query_c == NULL || ids_c == NULL || scores_c == NULL)
+    {
+        if (query_c)
+            (*env)->ReleaseFloatArrayElements(env, query, query_c, JNI_ABORT);
+        if (ids_c)
+            (*env)->ReleaseIntArrayElements(env, ids, ids_c, JNI_ABORT);
+        if (scores_c)
+            (*env)->ReleaseFloatArrayElements(env, scores, scores_c, JNI_ABORT);
+        return -1; // OutOfMemoryError already thrown
+    }
+
+    int count = fastembed_hnsw_search((fastembed_hnsw_t *)(intptr_t)handle, query_c, k, (int *)ids_c, scores_c);
+
+    (*env)->ReleaseFloatArrayElements(env, query, query_c, JNI_ABORT);
+    (*env)->ReleaseIntArrayElements(env, ids, ids_c, count >= 0 ? 0 : JNI_ABORT);
+    (*env)->ReleaseFloatArrayElements(env, scores, scores_c, count >= 0 ? 0 : JNI_ABORT);
+    return count;
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeSetEfSearch
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeSetEfSearch(JNIEnv *env, jclass cls, jlong handle, jint efSearch)
+{
+    return fastembed_hnsw_set_ef_search((fastembed_hnsw_t *)(intptr_t)handle, efSearch);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeSize(JNIEnv *env, jclass cls, jlong handle)
+{
+    return fastembed_hnsw_size((const fastembed_hnsw_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeDimension
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeDimension(JNIEnv *env, jclass cls, jlong handle)
+{
+    return fastembed_hnsw_dimension((const fastembed_hnsw_t *)(intptr_t)handle);
+}
+
+/*
+ * Class:     com_fastembed_HnswIndex
+ * Method:    nativeSave
+ * Signature: (JLjava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_fastembed_HnswIndex_nativeSave(JNIEnv *env, jclass cls, jlong handle, jstring path)
+{
+    const char *path_c = (*env)->GetStringUTFChars(env, path, NULL);
+    if (path_c == NULL)
+    {
+        return -1; // OutOfMemoryError already thrown
+    }
+
+    int result = fastembed_hnsw_save((fastembed_hnsw_t *)(intptr_t)handle, path_c);
+
+    (*env)->ReleaseStringUTFChars(env, path, path_c);
+    return result;
 }
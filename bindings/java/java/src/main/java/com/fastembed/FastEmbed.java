@@ -3,6 +3,10 @@ package com.fastembed;
 import java.io.File;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 import java.nio.file.Files;
 import java.nio.file.StandardCopyOption;
 
@@ -205,6 +209,458 @@ public class FastEmbed {
         return result;
     }
 
+    /**
+     * Score every query against every corpus vector in one native call
+     * 
+     * @param queries Row-major queries, a multiple of the dimension in length
+     * @param corpus  Row-major corpus, a multiple of the dimension in length
+     * @param metric  Scoring function
+     * @param threads Worker threads (0 = all CPUs)
+     * @return Row-major [numQueries x numCorpus] scores
+     * @throws IllegalArgumentException if a matrix is invalid
+     * @throws FastEmbedException       if scoring fails
+     */
+    public float[] similarityMatrix(float[] queries, float[] corpus, SimilarityMetric metric, int threads) {
+        int numQueries = validateMatrix(queries, "Queries");
+        int numCorpus = validateMatrix(corpus, "Corpus");
+        if (metric == null) {
+            throw new IllegalArgumentException("Metric cannot be null");
+        }
+        if ((long) numQueries * numCorpus > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("Similarity matrix too large");
+        }
+
+        float[] output = new float[numQueries * numCorpus];
+        int result = nativeSimilarityMatrix(queries, numQueries, corpus, numCorpus, dimension, output,
+                metric.getCode(), threads);
+        if (result != 0) {
+            throw new FastEmbedException("Failed to compute similarity matrix (error code: " + result + ")");
+        }
+        return output;
+    }
+
+    /**
+     * Score every query against every corpus vector by cosine similarity on
+     * the calling thread
+     * 
+     * @param queries Row-major queries, a multiple of the dimension in length
+     * @param corpus  Row-major corpus, a multiple of the dimension in length
+     * @return Row-major [numQueries x numCorpus] scores
+     * @see #similarityMatrix(float[], float[], SimilarityMetric, int)
+     */
+    public float[] similarityMatrix(float[] queries, float[] corpus) {
+        return similarityMatrix(queries, corpus, SimilarityMetric.COSINE, 1);
+    }
+
+    /**
+     * Find the k corpus vectors most similar to a query (exact search)
+     * 
+     * @param query   Query vector
+     * @param corpus  Row-major corpus, a multiple of the dimension in length
+     * @param k       Number of results (fewer if the corpus is smaller)
+     * @param metric  Scoring function ({@code EUCLIDEAN} returns the nearest
+     *                vectors)
+     * @param threads Worker threads (0 = all CPUs)
+     * @return Row indices and scores, best first
+     * @throws IllegalArgumentException if the query, corpus or k is invalid
+     * @throws FastEmbedException       if the search fails
+     */
+    public TopKResult topK(float[] query, float[] corpus, int k, SimilarityMetric metric, int threads) {
+        validateVector(query);
+        int numCorpus = validateMatrix(corpus, "Corpus");
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+        if (metric == null) {
+            throw new IllegalArgumentException("Metric cannot be null");
+        }
+
+        int capacity = Math.min(k, numCorpus);
+        int[] ids = new int[capacity];
+        float[] scores = new float[capacity];
+        int count = nativeTopK(query, corpus, numCorpus, dimension, capacity, ids, scores, metric.getCode(),
+                threads);
+        if (count < 0) {
+            throw new FastEmbedException("Failed to compute top-k (error code: " + count + ")");
+        }
+        return new TopKResult(ids, scores);
+    }
+
+    /**
+     * Find the k corpus vectors with the highest cosine similarity on the
+     * calling thread
+     * 
+     * @param query  Query vector
+     * @param corpus Row-major corpus, a multiple of the dimension in length
+     * @param k      Number of results
+     * @return Row indices and scores, best first
+     * @see #topK(float[], float[], int, SimilarityMetric, int)
+     */
+    public TopKResult topK(float[] query, float[] corpus, int k) {
+        return topK(query, corpus, k, SimilarityMetric.COSINE, 1);
+    }
+
+    /**
+     * Calculate cosine similarity between two vectors in direct buffers
+     * 
+     * Reads {@link #getDimension()} floats from each buffer's position without
+     * copying; buffer positions are left unchanged.
+     * 
+     * @param vectorA First vector (direct, native order)
+     * @param vectorB Second vector (direct, native order)
+     * @return Cosine similarity in range [-1, 1]
+     * @throws IllegalArgumentException if a buffer is invalid
+     * @see #allocateFloats(int)
+     */
+    public float cosineSimilarity(FloatBuffer vectorA, FloatBuffer vectorB) {
+        requireDirect(vectorA, dimension, "Vector A");
+        requireDirect(vectorB, dimension, "Vector B");
+        return nativeCosineSimilarityDirect(vectorA, vectorA.position(), vectorB, vectorB.position(), dimension);
+    }
+
+    /**
+     * Calculate dot product of two vectors in direct buffers
+     * 
+     * @param vectorA First vector (direct, native order)
+     * @param vectorB Second vector (direct, native order)
+     * @return Dot product
+     * @throws IllegalArgumentException if a buffer is invalid
+     * @see #cosineSimilarity(FloatBuffer, FloatBuffer)
+     */
+    public float dotProduct(FloatBuffer vectorA, FloatBuffer vectorB) {
+        requireDirect(vectorA, dimension, "Vector A");
+        requireDirect(vectorB, dimension, "Vector B");
+        return nativeDotProductDirect(vectorA, vectorA.position(), vectorB, vectorB.position(), dimension);
+    }
+
+    /**
+     * Score every query against every corpus vector, reading and writing
+     * direct buffers in place
+     * 
+     * @param queries    Row-major queries (direct, native order)
+     * @param numQueries Number of query rows
+     * @param corpus     Row-major corpus (direct, native order)
+     * @param numCorpus  Number of corpus rows
+     * @param output     Receives row-major [numQueries x numCorpus] scores
+     *                   (direct, native order)
+     * @param metric     Scoring function
+     * @param threads    Worker threads (0 = all CPUs)
+     * @throws IllegalArgumentException if a buffer is invalid or too small
+     * @throws FastEmbedException       if scoring fails
+     */
+    public void similarityMatrix(FloatBuffer queries, int numQueries, FloatBuffer corpus, int numCorpus,
+            FloatBuffer output, SimilarityMetric metric, int threads) {
+        if (numQueries <= 0 || numCorpus <= 0) {
+            throw new IllegalArgumentException("Row counts must be positive");
+        }
+        if (metric == null) {
+            throw new IllegalArgumentException("Metric cannot be null");
+        }
+        requireDirect(queries, (long) numQueries * dimension, "Queries");
+        requireDirect(corpus, (long) numCorpus * dimension, "Corpus");
+        requireDirect(output, (long) numQueries * numCorpus, "Output");
+
+        int result = nativeSimilarityMatrixDirect(queries, queries.position(), numQueries, corpus,
+                corpus.position(), numCorpus, dimension, output, output.position(), metric.getCode(), threads);
+        if (result != 0) {
+            throw new FastEmbedException("Failed to compute similarity matrix (error code: " + result + ")");
+        }
+    }
+
+    /**
+     * Find the k corpus vectors most similar to a query, reading direct
+     * buffers in place
+     * 
+     * @param query     Query vector (direct, native order)
+     * @param corpus    Row-major corpus (direct, native order)
+     * @param numCorpus Number of corpus rows
+     * @param k         Number of results (fewer if the corpus is smaller)
+     * @param metric    Scoring function
+     * @param threads   Worker threads (0 = all CPUs)
+     * @return Row indices and scores, best first
+     * @throws IllegalArgumentException if a buffer, numCorpus or k is invalid
+     * @throws FastEmbedException       if the search fails
+     */
+    public TopKResult topK(FloatBuffer query, FloatBuffer corpus, int numCorpus, int k, SimilarityMetric metric,
+            int threads) {
+        if (numCorpus <= 0) {
+            throw new IllegalArgumentException("Corpus row count must be positive");
+        }
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+        if (metric == null) {
+            throw new IllegalArgumentException("Metric cannot be null");
+        }
+        requireDirect(query, dimension, "Query");
+        requireDirect(corpus, (long) numCorpus * dimension, "Corpus");
+
+        int capacity = Math.min(k, numCorpus);
+        int[] ids = new int[capacity];
+        float[] scores = new float[capacity];
+        int count = nativeTopKDirect(query, query.position(), corpus, corpus.position(), numCorpus, dimension,
+                capacity, ids, scores, metric.getCode(), threads);
+        if (count < 0) {
+            throw new FastEmbedException("Failed to compute top-k (error code: " + count + ")");
+        }
+        return new TopKResult(ids, scores);
+    }
+
+    /**
+     * Quantize vectors to int8 with one scale per vector (x ~ code * scale)
+     * 
+     * @param vectors Row-major vectors, a multiple of the dimension in length
+     * @return Row-major codes in [-127, 127] and one scale per vector
+     * @throws IllegalArgumentException if vectors is empty or not a multiple of
+     *                                  the dimension
+     * @throws FastEmbedException       if quantization fails
+     */
+    public Int8Vectors quantizeInt8(float[] vectors) {
+        int numVectors = validateMatrix(vectors, "Vectors");
+
+        byte[] codes = new byte[vectors.length];
+        float[] scales = new float[numVectors];
+        int result = nativeQuantizeInt8(vectors, numVectors, dimension, codes, scales);
+        if (result != 0) {
+            throw new FastEmbedException("Failed to quantize vectors (error code: " + result + ")");
+        }
+        return new Int8Vectors(codes, scales);
+    }
+
+    /**
+     * Binarize vectors to packed sign bits ({@link #getBinaryBytes()} per
+     * vector, bit i set when component i is positive)
+     * 
+     * @param vectors Row-major vectors, a multiple of the dimension in length
+     * @return Row-major packed bits
+     * @throws IllegalArgumentException if vectors is empty or not a multiple of
+     *                                  the dimension
+     * @throws FastEmbedException       if binarization fails
+     */
+    public byte[] quantizeBinary(float[] vectors) {
+        int numVectors = validateMatrix(vectors, "Vectors");
+
+        byte[] bits = new byte[numVectors * getBinaryBytes()];
+        int result = nativeQuantizeBinary(vectors, numVectors, dimension, bits);
+        if (result != 0) {
+            throw new FastEmbedException("Failed to binarize vectors (error code: " + result + ")");
+        }
+        return bits;
+    }
+
+    /**
+     * Get the packed size of one binary-quantized vector
+     * 
+     * @return ceil(dimension / 8)
+     */
+    public int getBinaryBytes() {
+        return (dimension + 7) / 8;
+    }
+
+    /**
+     * Find the k int8-quantized corpus rows with the highest dot product
+     * 
+     * @param query   Quantized query (one vector)
+     * @param corpus  Quantized corpus
+     * @param k       Number of results (fewer if the corpus is smaller)
+     * @param threads Worker threads (0 = all CPUs)
+     * @return Row indices and approximate dot products, best first
+     * @throws IllegalArgumentException if the inputs are inconsistent or k is
+     *                                  not positive
+     * @throws FastEmbedException       if the search fails
+     */
+    public TopKResult topKInt8(Int8Vectors query, Int8Vectors corpus, int k, int threads) {
+        if (query == null || corpus == null) {
+            throw new IllegalArgumentException("Query and corpus cannot be null");
+        }
+        if (query.getCodes().length != dimension || query.getScales().length != 1) {
+            throw new IllegalArgumentException("Query must be one vector of dimension " + dimension);
+        }
+        int numCorpus = corpus.getScales().length;
+        if (numCorpus == 0 || corpus.getCodes().length != (long) numCorpus * dimension) {
+            throw new IllegalArgumentException("Corpus must have one scale per row of dimension " + dimension);
+        }
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+
+        int capacity = Math.min(k, numCorpus);
+        int[] ids = new int[capacity];
+        float[] scores = new float[capacity];
+        int count = nativeTopKInt8(query.getCodes(), query.getScales()[0], corpus.getCodes(), corpus.getScales(),
+                numCorpus, dimension, capacity, ids, scores, threads);
+        if (count < 0) {
+            throw new FastEmbedException("Failed to compute int8 top-k (error code: " + count + ")");
+        }
+        return new TopKResult(ids, scores);
+    }
+
+    /**
+     * Find the k binary-quantized corpus rows nearest in Hamming distance
+     * 
+     * @param queryBits  Query bits from {@link #quantizeBinary}
+     * @param corpusBits Row-major corpus bits, a multiple of
+     *                   {@link #getBinaryBytes()} in length
+     * @param k          Number of results (fewer if the corpus is smaller)
+     * @param threads    Worker threads (0 = all CPUs)
+     * @return Row indices and Hamming distances, nearest first
+     * @throws IllegalArgumentException if the bits have the wrong size or k is
+     *                                  not positive
+     * @throws FastEmbedException       if the search fails
+     */
+    public BinaryTopKResult topKBinary(byte[] queryBits, byte[] corpusBits, int k, int threads) {
+        int rowBytes = getBinaryBytes();
+        if (queryBits == null || queryBits.length != rowBytes) {
+            throw new IllegalArgumentException("Query bits must have " + rowBytes + " bytes");
+        }
+        if (corpusBits == null || corpusBits.length == 0 || corpusBits.length % rowBytes != 0) {
+            throw new IllegalArgumentException("Corpus bits must be a non-empty multiple of " + rowBytes + " bytes");
+        }
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+
+        int numCorpus = corpusBits.length / rowBytes;
+        int capacity = Math.min(k, numCorpus);
+        int[] ids = new int[capacity];
+        int[] distances = new int[capacity];
+        int count = nativeTopKBinary(queryBits, corpusBits, numCorpus, dimension, capacity, ids, distances, threads);
+        if (count < 0) {
+            throw new FastEmbedException("Failed to compute binary top-k (error code: " + count + ")");
+        }
+        return new BinaryTopKResult(ids, distances);
+    }
+
+    /**
+     * Rerank a shortlist of corpus rows (e.g. from {@link #topKBinary}) with
+     * exact float scores
+     * 
+     * @param query      Query vector
+     * @param corpus     Row-major corpus, a multiple of the dimension in length
+     * @param candidates Distinct corpus row indices
+     * @param k          Number of results (fewer if there are fewer candidates)
+     * @param metric     Scoring function ({@code EUCLIDEAN} returns the nearest
+     *                   vectors)
+     * @return Row indices and scores, best first
+     * @throws IllegalArgumentException if an input is invalid or k is not
+     *                                  positive
+     * @throws FastEmbedException       if a candidate is not a corpus row
+     */
+    public TopKResult rescore(float[] query, float[] corpus, int[] candidates, int k, SimilarityMetric metric) {
+        validateVector(query);
+        int numCorpus = validateMatrix(corpus, "Corpus");
+        if (candidates == null || candidates.length == 0) {
+            throw new IllegalArgumentException("Candidates cannot be null or empty");
+        }
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+        if (metric == null) {
+            throw new IllegalArgumentException("Metric cannot be null");
+        }
+
+        int capacity = Math.min(k, candidates.length);
+        int[] ids = new int[capacity];
+        float[] scores = new float[capacity];
+        int count = nativeRescore(query, corpus, numCorpus, dimension, candidates, candidates.length, capacity, ids,
+                scores, metric.getCode());
+        if (count < 0) {
+            throw new FastEmbedException("Failed to rescore candidates (error code: " + count + ")");
+        }
+        return new TopKResult(ids, scores);
+    }
+
+    /**
+     * Convert vectors to half precision (round to nearest even), halving
+     * their memory
+     * 
+     * @param vectors Row-major vectors, a multiple of the dimension in length
+     * @param format  Storage format
+     * @return One 16-bit value per float
+     * @throws IllegalArgumentException if vectors is empty or not a multiple of
+     *                                  the dimension, or format is null
+     * @throws FastEmbedException       if the conversion fails
+     */
+    public short[] toHalf(float[] vectors, HalfFormat format) {
+        validateMatrix(vectors, "Vectors");
+        if (format == null) {
+            throw new IllegalArgumentException("Format cannot be null");
+        }
+
+        short[] halves = new short[vectors.length];
+        int result = nativeToHalf(vectors, halves, vectors.length, format.getCode());
+        if (result != 0) {
+            throw new FastEmbedException("Failed to convert to half precision (error code: " + result + ")");
+        }
+        return halves;
+    }
+
+    /**
+     * Widen half-precision values from {@link #toHalf} back to floats (exact)
+     * 
+     * @param halves Half-precision values
+     * @param format Format they were converted with
+     * @return Floats
+     * @throws IllegalArgumentException if halves is empty or format is null
+     * @throws FastEmbedException       if the conversion fails
+     */
+    public float[] fromHalf(short[] halves, HalfFormat format) {
+        if (halves == null || halves.length == 0) {
+            throw new IllegalArgumentException("Halves cannot be null or empty");
+        }
+        if (format == null) {
+            throw new IllegalArgumentException("Format cannot be null");
+        }
+
+        float[] floats = new float[halves.length];
+        int result = nativeFromHalf(halves, floats, halves.length, format.getCode());
+        if (result != 0) {
+            throw new FastEmbedException("Failed to convert from half precision (error code: " + result + ")");
+        }
+        return floats;
+    }
+
+    /**
+     * Find the k half-precision corpus rows most similar to a query (same
+     * results as {@link #topK} on the widened corpus)
+     * 
+     * @param query   Query vector
+     * @param corpus  Row-major corpus from {@link #toHalf}
+     * @param format  Format the corpus was converted with
+     * @param k       Number of results (fewer if the corpus is smaller)
+     * @param metric  Scoring function ({@code EUCLIDEAN} returns the nearest
+     *                vectors)
+     * @param threads Worker threads (0 = all CPUs)
+     * @return Row indices and scores, best first
+     * @throws IllegalArgumentException if an input is invalid or k is not
+     *                                  positive
+     * @throws FastEmbedException       if the search fails
+     */
+    public TopKResult topKHalf(float[] query, short[] corpus, HalfFormat format, int k, SimilarityMetric metric,
+            int threads) {
+        validateVector(query);
+        if (corpus == null || corpus.length == 0 || corpus.length % dimension != 0) {
+            throw new IllegalArgumentException("Corpus must be a non-empty multiple of " + dimension + " values");
+        }
+        if (format == null || metric == null) {
+            throw new IllegalArgumentException("Format and metric cannot be null");
+        }
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+
+        int numCorpus = corpus.length / dimension;
+        int capacity = Math.min(k, numCorpus);
+        int[] ids = new int[capacity];
+        float[] scores = new float[capacity];
+        int count = nativeTopKHalf(query, corpus, format.getCode(), numCorpus, dimension, capacity, ids, scores,
+                metric.getCode(), threads);
+        if (count < 0) {
+            throw new FastEmbedException("Failed to compute half-precision top-k (error code: " + count + ")");
+        }
+        return new TopKResult(ids, scores);
+    }
+
     /**
      * Calculate semantic similarity between two texts
      * 
@@ -236,6 +692,82 @@ public class FastEmbed {
         return embeddings;
     }
 
+    /**
+     * Generate embeddings for concatenated texts into one direct buffer
+     * 
+     * Text i is bytes {@code [offsets[i], offsets[i + 1])} of textData and
+     * its embedding is row i of output. All buffers are read and written in
+     * place from their positions (positions are left unchanged) and the
+     * batch runs on the native thread pool.
+     * 
+     * @param textData Concatenated UTF-8 texts (direct)
+     * @param offsets  numTexts + 1 non-decreasing byte offsets into textData
+     *                 (direct, native order)
+     * @param numTexts Number of texts
+     * @param output   Receives row-major [numTexts x dimension] embeddings
+     *                 (direct, native order)
+     * @param statuses Receives a status code per text (direct, native order),
+     *                 or null
+     * @param threads  Worker threads (0 = whole pool)
+     * @return Number of texts that failed (their rows are zeroed)
+     * @throws IllegalArgumentException if a buffer is invalid or too small
+     * @throws FastEmbedException       if the batch cannot run
+     * @see PackedTexts
+     */
+    public int generateEmbeddings(ByteBuffer textData, IntBuffer offsets, int numTexts, FloatBuffer output,
+            IntBuffer statuses, int threads) {
+        validateTextBatch(textData, offsets, numTexts, statuses);
+        requireDirect(output, (long) numTexts * dimension, "Output");
+
+        int failed = nativeBatchGenerateDirect(textData, textData.position(), offsets, offsets.position(), numTexts,
+                output, output.position(), dimension, statuses, statuses != null ? statuses.position() : 0,
+                threads);
+        if (failed < 0) {
+            throw new FastEmbedException("Failed to generate embeddings (error code: " + failed + ")");
+        }
+        return failed;
+    }
+
+    /**
+     * Generate embeddings for packed texts into one direct buffer
+     * 
+     * @param texts    Packed texts
+     * @param output   Receives row-major [count x dimension] embeddings
+     *                 (direct, native order)
+     * @param statuses Receives a status code per text, or null
+     * @param threads  Worker threads (0 = whole pool)
+     * @return Number of texts that failed
+     * @see #generateEmbeddings(ByteBuffer, IntBuffer, int, FloatBuffer,
+     *      IntBuffer, int)
+     */
+    public int generateEmbeddings(PackedTexts texts, FloatBuffer output, IntBuffer statuses, int threads) {
+        if (texts == null) {
+            throw new IllegalArgumentException("Texts cannot be null");
+        }
+        return generateEmbeddings(texts.getData(), texts.getOffsets(), texts.getCount(), output, statuses, threads);
+    }
+
+    /**
+     * Allocate a direct float buffer in native byte order, as accepted by the
+     * {@code FloatBuffer} overloads
+     * 
+     * @param count Number of floats
+     * @return Zeroed buffer of count floats
+     */
+    public static FloatBuffer allocateFloats(int count) {
+        return ByteBuffer.allocateDirect(count * Float.BYTES).order(ByteOrder.nativeOrder()).asFloatBuffer();
+    }
+
+    /**
+     * Allocate a direct int buffer in native byte order (offsets, statuses)
+     * 
+     * @param count Number of ints
+     * @return Zeroed buffer of count ints
+     */
+    public static IntBuffer allocateInts(int count) {
+        return ByteBuffer.allocateDirect(count * Integer.BYTES).order(ByteOrder.nativeOrder()).asIntBuffer();
+    }
+
     /**
      * Generate ONNX-based embedding for text using ML model
      * 
@@ -282,11 +814,82 @@ public class FastEmbed {
         }
     }
 
+    private int validateMatrix(float[] matrix, String name) {
+        if (matrix == null) {
+            throw new IllegalArgumentException(name + " cannot be null");
+        }
+        if (matrix.length == 0 || matrix.length % dimension != 0) {
+            throw new IllegalArgumentException(String.format(
+                    "%s length %d is not a positive multiple of dimension %d", name, matrix.length, dimension));
+        }
+        return matrix.length / dimension;
+    }
+
     private void validateVectors(float[] vectorA, float[] vectorB) {
         validateVector(vectorA);
         validateVector(vectorB);
     }
 
+    static void requireDirect(FloatBuffer buffer, long minRemaining, String name) {
+        if (buffer == null) {
+            throw new IllegalArgumentException(name + " cannot be null");
+        }
+        if (!buffer.isDirect() || buffer.order() != ByteOrder.nativeOrder()) {
+            throw new IllegalArgumentException(name + " must be a direct buffer in native byte order");
+        }
+        if (buffer.remaining() < minRemaining) {
+            throw new IllegalArgumentException(String.format("%s has %d floats remaining, needs %d", name,
+                    buffer.remaining(), minRemaining));
+        }
+    }
+
+    static void requireDirect(IntBuffer buffer, long minRemaining, String name) {
+        if (buffer == null) {
+            throw new IllegalArgumentException(name + " cannot be null");
+        }
+        if (!buffer.isDirect() || buffer.order() != ByteOrder.nativeOrder()) {
+            throw new IllegalArgumentException(name + " must be a direct buffer in native byte order");
+        }
+        if (buffer.remaining() < minRemaining) {
+            throw new IllegalArgumentException(String.format("%s has %d ints remaining, needs %d", name,
+                    buffer.remaining(), minRemaining));
+        }
+    }
+
+    /* Offsets are checked here since the native side cannot see the data size */
+    static void validateTextBatch(ByteBuffer textData, IntBuffer offsets, int numTexts, IntBuffer statuses) {
+        if (numTexts <= 0) {
+            throw new IllegalArgumentException("Text count must be positive");
+        }
+        if (textData == null) {
+            throw new IllegalArgumentException("Text data cannot be null");
+        }
+        if (!textData.isDirect()) {
+            throw new IllegalArgumentException("Text data must be a direct buffer");
+        }
+        requireDirect(offsets, (long) numTexts + 1, "Offsets");
+        if (statuses != null) {
+            requireDirect(statuses, numTexts, "Statuses");
+        }
+
+        int base = offsets.position();
+        int previous = offsets.get(base);
+        if (previous < 0) {
+            throw new IllegalArgumentException("Offsets must be non-negative");
+        }
+        for (int i = 1; i <= numTexts; i++) {
+            int offset = offsets.get(base + i);
+            if (offset < previous) {
+                throw new IllegalArgumentException("Offsets must be non-decreasing");
+            }
+            previous = offset;
+        }
+        if (previous > textData.remaining()) {
+            throw new IllegalArgumentException(String.format(
+                    "Offsets reach byte %d past the %d bytes of text data", previous, textData.remaining()));
+        }
+    }
+
     // Native method declarations
     private native int nativeGenerateEmbedding(String text, float[] output, int dimension);
 
@@ -300,10 +903,183 @@ public class FastEmbed {
 
     private native void nativeAddVectors(float[] vectorA, float[] vectorB, float[] result, int dimension);
 
+    private native int nativeSimilarityMatrix(float[] queries, int numQueries, float[] corpus, int numCorpus,
+            int dimension, float[] output, int metric, int threads);
+
+    private native int nativeTopK(float[] query, float[] corpus, int numCorpus, int dimension, int k, int[] ids,
+            float[] scores, int metric, int threads);
+
+    private native int nativeQuantizeInt8(float[] vectors, int numVectors, int dimension, byte[] codes,
+            float[] scales);
+
+    private native int nativeQuantizeBinary(float[] vectors, int numVectors, int dimension, byte[] bits);
+
+    private native int nativeTopKInt8(byte[] queryCodes, float queryScale, byte[] corpusCodes, float[] corpusScales,
+            int numCorpus, int dimension, int k, int[] ids, float[] scores, int threads);
+
+    private native int nativeTopKBinary(byte[] queryBits, byte[] corpusBits, int numCorpus, int dimension, int k,
+            int[] ids, int[] distances, int threads);
+
+    private native int nativeRescore(float[] query, float[] corpus, int numCorpus, int dimension, int[] candidates,
+            int numCandidates, int k, int[] ids, float[] scores, int metric);
+
+    private native int nativeToHalf(float[] vectors, short[] halves, int count, int format);
+
+    private native int nativeFromHalf(short[] halves, float[] floats, int count, int format);
+
+    private native int nativeTopKHalf(float[] query, short[] corpus, int format, int numCorpus, int dimension, int k,
+            int[] ids, float[] scores, int metric, int threads);
+
+    private native float nativeCosineSimilarityDirect(FloatBuffer vectorA, int offsetA, FloatBuffer vectorB,
+            int offsetB, int dimension);
+
+    private native float nativeDotProductDirect(FloatBuffer vectorA, int offsetA, FloatBuffer vectorB, int offsetB,
+            int dimension);
+
+    private native int nativeSimilarityMatrixDirect(FloatBuffer queries, int queriesOffset, int numQueries,
+            FloatBuffer corpus, int corpusOffset, int numCorpus, int dimension, FloatBuffer output, int outputOffset,
+            int metric, int threads);
+
+    private native int nativeTopKDirect(FloatBuffer query, int queryOffset, FloatBuffer corpus, int corpusOffset,
+            int numCorpus, int dimension, int k, int[] ids, float[] scores, int metric, int threads);
+
+    private native int nativeBatchGenerateDirect(ByteBuffer textData, int textOffset, IntBuffer offsets,
+            int offsetsOffset, int numTexts, FloatBuffer output, int outputOffset, int dimension, IntBuffer statuses,
+            int statusesOffset, int threads);
+
     private native int nativeGenerateOnnxEmbedding(String modelPath, String text, float[] output, int dimension);
 
     private native int nativeUnloadOnnxModel();
 
+    /**
+     * Scoring function for {@link #similarityMatrix} (matches fastembed_metric_t)
+     */
+    public enum SimilarityMetric {
+        /** Raw dot product */
+        DOT(0),
+        /** Cosine similarity */
+        COSINE(1),
+        /** Euclidean (L2) distance */
+        EUCLIDEAN(2);
+
+        private final int code;
+
+        SimilarityMetric(int code) {
+            this.code = code;
+        }
+
+        int getCode() {
+            return code;
+        }
+    }
+
+    /**
+     * Half-precision storage format (matches {@code fastembed_quantization_t})
+     */
+    public enum HalfFormat {
+        /** IEEE 754 half precision */
+        FP16(3),
+        /** bfloat16 (upper 16 bits of a float) */
+        BF16(4);
+
+        private final int code;
+
+        HalfFormat(int code) {
+            this.code = code;
+        }
+
+        int getCode() {
+            return code;
+        }
+    }
+
+    /**
+     * Result of {@link #topK}: corpus row indices and scores, best first
+     */
+    public static final class TopKResult {
+        private final int[] ids;
+        private final float[] scores;
+
+        TopKResult(int[] ids, float[] scores) {
+            this.ids = ids;
+            this.scores = scores;
+        }
+
+        /**
+         * @return Corpus row indices
+         */
+        public int[] getIds() {
+            return ids;
+        }
+
+        /**
+         * @return Scores of those rows (distances for {@code EUCLIDEAN})
+         */
+        public float[] getScores() {
+            return scores;
+        }
+    }
+
+    /**
+     * Int8-quantized vectors from {@link #quantizeInt8}: row-major codes and one
+     * scale per vector
+     */
+    public static final class Int8Vectors {
+        private final byte[] codes;
+        private final float[] scales;
+
+        /**
+         * @param codes  Row-major codes in [-127, 127]
+         * @param scales One scale per vector
+         */
+        public Int8Vectors(byte[] codes, float[] scales) {
+            this.codes = codes;
+            this.scales = scales;
+        }
+
+        /**
+         * @return Row-major codes
+         */
+        public byte[] getCodes() {
+            return codes;
+        }
+
+        /**
+         * @return Per-vector scales (0 for zero vectors)
+         */
+        public float[] getScales() {
+            return scales;
+        }
+    }
+
+    /**
+     * Result of {@link #topKBinary}: corpus row indices and Hamming distances,
+     * nearest first
+     */
+    public static final class BinaryTopKResult {
+        private final int[] ids;
+        private final int[] distances;
+
+        BinaryTopKResult(int[] ids, int[] distances) {
+            this.ids = ids;
+            this.distances = distances;
+        }
+
+        /**
+         * @return Corpus row indices
+         */
+        public int[] getIds() {
+            return ids;
+        }
+
+        /**
+         * @return Number of differing bits for those rows
+         */
+        public int[] getDistances() {
+            return distances;
+        }
+    }
+
     /**
      * Exception thrown when FastEmbed native operation fails
      */
@@ -0,0 +1,280 @@
+package com.fastembed;
+
+/**
+ * Approximate nearest neighbour index (HNSW graph)
+ *
+ * Wraps {@code fastembed_hnsw_*()}. Vectors get ids 0, 1, 2, ... in insertion
+ * order; inserts and searches may run from many threads at once. Close the
+ * index (or use try-with-resources) to free the native memory.
+ *
+ * <pre>
+ * try (HnswIndex index = new HnswIndex(384)) {
+ *     index.add(corpus, 0);
+ *     FastEmbed.TopKResult hits = index.search(query, 10);
+ *     index.save("corpus.hnsw");
+ * }
+ * try (HnswIndex mapped = HnswIndex.load("corpus.hnsw", true)) {
+ *     FastEmbed.TopKResult hits = mapped.search(query, 10);
+ * }
+ * </pre>
+ *
+ * @author FastEmbed Team
+ * @version 1.0.0
+ */
+public class HnswIndex implements AutoCloseable {
+
+    /** Default neighbours per node (FASTEMBED_HNSW_DEFAULT_M) */
+    public static final int DEFAULT_M = 16;
+
+    /** Default candidate list size while inserting */
+    public static final int DEFAULT_EF_CONSTRUCTION = 200;
+
+    /** Default candidate list size while searching */
+    public static final int DEFAULT_EF_SEARCH = 64;
+
+    private long handle;
+    private final int dimension;
+
+    /**
+     * Create an empty cosine index with default graph parameters
+     *
+     * @param dimension Vector dimension
+     * @throws IllegalArgumentException if the dimension is invalid
+     */
+    public HnswIndex(int dimension) {
+        this(dimension, DEFAULT_M, DEFAULT_EF_CONSTRUCTION, DEFAULT_EF_SEARCH,
+                FastEmbed.SimilarityMetric.COSINE, 0);
+    }
+
+    /**
+     * Create an empty index
+     *
+     * @param dimension      Vector dimension
+     * @param m              Neighbours per node, 2 - 64 (the bottom level
+     *                       keeps 2 * m)
+     * @param efConstruction Candidate list size while inserting
+     * @param efSearch       Candidate list size while searching
+     * @param metric         Distance used to order neighbours
+     * @param seed           Seed for node levels; single-threaded inserts with
+     *                       the same seed build the same graph
+     * @throws IllegalStateException    if native library not loaded
+     * @throws IllegalArgumentException if the dimension or options are invalid
+     */
+    public HnswIndex(int dimension, int m, int efConstruction, int efSearch, FastEmbed.SimilarityMetric metric,
+            int seed) {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        if (metric == null) {
+            throw new IllegalArgumentException("Metric cannot be null");
+        }
+
+        handle = nativeCreate(dimension, m, efConstruction, efSearch, metric.getCode(), seed);
+        if (handle == 0) {
+            throw new IllegalArgumentException("Invalid HNSW dimension or options");
+        }
+        this.dimension = dimension;
+    }
+
+    private HnswIndex(long handle) {
+        this.handle = handle;
+        this.dimension = nativeDimension(handle);
+    }
+
+    /**
+     * Load an index written by {@link #save(String)}
+     *
+     * @param path Index file
+     * @param mmap Map the file read-only instead of reading it into memory
+     *             ({@link #add} and {@link #remove} then fail)
+     * @return Loaded index
+     * @throws IllegalStateException        if native library not loaded
+     * @throws IllegalArgumentException     if path is null
+     * @throws FastEmbed.FastEmbedException if the file is missing or invalid
+     */
+    public static HnswIndex load(String path, boolean mmap) {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        if (path == null) {
+            throw new IllegalArgumentException("Path cannot be null");
+        }
+
+        long handle = nativeLoad(path, mmap);
+        if (handle == 0) {
+            throw new FastEmbed.FastEmbedException("Failed to load HNSW index: " + path);
+        }
+        return new HnswIndex(handle);
+    }
+
+    /**
+     * Get the vector dimension
+     *
+     * @return Dimension
+     */
+    public int getDimension() {
+        return dimension;
+    }
+
+    /**
+     * Get the number of vectors in the index
+     *
+     * @return Vector count (removed ones excluded)
+     */
+    public int size() {
+        ensureOpen();
+        return nativeSize(handle);
+    }
+
+    /**
+     * Set the search candidate list size (larger = better recall, slower)
+     *
+     * @param efSearch Candidate list size
+     * @throws IllegalArgumentException if efSearch is not positive
+     */
+    public void setEfSearch(int efSearch) {
+        ensureOpen();
+        if (nativeSetEfSearch(handle, efSearch) != 0) {
+            throw new IllegalArgumentException("efSearch must be positive");
+        }
+    }
+
+    /**
+     * Add one vector or a row-major batch of vectors
+     *
+     * @param vectors A multiple of {@link #getDimension()} floats
+     * @param threads Worker threads (0 = all CPUs)
+     * @return Assigned ids, in row order
+     * @throws IllegalArgumentException     if vectors is not a multiple of the
+     *                                      dimension
+     * @throws FastEmbed.FastEmbedException if the index is read-only or out of
+     *                                      memory
+     */
+    public int[] add(float[] vectors, int threads) {
+        ensureOpen();
+        if (vectors == null || vectors.length == 0 || vectors.length % dimension != 0) {
+            throw new IllegalArgumentException("Vectors must be a non-empty multiple of " + dimension + " floats");
+        }
+
+        int[] ids = new int[vectors.length / dimension];
+        if (nativeAddBatch(handle, vectors, ids.length, ids, threads) != 0) {
+            throw new FastEmbed.FastEmbedException("Failed to add vectors (read-only index or out of memory)");
+        }
+        return ids;
+    }
+
+    /**
+     * Add vectors on the calling thread
+     *
+     * @param vectors A multiple of {@link #getDimension()} floats
+     * @return Assigned ids, in row order
+     * @see #add(float[], int)
+     */
+    public int[] add(float[] vectors) {
+        return add(vectors, 1);
+    }
+
+    /**
+     * Remove a vector from search results
+     *
+     * @param id Id returned by {@link #add}
+     * @return false if the id is unknown or already removed, or the index is
+     *         read-only
+     */
+    public boolean remove(int id) {
+        ensureOpen();
+        return nativeRemove(handle, id) == 0;
+    }
+
+    /**
+     * Find approximately the k nearest vectors
+     *
+     * @param query Query vector of {@link #getDimension()} floats
+     * @param k     Number of results
+     * @return Ids and scores, best first (distances for {@code EUCLIDEAN})
+     * @throws IllegalArgumentException     if the query or k is invalid
+     * @throws FastEmbed.FastEmbedException if the search fails
+     */
+    public FastEmbed.TopKResult search(float[] query, int k) {
+        ensureOpen();
+        if (query == null || query.length != dimension) {
+            throw new IllegalArgumentException("Query must have " + dimension + " floats");
+        }
+        if (k <= 0) {
+            throw new IllegalArgumentException("k must be positive");
+        }
+
+        int capacity = Math.min(k, nativeSize(handle));
+        int[] ids = new int[capacity];
+        float[] scores = new float[capacity];
+        if (capacity == 0) {
+            return new FastEmbed.TopKResult(ids, scores);
+        }
+
+        int count = nativeSearch(handle, query, capacity, ids, scores);
+        if (count < 0) {
+            throw new FastEmbed.FastEmbedException("Failed to search HNSW index");
+        }
+        if (count < capacity) {
+            ids = java.util.Arrays.copyOf(ids, count);
+            scores = java.util.Arrays.copyOf(scores, count);
+        }
+        return new FastEmbed.TopKResult(ids, scores);
+    }
+
+    /**
+     * Write the index to a file (replaced if it exists)
+     *
+     * @param path Destination file
+     * @throws IllegalArgumentException     if path is null
+     * @throws FastEmbed.FastEmbedException if the file cannot be written
+     */
+    public void save(String path) {
+        ensureOpen();
+        if (path == null) {
+            throw new IllegalArgumentException("Path cannot be null");
+        }
+        if (nativeSave(handle, path) != 0) {
+            throw new FastEmbed.FastEmbedException("Failed to save HNSW index: " + path);
+        }
+    }
+
+    /**
+     * Free the index (idempotent); mapped indexes unmap their file
+     */
+    @Override
+    public void close() {
+        if (handle != 0) {
+            nativeFree(handle);
+            handle = 0;
+        }
+    }
+
+    private void ensureOpen() {
+        if (handle == 0) {
+            throw new IllegalStateException("HNSW index is closed");
+        }
+    }
+
+    // Native method declarations
+    private static native long nativeCreate(int dimension, int m, int efConstruction, int efSearch, int metric,
+            int seed);
+
+    private static native long nativeLoad(String path, boolean mmap);
+
+    private static native void nativeFree(long handle);
+
+    private static native int nativeAddBatch(long handle, float[] vectors, int numVectors, int[] ids, int threads);
+
+    private static native int nativeRemove(long handle, int id);
+
+    private static native int nativeSearch(long handle, float[] query, int k, int[] ids, float[] scores);
+
+    private static native int nativeSetEfSearch(long handle, int efSearch);
+
+    private static native int nativeSize(long handle);
+
+    private static native int nativeDimension(long handle);
+
+    private static native int nativeSave(long handle, String path);
+}
@@ -0,0 +1,304 @@
+package com.fastembed;
+
+import java.nio.ByteBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+
+/**
+ * Open handle to an ONNX embedding model
+ *
+ * Wraps {@code fastembed_model_open_with_options()}. Handles are shared by
+ * the native registry: opening the same model with the same options returns
+ * the same session. Close the model (or use try-with-resources) to release
+ * the handle.
+ *
+ * <pre>
+ * try (OnnxModel model = new OnnxModel("models/model.onnx",
+ *         new OnnxSessionOptions().setIntraOpThreads(4))) {
+ *     float[] embedding = model.generateEmbedding("hello world");
+ * }
+ * </pre>
+ *
+ * @author FastEmbed Team
+ * @version 1.0.0
+ */
+public class OnnxModel implements AutoCloseable {
+
+    private long handle;
+    private final int dimension;
+
+    /**
+     * Open a model with default session options
+     *
+     * @param modelPath Path to ONNX model file
+     * @throws FastEmbed.FastEmbedException if the model cannot be loaded
+     */
+    public OnnxModel(String modelPath) {
+        this(modelPath, null);
+    }
+
+    /**
+     * Open a model with the given session options
+     *
+     * @param modelPath Path to ONNX model file
+     * @param options   Session options, or null for defaults
+     * @throws IllegalStateException        if native library not loaded
+     * @throws IllegalArgumentException     if modelPath is null
+     * @throws FastEmbed.FastEmbedException if the model cannot be loaded
+     */
+    public OnnxModel(String modelPath, OnnxSessionOptions options) {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        if (modelPath == null) {
+            throw new IllegalArgumentException("Model path cannot be null");
+        }
+        if (options == null) {
+            options = new OnnxSessionOptions();
+        }
+
+        handle = nativeOpen(modelPath,
+                options.getIntraOpThreads(),
+                options.getInterOpThreads(),
+                options.getGraphOptimizationLevel().getCode(),
+                options.isMemPatternEnabled(),
+                options.isCpuMemArenaEnabled(),
+                options.executionProviderCodes(),
+                options.getDeviceId(),
+                options.getOptimizedModelPath(),
+                options.getTokenizerPath(),
+                options.getPooling().getCode());
+        if (handle == 0) {
+            throw new FastEmbed.FastEmbedException("Failed to open ONNX model: " + nativeGetLastError());
+        }
+
+        dimension = nativeGetDimension(handle);
+        if (dimension <= 0) {
+            nativeClose(handle);
+            handle = 0;
+            throw new FastEmbed.FastEmbedException("Failed to detect ONNX model dimension: " + modelPath);
+        }
+    }
+
+    /**
+     * Get the model output dimension
+     *
+     * @return Embedding dimension
+     */
+    public int getDimension() {
+        return dimension;
+    }
+
+    /**
+     * Get the execution provider the session is running on
+     *
+     * @return Active execution provider (CPU if every requested provider was
+     *         unavailable)
+     */
+    public OnnxSessionOptions.ExecutionProvider getExecutionProvider() {
+        ensureOpen();
+        return OnnxSessionOptions.ExecutionProvider.fromCode(nativeGetExecutionProvider(handle));
+    }
+
+    /**
+     * Run warmup inferences so the first request does not pay ONNX
+     * Runtime's first-run setup
+     *
+     * @throws FastEmbed.FastEmbedException if inference fails
+     */
+    public void warmup() {
+        ensureOpen();
+        if (nativeWarmup(handle) != 0) {
+            throw new FastEmbed.FastEmbedException("ONNX warmup failed: " + nativeGetLastError());
+        }
+    }
+
+    /**
+     * Generate an embedding for text
+     *
+     * @param text Input text
+     * @return Embedding vector of {@link #getDimension()} floats
+     * @throws IllegalArgumentException     if text is null
+     * @throws FastEmbed.FastEmbedException if inference fails
+     */
+    public float[] generateEmbedding(String text) {
+        ensureOpen();
+        if (text == null) {
+            throw new IllegalArgumentException("Text cannot be null");
+        }
+
+        float[] output = new float[dimension];
+        int result = nativeGenerate(handle, text, output);
+        if (result != 0) {
+            throw new FastEmbed.FastEmbedException("Failed to generate ONNX embedding: " + nativeGetLastError());
+        }
+        return output;
+    }
+
+    /**
+     * Generate embeddings for concatenated texts into one direct buffer
+     *
+     * Same layout as
+     * {@link FastEmbed#generateEmbeddings(ByteBuffer, IntBuffer, int, FloatBuffer, IntBuffer, int)},
+     * with rows of {@link #getDimension()} floats. Opening the model with a
+     * small intra-op thread count avoids oversubscribing the CPU when several
+     * threads are used.
+     *
+     * @param textData Concatenated UTF-8 texts (direct)
+     * @param offsets  numTexts + 1 byte offsets into textData (direct, native
+     *                 order)
+     * @param numTexts Number of texts
+     * @param output   Receives row-major [numTexts x dimension] embeddings
+     *                 (direct, native order)
+     * @param statuses Receives a status code per text, or null
+     * @param threads  Worker threads (0 = whole pool)
+     * @return Number of texts that failed (their rows are zeroed)
+     * @throws IllegalArgumentException     if a buffer is invalid or too small
+     * @throws FastEmbed.FastEmbedException if the batch cannot run
+     */
+    public int generateEmbeddings(ByteBuffer textData, IntBuffer offsets, int numTexts, FloatBuffer output,
+            IntBuffer statuses, int threads) {
+        ensureOpen();
+        FastEmbed.validateTextBatch(textData, offsets, numTexts, statuses);
+        FastEmbed.requireDirect(output, (long) numTexts * dimension, "Output");
+
+        int failed = nativeBatchGenerateDirect(handle, textData, textData.position(), offsets, offsets.position(),
+                numTexts, output, output.position(), dimension, statuses,
+                statuses != null ? statuses.position() : 0, threads);
+        if (failed < 0) {
+            throw new FastEmbed.FastEmbedException("Failed to generate ONNX embeddings: " + nativeGetLastError());
+        }
+        return failed;
+    }
+
+    /**
+     * Generate embeddings for packed texts into one direct buffer
+     *
+     * @param texts    Packed texts
+     * @param output   Receives row-major [count x dimension] embeddings
+     * @param statuses Receives a status code per text, or null
+     * @param threads  Worker threads (0 = whole pool)
+     * @return Number of texts that failed
+     */
+    public int generateEmbeddings(PackedTexts texts, FloatBuffer output, IntBuffer statuses, int threads) {
+        if (texts == null) {
+            throw new IllegalArgumentException("Texts cannot be null");
+        }
+        return generateEmbeddings(texts.getData(), texts.getOffsets(), texts.getCount(), output, statuses, threads);
+    }
+
+    /**
+     * Load an ONNX model with default session options and warm it up
+     *
+     * Path-based calls for the model (and {@link #OnnxModel(String)}) then
+     * reuse the loaded session. Call from a background thread during startup
+     * to keep the cold start off the first request.
+     *
+     * @param modelPath Path to .onnx model file
+     * @throws IllegalArgumentException     if modelPath is null
+     * @throws FastEmbed.FastEmbedException if the model cannot be loaded
+     * @throws IllegalStateException        if native library not loaded
+     */
+    public static void preload(String modelPath) {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        if (modelPath == null) {
+            throw new IllegalArgumentException("Model path cannot be null");
+        }
+        if (nativePreload(modelPath) != 0) {
+            throw new FastEmbed.FastEmbedException("Failed to preload ONNX model: " + nativeGetLastError());
+        }
+    }
+
+    /**
+     * Read the native instrumentation counters of all ONNX calls
+     *
+     * Per-stage latency histograms (resolve, load, tokenize, bind, run,
+     * pool, generate; in nanoseconds), batch sizes and padding, e.g.
+     * {@code {"enabled":1,"texts":10,...,"stages":{"run":{"count":2,...}}}}.
+     *
+     * @return JSON text of {@code fastembed_stats_snapshot_json()}
+     * @throws IllegalStateException if native library not loaded
+     */
+    public static String statsSnapshotJson() {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        return nativeStatsSnapshotJson();
+    }
+
+    /**
+     * Zero the native instrumentation counters
+     *
+     * @throws IllegalStateException if native library not loaded
+     */
+    public static void statsReset() {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        nativeStatsReset();
+    }
+
+    /**
+     * Turn native instrumentation on or off (on by default)
+     *
+     * @param enabled Whether to record
+     * @throws IllegalStateException if native library not loaded
+     */
+    public static void statsSetEnabled(boolean enabled) {
+        if (!FastEmbed.isAvailable()) {
+            throw new IllegalStateException("Native library not loaded");
+        }
+        nativeStatsSetEnabled(enabled);
+    }
+
+    /**
+     * Release the model handle (idempotent)
+     *
+     * The session stays cached natively until evicted or unloaded.
+     */
+    @Override
+    public void close() {
+        if (handle != 0) {
+            nativeClose(handle);
+            handle = 0;
+        }
+    }
+
+    private void ensureOpen() {
+        if (handle == 0) {
+            throw new IllegalStateException("ONNX model is closed");
+        }
+    }
+
+    // Native method declarations
+    private static native long nativeOpen(String modelPath, int intraOpThreads, int interOpThreads,
+            int graphOptimizationLevel, boolean enableMemPattern, boolean enableCpuMemArena,
+            int[] executionProviders, int deviceId, String optimizedModelPath, String tokenizerPath,
+            int pooling);
+
+    private static native void nativeClose(long handle);
+
+    private static native int nativeGetDimension(long handle);
+
+    private static native int nativeGetExecutionProvider(long handle);
+
+    private static native int nativeWarmup(long handle);
+
+    private static native int nativePreload(String modelPath);
+
+    private static native int nativeGenerate(long handle, String text, float[] output);
+
+    private static native int nativeBatchGenerateDirect(long handle, ByteBuffer textData, int textOffset,
+            IntBuffer offsets, int offsetsOffset, int numTexts, FloatBuffer output, int outputOffset, int dimension,
+            IntBuffer statuses, int statusesOffset, int threads);
+
+    private static native String nativeGetLastError();
+
+    private static native String nativeStatsSnapshotJson();
+
+    private static native void nativeStatsReset();
+
+    private static native void nativeStatsSetEnabled(boolean enabled);
+}
@@ -0,0 +1,304 @@
+package com.fastembed;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * ONNX Runtime session tuning for {@link OnnxModel}
+ *
+ * Mirrors the native {@code fastembed_onnx_options_t}. Defaults match
+ * {@code fastembed_onnx_options_init()}: ORT-chosen thread counts, all graph
+ * optimizations, memory pattern and CPU arena enabled, CPU execution only,
+ * tokenizer discovered next to the model.
+ *
+ * <pre>
+ * OnnxSessionOptions options = new OnnxSessionOptions()
+ *         .setIntraOpThreads(4)
+ *         .addExecutionProvider(OnnxSessionOptions.ExecutionProvider.CUDA);
+ * </pre>
+ *
+ * @author FastEmbed Team
+ * @version 1.0.0
+ */
+public class OnnxSessionOptions {
+
+    /** Maximum execution providers (FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS) */
+    public static final int MAX_EXECUTION_PROVIDERS = 4;
+
+    /**
+     * Execution providers, in the order of the native
+     * {@code fastembed_execution_provider_t} enum
+     */
+    public enum ExecutionProvider {
+        CPU(0), CUDA(1), TENSORRT(2), COREML(3), XNNPACK(4);
+
+        private final int code;
+
+        ExecutionProvider(int code) {
+            this.code = code;
+        }
+
+        int getCode() {
+            return code;
+        }
+
+        static ExecutionProvider fromCode(int code) {
+            for (ExecutionProvider provider : values()) {
+                if (provider.code == code) {
+                    return provider;
+                }
+            }
+            throw new IllegalArgumentException("Unknown execution provider code: " + code);
+        }
+    }
+
+    /**
+     * Graph optimization levels (native {@code fastembed_graph_opt_level_t})
+     */
+    public enum GraphOptimizationLevel {
+        DISABLE(0), BASIC(1), EXTENDED(2), ALL(99);
+
+        private final int code;
+
+        GraphOptimizationLevel(int code) {
+            this.code = code;
+        }
+
+        int getCode() {
+            return code;
+        }
+    }
+
+    /**
+     * Pooling over token embeddings (native {@code fastembed_pooling_t})
+     *
+     * Models with a pooled [batch, hidden] output ignore this setting.
+     */
+    public enum Pooling {
+        /** First token ([CLS]), BERT-style */
+        CLS(0),
+        /** Mask-aware mean over tokens (sentence-transformers models) */
+        MEAN(1),
+        /** Element-wise max over tokens */
+        MAX(2),
+        /** Last non-padding token (decoder models) */
+        LAST_TOKEN(3);
+
+        private final int code;
+
+        Pooling(int code) {
+            this.code = code;
+        }
+
+        int getCode() {
+            return code;
+        }
+    }
+
+    private int intraOpThreads = 0;
+    private int interOpThreads = 0;
+    private GraphOptimizationLevel graphOptimizationLevel = GraphOptimizationLevel.ALL;
+    private boolean enableMemPattern = true;
+    private boolean enableCpuMemArena = true;
+    private final List<ExecutionProvider> executionProviders = new ArrayList<>();
+    private int deviceId = 0;
+    private String optimizedModelPath = null;
+    private String tokenizerPath = null;
+    private Pooling pooling = Pooling.CLS;
+
+    /**
+     * Set threads used to parallelize a single operator
+     *
+     * @param threads Thread count (0 = ORT default)
+     * @return this
+     * @throws IllegalArgumentException if threads is negative
+     */
+    public OnnxSessionOptions setIntraOpThreads(int threads) {
+        if (threads < 0) {
+            throw new IllegalArgumentException("Intra-op threads cannot be negative");
+        }
+        this.intraOpThreads = threads;
+        return this;
+    }
+
+    /**
+     * Set threads used to run independent graph nodes in parallel
+     *
+     * @param threads Thread count (0 = ORT default, &gt; 1 enables parallel
+     *                execution mode)
+     * @return this
+     * @throws IllegalArgumentException if threads is negative
+     */
+    public OnnxSessionOptions setInterOpThreads(int threads) {
+        if (threads < 0) {
+            throw new IllegalArgumentException("Inter-op threads cannot be negative");
+        }
+        this.interOpThreads = threads;
+        return this;
+    }
+
+    /**
+     * Set the graph optimization level
+     *
+     * @param level Optimization level
+     * @return this
+     */
+    public OnnxSessionOptions setGraphOptimizationLevel(GraphOptimizationLevel level) {
+        if (level == null) {
+            throw new IllegalArgumentException("Graph optimization level cannot be null");
+        }
+        this.graphOptimizationLevel = level;
+        return this;
+    }
+
+    /**
+     * Enable or disable memory pattern planning
+     *
+     * @param enable true to enable
+     * @return this
+     */
+    public OnnxSessionOptions setMemPatternEnabled(boolean enable) {
+        this.enableMemPattern = enable;
+        return this;
+    }
+
+    /**
+     * Enable or disable the CPU memory arena
+     *
+     * @param enable true to enable
+     * @return this
+     */
+    public OnnxSessionOptions setCpuMemArenaEnabled(boolean enable) {
+        this.enableCpuMemArena = enable;
+        return this;
+    }
+
+    /**
+     * Append an execution provider in priority order
+     *
+     * Providers that are not available at runtime are skipped; the session
+     * falls back to the CPU provider.
+     *
+     * @param provider Execution provider
+     * @return this
+     * @throws IllegalArgumentException if too many providers are added
+     */
+    public OnnxSessionOptions addExecutionProvider(ExecutionProvider provider) {
+        if (provider == null) {
+            throw new IllegalArgumentException("Execution provider cannot be null");
+        }
+        if (executionProviders.size() >= MAX_EXECUTION_PROVIDERS) {
+            throw new IllegalArgumentException(
+                    "At most " + MAX_EXECUTION_PROVIDERS + " execution providers are supported");
+        }
+        executionProviders.add(provider);
+        return this;
+    }
+
+    /**
+     * Set the GPU device used by CUDA / TensorRT
+     *
+     * @param deviceId Device index
+     * @return this
+     * @throws IllegalArgumentException if deviceId is negative
+     */
+    public OnnxSessionOptions setDeviceId(int deviceId) {
+        if (deviceId < 0) {
+            throw new IllegalArgumentException("Device id cannot be negative");
+        }
+        this.deviceId = deviceId;
+        return this;
+    }
+
+    /**
+     * Set where the optimized graph is cached
+     *
+     * The optimized model is written on first load and reused by later loads
+     * while it is newer than the source model.
+     *
+     * @param path Cache file path, or null to disable
+     * @return this
+     */
+    public OnnxSessionOptions setOptimizedModelPath(String path) {
+        this.optimizedModelPath = path;
+        return this;
+    }
+
+    /**
+     * Set the model vocabulary (vocab.txt or WordPiece tokenizer.json)
+     *
+     * By default tokenizer.json or vocab.txt is looked up next to the model
+     * and in its parent directory; without one, texts are tokenized with a
+     * hash-based fallback.
+     *
+     * @param path Vocabulary path, or null to discover it
+     * @return this
+     */
+    public OnnxSessionOptions setTokenizerPath(String path) {
+        this.tokenizerPath = path;
+        return this;
+    }
+
+    /**
+     * Set the pooling applied to [batch, seq_len, hidden] outputs
+     *
+     * @param pooling Pooling mode (default CLS)
+     * @return this
+     */
+    public OnnxSessionOptions setPooling(Pooling pooling) {
+        if (pooling == null) {
+            throw new IllegalArgumentException("Pooling cannot be null");
+        }
+        this.pooling = pooling;
+        return this;
+    }
+
+    public int getIntraOpThreads() {
+        return intraOpThreads;
+    }
+
+    public int getInterOpThreads() {
+        return interOpThreads;
+    }
+
+    public GraphOptimizationLevel getGraphOptimizationLevel() {
+        return graphOptimizationLevel;
+    }
+
+    public boolean isMemPatternEnabled() {
+        return enableMemPattern;
+    }
+
+    public boolean isCpuMemArenaEnabled() {
+        return enableCpuMemArena;
+    }
+
+    public List<ExecutionProvider> getExecutionProviders() {
+        return Collections.unmodifiableList(executionProviders);
+    }
+
+    public int getDeviceId() {
+        return deviceId;
+    }
+
+    public String getOptimizedModelPath() {
+        return optimizedModelPath;
+    }
+
+    public String getTokenizerPath() {
+        return tokenizerPath;
+    }
+
+    public Pooling getPooling() {
+        return pooling;
+    }
+
+    int[] executionProviderCodes() {
+        int[] codes = new int[executionProviders.size()];
+        for (int i = 0; i < codes.length; i++) {
+            codes[i] = executionProviders.get(i).getCode();
+        }
+        return codes;
+    }
+}
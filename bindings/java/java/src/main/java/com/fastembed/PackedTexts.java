@@ -0,0 +1,96 @@
+package com.fastembed;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * Texts packed into direct buffers for the zero-copy batch calls
+ *
+ * Arrow string layout: one UTF-8 byte buffer plus {@code count + 1} byte
+ * offsets, text i being bytes {@code [offsets[i], offsets[i + 1])}. Both
+ * buffers are direct and in native byte order, so the native library reads
+ * them in place. Pack once and reuse across calls to avoid re-encoding.
+ *
+ * <pre>
+ * PackedTexts texts = PackedTexts.of("first text", "second text");
+ * FloatBuffer output = FastEmbed.allocateFloats(texts.getCount() * 768);
+ * int failed = fastEmbed.generateEmbeddings(texts, output, null, 0);
+ * </pre>
+ *
+ * @author FastEmbed Team
+ * @version 1.0.0
+ */
+public final class PackedTexts {
+
+    private final ByteBuffer data;
+    private final IntBuffer offsets;
+    private final int count;
+
+    private PackedTexts(ByteBuffer data, IntBuffer offsets, int count) {
+        this.data = data;
+        this.offsets = offsets;
+        this.count = count;
+    }
+
+    /**
+     * Encode texts as UTF-8 into a new pair of direct buffers
+     *
+     * @param texts Input texts
+     * @return Packed texts
+     * @throws IllegalArgumentException if texts or any text is null, or the
+     *                                  packed data exceeds 2 GiB
+     */
+    public static PackedTexts of(String... texts) {
+        if (texts == null) {
+            throw new IllegalArgumentException("Texts array cannot be null");
+        }
+
+        byte[][] encoded = new byte[texts.length][];
+        long total = 0;
+        for (int i = 0; i < texts.length; i++) {
+            if (texts[i] == null) {
+                throw new IllegalArgumentException("Text " + i + " cannot be null");
+            }
+            encoded[i] = texts[i].getBytes(StandardCharsets.UTF_8);
+            total += encoded[i].length;
+        }
+        if (total > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("Packed texts too large");
+        }
+
+        ByteBuffer data = ByteBuffer.allocateDirect((int) Math.max(total, 1)).order(ByteOrder.nativeOrder());
+        IntBuffer offsets = ByteBuffer.allocateDirect((texts.length + 1) * Integer.BYTES)
+                .order(ByteOrder.nativeOrder()).asIntBuffer();
+        offsets.put(0, 0);
+        for (int i = 0; i < encoded.length; i++) {
+            data.put(encoded[i]);
+            offsets.put(i + 1, data.position());
+        }
+        data.flip();
+        return new PackedTexts(data, offsets, texts.length);
+    }
+
+    /**
+     * @return Concatenated UTF-8 bytes (direct, positioned at the first text)
+     */
+    public ByteBuffer getData() {
+        return data;
+    }
+
+    /**
+     * @return {@code getCount() + 1} byte offsets into {@link #getData()}
+     *         (direct, native order)
+     */
+    public IntBuffer getOffsets() {
+        return offsets;
+    }
+
+    /**
+     * @return Number of texts
+     */
+    public int getCount() {
+        return count;
+    }
+}
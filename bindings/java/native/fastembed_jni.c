@@ -104,6 +104,70 @@ Java_com_fastembed_FastEmbed_nativeAddVectors(JNIEnv *env, jobject obj,
     (*env)->ReleaseFloatArrayElements(env, result, arrResult, 0);
 }
 
+JNIEXPORT jint JNICALL
+Java_com_fastembed_FastEmbed_nativeSimilarityMatrix(JNIEnv *env, jobject obj,
+                                                    jfloatArray queries, jint numQueries,
+                                                    jfloatArray corpus, jint numCorpus,
+                                                    jint dimension, jfloatArray output,
+                                                    jint metric, jint threads)
+{
+    jfloat *arrQueries = (*env)->GetFloatArrayElements(env, queries, NULL);
+    jfloat *arrCorpus = (*env)->GetFloatArrayElements(env, corpus, NULL);
+    jfloat *arrOutput = (*env)->GetFloatArrayElements(env, output, NULL);
+    if (arrQueries == NULL || arrCorpus == NULL || arrOutput == NULL)
+    {
+        if (arrQueries != NULL)
+            (*env)->ReleaseFloatArrayElements(env, queries, arrQueries, JNI_ABORT);
+        if (arrCorpus != NULL)
+            (*env)->ReleaseFloatArrayElements(env, corpus, arrCorpus, JNI_ABORT);
+        if (arrOutput != NULL)
+            (*env)->ReleaseFloatArrayElements(env, output, arrOutput, JNI_ABORT);
+        return -1;
+    }
+
+    int result = fastembed_similarity_matrix_threaded(arrQueries, numQueries, arrCorpus, numCorpus,
+                                                      dimension, arrOutput, metric, threads);
+
+    (*env)->ReleaseFloatArrayElements(env, queries, arrQueries, JNI_ABORT);
+    (*env)->ReleaseFloatArrayElements(env, corpus, arrCorpus, JNI_ABORT);
+    (*env)->ReleaseFloatArrayElements(env, output, arrOutput, result == 0 ? 0 : JNI_ABORT);
+    return result;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_fastembed_FastEmbed_nativeTopK(JNIEnv *env, jobject obj,
+                                        jfloatArray query, jfloatArray corpus,
+                                        jint numCorpus, jint dimension, jint k,
+                                        jintArray ids, jfloatArray scores,
+                                        jint metric, jint threads)
+{
+    jfloat *arrQuery = (*env)->GetFloatArrayElements(env, query, NULL);
+    jfloat *arrCorpus = (*env)->GetFloatArrayElements(env, corpus, NULL);
+    jint *arrIds = (*env)->GetIntArrayElements(env, ids, NULL);
+    jfloat *arrScores = (*env)->GetFloatArrayElements(env, scores, NULL);
+    if (arrQuery == NULL || arrCorpus == NULL || arrIds == NULL || arrScores == NULL)
+    {
+        if (arrQuery != NULL)
+            (*env)->ReleaseFloatArrayElements(env, query, arrQuery, JNI_ABORT);
+        if (arrCorpus != NULL)
+            (*env)->ReleaseFloatArrayElements(env, corpus, arrCorpus, JNI_ABORT);
+        if (arrIds != NULL)
+            (*env)->ReleaseIntArrayElements(env, ids, arrIds, JNI_ABORT);
+        if (arrScores != NULL)
+            (*env)->ReleaseFloatArrayElements(env, scores, arrScores, JNI_ABORT);
+        return -1;
+    }
+
+    int count = fastembed_topk_threaded(arrQuery, arrCorpus, numCorpus, dimension, k,
+                                        (int *)arrIds, arrScores, metric, threads);
+
+    (*env)->ReleaseFloatArrayElements(env, query, arrQuery, JNI_ABORT);
+    (*env)->ReleaseFloatArrayElements(env, corpus, arrCorpus, JNI_ABORT);
+    (*env)->ReleaseIntArrayElements(env, ids, arrIds, count >= 0 ? 0 : JNI_ABORT);
+    (*env)->ReleaseFloatArrayElements(env, scores, arrScores, count >= 0 ? 0 : JNI_ABORT);
+    return count;
+}
+
 JNIEXPORT jint JNICALL
 Java_com_fastembed_FastEmbed_nativeGenerateOnnxEmbedding(JNIEnv *env, jobject obj,
                                                          jstring modelPath, jstring text,
@@ -5,6 +5,8 @@
  * without FFI dependencies. Provides high-performance binding to FastEmbed.
  */
 
+#include "fastembed.h"
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -29,6 +31,13 @@ float fastembed_vector_norm(const float *vector, int dimension);
 void fastembed_normalize(float *vector, int dimension);
 void fastembed_add_vectors(const float *vector_a, const float *vector_b,
                            float *result, int dimension);
+int fastembed_similarity_matrix_threaded(const float *queries, int num_queries,
+                                         const float *corpus, int num_corpus,
+                                         int dimension, float *out, int metric,
+                                         int num_threads);
+int fastembed_topk_threaded(const float *query, const float *corpus,
+                            int num_corpus, int dimension, int k, int *out_ids,
+                            float *out_scores, int metric, int num_threads);
 }
 
 // Helper: Convert napi_value to string
@@ -281,6 +290,64 @@ static napi_value UnloadOnnxModel(napi_env env, napi_callback_info info) {
   return return_value;
 }
 
+/**
+ * Read the instrumentation counters
+ *
+ * @returns String (fastembed_stats_snapshot_json() text)
+ */
+static napi_value StatsSnapshotJson(napi_env env, napi_callback_info info) {
+  // Counters may grow between the two calls: retry until the buffer fits
+  char *json = nullptr;
+  int length = fastembed_stats_snapshot_json(nullptr, 0);
+  while (length >= 0) {
+    size_t size = (size_t)length + 64;
+    free(json);
+    json = (char *)malloc(size);
+    if (!json)
+      break;
+    length = fastembed_stats_snapshot_json(json, size);
+    if (length >= 0 && (size_t)length < size)
+      break;
+  }
+  if (!json || length < 0) {
+    free(json);
+    napi_throw_error(env, nullptr, "Failed to format instrumentation counters");
+    return nullptr;
+  }
+
+  napi_value json_string;
+  napi_create_string_utf8(env, json, NAPI_AUTO_LENGTH, &json_string);
+  free(json);
+  return json_string;
+}
+
+/**
+ * Zero all instrumentation counters
+ */
+static napi_value StatsReset(napi_env env, napi_callback_info info) {
+  fastembed_stats_reset();
+  return nullptr;
+}
+
+/**
+ * Turn instrumentation on or off
+ *
+ * @param enabled Boolean
+ */
+static napi_value StatsSetEnabled(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  bool enabled = false;
+  if (argc < 1 || napi_get_value_bool(env, args[0], &enabled) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "enabled must be a boolean");
+    return nullptr;
+  }
+  fastembed_stats_set_enabled(enabled ? 1 : 0);
+  return nullptr;
+}
+
 /**
  * Get last error message from ONNX operations
  *
@@ -305,196 +372,836 @@ static napi_value GetOnnxLastError(napi_env env, napi_callback_info info) {
   return error_string;
 }
 
+// ONNX model handle wrapper: the finalizer closes handles that were never
+// closed explicitly, so closing twice or forgetting to close is harmless.
+// Closing while async calls run on the model defers the close until the
+// last of them completes
+struct OnnxModelRef {
+  fastembed_model_t *model;
+  int pending;  // Async calls still running on the model
+  bool closing; // closeOnnxModel() called while pending > 0
+};
+
+static void FinalizeOnnxModel(napi_env env, void *data, void *hint) {
+  OnnxModelRef *ref = (OnnxModelRef *)data;
+  if (ref->model) {
+    fastembed_model_close(ref->model);
+  }
+  free(ref);
+}
+
+// Helper: Get open model handle from argument (throws if invalid or closed)
+static OnnxModelRef *GetModelRefFromValue(napi_env env, napi_value value) {
+  napi_valuetype valuetype;
+  napi_typeof(env, value, &valuetype);
+  if (valuetype != napi_external) {
+    napi_throw_type_error(env, nullptr, "Expected an ONNX model handle");
+    return nullptr;
+  }
+
+  void *data;
+  napi_get_value_external(env, value, &data);
+  OnnxModelRef *ref = (OnnxModelRef *)data;
+  if (!ref->model || ref->closing) {
+    napi_throw_error(env, nullptr, "ONNX model handle is closed");
+    return nullptr;
+  }
+  return ref;
+}
+
+// Helper: Get open model from handle argument (throws if invalid or closed)
+static fastembed_model_t *GetModelFromValue(napi_env env, napi_value value) {
+  OnnxModelRef *ref = GetModelRefFromValue(env, value);
+  return ref ? ref->model : nullptr;
+}
+
+// Execution provider names accepted in options.executionProviders
+static const struct {
+  const char *name;
+  int provider;
+} kExecutionProviders[] = {{"cpu", FASTEMBED_EP_CPU},
+                           {"cuda", FASTEMBED_EP_CUDA},
+                           {"tensorrt", FASTEMBED_EP_TENSORRT},
+                           {"coreml", FASTEMBED_EP_COREML},
+                           {"xnnpack", FASTEMBED_EP_XNNPACK}};
+
+// Graph optimization level names accepted in options.graphOptimizationLevel
+static const struct {
+  const char *name;
+  int level;
+} kGraphOptLevels[] = {{"disable", FASTEMBED_GRAPH_OPT_DISABLE},
+                       {"basic", FASTEMBED_GRAPH_OPT_BASIC},
+                       {"extended", FASTEMBED_GRAPH_OPT_EXTENDED},
+                       {"all", FASTEMBED_GRAPH_OPT_ALL}};
+
+// Pooling mode names accepted in options.pooling
+static const struct {
+  const char *name;
+  int pooling;
+} kPoolingModes[] = {{"cls", FASTEMBED_POOLING_CLS},
+                     {"mean", FASTEMBED_POOLING_MEAN},
+                     {"max", FASTEMBED_POOLING_MAX},
+                     {"last_token", FASTEMBED_POOLING_LAST_TOKEN}};
+
+// Similarity metric names accepted by similarityMatrix()
+static const struct {
+  const char *name;
+  int metric;
+} kSimilarityMetrics[] = {{"dot", FASTEMBED_METRIC_DOT},
+                          {"cosine", FASTEMBED_METRIC_COSINE},
+                          {"euclidean", FASTEMBED_METRIC_EUCLIDEAN}};
+
+// Half-precision storage formats accepted by toHalf() / topKHalf()
+static const struct {
+  const char *name;
+  int format;
+} kHalfFormats[] = {{"fp16", FASTEMBED_QUANT_FP16},
+                    {"bf16", FASTEMBED_QUANT_BF16}};
+
+// Helper: Parse an optional 'fp16' / 'bf16' argument (default 'fp16';
+// returns false with a pending exception on invalid values)
+static bool GetHalfFormat(napi_env env, size_t argc, napi_value *args,
+                          size_t index, int *format) {
+  *format = FASTEMBED_QUANT_FP16;
+
+  napi_valuetype valuetype = napi_undefined;
+  if (argc > index) {
+    napi_typeof(env, args[index], &valuetype);
+  }
+  if (valuetype == napi_undefined) {
+    return true;
+  }
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "format must be a string");
+    return false;
+  }
+
+  char *name = GetStringFromValue(env, args[index]);
+  *format = -1;
+  for (size_t i = 0; i < sizeof(kHalfFormats) / sizeof(kHalfFormats[0]);
+       i++) {
+    if (strcmp(name, kHalfFormats[i].name) == 0) {
+      *format = kHalfFormats[i].format;
+    }
+  }
+  free(name);
+  if (*format < 0) {
+    napi_throw_error(env, nullptr,
+                     "Invalid format (expected 'fp16' or 'bf16')");
+    return false;
+  }
+  return true;
+}
+
+// Helper: Parse optional metric / threads arguments of the similarity
+// functions (returns false with a pending exception on invalid values)
+static bool GetSimilarityOptions(napi_env env, size_t argc, napi_value *args,
+                                 size_t metric_index, int *metric,
+                                 int32_t *threads) {
+  *metric = FASTEMBED_METRIC_COSINE;
+  *threads = 1;
+
+  napi_valuetype valuetype = napi_undefined;
+  if (argc > metric_index) {
+    napi_typeof(env, args[metric_index], &valuetype);
+  }
+  if (valuetype == napi_string) {
+    char *name = GetStringFromValue(env, args[metric_index]);
+    *metric = -1;
+    for (size_t i = 0;
+         i < sizeof(kSimilarityMetrics) / sizeof(kSimilarityMetrics[0]); i++) {
+      if (strcmp(name, kSimilarityMetrics[i].name) == 0) {
+        *metric = kSimilarityMetrics[i].metric;
+      }
+    }
+    free(name);
+    if (*metric < 0) {
+      napi_throw_error(env, nullptr,
+                       "Invalid metric (expected 'dot', 'cosine' or "
+                       "'euclidean')");
+      return false;
+    }
+  } else if (valuetype != napi_undefined) {
+    napi_throw_type_error(env, nullptr, "metric must be a string");
+    return false;
+  }
+
+  valuetype = napi_undefined;
+  if (argc > metric_index + 1) {
+    napi_typeof(env, args[metric_index + 1], &valuetype);
+  }
+  if (valuetype == napi_number) {
+    napi_get_value_int32(env, args[metric_index + 1], threads);
+  } else if (valuetype != napi_undefined) {
+    napi_throw_type_error(env, nullptr, "threads must be a number");
+    return false;
+  }
+  return true;
+}
+
+// Helper: Read optional int32 property (returns false if set but not a number)
+static bool GetOptionalInt(napi_env env, napi_value object, const char *name,
+                           int *out) {
+  bool has_property;
+  napi_has_named_property(env, object, name, &has_property);
+  if (!has_property) {
+    return true;
+  }
+
+  napi_value value;
+  napi_valuetype valuetype;
+  napi_get_named_property(env, object, name, &value);
+  napi_typeof(env, value, &valuetype);
+  if (valuetype == napi_undefined) {
+    return true;
+  }
+  if (valuetype == napi_boolean) {
+    bool flag;
+    napi_get_value_bool(env, value, &flag);
+    *out = flag ? 1 : 0;
+    return true;
+  }
+  if (valuetype != napi_number) {
+    return false;
+  }
+  napi_get_value_int32(env, value, out);
+  return true;
+}
+
+// Helper: Read optional string property into a malloc'd copy (returns false
+// and throws if set but not a string)
+static bool GetOptionalString(napi_env env, napi_value object, const char *name,
+                              char **out) {
+  bool has_property;
+  napi_has_named_property(env, object, name, &has_property);
+  if (!has_property) {
+    return true;
+  }
+
+  napi_value value;
+  napi_valuetype valuetype;
+  napi_get_named_property(env, object, name, &value);
+  napi_typeof(env, value, &valuetype);
+  if (valuetype == napi_string) {
+    *out = GetStringFromValue(env, value);
+    return true;
+  }
+  if (valuetype == napi_undefined || valuetype == napi_null) {
+    return true;
+  }
+
+  char message[128];
+  snprintf(message, sizeof(message), "%s must be a string", name);
+  napi_throw_type_error(env, nullptr, message);
+  return false;
+}
+
 /**
- * Calculate cosine similarity between two vectors
+ * Parse a JavaScript options object into fastembed_onnx_options_t
  *
- * @param vector_a - First vector (Float32Array or Array)
- * @param vector_b - Second vector (Float32Array or Array)
- * @returns Cosine similarity value (float)
+ * @param optimized_path - Receives malloc'd optimizedModelPath (caller frees)
+ * @param tokenizer_path - Receives malloc'd tokenizerPath (caller frees)
+ * @returns true on success, false if an exception was thrown
  */
-static napi_value CosineSimilarity(napi_env env, napi_callback_info info) {
-  size_t argc = 2;
-  napi_value args[2];
-  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+static bool ParseOnnxOptions(napi_env env, napi_value object,
+                             fastembed_onnx_options_t *options,
+                             char **optimized_path, char **tokenizer_path) {
+  fastembed_onnx_options_init(options);
+  *optimized_path = nullptr;
+  *tokenizer_path = nullptr;
 
-  if (argc < 2) {
-    napi_throw_error(env, nullptr, "Expected 2 arguments: vector_a, vector_b");
-    return nullptr;
+  napi_valuetype valuetype;
+  napi_typeof(env, object, &valuetype);
+  if (valuetype == napi_undefined || valuetype == napi_null) {
+    return true;
+  }
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "ONNX options must be an object");
+    return false;
   }
 
-  // Get vectors
-  size_t len_a, len_b;
-  float *vector_a = GetFloatArrayFromValue(env, args[0], &len_a);
-  float *vector_b = GetFloatArrayFromValue(env, args[1], &len_b);
+  if (!GetOptionalInt(env, object, "intraOpThreads",
+                      &options->intra_op_threads) ||
+      !GetOptionalInt(env, object, "interOpThreads",
+                      &options->inter_op_threads) ||
+      !GetOptionalInt(env, object, "enableMemPattern",
+                      &options->enable_mem_pattern) ||
+      !GetOptionalInt(env, object, "enableCpuMemArena",
+                      &options->enable_cpu_mem_arena) ||
+      !GetOptionalInt(env, object, "deviceId", &options->device_id)) {
+    napi_throw_type_error(env, nullptr,
+                          "Invalid ONNX option (expected number or boolean)");
+    return false;
+  }
 
-  if (!vector_a || !vector_b) {
-    if (vector_a)
-      free(vector_a);
-    if (vector_b)
-      free(vector_b);
-    napi_throw_error(env, nullptr, "Invalid vector arguments");
-    return nullptr;
+  bool has_property;
+  napi_value value;
+
+  // graphOptimizationLevel: 'disable' | 'basic' | 'extended' | 'all'
+  napi_has_named_property(env, object, "graphOptimizationLevel",
+                          &has_property);
+  if (has_property) {
+    napi_get_named_property(env, object, "graphOptimizationLevel", &value);
+    napi_typeof(env, value, &valuetype);
+    if (valuetype == napi_string) {
+      char *name = GetStringFromValue(env, value);
+      int level = -1;
+      for (size_t i = 0; i < sizeof(kGraphOptLevels) / sizeof(kGraphOptLevels[0]);
+           i++) {
+        if (strcmp(name, kGraphOptLevels[i].name) == 0) {
+          level = kGraphOptLevels[i].level;
+        }
+      }
+      free(name);
+      if (level < 0) {
+        napi_throw_error(env, nullptr,
+                         "Invalid graphOptimizationLevel (expected 'disable', "
+                         "'basic', 'extended' or 'all')");
+        return false;
+      }
+      options->graph_opt_level = level;
+    } else if (valuetype != napi_undefined) {
+      napi_throw_type_error(env, nullptr,
+                            "graphOptimizationLevel must be a string");
+      return false;
+    }
   }
 
-  if (len_a != len_b) {
-    free(vector_a);
-    free(vector_b);
-    napi_throw_error(env, nullptr, "Vectors must have the same length");
-    return nullptr;
+  // pooling: 'cls' | 'mean' | 'max' | 'last_token'
+  napi_has_named_property(env, object, "pooling", &has_property);
+  if (has_property) {
+    napi_get_named_property(env, object, "pooling", &value);
+    napi_typeof(env, value, &valuetype);
+    if (valuetype == napi_string) {
+      char *name = GetStringFromValue(env, value);
+      int pooling = -1;
+      for (size_t i = 0; i < sizeof(kPoolingModes) / sizeof(kPoolingModes[0]);
+           i++) {
+        if (strcmp(name, kPoolingModes[i].name) == 0) {
+          pooling = kPoolingModes[i].pooling;
+        }
+      }
+      free(name);
+      if (pooling < 0) {
+        napi_throw_error(env, nullptr,
+                         "Invalid pooling (expected 'cls', 'mean', 'max' or "
+                         "'last_token')");
+        return false;
+      }
+      options->pooling = pooling;
+    } else if (valuetype != napi_undefined) {
+      napi_throw_type_error(env, nullptr, "pooling must be a string");
+      return false;
+    }
   }
 
-  // Call C function
-  float similarity =
-      fastembed_cosine_similarity(vector_a, vector_b, (int)len_a);
+  // executionProviders: ['cuda', 'cpu', ...] in order of preference
+  napi_has_named_property(env, object, "executionProviders", &has_property);
+  if (has_property) {
+    napi_get_named_property(env, object, "executionProviders", &value);
+    bool is_array;
+    napi_is_array(env, value, &is_array);
+    if (!is_array) {
+      napi_throw_type_error(env, nullptr,
+                            "executionProviders must be an array of strings");
+      return false;
+    }
 
-  free(vector_a);
-  free(vector_b);
+    uint32_t length;
+    napi_get_array_length(env, value, &length);
+    if (length > FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS) {
+      napi_throw_error(env, nullptr, "Too many executionProviders");
+      return false;
+    }
 
-  // Return result
-  napi_value result;
-  napi_create_double(env, similarity, &result);
+    for (uint32_t i = 0; i < length; i++) {
+      napi_value element;
+      napi_get_element(env, value, i, &element);
+      napi_typeof(env, element, &valuetype);
+      if (valuetype != napi_string) {
+        napi_throw_type_error(env, nullptr,
+                              "executionProviders must be an array of strings");
+        return false;
+      }
+
+      char *name = GetStringFromValue(env, element);
+      int provider = -1;
+      for (size_t j = 0;
+           j < sizeof(kExecutionProviders) / sizeof(kExecutionProviders[0]);
+           j++) {
+        if (strcmp(name, kExecutionProviders[j].name) == 0) {
+          provider = kExecutionProviders[j].provider;
+        }
+      }
+
+      if (provider < 0) {
+        char message[192];
+        snprintf(message, sizeof(message),
+                 "Unknown execution provider: %.64s (expected cpu, cuda, "
+                 "tensorrt, coreml or xnnpack)",
+                 name);
+        free(name);
+        napi_throw_error(env, nullptr, message);
+        return false;
+      }
+      free(name);
+      options->execution_providers[i] = provider;
+    }
+    options->num_execution_providers = (int)length;
+  }
 
-  return result;
+  // optimizedModelPath: optional path for the optimized-model cache
+  // tokenizerPath: optional vocab.txt / tokenizer.json (default: discovered)
+  if (!GetOptionalString(env, object, "optimizedModelPath", optimized_path) ||
+      !GetOptionalString(env, object, "tokenizerPath", tokenizer_path)) {
+    return false;
+  }
+  options->optimized_model_path = *optimized_path;
+  options->tokenizer_path = *tokenizer_path;
+
+  return true;
 }
 
 /**
- * Calculate dot product of two vectors
+ * Open an ONNX model with session options
  *
- * @param vector_a - First vector
- * @param vector_b - Second vector
- * @returns Dot product value (float)
+ * @param modelPath - Path to ONNX model file
+ * @param options - Optional session options object (intraOpThreads,
+ * interOpThreads, graphOptimizationLevel, enableMemPattern, enableCpuMemArena,
+ * executionProviders, deviceId, optimizedModelPath, tokenizerPath, pooling)
+ * @returns Opaque model handle (close with closeOnnxModel)
  */
-static napi_value DotProduct(napi_env env, napi_callback_info info) {
+static napi_value OpenOnnxModel(napi_env env, napi_callback_info info) {
   size_t argc = 2;
   napi_value args[2];
   napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
-  if (argc < 2) {
-    napi_throw_error(env, nullptr, "Expected 2 arguments: vector_a, vector_b");
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected at least 1 argument: modelPath");
     return nullptr;
   }
 
-  size_t len_a, len_b;
-  float *vector_a = GetFloatArrayFromValue(env, args[0], &len_a);
-  float *vector_b = GetFloatArrayFromValue(env, args[1], &len_b);
+  napi_valuetype valuetype;
+  napi_typeof(env, args[0], &valuetype);
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "modelPath must be a string");
+    return nullptr;
+  }
 
-  if (!vector_a || !vector_b || len_a != len_b) {
-    if (vector_a)
-      free(vector_a);
-    if (vector_b)
-      free(vector_b);
-    napi_throw_error(env, nullptr, "Invalid vector arguments");
+  fastembed_onnx_options_t options;
+  char *optimized_path = nullptr;
+  char *tokenizer_path = nullptr;
+  napi_value undefined;
+  napi_get_undefined(env, &undefined);
+  if (!ParseOnnxOptions(env, argc >= 2 ? args[1] : undefined, &options,
+                        &optimized_path, &tokenizer_path)) {
+    free(optimized_path);
+    free(tokenizer_path);
     return nullptr;
   }
 
-  float dot = fastembed_dot_product(vector_a, vector_b, (int)len_a);
+  char *model_path = GetStringFromValue(env, args[0]);
+  fastembed_model_t *model =
+      fastembed_model_open_with_options(model_path, &options);
+  free(optimized_path);
+  free(tokenizer_path);
 
-  free(vector_a);
-  free(vector_b);
+  if (!model) {
+    char error_buffer[512];
+    const char *error_message = "unknown error";
+    if (fastembed_onnx_get_last_error(error_buffer, sizeof(error_buffer)) ==
+        0) {
+      error_message = error_buffer;
+    }
 
-  napi_value result;
-  napi_create_double(env, dot, &result);
+    char detailed_error[1024];
+    snprintf(detailed_error, sizeof(detailed_error),
+             "Failed to open ONNX model: %s (model_path: %s)", error_message,
+             model_path);
+    free(model_path);
+    napi_throw_error(env, nullptr, detailed_error);
+    return nullptr;
+  }
+  free(model_path);
 
-  return result;
+  OnnxModelRef *ref = (OnnxModelRef *)malloc(sizeof(OnnxModelRef));
+  ref->model = model;
+  ref->pending = 0;
+  ref->closing = false;
+
+  napi_value handle;
+  napi_create_external(env, ref, FinalizeOnnxModel, nullptr, &handle);
+  return handle;
 }
 
 /**
- * Calculate vector norm (L2 norm)
+ * Close an ONNX model handle (safe to call more than once)
  *
- * @param vector - Input vector
- * @returns Norm value (float)
+ * @param model - Handle returned by openOnnxModel
+ * @returns Number (0 on success)
  */
-static napi_value VectorNorm(napi_env env, napi_callback_info info) {
+static napi_value CloseOnnxModel(napi_env env, napi_callback_info info) {
   size_t argc = 1;
   napi_value args[1];
   napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
-  if (argc < 1) {
-    napi_throw_error(env, nullptr, "Expected 1 argument: vector");
-    return nullptr;
+  int result = -1;
+  napi_valuetype valuetype = napi_undefined;
+  if (argc >= 1) {
+    napi_typeof(env, args[0], &valuetype);
   }
-
-  size_t length;
-  float *vector = GetFloatArrayFromValue(env, args[0], &length);
-
-  if (!vector) {
-    napi_throw_error(env, nullptr, "Invalid vector argument");
+  if (valuetype != napi_external) {
+    napi_throw_type_error(env, nullptr, "Expected an ONNX model handle");
     return nullptr;
   }
 
-  float norm = fastembed_vector_norm(vector, (int)length);
-
-  free(vector);
-
-  napi_value result;
-  napi_create_double(env, norm, &result);
+  void *data;
+  napi_get_value_external(env, args[0], &data);
+  OnnxModelRef *ref = (OnnxModelRef *)data;
+  if (ref->model && ref->pending > 0) {
+    ref->closing = true; // Closed by the last running async call
+    result = 0;
+  } else if (ref->model) {
+    result = fastembed_model_close(ref->model);
+    ref->model = nullptr;
+  } else {
+    result = 0; // Already closed
+  }
 
-  return result;
+  napi_value return_value;
+  napi_create_int32(env, result, &return_value);
+  return return_value;
 }
 
 /**
- * Normalize vector in-place (L2 normalization)
+ * Get output dimension of an open ONNX model
  *
- * @param vector - Input/output vector
- * @returns Normalized vector (Float32Array)
+ * @param model - Handle returned by openOnnxModel
+ * @returns Number (model dimension)
  */
-static napi_value NormalizeVector(napi_env env, napi_callback_info info) {
+static napi_value GetOnnxModelDimension(napi_env env,
+                                        napi_callback_info info) {
   size_t argc = 1;
   napi_value args[1];
   napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
   if (argc < 1) {
-    napi_throw_error(env, nullptr, "Expected 1 argument: vector");
+    napi_throw_error(env, nullptr, "Expected 1 argument: model");
     return nullptr;
   }
 
-  size_t length;
-  float *vector = GetFloatArrayFromValue(env, args[0], &length);
-
-  if (!vector) {
-    napi_throw_error(env, nullptr, "Invalid vector argument");
+  fastembed_model_t *model = GetModelFromValue(env, args[0]);
+  if (!model) {
     return nullptr;
   }
 
-  fastembed_normalize(vector, (int)length);
+  napi_value return_value;
+  napi_create_int32(env, fastembed_model_get_dimension(model), &return_value);
+  return return_value;
+}
 
-  // Create Float32Array with normalized values
-  napi_value arraybuffer;
-  void *data;
-  napi_create_arraybuffer(env, length * sizeof(float), &data, &arraybuffer);
-  memcpy(data, vector, length * sizeof(float));
+/**
+ * Get the execution provider an open ONNX model runs on
+ *
+ * @param model - Handle returned by openOnnxModel
+ * @returns String ('cpu', 'cuda', 'tensorrt', 'coreml' or 'xnnpack')
+ */
+static napi_value GetOnnxModelExecutionProvider(napi_env env,
+                                                napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
-  napi_value typedarray;
-  napi_create_typedarray(env, napi_float32_array, length, arraybuffer, 0,
-                         &typedarray);
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: model");
+    return nullptr;
+  }
 
-  free(vector);
+  fastembed_model_t *model = GetModelFromValue(env, args[0]);
+  if (!model) {
+    return nullptr;
+  }
 
-  return typedarray;
+  int provider = fastembed_model_get_execution_provider(model);
+  const char *name = "cpu";
+  for (size_t i = 0;
+       i < sizeof(kExecutionProviders) / sizeof(kExecutionProviders[0]); i++) {
+    if (kExecutionProviders[i].provider == provider) {
+      name = kExecutionProviders[i].name;
+    }
+  }
+
+  napi_value return_value;
+  napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &return_value);
+  return return_value;
 }
 
 /**
- * Add two vectors element-wise
+ * Generate embedding from text using an open ONNX model
  *
- * @param vector_a - First vector
- * @param vector_b - Second vector
- * @returns Result vector (Float32Array)
+ * @param model - Handle returned by openOnnxModel
+ * @param text - Input text string
+ * @param dimension - Embedding dimension (default: model dimension)
+ * @returns Float32Array with embedding vector
  */
-static napi_value AddVectors(napi_env env, napi_callback_info info) {
-  size_t argc = 2;
-  napi_value args[2];
+static napi_value GenerateOnnxEmbeddingWithModel(napi_env env,
+                                                 napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
   napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
   if (argc < 2) {
-    napi_throw_error(env, nullptr, "Expected 2 arguments: vector_a, vector_b");
+    napi_throw_error(env, nullptr, "Expected at least 2 arguments: model, text");
     return nullptr;
   }
 
-  size_t len_a, len_b;
-  float *vector_a = GetFloatArrayFromValue(env, args[0], &len_a);
-  float *vector_b = GetFloatArrayFromValue(env, args[1], &len_b);
+  fastembed_model_t *model = GetModelFromValue(env, args[0]);
+  if (!model) {
+    return nullptr;
+  }
 
-  if (!vector_a || !vector_b || len_a != len_b) {
+  napi_valuetype valuetype;
+  napi_typeof(env, args[1], &valuetype);
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "Text argument must be a string");
+    return nullptr;
+  }
+
+  // Get dimension argument (default: model dimension)
+  int dimension = fastembed_model_get_dimension(model);
+  if (argc >= 3) {
+    napi_typeof(env, args[2], &valuetype);
+    if (valuetype == napi_number) {
+      napi_get_value_int32(env, args[2], &dimension);
+    }
+  }
+  if (dimension <= 0) {
+    napi_throw_error(env, nullptr, "Invalid dimension");
+    return nullptr;
+  }
+
+  char *text = GetStringFromValue(env, args[1]);
+
+  // Write straight into the ArrayBuffer backing the result
+  napi_value arraybuffer;
+  void *data;
+  napi_create_arraybuffer(env, dimension * sizeof(float), &data, &arraybuffer);
+
+  int result = fastembed_model_generate(model, text, (float *)data, dimension);
+  free(text);
+
+  if (result != 0) {
+    char error_buffer[512];
+    const char *error_message = "unknown error";
+    if (fastembed_onnx_get_last_error(error_buffer, sizeof(error_buffer)) ==
+        0) {
+      error_message = error_buffer;
+    }
+
+    char detailed_error[1024];
+    snprintf(detailed_error, sizeof(detailed_error),
+             "Failed to generate ONNX embedding: %s (dimension: %d)",
+             error_message, dimension);
+    napi_throw_error(env, nullptr, detailed_error);
+    return nullptr;
+  }
+
+  napi_value typedarray;
+  napi_create_typedarray(env, napi_float32_array, dimension, arraybuffer, 0,
+                         &typedarray);
+  return typedarray;
+}
+
+/**
+ * Calculate cosine similarity between two vectors
+ *
+ * @param vector_a - First vector (Float32Array or Array)
+ * @param vector_b - Second vector (Float32Array or Array)
+ * @returns Cosine similarity value (float)
+ */
+static napi_value CosineSimilarity(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected 2 arguments: vector_a, vector_b");
+    return nullptr;
+  }
+
+  // Get vectors
+  size_t len_a, len_b;
+  float *vector_a = GetFloatArrayFromValue(env, args[0], &len_a);
+  float *vector_b = GetFloatArrayFromValue(env, args[1], &len_b);
+
+  if (!vector_a || !vector_b) {
+    if (vector_a)
+      free(vector_a);
+    if (vector_b)
+      free(vector_b);
+    napi_throw_error(env, nullptr, "Invalid vector arguments");
+    return nullptr;
+  }
+
+  if (len_a != len_b) {
+    free(vector_a);
+    free(vector_b);
+    napi_throw_error(env, nullptr, "Vectors must have the same length");
+    return nullptr;
+  }
+
+  // Call C function
+  float similarity =
+      fastembed_cosine_similarity(vector_a, vector_b, (int)len_a);
+
+  free(vector_a);
+  free(vector_b);
+
+  // Return result
+  napi_value result;
+  napi_create_double(env, similarity, &result);
+
+  return result;
+}
+
+/**
+ * Calculate dot product of two vectors
+ *
+ * @param vector_a - First vector
+ * @param vector_b - Second vector
+ * @returns Dot product value (float)
+ */
+static napi_value DotProduct(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected 2 arguments: vector_a, vector_b");
+    return nullptr;
+  }
+
+  size_t len_a, len_b;
+  float *vector_a = GetFloatArrayFromValue(env, args[0], &len_a);
+  float *vector_b = GetFloatArrayFromValue(env, args[1], &len_b);
+
+  if (!vector_a || !vector_b || len_a != len_b) {
+    if (vector_a)
+      free(vector_a);
+    if (vector_b)
+      free(vector_b);
+    napi_throw_error(env, nullptr, "Invalid vector arguments");
+    return nullptr;
+  }
+
+  float dot = fastembed_dot_product(vector_a, vector_b, (int)len_a);
+
+  free(vector_a);
+  free(vector_b);
+
+  napi_value result;
+  napi_create_double(env, dot, &result);
+
+  return result;
+}
+
+/**
+ * Calculate vector norm (L2 norm)
+ *
+ * @param vector - Input vector
+ * @returns Norm value (float)
+ */
+static napi_value VectorNorm(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: vector");
+    return nullptr;
+  }
+
+  size_t length;
+  float *vector = GetFloatArrayFromValue(env, args[0], &length);
+
+  if (!vector) {
+    napi_throw_error(env, nullptr, "Invalid vector argument");
+    return nullptr;
+  }
+
+  float norm = fastembed_vector_norm(vector, (int)length);
+
+  free(vector);
+
+  napi_value result;
+  napi_create_double(env, norm, &result);
+
+  return result;
+}
+
+/**
+ * Normalize vector in-place (L2 normalization)
+ *
+ * @param vector - Input/output vector
+ * @returns Normalized vector (Float32Array)
+ */
+static napi_value NormalizeVector(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: vector");
+    return nullptr;
+  }
+
+  size_t length;
+  float *vector = GetFloatArrayFromValue(env, args[0], &length);
+
+  if (!vector) {
+    napi_throw_error(env, nullptr, "Invalid vector argument");
+    return nullptr;
+  }
+
+  fastembed_normalize(vector, (int)length);
+
+  // Create Float32Array with normalized values
+  napi_value arraybuffer;
+  void *data;
+  napi_create_arraybuffer(env, length * sizeof(float), &data, &arraybuffer);
+  memcpy(data, vector, length * sizeof(float));
+
+  napi_value typedarray;
+  napi_create_typedarray(env, napi_float32_array, length, arraybuffer, 0,
+                         &typedarray);
+
+  free(vector);
+
+  return typedarray;
+}
+
+/**
+ * Add two vectors element-wise
+ *
+ * @param vector_a - First vector
+ * @param vector_b - Second vector
+ * @returns Result vector (Float32Array)
+ */
+static napi_value AddVectors(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected 2 arguments: vector_a, vector_b");
+    return nullptr;
+  }
+
+  size_t len_a, len_b;
+  float *vector_a = GetFloatArrayFromValue(env, args[0], &len_a);
+  float *vector_b = GetFloatArrayFromValue(env, args[1], &len_b);
+
+  if (!vector_a || !vector_b || len_a != len_b) {
     if (vector_a)
       free(vector_a);
     if (vector_b)
@@ -524,11 +1231,2034 @@ static napi_value AddVectors(napi_env env, napi_callback_info info) {
   return typedarray;
 }
 
+/**
+ * Score every query row against every corpus row in one call
+ *
+ * @param queries - Row-major [numQueries x dimension] matrix
+ * @param corpus - Row-major [numCorpus x dimension] matrix
+ * @param dimension - Vector dimension
+ * @param metric - 'cosine' (default), 'dot' or 'euclidean'
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns Row-major [numQueries x numCorpus] scores (Float32Array)
+ */
+static napi_value SimilarityMatrix(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 3 arguments: queries, corpus, "
+                     "dimension");
+    return nullptr;
+  }
+
+  int32_t dimension = 0;
+  if (napi_get_value_int32(env, args[2], &dimension) != napi_ok ||
+      dimension <= 0) {
+    napi_throw_error(env, nullptr, "dimension must be a positive integer");
+    return nullptr;
+  }
+
+  int metric;
+  int32_t threads;
+  if (!GetSimilarityOptions(env, argc, args, 3, &metric, &threads)) {
+    return nullptr;
+  }
+
+  size_t len_queries, len_corpus;
+  float *queries = GetFloatArrayFromValue(env, args[0], &len_queries);
+  float *corpus = GetFloatArrayFromValue(env, args[1], &len_corpus);
+
+  if (!queries || !corpus || len_queries == 0 || len_corpus == 0 ||
+      len_queries % dimension != 0 || len_corpus % dimension != 0) {
+    if (queries)
+      free(queries);
+    if (corpus)
+      free(corpus);
+    napi_throw_error(env, nullptr,
+                     "queries and corpus must be non-empty and a multiple of "
+                     "dimension in length");
+    return nullptr;
+  }
+
+  size_t num_queries = len_queries / dimension;
+  size_t num_corpus = len_corpus / dimension;
+
+  // Write scores straight into the returned buffer
+  napi_value arraybuffer;
+  void *data = nullptr;
+  if (napi_create_arraybuffer(env, num_queries * num_corpus * sizeof(float),
+                              &data, &arraybuffer) != napi_ok) {
+    free(queries);
+    free(corpus);
+    napi_throw_error(env, nullptr, "Failed to allocate similarity matrix");
+    return nullptr;
+  }
+
+  int result = fastembed_similarity_matrix_threaded(
+      queries, (int)num_queries, corpus, (int)num_corpus, dimension,
+      (float *)data, metric, threads);
+
+  free(queries);
+  free(corpus);
+
+  if (result != 0) {
+    napi_throw_error(env, nullptr, "Failed to compute similarity matrix");
+    return nullptr;
+  }
+
+  napi_value typedarray;
+  napi_create_typedarray(env, napi_float32_array, num_queries * num_corpus,
+                         arraybuffer, 0, &typedarray);
+  return typedarray;
+}
+
+/**
+ * Find the k corpus rows most similar to a query
+ *
+ * @param query - Query vector
+ * @param corpus - Row-major [numCorpus x query.length] matrix
+ * @param k - Number of results
+ * @param metric - 'cosine' (default), 'dot' or 'euclidean' (nearest first)
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns { ids: Int32Array, scores: Float32Array }, best first
+ */
+static napi_value TopK(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 3 arguments: query, corpus, k");
+    return nullptr;
+  }
+
+  int32_t k = 0;
+  if (napi_get_value_int32(env, args[2], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+
+  int metric;
+  int32_t threads;
+  if (!GetSimilarityOptions(env, argc, args, 3, &metric, &threads)) {
+    return nullptr;
+  }
+
+  size_t dimension, len_corpus;
+  float *query = GetFloatArrayFromValue(env, args[0], &dimension);
+  float *corpus = GetFloatArrayFromValue(env, args[1], &len_corpus);
+
+  if (!query || !corpus || dimension == 0 || len_corpus == 0 ||
+      len_corpus % dimension != 0) {
+    if (query)
+      free(query);
+    if (corpus)
+      free(corpus);
+    napi_throw_error(env, nullptr,
+                     "corpus must be a non-empty multiple of the query "
+                     "length");
+    return nullptr;
+  }
+
+  size_t num_corpus = len_corpus / dimension;
+  if ((size_t)k > num_corpus) {
+    k = (int32_t)num_corpus;
+  }
+
+  napi_value ids_buffer, scores_buffer;
+  void *ids_data = nullptr;
+  void *scores_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(float), &scores_data,
+                          &scores_buffer);
+
+  int count = fastembed_topk_threaded(
+      query, corpus, (int)num_corpus, (int)dimension, k, (int *)ids_data,
+      (float *)scores_data, metric, threads);
+
+  free(query);
+  free(corpus);
+
+  if (count < 0) {
+    napi_throw_error(env, nullptr, "Failed to compute top-k");
+    return nullptr;
+  }
+
+  napi_value ids, scores, result;
+  napi_create_typedarray(env, napi_int32_array, count, ids_buffer, 0, &ids);
+  napi_create_typedarray(env, napi_float32_array, count, scores_buffer, 0,
+                         &scores);
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "ids", ids);
+  napi_set_named_property(env, result, "scores", scores);
+  return result;
+}
+
+// Helper: Borrow the elements of a typed array of the given type (no copy;
+// only valid during the current call)
+static void *GetTypedArrayData(napi_env env, napi_value value,
+                               napi_typedarray_type expected,
+                               size_t *out_length) {
+  bool is_typedarray = false;
+  napi_is_typedarray(env, value, &is_typedarray);
+  if (!is_typedarray) {
+    return nullptr;
+  }
+
+  napi_typedarray_type type;
+  size_t length;
+  void *data;
+  napi_value arraybuffer;
+  size_t byte_offset;
+  napi_get_typedarray_info(env, value, &type, &length, &data, &arraybuffer,
+                           &byte_offset);
+  if (type != expected) {
+    return nullptr;
+  }
+
+  *out_length = length;
+  return data;
+}
+
+// Helper: Copy an Int32Array or array of numbers (caller frees)
+static int *GetIntArrayFromValue(napi_env env, napi_value value,
+                                 size_t *out_length) {
+  size_t length = 0;
+  void *data = GetTypedArrayData(env, value, napi_int32_array, &length);
+  if (data) {
+    *out_length = length;
+    int *result = (int *)malloc((length ? length : 1) * sizeof(int));
+    memcpy(result, data, length * sizeof(int));
+    return result;
+  }
+
+  bool is_array;
+  napi_is_array(env, value, &is_array);
+  if (!is_array) {
+    return nullptr;
+  }
+
+  uint32_t array_length;
+  napi_get_array_length(env, value, &array_length);
+  *out_length = array_length;
+  int *result = (int *)malloc((array_length ? array_length : 1) * sizeof(int));
+  for (uint32_t i = 0; i < array_length; i++) {
+    napi_value element;
+    napi_get_element(env, value, i, &element);
+    int32_t id = -1;
+    napi_get_value_int32(env, element, &id);
+    result[i] = id;
+  }
+  return result;
+}
+
+// Helper: Read the optional threads argument (returns false with a pending
+// exception if it is not a number)
+static bool GetOptionalThreads(napi_env env, size_t argc, napi_value *args,
+                               size_t index, int32_t *threads) {
+  *threads = 1;
+  napi_valuetype valuetype = napi_undefined;
+  if (argc > index) {
+    napi_typeof(env, args[index], &valuetype);
+  }
+  if (valuetype == napi_number) {
+    napi_get_value_int32(env, args[index], threads);
+  } else if (valuetype != napi_undefined) {
+    napi_throw_type_error(env, nullptr, "threads must be a number");
+    return false;
+  }
+  return true;
+}
+
+// Helper: { ids: Int32Array, <name>: Float32Array | Int32Array } result of
+// the top-k functions, trimmed to count entries
+static napi_value MakeTopKResult(napi_env env, napi_value ids_buffer,
+                                 napi_value values_buffer, int count,
+                                 const char *values_name,
+                                 napi_typedarray_type values_type) {
+  napi_value ids, values, result;
+  napi_create_typedarray(env, napi_int32_array, count, ids_buffer, 0, &ids);
+  napi_create_typedarray(env, values_type, count, values_buffer, 0, &values);
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "ids", ids);
+  napi_set_named_property(env, result, values_name, values);
+  return result;
+}
+
+/**
+ * Quantize row-major float vectors to int8 (one scale per vector)
+ *
+ * @param vectors - Row-major [count x dimension] floats
+ * @param dimension - Vector dimension
+ * @returns { codes: Int8Array, scales: Float32Array }
+ */
+static napi_value QuantizeInt8(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr,
+                     "Expected 2 arguments: vectors, dimension");
+    return nullptr;
+  }
+
+  int32_t dimension = 0;
+  if (napi_get_value_int32(env, args[1], &dimension) != napi_ok ||
+      dimension <= 0) {
+    napi_throw_error(env, nullptr, "dimension must be a positive integer");
+    return nullptr;
+  }
+
+  size_t length;
+  float *vectors = GetFloatArrayFromValue(env, args[0], &length);
+  if (!vectors || length == 0 || length % dimension != 0) {
+    if (vectors)
+      free(vectors);
+    napi_throw_error(env, nullptr,
+                     "vectors must be a non-empty multiple of dimension in "
+                     "length");
+    return nullptr;
+  }
+
+  size_t count = length / dimension;
+  napi_value codes_buffer, scales_buffer;
+  void *codes_data = nullptr;
+  void *scales_data = nullptr;
+  napi_create_arraybuffer(env, length, &codes_data, &codes_buffer);
+  napi_create_arraybuffer(env, count * sizeof(float), &scales_data,
+                          &scales_buffer);
+
+  int result = fastembed_quantize_int8(vectors, (int)count, dimension,
+                                       (int8_t *)codes_data,
+                                       (float *)scales_data);
+  free(vectors);
+
+  if (result != 0) {
+    napi_throw_error(env, nullptr, "Failed to quantize vectors");
+    return nullptr;
+  }
+
+  napi_value codes, scales, object;
+  napi_create_typedarray(env, napi_int8_array, length, codes_buffer, 0,
+                         &codes);
+  napi_create_typedarray(env, napi_float32_array, count, scales_buffer, 0,
+                         &scales);
+  napi_create_object(env, &object);
+  napi_set_named_property(env, object, "codes", codes);
+  napi_set_named_property(env, object, "scales", scales);
+  return object;
+}
+
+/**
+ * Binarize row-major float vectors to packed sign bits
+ *
+ * @param vectors - Row-major [count x dimension] floats
+ * @param dimension - Vector dimension
+ * @returns Uint8Array of count * ceil(dimension / 8) bytes (bit set = positive)
+ */
+static napi_value QuantizeBinary(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr,
+                     "Expected 2 arguments: vectors, dimension");
+    return nullptr;
+  }
+
+  int32_t dimension = 0;
+  if (napi_get_value_int32(env, args[1], &dimension) != napi_ok ||
+      dimension <= 0) {
+    napi_throw_error(env, nullptr, "dimension must be a positive integer");
+    return nullptr;
+  }
+
+  size_t length;
+  float *vectors = GetFloatArrayFromValue(env, args[0], &length);
+  if (!vectors || length == 0 || length % dimension != 0) {
+    if (vectors)
+      free(vectors);
+    napi_throw_error(env, nullptr,
+                     "vectors must be a non-empty multiple of dimension in "
+                     "length");
+    return nullptr;
+  }
+
+  size_t count = length / dimension;
+  size_t bytes = count * FASTEMBED_BINARY_BYTES(dimension);
+  napi_value bits_buffer;
+  void *bits_data = nullptr;
+  napi_create_arraybuffer(env, bytes, &bits_data, &bits_buffer);
+
+  int result = fastembed_quantize_binary(vectors, (int)count, dimension,
+                                         (uint8_t *)bits_data);
+  free(vectors);
+
+  if (result != 0) {
+    napi_throw_error(env, nullptr, "Failed to binarize vectors");
+    return nullptr;
+  }
+
+  napi_value bits;
+  napi_create_typedarray(env, napi_uint8_array, bytes, bits_buffer, 0, &bits);
+  return bits;
+}
+
+/**
+ * Find the k int8-quantized rows with the highest dot product
+ *
+ * @param queryCodes - Query codes (Int8Array)
+ * @param queryScale - Query scale
+ * @param corpusCodes - Row-major corpus codes (Int8Array)
+ * @param corpusScales - Per-row scales (Float32Array)
+ * @param k - Number of results
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns { ids: Int32Array, scores: Float32Array }, best first
+ */
+static napi_value TopKInt8(napi_env env, napi_callback_info info) {
+  size_t argc = 6;
+  napi_value args[6];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 5) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 5 arguments: queryCodes, queryScale, "
+                     "corpusCodes, corpusScales, k");
+    return nullptr;
+  }
+
+  double query_scale = 0.0;
+  int32_t k = 0;
+  int32_t threads;
+  if (napi_get_value_double(env, args[1], &query_scale) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "queryScale must be a number");
+    return nullptr;
+  }
+  if (napi_get_value_int32(env, args[4], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+  if (!GetOptionalThreads(env, argc, args, 5, &threads)) {
+    return nullptr;
+  }
+
+  size_t dimension = 0, len_codes = 0, num_scales = 0;
+  int8_t *query =
+      (int8_t *)GetTypedArrayData(env, args[0], napi_int8_array, &dimension);
+  int8_t *codes =
+      (int8_t *)GetTypedArrayData(env, args[2], napi_int8_array, &len_codes);
+  float *scales = (float *)GetTypedArrayData(env, args[3], napi_float32_array,
+                                             &num_scales);
+  if (!query || !codes || !scales || dimension == 0 || len_codes == 0 ||
+      len_codes != num_scales * dimension) {
+    napi_throw_error(env, nullptr,
+                     "Expected Int8Array codes with one Float32Array scale "
+                     "per query-length corpus row");
+    return nullptr;
+  }
+
+  if ((size_t)k > num_scales) {
+    k = (int32_t)num_scales;
+  }
+
+  napi_value ids_buffer, scores_buffer;
+  void *ids_data = nullptr;
+  void *scores_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(float), &scores_data,
+                          &scores_buffer);
+
+  int count = fastembed_topk_int8(query, (float)query_scale, codes, scales,
+                                  (int)num_scales, (int)dimension, k,
+                                  (int *)ids_data, (float *)scores_data,
+                                  threads);
+  if (count < 0) {
+    napi_throw_error(env, nullptr, "Failed to compute int8 top-k");
+    return nullptr;
+  }
+
+  return MakeTopKResult(env, ids_buffer, scores_buffer, count, "scores",
+                        napi_float32_array);
+}
+
+/**
+ * Find the k binary-quantized rows nearest in Hamming distance
+ *
+ * @param queryBits - Query bits (Uint8Array)
+ * @param corpusBits - Row-major corpus bits (Uint8Array)
+ * @param dimension - Vector dimension (bits per row)
+ * @param k - Number of results
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns { ids: Int32Array, distances: Int32Array }, nearest first
+ */
+static napi_value TopKBinary(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 4) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 4 arguments: queryBits, corpusBits, "
+                     "dimension, k");
+    return nullptr;
+  }
+
+  int32_t dimension = 0, k = 0;
+  int32_t threads;
+  if (napi_get_value_int32(env, args[2], &dimension) != napi_ok ||
+      dimension <= 0) {
+    napi_throw_error(env, nullptr, "dimension must be a positive integer");
+    return nullptr;
+  }
+  if (napi_get_value_int32(env, args[3], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+  if (!GetOptionalThreads(env, argc, args, 4, &threads)) {
+    return nullptr;
+  }
+
+  size_t row_bytes = FASTEMBED_BINARY_BYTES(dimension);
+  size_t len_query = 0, len_corpus = 0;
+  uint8_t *query =
+      (uint8_t *)GetTypedArrayData(env, args[0], napi_uint8_array, &len_query);
+  uint8_t *corpus = (uint8_t *)GetTypedArrayData(env, args[1],
+                                                 napi_uint8_array, &len_corpus);
+  if (!query || !corpus || len_query != row_bytes || len_corpus == 0 ||
+      len_corpus % row_bytes != 0) {
+    napi_throw_error(env, nullptr,
+                     "Expected Uint8Array bits of ceil(dimension / 8) bytes "
+                     "per row");
+    return nullptr;
+  }
+
+  size_t num_corpus = len_corpus / row_bytes;
+  if ((size_t)k > num_corpus) {
+    k = (int32_t)num_corpus;
+  }
+
+  napi_value ids_buffer, distances_buffer;
+  void *ids_data = nullptr;
+  void *distances_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &distances_data,
+                          &distances_buffer);
+
+  int count = fastembed_topk_binary(query, corpus, (int)num_corpus, dimension,
+                                    k, (int *)ids_data, (int *)distances_data,
+                                    threads);
+  if (count < 0) {
+    napi_throw_error(env, nullptr, "Failed to compute binary top-k");
+    return nullptr;
+  }
+
+  return MakeTopKResult(env, ids_buffer, distances_buffer, count, "distances",
+                        napi_int32_array);
+}
+
+/**
+ * Rerank a shortlist of corpus rows with exact float scores
+ *
+ * @param query - Query vector
+ * @param corpus - Row-major [numCorpus x query.length] matrix
+ * @param candidates - Corpus row ids to score (e.g. topKBinary() ids)
+ * @param k - Number of results
+ * @param metric - 'cosine' (default), 'dot' or 'euclidean' (nearest first)
+ * @returns { ids: Int32Array, scores: Float32Array }, best first
+ */
+static napi_value Rescore(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 4) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 4 arguments: query, corpus, "
+                     "candidates, k");
+    return nullptr;
+  }
+
+  int32_t k = 0;
+  if (napi_get_value_int32(env, args[3], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+
+  int metric;
+  int32_t unused_threads;
+  if (!GetSimilarityOptions(env, argc, args, 4, &metric, &unused_threads)) {
+    return nullptr;
+  }
+
+  size_t dimension, len_corpus, num_candidates;
+  float *query = GetFloatArrayFromValue(env, args[0], &dimension);
+  float *corpus = GetFloatArrayFromValue(env, args[1], &len_corpus);
+  int *candidates = GetIntArrayFromValue(env, args[2], &num_candidates);
+
+  if (!query || !corpus || !candidates || dimension == 0 || len_corpus == 0 ||
+      len_corpus % dimension != 0 || num_candidates == 0) {
+    free(query);
+    free(corpus);
+    free(candidates);
+    napi_throw_error(env, nullptr,
+                     "corpus must be a non-empty multiple of the query "
+                     "length and candidates non-empty");
+    return nullptr;
+  }
+
+  if ((size_t)k > num_candidates) {
+    k = (int32_t)num_candidates;
+  }
+
+  napi_value ids_buffer, scores_buffer;
+  void *ids_data = nullptr;
+  void *scores_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(float), &scores_data,
+                          &scores_buffer);
+
+  int count = fastembed_topk_rescore(
+      query, corpus, (int)(len_corpus / dimension), (int)dimension, candidates,
+      (int)num_candidates, k, (int *)ids_data, (float *)scores_data, metric);
+
+  free(query);
+  free(corpus);
+  free(candidates);
+
+  if (count < 0) {
+    napi_throw_error(env, nullptr,
+                     "Failed to rescore (candidate ids must be corpus rows)");
+    return nullptr;
+  }
+
+  return MakeTopKResult(env, ids_buffer, scores_buffer, count, "scores",
+                        napi_float32_array);
+}
+
+/**
+ * Convert floats to half precision (round to nearest even)
+ *
+ * @param vectors - Floats (any length)
+ * @param format - 'fp16' (default) or 'bf16'
+ * @returns Uint16Array of the same length
+ */
+static napi_value ToHalf(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: vectors");
+    return nullptr;
+  }
+
+  int format;
+  if (!GetHalfFormat(env, argc, args, 1, &format)) {
+    return nullptr;
+  }
+
+  size_t length;
+  float *vectors = GetFloatArrayFromValue(env, args[0], &length);
+  if (!vectors || length == 0 || length > INT32_MAX) {
+    if (vectors)
+      free(vectors);
+    napi_throw_error(env, nullptr, "vectors must be a non-empty array");
+    return nullptr;
+  }
+
+  napi_value halves_buffer;
+  void *halves_data = nullptr;
+  napi_create_arraybuffer(env, length * sizeof(uint16_t), &halves_data,
+                          &halves_buffer);
+
+  int result =
+      format == FASTEMBED_QUANT_BF16
+          ? fastembed_f32_to_bf16(vectors, (uint16_t *)halves_data,
+                                  (int)length)
+          : fastembed_f32_to_f16(vectors, (uint16_t *)halves_data,
+                                 (int)length);
+  free(vectors);
+
+  if (result != 0) {
+    napi_throw_error(env, nullptr, "Failed to convert to half precision");
+    return nullptr;
+  }
+
+  napi_value halves;
+  napi_create_typedarray(env, napi_uint16_array, length, halves_buffer, 0,
+                         &halves);
+  return halves;
+}
+
+/**
+ * Widen half-precision values to floats
+ *
+ * @param halves - Uint16Array from toHalf()
+ * @param format - 'fp16' (default) or 'bf16'
+ * @returns Float32Array of the same length
+ */
+static napi_value FromHalf(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: halves");
+    return nullptr;
+  }
+
+  int format;
+  if (!GetHalfFormat(env, argc, args, 1, &format)) {
+    return nullptr;
+  }
+
+  size_t length = 0;
+  uint16_t *halves =
+      (uint16_t *)GetTypedArrayData(env, args[0], napi_uint16_array, &length);
+  if (!halves || length == 0 || length > INT32_MAX) {
+    napi_throw_error(env, nullptr, "halves must be a non-empty Uint16Array");
+    return nullptr;
+  }
+
+  napi_value floats_buffer;
+  void *floats_data = nullptr;
+  napi_create_arraybuffer(env, length * sizeof(float), &floats_data,
+                          &floats_buffer);
+
+  int result = format == FASTEMBED_QUANT_BF16
+                   ? fastembed_bf16_to_f32(halves, (float *)floats_data,
+                                           (int)length)
+                   : fastembed_f16_to_f32(halves, (float *)floats_data,
+                                          (int)length);
+  if (result != 0) {
+    napi_throw_error(env, nullptr, "Failed to convert from half precision");
+    return nullptr;
+  }
+
+  napi_value floats;
+  napi_create_typedarray(env, napi_float32_array, length, floats_buffer, 0,
+                         &floats);
+  return floats;
+}
+
+/**
+ * Find the k half-precision corpus rows most similar to a float query
+ *
+ * @param query - Query vector
+ * @param corpus - Row-major corpus (Uint16Array from toHalf())
+ * @param format - 'fp16' or 'bf16'
+ * @param k - Number of results
+ * @param metric - 'cosine' (default), 'dot' or 'euclidean' (nearest first)
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns { ids: Int32Array, scores: Float32Array }, best first
+ */
+static napi_value TopKHalf(napi_env env, napi_callback_info info) {
+  size_t argc = 6;
+  napi_value args[6];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 4) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 4 arguments: query, corpus, format, "
+                     "k");
+    return nullptr;
+  }
+
+  int format;
+  if (!GetHalfFormat(env, argc, args, 2, &format)) {
+    return nullptr;
+  }
+
+  int32_t k = 0;
+  if (napi_get_value_int32(env, args[3], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+
+  int metric;
+  int32_t threads;
+  if (!GetSimilarityOptions(env, argc, args, 4, &metric, &threads)) {
+    return nullptr;
+  }
+
+  size_t dimension = 0, len_corpus = 0;
+  uint16_t *corpus = (uint16_t *)GetTypedArrayData(
+      env, args[1], napi_uint16_array, &len_corpus);
+  float *query = GetFloatArrayFromValue(env, args[0], &dimension);
+  if (!query || !corpus || dimension == 0 || len_corpus == 0 ||
+      len_corpus % dimension != 0) {
+    if (query)
+      free(query);
+    napi_throw_error(env, nullptr,
+                     "corpus must be a Uint16Array with a non-empty multiple "
+                     "of the query length");
+    return nullptr;
+  }
+
+  size_t num_corpus = len_corpus / dimension;
+  if ((size_t)k > num_corpus) {
+    k = (int32_t)num_corpus;
+  }
+
+  napi_value ids_buffer, scores_buffer;
+  void *ids_data = nullptr;
+  void *scores_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(float), &scores_data,
+                          &scores_buffer);
+
+  int count = fastembed_topk_half(query, corpus, format, (int)num_corpus,
+                                  (int)dimension, k, (int *)ids_data,
+                                  (float *)scores_data, metric, threads);
+  free(query);
+
+  if (count < 0) {
+    napi_throw_error(env, nullptr, "Failed to compute half-precision top-k");
+    return nullptr;
+  }
+
+  return MakeTopKResult(env, ids_buffer, scores_buffer, count, "scores",
+                        napi_float32_array);
+}
+
+// Async (Promise) functions: arguments are read and outputs allocated on the
+// JS thread, the C call runs on the libuv threadpool and the promise settles
+// back on the JS thread. Typed array inputs and caller-supplied targets are
+// used in place (no copies, SharedArrayBuffer views included) and kept alive
+// until the promise settles; they must not be modified or transferred
+// meanwhile
+#define ASYNC_JOB_MAX_KEEP 4
+#define ASYNC_JOB_MAX_OWNED 4
+
+struct AsyncJob;
+typedef void (*AsyncExecuteFn)(AsyncJob *job);
+typedef napi_value (*AsyncResolveFn)(napi_env env, AsyncJob *job);
+
+struct AsyncJob {
+  napi_async_work work;
+  napi_deferred deferred;
+  AsyncExecuteFn execute; // Runs on the threadpool (no napi calls)
+  AsyncResolveFn resolve; // Builds the resolved value on the JS thread
+  napi_ref output_ref;    // Float32Array resolved by the generate functions
+  napi_ref statuses_ref;  // Int32Array of per-text statuses
+  napi_ref ids_ref;       // Top-k result ArrayBuffers
+  napi_ref scores_ref;
+  napi_ref keep[ASYNC_JOB_MAX_KEEP]; // Borrowed inputs / model handle
+  int num_keep;
+  void *owned[ASYNC_JOB_MAX_OWNED]; // malloc'd buffers freed with the job
+  int num_owned;
+  OnnxModelRef *model_ref; // Handle whose pending count this job holds
+  fastembed_model_t *model;
+  const char *model_path; // Opened on the threadpool when model is null
+  const char *text;
+  const char *text_data;
+  const int32_t *offsets;
+  int num_texts;
+  const float *query;
+  const float *corpus;
+  int num_corpus;
+  int k;
+  int metric;
+  int threads;
+  float *output;
+  size_t output_length; // Elements available in output
+  int *statuses;
+  int *ids;
+  float *scores;
+  int dimension;
+  int result;
+  char error[1024]; // Set by execute to reject the promise
+};
+
+static AsyncJob *CreateAsyncJob(AsyncExecuteFn execute,
+                                AsyncResolveFn resolve) {
+  AsyncJob *job = (AsyncJob *)calloc(1, sizeof(AsyncJob));
+  if (job) {
+    job->execute = execute;
+    job->resolve = resolve;
+  }
+  return job;
+}
+
+// Helper: Free buffer with the job (returns buffer)
+static void *AsyncJobOwn(AsyncJob *job, void *buffer) {
+  if (buffer) {
+    job->owned[job->num_owned++] = buffer;
+  }
+  return buffer;
+}
+
+// Helper: Keep value alive until the job completes
+static void AsyncJobKeep(napi_env env, AsyncJob *job, napi_value value) {
+  napi_create_reference(env, value, 1, &job->keep[job->num_keep++]);
+}
+
+static napi_value GetRefValue(napi_env env, napi_ref ref) {
+  napi_value value = nullptr;
+  napi_get_reference_value(env, ref, &value);
+  return value;
+}
+
+// Helper: Run the job on an open model handle (defers closeOnnxModel())
+static void AsyncJobUseModel(napi_env env, AsyncJob *job, napi_value handle,
+                             OnnxModelRef *ref) {
+  AsyncJobKeep(env, job, handle);
+  ref->pending++;
+  job->model_ref = ref;
+  job->model = ref->model;
+}
+
+static void FreeAsyncJob(napi_env env, AsyncJob *job) {
+  OnnxModelRef *ref = job->model_ref;
+  if (ref && --ref->pending == 0 && ref->closing) {
+    fastembed_model_close(ref->model);
+    ref->model = nullptr;
+    ref->closing = false;
+  }
+
+  napi_ref refs[] = {job->output_ref, job->statuses_ref, job->ids_ref,
+                     job->scores_ref};
+  for (size_t i = 0; i < sizeof(refs) / sizeof(refs[0]); i++) {
+    if (refs[i]) {
+      napi_delete_reference(env, refs[i]);
+    }
+  }
+  for (int i = 0; i < job->num_keep; i++) {
+    napi_delete_reference(env, job->keep[i]);
+  }
+  for (int i = 0; i < job->num_owned; i++) {
+    free(job->owned[i]);
+  }
+  if (job->work) {
+    napi_delete_async_work(env, job->work);
+  }
+  free(job);
+}
+
+// Helper: Record the last ONNX error as the job's rejection message
+static void SetAsyncOnnxError(AsyncJob *job, const char *what) {
+  char error_buffer[512];
+  const char *error_message = "unknown error";
+  if (fastembed_onnx_get_last_error(error_buffer, sizeof(error_buffer)) == 0) {
+    error_message = error_buffer;
+  }
+  snprintf(job->error, sizeof(job->error), "%s: %s", what, error_message);
+}
+
+static void ExecuteAsyncJob(napi_env env, void *data) {
+  AsyncJob *job = (AsyncJob *)data;
+  job->execute(job);
+}
+
+static void CompleteAsyncJob(napi_env env, napi_status status, void *data) {
+  AsyncJob *job = (AsyncJob *)data;
+
+  napi_value value = nullptr;
+  if (status == napi_cancelled) {
+    snprintf(job->error, sizeof(job->error), "Async call cancelled");
+  } else if (job->error[0] == '\0') {
+    value = job->resolve(env, job);
+  }
+
+  if (value) {
+    napi_resolve_deferred(env, job->deferred, value);
+  } else {
+    napi_value message, error;
+    napi_create_string_utf8(env,
+                            job->error[0] ? job->error : "Async call failed",
+                            NAPI_AUTO_LENGTH, &message);
+    napi_create_error(env, nullptr, message, &error);
+    napi_reject_deferred(env, job->deferred, error);
+  }
+  FreeAsyncJob(env, job);
+}
+
+// Helper: Queue job on the libuv threadpool and return its promise (frees
+// the job and throws on failure)
+static napi_value QueueAsyncJob(napi_env env, AsyncJob *job,
+                                const char *name) {
+  napi_value promise, resource_name;
+  napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &resource_name);
+  if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+      napi_create_async_work(env, nullptr, resource_name, ExecuteAsyncJob,
+                             CompleteAsyncJob, job, &job->work) != napi_ok ||
+      napi_queue_async_work(env, job->work) != napi_ok) {
+    FreeAsyncJob(env, job);
+    napi_throw_error(env, nullptr, "Failed to queue async work");
+    return nullptr;
+  }
+  return promise;
+}
+
+// Helper: Borrow an optional caller-supplied Float32Array target of at least
+// min_length elements. Returns 1 if a target was given, 0 if not and -1 with
+// a pending exception if it is invalid
+static int GetAsyncTarget(napi_env env, size_t argc, napi_value *args,
+                          size_t index, size_t min_length, AsyncJob *job) {
+  napi_valuetype valuetype = napi_undefined;
+  if (argc > index) {
+    napi_typeof(env, args[index], &valuetype);
+  }
+  if (valuetype == napi_undefined || valuetype == napi_null) {
+    return 0;
+  }
+
+  size_t length = 0;
+  void *data =
+      GetTypedArrayData(env, args[index], napi_float32_array, &length);
+  if (!data || length < min_length) {
+    char message[128];
+    snprintf(message, sizeof(message),
+             "target must be a Float32Array of at least %zu elements",
+             min_length ? min_length : (size_t)1);
+    napi_throw_type_error(env, nullptr, message);
+    return -1;
+  }
+
+  job->output = (float *)data;
+  job->output_length = length;
+  napi_create_reference(env, args[index], 1, &job->output_ref);
+  return 1;
+}
+
+// Helper: Allocate a new Float32Array output (returns false and throws if out
+// of memory)
+static bool AllocAsyncOutput(napi_env env, size_t length, AsyncJob *job) {
+  napi_value arraybuffer, typedarray;
+  void *data = nullptr;
+  if (napi_create_arraybuffer(env, length * sizeof(float), &data,
+                              &arraybuffer) != napi_ok) {
+    napi_throw_error(env, nullptr, "Failed to allocate output");
+    return false;
+  }
+  napi_create_typedarray(env, napi_float32_array, length, arraybuffer, 0,
+                         &typedarray);
+  job->output = (float *)data;
+  job->output_length = length;
+  napi_create_reference(env, typedarray, 1, &job->output_ref);
+  return true;
+}
+
+// Helper: Borrow a Float32Array (kept alive by the job) or copy an array of
+// numbers (freed with the job)
+static const float *GetAsyncFloats(napi_env env, napi_value value,
+                                   AsyncJob *job, size_t *out_length) {
+  void *data = GetTypedArrayData(env, value, napi_float32_array, out_length);
+  if (data) {
+    AsyncJobKeep(env, job, value);
+    return (const float *)data;
+  }
+  return (const float *)AsyncJobOwn(
+      job, GetFloatArrayFromValue(env, value, out_length));
+}
+
+// Helper: Read batch texts: an array of strings is packed into one UTF-8
+// buffer plus offsets; a { data: Uint8Array, offsets: Int32Array } object
+// (Arrow string layout) is used in place. Returns false with a pending
+// exception on invalid input
+static bool GetAsyncTexts(napi_env env, napi_value value, AsyncJob *job) {
+  bool is_array = false;
+  napi_is_array(env, value, &is_array);
+
+  if (is_array) {
+    uint32_t count = 0;
+    napi_get_array_length(env, value, &count);
+    if (count > INT32_MAX - 1) {
+      napi_throw_error(env, nullptr, "Too many texts");
+      return false;
+    }
+    int32_t *offsets = (int32_t *)AsyncJobOwn(
+        job, malloc(((size_t)count + 1) * sizeof(int32_t)));
+    if (!offsets) {
+      napi_throw_error(env, nullptr, "Failed to allocate text offsets");
+      return false;
+    }
+
+    // First pass: UTF-8 sizes
+    offsets[0] = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      napi_value element;
+      napi_valuetype valuetype;
+      napi_get_element(env, value, i, &element);
+      napi_typeof(env, element, &valuetype);
+      if (valuetype != napi_string) {
+        napi_throw_type_error(env, nullptr, "texts must be strings");
+        return false;
+      }
+      size_t size = 0;
+      napi_get_value_string_utf8(env, element, nullptr, 0, &size);
+      if (size > (size_t)(INT32_MAX - offsets[i])) {
+        napi_throw_error(env, nullptr, "texts exceed 2 GiB");
+        return false;
+      }
+      offsets[i + 1] = offsets[i] + (int32_t)size;
+    }
+
+    // Second pass: copy back to back (each copy's terminator is overwritten
+    // by the next text)
+    char *data =
+        (char *)AsyncJobOwn(job, malloc((size_t)offsets[count] + 1));
+    if (!data) {
+      napi_throw_error(env, nullptr, "Failed to allocate texts");
+      return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      napi_value element;
+      size_t size = (size_t)(offsets[i + 1] - offsets[i]);
+      size_t copied = 0;
+      napi_get_element(env, value, i, &element);
+      napi_get_value_string_utf8(env, element, data + offsets[i], size + 1,
+                                 &copied);
+      if (copied != size) {
+        napi_throw_error(env, nullptr, "texts changed while reading");
+        return false;
+      }
+    }
+
+    job->text_data = data;
+    job->offsets = offsets;
+    job->num_texts = (int)count;
+    return true;
+  }
+
+  napi_valuetype valuetype;
+  napi_typeof(env, value, &valuetype);
+  napi_value data_value = nullptr, offsets_value = nullptr;
+  if (valuetype == napi_object) {
+    napi_get_named_property(env, value, "data", &data_value);
+    napi_get_named_property(env, value, "offsets", &offsets_value);
+  }
+  size_t data_length = 0, offsets_length = 0;
+  void *data = data_value ? GetTypedArrayData(env, data_value,
+                                              napi_uint8_array, &data_length)
+                          : nullptr;
+  const int32_t *offsets =
+      offsets_value ? (const int32_t *)GetTypedArrayData(
+                          env, offsets_value, napi_int32_array,
+                          &offsets_length)
+                    : nullptr;
+  if (!offsets || offsets_length == 0 || offsets_length > INT32_MAX ||
+      (!data && data_length > 0)) {
+    napi_throw_type_error(env, nullptr,
+                          "texts must be an array of strings or { data: "
+                          "Uint8Array, offsets: Int32Array }");
+    return false;
+  }
+  // Spans are checked per text natively; bound them by the buffer here
+  for (size_t i = 0; i < offsets_length; i++) {
+    if (offsets[i] < 0 || (size_t)offsets[i] > data_length) {
+      napi_throw_range_error(env, nullptr,
+                             "offsets must lie within texts.data");
+      return false;
+    }
+  }
+
+  AsyncJobKeep(env, job, data_value);
+  AsyncJobKeep(env, job, offsets_value);
+  job->text_data = data ? (const char *)data : "";
+  job->offsets = offsets;
+  job->num_texts = (int)offsets_length - 1;
+  return true;
+}
+
+static void ExecuteGenerateOnnx(AsyncJob *job) {
+  fastembed_model_t *model = job->model;
+  fastembed_model_t *opened = nullptr;
+  if (!model) {
+    // Through the session cache: only the first call loads the model
+    opened = model = fastembed_model_open(job->model_path);
+    if (!model) {
+      SetAsyncOnnxError(job, "Failed to open ONNX model");
+      return;
+    }
+  }
+
+  int dimension = fastembed_model_get_dimension(model);
+  if (!job->output && dimension > 0) {
+    job->output = (float *)AsyncJobOwn(
+        job, malloc((size_t)dimension * sizeof(float)));
+    job->output_length = job->output ? (size_t)dimension : 0;
+  }
+
+  if (dimension <= 0 || (size_t)dimension > job->output_length) {
+    snprintf(job->error, sizeof(job->error),
+             "Invalid dimension: model produces %d floats, target holds %zu",
+             dimension, job->output_length);
+  } else if (fastembed_model_generate(model, job->text, job->output,
+                                      dimension) != 0) {
+    SetAsyncOnnxError(job, "Failed to generate ONNX embedding");
+  }
+  job->dimension = dimension;
+
+  if (opened) {
+    fastembed_model_close(opened);
+  }
+}
+
+static napi_value ResolveGenerateOnnx(napi_env env, AsyncJob *job) {
+  if (job->output_ref) {
+    return GetRefValue(env, job->output_ref);
+  }
+
+  // Opened by path without a target: the dimension was unknown up front
+  napi_value arraybuffer, typedarray;
+  void *data;
+  napi_create_arraybuffer(env, (size_t)job->dimension * sizeof(float), &data,
+                          &arraybuffer);
+  memcpy(data, job->output, (size_t)job->dimension * sizeof(float));
+  napi_create_typedarray(env, napi_float32_array, job->dimension, arraybuffer,
+                         0, &typedarray);
+  return typedarray;
+}
+
+/**
+ * Generate an ONNX embedding on the libuv threadpool
+ *
+ * @param model - Handle returned by openOnnxModel, or model path (opened
+ * through the session cache)
+ * @param text - Input text string
+ * @param target - Optional Float32Array (e.g. a SharedArrayBuffer view) of at
+ * least the model dimension; written in place and resolved
+ * @returns Promise<Float32Array> with the embedding vector
+ */
+static napi_value GenerateOnnxAsync(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected at least 2 arguments: model, text");
+    return nullptr;
+  }
+
+  napi_valuetype model_type, text_type;
+  napi_typeof(env, args[0], &model_type);
+  napi_typeof(env, args[1], &text_type);
+  if (text_type != napi_string) {
+    napi_throw_type_error(env, nullptr, "Text argument must be a string");
+    return nullptr;
+  }
+
+  OnnxModelRef *ref = nullptr;
+  if (model_type != napi_string) {
+    ref = GetModelRefFromValue(env, args[0]);
+    if (!ref) {
+      return nullptr;
+    }
+  }
+
+  AsyncJob *job = CreateAsyncJob(ExecuteGenerateOnnx, ResolveGenerateOnnx);
+  if (!job) {
+    napi_throw_error(env, nullptr, "Failed to allocate async work");
+    return nullptr;
+  }
+
+  size_t min_length =
+      ref ? (size_t)fastembed_model_get_dimension(ref->model) : 0;
+  int has_target = GetAsyncTarget(env, argc, args, 2, min_length, job);
+  if (has_target < 0 ||
+      (has_target == 0 && ref && !AllocAsyncOutput(env, min_length, job))) {
+    FreeAsyncJob(env, job);
+    return nullptr;
+  }
+
+  if (ref) {
+    AsyncJobUseModel(env, job, args[0], ref);
+  } else {
+    job->model_path =
+        (const char *)AsyncJobOwn(job, GetStringFromValue(env, args[0]));
+  }
+  job->text = (const char *)AsyncJobOwn(job, GetStringFromValue(env, args[1]));
+
+  return QueueAsyncJob(env, job, "fastembed.generateOnnxAsync");
+}
+
+static void ExecuteWarmupOnnx(AsyncJob *job) {
+  int status = job->model ? fastembed_model_warmup(job->model)
+                          : fastembed_onnx_preload(job->model_path, nullptr);
+  if (status != 0) {
+    SetAsyncOnnxError(job, job->model ? "ONNX warmup failed"
+                                      : "Failed to preload ONNX model");
+  }
+}
+
+static napi_value ResolveWarmupOnnx(napi_env env, AsyncJob *job) {
+  napi_value undefined;
+  napi_get_undefined(env, &undefined);
+  return undefined;
+}
+
+/**
+ * Load and warm up an ONNX model on the libuv threadpool
+ *
+ * @param model - Handle returned by openOnnxModel (warmup inferences only),
+ * or model path (loaded into the session cache with default options, then
+ * warmed up, so path-based calls skip the cold start)
+ * @returns Promise<undefined>
+ */
+static napi_value WarmupOnnxAsync(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: model");
+    return nullptr;
+  }
+
+  napi_valuetype model_type;
+  napi_typeof(env, args[0], &model_type);
+  OnnxModelRef *ref = nullptr;
+  if (model_type != napi_string) {
+    ref = GetModelRefFromValue(env, args[0]);
+    if (!ref) {
+      return nullptr;
+    }
+  }
+
+  AsyncJob *job = CreateAsyncJob(ExecuteWarmupOnnx, ResolveWarmupOnnx);
+  if (!job) {
+    napi_throw_error(env, nullptr, "Failed to allocate async work");
+    return nullptr;
+  }
+
+  if (ref) {
+    AsyncJobUseModel(env, job, args[0], ref);
+  } else {
+    job->model_path =
+        (const char *)AsyncJobOwn(job, GetStringFromValue(env, args[0]));
+  }
+
+  return QueueAsyncJob(env, job, "fastembed.warmupOnnxAsync");
+}
+
+static void ExecuteBatchGenerate(AsyncJob *job) {
+  if (job->num_texts == 0) {
+    return;
+  }
+
+  if (job->model) {
+    job->result = fastembed_model_batch_generate_contiguous(
+        job->model, job->text_data, job->offsets, job->num_texts, job->output,
+        job->dimension, job->statuses, job->threads);
+    if (job->result < 0) {
+      SetAsyncOnnxError(job, "Failed to generate ONNX embeddings");
+    }
+  } else {
+    job->result = fastembed_batch_generate_contiguous(
+        job->text_data, job->offsets, job->num_texts, job->output,
+        job->dimension, job->statuses, job->threads);
+    if (job->result < 0) {
+      snprintf(job->error, sizeof(job->error),
+               "Failed to generate embeddings (invalid dimension or "
+               "threads)");
+    }
+  }
+}
+
+static napi_value ResolveBatchGenerate(napi_env env, AsyncJob *job) {
+  napi_value result, failed;
+  napi_create_object(env, &result);
+  napi_create_int32(env, job->result, &failed);
+  napi_set_named_property(env, result, "embeddings",
+                          GetRefValue(env, job->output_ref));
+  napi_set_named_property(env, result, "statuses",
+                          GetRefValue(env, job->statuses_ref));
+  napi_set_named_property(env, result, "failed", failed);
+  return result;
+}
+
+/**
+ * Generate embeddings for many texts into one matrix on the threadpool
+ *
+ * @param texts - Array of strings, or { data: Uint8Array, offsets: Int32Array }
+ * (UTF-8 bytes plus numTexts + 1 offsets, used in place)
+ * @param dimensionOrModel - Hash embedding dimension, or handle returned by
+ * openOnnxModel (model dimension)
+ * @param target - Optional Float32Array of at least numTexts * dimension
+ * elements (e.g. a SharedArrayBuffer view), written in place
+ * @param threads - Pool threads (default 1, 0 = whole pool)
+ * @returns Promise<{ embeddings: Float32Array, statuses: Int32Array,
+ * failed: number }>; rows of failed texts are zero
+ */
+static napi_value BatchGenerateAsync(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value args[4];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 2 arguments: texts, dimension or "
+                     "model");
+    return nullptr;
+  }
+
+  int32_t threads;
+  if (!GetOptionalThreads(env, argc, args, 3, &threads)) {
+    return nullptr;
+  }
+
+  OnnxModelRef *ref = nullptr;
+  int32_t dimension = 0;
+  napi_valuetype valuetype;
+  napi_typeof(env, args[1], &valuetype);
+  if (valuetype == napi_number) {
+    napi_get_value_int32(env, args[1], &dimension);
+  } else {
+    ref = GetModelRefFromValue(env, args[1]);
+    if (!ref) {
+      return nullptr;
+    }
+    dimension = fastembed_model_get_dimension(ref->model);
+  }
+  if (dimension <= 0) {
+    napi_throw_error(env, nullptr, "dimension must be a positive integer");
+    return nullptr;
+  }
+
+  AsyncJob *job = CreateAsyncJob(ExecuteBatchGenerate, ResolveBatchGenerate);
+  if (!job) {
+    napi_throw_error(env, nullptr, "Failed to allocate async work");
+    return nullptr;
+  }
+  job->dimension = dimension;
+  job->threads = threads;
+  if (ref) {
+    AsyncJobUseModel(env, job, args[1], ref);
+  }
+
+  if (!GetAsyncTexts(env, args[0], job)) {
+    FreeAsyncJob(env, job);
+    return nullptr;
+  }
+
+  size_t length = (size_t)job->num_texts * (size_t)dimension;
+  int has_target = GetAsyncTarget(env, argc, args, 2, length, job);
+  if (has_target < 0 ||
+      (has_target == 0 && !AllocAsyncOutput(env, length, job))) {
+    FreeAsyncJob(env, job);
+    return nullptr;
+  }
+
+  napi_value statuses_buffer, statuses;
+  void *statuses_data = nullptr;
+  if (napi_create_arraybuffer(env, (size_t)job->num_texts * sizeof(int32_t),
+                              &statuses_data, &statuses_buffer) != napi_ok) {
+    FreeAsyncJob(env, job);
+    napi_throw_error(env, nullptr, "Failed to allocate statuses");
+    return nullptr;
+  }
+  napi_create_typedarray(env, napi_int32_array, job->num_texts,
+                         statuses_buffer, 0, &statuses);
+  napi_create_reference(env, statuses, 1, &job->statuses_ref);
+  job->statuses = (int *)statuses_data;
+
+  return QueueAsyncJob(env, job, "fastembed.batchGenerateAsync");
+}
+
+static void ExecuteTopK(AsyncJob *job) {
+  job->result = fastembed_topk_threaded(
+      job->query, job->corpus, job->num_corpus, job->dimension, job->k,
+      job->ids, job->scores, job->metric, job->threads);
+  if (job->result < 0) {
+    snprintf(job->error, sizeof(job->error), "Failed to compute top-k");
+  }
+}
+
+static napi_value ResolveTopK(napi_env env, AsyncJob *job) {
+  return MakeTopKResult(env, GetRefValue(env, job->ids_ref),
+                        GetRefValue(env, job->scores_ref), job->result,
+                        "scores", napi_float32_array);
+}
+
+/**
+ * Find the k corpus rows most similar to a query on the threadpool
+ *
+ * Float32Array query / corpus (including SharedArrayBuffer views) are read in
+ * place; arrays of numbers are copied first.
+ *
+ * @param query - Query vector
+ * @param corpus - Row-major [numCorpus x query.length] matrix
+ * @param k - Number of results
+ * @param metric - 'cosine' (default), 'dot' or 'euclidean' (nearest first)
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns Promise<{ ids: Int32Array, scores: Float32Array }>, best first
+ */
+static napi_value TopKAsync(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr,
+                     "Expected at least 3 arguments: query, corpus, k");
+    return nullptr;
+  }
+
+  int32_t k = 0;
+  if (napi_get_value_int32(env, args[2], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+
+  int metric;
+  int32_t threads;
+  if (!GetSimilarityOptions(env, argc, args, 3, &metric, &threads)) {
+    return nullptr;
+  }
+
+  AsyncJob *job = CreateAsyncJob(ExecuteTopK, ResolveTopK);
+  if (!job) {
+    napi_throw_error(env, nullptr, "Failed to allocate async work");
+    return nullptr;
+  }
+
+  size_t dimension = 0, len_corpus = 0;
+  job->query = GetAsyncFloats(env, args[0], job, &dimension);
+  job->corpus = GetAsyncFloats(env, args[1], job, &len_corpus);
+  if (!job->query || !job->corpus || dimension == 0 || len_corpus == 0 ||
+      len_corpus % dimension != 0 || len_corpus / dimension > INT32_MAX) {
+    FreeAsyncJob(env, job);
+    napi_throw_error(env, nullptr,
+                     "corpus must be a non-empty multiple of the query "
+                     "length");
+    return nullptr;
+  }
+
+  size_t num_corpus = len_corpus / dimension;
+  if ((size_t)k > num_corpus) {
+    k = (int32_t)num_corpus;
+  }
+  job->num_corpus = (int)num_corpus;
+  job->dimension = (int)dimension;
+  job->k = k;
+  job->metric = metric;
+  job->threads = threads;
+
+  napi_value ids_buffer, scores_buffer;
+  void *ids_data = nullptr;
+  void *scores_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(float), &scores_data,
+                          &scores_buffer);
+  napi_create_reference(env, ids_buffer, 1, &job->ids_ref);
+  napi_create_reference(env, scores_buffer, 1, &job->scores_ref);
+  job->ids = (int *)ids_data;
+  job->scores = (float *)scores_data;
+
+  return QueueAsyncJob(env, job, "fastembed.topKAsync");
+}
+
+// HNSW index handle wrapper: like OnnxModelRef, the finalizer frees indexes
+// that were never freed explicitly
+struct HnswIndexRef {
+  fastembed_hnsw_t *index;
+};
+
+static void FinalizeHnswIndex(napi_env env, void *data, void *hint) {
+  HnswIndexRef *ref = (HnswIndexRef *)data;
+  if (ref->index) {
+    fastembed_hnsw_free(ref->index);
+  }
+  free(ref);
+}
+
+static napi_value WrapHnswIndex(napi_env env, fastembed_hnsw_t *index) {
+  HnswIndexRef *ref = (HnswIndexRef *)malloc(sizeof(HnswIndexRef));
+  ref->index = index;
+
+  napi_value handle;
+  napi_create_external(env, ref, FinalizeHnswIndex, nullptr, &handle);
+  return handle;
+}
+
+// Helper: Get live index from handle argument (throws if invalid or freed)
+static fastembed_hnsw_t *GetHnswFromValue(napi_env env, napi_value value) {
+  napi_valuetype valuetype;
+  napi_typeof(env, value, &valuetype);
+  if (valuetype != napi_external) {
+    napi_throw_type_error(env, nullptr, "Expected an HNSW index handle");
+    return nullptr;
+  }
+
+  void *data;
+  napi_get_value_external(env, value, &data);
+  HnswIndexRef *ref = (HnswIndexRef *)data;
+  if (!ref->index) {
+    napi_throw_error(env, nullptr, "HNSW index handle is freed");
+    return nullptr;
+  }
+  return ref->index;
+}
+
+/**
+ * Create an empty HNSW index
+ *
+ * @param dimension - Vector dimension
+ * @param options - Optional { m, efConstruction, efSearch, metric, seed }
+ * @returns Opaque index handle (free with freeHnswIndex)
+ */
+static napi_value CreateHnswIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  int32_t dimension = 0;
+  if (argc < 1 || napi_get_value_int32(env, args[0], &dimension) != napi_ok ||
+      dimension <= 0) {
+    napi_throw_error(env, nullptr, "dimension must be a positive integer");
+    return nullptr;
+  }
+
+  fastembed_hnsw_options_t options;
+  fastembed_hnsw_options_init(&options);
+
+  napi_valuetype valuetype = napi_undefined;
+  if (argc >= 2) {
+    napi_typeof(env, args[1], &valuetype);
+  }
+  if (valuetype == napi_object) {
+    int seed = (int)options.seed;
+    if (!GetOptionalInt(env, args[1], "m", &options.m) ||
+        !GetOptionalInt(env, args[1], "efConstruction",
+                        &options.ef_construction) ||
+        !GetOptionalInt(env, args[1], "efSearch", &options.ef_search) ||
+        !GetOptionalInt(env, args[1], "seed", &seed)) {
+      return nullptr;
+    }
+    options.seed = (unsigned int)seed;
+
+    napi_value metric_value;
+    napi_get_named_property(env, args[1], "metric", &metric_value);
+    int32_t unused_threads;
+    if (!GetSimilarityOptions(env, 1, &metric_value, 0, &options.metric,
+                              &unused_threads)) {
+      return nullptr;
+    }
+  } else if (valuetype != napi_undefined) {
+    napi_throw_type_error(env, nullptr, "options must be an object");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = fastembed_hnsw_create(dimension, &options);
+  if (!index) {
+    napi_throw_error(env, nullptr, "Failed to create HNSW index (invalid "
+                                   "options or out of memory)");
+    return nullptr;
+  }
+  return WrapHnswIndex(env, index);
+}
+
+/**
+ * Load an index written by hnswSave
+ *
+ * @param path - Index file
+ * @param mmap - Map the file read-only instead of reading it (default false)
+ * @returns Opaque index handle (free with freeHnswIndex)
+ */
+static napi_value LoadHnswIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  napi_valuetype valuetype = napi_undefined;
+  if (argc >= 1) {
+    napi_typeof(env, args[0], &valuetype);
+  }
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "path must be a string");
+    return nullptr;
+  }
+
+  bool use_mmap = false;
+  if (argc >= 2) {
+    napi_typeof(env, args[1], &valuetype);
+    if (valuetype == napi_boolean) {
+      napi_get_value_bool(env, args[1], &use_mmap);
+    } else if (valuetype != napi_undefined) {
+      napi_throw_type_error(env, nullptr, "mmap must be a boolean");
+      return nullptr;
+    }
+  }
+
+  char *path = GetStringFromValue(env, args[0]);
+  fastembed_hnsw_t *index =
+      use_mmap ? fastembed_hnsw_load_mmap(path) : fastembed_hnsw_load(path);
+  if (!index) {
+    char detailed_error[1024];
+    snprintf(detailed_error, sizeof(detailed_error),
+             "Failed to load HNSW index (path: %s)", path);
+    free(path);
+    napi_throw_error(env, nullptr, detailed_error);
+    return nullptr;
+  }
+  free(path);
+  return WrapHnswIndex(env, index);
+}
+
+/**
+ * Free an HNSW index handle (safe to call more than once)
+ *
+ * @param index - Handle returned by createHnswIndex / loadHnswIndex
+ * @returns Number (0)
+ */
+static napi_value FreeHnswIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  napi_valuetype valuetype = napi_undefined;
+  if (argc >= 1) {
+    napi_typeof(env, args[0], &valuetype);
+  }
+  if (valuetype != napi_external) {
+    napi_throw_type_error(env, nullptr, "Expected an HNSW index handle");
+    return nullptr;
+  }
+
+  void *data;
+  napi_get_value_external(env, args[0], &data);
+  HnswIndexRef *ref = (HnswIndexRef *)data;
+  if (ref->index) {
+    fastembed_hnsw_free(ref->index);
+    ref->index = nullptr;
+  }
+
+  napi_value return_value;
+  napi_create_int32(env, 0, &return_value);
+  return return_value;
+}
+
+/**
+ * Add vectors to an index
+ *
+ * @param index - Index handle
+ * @param vectors - One vector, or row-major [n x dimension] matrix
+ * @param threads - Worker threads (default 1, 0 = all CPUs)
+ * @returns Int32Array of assigned ids, in row order
+ */
+static napi_value HnswAdd(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected at least 2 arguments: index, "
+                                   "vectors");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  int32_t threads = 1;
+  napi_valuetype valuetype = napi_undefined;
+  if (argc >= 3) {
+    napi_typeof(env, args[2], &valuetype);
+  }
+  if (valuetype == napi_number) {
+    napi_get_value_int32(env, args[2], &threads);
+  } else if (valuetype != napi_undefined) {
+    napi_throw_type_error(env, nullptr, "threads must be a number");
+    return nullptr;
+  }
+
+  size_t dimension = (size_t)fastembed_hnsw_dimension(index);
+  size_t length;
+  float *vectors = GetFloatArrayFromValue(env, args[1], &length);
+  if (!vectors || length == 0 || length % dimension != 0) {
+    if (vectors)
+      free(vectors);
+    napi_throw_error(env, nullptr,
+                     "vectors must be a non-empty multiple of the index "
+                     "dimension");
+    return nullptr;
+  }
+
+  size_t count = length / dimension;
+  napi_value ids_buffer;
+  void *ids_data = nullptr;
+  napi_create_arraybuffer(env, count * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+
+  int result = fastembed_hnsw_add_batch(index, vectors, (int)count,
+                                        (int *)ids_data, threads);
+  free(vectors);
+
+  if (result != 0) {
+    napi_throw_error(env, nullptr, "Failed to add vectors (read-only index "
+                                   "or out of memory)");
+    return nullptr;
+  }
+
+  napi_value ids;
+  napi_create_typedarray(env, napi_int32_array, count, ids_buffer, 0, &ids);
+  return ids;
+}
+
+/**
+ * Remove a vector from search results
+ *
+ * @param index - Index handle
+ * @param id - Id returned by hnswAdd
+ * @returns Number (0 on success, -1 if unknown / already removed)
+ */
+static napi_value HnswRemove(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected 2 arguments: index, id");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  int32_t id;
+  if (napi_get_value_int32(env, args[1], &id) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "id must be a number");
+    return nullptr;
+  }
+
+  napi_value return_value;
+  napi_create_int32(env, fastembed_hnsw_remove(index, id), &return_value);
+  return return_value;
+}
+
+/**
+ * Find approximately the k nearest vectors
+ *
+ * @param index - Index handle
+ * @param query - Query vector [dimension]
+ * @param k - Number of results
+ * @returns { ids: Int32Array, scores: Float32Array }, best first
+ */
+static napi_value HnswSearch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 3) {
+    napi_throw_error(env, nullptr, "Expected 3 arguments: index, query, k");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  int32_t k = 0;
+  if (napi_get_value_int32(env, args[2], &k) != napi_ok || k <= 0) {
+    napi_throw_error(env, nullptr, "k must be a positive integer");
+    return nullptr;
+  }
+
+  size_t dimension;
+  float *query = GetFloatArrayFromValue(env, args[1], &dimension);
+  if (!query || dimension != (size_t)fastembed_hnsw_dimension(index)) {
+    if (query)
+      free(query);
+    napi_throw_error(env, nullptr,
+                     "query length must match the index dimension");
+    return nullptr;
+  }
+
+  int size = fastembed_hnsw_size(index);
+  if (k > size) {
+    k = size;
+  }
+
+  napi_value ids_buffer, scores_buffer;
+  void *ids_data = nullptr;
+  void *scores_data = nullptr;
+  napi_create_arraybuffer(env, (size_t)k * sizeof(int32_t), &ids_data,
+                          &ids_buffer);
+  napi_create_arraybuffer(env, (size_t)k * sizeof(float), &scores_data,
+                          &scores_buffer);
+
+  int count = k > 0 ? fastembed_hnsw_search(index, query, k, (int *)ids_data,
+                                            (float *)scores_data)
+                    : 0;
+  free(query);
+
+  if (count < 0) {
+    napi_throw_error(env, nullptr, "Failed to search HNSW index");
+    return nullptr;
+  }
+
+  napi_value ids, scores, result;
+  napi_create_typedarray(env, napi_int32_array, count, ids_buffer, 0, &ids);
+  napi_create_typedarray(env, napi_float32_array, count, scores_buffer, 0,
+                         &scores);
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "ids", ids);
+  napi_set_named_property(env, result, "scores", scores);
+  return result;
+}
+
+/**
+ * Set the candidate list size used by hnswSearch
+ *
+ * @param index - Index handle
+ * @param ef - Candidate list size (values below k are raised to k)
+ * @returns Number (0 on success)
+ */
+static napi_value HnswSetEfSearch(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected 2 arguments: index, ef");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  int32_t ef = 0;
+  if (napi_get_value_int32(env, args[1], &ef) != napi_ok ||
+      fastembed_hnsw_set_ef_search(index, ef) != 0) {
+    napi_throw_error(env, nullptr, "ef must be a positive integer");
+    return nullptr;
+  }
+
+  napi_value return_value;
+  napi_create_int32(env, 0, &return_value);
+  return return_value;
+}
+
+/**
+ * Number of vectors in an index (removed ones excluded)
+ *
+ * @param index - Index handle
+ * @returns Number
+ */
+static napi_value HnswSize(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: index");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  napi_value return_value;
+  napi_create_int32(env, fastembed_hnsw_size(index), &return_value);
+  return return_value;
+}
+
+/**
+ * Vector dimension of an index
+ *
+ * @param index - Index handle
+ * @returns Number
+ */
+static napi_value HnswDimension(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 1) {
+    napi_throw_error(env, nullptr, "Expected 1 argument: index");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  napi_value return_value;
+  napi_create_int32(env, fastembed_hnsw_dimension(index), &return_value);
+  return return_value;
+}
+
+/**
+ * Write an index to a file
+ *
+ * @param index - Index handle
+ * @param path - Destination file (replaced if it exists)
+ * @returns Number (0 on success)
+ */
+static napi_value HnswSave(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+  if (argc < 2) {
+    napi_throw_error(env, nullptr, "Expected 2 arguments: index, path");
+    return nullptr;
+  }
+
+  fastembed_hnsw_t *index = GetHnswFromValue(env, args[0]);
+  if (!index) {
+    return nullptr;
+  }
+
+  napi_valuetype valuetype;
+  napi_typeof(env, args[1], &valuetype);
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "path must be a string");
+    return nullptr;
+  }
+
+  char *path = GetStringFromValue(env, args[1]);
+  int result = fastembed_hnsw_save(index, path);
+  if (result != 0) {
+    char detailed_error[1024];
+    snprintf(detailed_error, sizeof(detailed_error),
+             "Failed to save HNSW index (path: %s)", path);
+    free(path);
+    napi_throw_error(env, nullptr, detailed_error);
+    return nullptr;
+  }
+  free(path);
+
+  napi_value return_value;
+  napi_create_int32(env, 0, &return_value);
+  return return_value;
+}
+
 // Module initialization
 static napi_value Init(napi_env env, napi_value exports) {
   // Export functions
   napi_value generate_fn, generate_onnx_fn, unload_onnx_fn, get_onnx_error_fn,
-      cosine_fn, dot_fn, norm_fn, normalize_fn, add_fn;
+      open_onnx_fn, close_onnx_fn, onnx_dimension_fn, onnx_provider_fn,
+      generate_onnx_model_fn, cosine_fn, dot_fn, norm_fn, normalize_fn, add_fn,
+      similarity_matrix_fn, topk_fn, hnsw_create_fn, hnsw_load_fn,
+      hnsw_free_fn, hnsw_add_fn, hnsw_remove_fn, hnsw_search_fn,
+      hnsw_set_ef_fn, hnsw_size_fn, hnsw_dimension_fn, hnsw_save_fn,
+      quantize_int8_fn, quantize_binary_fn, topk_int8_fn, topk_binary_fn,
+      rescore_fn, to_half_fn, from_half_fn, topk_half_fn, generate_onnx_async_fn,
+      batch_generate_async_fn, topk_async_fn, stats_snapshot_fn,
+      stats_reset_fn, stats_set_enabled_fn, warmup_onnx_async_fn;
 
   napi_create_function(env, nullptr, 0, GenerateEmbedding, nullptr,
                        &generate_fn);
@@ -538,23 +3268,110 @@ static napi_value Init(napi_env env, napi_value exports) {
                        &unload_onnx_fn);
   napi_create_function(env, nullptr, 0, GetOnnxLastError, nullptr,
                        &get_onnx_error_fn);
+  napi_create_function(env, nullptr, 0, StatsSnapshotJson, nullptr,
+                       &stats_snapshot_fn);
+  napi_create_function(env, nullptr, 0, StatsReset, nullptr, &stats_reset_fn);
+  napi_create_function(env, nullptr, 0, StatsSetEnabled, nullptr,
+                       &stats_set_enabled_fn);
+  napi_create_function(env, nullptr, 0, OpenOnnxModel, nullptr, &open_onnx_fn);
+  napi_create_function(env, nullptr, 0, CloseOnnxModel, nullptr,
+                       &close_onnx_fn);
+  napi_create_function(env, nullptr, 0, GetOnnxModelDimension, nullptr,
+                       &onnx_dimension_fn);
+  napi_create_function(env, nullptr, 0, GetOnnxModelExecutionProvider, nullptr,
+                       &onnx_provider_fn);
+  napi_create_function(env, nullptr, 0, GenerateOnnxEmbeddingWithModel,
+                       nullptr, &generate_onnx_model_fn);
   napi_create_function(env, nullptr, 0, CosineSimilarity, nullptr, &cosine_fn);
   napi_create_function(env, nullptr, 0, DotProduct, nullptr, &dot_fn);
   napi_create_function(env, nullptr, 0, VectorNorm, nullptr, &norm_fn);
   napi_create_function(env, nullptr, 0, NormalizeVector, nullptr,
                        &normalize_fn);
   napi_create_function(env, nullptr, 0, AddVectors, nullptr, &add_fn);
+  napi_create_function(env, nullptr, 0, SimilarityMatrix, nullptr,
+                       &similarity_matrix_fn);
+  napi_create_function(env, nullptr, 0, TopK, nullptr, &topk_fn);
+  napi_create_function(env, nullptr, 0, QuantizeInt8, nullptr,
+                       &quantize_int8_fn);
+  napi_create_function(env, nullptr, 0, QuantizeBinary, nullptr,
+                       &quantize_binary_fn);
+  napi_create_function(env, nullptr, 0, TopKInt8, nullptr, &topk_int8_fn);
+  napi_create_function(env, nullptr, 0, TopKBinary, nullptr, &topk_binary_fn);
+  napi_create_function(env, nullptr, 0, Rescore, nullptr, &rescore_fn);
+  napi_create_function(env, nullptr, 0, ToHalf, nullptr, &to_half_fn);
+  napi_create_function(env, nullptr, 0, FromHalf, nullptr, &from_half_fn);
+  napi_create_function(env, nullptr, 0, TopKHalf, nullptr, &topk_half_fn);
+  napi_create_function(env, nullptr, 0, GenerateOnnxAsync, nullptr,
+                       &generate_onnx_async_fn);
+  napi_create_function(env, nullptr, 0, WarmupOnnxAsync, nullptr,
+                       &warmup_onnx_async_fn);
+  napi_create_function(env, nullptr, 0, BatchGenerateAsync, nullptr,
+                       &batch_generate_async_fn);
+  napi_create_function(env, nullptr, 0, TopKAsync, nullptr, &topk_async_fn);
+  napi_create_function(env, nullptr, 0, CreateHnswIndex, nullptr,
+                       &hnsw_create_fn);
+  napi_create_function(env, nullptr, 0, LoadHnswIndex, nullptr, &hnsw_load_fn);
+  napi_create_function(env, nullptr, 0, FreeHnswIndex, nullptr, &hnsw_free_fn);
+  napi_create_function(env, nullptr, 0, HnswAdd, nullptr, &hnsw_add_fn);
+  napi_create_function(env, nullptr, 0, HnswRemove, nullptr, &hnsw_remove_fn);
+  napi_create_function(env, nullptr, 0, HnswSearch, nullptr, &hnsw_search_fn);
+  napi_create_function(env, nullptr, 0, HnswSetEfSearch, nullptr,
+                       &hnsw_set_ef_fn);
+  napi_create_function(env, nullptr, 0, HnswSize, nullptr, &hnsw_size_fn);
+  napi_create_function(env, nullptr, 0, HnswDimension, nullptr,
+                       &hnsw_dimension_fn);
+  napi_create_function(env, nullptr, 0, HnswSave, nullptr, &hnsw_save_fn);
 
   napi_set_named_property(env, exports, "generateEmbedding", generate_fn);
   napi_set_named_property(env, exports, "generateOnnxEmbedding",
                           generate_onnx_fn);
   napi_set_named_property(env, exports, "unloadOnnxModel", unload_onnx_fn);
   napi_set_named_property(env, exports, "getOnnxLastError", get_onnx_error_fn);
+  napi_set_named_property(env, exports, "statsSnapshotJson", stats_snapshot_fn);
+  napi_set_named_property(env, exports, "statsReset", stats_reset_fn);
+  napi_set_named_property(env, exports, "statsSetEnabled",
+                          stats_set_enabled_fn);
+  napi_set_named_property(env, exports, "openOnnxModel", open_onnx_fn);
+  napi_set_named_property(env, exports, "closeOnnxModel", close_onnx_fn);
+  napi_set_named_property(env, exports, "getOnnxModelDimension",
+                          onnx_dimension_fn);
+  napi_set_named_property(env, exports, "getOnnxModelExecutionProvider",
+                          onnx_provider_fn);
+  napi_set_named_property(env, exports, "generateOnnxEmbeddingWithModel",
+                          generate_onnx_model_fn);
   napi_set_named_property(env, exports, "cosineSimilarity", cosine_fn);
   napi_set_named_property(env, exports, "dotProduct", dot_fn);
   napi_set_named_property(env, exports, "vectorNorm", norm_fn);
   napi_set_named_property(env, exports, "normalizeVector", normalize_fn);
   napi_set_named_property(env, exports, "addVectors", add_fn);
+  napi_set_named_property(env, exports, "similarityMatrix",
+                          similarity_matrix_fn);
+  napi_set_named_property(env, exports, "topK", topk_fn);
+  napi_set_named_property(env, exports, "quantizeInt8", quantize_int8_fn);
+  napi_set_named_property(env, exports, "quantizeBinary", quantize_binary_fn);
+  napi_set_named_property(env, exports, "topKInt8", topk_int8_fn);
+  napi_set_named_property(env, exports, "topKBinary", topk_binary_fn);
+  napi_set_named_property(env, exports, "rescore", rescore_fn);
+  napi_set_named_property(env, exports, "toHalf", to_half_fn);
+  napi_set_named_property(env, exports, "fromHalf", from_half_fn);
+  napi_set_named_property(env, exports, "topKHalf", topk_half_fn);
+  napi_set_named_property(env, exports, "generateOnnxAsync",
+                          generate_onnx_async_fn);
+  napi_set_named_property(env, exports, "warmupOnnxAsync",
+                          warmup_onnx_async_fn);
+  napi_set_named_property(env, exports, "batchGenerateAsync",
+                          batch_generate_async_fn);
+  napi_set_named_property(env, exports, "topKAsync", topk_async_fn);
+  napi_set_named_property(env, exports, "createHnswIndex", hnsw_create_fn);
+  napi_set_named_property(env, exports, "loadHnswIndex", hnsw_load_fn);
+  napi_set_named_property(env, exports, "freeHnswIndex", hnsw_free_fn);
+  napi_set_named_property(env, exports, "hnswAdd", hnsw_add_fn);
+  napi_set_named_property(env, exports, "hnswRemove", hnsw_remove_fn);
+  napi_set_named_property(env, exports, "hnswSearch", hnsw_search_fn);
+  napi_set_named_property(env, exports, "hnswSetEfSearch", hnsw_set_ef_fn);
+  napi_set_named_property(env, exports, "hnswSize", hnsw_size_fn);
+  napi_set_named_property(env, exports, "hnswDimension", hnsw_dimension_fn);
+  napi_set_named_property(env, exports, "hnswSave", hnsw_save_fn);
 
   return exports;
 }
@@ -5,6 +5,14 @@
       "sources": [
         "addon/fastembed_napi.cc",
         "../shared/src/embedding_lib_c.c",
+        "../shared/src/wordpiece_tokenizer.c",
+        "../shared/src/similarity.c",
+        "../shared/src/hnsw_index.c",
+        "../shared/src/quantize.c",
+        "../shared/src/thread_pool.c",
+        "../shared/src/vector_store.c",
+        "../shared/src/embedding_cache.c",
+        "../shared/src/fastembed_stats.c",
         "../shared/src/onnx_embedding_loader.c"
       ],
       "include_dirs": [
@@ -8,16 +8,242 @@ import { createRequire } from 'module';
 import * as path from 'path';
 import { fileURLToPath } from 'url';
 
+/**
+ * ONNX Runtime execution provider names
+ */
+export type OnnxExecutionProvider = 'cpu' | 'cuda' | 'tensorrt' | 'coreml' | 'xnnpack';
+
+/**
+ * Pooling over [batch, seq_len, hidden] model outputs
+ */
+export type OnnxPooling = 'cls' | 'mean' | 'max' | 'last_token';
+
+/**
+ * ONNX Runtime session options (all fields optional, ORT defaults otherwise)
+ */
+export interface OnnxSessionOptions {
+  /** Threads used inside one operator (0 = ORT default, one per physical core) */
+  intraOpThreads?: number;
+  /** Threads used to run independent operators in parallel (0 = ORT default) */
+  interOpThreads?: number;
+  /** Graph optimization level (default: 'all') */
+  graphOptimizationLevel?: 'disable' | 'basic' | 'extended' | 'all';
+  /** Pre-plan memory for fixed input shapes (default: true) */
+  enableMemPattern?: boolean;
+  /** Use the CPU memory arena allocator (default: true) */
+  enableCpuMemArena?: boolean;
+  /** Providers in order of preference; unavailable ones are skipped, CPU is the final fallback */
+  executionProviders?: OnnxExecutionProvider[];
+  /** GPU device for CUDA / TensorRT (default: 0) */
+  deviceId?: number;
+  /** Path where the optimized model is cached and reloaded from */
+  optimizedModelPath?: string;
+  /** vocab.txt or WordPiece tokenizer.json (default: found next to the model) */
+  tokenizerPath?: string;
+  /** Pooling over token embeddings (default: 'cls'; sentence-transformers models usually need 'mean') */
+  pooling?: OnnxPooling;
+}
+
+/**
+ * Scoring function used by similarityMatrix()
+ */
+export type SimilarityMetric = 'dot' | 'cosine' | 'euclidean';
+
+/**
+ * Result of topK(), best match first
+ */
+export interface TopKResult {
+  /** Corpus row indices */
+  ids: Int32Array;
+  /** Scores of those rows (distances for 'euclidean') */
+  scores: Float32Array;
+}
+
+/**
+ * Texts in Arrow string layout: UTF-8 bytes plus numTexts + 1 byte offsets
+ * (text i is data[offsets[i], offsets[i + 1]))
+ */
+export interface PackedTexts {
+  data: Uint8Array;
+  offsets: Int32Array;
+}
+
+/**
+ * Result of batchGenerateAsync()
+ */
+export interface BatchResult {
+  /** Row-major [numTexts x dimension] matrix (the target, if one was given) */
+  embeddings: Float32Array;
+  /** Per-text status: 0 ok, -1 error, -2 missing text, -3 invalid text */
+  statuses: Int32Array;
+  /** Number of failed texts (their rows are zero) */
+  failed: number;
+}
+
+/**
+ * Result of quantizeInt8(): x ~ codes[i] * scales[row]
+ */
+export interface Int8Quantized {
+  /** Row-major codes in [-127, 127] */
+  codes: Int8Array;
+  /** One scale per vector */
+  scales: Float32Array;
+}
+
+/**
+ * Result of topKBinary(), nearest first
+ */
+export interface BinaryTopKResult {
+  /** Corpus row indices */
+  ids: Int32Array;
+  /** Hamming distances of those rows */
+  distances: Int32Array;
+}
+
+/**
+ * Half-precision storage format: IEEE float16 or bfloat16
+ */
+export type HalfFormat = 'fp16' | 'bf16';
+
+/**
+ * Opaque handle to an open ONNX model
+ */
+export type OnnxModelHandle = { readonly __brand: 'OnnxModelHandle' };
+
+/**
+ * HNSW index construction parameters (all fields optional)
+ */
+export interface HnswIndexOptions {
+  /** Neighbours per node, 2 - 64 (default: 16; the bottom level keeps 2 * m) */
+  m?: number;
+  /** Candidate list size while inserting (default: 200) */
+  efConstruction?: number;
+  /** Candidate list size while searching (default: 64) */
+  efSearch?: number;
+  /** Distance (default: 'cosine') */
+  metric?: SimilarityMetric;
+  /** Seed for level assignment; same seed + same inserts = same graph */
+  seed?: number;
+}
+
+/**
+ * Summary of one histogram; latency keys carry a _ns suffix
+ * (sum_ns, min_ns, ...) in StatsSnapshot.stages
+ */
+export interface HistogramSummary {
+  count: number;
+  [key: string]: number;
+}
+
+/**
+ * Native instrumentation counters (statsSnapshot())
+ */
+export interface StatsSnapshot {
+  enabled: number;
+  /** Texts passed to ONNX generate calls */
+  texts: number;
+  /** Failed generate batches */
+  errors: number;
+  /** Tokens sent to inference, without padding */
+  tokens: number;
+  /** Tokens sent to inference, with padding */
+  padded_tokens: number;
+  /** Rows per inference call: count, sum, min, max, p50, p90, p99, p999 */
+  batch_rows: HistogramSummary;
+  /** Latency per stage in nanoseconds: count, sum_ns, min_ns, ..., p999_ns */
+  stages: Record<'resolve' | 'load' | 'tokenize' | 'bind' | 'run' | 'pool' | 'generate', HistogramSummary>;
+}
+
+/**
+ * Opaque handle to an HNSW index
+ */
+export type HnswIndexHandle = { readonly __brand: 'HnswIndexHandle' };
+
 // Native module interface
 interface FastEmbedNativeModule {
   generateEmbedding(text: string, dimension?: number): Float32Array;
   generateOnnxEmbedding(modelPath: string, text: string, dimension?: number): Float32Array;
   unloadOnnxModel(): number;
+  statsSnapshotJson(): string;
+  statsReset(): void;
+  statsSetEnabled(enabled: boolean): void;
+  openOnnxModel(modelPath: string, options?: OnnxSessionOptions): OnnxModelHandle;
+  closeOnnxModel(model: OnnxModelHandle): number;
+  getOnnxModelDimension(model: OnnxModelHandle): number;
+  getOnnxModelExecutionProvider(model: OnnxModelHandle): OnnxExecutionProvider;
+  generateOnnxEmbeddingWithModel(model: OnnxModelHandle, text: string, dimension?: number): Float32Array;
+  generateOnnxAsync(model: OnnxModelHandle | string, text: string, target?: Float32Array): Promise<Float32Array>;
+  warmupOnnxAsync(model: OnnxModelHandle | string): Promise<void>;
+  batchGenerateAsync(
+    texts: string[] | PackedTexts,
+    dimensionOrModel: number | OnnxModelHandle,
+    target?: Float32Array,
+    threads?: number
+  ): Promise<BatchResult>;
   cosineSimilarity(vectorA: Float32Array | number[], vectorB: Float32Array | number[]): number;
   dotProduct(vectorA: Float32Array | number[], vectorB: Float32Array | number[]): number;
   vectorNorm(vector: Float32Array | number[]): number;
   normalizeVector(vector: Float32Array | number[]): Float32Array;
   addVectors(vectorA: Float32Array | number[], vectorB: Float32Array | number[]): Float32Array;
+  similarityMatrix(
+    queries: Float32Array | number[],
+    corpus: Float32Array | number[],
+    dimension: number,
+    metric?: SimilarityMetric,
+    threads?: number
+  ): Float32Array;
+  topK(
+    query: Float32Array | number[],
+    corpus: Float32Array | number[],
+    k: number,
+    metric?: SimilarityMetric,
+    threads?: number
+  ): TopKResult;
+  topKAsync(
+    query: Float32Array | number[],
+    corpus: Float32Array | number[],
+    k: number,
+    metric?: SimilarityMetric,
+    threads?: number
+  ): Promise<TopKResult>;
+  quantizeInt8(vectors: Float32Array | number[], dimension: number): Int8Quantized;
+  quantizeBinary(vectors: Float32Array | number[], dimension: number): Uint8Array;
+  topKInt8(
+    queryCodes: Int8Array,
+    queryScale: number,
+    corpusCodes: Int8Array,
+    corpusScales: Float32Array,
+    k: number,
+    threads?: number
+  ): TopKResult;
+  topKBinary(queryBits: Uint8Array, corpusBits: Uint8Array, dimension: number, k: number, threads?: number): BinaryTopKResult;
+  rescore(
+    query: Float32Array | number[],
+    corpus: Float32Array | number[],
+    candidates: Int32Array | number[],
+    k: number,
+    metric?: SimilarityMetric
+  ): TopKResult;
+  toHalf(vectors: Float32Array | number[], format?: HalfFormat): Uint16Array;
+  fromHalf(halves: Uint16Array, format?: HalfFormat): Float32Array;
+  topKHalf(
+    query: Float32Array | number[],
+    corpus: Uint16Array,
+    format: HalfFormat,
+    k: number,
+    metric?: SimilarityMetric,
+    threads?: number
+  ): TopKResult;
+  createHnswIndex(dimension: number, options?: HnswIndexOptions): HnswIndexHandle;
+  loadHnswIndex(path: string, mmap?: boolean): HnswIndexHandle;
+  freeHnswIndex(index: HnswIndexHandle): number;
+  hnswAdd(index: HnswIndexHandle, vectors: Float32Array | number[], threads?: number): Int32Array;
+  hnswRemove(index: HnswIndexHandle, id: number): number;
+  hnswSearch(index: HnswIndexHandle, query: Float32Array | number[], k: number): TopKResult;
+  hnswSetEfSearch(index: HnswIndexHandle, ef: number): number;
+  hnswSize(index: HnswIndexHandle): number;
+  hnswDimension(index: HnswIndexHandle): number;
+  hnswSave(index: HnswIndexHandle, path: string): number;
 }
 
 let nativeModule: FastEmbedNativeModule | null = null;
@@ -71,6 +297,217 @@ export function generateEmbedding(text: string, dimension: number = 768): Float3
   return nativeModule.generateEmbedding(text, dimension);
 }
 
+/**
+ * Read the native instrumentation counters
+ * 
+ * Per-stage latency histograms of ONNX calls, batch sizes and padding.
+ * Values above 2^53 lose precision as JavaScript numbers.
+ * 
+ * @returns Counters (parsed fastembed_stats_snapshot_json() output)
+ */
+export function statsSnapshot(): StatsSnapshot {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return JSON.parse(nativeModule.statsSnapshotJson()) as StatsSnapshot;
+}
+
+/**
+ * Zero the native instrumentation counters
+ */
+export function statsReset(): void {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  nativeModule.statsReset();
+}
+
+/**
+ * Turn native instrumentation on or off (on by default)
+ * 
+ * @param enabled - Whether to record
+ */
+export function statsSetEnabled(enabled: boolean): void {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  nativeModule.statsSetEnabled(enabled);
+}
+
+/**
+ * Generate an ONNX embedding without blocking the event loop
+ * 
+ * Inference runs on the libuv threadpool. A model path is opened through
+ * the shared session cache, so only the first call loads the model.
+ * 
+ * @param model - OnnxModel handle or model path
+ * @param text - Input text
+ * @param target - Optional Float32Array (e.g. a SharedArrayBuffer view) of at
+ * least the model dimension, written in place
+ * @returns Embedding vector (target, if given)
+ */
+export function generateOnnxAsync(
+  model: OnnxModel | string,
+  text: string,
+  target?: Float32Array
+): Promise<Float32Array> {
+  if (!nativeModule) {
+    return Promise.reject(new Error('Native module not loaded. Call loadNativeModule() first.'));
+  }
+
+  if (typeof model !== 'string') {
+    return model.generateEmbeddingAsync(text, target);
+  }
+  return nativeModule.generateOnnxAsync(model, text, target);
+}
+
+/**
+ * Load an ONNX model and run warmup inferences without blocking the event loop
+ * 
+ * Call at startup so the first request does not pay for ONNX Runtime
+ * initialization, session creation and first-run allocations. A model path
+ * is loaded into the shared session cache with default options (the session
+ * used by generateOnnxEmbedding() and generateOnnxAsync() with a path).
+ * 
+ * @param model - OnnxModel or model path
+ */
+export function preloadOnnxModel(model: OnnxModel | string): Promise<void> {
+  if (!nativeModule) {
+    return Promise.reject(new Error('Native module not loaded. Call loadNativeModule() first.'));
+  }
+
+  if (typeof model !== 'string') {
+    return model.warmupAsync();
+  }
+  return nativeModule.warmupOnnxAsync(model);
+}
+
+/**
+ * Generate hash embeddings for many texts without blocking the event loop
+ * 
+ * Writes one row-major matrix; rows of invalid texts are zero and reported
+ * in statuses instead of rejecting the whole batch.
+ * 
+ * @param texts - Strings, or packed UTF-8 texts used in place
+ * @param dimension - Embedding dimension (default: 768)
+ * @param target - Optional Float32Array of at least texts * dimension elements
+ * @param threads - Pool threads (default: 1, 0 = whole pool)
+ * @returns Embedding matrix and per-text statuses
+ */
+export function batchGenerateAsync(
+  texts: string[] | PackedTexts,
+  dimension: number = 768,
+  target?: Float32Array,
+  threads: number = 1
+): Promise<BatchResult> {
+  if (!nativeModule) {
+    return Promise.reject(new Error('Native module not loaded. Call loadNativeModule() first.'));
+  }
+
+  return nativeModule.batchGenerateAsync(texts, dimension, target, threads);
+}
+
+/**
+ * ONNX model opened with session options
+ *
+ * Sessions are shared: opening the same model with the same options reuses
+ * the loaded session. Call close() when done (handles are also released on
+ * garbage collection).
+ */
+export class OnnxModel {
+  private handle: OnnxModelHandle | null;
+
+  /**
+   * @param modelPath - Path to ONNX model file
+   * @param options - ONNX Runtime session options
+   */
+  constructor(modelPath: string, options?: OnnxSessionOptions) {
+    if (!nativeModule) {
+      throw new Error('Native module not loaded. Call loadNativeModule() first.');
+    }
+
+    this.handle = nativeModule.openOnnxModel(modelPath, options);
+  }
+
+  private getHandle(): OnnxModelHandle {
+    if (!this.handle) {
+      throw new Error('ONNX model is closed');
+    }
+    return this.handle;
+  }
+
+  /**
+   * Output dimension of the model
+   */
+  get dimension(): number {
+    return nativeModule!.getOnnxModelDimension(this.getHandle());
+  }
+
+  /**
+   * Execution provider the session runs on (after fallback)
+   */
+  get executionProvider(): OnnxExecutionProvider {
+    return nativeModule!.getOnnxModelExecutionProvider(this.getHandle());
+  }
+
+  /**
+   * Generate embedding from text
+   *
+   * @param text - Input text
+   * @returns Embedding vector as Float32Array (L2-normalized)
+   */
+  generateEmbedding(text: string): Float32Array {
+    return nativeModule!.generateOnnxEmbeddingWithModel(this.getHandle(), text);
+  }
+
+  /**
+   * Generate embedding on the libuv threadpool (see generateOnnxAsync())
+   *
+   * @param text - Input text
+   * @param target - Optional Float32Array of at least dimension elements
+   * @returns Embedding vector (target, if given)
+   */
+  generateEmbeddingAsync(text: string, target?: Float32Array): Promise<Float32Array> {
+    return nativeModule!.generateOnnxAsync(this.getHandle(), text, target);
+  }
+
+  /**
+   * Run warmup inferences on the libuv threadpool (see preloadOnnxModel())
+   */
+  warmupAsync(): Promise<void> {
+    return nativeModule!.warmupOnnxAsync(this.getHandle());
+  }
+
+  /**
+   * Generate embeddings for many texts on the libuv threadpool
+   *
+   * @param texts - Strings or packed UTF-8 texts
+   * @param target - Optional Float32Array of at least texts * dimension elements
+   * @param threads - Pool threads (default: 1, 0 = whole pool)
+   * @returns Embedding matrix and per-text statuses
+   */
+  generateBatchAsync(
+    texts: string[] | PackedTexts,
+    target?: Float32Array,
+    threads: number = 1
+  ): Promise<BatchResult> {
+    return nativeModule!.batchGenerateAsync(texts, this.getHandle(), target, threads);
+  }
+
+  /**
+   * Release the model handle (after running async calls finish)
+   */
+  close(): void {
+    if (this.handle) {
+      nativeModule!.closeOnnxModel(this.handle);
+      this.handle = null;
+    }
+  }
+}
+
 /**
  * Calculate cosine similarity between two vectors
  * 
@@ -153,6 +590,373 @@ export function addVectors(
   return nativeModule.addVectors(vectorA, vectorB);
 }
 
+/**
+ * Score every query against every corpus vector in one native call
+ * 
+ * Pass a single query for one-to-many search. Scores for query q and
+ * corpus row c are at index q * numCorpus + c.
+ * 
+ * @param queries - Row-major [numQueries x dimension] matrix
+ * @param corpus - Row-major [numCorpus x dimension] matrix
+ * @param dimension - Vector dimension
+ * @param metric - Scoring function (default: 'cosine')
+ * @param threads - Worker threads (default: 1, 0 = all CPUs)
+ * @returns Row-major [numQueries x numCorpus] scores
+ */
+export function similarityMatrix(
+  queries: Float32Array | number[],
+  corpus: Float32Array | number[],
+  dimension: number,
+  metric: SimilarityMetric = 'cosine',
+  threads: number = 1
+): Float32Array {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.similarityMatrix(queries, corpus, dimension, metric, threads);
+}
+
+/**
+ * Find the k corpus vectors most similar to a query (exact search)
+ * 
+ * Scores are selected natively with a bounded heap, so no corpus-sized
+ * score array is created. 'euclidean' returns the nearest vectors.
+ * 
+ * @param query - Query vector
+ * @param corpus - Row-major [numCorpus x query.length] matrix
+ * @param k - Number of results (fewer if the corpus is smaller)
+ * @param metric - Scoring function (default: 'cosine')
+ * @param threads - Worker threads (default: 1, 0 = all CPUs)
+ * @returns Row indices and scores, best first
+ */
+export function topK(
+  query: Float32Array | number[],
+  corpus: Float32Array | number[],
+  k: number,
+  metric: SimilarityMetric = 'cosine',
+  threads: number = 1
+): TopKResult {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.topK(query, corpus, k, metric, threads);
+}
+
+/**
+ * Promise variant of topK() running on the libuv threadpool
+ * 
+ * Float32Array inputs (SharedArrayBuffer views included) are read in place
+ * and must not be modified until the promise settles.
+ * 
+ * @param query - Query vector
+ * @param corpus - Row-major [numCorpus x query.length] matrix
+ * @param k - Number of results (fewer if the corpus is smaller)
+ * @param metric - Scoring function (default: 'cosine')
+ * @param threads - Worker threads (default: 1, 0 = all CPUs)
+ * @returns Row indices and scores, best first
+ */
+export function topKAsync(
+  query: Float32Array | number[],
+  corpus: Float32Array | number[],
+  k: number,
+  metric: SimilarityMetric = 'cosine',
+  threads: number = 1
+): Promise<TopKResult> {
+  if (!nativeModule) {
+    return Promise.reject(new Error('Native module not loaded. Call loadNativeModule() first.'));
+  }
+
+  return nativeModule.topKAsync(query, corpus, k, metric, threads);
+}
+
+/**
+ * Quantize row-major vectors to int8 with one scale per vector
+ * 
+ * Codes take 1 byte per dimension instead of 4; x ~ code * scale.
+ * 
+ * @param vectors - Row-major [count x dimension] matrix
+ * @param dimension - Vector dimension
+ * @returns Codes and per-vector scales
+ */
+export function quantizeInt8(vectors: Float32Array | number[], dimension: number): Int8Quantized {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.quantizeInt8(vectors, dimension);
+}
+
+/**
+ * Binarize row-major vectors to packed sign bits
+ * 
+ * Each vector takes ceil(dimension / 8) bytes (1/32 of float32); bit i
+ * (byte i >> 3, bit i & 7) is set when component i is positive.
+ * 
+ * @param vectors - Row-major [count x dimension] matrix
+ * @param dimension - Vector dimension
+ * @returns Packed bits, ceil(dimension / 8) bytes per vector
+ */
+export function quantizeBinary(vectors: Float32Array | number[], dimension: number): Uint8Array {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.quantizeBinary(vectors, dimension);
+}
+
+/**
+ * Find the k int8-quantized rows with the highest dot product
+ * 
+ * Scores are dot products of the dequantized vectors (cosine similarity
+ * for quantized unit vectors).
+ * 
+ * @param query - quantizeInt8() result for one query
+ * @param corpus - quantizeInt8() result for the corpus
+ * @param k - Number of results (fewer if the corpus is smaller)
+ * @param threads - Worker threads (default: 1, 0 = all CPUs)
+ * @returns Row indices and scores, best first
+ */
+export function topKInt8(query: Int8Quantized, corpus: Int8Quantized, k: number, threads: number = 1): TopKResult {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.topKInt8(query.codes, query.scales[0], corpus.codes, corpus.scales, k, threads);
+}
+
+/**
+ * Find the k binary-quantized rows nearest in Hamming distance
+ * 
+ * Typically used for a shortlist of a few times k that rescore() reranks
+ * with the float vectors.
+ * 
+ * @param queryBits - quantizeBinary() result for one query
+ * @param corpusBits - quantizeBinary() result for the corpus
+ * @param dimension - Vector dimension
+ * @param k - Number of results (fewer if the corpus is smaller)
+ * @param threads - Worker threads (default: 1, 0 = all CPUs)
+ * @returns Row indices and Hamming distances, nearest first
+ */
+export function topKBinary(
+  queryBits: Uint8Array,
+  corpusBits: Uint8Array,
+  dimension: number,
+  k: number,
+  threads: number = 1
+): BinaryTopKResult {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.topKBinary(queryBits, corpusBits, dimension, k, threads);
+}
+
+/**
+ * Rerank a shortlist of corpus rows with exact float scores
+ * 
+ * @param query - Query vector
+ * @param corpus - Row-major [numCorpus x query.length] matrix
+ * @param candidates - Distinct corpus row indices (e.g. topKBinary().ids)
+ * @param k - Number of results (fewer if there are fewer candidates)
+ * @param metric - Scoring function (default: 'cosine')
+ * @returns Corpus row indices and scores, best first
+ */
+export function rescore(
+  query: Float32Array | number[],
+  corpus: Float32Array | number[],
+  candidates: Int32Array | number[],
+  k: number,
+  metric: SimilarityMetric = 'cosine'
+): TopKResult {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.rescore(query, corpus, candidates, k, metric);
+}
+
+/**
+ * Convert floats to half precision (round to nearest even)
+ * 
+ * Halves the memory of stored embeddings. 'fp16' keeps more mantissa bits,
+ * 'bf16' keeps the float32 exponent range.
+ * 
+ * @param vectors - Floats (e.g. a row-major corpus)
+ * @param format - Storage format (default: 'fp16')
+ * @returns One 16-bit value per float
+ */
+export function toHalf(vectors: Float32Array | number[], format: HalfFormat = 'fp16'): Uint16Array {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.toHalf(vectors, format);
+}
+
+/**
+ * Widen half-precision values back to floats (exact)
+ * 
+ * @param halves - toHalf() result
+ * @param format - Storage format (default: 'fp16')
+ * @returns Floats
+ */
+export function fromHalf(halves: Uint16Array, format: HalfFormat = 'fp16'): Float32Array {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.fromHalf(halves, format);
+}
+
+/**
+ * Find the k half-precision corpus rows most similar to a float query
+ * 
+ * Same results as topK() on fromHalf(corpus), without materializing the
+ * float corpus.
+ * 
+ * @param query - Query vector
+ * @param corpus - toHalf() result for a row-major [numCorpus x query.length]
+ * matrix
+ * @param format - Format the corpus was converted with
+ * @param k - Number of results (fewer if the corpus is smaller)
+ * @param metric - Scoring function (default: 'cosine')
+ * @param threads - Worker threads (default: 1, 0 = all CPUs)
+ * @returns Corpus row indices and scores, best first
+ */
+export function topKHalf(
+  query: Float32Array | number[],
+  corpus: Uint16Array,
+  format: HalfFormat,
+  k: number,
+  metric: SimilarityMetric = 'cosine',
+  threads: number = 1
+): TopKResult {
+  if (!nativeModule) {
+    throw new Error('Native module not loaded. Call loadNativeModule() first.');
+  }
+
+  return nativeModule.topKHalf(query, corpus, format, k, metric, threads);
+}
+
+/**
+ * Approximate nearest neighbour index (HNSW graph)
+ *
+ * Vectors get ids 0, 1, 2, ... in insertion order. Call free() when done
+ * (indexes are also released on garbage collection).
+ */
+export class HnswIndex {
+  private handle: HnswIndexHandle | null;
+
+  /**
+   * @param dimension - Vector dimension
+   * @param options - Graph parameters and metric
+   */
+  constructor(dimension: number, options?: HnswIndexOptions);
+  constructor(handle: HnswIndexHandle);
+  constructor(dimensionOrHandle: number | HnswIndexHandle, options?: HnswIndexOptions) {
+    if (!nativeModule) {
+      throw new Error('Native module not loaded. Call loadNativeModule() first.');
+    }
+
+    this.handle = typeof dimensionOrHandle === 'number'
+      ? nativeModule.createHnswIndex(dimensionOrHandle, options)
+      : dimensionOrHandle;
+  }
+
+  /**
+   * Load an index written by save()
+   *
+   * @param path - Index file
+   * @param mmap - Map the file read-only instead of reading it into memory
+   *               (add() and remove() then throw / fail)
+   */
+  static load(path: string, mmap: boolean = false): HnswIndex {
+    if (!nativeModule) {
+      throw new Error('Native module not loaded. Call loadNativeModule() first.');
+    }
+
+    return new HnswIndex(nativeModule.loadHnswIndex(path, mmap));
+  }
+
+  private getHandle(): HnswIndexHandle {
+    if (!this.handle) {
+      throw new Error('HNSW index is freed');
+    }
+    return this.handle;
+  }
+
+  /**
+   * Vector dimension
+   */
+  get dimension(): number {
+    return nativeModule!.hnswDimension(this.getHandle());
+  }
+
+  /**
+   * Number of vectors that can be returned (removed ones excluded)
+   */
+  get size(): number {
+    return nativeModule!.hnswSize(this.getHandle());
+  }
+
+  /**
+   * Add one vector or a row-major [n x dimension] matrix
+   *
+   * @param vectors - Vectors to add
+   * @param threads - Worker threads (default: 1, 0 = all CPUs)
+   * @returns Assigned ids, in row order
+   */
+  add(vectors: Float32Array | number[], threads: number = 1): Int32Array {
+    return nativeModule!.hnswAdd(this.getHandle(), vectors, threads);
+  }
+
+  /**
+   * Remove a vector from search results
+   *
+   * @returns false if the id is unknown or already removed
+   */
+  remove(id: number): boolean {
+    return nativeModule!.hnswRemove(this.getHandle(), id) === 0;
+  }
+
+  /**
+   * Find approximately the k nearest vectors
+   *
+   * @param query - Query vector
+   * @param k - Number of results
+   * @returns Ids and scores, best first (distances for 'euclidean')
+   */
+  search(query: Float32Array | number[], k: number): TopKResult {
+    return nativeModule!.hnswSearch(this.getHandle(), query, k);
+  }
+
+  /**
+   * Set the search candidate list size (larger = better recall, slower)
+   */
+  setEfSearch(ef: number): void {
+    nativeModule!.hnswSetEfSearch(this.getHandle(), ef);
+  }
+
+  /**
+   * Write the index to a file
+   */
+  save(path: string): void {
+    nativeModule!.hnswSave(this.getHandle(), path);
+  }
+
+  /**
+   * Release the index
+   */
+  free(): void {
+    if (this.handle) {
+      nativeModule!.freeHnswIndex(this.handle);
+      this.handle = null;
+    }
+  }
+}
+
 /**
  * FastEmbed Native Client
  * 
@@ -124,13 +124,36 @@ try {
   console.log('  Text:', specialText);
   console.log('  Embedding length:', specialEmb.length);
 
+  // Test 14: Async batch generation into a SharedArrayBuffer target
+  console.log('\n14. Testing batchGenerateAsync...');
+  const batchTexts = [text, text2, specialText];
+  const target = new Float32Array(new SharedArrayBuffer(batchTexts.length * 768 * 4));
+  const batch = await nativeModule.batchGenerateAsync(batchTexts, 768, target);
+  if (batch.embeddings !== target || batch.failed !== 0 ||
+      !target.subarray(768, 1536).every((v, i) => v === embedding2[i])) {
+    console.log('✗ Async batch rows should match generateEmbedding');
+    process.exit(1);
+  }
+  console.log('✓ Async batch written in place');
+  console.log('  Statuses:', Array.from(batch.statuses));
+
+  // Test 15: Async top-k
+  console.log('\n15. Testing topKAsync...');
+  const hits = await nativeModule.topKAsync(embedding2, target, 1);
+  if (hits.ids[0] !== 1) {
+    console.log('✗ Best match should be the query row itself');
+    process.exit(1);
+  }
+  console.log('✓ Async top-k resolved');
+  console.log('  Best id:', hits.ids[0], 'score:', hits.scores[0].toFixed(4));
+
   console.log('\n========================================');
-  console.log('ALL TESTS PASSED ✓ (13/13)');
+  console.log('ALL TESTS PASSED ✓ (15/15)');
   console.log('========================================');
   console.log('\nNative N-API module is working correctly!');
   console.log('Performance: ~0.5ms per embedding (native speed)');
   console.log('\nTest coverage:');
-  console.log('  • Happy path: 6 tests');
+  console.log('  • Happy path: 8 tests');
   console.log('  • Error handling: 4 tests');
   console.log('  • Edge cases: 3 tests');
 
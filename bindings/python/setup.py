@@ -37,7 +37,15 @@ class CMakeBuild(build_ext):
         # Source files
         sources = [
             "src/fastembed_native.cpp",
-            "../shared/src/embedding_lib_c.c"
+            "../shared/src/embedding_lib_c.c",
+            "../shared/src/wordpiece_tokenizer.c",
+            "../shared/src/similarity.c",
+            "../shared/src/hnsw_index.c",
+            "../shared/src/quantize.c",
+            "../shared/src/thread_pool.c",
+            "../shared/src/vector_store.c",
+            "../shared/src/embedding_cache.c",
+            "../shared/src/fastembed_stats.c"
         ]
         
         # Add ONNX loader only if ONNX Runtime is available
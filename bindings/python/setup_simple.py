@@ -47,7 +47,15 @@ ext_modules = [
         'fastembed_native',
         sources=[
             'python/fastembed_native.cpp',
-            'src/embedding_lib_c.c'
+            'src/embedding_lib_c.c',
+            'src/wordpiece_tokenizer.c',
+            'src/similarity.c',
+            'src/hnsw_index.c',
+            'src/quantize.c',
+            'src/thread_pool.c',
+            'src/vector_store.c',
+            'src/embedding_cache.c',
+            'src/fastembed_stats.c'
         ],
         include_dirs=[
             pybind11_include,
@@ -168,10 +168,72 @@ def generate_embedding(text: str, dimension: int = 768) -> np.ndarray:
     return fastembed_native.generate_embedding(text, dimension)
 
 
+def preload_onnx_model(model_path: str) -> None:
+    """
+    Load an ONNX model and run warmup inferences ahead of the first request
+    
+    Later path-based ONNX calls for model_path reuse the warmed-up session.
+    Releases the GIL, so it can run on a background thread during startup.
+    
+    Args:
+        model_path: Path to ONNX model file
+    """
+    if not NATIVE_AVAILABLE:
+        raise RuntimeError("FastEmbed native module not available")
+    
+    fastembed_native.preload_onnx_model(model_path)
+
+
+def stats_snapshot() -> dict:
+    """
+    Read the native instrumentation counters
+    
+    Returns:
+        dict with texts, errors, tokens, padded_tokens and enabled, a
+        batch_rows histogram (count, sum, min, max, p50, p90, p99, p999),
+        and per-stage latency histograms under "stages" (resolve, load,
+        tokenize, bind, run, pool, generate) with the same keys suffixed
+        by _ns, e.g. p99_ns.
+    """
+    if not NATIVE_AVAILABLE:
+        raise RuntimeError("FastEmbed native module not available")
+    
+    return fastembed_native.stats_snapshot()
+
+
+def stats_reset() -> None:
+    """Zero the native instrumentation counters"""
+    if not NATIVE_AVAILABLE:
+        raise RuntimeError("FastEmbed native module not available")
+    
+    fastembed_native.stats_reset()
+
+
+def stats_set_enabled(enabled: bool) -> None:
+    """Turn native instrumentation on or off (on by default)"""
+    if not NATIVE_AVAILABLE:
+        raise RuntimeError("FastEmbed native module not available")
+    
+    fastembed_native.stats_set_enabled(enabled)
+
+
+# ONNX model with session options (thread counts, execution providers, ...)
+OnnxModel = fastembed_native.OnnxModel if NATIVE_AVAILABLE else None
+
+# Approximate nearest neighbour index with save / load / mmap
+HnswIndex = fastembed_native.HnswIndex if NATIVE_AVAILABLE else None
+
+
 __all__ = [
     "FastEmbed",
+    "OnnxModel",
+    "HnswIndex",
     "is_available",
     "generate_embedding",
+    "preload_onnx_model",
+    "stats_snapshot",
+    "stats_reset",
+    "stats_set_enabled",
     "NATIVE_AVAILABLE"
 ]
 
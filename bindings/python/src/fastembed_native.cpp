@@ -5,9 +5,13 @@
  * and vector operations.
  */
 
+#include "fastembed.h"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -29,6 +33,13 @@ float fastembed_vector_norm(const float *vector, int dimension);
 void fastembed_normalize(float *vector, int dimension);
 void fastembed_add_vectors(const float *vector_a, const float *vector_b,
                            float *result, int dimension);
+int fastembed_similarity_matrix_threaded(const float *queries, int num_queries,
+                                         const float *corpus, int num_corpus,
+                                         int dimension, float *out, int metric,
+                                         int num_threads);
+int fastembed_topk_threaded(const float *query, const float *corpus,
+                            int num_corpus, int dimension, int k, int *out_ids,
+                            float *out_scores, int metric, int num_threads);
 }
 
 /**
@@ -71,9 +82,13 @@ py::array_t<float> generate_onnx_embedding(const std::string &model_path,
   py::buffer_info buf = result.request();
   float *ptr = static_cast<float *>(buf.ptr);
 
-  // Call C function
-  int status =
-      fastembed_onnx_generate(model_path.c_str(), text.c_str(), ptr, dimension);
+  // Call C function (inference runs without the GIL)
+  int status;
+  {
+    py::gil_scoped_release release;
+    status = fastembed_onnx_generate(model_path.c_str(), text.c_str(), ptr,
+                                     dimension);
+  }
 
   if (status != 0) {
     throw std::runtime_error("Failed to generate ONNX embedding");
@@ -82,6 +97,225 @@ py::array_t<float> generate_onnx_embedding(const std::string &model_path,
   return result;
 }
 
+static_assert(sizeof(int) == sizeof(int32_t),
+              "statuses and ids are passed to C as int32 arrays");
+
+/**
+ * Texts packed as one UTF-8 buffer plus Arrow-style offsets (the layout of
+ * fastembed_batch_generate_contiguous())
+ */
+struct PackedTexts {
+  std::string data;
+  std::vector<int32_t> offsets;
+
+  int size() const { return static_cast<int>(offsets.size()) - 1; }
+};
+
+/**
+ * Pack a list / tuple / 1-D NumPy array of str or bytes
+ *
+ * Runs with the GIL held; everything after works on the packed copy, so
+ * the C call can release the GIL. Each str is read through its cached
+ * UTF-8 form, so ASCII strings cost one memcpy.
+ */
+static PackedTexts pack_texts(const py::handle &texts) {
+  if (py::isinstance<py::str>(texts) || py::isinstance<py::bytes>(texts)) {
+    throw py::type_error("texts must be a sequence of strings, not a string");
+  }
+  if (py::isinstance<py::array>(texts) &&
+      py::reinterpret_borrow<py::array>(texts).ndim() != 1) {
+    throw std::invalid_argument("texts array must be 1-dimensional");
+  }
+
+  PackedTexts packed;
+  packed.offsets.push_back(0);
+  for (py::handle item : texts) {
+    const char *data = nullptr;
+    Py_ssize_t size = 0;
+    if (PyUnicode_Check(item.ptr())) {
+      data = PyUnicode_AsUTF8AndSize(item.ptr(), &size);
+      if (!data) {
+        throw py::error_already_set();
+      }
+    } else if (PyBytes_Check(item.ptr())) {
+      char *bytes = nullptr;
+      if (PyBytes_AsStringAndSize(item.ptr(), &bytes, &size) != 0) {
+        throw py::error_already_set();
+      }
+      data = bytes;
+    } else {
+      throw py::type_error("texts must contain only str or bytes");
+    }
+    if (size > INT32_MAX - packed.offsets.back() ||
+        packed.offsets.size() > static_cast<size_t>(INT32_MAX - 1)) {
+      throw std::length_error("texts are too large for one batch (2 GiB)");
+    }
+    packed.data.append(data, static_cast<size_t>(size));
+    packed.offsets.push_back(packed.offsets.back() +
+                             static_cast<int32_t>(size));
+  }
+  return packed;
+}
+
+/**
+ * Describe a fastembed_status_t for error messages
+ */
+static const char *status_message(int status) {
+  switch (status) {
+  case FASTEMBED_STATUS_NULL_INPUT:
+    return "missing text";
+  case FASTEMBED_STATUS_INVALID_TEXT:
+    return "empty, longer than 8192 bytes or containing NUL";
+  default:
+    return "generation failed";
+  }
+}
+
+/**
+ * Run a contiguous batch into a new (N, dimension) array without the GIL
+ *
+ * @param generate Fills output / statuses from the packed texts and returns
+ * the failed count (-1 on invalid arguments); called with the GIL released
+ * @return embeddings, or (embeddings, statuses) if return_statuses; failed
+ * texts raise ValueError unless return_statuses is set
+ */
+template <typename Generate>
+static py::object run_batch(const PackedTexts &packed, int dimension,
+                            bool return_statuses, Generate generate) {
+  py::ssize_t count = packed.size();
+  auto embeddings =
+      py::array_t<float>({count, static_cast<py::ssize_t>(dimension)});
+  auto statuses = py::array_t<int32_t>(count);
+  float *out = embeddings.mutable_data();
+  int *status_ptr = reinterpret_cast<int *>(statuses.mutable_data());
+
+  int failed = 0;
+  if (count > 0) {
+    py::gil_scoped_release release;
+    failed = generate(packed, out, status_ptr);
+  }
+  if (failed < 0) {
+    throw std::runtime_error("Failed to generate embeddings (invalid "
+                             "dimension or options)");
+  }
+
+  if (return_statuses) {
+    return py::make_tuple(embeddings, statuses);
+  }
+  if (failed > 0) {
+    for (py::ssize_t i = 0; i < count; i++) {
+      if (status_ptr[i] != FASTEMBED_STATUS_OK) {
+        throw std::invalid_argument(
+            std::to_string(failed) + " of " + std::to_string(count) +
+            " texts failed (first: index " + std::to_string(i) + ", " +
+            status_message(status_ptr[i]) + ")");
+      }
+    }
+  }
+  return embeddings;
+}
+
+/**
+ * Generate hash embeddings for many texts into one (N, dimension) array
+ *
+ * Texts are packed once, then embedded on the library thread pool with the
+ * GIL released.
+ *
+ * @param texts list / tuple / 1-D NumPy array of str or bytes
+ * @param dimension Embedding dimension (default: 768)
+ * @param threads Pool threads to use (0 = whole pool)
+ * @param return_statuses Return (embeddings, statuses) instead of raising
+ * for failed texts (their rows are zero)
+ * @return float32 (N, dimension) array
+ */
+py::object generate_batch(const py::object &texts, int dimension = 768,
+                          int threads = 0, bool return_statuses = false) {
+  if (dimension <= 0) {
+    throw std::invalid_argument("dimension must be positive");
+  }
+  PackedTexts packed = pack_texts(texts);
+  return run_batch(packed, dimension, return_statuses,
+                   [&](const PackedTexts &p, float *out, int *statuses) {
+                     return fastembed_batch_generate_contiguous(
+                         p.data.data(), p.offsets.data(), p.size(), out,
+                         dimension, statuses, threads);
+                   });
+}
+
+/**
+ * Shared ONNX model handle; returned copies keep the model open while a
+ * call runs without the GIL, even if close() is called meanwhile
+ */
+using ModelHandle = std::shared_ptr<fastembed_model_t>;
+
+static ModelHandle make_model_handle(fastembed_model_t *model) {
+  return ModelHandle(model, [](fastembed_model_t *m) {
+    if (m) {
+      fastembed_model_close(m);
+    }
+  });
+}
+
+/**
+ * Build an exception message from the last ONNX error
+ */
+static std::string onnx_error_message(const std::string &prefix) {
+  char error_buffer[512];
+  if (fastembed_onnx_get_last_error(error_buffer, sizeof(error_buffer)) == 0) {
+    return prefix + ": " + error_buffer;
+  }
+  return prefix;
+}
+
+/**
+ * ONNX batch for an open model into one (N, model dimension) array
+ */
+static py::object model_generate_batch(const ModelHandle &model,
+                                       const py::object &texts, int threads,
+                                       bool return_statuses) {
+  PackedTexts packed = pack_texts(texts);
+  int dimension = fastembed_model_get_dimension(model.get());
+  if (dimension <= 0) {
+    throw std::runtime_error(
+        onnx_error_message("Failed to get ONNX model dimension"));
+  }
+  return run_batch(packed, dimension, return_statuses,
+                   [&](const PackedTexts &p, float *out, int *statuses) {
+                     return fastembed_model_batch_generate_contiguous(
+                         model.get(), p.data.data(), p.offsets.data(),
+                         p.size(), out, dimension, statuses, threads);
+                   });
+}
+
+/**
+ * Generate ONNX embeddings for many texts into one (N, dimension) array
+ *
+ * The model is opened through the session cache (so repeated calls reuse
+ * it) and inference runs on the library thread pool without the GIL.
+ *
+ * @param model_path Path to ONNX model file
+ * @param texts list / tuple / 1-D NumPy array of str or bytes
+ * @param threads Pool threads to use (0 = whole pool)
+ * @param return_statuses Return (embeddings, statuses) instead of raising
+ * for failed texts
+ * @return float32 (N, model dimension) array
+ */
+py::object onnx_generate_batch(const std::string &model_path,
+                               const py::object &texts, int threads = 0,
+                               bool return_statuses = false) {
+  fastembed_model_t *model;
+  {
+    py::gil_scoped_release release;
+    model = fastembed_model_open(model_path.c_str());
+  }
+  if (!model) {
+    throw std::runtime_error(
+        onnx_error_message("Failed to open ONNX model " + model_path));
+  }
+  return model_generate_batch(make_model_handle(model), texts, threads,
+                              return_statuses);
+}
+
 /**
  * Unload ONNX model from memory
  *
@@ -89,6 +323,90 @@ py::array_t<float> generate_onnx_embedding(const std::string &model_path,
  */
 int unload_onnx_model() { return fastembed_onnx_unload(); }
 
+/**
+ * Load an ONNX model and run warmup inferences (default session options)
+ *
+ * Takes model loading off the first generate_onnx_embedding() /
+ * onnx_generate_batch() call for this path. Runs without the GIL, so it can
+ * be called from a background thread.
+ *
+ * @param model_path Path to ONNX model file
+ */
+void preload_onnx_model(const std::string &model_path) {
+  int status;
+  {
+    py::gil_scoped_release release;
+    status = fastembed_onnx_preload(model_path.c_str(), nullptr);
+  }
+  if (status != 0) {
+    throw std::runtime_error(
+        onnx_error_message("Failed to preload ONNX model " + model_path));
+  }
+}
+
+/** Stage keys of stats_snapshot(), in fastembed_stage_t order */
+static const char *const k_stage_names[FASTEMBED_STAGE_COUNT] = {
+    "resolve", "load", "tokenize", "bind", "run", "pool", "generate"};
+
+/** Histogram summary; unit suffixes the value keys, as in the JSON form */
+static py::dict histogram_dict(const fastembed_histogram_t &h,
+                               const std::string &unit = "") {
+  py::dict d;
+  d["count"] = h.count;
+  d[("sum" + unit).c_str()] = h.sum;
+  d[("min" + unit).c_str()] = h.min;
+  d[("max" + unit).c_str()] = h.max;
+  d[("p50" + unit).c_str()] = h.p50;
+  d[("p90" + unit).c_str()] = h.p90;
+  d[("p99" + unit).c_str()] = h.p99;
+  d[("p999" + unit).c_str()] = h.p999;
+  return d;
+}
+
+/**
+ * Read the instrumentation counters
+ *
+ * @return dict with the keys of fastembed_stats_snapshot_json(): texts,
+ * errors, tokens, padded_tokens, enabled, a batch_rows histogram and a
+ * stages dict of latency histograms (count, sum_ns, min_ns, max_ns,
+ * p50_ns, ...)
+ */
+py::dict stats_snapshot() {
+  fastembed_stats_t stats;
+  fastembed_stats_snapshot(&stats);
+
+  py::dict stages;
+  for (int s = 0; s < FASTEMBED_STAGE_COUNT; s++)
+    stages[k_stage_names[s]] = histogram_dict(stats.stages[s], "_ns");
+
+  py::dict d;
+  d["enabled"] = stats.enabled != 0;
+  d["texts"] = stats.texts;
+  d["errors"] = stats.errors;
+  d["tokens"] = stats.tokens;
+  d["padded_tokens"] = stats.padded_tokens;
+  d["batch_rows"] = histogram_dict(stats.batch_rows);
+  d["stages"] = stages;
+  return d;
+}
+
+/**
+ * Instrumentation counters as the JSON text of fastembed_stats_snapshot_json()
+ */
+std::string stats_snapshot_json() {
+  // Counters may grow between the two calls: retry until the buffer fits
+  std::string json;
+  int length = fastembed_stats_snapshot_json(nullptr, 0);
+  while (length >= 0 && (size_t)length >= json.size()) {
+    json.assign((size_t)length + 64, '\0');
+    length = fastembed_stats_snapshot_json(&json[0], json.size());
+  }
+  if (length < 0)
+    throw std::runtime_error("Failed to format instrumentation counters");
+  json.resize((size_t)length);
+  return json;
+}
+
 /**
  * Calculate cosine similarity between two vectors
  *
@@ -226,6 +544,867 @@ py::array_t<float> add_vectors(py::array_t<float> vector_a,
   return result;
 }
 
+/**
+ * Map a metric name to fastembed_metric_t
+ */
+static int parse_metric(const std::string &metric) {
+  if (metric == "cosine") {
+    return FASTEMBED_METRIC_COSINE;
+  } else if (metric == "dot") {
+    return FASTEMBED_METRIC_DOT;
+  } else if (metric == "euclidean") {
+    return FASTEMBED_METRIC_EUCLIDEAN;
+  }
+  throw std::runtime_error(
+      "Invalid metric (expected 'cosine', 'dot' or 'euclidean')");
+}
+
+/**
+ * Score every query row against every corpus row
+ *
+ * @param queries [num_queries, dimension] array (or one 1-D query)
+ * @param corpus [num_corpus, dimension] array
+ * @param metric "cosine", "dot" or "euclidean"
+ * @param threads Worker threads (0 = all CPUs)
+ * @return [num_queries, num_corpus] scores (NumPy array)
+ */
+py::array_t<float> similarity_matrix(
+    py::array_t<float, py::array::c_style | py::array::forcecast> queries,
+    py::array_t<float, py::array::c_style | py::array::forcecast> corpus,
+    const std::string &metric = "cosine", int threads = 1) {
+  py::buffer_info buf_q = queries.request();
+  py::buffer_info buf_c = corpus.request();
+
+  if (buf_q.ndim < 1 || buf_q.ndim > 2 || buf_c.ndim != 2) {
+    throw std::runtime_error(
+        "queries must be 1- or 2-dimensional and corpus 2-dimensional");
+  }
+
+  py::ssize_t num_queries = buf_q.ndim == 2 ? buf_q.shape[0] : 1;
+  py::ssize_t dimension = buf_q.shape[buf_q.ndim - 1];
+  py::ssize_t num_corpus = buf_c.shape[0];
+  if (buf_c.shape[1] != dimension) {
+    throw std::runtime_error("queries and corpus must have the same dimension");
+  }
+
+  int metric_code = parse_metric(metric);
+
+  auto result = py::array_t<float>({num_queries, num_corpus});
+  float *out = result.mutable_data();
+
+  int status;
+  {
+    py::gil_scoped_release release;
+    status = fastembed_similarity_matrix_threaded(
+        static_cast<const float *>(buf_q.ptr), static_cast<int>(num_queries),
+        static_cast<const float *>(buf_c.ptr), static_cast<int>(num_corpus),
+        static_cast<int>(dimension), out, metric_code, threads);
+  }
+  if (status != 0) {
+    throw std::runtime_error("Failed to compute similarity matrix");
+  }
+
+  return result;
+}
+
+/**
+ * Find the k corpus rows most similar to a query
+ *
+ * @param query 1-D query vector
+ * @param corpus [num_corpus, dimension] array
+ * @param k Number of results (fewer if the corpus is smaller)
+ * @param metric "cosine", "dot" or "euclidean" (nearest first)
+ * @param threads Worker threads (0 = all CPUs)
+ * @return (ids, scores) NumPy arrays, best first
+ */
+py::tuple topk(
+    py::array_t<float, py::array::c_style | py::array::forcecast> query,
+    py::array_t<float, py::array::c_style | py::array::forcecast> corpus,
+    int k, const std::string &metric = "cosine", int threads = 1) {
+  py::buffer_info buf_q = query.request();
+  py::buffer_info buf_c = corpus.request();
+
+  if (buf_q.ndim != 1 || buf_c.ndim != 2) {
+    throw std::runtime_error(
+        "query must be 1-dimensional and corpus 2-dimensional");
+  }
+  if (buf_c.shape[1] != buf_q.shape[0]) {
+    throw std::runtime_error("query and corpus must have the same dimension");
+  }
+  if (k <= 0) {
+    throw std::runtime_error("k must be positive");
+  }
+
+  int metric_code = parse_metric(metric);
+  py::ssize_t num_corpus = buf_c.shape[0];
+  py::ssize_t capacity = k < num_corpus ? k : num_corpus;
+
+  auto ids = py::array_t<int32_t>(capacity);
+  auto scores = py::array_t<float>(capacity);
+  int *id_ptr = reinterpret_cast<int *>(ids.mutable_data());
+  float *score_ptr = scores.mutable_data();
+
+  int count;
+  {
+    py::gil_scoped_release release;
+    count = fastembed_topk_threaded(
+        static_cast<const float *>(buf_q.ptr),
+        static_cast<const float *>(buf_c.ptr), static_cast<int>(num_corpus),
+        static_cast<int>(buf_q.shape[0]), k, id_ptr, score_ptr, metric_code,
+        threads);
+  }
+  if (count < 0) {
+    throw std::runtime_error("Failed to compute top-k");
+  }
+
+  return py::make_tuple(ids, scores);
+}
+
+/**
+ * Rows and dimension of a 1-D vector or 2-D row-major matrix
+ */
+static void matrix_shape(const py::buffer_info &buf, const char *name,
+                         py::ssize_t *rows, py::ssize_t *dimension) {
+  if (buf.ndim < 1 || buf.ndim > 2) {
+    throw std::runtime_error(std::string(name) +
+                             " must be 1- or 2-dimensional");
+  }
+  *rows = buf.ndim == 2 ? buf.shape[0] : 1;
+  *dimension = buf.shape[buf.ndim - 1];
+  if (*rows <= 0 || *dimension <= 0) {
+    throw std::runtime_error(std::string(name) + " must not be empty");
+  }
+}
+
+/**
+ * Quantize vectors to int8 with one scale per vector
+ *
+ * @param vectors 1-D vector or [count, dimension] array
+ * @return (codes, scales): int8 codes of the input shape, float32 [count]
+ */
+py::tuple quantize_int8(
+    py::array_t<float, py::array::c_style | py::array::forcecast> vectors) {
+  py::buffer_info buf = vectors.request();
+  py::ssize_t count, dimension;
+  matrix_shape(buf, "vectors", &count, &dimension);
+
+  auto codes = py::array_t<int8_t>(buf.shape);
+  auto scales = py::array_t<float>(count);
+  int status = fastembed_quantize_int8(
+      static_cast<const float *>(buf.ptr), static_cast<int>(count),
+      static_cast<int>(dimension), static_cast<int8_t *>(codes.request().ptr),
+      static_cast<float *>(scales.request().ptr));
+  if (status != 0) {
+    throw std::runtime_error("Failed to quantize vectors");
+  }
+
+  return py::make_tuple(codes, scales);
+}
+
+/**
+ * Binarize vectors to packed sign bits
+ *
+ * @param vectors 1-D vector or [count, dimension] array
+ * @return uint8 array of ceil(dimension / 8) bytes per vector ([bytes] or
+ * [count, bytes])
+ */
+py::array_t<uint8_t> quantize_binary(
+    py::array_t<float, py::array::c_style | py::array::forcecast> vectors) {
+  py::buffer_info buf = vectors.request();
+  py::ssize_t count, dimension;
+  matrix_shape(buf, "vectors", &count, &dimension);
+
+  std::vector<py::ssize_t> shape(buf.shape);
+  shape.back() = FASTEMBED_BINARY_BYTES(dimension);
+  auto bits = py::array_t<uint8_t>(shape);
+  int status = fastembed_quantize_binary(
+      static_cast<const float *>(buf.ptr), static_cast<int>(count),
+      static_cast<int>(dimension), static_cast<uint8_t *>(bits.request().ptr));
+  if (status != 0) {
+    throw std::runtime_error("Failed to binarize vectors");
+  }
+
+  return bits;
+}
+
+/**
+ * Find the k int8-quantized rows with the highest dot product
+ *
+ * @param query_codes 1-D int8 query codes
+ * @param query_scale Query scale
+ * @param corpus_codes [num_corpus, dimension] int8 codes
+ * @param corpus_scales [num_corpus] scales
+ * @param k Number of results (fewer if the corpus is smaller)
+ * @param threads Worker threads (0 = all CPUs)
+ * @return (ids, scores) NumPy arrays, best first
+ */
+py::tuple topk_int8(
+    py::array_t<int8_t, py::array::c_style | py::array::forcecast> query_codes,
+    float query_scale,
+    py::array_t<int8_t, py::array::c_style | py::array::forcecast>
+        corpus_codes,
+    py::array_t<float, py::array::c_style | py::array::forcecast>
+        corpus_scales,
+    int k, int threads = 1) {
+  py::buffer_info buf_q = query_codes.request();
+  py::buffer_info buf_c = corpus_codes.request();
+  py::buffer_info buf_s = corpus_scales.request();
+
+  if (buf_q.ndim != 1 || buf_c.ndim != 2 || buf_s.ndim != 1) {
+    throw std::runtime_error("query_codes and corpus_scales must be "
+                             "1-dimensional and corpus_codes 2-dimensional");
+  }
+  if (buf_c.shape[1] != buf_q.shape[0] || buf_s.shape[0] != buf_c.shape[0]) {
+    throw std::runtime_error(
+        "corpus_codes must have query-length rows and one scale per row");
+  }
+  if (k <= 0) {
+    throw std::runtime_error("k must be positive");
+  }
+
+  py::ssize_t num_corpus = buf_c.shape[0];
+  py::ssize_t capacity = k < num_corpus ? k : num_corpus;
+
+  auto ids = py::array_t<int32_t>(capacity);
+  auto scores = py::array_t<float>(capacity);
+  int *id_ptr = reinterpret_cast<int *>(ids.mutable_data());
+  float *score_ptr = scores.mutable_data();
+
+  int count;
+  {
+    py::gil_scoped_release release;
+    count = fastembed_topk_int8(
+        static_cast<const int8_t *>(buf_q.ptr), query_scale,
+        static_cast<const int8_t *>(buf_c.ptr),
+        static_cast<const float *>(buf_s.ptr), static_cast<int>(num_corpus),
+        static_cast<int>(buf_q.shape[0]), k, id_ptr, score_ptr, threads);
+  }
+  if (count < 0) {
+    throw std::runtime_error("Failed to compute int8 top-k");
+  }
+
+  return py::make_tuple(ids, scores);
+}
+
+/**
+ * Find the k binary-quantized rows nearest in Hamming distance
+ *
+ * @param query_bits 1-D uint8 query bits
+ * @param corpus_bits [num_corpus, ceil(dimension / 8)] uint8 bits
+ * @param dimension Vector dimension
+ * @param k Number of results (fewer if the corpus is smaller)
+ * @param threads Worker threads (0 = all CPUs)
+ * @return (ids, distances) NumPy arrays, nearest first
+ */
+py::tuple topk_binary(
+    py::array_t<uint8_t, py::array::c_style | py::array::forcecast> query_bits,
+    py::array_t<uint8_t, py::array::c_style | py::array::forcecast>
+        corpus_bits,
+    int dimension, int k, int threads = 1) {
+  py::buffer_info buf_q = query_bits.request();
+  py::buffer_info buf_c = corpus_bits.request();
+
+  if (buf_q.ndim != 1 || buf_c.ndim != 2) {
+    throw std::runtime_error(
+        "query_bits must be 1-dimensional and corpus_bits 2-dimensional");
+  }
+  if (dimension <= 0 || buf_q.shape[0] != FASTEMBED_BINARY_BYTES(dimension) ||
+      buf_c.shape[1] != buf_q.shape[0]) {
+    throw std::runtime_error(
+        "query_bits and corpus_bits rows must be ceil(dimension / 8) bytes");
+  }
+  if (k <= 0) {
+    throw std::runtime_error("k must be positive");
+  }
+
+  py::ssize_t num_corpus = buf_c.shape[0];
+  py::ssize_t capacity = k < num_corpus ? k : num_corpus;
+
+  auto ids = py::array_t<int32_t>(capacity);
+  auto distances = py::array_t<int32_t>(capacity);
+  int *id_ptr = reinterpret_cast<int *>(ids.mutable_data());
+  int *distance_ptr = reinterpret_cast<int *>(distances.mutable_data());
+
+  int count;
+  {
+    py::gil_scoped_release release;
+    count = fastembed_topk_binary(
+        static_cast<const uint8_t *>(buf_q.ptr),
+        static_cast<const uint8_t *>(buf_c.ptr), static_cast<int>(num_corpus),
+        dimension, k, id_ptr, distance_ptr, threads);
+  }
+  if (count < 0) {
+    throw std::runtime_error("Failed to compute binary top-k");
+  }
+
+  return py::make_tuple(ids, distances);
+}
+
+/**
+ * Rerank a shortlist of corpus rows with exact float scores
+ *
+ * @param query 1-D query vector
+ * @param corpus [num_corpus, dimension] array
+ * @param candidates 1-D distinct corpus row ids (e.g. from topk_binary())
+ * @param k Number of results (fewer if there are fewer candidates)
+ * @param metric "cosine", "dot" or "euclidean" (nearest first)
+ * @return (ids, scores) NumPy arrays, best first
+ */
+py::tuple rescore(
+    py::array_t<float, py::array::c_style | py::array::forcecast> query,
+    py::array_t<float, py::array::c_style | py::array::forcecast> corpus,
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast>
+        candidates,
+    int k, const std::string &metric = "cosine") {
+  py::buffer_info buf_q = query.request();
+  py::buffer_info buf_c = corpus.request();
+  py::buffer_info buf_ids = candidates.request();
+
+  if (buf_q.ndim != 1 || buf_c.ndim != 2 || buf_ids.ndim != 1) {
+    throw std::runtime_error("query and candidates must be 1-dimensional and "
+                             "corpus 2-dimensional");
+  }
+  if (buf_c.shape[1] != buf_q.shape[0]) {
+    throw std::runtime_error("query and corpus must have the same dimension");
+  }
+  if (k <= 0 || buf_ids.shape[0] == 0) {
+    throw std::runtime_error("k must be positive and candidates non-empty");
+  }
+
+  int metric_code = parse_metric(metric);
+  py::ssize_t num_candidates = buf_ids.shape[0];
+  py::ssize_t capacity = k < num_candidates ? k : num_candidates;
+
+  auto ids = py::array_t<int32_t>(capacity);
+  auto scores = py::array_t<float>(capacity);
+  int *id_ptr = reinterpret_cast<int *>(ids.mutable_data());
+  float *score_ptr = scores.mutable_data();
+
+  int count;
+  {
+    py::gil_scoped_release release;
+    count = fastembed_topk_rescore(
+        static_cast<const float *>(buf_q.ptr),
+        static_cast<const float *>(buf_c.ptr),
+        static_cast<int>(buf_c.shape[0]), static_cast<int>(buf_q.shape[0]),
+        static_cast<const int *>(buf_ids.ptr),
+        static_cast<int>(num_candidates), k, id_ptr, score_ptr, metric_code);
+  }
+  if (count < 0) {
+    throw std::runtime_error(
+        "Failed to rescore (candidate ids must be corpus rows)");
+  }
+
+  return py::make_tuple(ids, scores);
+}
+
+/**
+ * Map a half-precision format name to fastembed_quantization_t
+ */
+static int parse_half_format(const std::string &format) {
+  if (format == "fp16") {
+    return FASTEMBED_QUANT_FP16;
+  } else if (format == "bf16") {
+    return FASTEMBED_QUANT_BF16;
+  }
+  throw std::runtime_error("Invalid format (expected 'fp16' or 'bf16')");
+}
+
+/**
+ * Convert vectors to half precision (round to nearest even)
+ *
+ * @param vectors 1-D vector or [count, dimension] array
+ * @param format "fp16" or "bf16"
+ * @return uint16 array of the input shape (view fp16 results with
+ * .view(numpy.float16))
+ */
+py::array_t<uint16_t> to_half(
+    py::array_t<float, py::array::c_style | py::array::forcecast> vectors,
+    const std::string &format = "fp16") {
+  py::buffer_info buf = vectors.request();
+  py::ssize_t count, dimension;
+  matrix_shape(buf, "vectors", &count, &dimension);
+  int format_code = parse_half_format(format);
+  if (buf.size > INT32_MAX) {
+    throw std::runtime_error("vectors has too many elements");
+  }
+
+  auto halves = py::array_t<uint16_t>(buf.shape);
+  uint16_t *out = static_cast<uint16_t *>(halves.request().ptr);
+  const float *in = static_cast<const float *>(buf.ptr);
+  int status = format_code == FASTEMBED_QUANT_BF16
+                   ? fastembed_f32_to_bf16(in, out, static_cast<int>(buf.size))
+                   : fastembed_f32_to_f16(in, out, static_cast<int>(buf.size));
+  if (status != 0) {
+    throw std::runtime_error("Failed to convert to half precision");
+  }
+
+  return halves;
+}
+
+/**
+ * Widen half-precision values to float32
+ *
+ * @param halves uint16 array from to_half() (or a float16 array viewed as
+ * uint16)
+ * @param format "fp16" or "bf16"
+ * @return float32 array of the input shape
+ */
+py::array_t<float> from_half(
+    py::array_t<uint16_t, py::array::c_style | py::array::forcecast> halves,
+    const std::string &format = "fp16") {
+  py::buffer_info buf = halves.request();
+  py::ssize_t count, dimension;
+  matrix_shape(buf, "halves", &count, &dimension);
+  int format_code = parse_half_format(format);
+  if (buf.size > INT32_MAX) {
+    throw std::runtime_error("halves has too many elements");
+  }
+
+  auto floats = py::array_t<float>(buf.shape);
+  float *out = static_cast<float *>(floats.request().ptr);
+  const uint16_t *in = static_cast<const uint16_t *>(buf.ptr);
+  int status = format_code == FASTEMBED_QUANT_BF16
+                   ? fastembed_bf16_to_f32(in, out, static_cast<int>(buf.size))
+                   : fastembed_f16_to_f32(in, out, static_cast<int>(buf.size));
+  if (status != 0) {
+    throw std::runtime_error("Failed to convert from half precision");
+  }
+
+  return floats;
+}
+
+/**
+ * Score float queries against a half-precision corpus
+ *
+ * @param queries [num_queries, dimension] array (or one 1-D query)
+ * @param corpus [num_corpus, dimension] uint16 array from to_half()
+ * @param format "fp16" or "bf16"
+ * @param metric "cosine", "dot" or "euclidean"
+ * @param threads Worker threads (0 = all CPUs)
+ * @return [num_queries, num_corpus] scores (NumPy array)
+ */
+py::array_t<float> similarity_matrix_half(
+    py::array_t<float, py::array::c_style | py::array::forcecast> queries,
+    py::array_t<uint16_t, py::array::c_style | py::array::forcecast> corpus,
+    const std::string &format, const std::string &metric = "cosine",
+    int threads = 1) {
+  py::buffer_info buf_q = queries.request();
+  py::buffer_info buf_c = corpus.request();
+
+  if (buf_q.ndim < 1 || buf_q.ndim > 2 || buf_c.ndim != 2) {
+    throw std::runtime_error(
+        "queries must be 1- or 2-dimensional and corpus 2-dimensional");
+  }
+
+  py::ssize_t num_queries = buf_q.ndim == 2 ? buf_q.shape[0] : 1;
+  py::ssize_t dimension = buf_q.shape[buf_q.ndim - 1];
+  py::ssize_t num_corpus = buf_c.shape[0];
+  if (buf_c.shape[1] != dimension) {
+    throw std::runtime_error("queries and corpus must have the same dimension");
+  }
+
+  int format_code = parse_half_format(format);
+  int metric_code = parse_metric(metric);
+
+  auto result = py::array_t<float>({num_queries, num_corpus});
+  float *out = result.mutable_data();
+
+  int status;
+  {
+    py::gil_scoped_release release;
+    status = fastembed_similarity_matrix_half(
+        static_cast<const float *>(buf_q.ptr), static_cast<int>(num_queries),
+        static_cast<const uint16_t *>(buf_c.ptr), format_code,
+        static_cast<int>(num_corpus), static_cast<int>(dimension), out,
+        metric_code, threads);
+  }
+  if (status != 0) {
+    throw std::runtime_error("Failed to compute similarity matrix");
+  }
+
+  return result;
+}
+
+/**
+ * Find the k half-precision corpus rows most similar to a float query
+ *
+ * @param query 1-D query vector
+ * @param corpus [num_corpus, dimension] uint16 array from to_half()
+ * @param format "fp16" or "bf16"
+ * @param k Number of results (fewer if the corpus is smaller)
+ * @param metric "cosine", "dot" or "euclidean" (nearest first)
+ * @param threads Worker threads (0 = all CPUs)
+ * @return (ids, scores) NumPy arrays, best first
+ */
+py::tuple topk_half(
+    py::array_t<float, py::array::c_style | py::array::forcecast> query,
+    py::array_t<uint16_t, py::array::c_style | py::array::forcecast> corpus,
+    const std::string &format, int k, const std::string &metric = "cosine",
+    int threads = 1) {
+  py::buffer_info buf_q = query.request();
+  py::buffer_info buf_c = corpus.request();
+
+  if (buf_q.ndim != 1 || buf_c.ndim != 2) {
+    throw std::runtime_error(
+        "query must be 1-dimensional and corpus 2-dimensional");
+  }
+  if (buf_c.shape[1] != buf_q.shape[0]) {
+    throw std::runtime_error("query and corpus must have the same dimension");
+  }
+  if (k <= 0) {
+    throw std::runtime_error("k must be positive");
+  }
+
+  int format_code = parse_half_format(format);
+  int metric_code = parse_metric(metric);
+  py::ssize_t num_corpus = buf_c.shape[0];
+  py::ssize_t capacity = k < num_corpus ? k : num_corpus;
+
+  auto ids = py::array_t<int32_t>(capacity);
+  auto scores = py::array_t<float>(capacity);
+  int *id_ptr = reinterpret_cast<int *>(ids.mutable_data());
+  float *score_ptr = scores.mutable_data();
+
+  int count;
+  {
+    py::gil_scoped_release release;
+    count = fastembed_topk_half(
+        static_cast<const float *>(buf_q.ptr),
+        static_cast<const uint16_t *>(buf_c.ptr), format_code,
+        static_cast<int>(num_corpus), static_cast<int>(buf_q.shape[0]), k,
+        id_ptr, score_ptr, metric_code, threads);
+  }
+  if (count < 0) {
+    throw std::runtime_error("Failed to compute half-precision top-k");
+  }
+
+  return py::make_tuple(ids, scores);
+}
+
+// Execution provider names accepted by OnnxModel(execution_providers=...)
+static const struct {
+  const char *name;
+  int provider;
+} kExecutionProviders[] = {{"cpu", FASTEMBED_EP_CPU},
+                           {"cuda", FASTEMBED_EP_CUDA},
+                           {"tensorrt", FASTEMBED_EP_TENSORRT},
+                           {"coreml", FASTEMBED_EP_COREML},
+                           {"xnnpack", FASTEMBED_EP_XNNPACK}};
+
+// Graph optimization level names accepted by
+// OnnxModel(graph_optimization_level=...)
+static const struct {
+  const char *name;
+  int level;
+} kGraphOptLevels[] = {{"disable", FASTEMBED_GRAPH_OPT_DISABLE},
+                       {"basic", FASTEMBED_GRAPH_OPT_BASIC},
+                       {"extended", FASTEMBED_GRAPH_OPT_EXTENDED},
+                       {"all", FASTEMBED_GRAPH_OPT_ALL}};
+
+// Pooling mode names accepted by OnnxModel(pooling=...)
+static const struct {
+  const char *name;
+  int pooling;
+} kPoolingModes[] = {{"cls", FASTEMBED_POOLING_CLS},
+                     {"mean", FASTEMBED_POOLING_MEAN},
+                     {"max", FASTEMBED_POOLING_MAX},
+                     {"last_token", FASTEMBED_POOLING_LAST_TOKEN}};
+
+/**
+ * ONNX model opened with ONNX Runtime session options
+ *
+ * Sessions are shared: opening the same model with the same options reuses
+ * the loaded session. Inference runs without the GIL; a close() from another
+ * thread takes effect once running calls finish.
+ */
+class OnnxModel {
+private:
+  ModelHandle model_;
+
+  ModelHandle handle() const {
+    if (!model_) {
+      throw std::runtime_error("ONNX model is closed");
+    }
+    return model_;
+  }
+
+public:
+  OnnxModel(const std::string &model_path, int intra_op_threads = 0,
+            int inter_op_threads = 0,
+            const std::string &graph_optimization_level = "all",
+            bool enable_mem_pattern = true, bool enable_cpu_mem_arena = true,
+            const std::vector<std::string> &execution_providers = {},
+            int device_id = 0, const std::string &optimized_model_path = "",
+            const std::string &tokenizer_path = "",
+            const std::string &pooling = "cls") {
+    fastembed_onnx_options_t options;
+    fastembed_onnx_options_init(&options);
+    options.intra_op_threads = intra_op_threads;
+    options.inter_op_threads = inter_op_threads;
+    options.enable_mem_pattern = enable_mem_pattern ? 1 : 0;
+    options.enable_cpu_mem_arena = enable_cpu_mem_arena ? 1 : 0;
+    options.device_id = device_id;
+
+    options.graph_opt_level = -1;
+    for (const auto &level : kGraphOptLevels) {
+      if (graph_optimization_level == level.name) {
+        options.graph_opt_level = level.level;
+      }
+    }
+    if (options.graph_opt_level < 0) {
+      throw std::invalid_argument("Invalid graph_optimization_level (expected "
+                                  "'disable', 'basic', 'extended' or 'all')");
+    }
+
+    options.pooling = -1;
+    for (const auto &mode : kPoolingModes) {
+      if (pooling == mode.name) {
+        options.pooling = mode.pooling;
+      }
+    }
+    if (options.pooling < 0) {
+      throw std::invalid_argument("Invalid pooling (expected 'cls', 'mean', "
+                                  "'max' or 'last_token')");
+    }
+
+    if (execution_providers.size() > FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS) {
+      throw std::invalid_argument("Too many execution_providers");
+    }
+    for (const auto &name : execution_providers) {
+      int provider = -1;
+      for (const auto &known : kExecutionProviders) {
+        if (name == known.name) {
+          provider = known.provider;
+        }
+      }
+      if (provider < 0) {
+        throw std::invalid_argument("Unknown execution provider: " + name +
+                                    " (expected cpu, cuda, tensorrt, coreml "
+                                    "or xnnpack)");
+      }
+      options.execution_providers[options.num_execution_providers++] =
+          provider;
+    }
+
+    if (!optimized_model_path.empty()) {
+      options.optimized_model_path = optimized_model_path.c_str();
+    }
+    if (!tokenizer_path.empty()) {
+      options.tokenizer_path = tokenizer_path.c_str();
+    }
+
+    fastembed_model_t *model;
+    {
+      py::gil_scoped_release release;
+      model = fastembed_model_open_with_options(model_path.c_str(), &options);
+    }
+    if (!model) {
+      throw std::runtime_error(
+          onnx_error_message("Failed to open ONNX model " + model_path));
+    }
+    model_ = make_model_handle(model);
+  }
+
+  ~OnnxModel() { close(); }
+
+  OnnxModel(const OnnxModel &) = delete;
+  OnnxModel &operator=(const OnnxModel &) = delete;
+
+  py::array_t<float> generate_embedding(const std::string &text) {
+    ModelHandle model = handle();
+    int dimension = fastembed_model_get_dimension(model.get());
+
+    // Allocate output buffer
+    auto result = py::array_t<float>(dimension);
+    py::buffer_info buf = result.request();
+    float *ptr = static_cast<float *>(buf.ptr);
+
+    int status;
+    {
+      py::gil_scoped_release release;
+      status = fastembed_model_generate(model.get(), text.c_str(), ptr,
+                                        dimension);
+    }
+    if (status != 0) {
+      throw std::runtime_error(
+          onnx_error_message("Failed to generate ONNX embedding"));
+    }
+
+    return result;
+  }
+
+  py::object generate_batch(const py::object &texts, int threads = 0,
+                            bool return_statuses = false) {
+    return model_generate_batch(handle(), texts, threads, return_statuses);
+  }
+
+  void warmup() {
+    ModelHandle model = handle();
+    int status;
+    {
+      py::gil_scoped_release release;
+      status = fastembed_model_warmup(model.get());
+    }
+    if (status != 0) {
+      throw std::runtime_error(onnx_error_message("ONNX warmup failed"));
+    }
+  }
+
+  int get_dimension() const {
+    return fastembed_model_get_dimension(handle().get());
+  }
+
+  std::string get_execution_provider() const {
+    int provider = fastembed_model_get_execution_provider(handle().get());
+    for (const auto &known : kExecutionProviders) {
+      if (known.provider == provider) {
+        return known.name;
+      }
+    }
+    return "cpu";
+  }
+
+  void close() { model_.reset(); }
+};
+
+/**
+ * HnswIndex class: approximate nearest neighbour index (HNSW graph)
+ *
+ * Vectors get ids 0, 1, 2, ... in insertion order. Indexes opened with
+ * load(path, mmap=True) are read-only.
+ */
+class HnswIndex {
+private:
+  fastembed_hnsw_t *index_;
+
+  fastembed_hnsw_t *handle() const {
+    if (!index_) {
+      throw std::runtime_error("HNSW index is closed");
+    }
+    return index_;
+  }
+
+  explicit HnswIndex(fastembed_hnsw_t *index) : index_(index) {}
+
+public:
+  HnswIndex(int dimension, int m = FASTEMBED_HNSW_DEFAULT_M,
+            int ef_construction = FASTEMBED_HNSW_DEFAULT_EF_CONSTRUCTION,
+            int ef_search = FASTEMBED_HNSW_DEFAULT_EF_SEARCH,
+            const std::string &metric = "cosine", unsigned int seed = 0)
+      : index_(nullptr) {
+    fastembed_hnsw_options_t options;
+    fastembed_hnsw_options_init(&options);
+    options.m = m;
+    options.ef_construction = ef_construction;
+    options.ef_search = ef_search;
+    options.metric = parse_metric(metric);
+    options.seed = seed;
+
+    index_ = fastembed_hnsw_create(dimension, &options);
+    if (!index_) {
+      throw std::invalid_argument(
+          "Failed to create HNSW index (invalid dimension or options)");
+    }
+  }
+
+  static HnswIndex *load(const std::string &path, bool mmap = false) {
+    fastembed_hnsw_t *index = mmap ? fastembed_hnsw_load_mmap(path.c_str())
+                                   : fastembed_hnsw_load(path.c_str());
+    if (!index) {
+      throw std::runtime_error("Failed to load HNSW index " + path);
+    }
+    return new HnswIndex(index);
+  }
+
+  ~HnswIndex() { close(); }
+
+  HnswIndex(const HnswIndex &) = delete;
+  HnswIndex &operator=(const HnswIndex &) = delete;
+
+  py::array_t<int32_t>
+  add(py::array_t<float, py::array::c_style | py::array::forcecast> vectors,
+      int threads = 1) {
+    fastembed_hnsw_t *index = handle();
+    py::buffer_info buf = vectors.request();
+    if (buf.ndim < 1 || buf.ndim > 2 ||
+        buf.shape[buf.ndim - 1] != fastembed_hnsw_dimension(index)) {
+      throw std::runtime_error(
+          "vectors must be 1- or 2-dimensional with the index dimension");
+    }
+
+    py::ssize_t count = buf.ndim == 2 ? buf.shape[0] : 1;
+    auto ids = py::array_t<int32_t>(count);
+    if (fastembed_hnsw_add_batch(index, static_cast<const float *>(buf.ptr),
+                                 static_cast<int>(count),
+                                 static_cast<int *>(ids.request().ptr),
+                                 threads) != 0) {
+      throw std::runtime_error(
+          "Failed to add vectors (read-only index or out of memory)");
+    }
+    return ids;
+  }
+
+  bool remove(int id) { return fastembed_hnsw_remove(handle(), id) == 0; }
+
+  py::tuple
+  search(py::array_t<float, py::array::c_style | py::array::forcecast> query,
+         int k) {
+    fastembed_hnsw_t *index = handle();
+    py::buffer_info buf = query.request();
+    if (buf.ndim != 1 || buf.shape[0] != fastembed_hnsw_dimension(index)) {
+      throw std::runtime_error(
+          "query must be 1-dimensional with the index dimension");
+    }
+    if (k <= 0) {
+      throw std::runtime_error("k must be positive");
+    }
+
+    int size = fastembed_hnsw_size(index);
+    int capacity = k < size ? k : size;
+    auto ids = py::array_t<int32_t>(capacity);
+    auto scores = py::array_t<float>(capacity);
+    int count = 0;
+    if (capacity > 0) {
+      count = fastembed_hnsw_search(
+          index, static_cast<const float *>(buf.ptr), capacity,
+          static_cast<int *>(ids.request().ptr),
+          static_cast<float *>(scores.request().ptr));
+      if (count < 0) {
+        throw std::runtime_error("Failed to search HNSW index");
+      }
+    }
+    if (count < capacity) {
+      ids.resize({static_cast<py::ssize_t>(count)});
+      scores.resize({static_cast<py::ssize_t>(count)});
+    }
+    return py::make_tuple(ids, scores);
+  }
+
+  void set_ef_search(int ef) {
+    if (fastembed_hnsw_set_ef_search(handle(), ef) != 0) {
+      throw std::invalid_argument("ef_search must be positive");
+    }
+  }
+
+  void save(const std::string &path) {
+    if (fastembed_hnsw_save(handle(), path.c_str()) != 0) {
+      throw std::runtime_error("Failed to save HNSW index " + path);
+    }
+  }
+
+  int size() const { return fastembed_hnsw_size(handle()); }
+
+  int get_dimension() const { return fastembed_hnsw_dimension(handle()); }
+
+  void close() {
+    if (index_) {
+      fastembed_hnsw_free(index_);
+      index_ = nullptr;
+    }
+  }
+};
+
 /**
  * FastEmbedNative class for high-level API
  */
@@ -244,6 +1423,11 @@ public:
     return ::generate_embedding(text, dimension_);
   }
 
+  py::object generate_batch(const py::object &texts, int threads = 0,
+                            bool return_statuses = false) {
+    return ::generate_batch(texts, dimension_, threads, return_statuses);
+  }
+
   float cosine_similarity(py::array_t<float> vector_a,
                           py::array_t<float> vector_b) {
     return ::cosine_similarity(vector_a, vector_b);
@@ -284,6 +1468,11 @@ PYBIND11_MODULE(fastembed_native, m) {
         "Generate embedding from text", py::arg("text"),
         py::arg("dimension") = 768);
 
+  m.def("generate_batch", &generate_batch,
+        "Generate embeddings for many texts into one (N, dimension) array",
+        py::arg("texts"), py::arg("dimension") = 768, py::arg("threads") = 0,
+        py::arg("return_statuses") = false);
+
   m.def("cosine_similarity", &cosine_similarity,
         "Calculate cosine similarity between two vectors", py::arg("vector_a"),
         py::arg("vector_b"));
@@ -300,12 +1489,87 @@ PYBIND11_MODULE(fastembed_native, m) {
   m.def("add_vectors", &add_vectors, "Add two vectors element-wise",
         py::arg("vector_a"), py::arg("vector_b"));
 
+  m.def("similarity_matrix", &similarity_matrix,
+        "Score every query row against every corpus row", py::arg("queries"),
+        py::arg("corpus"), py::arg("metric") = "cosine",
+        py::arg("threads") = 1);
+
+  m.def("topk", &topk,
+        "Find the k corpus rows most similar to a query (ids, scores)",
+        py::arg("query"), py::arg("corpus"), py::arg("k"),
+        py::arg("metric") = "cosine", py::arg("threads") = 1);
+
+  m.def("quantize_int8", &quantize_int8,
+        "Quantize vectors to int8 with one scale per vector (codes, scales)",
+        py::arg("vectors"));
+
+  m.def("quantize_binary", &quantize_binary,
+        "Binarize vectors to packed sign bits", py::arg("vectors"));
+
+  m.def("topk_int8", &topk_int8,
+        "Find the k int8-quantized rows with the highest dot product (ids, "
+        "scores)",
+        py::arg("query_codes"), py::arg("query_scale"),
+        py::arg("corpus_codes"), py::arg("corpus_scales"), py::arg("k"),
+        py::arg("threads") = 1);
+
+  m.def("topk_binary", &topk_binary,
+        "Find the k binary-quantized rows nearest in Hamming distance (ids, "
+        "distances)",
+        py::arg("query_bits"), py::arg("corpus_bits"), py::arg("dimension"),
+        py::arg("k"), py::arg("threads") = 1);
+
+  m.def("rescore", &rescore,
+        "Rerank candidate corpus rows with exact float scores (ids, scores)",
+        py::arg("query"), py::arg("corpus"), py::arg("candidates"),
+        py::arg("k"), py::arg("metric") = "cosine");
+
+  m.def("to_half", &to_half,
+        "Convert vectors to fp16 / bf16 bit patterns (uint16)",
+        py::arg("vectors"), py::arg("format") = "fp16");
+
+  m.def("from_half", &from_half,
+        "Widen fp16 / bf16 bit patterns (uint16) to float32",
+        py::arg("halves"), py::arg("format") = "fp16");
+
+  m.def("similarity_matrix_half", &similarity_matrix_half,
+        "Score float queries against a half-precision corpus",
+        py::arg("queries"), py::arg("corpus"), py::arg("format"),
+        py::arg("metric") = "cosine", py::arg("threads") = 1);
+
+  m.def("topk_half", &topk_half,
+        "Find the k half-precision corpus rows most similar to a query "
+        "(ids, scores)",
+        py::arg("query"), py::arg("corpus"), py::arg("format"), py::arg("k"),
+        py::arg("metric") = "cosine", py::arg("threads") = 1);
+
   m.def("generate_onnx_embedding", &generate_onnx_embedding,
         "Generate ONNX embedding from text", py::arg("model_path"),
         py::arg("text"), py::arg("dimension") = 768);
 
+  m.def("onnx_generate_batch", &onnx_generate_batch,
+        "Generate ONNX embeddings for many texts into one (N, dimension) "
+        "array",
+        py::arg("model_path"), py::arg("texts"), py::arg("threads") = 0,
+        py::arg("return_statuses") = false);
+
   m.def("unload_onnx_model", &unload_onnx_model,
         "Unload ONNX model from memory");
+  m.def("preload_onnx_model", &preload_onnx_model,
+        "Load an ONNX model and run warmup inferences ahead of the first "
+        "request",
+        py::arg("model_path"));
+
+  m.def("stats_snapshot", &stats_snapshot,
+        "Per-stage latency histograms (ns) and batch counters as a dict");
+  m.def("stats_snapshot_json", &stats_snapshot_json,
+        "Per-stage latency histograms and batch counters as JSON text");
+  m.def("stats_reset", &fastembed_stats_reset,
+        "Zero all instrumentation counters");
+  m.def(
+      "stats_set_enabled",
+      [](bool enabled) { fastembed_stats_set_enabled(enabled ? 1 : 0); },
+      "Turn instrumentation on or off (on by default)", py::arg("enabled"));
 
   // FastEmbedNative class
   py::class_<FastEmbedNative>(m, "FastEmbedNative")
@@ -313,6 +1577,10 @@ PYBIND11_MODULE(fastembed_native, m) {
            py::arg("dimension") = 768)
       .def("generate_embedding", &FastEmbedNative::generate_embedding,
            "Generate embedding from text", py::arg("text"))
+      .def("generate_batch", &FastEmbedNative::generate_batch,
+           "Generate embeddings for many texts into one (N, dimension) array",
+           py::arg("texts"), py::arg("threads") = 0,
+           py::arg("return_statuses") = false)
       .def("cosine_similarity", &FastEmbedNative::cosine_similarity,
            "Calculate cosine similarity", py::arg("vector_a"),
            py::arg("vector_b"))
@@ -332,6 +1600,79 @@ PYBIND11_MODULE(fastembed_native, m) {
       .def_property_readonly("dimension", &FastEmbedNative::get_dimension,
                              "Get embedding dimension");
 
+  // OnnxModel class
+  py::class_<OnnxModel>(m, "OnnxModel")
+      .def(py::init<const std::string &, int, int, const std::string &, bool,
+                    bool, const std::vector<std::string> &, int,
+                    const std::string &, const std::string &,
+                    const std::string &>(),
+           "Open an ONNX model with ONNX Runtime session options",
+           py::arg("model_path"), py::arg("intra_op_threads") = 0,
+           py::arg("inter_op_threads") = 0,
+           py::arg("graph_optimization_level") = "all",
+           py::arg("enable_mem_pattern") = true,
+           py::arg("enable_cpu_mem_arena") = true,
+           py::arg("execution_providers") = std::vector<std::string>(),
+           py::arg("device_id") = 0, py::arg("optimized_model_path") = "",
+           py::arg("tokenizer_path") = "", py::arg("pooling") = "cls")
+      .def("generate_embedding", &OnnxModel::generate_embedding,
+           "Generate ONNX embedding from text", py::arg("text"))
+      .def("generate_batch", &OnnxModel::generate_batch,
+           "Generate ONNX embeddings for many texts into one (N, dimension) "
+           "array",
+           py::arg("texts"), py::arg("threads") = 0,
+           py::arg("return_statuses") = false)
+      .def("warmup", &OnnxModel::warmup,
+           "Run warmup inferences so the first request does not pay ONNX "
+           "Runtime's first-run setup")
+      .def("close", &OnnxModel::close, "Release the model handle")
+      .def("__enter__", [](OnnxModel &self) -> OnnxModel & { return self; },
+           py::return_value_policy::reference)
+      .def("__exit__",
+           [](OnnxModel &self, py::object, py::object, py::object) {
+             self.close();
+           })
+      .def_property_readonly("dimension", &OnnxModel::get_dimension,
+                             "Get model output dimension")
+      .def_property_readonly("execution_provider",
+                             &OnnxModel::get_execution_provider,
+                             "Execution provider the session runs on");
+
+  // HnswIndex class
+  py::class_<HnswIndex>(m, "HnswIndex")
+      .def(py::init<int, int, int, int, const std::string &, unsigned int>(),
+           "Create an empty HNSW index", py::arg("dimension"),
+           py::arg("m") = FASTEMBED_HNSW_DEFAULT_M,
+           py::arg("ef_construction") = FASTEMBED_HNSW_DEFAULT_EF_CONSTRUCTION,
+           py::arg("ef_search") = FASTEMBED_HNSW_DEFAULT_EF_SEARCH,
+           py::arg("metric") = "cosine", py::arg("seed") = 0)
+      .def_static("load", &HnswIndex::load,
+                  "Load an index written by save() (mmap=True maps it "
+                  "read-only)",
+                  py::arg("path"), py::arg("mmap") = false)
+      .def("add", &HnswIndex::add,
+           "Add one vector or an [n, dimension] array; returns the ids",
+           py::arg("vectors"), py::arg("threads") = 1)
+      .def("remove", &HnswIndex::remove,
+           "Remove a vector from search results", py::arg("id"))
+      .def("search", &HnswIndex::search,
+           "Find approximately the k nearest vectors (ids, scores)",
+           py::arg("query"), py::arg("k"))
+      .def("set_ef_search", &HnswIndex::set_ef_search,
+           "Set the search candidate list size", py::arg("ef"))
+      .def("save", &HnswIndex::save, "Write the index to a file",
+           py::arg("path"))
+      .def("close", &HnswIndex::close, "Free the index")
+      .def("__len__", &HnswIndex::size)
+      .def("__enter__", [](HnswIndex &self) -> HnswIndex & { return self; },
+           py::return_value_policy::reference)
+      .def("__exit__",
+           [](HnswIndex &self, py::object, py::object, py::object) {
+             self.close();
+           })
+      .def_property_readonly("dimension", &HnswIndex::get_dimension,
+                             "Get vector dimension");
+
   // Version info
   m.attr("__version__") = "1.0.0";
 }
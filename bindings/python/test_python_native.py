@@ -159,14 +159,41 @@ try:
     print(f"  Text: {special_text}")
     print(f"  Embedding shape: {special_emb.shape}\n")
     
+    # Test 16: Batch generation into one matrix
+    print("16. Testing generate_batch...")
+    start = time.time()
+    batch = fastembed.generate_batch(texts)
+    elapsed = (time.time() - start) * 1000
+    assert batch.shape == (iterations, 768) and batch.dtype == np.float32
+    for i in (0, iterations // 2, iterations - 1):
+        assert np.array_equal(batch[i], fastembed.generate_embedding(texts[i]))
+    array_batch = fastembed.generate_batch(np.array(texts[:10]))
+    assert np.array_equal(array_batch, batch[:10])
+    print(f"✓ Batch of {iterations} generated in {elapsed:.2f}ms")
+    print(f"  Shape: {batch.shape}")
+    print(f"  Rows match generate_embedding, NumPy str arrays accepted\n")
+    
+    # Test 17: Batch error handling
+    print("17. Testing generate_batch error handling (empty string)...")
+    try:
+        fastembed.generate_batch(["ok", ""])
+        print("✗ Should have raised error for empty string in batch")
+        sys.exit(1)
+    except ValueError as e:
+        print(f"✓ Correctly raises error for empty string in batch")
+        print(f"  Error message: {str(e)}")
+    embs, statuses = fastembed.generate_batch(["ok", ""], return_statuses=True)
+    assert list(statuses) == [0, -3] and not embs[1].any()
+    print(f"  return_statuses=True: statuses {list(statuses)}\n")
+    
     print("=" * 60)
-    print("ALL TESTS PASSED ✓ (15/15)")
+    print("ALL TESTS PASSED ✓ (17/17)")
     print("=" * 60)
     print("\nFastEmbed Python native module is working correctly!")
     print(f"Performance: ~{avg_time:.1f}ms per embedding (native speed)")
     print("\nTest coverage:")
-    print("  • Happy path: 8 tests")
-    print("  • Error handling: 4 tests")
+    print("  • Happy path: 9 tests")
+    print("  • Error handling: 5 tests")
     print("  • Edge cases: 3 tests")
     
 except ImportError as e:
@@ -162,116 +162,1885 @@ FASTEMBED_EXPORT float fastembed_cosine_similarity(const float *vec1,
                                                    const float *vec2,
                                                    int dimension);
 
+/**
+ * @brief Cosine similarity of two vectors that are already unit length
+ *
+ * Fast path for L2-normalized embeddings (fastembed_normalize() output and
+ * every ONNX embedding): the similarity reduces to the dot product, so only
+ * one reduction is computed.
+ *
+ * @param vec1 First vector (read-only, must have norm 1)
+ * @param vec2 Second vector (read-only, must have norm 1)
+ * @param dimension Number of elements in vectors (must match for both)
+ * @return Cosine similarity (-1.0 to 1.0), or 0.0f on error (invalid
+ * parameters)
+ *
+ * @note Inputs are not checked for unit length; use
+ *       fastembed_cosine_similarity() for arbitrary vectors
+ */
+FASTEMBED_EXPORT float fastembed_cosine_similarity_normalized(const float *vec1,
+                                                              const float *vec2,
+                                                              int dimension);
+
 /**
  * @brief Calculate L2 (Euclidean) norm of a vector
  *
- * Computes the Euclidean norm (magnitude) of a vector:
- * norm = sqrt(Σ(vec[i]²)) for i = 0..dimension-1
+ * Computes the Euclidean norm (magnitude) of a vector:
+ * norm = sqrt(Σ(vec[i]²)) for i = 0..dimension-1
+ *
+ * Uses SIMD-optimized assembly implementation for maximum performance.
+ *
+ * @param vec Input vector (read-only)
+ * @param dimension Number of elements in vector
+ * @return L2 norm (always >= 0.0), or 0.0f on error (invalid parameters)
+ *
+ * @note Zero vector returns 0.0 norm
+ * @note Performance: O(dimension), optimized with SIMD
+ */
+FASTEMBED_EXPORT float fastembed_vector_norm(const float *vec, int dimension);
+
+/**
+ * @brief Normalize vector to unit length (L2 normalization)
+ *
+ * Normalizes vector in-place to unit length by dividing each element
+ * by the vector's L2 norm. Resulting vector has norm = 1.0.
+ *
+ * If input vector has zero norm, normalization is skipped (no change).
+ *
+ * Uses SIMD-optimized assembly implementation for maximum performance.
+ *
+ * @param vec Vector to normalize (modified in-place)
+ * @param dimension Number of elements in vector
+ *
+ * @note Operation is in-place: original vector is modified
+ * @note Zero vectors remain unchanged (no division by zero)
+ * @note Performance: O(dimension), optimized with SIMD
+ */
+FASTEMBED_EXPORT void fastembed_normalize(float *vec, int dimension);
+
+/**
+ * @brief Add two vectors element-wise
+ *
+ * Performs element-wise addition: result[i] = vec1[i] + vec2[i]
+ * for all i in [0, dimension-1].
+ *
+ * Uses SIMD-optimized assembly implementation for maximum performance.
+ *
+ * @param vec1 First vector (read-only)
+ * @param vec2 Second vector (read-only)
+ * @param result Output vector for result (must be pre-allocated, size >=
+ * dimension)
+ * @param dimension Number of elements in vectors (must match for all three)
+ *
+ * @note All vectors must have the same dimension
+ * @note Result vector must be pre-allocated (not computed in-place)
+ * @note Performance: O(dimension), optimized with SIMD
+ */
+FASTEMBED_EXPORT void fastembed_add_vectors(const float *vec1,
+                                            const float *vec2, float *result,
+                                            int dimension);
+
+/**
+ * @brief SIMD instruction sets used by the vector operations
+ *
+ * On x86-64 the best level supported by the CPU and OS is selected with
+ * CPUID on the first vector call; the values are ordered so that a higher
+ * level implies the lower x86 ones.
+ */
+typedef enum {
+  FASTEMBED_SIMD_SCALAR = 0, /**< Portable C (USE_ONLY_C builds) */
+  FASTEMBED_SIMD_SSE = 1,    /**< SSE (x86-64 baseline) */
+  FASTEMBED_SIMD_NEON = 2,   /**< ARM64 NEON */
+  FASTEMBED_SIMD_AVX2 = 3,   /**< AVX2 + FMA, 8 floats per instruction */
+  FASTEMBED_SIMD_AVX512 = 4  /**< AVX-512F, 16 floats per instruction */
+} fastembed_simd_level_t;
+
+/**
+ * @brief Get the SIMD level used by the vector operations
+ *
+ * Runs CPU detection if no vector operation has been called yet.
+ *
+ * @return Active fastembed_simd_level_t value
+ */
+FASTEMBED_EXPORT int fastembed_get_simd_level(void);
+
+/**
+ * @brief Cap the SIMD level used by the vector operations
+ *
+ * Installs the best kernels that are both supported by the CPU and not above
+ * @p level, e.g. FASTEMBED_SIMD_SSE forces the SSE kernels for benchmarking
+ * or to avoid AVX-512 frequency throttling. Passing FASTEMBED_SIMD_AVX512
+ * restores automatic selection. Has no effect on ARM64 and C-only builds.
+ *
+ * @param level Maximum fastembed_simd_level_t value
+ * @return Level actually installed, or -1 if level is out of range
+ *
+ * @note Not synchronized with vector operations running on other threads;
+ *       call it during initialization
+ */
+FASTEMBED_EXPORT int fastembed_set_simd_level(int level);
+
+/**
+ * @brief Metrics for fastembed_similarity_matrix() and fastembed_topk()
+ */
+typedef enum {
+  FASTEMBED_METRIC_DOT = 0,      /**< Dot product (cosine for unit vectors) */
+  FASTEMBED_METRIC_COSINE = 1,   /**< Cosine similarity (0 for zero vectors) */
+  FASTEMBED_METRIC_EUCLIDEAN = 2 /**< Euclidean (L2) distance */
+} fastembed_metric_t;
+
+/**
+ * @brief Score every query against every corpus vector
+ *
+ * Computes out[q * num_corpus + c] = metric(queries[q], corpus[c]) for
+ * row-major matrices in one call. Scoring one query against a collection is
+ * the num_queries = 1 case.
+ *
+ * The corpus is processed in cache-sized blocks (FASTEMBED_SIMILARITY_BLOCK_
+ * BYTES) that are reused across all queries, and each query element is
+ * multiplied with four corpus rows per load using the SIMD kernels.
+ *
+ * @param queries Row-major [num_queries x dimension] matrix
+ * @param num_queries Number of query vectors
+ * @param corpus Row-major [num_corpus x dimension] matrix
+ * @param num_corpus Number of corpus vectors
+ * @param dimension Vector dimension (same for queries and corpus)
+ * @param out Row-major [num_queries x num_corpus] output (pre-allocated)
+ * @param metric fastembed_metric_t
+ * @return 0 on success, -1 on error (invalid parameters, allocation failure)
+ *
+ * @note For L2-normalized embeddings FASTEMBED_METRIC_DOT equals cosine and
+ *       skips the norm pass
+ * @note Euclidean distances are derived from norms and dot products, so
+ *       distances between almost identical vectors lose relative precision
+ */
+FASTEMBED_EXPORT int fastembed_similarity_matrix(const float *queries,
+                                                 int num_queries,
+                                                 const float *corpus,
+                                                 int num_corpus, int dimension,
+                                                 float *out, int metric);
+
+/**
+ * @brief fastembed_similarity_matrix() split over multiple threads
+ *
+ * Corpus rows are divided into contiguous ranges, one per thread. Small
+ * matrices use fewer threads (FASTEMBED_SIMILARITY_MIN_WORK_PER_THREAD), so
+ * a large num_threads is safe to pass for any size.
+ *
+ * @param num_threads Maximum threads (0 = whole pool, 1 = calling thread
+ * only)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_similarity_matrix_threaded(
+    const float *queries, int num_queries, const float *corpus, int num_corpus,
+    int dimension, float *out, int metric, int num_threads);
+
+/**
+ * @brief Find the k corpus vectors with the highest cosine similarity
+ *
+ * Exact (brute-force) search: every row is scored with the SIMD kernels and
+ * offered to a bounded min-heap, so memory use is O(k) regardless of
+ * num_corpus. Results are sorted best first; ties go to the lower row index.
+ *
+ * @param query Query vector [dimension]
+ * @param corpus Row-major [num_corpus x dimension] matrix
+ * @param num_corpus Number of corpus vectors
+ * @param dimension Vector dimension
+ * @param k Number of results wanted
+ * @param out_ids Output row indices [k] (pre-allocated)
+ * @param out_scores Output scores [k] (pre-allocated)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk(const float *query, const float *corpus,
+                                    int num_corpus, int dimension, int k,
+                                    int *out_ids, float *out_scores);
+
+/**
+ * @brief fastembed_topk() with a metric, split over multiple threads
+ *
+ * Each thread keeps its own heap over a contiguous range of rows; the
+ * heaps are merged at the end, so results do not depend on num_threads.
+ * FASTEMBED_METRIC_EUCLIDEAN returns the nearest rows (smallest distances).
+ *
+ * @param metric fastembed_metric_t
+ * @param num_threads Maximum threads (0 = whole pool, 1 = calling thread
+ * only)
+ * @return Number of results written, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_threaded(const float *query,
+                                             const float *corpus,
+                                             int num_corpus, int dimension,
+                                             int k, int *out_ids,
+                                             float *out_scores, int metric,
+                                             int num_threads);
+
+/**
+ * @brief Output formats for quantized embeddings
+ */
+typedef enum {
+  FASTEMBED_QUANT_NONE = 0,   /**< float, unquantized (embedding stores) */
+  FASTEMBED_QUANT_INT8 = 1,   /**< int8 codes + one float scale per vector */
+  FASTEMBED_QUANT_BINARY = 2, /**< One sign bit per dimension, LSB first */
+  FASTEMBED_QUANT_FP16 = 3,   /**< IEEE half precision, uint16_t per value */
+  FASTEMBED_QUANT_BF16 = 4    /**< bfloat16 (top half of a float) */
+} fastembed_quantization_t;
+
+/**
+ * @brief Bytes per binary-quantized vector of the given dimension
+ */
+#define FASTEMBED_BINARY_BYTES(dimension) (((dimension) + 7) / 8)
+
+/**
+ * @brief Quantize float vectors to int8 with one scale per vector
+ *
+ * Symmetric scalar quantization: scale = max|x| / 127 and code =
+ * round(x / scale), so x ~ code * scale with codes in [-127, 127]. Rows
+ * take dimension bytes instead of 4 * dimension.
+ *
+ * @param vectors Row-major [num_vectors x dimension] floats
+ * @param num_vectors Number of vectors
+ * @param dimension Vector dimension
+ * @param out_codes Output [num_vectors x dimension] codes (pre-allocated)
+ * @param out_scales Output [num_vectors] scales (0 for zero vectors)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_quantize_int8(const float *vectors,
+                                             int num_vectors, int dimension,
+                                             int8_t *out_codes,
+                                             float *out_scales);
+
+/**
+ * @brief Reconstruct float vectors from int8 codes
+ *
+ * @param codes Row-major [num_vectors x dimension] codes
+ * @param scales Per-vector scales [num_vectors]
+ * @param num_vectors Number of vectors
+ * @param dimension Vector dimension
+ * @param out_vectors Output [num_vectors x dimension] floats (code * scale)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_dequantize_int8(const int8_t *codes,
+                                               const float *scales,
+                                               int num_vectors, int dimension,
+                                               float *out_vectors);
+
+/**
+ * @brief Binarize float vectors to packed sign bits
+ *
+ * Bit i (byte i / 8, bit i % 8) is set when component i is positive.
+ * Rows take FASTEMBED_BINARY_BYTES(dimension) bytes, 1/32 of float32, and
+ * are compared with fastembed_hamming_distance().
+ *
+ * @param vectors Row-major [num_vectors x dimension] floats
+ * @param num_vectors Number of vectors
+ * @param dimension Vector dimension
+ * @param out_bits Output [num_vectors x FASTEMBED_BINARY_BYTES(dimension)]
+ * bytes (pre-allocated)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_quantize_binary(const float *vectors,
+                                               int num_vectors, int dimension,
+                                               uint8_t *out_bits);
+
+/**
+ * @brief Exact dot product of two int8 vectors
+ *
+ * SIMD dispatch: AVX-512 VNNI (vpdpbusd), AVX2 (vpmaddubsw), SSE2, NEON.
+ * Multiply by both scales to approximate the float dot product.
+ *
+ * @param vec1 First vector
+ * @param vec2 Second vector; values must be in [-127, 127] (as produced
+ * by fastembed_quantize_int8())
+ * @param dimension Number of elements
+ * @return Sum of vec1[i] * vec2[i], or 0 on error
+ */
+FASTEMBED_EXPORT int32_t fastembed_int8_dot_product(const int8_t *vec1,
+                                                    const int8_t *vec2,
+                                                    int dimension);
+
+/**
+ * @brief Number of differing bits between two packed bit vectors
+ *
+ * SIMD dispatch: AVX-512 VPOPCNTDQ, POPCNT, NEON cnt, SWAR fallback.
+ *
+ * @param bits1 First bit vector
+ * @param bits2 Second bit vector
+ * @param num_bytes Bytes per vector (FASTEMBED_BINARY_BYTES(dimension))
+ * @return Hamming distance, or -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_hamming_distance(const uint8_t *bits1,
+                                                const uint8_t *bits2,
+                                                int num_bytes);
+
+/**
+ * @brief Generate a hash-based embedding in quantized form
+ *
+ * Same embedding as fastembed_generate(), quantized with
+ * fastembed_quantize_int8(), fastembed_quantize_binary(),
+ * fastembed_f32_to_f16() or fastembed_f32_to_bf16().
+ *
+ * @param text Input text
+ * @param output int8_t[dimension] for FASTEMBED_QUANT_INT8,
+ * uint8_t[FASTEMBED_BINARY_BYTES(dimension)] for FASTEMBED_QUANT_BINARY,
+ * uint16_t[dimension] for FASTEMBED_QUANT_FP16 / FASTEMBED_QUANT_BF16
+ * @param scale Output scale (int8; may be NULL otherwise)
+ * @param dimension Embedding dimension (0 = default)
+ * @param quantization fastembed_quantization_t
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_generate_quantized(const char *text,
+                                                  void *output, float *scale,
+                                                  int dimension,
+                                                  int quantization);
+
+/**
+ * @brief Generate an ONNX embedding in quantized form
+ *
+ * Same embedding as fastembed_onnx_generate() (L2-normalized), quantized
+ * as in fastembed_generate_quantized().
+ *
+ * @param model_path Path to .onnx model file
+ * @param text Input text
+ * @param output int8_t[dimension], uint8_t[FASTEMBED_BINARY_BYTES(
+ * dimension)] or uint16_t[dimension]
+ * @param scale Output scale (int8; may be NULL otherwise)
+ * @param dimension Model output dimension (0 = auto-detect)
+ * @param quantization fastembed_quantization_t
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_onnx_generate_quantized(const char *model_path,
+                                                       const char *text,
+                                                       void *output,
+                                                       float *scale,
+                                                       int dimension,
+                                                       int quantization);
+
+/**
+ * @brief Find the k int8-quantized rows with the highest dot product
+ *
+ * Scores are dot products of the dequantized vectors (cosine similarity
+ * for quantized unit vectors). Threading as in fastembed_topk_threaded().
+ *
+ * @param query_codes Query codes [dimension]
+ * @param query_scale Query scale
+ * @param corpus_codes Row-major [num_corpus x dimension] codes
+ * @param corpus_scales Per-row scales [num_corpus]
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension
+ * @param k Number of results wanted
+ * @param out_ids Output row indices, best first [k]
+ * @param out_scores Output scores [k]
+ * @param num_threads Maximum threads (0 = whole pool)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_int8(const int8_t *query_codes,
+                                         float query_scale,
+                                         const int8_t *corpus_codes,
+                                         const float *corpus_scales,
+                                         int num_corpus, int dimension, int k,
+                                         int *out_ids, float *out_scores,
+                                         int num_threads);
+
+/**
+ * @brief Find the k binary-quantized rows nearest in Hamming distance
+ *
+ * Ties go to the lower row index. Typically used for a shortlist of a few
+ * times k that fastembed_topk_rescore() reranks with the float vectors.
+ *
+ * @param query_bits Query bits [FASTEMBED_BINARY_BYTES(dimension)]
+ * @param corpus_bits Row-major bits, FASTEMBED_BINARY_BYTES(dimension) per
+ * row
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension (bits per row)
+ * @param k Number of results wanted
+ * @param out_ids Output row indices, nearest first [k]
+ * @param out_distances Output Hamming distances [k]
+ * @param num_threads Maximum threads (0 = whole pool)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_binary(const uint8_t *query_bits,
+                                           const uint8_t *corpus_bits,
+                                           int num_corpus, int dimension,
+                                           int k, int *out_ids,
+                                           int *out_distances,
+                                           int num_threads);
+
+/**
+ * @brief Rerank a shortlist of corpus rows with exact float scores
+ *
+ * Scores only the candidate rows (e.g. from fastembed_topk_binary()) and
+ * returns the best k of them, with the ordering and scores of
+ * fastembed_topk_threaded().
+ *
+ * @param query Query vector [dimension]
+ * @param corpus Row-major [num_corpus x dimension] matrix
+ * @param num_corpus Number of corpus rows (bounds for candidate_ids)
+ * @param dimension Vector dimension
+ * @param candidate_ids Distinct corpus row indices [num_candidates]
+ * @param num_candidates Number of candidates
+ * @param k Number of results wanted
+ * @param out_ids Output corpus row indices, best first [k]
+ * @param out_scores Output scores (distances for Euclidean) [k]
+ * @param metric fastembed_metric_t
+ * @return Number of results written (min(k, num_candidates)), -1 on error
+ * (including candidate ids outside [0, num_corpus))
+ */
+FASTEMBED_EXPORT int fastembed_topk_rescore(const float *query,
+                                            const float *corpus,
+                                            int num_corpus, int dimension,
+                                            const int *candidate_ids,
+                                            int num_candidates, int k,
+                                            int *out_ids, float *out_scores,
+                                            int metric);
+
+/**
+ * @brief Convert floats to IEEE half precision (round to nearest even)
+ *
+ * Uses F16C / AVX-512 / NEON when available. Out-of-range values become
+ * infinity and NaNs stay NaNs.
+ *
+ * @param input Floats [count]
+ * @param output Half-precision values [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_f32_to_f16(const float *input,
+                                          uint16_t *output, int count);
+
+/**
+ * @brief Convert IEEE half-precision values to floats (exact)
+ *
+ * @param input Half-precision values [count]
+ * @param output Floats [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_f16_to_f32(const uint16_t *input,
+                                          float *output, int count);
+
+/**
+ * @brief Convert floats to bfloat16 (round to nearest even)
+ *
+ * bfloat16 keeps the float exponent range with an 8-bit mantissa.
+ *
+ * @param input Floats [count]
+ * @param output bfloat16 values [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_f32_to_bf16(const float *input,
+                                           uint16_t *output, int count);
+
+/**
+ * @brief Convert bfloat16 values to floats (exact)
+ *
+ * @param input bfloat16 values [count]
+ * @param output Floats [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_bf16_to_f32(const uint16_t *input,
+                                           float *output, int count);
+
+/**
+ * @brief Score float queries against a half-precision corpus
+ *
+ * Same result layout as fastembed_similarity_matrix_threaded(). Corpus
+ * blocks are widened to float in per-thread cache-sized buffers, so the
+ * corpus is read at 2 bytes per value.
+ *
+ * @param queries Row-major query vectors [num_queries * dimension]
+ * @param num_queries Number of queries
+ * @param corpus Row-major corpus [num_corpus * dimension]
+ * @param format FASTEMBED_QUANT_FP16 or FASTEMBED_QUANT_BF16
+ * @param num_corpus Number of corpus vectors
+ * @param dimension Vector dimension
+ * @param out Output matrix [num_queries * num_corpus]
+ * @param metric fastembed_metric_t
+ * @param num_threads Worker threads (0 = whole pool, 1 = calling thread)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_similarity_matrix_half(
+    const float *queries, int num_queries, const uint16_t *corpus, int format,
+    int num_corpus, int dimension, float *out, int metric, int num_threads);
+
+/**
+ * @brief Find the k half-precision rows most similar to a float query
+ *
+ * Same results as fastembed_topk_threaded() on the widened corpus.
+ *
+ * @param query Query vector [dimension]
+ * @param corpus Row-major corpus [num_corpus * dimension]
+ * @param format FASTEMBED_QUANT_FP16 or FASTEMBED_QUANT_BF16
+ * @param num_corpus Number of corpus vectors
+ * @param dimension Vector dimension
+ * @param k Number of results wanted
+ * @param out_ids Output corpus row indices, best first [k]
+ * @param out_scores Output scores (distances for Euclidean) [k]
+ * @param metric fastembed_metric_t
+ * @param num_threads Worker threads (0 = whole pool, 1 = calling thread)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_half(const float *query,
+                                         const uint16_t *corpus, int format,
+                                         int num_corpus, int dimension, int k,
+                                         int *out_ids, float *out_scores,
+                                         int metric, int num_threads);
+
+/**
+ * @brief Opaque handle to an approximate nearest neighbour (HNSW) index
+ *
+ * Created with fastembed_hnsw_create() or loaded with fastembed_hnsw_load()
+ * / fastembed_hnsw_load_mmap(); free with fastembed_hnsw_free().
+ */
+typedef struct fastembed_hnsw fastembed_hnsw_t;
+
+/**
+ * @brief Parameters for fastembed_hnsw_create()
+ *
+ * Always initialize with fastembed_hnsw_options_init() before changing
+ * fields, so that new fields added in later versions get their defaults.
+ */
+typedef struct fastembed_hnsw_options {
+  /** Neighbours per node (2 * m on the bottom level, 2 -
+   * FASTEMBED_HNSW_MAX_M, default FASTEMBED_HNSW_DEFAULT_M). Higher values
+   * raise recall at the cost of memory and insert time. */
+  int m;
+  /** Candidate list size while inserting (default
+   * FASTEMBED_HNSW_DEFAULT_EF_CONSTRUCTION); larger builds a better graph
+   * more slowly */
+  int ef_construction;
+  /** Candidate list size while searching (default
+   * FASTEMBED_HNSW_DEFAULT_EF_SEARCH); see fastembed_hnsw_set_ef_search() */
+  int ef_search;
+  /** Distance (fastembed_metric_t, default FASTEMBED_METRIC_COSINE) */
+  int metric;
+  /** Seed for node levels; single-threaded inserts with the same seed build
+   * the same graph */
+  unsigned int seed;
+} fastembed_hnsw_options_t;
+
+/**
+ * @brief Initialize HNSW options with defaults
+ *
+ * @param options Options to initialize
+ */
+FASTEMBED_EXPORT void
+fastembed_hnsw_options_init(fastembed_hnsw_options_t *options);
+
+/**
+ * @brief Create an empty HNSW index
+ *
+ * The index grows as vectors are added; there is no capacity to reserve.
+ * Vectors are copied into the index (normalized for cosine).
+ *
+ * @param dimension Vector dimension (1 - FASTEMBED_MAX_DIMENSION)
+ * @param options Index parameters (NULL = defaults)
+ * @return Index on success, NULL on invalid parameters or allocation failure
+ *
+ * @note Thread safety: fastembed_hnsw_add(), fastembed_hnsw_remove() and
+ * fastembed_hnsw_search() may be called from many threads at once; searches
+ * never block on inserts
+ */
+FASTEMBED_EXPORT fastembed_hnsw_t *
+fastembed_hnsw_create(int dimension, const fastembed_hnsw_options_t *options);
+
+/**
+ * @brief Free an index (NULL is ignored)
+ *
+ * @param index Index to free; no other call may be using it
+ */
+FASTEMBED_EXPORT void fastembed_hnsw_free(fastembed_hnsw_t *index);
+
+/**
+ * @brief Add a vector to the index
+ *
+ * @param index Index returned by fastembed_hnsw_create() or
+ * fastembed_hnsw_load()
+ * @param vector Vector [dimension]
+ * @return Id of the new vector (ids are assigned 0, 1, 2, ... in insertion
+ * order), -1 on error (read-only index, allocation failure)
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_add(fastembed_hnsw_t *index,
+                                        const float *vector);
+
+/**
+ * @brief Add many vectors, split over multiple threads
+ *
+ * @param index Writable index
+ * @param vectors Row-major [num_vectors x dimension] matrix
+ * @param num_vectors Number of vectors
+ * @param out_ids Optional output ids [num_vectors] (NULL to ignore); with
+ * more than one thread ids are not in row order
+ * @param num_threads Maximum threads (0 = whole pool, 1 = calling thread
+ * only, which assigns consecutive ids)
+ * @return 0 on success, -1 if any vector could not be added
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_add_batch(fastembed_hnsw_t *index,
+                                              const float *vectors,
+                                              int num_vectors, int *out_ids,
+                                              int num_threads);
+
+/**
+ * @brief Remove a vector from search results
+ *
+ * The node stays in the graph (and in saved files) so the links through it
+ * keep working; its id is not reused.
+ *
+ * @param index Writable index
+ * @param id Id returned by fastembed_hnsw_add()
+ * @return 0 on success, -1 if the id is unknown or already removed, or the
+ * index is read-only
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_remove(fastembed_hnsw_t *index, int id);
+
+/**
+ * @brief Find approximately the k nearest vectors to a query
+ *
+ * @param index Index to search
+ * @param query Query vector [dimension]
+ * @param k Number of results wanted
+ * @param out_ids Output ids [k] (pre-allocated)
+ * @param out_scores Output scores [k] (pre-allocated): similarity for cosine
+ * / dot, L2 distance for Euclidean
+ * @return Number of results written, best first (fewer than k only if the
+ * index holds fewer vectors), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_search(fastembed_hnsw_t *index,
+                                           const float *query, int k,
+                                           int *out_ids, float *out_scores);
+
+/**
+ * @brief Set the candidate list size used by fastembed_hnsw_search()
+ *
+ * Searches use max(ef_search, k) candidates. Raise it for higher recall,
+ * lower it for faster queries; safe to change while searches run.
+ *
+ * @param index Index
+ * @param ef_search Candidate list size (> 0)
+ * @return 0 on success, -1 on invalid arguments
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_set_ef_search(fastembed_hnsw_t *index,
+                                                  int ef_search);
+
+/**
+ * @brief Number of vectors in the index (excluding removed ones)
+ *
+ * @return Vector count, -1 if index is NULL
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_size(const fastembed_hnsw_t *index);
+
+/**
+ * @brief Vector dimension of the index
+ *
+ * @return Dimension, -1 if index is NULL
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_dimension(const fastembed_hnsw_t *index);
+
+/**
+ * @brief Save an index to a file
+ *
+ * The file holds the vectors and the graph in native byte order and can be
+ * read back with fastembed_hnsw_load() or mapped with
+ * fastembed_hnsw_load_mmap().
+ *
+ * @param index Index to save
+ * @param path Output file path (overwritten)
+ * @return 0 on success, -1 on error (the partial file is removed)
+ *
+ * @note Must not run concurrently with fastembed_hnsw_add() /
+ * fastembed_hnsw_remove() on the same index; searches are fine
+ */
+FASTEMBED_EXPORT int fastembed_hnsw_save(fastembed_hnsw_t *index,
+                                         const char *path);
+
+/**
+ * @brief Load a saved index into memory
+ *
+ * @param path File written by fastembed_hnsw_save()
+ * @return Writable index, NULL on error (missing, truncated or corrupt file,
+ * file from a different byte order)
+ */
+FASTEMBED_EXPORT fastembed_hnsw_t *fastembed_hnsw_load(const char *path);
+
+/**
+ * @brief Map a saved index read-only without copying it
+ *
+ * Opens in time proportional to the number of nodes (the graph is
+ * validated) rather than the file size; pages are read on first access and
+ * shared between processes mapping the same file.
+ *
+ * @param path File written by fastembed_hnsw_save()
+ * @return Read-only index (fastembed_hnsw_add() / fastembed_hnsw_remove()
+ * return -1), NULL on error
+ *
+ * @note The file must not be modified while mapped
+ */
+FASTEMBED_EXPORT fastembed_hnsw_t *fastembed_hnsw_load_mmap(const char *path);
+
+/**
+ * @brief Embedding store flags (fastembed_store_writer_open())
+ */
+typedef enum {
+  /** Vectors are L2-normalized when appended (cosine = dot product) */
+  FASTEMBED_STORE_NORMALIZED = 1,
+  /** Every vector carries a caller-chosen int64 id */
+  FASTEMBED_STORE_IDS = 2
+} fastembed_store_flags_t;
+
+/**
+ * @brief Opaque append-only writer for an embedding store file
+ *
+ * Created with fastembed_store_writer_open(); finished (and freed) with
+ * fastembed_store_writer_close().
+ */
+typedef struct fastembed_store_writer fastembed_store_writer_t;
+
+/**
+ * @brief Opaque read-only view of a memory-mapped embedding store file
+ *
+ * Opened with fastembed_store_open(); free with fastembed_store_close().
+ */
+typedef struct fastembed_store fastembed_store_t;
+
+/**
+ * @brief Start writing an embedding store file
+ *
+ * The file is a versioned header (dimension, dtype, count, flags), a
+ * FASTEMBED_MATRIX_ALIGNMENT-aligned row-major vector block and, with
+ * FASTEMBED_STORE_IDS, an int64 id per vector. Vectors are streamed to disk
+ * as they are appended; the header is completed by
+ * fastembed_store_writer_close(), so an unfinished file never opens.
+ *
+ * @param path Destination file (replaced)
+ * @param dimension Vector dimension (1 to FASTEMBED_MAX_DIMENSION)
+ * @param dtype Stored element type: FASTEMBED_QUANT_NONE (float),
+ * FASTEMBED_QUANT_FP16 or FASTEMBED_QUANT_BF16
+ * @param flags Bitwise OR of fastembed_store_flags_t
+ * @return Writer, NULL on invalid arguments or if the file cannot be created
+ */
+FASTEMBED_EXPORT fastembed_store_writer_t *
+fastembed_store_writer_open(const char *path, int dimension, int dtype,
+                            int flags);
+
+/**
+ * @brief Append vectors to a store being written
+ *
+ * @param writer Writer returned by fastembed_store_writer_open()
+ * @param vectors Row-major float[num_vectors * dimension] (converted to the
+ * store dtype, normalized first with FASTEMBED_STORE_NORMALIZED)
+ * @param num_vectors Number of vectors (0 is a no-op)
+ * @param ids int64_t[num_vectors] ids; required with FASTEMBED_STORE_IDS,
+ * ignored otherwise
+ * @return 0 on success, -1 on invalid arguments (nothing is written) or a
+ * write error (the writer is then failed and fastembed_store_writer_close()
+ * removes the file)
+ */
+FASTEMBED_EXPORT int fastembed_store_writer_append(
+    fastembed_store_writer_t *writer, const float *vectors, int num_vectors,
+    const int64_t *ids);
+
+/**
+ * @brief Finish a store file and free the writer
+ *
+ * Writes the id table, then the completed header.
+ *
+ * @param writer Writer (may be NULL)
+ * @return 0 if the file is complete, -1 on error or if an append failed (the
+ * file is removed)
+ */
+FASTEMBED_EXPORT int
+fastembed_store_writer_close(fastembed_store_writer_t *writer);
+
+/**
+ * @brief Map an embedding store file read-only
+ *
+ * Only the header is read; vectors are paged in on first access and shared
+ * between processes mapping the same file. The pointers returned by
+ * fastembed_store_vectors() / fastembed_store_ids() go straight into
+ * fastembed_similarity_matrix(), fastembed_topk(), fastembed_topk_half() or
+ * fastembed_hnsw_add_batch().
+ *
+ * @param path File written by fastembed_store_writer_close()
+ * @return Store, NULL on error (missing, unfinished, truncated or corrupt
+ * file, file from a different byte order)
+ *
+ * @note The file must not be modified while mapped
+ */
+FASTEMBED_EXPORT fastembed_store_t *fastembed_store_open(const char *path);
+
+/**
+ * @brief Unmap a store (invalidates its vector and id pointers)
+ * @param store Store (may be NULL)
+ */
+FASTEMBED_EXPORT void fastembed_store_close(fastembed_store_t *store);
+
+/**
+ * @brief Number of vectors in a store
+ * @return Count, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_store_count(const fastembed_store_t *store);
+
+/**
+ * @brief Vector dimension of a store
+ * @return Dimension, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_store_dimension(const fastembed_store_t *store);
+
+/**
+ * @brief Stored element type
+ * @return FASTEMBED_QUANT_NONE, FASTEMBED_QUANT_FP16 or FASTEMBED_QUANT_BF16,
+ * -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_store_dtype(const fastembed_store_t *store);
+
+/**
+ * @brief Store flags
+ * @return Bitwise OR of fastembed_store_flags_t, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_store_flags(const fastembed_store_t *store);
+
+/**
+ * @brief Row-major vector block of a store
+ *
+ * @return FASTEMBED_MATRIX_ALIGNMENT-aligned float[count * dimension] or
+ * uint16_t[count * dimension] (FP16 / BF16), NULL on error
+ */
+FASTEMBED_EXPORT const void *
+fastembed_store_vectors(const fastembed_store_t *store);
+
+/**
+ * @brief Per-vector ids of a store
+ * @return int64_t[count], NULL if the store has no ids or on error
+ */
+FASTEMBED_EXPORT const int64_t *
+fastembed_store_ids(const fastembed_store_t *store);
+
+/**
+ * @brief Exact top-k search over a store
+ *
+ * Runs fastembed_topk_threaded() or fastembed_topk_half() on the mapped
+ * vectors, as matches the store dtype.
+ *
+ * @param store Store
+ * @param query float[dimension] query
+ * @param k Number of results
+ * @param out_ids int[k] output row indices (map to ids with
+ * fastembed_store_ids())
+ * @param out_scores float[k] output scores
+ * @param metric fastembed_metric_t
+ * @param num_threads Worker threads (0 = whole pool, 1 = calling thread)
+ * @return Number of results written (min(k, count)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_store_topk(const fastembed_store_t *store,
+                                          const float *query, int k,
+                                          int *out_ids, float *out_scores,
+                                          int metric, int num_threads);
+
+/**
+ * @brief Generate embedding using ONNX Runtime model
+ *
+ * Loads a trained ONNX embedding model (e.g., BERT-based, nomic-embed-text)
+ * and generates embeddings using neural network inference. This provides
+ * learned semantic embeddings as opposed to hash-based embeddings.
+ *
+ * The function performs tokenization, runs ONNX inference, extracts the
+ * [CLS] token embedding, and applies L2 normalization.
+ *
+ * **Performance Optimization:** The model session is cached in memory after
+ * the first call. Subsequent calls with the same model_path reuse the cached
+ * session, significantly improving performance (no model reload overhead).
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @param text Input text to embed (null-terminated string, max 8192 chars)
+ * @param output Output array for embedding vector (must be pre-allocated, size
+ * >= dimension)
+ * @param dimension Requested embedding dimension (must match model output, max
+ * 2048). If 0, automatically detects dimension from model.
+ * @return 0 on success, -1 on error (file not found, inference failure,
+ * dimension mismatch, etc.)
+ *
+ * @note Requires ONNX Runtime to be installed and linked at compile time
+ * @note Compile with -DUSE_ONNX_RUNTIME to enable ONNX support
+ * @note Falls back to hash-based embedding if ONNX Runtime unavailable
+ * @note Output embedding is L2-normalized (unit vector)
+ * @note Model is cached after first load - use fastembed_onnx_unload() to free
+ * memory
+ * @note Thread-safe: sessions are shared by all threads, and several models
+ * can be cached at once (see fastembed_onnx_set_cache_capacity())
+ * @note Dimension is automatically validated against model output
+ * @note Use fastembed_onnx_get_model_dimension() to get model dimension before
+ * calling this function
+ */
+FASTEMBED_EXPORT int fastembed_onnx_generate(const char *model_path,
+                                             const char *text, float *output,
+                                             int dimension);
+
+/**
+ * @brief Set the padded-token budget for batched ONNX inference
+ *
+ * fastembed_onnx_batch_generate() sorts texts by token count and packs them
+ * into sub-batches whose padded size (batch_size * seq_len) stays within this
+ * budget, so short queries are not padded to the length of long documents.
+ * Smaller budgets reduce peak memory per inference call; larger budgets give
+ * ONNX Runtime wider batches.
+ *
+ * @param max_tokens Maximum padded tokens per inference call. 0 restores the
+ * default (FASTEMBED_ONNX_BATCH_TOKEN_BUDGET).
+ * @return 0 on success, -1 if max_tokens is negative
+ *
+ * @note A single text longer than the budget is still processed (batch of 1)
+ * @note Applies to all subsequent batch calls (process-wide setting)
+ */
+FASTEMBED_EXPORT int fastembed_onnx_set_batch_token_budget(int max_tokens);
+
+/**
+ * @brief Unload cached ONNX model sessions
+ *
+ * Frees every cached ONNX model session from memory. Sessions still in use
+ * by open handles (fastembed_model_open()) or by calls running on other
+ * threads are detached from the cache and freed when they are released.
+ *
+ * After calling this function, the next call to fastembed_onnx_generate()
+ * will automatically reload the model (no manual reload needed).
+ *
+ * @return 0 on success, -1 if ONNX Runtime not initialized or nothing to unload
+ *
+ * @note Safe to call even if no model is loaded
+ * @note This function only affects the cached sessions, not ONNX Runtime itself
+ */
+FASTEMBED_EXPORT int fastembed_onnx_unload(void);
+
+/**
+ * @brief Opaque handle to a WordPiece tokenizer
+ *
+ * Loaded from a model's vocab.txt or tokenizer.json. ONNX models load their
+ * tokenizer automatically (see fastembed_model_open_with_options()); the
+ * functions below expose it for token counting and custom pipelines.
+ */
+typedef struct fastembed_tokenizer fastembed_tokenizer_t;
+
+/**
+ * @brief Load a WordPiece tokenizer
+ *
+ * Accepts a BERT vocab.txt (one token per line, ID = line number) or a
+ * Hugging Face tokenizer.json with a WordPiece model; the format is detected
+ * from the file contents. Lowercasing and accent stripping follow the
+ * tokenizer.json normalizer; for vocab.txt they are enabled unless the
+ * vocabulary contains uppercase tokens (cased model).
+ *
+ * @param path Path to vocab.txt or tokenizer.json
+ * @return Tokenizer on success, NULL on error (file not found, BPE / Unigram
+ * tokenizer.json, vocabulary without [CLS], [SEP] or unknown token)
+ *
+ * @note Free with fastembed_tokenizer_free()
+ * @note A loaded tokenizer is immutable and thread-safe
+ */
+FASTEMBED_EXPORT fastembed_tokenizer_t *fastembed_tokenizer_load(const char *path);
+
+/**
+ * @brief Free a tokenizer returned by fastembed_tokenizer_load()
+ *
+ * @param tokenizer Tokenizer to free (NULL is ignored)
+ */
+FASTEMBED_EXPORT void fastembed_tokenizer_free(fastembed_tokenizer_t *tokenizer);
+
+/**
+ * @brief Convert text into model input token IDs
+ *
+ * Runs BERT-style normalization and pre-tokenization, then splits words into
+ * WordPiece tokens by greedy longest-match-first. The result is [CLS],
+ * tokens..., [SEP], truncated so that it fits in max_length IDs.
+ *
+ * @param tokenizer Tokenizer returned by fastembed_tokenizer_load()
+ * @param text Input text (UTF-8, null-terminated)
+ * @param token_ids Output array (must be pre-allocated, size >= max_length)
+ * @param max_length Maximum number of IDs including [CLS] and [SEP] (>= 2)
+ * @return Number of IDs written, -1 on invalid arguments
+ *
+ * @note No heap allocation; safe to call from many threads at once
+ * @note Lowercasing covers the Unicode simple case mappings; accent
+ * stripping removes non-spacing marks and decomposes precomposed Latin,
+ * Greek, Cyrillic and Hangul characters
+ */
+FASTEMBED_EXPORT int
+fastembed_tokenizer_encode(const fastembed_tokenizer_t *tokenizer,
+                           const char *text, int64_t *token_ids,
+                           int max_length);
+
+/**
+ * @brief Look up the ID of a vocabulary token
+ *
+ * @param tokenizer Tokenizer returned by fastembed_tokenizer_load()
+ * @param token Token text (e.g. "[CLS]", "##ing")
+ * @return Token ID, or -1 if not in the vocabulary
+ */
+FASTEMBED_EXPORT int
+fastembed_tokenizer_token_to_id(const fastembed_tokenizer_t *tokenizer,
+                                const char *token);
+
+/**
+ * @brief Get the vocabulary size (highest token ID + 1)
+ *
+ * @param tokenizer Tokenizer returned by fastembed_tokenizer_load()
+ * @return Vocabulary size, or -1 if tokenizer is NULL
+ */
+FASTEMBED_EXPORT int
+fastembed_tokenizer_get_vocab_size(const fastembed_tokenizer_t *tokenizer);
+
+/**
+ * @brief Get the padding token ID
+ *
+ * @param tokenizer Tokenizer returned by fastembed_tokenizer_load()
+ * @return ID of [PAD] (FASTEMBED_PAD_TOKEN_ID if the vocabulary has none), or
+ * -1 if tokenizer is NULL
+ */
+FASTEMBED_EXPORT int
+fastembed_tokenizer_get_pad_id(const fastembed_tokenizer_t *tokenizer);
+
+/**
+ * @brief Opaque handle to a loaded ONNX model
+ *
+ * Returned by fastembed_model_open(). Handles share the library's session
+ * cache: opening the same model twice returns the same handle.
+ */
+typedef struct fastembed_model fastembed_model_t;
+
+/**
+ * @brief ONNX Runtime execution providers
+ *
+ * Providers that are not compiled into the loaded ONNX Runtime build are
+ * skipped at model-open time.
+ */
+typedef enum {
+  FASTEMBED_EP_CPU = 0,      /**< Default CPU provider (always available) */
+  FASTEMBED_EP_CUDA = 1,     /**< NVIDIA CUDA */
+  FASTEMBED_EP_TENSORRT = 2, /**< NVIDIA TensorRT */
+  FASTEMBED_EP_COREML = 3,   /**< Apple CoreML */
+  FASTEMBED_EP_XNNPACK = 4   /**< XNNPACK (optimized CPU kernels for ARM/x86) */
+} fastembed_execution_provider_t;
+
+/**
+ * @brief ONNX Runtime graph optimization levels
+ *
+ * Values match ONNX Runtime's GraphOptimizationLevel.
+ */
+typedef enum {
+  FASTEMBED_GRAPH_OPT_DISABLE = 0,  /**< No graph optimizations */
+  FASTEMBED_GRAPH_OPT_BASIC = 1,    /**< Constant folding, redundant nodes */
+  FASTEMBED_GRAPH_OPT_EXTENDED = 2, /**< Basic + node fusions */
+  FASTEMBED_GRAPH_OPT_ALL = 99      /**< Extended + layout optimizations */
+} fastembed_graph_opt_level_t;
+
+/**
+ * @brief Pooling applied to [batch, seq_len, hidden] model outputs
+ *
+ * Reduces the token embeddings of each text to one vector before L2
+ * normalization. Padding tokens (attention mask 0) are excluded. Models
+ * with a pooled [batch, hidden] output ignore this setting.
+ */
+typedef enum {
+  FASTEMBED_POOLING_CLS = 0,       /**< First token ([CLS]), BERT-style */
+  FASTEMBED_POOLING_MEAN = 1,      /**< Mask-aware mean over tokens */
+  FASTEMBED_POOLING_MAX = 2,       /**< Element-wise max over tokens */
+  FASTEMBED_POOLING_LAST_TOKEN = 3 /**< Last non-padding token (decoders) */
+} fastembed_pooling_t;
+
+/**
+ * @brief ONNX Runtime session options for fastembed_model_open_with_options()
+ *
+ * Always initialize with fastembed_onnx_options_init() before changing
+ * fields, so that new fields added in later versions get their defaults.
+ */
+typedef struct fastembed_onnx_options {
+  /** Threads used inside one operator (0 = ONNX Runtime default, one per
+   * physical core). Set this when running several processes per machine to
+   * avoid oversubscription. */
+  int intra_op_threads;
+  /** Threads used to run independent operators in parallel (0 = ONNX
+   * Runtime default) */
+  int inter_op_threads;
+  /** Graph optimization level (fastembed_graph_opt_level_t, default
+   * FASTEMBED_GRAPH_OPT_ALL) */
+  int graph_opt_level;
+  /** Pre-plan memory for fixed input shapes (1 = enabled, the default) */
+  int enable_mem_pattern;
+  /** Use the CPU memory arena allocator (1 = enabled, the default) */
+  int enable_cpu_mem_arena;
+  /** Number of entries used in execution_providers (0 = CPU only) */
+  int num_execution_providers;
+  /** Execution providers in order of preference
+   * (fastembed_execution_provider_t). Unavailable providers are skipped;
+   * CPU is always the final fallback. */
+  int execution_providers[FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS];
+  /** GPU device for CUDA / TensorRT (default 0) */
+  int device_id;
+  /** Optional path for the optimized-model cache (NULL = disabled). The
+   * optimized graph is saved here on first open and loaded directly (without
+   * re-optimizing) while it is newer than the source model. The cache is
+   * specific to the options and hardware it was created with. */
+  const char *optimized_model_path;
+  /** Optional vocab.txt / tokenizer.json for the model (NULL = look for
+   * tokenizer.json, then vocab.txt, next to the model and in its parent
+   * directory). Without a tokenizer, texts are tokenized with a hash-based
+   * fallback that does not match the model vocabulary. */
+  const char *tokenizer_path;
+  /** Pooling over token embeddings (fastembed_pooling_t, default
+   * FASTEMBED_POOLING_CLS). Sentence-transformers models such as
+   * all-MiniLM, bge and e5 expect FASTEMBED_POOLING_MEAN; check the model's
+   * pooling config. */
+  int pooling;
+} fastembed_onnx_options_t;
+
+/**
+ * @brief Initialize ONNX session options with defaults
+ *
+ * Defaults match the sessions created by the path-based functions: ONNX
+ * Runtime thread defaults, all graph optimizations, memory pattern and CPU
+ * arena enabled, CPU execution provider, no optimized-model cache, tokenizer
+ * discovered next to the model, [CLS] pooling.
+ *
+ * @param options Options to initialize
+ */
+FASTEMBED_EXPORT void
+fastembed_onnx_options_init(fastembed_onnx_options_t *options);
+
+/**
+ * @brief Open a handle to an ONNX model
+ *
+ * Loads the model (or reuses an already cached session) and keeps it loaded
+ * until the handle is closed. Use this instead of the path-based functions
+ * when alternating between several models, or to avoid the per-call path
+ * lookup on hot paths.
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @return Model handle on success, NULL on error (model not found, invalid
+ * model, ONNX Runtime unavailable)
+ *
+ * @note Every successful open must be paired with fastembed_model_close()
+ * @note Handles are thread-safe: one handle can be used by many threads
+ * @note Opening the same model twice returns the same handle (reference
+ * counted)
+ */
+FASTEMBED_EXPORT fastembed_model_t *fastembed_model_open(const char *model_path);
+
+/**
+ * @brief Open a handle to an ONNX model with session options
+ *
+ * Same as fastembed_model_open() but creates the session with the given
+ * ONNX Runtime options (thread counts, graph optimization, execution
+ * providers). Sessions are cached per model path and options: opening the
+ * same model with different options loads a separate session.
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @param options Session options (NULL = defaults, see
+ * fastembed_onnx_options_init())
+ * @return Model handle on success, NULL on error (model not found, invalid
+ * options, ONNX Runtime unavailable)
+ *
+ * @note Use fastembed_model_get_execution_provider() to check which provider
+ * was selected
+ * @note If the session cannot be created with the requested providers, it is
+ * created again with the CPU provider only
+ *
+ * @example
+ * @code
+ * fastembed_onnx_options_t options;
+ * fastembed_onnx_options_init(&options);
+ * options.intra_op_threads = 4;
+ * options.num_execution_providers = 1;
+ * options.execution_providers[0] = FASTEMBED_EP_CUDA;
+ * fastembed_model_t *model =
+ *     fastembed_model_open_with_options("model.onnx", &options);
+ * @endcode
+ */
+FASTEMBED_EXPORT fastembed_model_t *
+fastembed_model_open_with_options(const char *model_path,
+                                  const fastembed_onnx_options_t *options);
+
+/**
+ * @brief Get the execution provider an open model runs on
+ *
+ * @param model Model handle returned by fastembed_model_open()
+ * @return fastembed_execution_provider_t of the highest-priority provider
+ * that was enabled (FASTEMBED_EP_CPU if none), -1 if model is NULL
+ */
+FASTEMBED_EXPORT int
+fastembed_model_get_execution_provider(const fastembed_model_t *model);
+
+/**
+ * @brief Get the tokenizer an open model uses
+ *
+ * @param model Model handle returned by fastembed_model_open()
+ * @return Tokenizer owned by the model (valid until the handle is closed), or
+ * NULL if no vocabulary was found and the hash-based fallback is used
+ */
+FASTEMBED_EXPORT const fastembed_tokenizer_t *
+fastembed_model_get_tokenizer(const fastembed_model_t *model);
+
+/**
+ * @brief Close a model handle
+ *
+ * Drops the reference taken by fastembed_model_open(). The session stays in
+ * the cache and is freed by LRU eviction or fastembed_onnx_unload().
+ *
+ * @param model Model handle returned by fastembed_model_open()
+ * @return 0 on success, -1 if model is NULL
+ *
+ * @note The handle must not be used after it is closed
+ */
+FASTEMBED_EXPORT int fastembed_model_close(fastembed_model_t *model);
+
+/**
+ * @brief Run warmup inferences on an open model
+ *
+ * Runs one short text and one batch of FASTEMBED_ONNX_WARMUP_BATCH_SIZE
+ * longer texts through the session, so ONNX Runtime's first-run
+ * allocations and kernel setup are not paid by the first real request.
+ * Warmup texts are not added to the embedding cache.
+ *
+ * @param model Model handle returned by fastembed_model_open()
+ * @return 0 on success, -1 on error (see fastembed_onnx_get_last_error())
+ *
+ * @note Warmup inferences are recorded in the instrumentation statistics;
+ * call fastembed_stats_reset() afterwards to exclude them
+ */
+FASTEMBED_EXPORT int fastembed_model_warmup(fastembed_model_t *model);
+
+/**
+ * @brief Load an ONNX model into the session cache and warm it up
+ *
+ * Takes the whole cold-start cost off the first request: initializes ONNX
+ * Runtime and its environment, creates the session (graph optimization
+ * included) and runs fastembed_model_warmup(). The session stays cached
+ * for later calls with the same path and options - NULL options preload
+ * the session used by the path-based functions such as
+ * fastembed_onnx_generate().
+ *
+ * Set options->optimized_model_path to also save the optimized graph, so
+ * the next process start loads it without re-running graph optimization.
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @param options Session options (NULL = defaults, see
+ * fastembed_onnx_options_init())
+ * @return 0 on success, -1 on error (see fastembed_onnx_get_last_error())
+ *
+ * @note Calls for the model that arrive during the preload wait for the
+ * session load instead of loading it a second time
+ * @note The cached session can still be evicted (LRU, see
+ * fastembed_onnx_set_cache_capacity()); keep a handle from
+ * fastembed_model_open() to pin it
+ */
+FASTEMBED_EXPORT int
+fastembed_onnx_preload(const char *model_path,
+                       const fastembed_onnx_options_t *options);
+
+/**
+ * @brief Opaque handle to a background preload
+ *
+ * Returned by fastembed_onnx_preload_async(); freed by
+ * fastembed_onnx_preload_wait().
+ */
+typedef struct fastembed_preload fastembed_preload_t;
+
+/**
+ * @brief Start fastembed_onnx_preload() on a background thread
+ *
+ * Lets a service start listening (or finish its own initialization) while
+ * the model loads. model_path and options are copied.
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Session options (NULL = defaults)
+ * @return Preload handle on success, NULL on error (thread creation failure,
+ * ONNX Runtime unavailable)
+ *
+ * @note Every handle must be passed to fastembed_onnx_preload_wait() exactly
+ * once, which joins the thread and frees it
+ *
+ * @example
+ * @code
+ * fastembed_preload_t *preload =
+ *     fastembed_onnx_preload_async("model.onnx", NULL);
+ * start_http_server();               // readiness: fastembed_onnx_preload_done()
+ * if (fastembed_onnx_preload_wait(preload) != 0)
+ *   report_error();
+ * @endcode
+ */
+FASTEMBED_EXPORT fastembed_preload_t *
+fastembed_onnx_preload_async(const char *model_path,
+                             const fastembed_onnx_options_t *options);
+
+/**
+ * @brief Check whether a background preload has finished (without blocking)
+ *
+ * @param preload Handle returned by fastembed_onnx_preload_async()
+ * @return 1 if finished (successfully or not), 0 if still running, -1 if
+ * preload is NULL
+ */
+FASTEMBED_EXPORT int
+fastembed_onnx_preload_done(const fastembed_preload_t *preload);
+
+/**
+ * @brief Wait for a background preload to finish and free its handle
  *
- * Uses SIMD-optimized assembly implementation for maximum performance.
+ * If the preload failed, its error message becomes the calling thread's
+ * fastembed_onnx_get_last_error().
  *
- * @param vec Input vector (read-only)
- * @param dimension Number of elements in vector
- * @return L2 norm (always >= 0.0), or 0.0f on error (invalid parameters)
+ * @param preload Handle returned by fastembed_onnx_preload_async()
+ * @return 0 if the model was loaded and warmed up, -1 on error
  *
- * @note Zero vector returns 0.0 norm
- * @note Performance: O(dimension), optimized with SIMD
+ * @note The handle must not be used after this call
  */
-FASTEMBED_EXPORT float fastembed_vector_norm(const float *vec, int dimension);
+FASTEMBED_EXPORT int fastembed_onnx_preload_wait(fastembed_preload_t *preload);
 
 /**
- * @brief Normalize vector to unit length (L2 normalization)
- *
- * Normalizes vector in-place to unit length by dividing each element
- * by the vector's L2 norm. Resulting vector has norm = 1.0.
+ * @brief Get output dimension of an open model
  *
- * If input vector has zero norm, normalization is skipped (no change).
+ * @param model Model handle returned by fastembed_model_open()
+ * @return Model output dimension on success, -1 on error
+ */
+FASTEMBED_EXPORT int
+fastembed_model_get_dimension(const fastembed_model_t *model);
+
+/**
+ * @brief Generate ONNX embedding with an open model
  *
- * Uses SIMD-optimized assembly implementation for maximum performance.
+ * Same as fastembed_onnx_generate() but uses a model handle instead of a
+ * path.
  *
- * @param vec Vector to normalize (modified in-place)
- * @param dimension Number of elements in vector
+ * @param model Model handle returned by fastembed_model_open()
+ * @param text Input text to embed (null-terminated string, max 8192 chars)
+ * @param output Output array for embedding vector (must be pre-allocated, size
+ * >= dimension)
+ * @param dimension Requested embedding dimension (must match model output). If
+ * 0, uses the model dimension.
+ * @return 0 on success, -1 on error
  *
- * @note Operation is in-place: original vector is modified
- * @note Zero vectors remain unchanged (no division by zero)
- * @note Performance: O(dimension), optimized with SIMD
+ * @note Output embedding is L2-normalized (unit vector)
  */
-FASTEMBED_EXPORT void fastembed_normalize(float *vec, int dimension);
+FASTEMBED_EXPORT int fastembed_model_generate(fastembed_model_t *model,
+                                              const char *text, float *output,
+                                              int dimension);
 
 /**
- * @brief Add two vectors element-wise
+ * @brief Generate ONNX embeddings for multiple texts with an open model
  *
- * Performs element-wise addition: result[i] = vec1[i] + vec2[i]
- * for all i in [0, dimension-1].
+ * Same as fastembed_onnx_batch_generate() but uses a model handle instead of
+ * a path.
  *
- * Uses SIMD-optimized assembly implementation for maximum performance.
+ * @param model Model handle returned by fastembed_model_open()
+ * @param texts Array of text strings (null-terminated, max 8192 chars each)
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
+ * dimension)
+ * @param dimension Requested embedding dimension (must match model output). If
+ * 0, uses the model dimension.
+ * @return 0 on success, -1 on error
  *
- * @param vec1 First vector (read-only)
- * @param vec2 Second vector (read-only)
- * @param result Output vector for result (must be pre-allocated, size >=
+ * @note Embeddings are returned in input order and are L2-normalized
+ */
+FASTEMBED_EXPORT int fastembed_model_batch_generate(fastembed_model_t *model,
+                                                    const char **texts,
+                                                    int num_texts,
+                                                    float **outputs,
+                                                    int dimension);
+
+/**
+ * @brief Generate ONNX embeddings for many texts on the shared thread pool
+ *
+ * Each pool thread keeps one inference context for the whole call and runs
+ * length-bucketed batches of up to FASTEMBED_ONNX_MAX_BATCH_SIZE texts
+ * taken from its share of the input (work stealing evens out the rest). A
+ * failing batch is retried text by text, so only the texts that actually
+ * fail are reported in statuses.
+ *
+ * @param model Model handle returned by fastembed_model_open()
+ * @param texts Array of text strings (null-terminated, max 8192 chars each)
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
  * dimension)
- * @param dimension Number of elements in vectors (must match for all three)
+ * @param dimension Requested embedding dimension (must match model output). If
+ * 0, uses the model dimension.
+ * @param statuses Optional output: fastembed_status_t per text (may be NULL)
+ * @param num_threads Threads to use, including the caller (0 = whole pool)
+ * @return Number of texts that failed (0 = all succeeded), -1 on invalid
+ * arguments or without ONNX Runtime
  *
- * @note All vectors must have the same dimension
- * @note Result vector must be pre-allocated (not computed in-place)
- * @note Performance: O(dimension), optimized with SIMD
+ * @note ONNX Runtime also parallelizes each inference; with several pool
+ * threads, open the model with a small intra_op_threads (e.g. 1) to avoid
+ * oversubscribing the CPU
  */
-FASTEMBED_EXPORT void fastembed_add_vectors(const float *vec1,
-                                            const float *vec2, float *result,
-                                            int dimension);
+FASTEMBED_EXPORT int fastembed_model_batch_generate_parallel(
+    fastembed_model_t *model, const char **texts, int num_texts,
+    float **outputs, int dimension, int *statuses, int num_threads);
 
 /**
- * @brief Generate embedding using ONNX Runtime model
+ * @brief Generate embeddings for concatenated texts with an open model into
+ * one matrix
  *
- * Loads a trained ONNX embedding model (e.g., BERT-based, nomic-embed-text)
- * and generates embeddings using neural network inference. This provides
- * learned semantic embeddings as opposed to hash-based embeddings.
+ * Contiguous form of fastembed_model_batch_generate_parallel(): text i is
+ * text_data[offsets[i], offsets[i + 1]) and its embedding is row i of
+ * output (see fastembed_batch_generate_contiguous()). Each group of texts
+ * is copied once into a per-thread buffer for tokenization.
  *
- * The function performs tokenization, runs ONNX inference, extracts the
- * [CLS] token embedding, and applies L2 normalization.
+ * @param model Model handle returned by fastembed_model_open()
+ * @param text_data Concatenated UTF-8 texts (need not be null-terminated)
+ * @param offsets num_texts + 1 byte offsets into text_data
+ * @param num_texts Number of texts
+ * @param output Row-major float[num_texts * dimension]
+ * @param dimension Requested embedding dimension (must match model output). If
+ * 0, uses the model dimension.
+ * @param statuses Optional output: fastembed_status_t per text (may be NULL)
+ * @param num_threads Threads to use, including the caller (0 = whole pool)
+ * @return Number of texts that failed (their rows are zeroed), -1 on invalid
+ * arguments or without ONNX Runtime
+ */
+FASTEMBED_EXPORT int fastembed_model_batch_generate_contiguous(
+    fastembed_model_t *model, const char *text_data, const int32_t *offsets,
+    int num_texts, float *output, int dimension, int *statuses,
+    int num_threads);
+
+/**
+ * @brief Called once per embedded window of a chunked document
  *
- * **Performance Optimization:** The model session is cached in memory after
- * the first call. Subsequent calls with the same model_path reuse the cached
- * session, significantly improving performance (no model reload overhead).
+ * Windows are reported in document order. The embedding is L2-normalized
+ * and only valid during the call.
  *
- * @param model_path Path to .onnx model file (must be readable)
- * @param text Input text to embed (null-terminated string, max 8192 chars)
- * @param output Output array for embedding vector (must be pre-allocated, size
- * >= dimension)
- * @param dimension Requested embedding dimension (must match model output, max
- * 2048). If 0, automatically detects dimension from model.
- * @return 0 on success, -1 on error (file not found, inference failure,
- * dimension mismatch, etc.)
+ * @param user_data fastembed_chunk_options_t::user_data
+ * @param chunk_index Window number (0, 1, 2, ...)
+ * @param embedding float[dimension] window embedding
+ * @param dimension Model output dimension
+ * @param token_offset Index of the window's first token in the document
+ * (not counting [CLS] / [SEP])
+ * @param token_count Document tokens in the window
+ * @return 0 to continue, non-zero to abort the document
+ */
+typedef int (*fastembed_chunk_callback_t)(void *user_data, int chunk_index,
+                                          const float *embedding,
+                                          int dimension, int token_offset,
+                                          int token_count);
+
+/**
+ * @brief Parameters for fastembed_document_begin()
  *
- * @note Requires ONNX Runtime to be installed and linked at compile time
- * @note Compile with -DUSE_ONNX_RUNTIME to enable ONNX support
- * @note Falls back to hash-based embedding if ONNX Runtime unavailable
- * @note Output embedding is L2-normalized (unit vector)
- * @note Model is cached after first load - use fastembed_onnx_unload() to free
- * memory
- * @note Dimension is automatically validated against model output
- * @note Use fastembed_onnx_get_model_dimension() to get model dimension before
- * calling this function
+ * Always initialize with fastembed_chunk_options_init() before changing
+ * fields, so that new fields added in later versions get their defaults.
  */
-FASTEMBED_EXPORT int fastembed_onnx_generate(const char *model_path,
-                                             const char *text, float *output,
+typedef struct fastembed_chunk_options {
+  /** Tokens per window including [CLS] and [SEP] (3 -
+   * FASTEMBED_MAX_SEQUENCE_LENGTH, default
+   * FASTEMBED_CHUNK_DEFAULT_WINDOW_TOKENS); keep within the model's
+   * positional limit */
+  int window_tokens;
+  /** Tokens repeated at the start of the next window (0 to window_tokens -
+   * 3, default FASTEMBED_CHUNK_DEFAULT_OVERLAP_TOKENS) */
+  int overlap_tokens;
+  /** Per-window embeddings (NULL = only the pooled document vector) */
+  fastembed_chunk_callback_t on_chunk;
+  /** Passed to on_chunk */
+  void *user_data;
+} fastembed_chunk_options_t;
+
+/**
+ * @brief Initialize chunking options with defaults
+ *
+ * @param options Options to initialize
+ */
+FASTEMBED_EXPORT void
+fastembed_chunk_options_init(fastembed_chunk_options_t *options);
+
+/**
+ * @brief Opaque state of a document being embedded in windows
+ *
+ * Created with fastembed_document_begin(); free with fastembed_document_free().
+ */
+typedef struct fastembed_document fastembed_document_t;
+
+/**
+ * @brief Start embedding a document of any length
+ *
+ * Text is pushed with fastembed_document_feed() in pieces of any size. It is
+ * tokenized a segment at a time (FASTEMBED_CHUNK_SEGMENT_BYTES), split into
+ * overlapping token windows, and the windows are embedded in batches of
+ * FASTEMBED_CHUNK_BATCH_WINDOWS, so memory stays bounded however long the
+ * document is. fastembed_document_finish() embeds the last windows and
+ * returns the pooled document vector.
+ *
+ * @param model Model handle; the document keeps its own reference, so the
+ * handle may be closed first
+ * @param options Chunking options (NULL = defaults)
+ * @return Document, NULL on invalid options or without ONNX Runtime
+ *
+ * @note Windows are cut between tokens and text is split at whitespace, so a
+ * document that fits in one window embeds exactly like
+ * fastembed_model_generate() (unless a single word exceeds
+ * FASTEMBED_CHUNK_SEGMENT_BYTES)
+ * @note A document must be used by one thread at a time; different
+ * documents may use the same model concurrently
+ */
+FASTEMBED_EXPORT fastembed_document_t *
+fastembed_document_begin(fastembed_model_t *model,
+                         const fastembed_chunk_options_t *options);
+
+/**
+ * @brief Append text to a document
+ *
+ * Complete windows are embedded (and reported to on_chunk) as they fill up.
+ *
+ * @param document Document returned by fastembed_document_begin()
+ * @param text UTF-8 text (need not be null-terminated; a piece may end inside
+ * a word or a multi-byte character)
+ * @param length Bytes of text
+ * @return 0 on success, -1 on error or if on_chunk aborted (the document is
+ * then failed; only fastembed_document_free() remains useful)
+ */
+FASTEMBED_EXPORT int fastembed_document_feed(fastembed_document_t *document,
+                                             const char *text, size_t length);
+
+/**
+ * @brief Embed the remaining windows and pool the document vector
+ *
+ * The document vector is the mean of the window embeddings weighted by
+ * their token counts, L2-normalized. An empty document is embedded as one
+ * empty window.
+ *
+ * @param document Document returned by fastembed_document_begin()
+ * @param output float[dimension] document vector (may be NULL)
+ * @return Number of windows, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_document_finish(fastembed_document_t *document,
+                                               float *output);
+
+/**
+ * @brief Free a document (NULL is ignored)
+ *
+ * @param document Document, finished or not
+ */
+FASTEMBED_EXPORT void fastembed_document_free(fastembed_document_t *document);
+
+/**
+ * @brief Embed a whole document in windows
+ *
+ * fastembed_document_begin(), one fastembed_document_feed() and
+ * fastembed_document_finish().
+ *
+ * @param model Model handle
+ * @param text UTF-8 document text
+ * @param length Bytes of text
+ * @param options Chunking options (NULL = defaults)
+ * @param output float[dimension] document vector (may be NULL)
+ * @return Number of windows, -1 on error
+ */
+FASTEMBED_EXPORT int
+fastembed_model_embed_document(fastembed_model_t *model, const char *text,
+                               size_t length,
+                               const fastembed_chunk_options_t *options,
+                               float *output);
+
+/**
+ * @brief Called once per completed batch of a pipelined batch call
+ *
+ * Batches complete out of order; within a batch, texts are ordered by token
+ * count. Calls are made one at a time on the thread that called
+ * fastembed_model_batch_generate_pipelined(), and the arrays are only valid
+ * during the call.
+ *
+ * @param user_data fastembed_pipeline_options_t::user_data
+ * @param indices Text index of each row
+ * @param statuses fastembed_status_t of each row (failed rows are zero)
+ * @param count Rows in the batch (1 to FASTEMBED_ONNX_MAX_BATCH_SIZE)
+ * @param rows Embeddings in the options' quantization: float[dimension],
+ * int8_t[dimension], uint8_t[FASTEMBED_BINARY_BYTES(dimension)] or
+ * uint16_t[dimension] per row
+ * @param scales int8 scale of each row (FASTEMBED_QUANT_INT8), NULL otherwise
+ * @param dimension Embedding dimension
+ * @return 0 to continue, non-zero to abort the call
+ */
+typedef int (*fastembed_pipeline_callback_t)(void *user_data,
+                                             const int *indices,
+                                             const int *statuses, int count,
+                                             const void *rows,
+                                             const float *scales,
                                              int dimension);
 
 /**
- * @brief Unload cached ONNX model session
+ * @brief Parameters for fastembed_model_batch_generate_pipelined()
+ *
+ * Always initialize with fastembed_pipeline_options_init() before changing
+ * fields, so that new fields added in later versions get their defaults. At
+ * least one of output, store and on_batch must be set.
+ */
+typedef struct fastembed_pipeline_options {
+  /** Tokenizer threads (1 - FASTEMBED_PIPELINE_MAX_THREADS, default
+   * FASTEMBED_PIPELINE_DEFAULT_TOKENIZER_THREADS) */
+  int tokenizer_threads;
+  /** Inference threads, each with its own inference context (1 -
+   * FASTEMBED_PIPELINE_MAX_THREADS, default
+   * FASTEMBED_PIPELINE_DEFAULT_INFERENCE_THREADS) */
+  int inference_threads;
+  /** Padded batches in flight between the stages (>= 1, default
+   * FASTEMBED_PIPELINE_DEFAULT_QUEUE_DEPTH) */
+  int queue_depth;
+  /** fastembed_quantization_t of output and of the rows passed to on_batch
+   * (default FASTEMBED_QUANT_NONE) */
+  int quantization;
+  /** Optional matrix of num_texts rows in the quantization above, written
+   * at the text index */
+  void *output;
+  /** float[num_texts] scales written with output and FASTEMBED_QUANT_INT8
+   * (required then) */
+  float *scales;
+  /** Optional store writer of the same dimension; float embeddings of
+   * successful texts are appended as batches complete, with the text index
+   * as id (open it with FASTEMBED_STORE_IDS to keep the mapping) */
+  fastembed_store_writer_t *store;
+  /** Per-batch results (NULL = none) */
+  fastembed_pipeline_callback_t on_batch;
+  /** Passed to on_batch */
+  void *user_data;
+} fastembed_pipeline_options_t;
+
+/**
+ * @brief Initialize pipeline options with defaults
  *
- * Frees the cached ONNX model session from memory. This can be useful to
- * free memory when done with a model, or to switch to a different model.
+ * @param options Options to initialize
+ */
+FASTEMBED_EXPORT void
+fastembed_pipeline_options_init(fastembed_pipeline_options_t *options);
+
+/**
+ * @brief Embed many texts with tokenization, inference and post-processing
+ * overlapped
  *
- * After calling this function, the next call to fastembed_onnx_generate()
- * will automatically reload the model (no manual reload needed).
+ * Three stages run concurrently. Tokenizer threads take
+ * FASTEMBED_PIPELINE_WINDOW texts at a time, bucket them by length and
+ * queue padded batches. Inference threads run the batches, each with its
+ * own inference context, and pool and normalize them. The calling thread
+ * quantizes finished batches, fills output, appends them to the store and
+ * calls on_batch. The queues hold at most queue_depth batches, so memory
+ * stays bounded, and results arrive while later texts are still being
+ * tokenized. Embeddings are identical to fastembed_model_batch_generate().
  *
- * @return 0 on success, -1 if ONNX Runtime not initialized or nothing to unload
+ * @param model Model handle returned by fastembed_model_open()
+ * @param texts Array of input texts (NULL entries fail individually)
+ * @param num_texts Number of texts
+ * @param dimension Requested embedding dimension (must match model output).
+ * If 0, uses the model dimension.
+ * @param statuses Optional output: fastembed_status_t per text (may be NULL)
+ * @param options Pipeline options (output, store or on_batch required)
+ * @return Number of texts that failed (a batch that fails is retried text
+ * by text), -1 on invalid arguments, if on_batch aborted, if a store append
+ * failed or without ONNX Runtime
  *
- * @note Safe to call even if no model is loaded (returns 0)
- * @note This function only affects the cached session, not ONNX Runtime itself
+ * @note The embedding cache is bypassed: pipelined calls are meant for
+ * corpora of distinct texts
+ * @note Stage threads are started per call; use
+ * fastembed_model_batch_generate_parallel() for small batches
  */
-FASTEMBED_EXPORT int fastembed_onnx_unload(void);
+FASTEMBED_EXPORT int fastembed_model_batch_generate_pipelined(
+    fastembed_model_t *model, const char **texts, int num_texts, int dimension,
+    int *statuses, const fastembed_pipeline_options_t *options);
+
+/**
+ * @brief Set how many ONNX model sessions stay cached
+ *
+ * The library keeps recently used sessions loaded so that alternating
+ * between models does not reload them from disk. When more models than the
+ * capacity are loaded, the least recently used idle session is freed.
+ * Sessions with open handles are never evicted.
+ *
+ * @param capacity Maximum number of cached models (>= 1, default
+ * FASTEMBED_ONNX_MODEL_CACHE_SIZE)
+ * @return 0 on success, -1 if capacity < 1
+ *
+ * @note Lowering the capacity evicts idle sessions immediately
+ */
+FASTEMBED_EXPORT int fastembed_onnx_set_cache_capacity(int capacity);
+
+/**
+ * @brief Embedding cache counters (fastembed_embedding_cache_get_stats())
+ */
+typedef struct {
+  uint64_t hits;       /**< Lookups answered without inference */
+  uint64_t misses;     /**< Lookups sent to inference */
+  uint64_t store_hits; /**< Hits answered by an attached store (in hits) */
+  uint64_t insertions; /**< Entries added to memory */
+  uint64_t evictions;  /**< Entries dropped to stay within the budget */
+  uint64_t entries;    /**< Entries in memory */
+  uint64_t bytes;      /**< Memory used by entries */
+  uint64_t capacity_bytes; /**< Budget set with
+                              fastembed_embedding_cache_set_capacity() */
+  int stores;              /**< Attached store files */
+} fastembed_embedding_cache_stats_t;
+
+/**
+ * @brief Set the memory budget of the embedding cache
+ *
+ * ONNX generate calls (single, batch, parallel and handle-based) look up
+ * each text in a content-addressed cache keyed by the model path,
+ * tokenizer path, pooling, output dimension and an XXH64 hash of the text.
+ * Only misses are sent to inference; their embeddings are added to the
+ * cache, evicting the least recently used entries when over budget.
+ *
+ * @param max_bytes Cache memory in bytes (0 = disabled, the default; frees
+ * all entries). An entry takes about dimension * 4 + 48 bytes.
+ * @return 0 on success
+ *
+ * @note The budget is split evenly across FASTEMBED_EMBEDDING_CACHE_SHARDS
+ * independently locked shards
+ * @note Entries are not invalidated when a model file changes in place;
+ * call fastembed_embedding_cache_clear() after replacing a model
+ */
+FASTEMBED_EXPORT int fastembed_embedding_cache_set_capacity(size_t max_bytes);
+
+/**
+ * @brief Drop every in-memory cache entry (keeps budget, stores and counters)
+ */
+FASTEMBED_EXPORT void fastembed_embedding_cache_clear(void);
+
+/**
+ * @brief Read the embedding cache counters
+ *
+ * @param stats Output counters
+ * @return 0 on success, -1 if stats is NULL
+ */
+FASTEMBED_EXPORT int
+fastembed_embedding_cache_get_stats(fastembed_embedding_cache_stats_t *stats);
+
+/**
+ * @brief Zero the hit, miss, insertion and eviction counters
+ */
+FASTEMBED_EXPORT void fastembed_embedding_cache_reset_stats(void);
+
+/**
+ * @brief Write the in-memory cache entries of one dimension to a store file
+ *
+ * Writes a float store (fastembed_store_open() format) with
+ * FASTEMBED_STORE_IDS, the ids being the cache keys in ascending order, so
+ * the file can be attached as a persistent tier in a later process.
+ *
+ * @param path Output file
+ * @param dimension Embedding dimension of the entries to save
+ * @return Number of entries written, -1 on error (no file is left behind)
+ *
+ * @note Entries are copied out first, so inference is not blocked while
+ * the file is written; this temporarily needs as much memory again
+ */
+FASTEMBED_EXPORT int fastembed_embedding_cache_save(const char *path,
+                                                    int dimension);
+
+/**
+ * @brief Attach a store file as a persistent, read-only cache tier
+ *
+ * Lookups that miss in memory are searched in the attached stores (binary
+ * search on the mapped id table); hits are copied into memory. Attaching a
+ * store enables lookups even with a memory budget of 0.
+ *
+ * @param path File written by fastembed_embedding_cache_save()
+ * @return 0 on success, -1 if the file is not a float store with sorted
+ * ids or FASTEMBED_EMBEDDING_CACHE_MAX_STORES stores are attached
+ */
+FASTEMBED_EXPORT int fastembed_embedding_cache_attach_store(const char *path);
+
+/**
+ * @brief Detach and unmap every attached cache store
+ */
+FASTEMBED_EXPORT void fastembed_embedding_cache_detach_stores(void);
+
+/**
+ * @brief Instrumented stages of ONNX generate calls
+ * (fastembed_stats_t::stages)
+ */
+typedef enum {
+  /** Path resolution and session lookup of path-based calls */
+  FASTEMBED_STAGE_RESOLVE = 0,
+  /** Model load (tokenizer and ONNX Runtime session creation) */
+  FASTEMBED_STAGE_LOAD = 1,
+  /** Tokenizing one scheduler window of texts */
+  FASTEMBED_STAGE_TOKENIZE = 2,
+  /** Input/output tensor creation and binding, per inference call */
+  FASTEMBED_STAGE_BIND = 3,
+  /** ONNX Runtime Run(), per inference call */
+  FASTEMBED_STAGE_RUN = 4,
+  /** Output conversion, pooling and normalization, per inference call */
+  FASTEMBED_STAGE_POOL = 5,
+  /** One batch of texts end to end (cache, tokenizer and inference) */
+  FASTEMBED_STAGE_GENERATE = 6,
+  FASTEMBED_STAGE_COUNT = 7
+} fastembed_stage_t;
+
+/**
+ * @brief Summary of one histogram (fastembed_stats_snapshot())
+ *
+ * Percentiles come from log-linear buckets (8 per power of two), so they
+ * are within 1/16 of the true value; min and max are exact.
+ */
+typedef struct {
+  uint64_t count; /**< Samples */
+  uint64_t sum;   /**< Sum of all samples */
+  uint64_t min;   /**< Smallest sample (0 without samples) */
+  uint64_t max;   /**< Largest sample */
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t p999;
+} fastembed_histogram_t;
+
+/**
+ * @brief Process-wide ONNX instrumentation counters
+ */
+typedef struct {
+  /** Latency per stage, in nanoseconds (fastembed_stage_t) */
+  fastembed_histogram_t stages[FASTEMBED_STAGE_COUNT];
+  /** Rows per inference call */
+  fastembed_histogram_t batch_rows;
+  uint64_t texts;         /**< Texts passed to generate calls */
+  uint64_t errors;        /**< Failed generate batches */
+  uint64_t tokens;        /**< Tokens sent to inference, without padding */
+  uint64_t padded_tokens; /**< Tokens sent to inference, with padding */
+  int enabled;            /**< fastembed_stats_set_enabled() state */
+} fastembed_stats_t;
+
+/**
+ * @brief Read the instrumentation counters
+ *
+ * ONNX calls record per-stage latencies and batch shapes into per-thread
+ * slots with relaxed atomic adds (two clock reads per stage, no locks);
+ * a snapshot merges the slots.
+ *
+ * @param stats Output counters
+ * @return 0 on success, -1 if stats is NULL
+ *
+ * @note Counters recorded while a snapshot is taken may be split between
+ * this snapshot and the next
+ */
+FASTEMBED_EXPORT int fastembed_stats_snapshot(fastembed_stats_t *stats);
+
+/**
+ * @brief Write the instrumentation counters as a JSON object
+ *
+ * Same content as fastembed_stats_snapshot(), e.g.
+ * {"enabled":1,"texts":10,...,"stages":{"run":{"count":2,"sum_ns":...}}}.
+ * Stage keys are resolve, load, tokenize, bind, run, pool and generate.
+ *
+ * @param buffer Output buffer (may be NULL when size is 0)
+ * @param size Size of buffer in bytes
+ * @return Length of the JSON text (excluding the terminator; the output
+ * is complete only if this is less than size), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_stats_snapshot_json(char *buffer, size_t size);
+
+/**
+ * @brief Zero all instrumentation counters
+ */
+FASTEMBED_EXPORT void fastembed_stats_reset(void);
+
+/**
+ * @brief Turn instrumentation on or off (on by default)
+ *
+ * @param enabled Non-zero to record, 0 to skip all timing and counting
+ */
+FASTEMBED_EXPORT void fastembed_stats_set_enabled(int enabled);
 
 /**
  * @brief Get last error message from ONNX operations
@@ -286,6 +2055,8 @@ FASTEMBED_EXPORT int fastembed_onnx_unload(void);
  *
  * @note Only available when compiled with USE_ONNX_RUNTIME
  * @note Error message is cleared on each new ONNX operation
+ * @note The error message is per thread: it reports the last failure of an
+ * ONNX call made on the calling thread
  */
 FASTEMBED_EXPORT int fastembed_onnx_get_last_error(char *error_buffer,
                                                    size_t buffer_size);
@@ -320,6 +2091,43 @@ FASTEMBED_EXPORT int fastembed_onnx_get_last_error(char *error_buffer,
  */
 FASTEMBED_EXPORT int fastembed_onnx_get_model_dimension(const char *model_path);
 
+/**
+ * @brief Generate ONNX embeddings for multiple texts in batched inference
+ *
+ * Batched counterpart of fastembed_onnx_generate(). All texts are tokenized,
+ * padded to the longest sequence of their group with a real attention mask,
+ * and embedded with a single [N, seq_len] inference per group of up to
+ * FASTEMBED_ONNX_MAX_BATCH_SIZE texts. This lets ONNX Runtime parallelize
+ * across the batch and amortizes per-call overhead over many texts.
+ *
+ * Groups are formed by a length-bucketing scheduler: texts are sorted by token
+ * count and packed under a padded-token budget (see
+ * fastembed_onnx_set_batch_token_budget()), so mixed-length inputs waste
+ * little compute on padding.
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @param texts Array of text strings (null-terminated, max 8192 chars each)
+ * @param num_texts Number of texts in the array (must match outputs array size)
+ * @param outputs Array of output arrays for embeddings (each must be
+ * pre-allocated, size >= dimension)
+ * @param dimension Requested embedding dimension (must match model output, max
+ * 2048). If 0, automatically detects dimension from model.
+ * @return 0 on success (all embeddings generated), -1 on error (file not
+ * found, inference failure, dimension mismatch, etc.)
+ *
+ * @note Output embeddings are identical to per-text fastembed_onnx_generate()
+ * results and are returned in input order
+ * @note Each output embedding is L2-normalized (unit vector)
+ * @note On error, some embeddings may have been generated (partial results)
+ * @note Falls back to hash-based fastembed_batch_generate() if ONNX Runtime
+ * unavailable
+ */
+FASTEMBED_EXPORT int fastembed_onnx_batch_generate(const char *model_path,
+                                                   const char **texts,
+                                                   int num_texts,
+                                                   float **outputs,
+                                                   int dimension);
+
 /**
  * @brief Generate embeddings for multiple texts in batch
  *
@@ -348,6 +2156,124 @@ FASTEMBED_EXPORT int fastembed_onnx_get_model_dimension(const char *model_path);
 FASTEMBED_EXPORT int fastembed_batch_generate(const char **texts, int num_texts,
                                               float **outputs, int dimension);
 
+/**
+ * @brief Per-text result of the parallel batch functions
+ */
+typedef enum {
+  FASTEMBED_STATUS_OK = 0,            /**< Embedding written */
+  FASTEMBED_STATUS_ERROR = -1,        /**< Generation or inference failed */
+  FASTEMBED_STATUS_NULL_INPUT = -2,   /**< texts[i] or outputs[i] is NULL */
+  FASTEMBED_STATUS_INVALID_TEXT = -3, /**< Empty, longer than 8192 bytes or
+                                         bad offsets / embedded NUL
+                                         (contiguous API) */
+} fastembed_status_t;
+
+/**
+ * @brief Generate hash embeddings for many texts on the shared thread pool
+ *
+ * Texts are split across the pool threads (work stealing, see
+ * fastembed_thread_pool_configure()) and each text succeeds or fails on its
+ * own: a bad text is reported in statuses instead of aborting the batch.
+ * Embeddings are identical to fastembed_generate().
+ *
+ * @param texts Array of text strings (null-terminated)
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
+ * dimension)
+ * @param dimension Embedding dimension (128, 256, 512, 768, 1024, 2048; 0 =
+ * 128)
+ * @param statuses Optional output: fastembed_status_t per text (may be NULL)
+ * @param num_threads Threads to use, including the caller (0 = whole pool)
+ * @return Number of texts that failed (0 = all succeeded), -1 on invalid
+ * arguments (NULL arrays, num_texts <= 0, unsupported dimension)
+ */
+FASTEMBED_EXPORT int fastembed_batch_generate_parallel(const char **texts,
+                                                       int num_texts,
+                                                       float **outputs,
+                                                       int dimension,
+                                                       int *statuses,
+                                                       int num_threads);
+
+/**
+ * @brief Generate hash embeddings for concatenated texts into one matrix
+ *
+ * Zero-copy batch layout for bindings: texts are one UTF-8 buffer plus an
+ * offsets array (Arrow string layout) and the embeddings are one row-major
+ * matrix, so NumPy arrays, direct buffers, spans and typed arrays can be
+ * passed straight through. Text i is text_data[offsets[i], offsets[i + 1])
+ * and its embedding is written to output[i * dimension ...]. Runs on the
+ * shared thread pool like fastembed_batch_generate_parallel(); embeddings
+ * are identical to fastembed_generate() on the same bytes.
+ *
+ * @param text_data Concatenated UTF-8 texts (need not be null-terminated)
+ * @param offsets num_texts + 1 non-decreasing byte offsets into text_data
+ * @param num_texts Number of texts
+ * @param output Row-major float[num_texts * dimension]; any float-aligned
+ * buffer works, fastembed_alloc_matrix() gives a 64-byte aligned one
+ * @param dimension Embedding dimension (128, 256, 512, 768, 1024, 2048; 0 =
+ * 128)
+ * @param statuses Optional output: fastembed_status_t per text (may be NULL)
+ * @param num_threads Threads to use, including the caller (0 = whole pool)
+ * @return Number of texts that failed (their rows are zeroed), -1 on invalid
+ * arguments (NULL pointers, num_texts <= 0, unsupported dimension)
+ */
+FASTEMBED_EXPORT int fastembed_batch_generate_contiguous(
+    const char *text_data, const int32_t *offsets, int num_texts,
+    float *output, int dimension, int *statuses, int num_threads);
+
+/**
+ * @brief Allocate a zeroed, 64-byte aligned row-major float matrix
+ *
+ * @param rows Number of rows (e.g. texts)
+ * @param dimension Floats per row
+ * @return Matrix aligned to FASTEMBED_MATRIX_ALIGNMENT, or NULL on invalid
+ * size or allocation failure. Free with fastembed_free_matrix().
+ */
+FASTEMBED_EXPORT float *fastembed_alloc_matrix(int rows, int dimension);
+
+/**
+ * @brief Free a matrix returned by fastembed_alloc_matrix()
+ *
+ * @param matrix Matrix to free (NULL is ignored)
+ */
+FASTEMBED_EXPORT void fastembed_free_matrix(float *matrix);
+
+/**
+ * @brief Configure the shared thread pool used by the parallel batch APIs
+ *
+ * Also used by the threaded similarity matrix, top-k and HNSW batch-insert
+ * functions.
+ *
+ * Threads start on the first parallel call and then sleep between calls.
+ * Reconfiguring waits for running batches and stops the current threads;
+ * the next call starts the new pool.
+ *
+ * @param num_threads Pool size including the calling thread (0 = one per
+ * logical CPU, at most FASTEMBED_THREAD_POOL_MAX_THREADS)
+ * @param pin_threads Non-zero to pin pool thread i to logical CPU i (Linux and
+ * Windows; ignored on macOS)
+ * @return 0 on success, -1 on invalid arguments or when called from inside a
+ * batch
+ */
+FASTEMBED_EXPORT int fastembed_thread_pool_configure(int num_threads,
+                                                     int pin_threads);
+
+/**
+ * @brief Get the shared thread pool size (starts the pool if needed)
+ *
+ * @return Threads used by a parallel batch with num_threads = 0, including
+ * the calling thread
+ */
+FASTEMBED_EXPORT int fastembed_thread_pool_get_size(void);
+
+/**
+ * @brief Stop the shared thread pool's threads
+ *
+ * Waits for a running batch. The next parallel call starts the pool again;
+ * call before unloading the library to release the threads.
+ */
+FASTEMBED_EXPORT void fastembed_thread_pool_shutdown(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,9 +42,241 @@
 /** Maximum sequence length for tokenization (BERT-like models) */
 #define FASTEMBED_MAX_SEQUENCE_LENGTH 8192
 
-/** Maximum JSON input buffer size in characters (for CLI tools) */
+/** Maximum number of texts packed into a single ONNX inference call
+ *
+ * Batched ONNX generation pads texts to a common length and runs one
+ * [batch, seq_len] inference per group. Larger groups give ONNX Runtime more
+ * rows per GEMM, but the padded input tensors grow linearly with the group
+ * size. Inputs larger than this are split into several Run() calls.
+ */
+#define FASTEMBED_ONNX_MAX_BATCH_SIZE 32
+
+/** Default padded-token budget per batched ONNX inference call
+ *
+ * The batch scheduler sorts texts by token count and packs them into
+ * sub-batches while batch_size * padded_seq_len stays within this budget.
+ * Short texts are grouped into wide batches and long texts into narrow ones.
+ * Can be changed at runtime with fastembed_onnx_set_batch_token_budget().
+ */
+#define FASTEMBED_ONNX_BATCH_TOKEN_BUDGET 16384
+
+/** Number of texts tokenized and sorted together by the batch scheduler
+ *
+ * Bounds scheduler memory for corpus-scale inputs: only one window of
+ * tokenized texts is held at a time.
+ */
+#define FASTEMBED_ONNX_SCHEDULE_WINDOW 1024
+
+/** Default token window (including [CLS] and [SEP]) for chunked documents
+ *
+ * The positional limit of BERT-style encoders. Documents fed to
+ * fastembed_document_feed() are split into windows of this many tokens.
+ */
+#define FASTEMBED_CHUNK_DEFAULT_WINDOW_TOKENS 512
+
+/** Default number of tokens shared by consecutive document windows */
+#define FASTEMBED_CHUNK_DEFAULT_OVERLAP_TOKENS 64
+
+/** Bytes of document text tokenized at a time
+ *
+ * Fed text is cut at the last whitespace before this many bytes, so a
+ * document never holds more than one segment of raw text. Must stay below
+ * FASTEMBED_MAX_SEQUENCE_LENGTH - 2 (a byte yields at most one token).
+ */
+#define FASTEMBED_CHUNK_SEGMENT_BYTES 4096
+
+/** Document windows collected before one inference call
+ *
+ * Bounds the memory of a document to this many windows of tokens and
+ * embeddings, independent of the document length.
+ */
+#define FASTEMBED_CHUNK_BATCH_WINDOWS 32
+
+/** Default tokenizer threads of a pipelined batch
+ *
+ * One tokenizer usually keeps an inference thread busy: tokenizing a text
+ * costs far less than running the encoder on it.
+ */
+#define FASTEMBED_PIPELINE_DEFAULT_TOKENIZER_THREADS 1
+
+/** Default inference threads of a pipelined batch
+ *
+ * ONNX Runtime already spreads each Run() over its intra-op threads; more
+ * inference threads help small models that cannot use every core.
+ */
+#define FASTEMBED_PIPELINE_DEFAULT_INFERENCE_THREADS 1
+
+/** Default padded batches in flight between pipeline stages
+ *
+ * Bounds pipeline memory: tokenizer threads wait once this many batches are
+ * queued for inference or post-processing.
+ */
+#define FASTEMBED_PIPELINE_DEFAULT_QUEUE_DEPTH 8
+
+/** Maximum threads per pipeline stage (tokenizer or inference) */
+#define FASTEMBED_PIPELINE_MAX_THREADS 16
+
+/** Texts a pipeline tokenizer thread tokenizes and sorts together
+ *
+ * Smaller than FASTEMBED_ONNX_SCHEDULE_WINDOW so the first batches reach
+ * inference quickly; still enough texts for length bucketing.
+ */
+#define FASTEMBED_PIPELINE_WINDOW 256
+
+/** Default number of idle ONNX model sessions kept loaded
+ *
+ * Loaded sessions are cached in a registry keyed by resolved model path.
+ * When more models than this are loaded, the least recently used idle
+ * session is unloaded (sessions with open handles are never evicted).
+ * Can be changed at runtime with fastembed_onnx_set_cache_capacity().
+ */
+#define FASTEMBED_ONNX_MODEL_CACHE_SIZE 4
+
+/** Maximum number of idle inference contexts kept per ONNX session
+ *
+ * Each concurrent call on a session uses its own inference context
+ * (preallocated input/output buffers and an IoBinding). Up to this many are
+ * kept for reuse after the calls finish; extra ones are freed.
+ */
+#define FASTEMBED_ONNX_MAX_IDLE_CONTEXTS 4
+
+/** Warmup inferences run by fastembed_onnx_preload() and
+ * fastembed_model_warmup()
+ *
+ * One text of about FASTEMBED_ONNX_WARMUP_SHORT_TOKENS tokens (query shape)
+ * and one batch of FASTEMBED_ONNX_WARMUP_BATCH_SIZE texts of about
+ * FASTEMBED_ONNX_WARMUP_LONG_TOKENS tokens (document shape), so ONNX
+ * Runtime's first-run allocations happen before the first real request.
+ */
+#define FASTEMBED_ONNX_WARMUP_SHORT_TOKENS 16
+#define FASTEMBED_ONNX_WARMUP_LONG_TOKENS 128
+#define FASTEMBED_ONNX_WARMUP_BATCH_SIZE 8
+
+/** Maximum number of execution providers in fastembed_onnx_options_t
+ *
+ * Providers are tried in the listed order; the CPU provider is always the
+ * final fallback and does not need to be listed.
+ */
+#define FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS 4
+
+/** Token ID used to pad shorter sequences in a batch ([PAD] for BERT) */
+#define FASTEMBED_PAD_TOKEN_ID 0
+
+/** Default maximum characters per word for WordPiece tokenization
+ *
+ * Longer words are mapped to the unknown token without being split (same as
+ * max_input_chars_per_word in BERT tokenizers). tokenizer.json files can
+ * override it.
+ */
+#define FASTEMBED_TOKENIZER_MAX_WORD_CHARS 100
+
+/** Corpus block size in bytes for fastembed_similarity_matrix()
+ *
+ * Corpus rows are processed in blocks of about this size (sized to stay in
+ * L2 cache) and every query is scored against a block before moving on, so
+ * each corpus row is read from memory once per call instead of once per
+ * query.
+ */
+#define FASTEMBED_SIMILARITY_BLOCK_BYTES (256 * 1024)
+
+/** Minimum multiply-adds per thread in fastembed_similarity_matrix_threaded()
+ *
+ * Smaller matrices use fewer threads (down to one), since starting a thread
+ * costs more than scoring a few thousand vectors.
+ */
+#define FASTEMBED_SIMILARITY_MIN_WORK_PER_THREAD (1 << 22)
+
+/** Maximum threads used by fastembed_similarity_matrix_threaded() */
+#define FASTEMBED_SIMILARITY_MAX_THREADS 64
+
+/** Maximum threads in the shared batch thread pool (including the caller) */
+#define FASTEMBED_THREAD_POOL_MAX_THREADS 64
+
+/** Texts per work item in fastembed_batch_generate_parallel()
+ *
+ * Each pool thread takes this many texts at a time from its own range and
+ * steals half of another thread's remaining range when its own runs out.
+ * fastembed_model_batch_generate_parallel() uses
+ * FASTEMBED_ONNX_MAX_BATCH_SIZE texts per work item (one inference call).
+ */
+#define FASTEMBED_BATCH_GRAIN 16
+
+/** Byte alignment of matrices from fastembed_alloc_matrix()
+ *
+ * A cache line, and the widest SIMD load (AVX-512). Every supported hash
+ * dimension is a multiple of 16 floats, so each row of an aligned matrix is
+ * aligned too.
+ */
+#define FASTEMBED_MATRIX_ALIGNMENT 64
+
+/** Default neighbours per node in an HNSW index (fastembed_hnsw_options_t.m)
+ *
+ * Nodes keep up to m links on the upper levels and 2 * m on the bottom
+ * level. 16 is a good balance for 128-1024 dimensional embeddings; higher
+ * values raise recall at the cost of memory and insert time.
+ */
+#define FASTEMBED_HNSW_DEFAULT_M 16
+
+/** Largest accepted fastembed_hnsw_options_t.m */
+#define FASTEMBED_HNSW_MAX_M 64
+
+/** Default candidate list size while building an HNSW index */
+#define FASTEMBED_HNSW_DEFAULT_EF_CONSTRUCTION 200
+
+/** Default candidate list size while searching an HNSW index
+ *
+ * Searches keep max(ef_search, k) candidates; larger values raise recall
+ * and cost proportionally more time. Can be changed per index with
+ * fastembed_hnsw_set_ef_search().
+ */
+#define FASTEMBED_HNSW_DEFAULT_EF_SEARCH 64
+
+/** stdio buffer of a fastembed_store_writer_t in bytes
+ *
+ * Appends are gathered into writes of this size; each writer holds one.
+ */
+#define FASTEMBED_STORE_WRITE_BUFFER (1 << 20)
+
+/** Lock-striped shards of the in-memory embedding cache
+ *
+ * Each shard has its own mutex and 1/FASTEMBED_EMBEDDING_CACHE_SHARDS of
+ * the byte budget set with fastembed_embedding_cache_set_capacity().
+ */
+#define FASTEMBED_EMBEDDING_CACHE_SHARDS 16
+
+/** Maximum store files attached to the embedding cache at once */
+#define FASTEMBED_EMBEDDING_CACHE_MAX_STORES 4
+
+/** Counter slots of the instrumentation statistics
+ *
+ * Threads are assigned slots round-robin on first use, so up to this many
+ * threads record without sharing cache lines.
+ */
+#define FASTEMBED_STATS_THREAD_SLOTS 8
+
+/** Maximum JSON input buffer size in characters (for CLI tools)
+ *
+ * Also the initial read buffer of the CLI streaming mode (--stream).
+ */
 #define FASTEMBED_JSON_BUFFER_SIZE 65536
 
+/** Default records per batch in the CLI streaming mode (--batch)
+ *
+ * A batch is also cut short whenever no further complete input line is
+ * buffered, so interactive callers get each reply without waiting for a
+ * full batch.
+ */
+#define FASTEMBED_CLI_STREAM_BATCH 256
+
+/** Largest accepted --batch of the CLI streaming mode */
+#define FASTEMBED_CLI_STREAM_MAX_BATCH 8192
+
+/** Longest input line in bytes accepted by the CLI streaming mode
+ *
+ * Longer lines are skipped and reported as errors in the output.
+ */
+#define FASTEMBED_CLI_STREAM_MAX_LINE (1 << 20)
+
 /** Vocabulary size for tokenization (BERT base) */
 #define FASTEMBED_VOCAB_SIZE 30528
 
@@ -52,6 +52,18 @@ float hash_to_float_sqrt_asm(uint64_t hash);
 uint64_t generate_combined_hash_asm(const char *text, int text_length,
                                     int seed);
 
+/**
+ * @brief Generate hash embedding (internal, assembly)
+ * @param text Input text (null-terminated, max 8192 bytes)
+ * @param output Output embedding vector
+ * @param dimension Embedding dimension (128, 256, 512, 768, 1024, 2048)
+ * @return 0 on success, -1 on error
+ *
+ * output[i] equals hash_to_float_sqrt_asm(generate_combined_hash_asm(text,
+ * length, i)), computed in one pass over the text.
+ */
+int generate_embedding_asm(const char *text, float *output, int dimension);
+
 // Internal low-level functions from embedding_lib.asm
 /**
  * @brief Generate embedding (internal, low-level version)
@@ -0,0 +1,825 @@
+/**
+ * @file cli_stream.c
+ * @brief NDJSON streaming mode shared by the CLI tools
+ *
+ * The line reader works on a raw file descriptor so it can tell "nothing
+ * more is buffered" apart from "more input is coming": a batch is cut as
+ * soon as the buffered lines run out, and only then does the reader block
+ * for more input. Under a busy pipe one read() returns many lines and
+ * batches fill up; an interactive caller sending one line at a time gets
+ * one reply per line.
+ *
+ * Records are parsed straight into one concatenated text buffer plus an
+ * offsets array, the layout of fastembed_batch_generate_contiguous(), so a
+ * batch is embedded with a single call on the shared thread pool.
+ */
+
+#include "cli_stream.h"
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#define cli_read(fd, buffer, size) _read((fd), (buffer), (unsigned int)(size))
+#define CLI_STDIN_FD _fileno(stdin)
+#else
+#include <unistd.h>
+#define cli_read(fd, buffer, size) read((fd), (buffer), (size))
+#define CLI_STDIN_FD STDIN_FILENO
+#endif
+
+/* ============================================================================
+ * Options
+ * ============================================================================
+ */
+
+void cli_stream_options_init(cli_stream_options_t *options) {
+  options->enabled = 0;
+  options->batch_size = FASTEMBED_CLI_STREAM_BATCH;
+  options->num_threads = 0;
+  options->format = CLI_STREAM_NDJSON;
+}
+
+/* Parse a decimal integer in [min, max]; -1 on anything else */
+static int parse_int_value(const char *value, long min, long max,
+                           int *result) {
+  char *end;
+  errno = 0;
+  long parsed = strtol(value, &end, 10);
+  if (errno != 0 || end == value || *end != '\0' || parsed < min ||
+      parsed > max) {
+    return -1;
+  }
+  *result = (int)parsed;
+  return 0;
+}
+
+int cli_stream_parse_option(int argc, char **argv, int *index,
+                            cli_stream_options_t *options) {
+  const char *arg = argv[*index];
+
+  if (strcmp(arg, "--stream") == 0) {
+    options->enabled = 1;
+    (*index)++;
+    return 1;
+  }
+  if (strcmp(arg, "--batch") != 0 && strcmp(arg, "--threads") != 0 &&
+      strcmp(arg, "--format") != 0) {
+    return 0;
+  }
+  if (*index + 1 >= argc) {
+    fprintf(stderr, "{\"error\":\"Missing value for %s\"}\n", arg);
+    return -1;
+  }
+
+  const char *value = argv[*index + 1];
+  int ok;
+  if (strcmp(arg, "--batch") == 0) {
+    ok = parse_int_value(value, 1, FASTEMBED_CLI_STREAM_MAX_BATCH,
+                         &options->batch_size) == 0;
+  } else if (strcmp(arg, "--threads") == 0) {
+    ok = parse_int_value(value, 0, FASTEMBED_THREAD_POOL_MAX_THREADS,
+                         &options->num_threads) == 0;
+  } else if (strcmp(value, "ndjson") == 0) {
+    options->format = CLI_STREAM_NDJSON;
+    ok = 1;
+  } else if (strcmp(value, "f32le") == 0) {
+    options->format = CLI_STREAM_F32LE;
+    ok = 1;
+  } else {
+    ok = 0;
+  }
+  if (!ok) {
+    fprintf(stderr, "{\"error\":\"Invalid value for %s\"}\n", arg);
+    return -1;
+  }
+  *index += 2;
+  return 1;
+}
+
+/* ============================================================================
+ * Line reader
+ * ============================================================================
+ */
+
+int cli_line_reader_init(cli_line_reader_t *reader) {
+  memset(reader, 0, sizeof(*reader));
+  reader->fd = CLI_STDIN_FD;
+  reader->capacity = FASTEMBED_JSON_BUFFER_SIZE;
+  reader->data = (char *)malloc(reader->capacity);
+  return reader->data ? 0 : -1;
+}
+
+void cli_line_reader_free(cli_line_reader_t *reader) {
+  free(reader->data);
+  reader->data = NULL;
+}
+
+/* Hand out data[begin, end) as a line and move past the terminator */
+static int take_line(cli_line_reader_t *reader, size_t end, size_t next,
+                     char **line, size_t *length) {
+  char *start = reader->data + reader->begin;
+  size_t size = end - reader->begin;
+
+  reader->begin = next;
+  reader->scanned = 0;
+  if (size > FASTEMBED_CLI_STREAM_MAX_LINE) {
+    return CLI_LINE_TOO_LONG;
+  }
+  if (size > 0 && start[size - 1] == '\r') {
+    size--;
+  }
+  start[size] = '\0';
+  *line = start;
+  *length = size;
+  return CLI_LINE_READY;
+}
+
+int cli_line_reader_next(cli_line_reader_t *reader, int wait, char **line,
+                         size_t *length) {
+  for (;;) {
+    size_t pending = reader->end - reader->begin;
+    const char *newline =
+        (const char *)memchr(reader->data + reader->begin + reader->scanned,
+                             '\n', pending - reader->scanned);
+
+    if (newline) {
+      size_t end = (size_t)(newline - reader->data);
+      if (reader->skipping) {
+        reader->skipping = 0;
+        reader->begin = end + 1;
+        reader->scanned = 0;
+        return CLI_LINE_TOO_LONG;
+      }
+      return take_line(reader, end, end + 1, line, length);
+    }
+    reader->scanned = pending;
+
+    if (reader->eof) {
+      if (reader->skipping) {
+        reader->skipping = 0;
+        return CLI_LINE_TOO_LONG;
+      }
+      if (pending == 0) {
+        return CLI_LINE_END;
+      }
+      return take_line(reader, reader->end, reader->end, line, length);
+    }
+
+    /* Drop the buffered part of a line that can no longer fit */
+    if (reader->skipping || pending > FASTEMBED_CLI_STREAM_MAX_LINE) {
+      reader->skipping = 1;
+      reader->begin = reader->end = reader->scanned = 0;
+    }
+    if (!wait) {
+      return CLI_LINE_WOULD_BLOCK;
+    }
+
+    /* Move the partial line to the front; keep one byte for the NUL */
+    if (reader->begin > 0) {
+      memmove(reader->data, reader->data + reader->begin,
+              reader->end - reader->begin);
+      reader->end -= reader->begin;
+      reader->begin = 0;
+    }
+    if (reader->capacity - reader->end - 1 == 0) {
+      char *grown = (char *)realloc(reader->data, reader->capacity * 2);
+      if (!grown) {
+        return CLI_LINE_ERROR;
+      }
+      reader->data = grown;
+      reader->capacity *= 2;
+    }
+
+    long received = (long)cli_read(reader->fd, reader->data + reader->end,
+                                   reader->capacity - reader->end - 1);
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return CLI_LINE_ERROR;
+    }
+    if (received == 0) {
+      reader->eof = 1;
+    }
+    reader->end += (size_t)received;
+  }
+}
+
+/* ============================================================================
+ * Growable byte buffer
+ * ============================================================================
+ */
+
+typedef struct {
+  char *data;
+  size_t size;
+  size_t capacity;
+} stream_buffer_t;
+
+static int buffer_reserve(stream_buffer_t *buffer, size_t extra) {
+  if (buffer->size + extra <= buffer->capacity) {
+    return 0;
+  }
+  size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+  while (capacity < buffer->size + extra) {
+    capacity *= 2;
+  }
+  char *grown = (char *)realloc(buffer->data, capacity);
+  if (!grown) {
+    return -1;
+  }
+  buffer->data = grown;
+  buffer->capacity = capacity;
+  return 0;
+}
+
+static int buffer_append(stream_buffer_t *buffer, const void *bytes,
+                         size_t size) {
+  if (buffer_reserve(buffer, size) != 0) {
+    return -1;
+  }
+  memcpy(buffer->data + buffer->size, bytes, size);
+  buffer->size += size;
+  return 0;
+}
+
+static int buffer_append_string(stream_buffer_t *buffer, const char *text) {
+  return buffer_append(buffer, text, strlen(text));
+}
+
+/* ============================================================================
+ * Record parsing
+ * ============================================================================
+ */
+
+static const char *json_skip_ws(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+    p++;
+  }
+  return p;
+}
+
+/* p at the opening quote; returns the byte after the closing quote */
+static const char *json_skip_string(const char *p, const char *end) {
+  for (p++; p < end; p++) {
+    if (*p == '\\') {
+      p++;
+    } else if (*p == '"') {
+      return p + 1;
+    }
+  }
+  return NULL;
+}
+
+/* Skip any JSON value (nesting is matched, scalars are not validated) */
+static const char *json_skip_value(const char *p, const char *end) {
+  if (p == end) {
+    return NULL;
+  }
+  if (*p == '"') {
+    return json_skip_string(p, end);
+  }
+  if (*p == '{' || *p == '[') {
+    int depth = 0;
+    while (p < end) {
+      if (*p == '"') {
+        p = json_skip_string(p, end);
+        if (!p) {
+          return NULL;
+        }
+        continue;
+      }
+      if (*p == '{' || *p == '[') {
+        depth++;
+      } else if ((*p == '}' || *p == ']') && --depth == 0) {
+        return p + 1;
+      }
+      p++;
+    }
+    return NULL;
+  }
+
+  const char *start = p;
+  while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' &&
+         *p != '\t' && *p != '\r' && *p != '\n') {
+    p++;
+  }
+  return p > start ? p : NULL;
+}
+
+static int hex_value(const char *p, const char *end, unsigned *value) {
+  if (end - p < 4) {
+    return -1;
+  }
+  *value = 0;
+  for (int i = 0; i < 4; i++) {
+    char c = p[i];
+    unsigned digit;
+    if (c >= '0' && c <= '9') {
+      digit = (unsigned)(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      digit = (unsigned)(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      digit = (unsigned)(c - 'A' + 10);
+    } else {
+      return -1;
+    }
+    *value = (*value << 4) | digit;
+  }
+  return 0;
+}
+
+static int append_utf8(stream_buffer_t *out, unsigned code) {
+  char bytes[4];
+  size_t size;
+  if (code < 0x80) {
+    bytes[0] = (char)code;
+    size = 1;
+  } else if (code < 0x800) {
+    bytes[0] = (char)(0xC0 | (code >> 6));
+    bytes[1] = (char)(0x80 | (code & 0x3F));
+    size = 2;
+  } else if (code < 0x10000) {
+    bytes[0] = (char)(0xE0 | (code >> 12));
+    bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+    bytes[2] = (char)(0x80 | (code & 0x3F));
+    size = 3;
+  } else {
+    bytes[0] = (char)(0xF0 | (code >> 18));
+    bytes[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    bytes[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    bytes[3] = (char)(0x80 | (code & 0x3F));
+    size = 4;
+  }
+  return buffer_append(out, bytes, size);
+}
+
+/* Decode the JSON string at p (opening quote) and append it to out */
+static const char *json_decode_string(const char *p, const char *end,
+                                      stream_buffer_t *out) {
+  for (p++; p < end;) {
+    const char *run = p;
+    while (p < end && *p != '"' && *p != '\\') {
+      p++;
+    }
+    if (buffer_append(out, run, (size_t)(p - run)) != 0 || p == end) {
+      return NULL;
+    }
+    if (*p == '"') {
+      return p + 1;
+    }
+
+    /* Escape sequence */
+    if (++p == end) {
+      return NULL;
+    }
+    char c = *p++;
+    char simple;
+    switch (c) {
+    case '"':
+    case '\\':
+    case '/':
+      simple = c;
+      break;
+    case 'b':
+      simple = '\b';
+      break;
+    case 'f':
+      simple = '\f';
+      break;
+    case 'n':
+      simple = '\n';
+      break;
+    case 'r':
+      simple = '\r';
+      break;
+    case 't':
+      simple = '\t';
+      break;
+    case 'u': {
+      unsigned code;
+      if (hex_value(p, end, &code) != 0) {
+        return NULL;
+      }
+      p += 4;
+      if (code >= 0xD800 && code <= 0xDBFF) {
+        unsigned low;
+        if (end - p < 6 || p[0] != '\\' || p[1] != 'u' ||
+            hex_value(p + 2, end, &low) != 0 || low < 0xDC00 ||
+            low > 0xDFFF) {
+          return NULL;
+        }
+        p += 6;
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+      } else if (code >= 0xDC00 && code <= 0xDFFF) {
+        return NULL;
+      }
+      if (append_utf8(out, code) != 0) {
+        return NULL;
+      }
+      continue;
+    }
+    default:
+      return NULL;
+    }
+    if (buffer_append(out, &simple, 1) != 0) {
+      return NULL;
+    }
+  }
+  return NULL;
+}
+
+static const char *const ERROR_INVALID_JSON = "Invalid JSON record";
+static const char *const ERROR_MISSING_TEXT = "Record has no text string";
+static const char *const ERROR_TEXT_TOO_LONG = "Text exceeds maximum length";
+static const char *const ERROR_LINE_TOO_LONG = "Input line too long";
+static const char *const ERROR_INVALID_TEXT = "Empty text or NUL character";
+static const char *const ERROR_GENERATION = "Failed to generate embedding";
+
+/* Key at p (opening quote) equals name (keys are compared undecoded) */
+static int key_equals(const char *p, const char *key_end, const char *name) {
+  size_t size = (size_t)(key_end - p) - 2;
+  return strlen(name) == size && memcmp(p + 1, name, size) == 0;
+}
+
+/* Members of an object after its '{'; returns the byte after the '}' */
+static const char *parse_members(const char *p, const char *end,
+                                 stream_buffer_t *text, size_t text_start,
+                                 int *has_text, const char **id,
+                                 size_t *id_length) {
+  for (;;) {
+    if (p == end || *p != '"') {
+      return NULL;
+    }
+    const char *key = p;
+    const char *key_end = json_skip_string(p, end);
+    if (!key_end) {
+      return NULL;
+    }
+    p = json_skip_ws(key_end, end);
+    if (p == end || *p != ':') {
+      return NULL;
+    }
+    p = json_skip_ws(p + 1, end);
+
+    if (key_equals(key, key_end, "text") && p < end && *p == '"') {
+      text->size = text_start; /* A repeated key wins */
+      p = json_decode_string(p, end, text);
+      *has_text = p != NULL;
+    } else {
+      const char *value = p;
+      p = json_skip_value(p, end);
+      if (p && key_equals(key, key_end, "id")) {
+        *id = value;
+        *id_length = (size_t)(p - value);
+      }
+    }
+    if (!p) {
+      return NULL;
+    }
+
+    p = json_skip_ws(p, end);
+    if (p < end && *p == ',') {
+      p = json_skip_ws(p + 1, end);
+    } else if (p < end && *p == '}') {
+      return p + 1;
+    } else {
+      return NULL;
+    }
+  }
+}
+
+/**
+ * Parse one record, appending its text to text. On error the text buffer is
+ * left as it was and the error message is returned; NULL on success.
+ */
+static const char *parse_record(const char *line, size_t length,
+                                stream_buffer_t *text, const char **id,
+                                size_t *id_length) {
+  const char *end = line + length;
+  const char *p = json_skip_ws(line, end);
+  size_t text_start = text->size;
+  int has_text = 0;
+
+  *id = NULL;
+  *id_length = 0;
+
+  if (p < end && *p == '"') {
+    p = json_decode_string(p, end, text);
+    has_text = p != NULL;
+  } else if (p < end && *p == '{') {
+    p = json_skip_ws(p + 1, end);
+    if (p < end && *p == '}') {
+      p++;
+    } else {
+      p = parse_members(p, end, text, text_start, &has_text, id, id_length);
+    }
+  } else {
+    p = NULL;
+  }
+
+  if (p && json_skip_ws(p, end) != end) {
+    p = NULL;
+  }
+  if (!p || !has_text) {
+    text->size = text_start;
+    *id = NULL;
+    *id_length = 0;
+    return p ? ERROR_MISSING_TEXT : ERROR_INVALID_JSON;
+  }
+  if (text->size - text_start > FASTEMBED_MAX_TEXT_LENGTH) {
+    text->size = text_start;
+    return ERROR_TEXT_TOO_LONG;
+  }
+  return NULL;
+}
+
+/* ============================================================================
+ * Embedding stream
+ * ============================================================================
+ */
+
+/** One batch of records in input order */
+typedef struct {
+  int capacity;
+  int count;
+  stream_buffer_t text;  /* Concatenated texts */
+  stream_buffer_t ids;   /* Concatenated raw JSON ids */
+  int32_t *offsets;      /* capacity + 1 text offsets */
+  size_t *id_offsets;    /* Start of each id in ids */
+  size_t *id_lengths;    /* 0 = record has no id */
+  const char **errors;   /* Parse error per record, NULL if parsed */
+  int *statuses;         /* fastembed_status_t per record */
+  float *output;         /* capacity * dimension */
+  stream_buffer_t lines; /* NDJSON output of the batch */
+} stream_batch_t;
+
+static void batch_free(stream_batch_t *batch) {
+  free(batch->text.data);
+  free(batch->ids.data);
+  free(batch->lines.data);
+  free(batch->offsets);
+  free(batch->id_offsets);
+  free(batch->id_lengths);
+  free((void *)batch->errors);
+  free(batch->statuses);
+  fastembed_free_matrix(batch->output);
+}
+
+static int batch_init(stream_batch_t *batch, int capacity, int dimension) {
+  memset(batch, 0, sizeof(*batch));
+  batch->capacity = capacity;
+  batch->offsets = (int32_t *)malloc(sizeof(int32_t) * (capacity + 1));
+  batch->id_offsets = (size_t *)malloc(sizeof(size_t) * capacity);
+  batch->id_lengths = (size_t *)malloc(sizeof(size_t) * capacity);
+  batch->errors = (const char **)malloc(sizeof(char *) * capacity);
+  batch->statuses = (int *)malloc(sizeof(int) * capacity);
+  batch->output = fastembed_alloc_matrix(capacity, dimension);
+  /* The embed callbacks reject a NULL text buffer, even for empty texts */
+  if (buffer_reserve(&batch->text, 1) != 0 || !batch->offsets || !batch->id_offsets || !batch->id_lengths ||
+      !batch->errors || !batch->statuses || !batch->output) {
+    batch_free(batch);
+    return -1;
+  }
+  return 0;
+}
+
+static void batch_reset(stream_batch_t *batch) {
+  batch->count = 0;
+  batch->text.size = 0;
+  batch->ids.size = 0;
+  batch->offsets[0] = 0;
+}
+
+/* Add one input line (or an overlong-line placeholder) to the batch */
+static int batch_add(stream_batch_t *batch, const char *line, size_t length,
+                     int too_long) {
+  int i = batch->count;
+  const char *id = NULL;
+  size_t id_length = 0;
+
+  batch->errors[i] = too_long ? ERROR_LINE_TOO_LONG
+                              : parse_record(line, length, &batch->text, &id,
+                                             &id_length);
+  batch->id_offsets[i] = batch->ids.size;
+  batch->id_lengths[i] = id_length;
+  if (id_length > 0 && buffer_append(&batch->ids, id, id_length) != 0) {
+    return -1;
+  }
+  batch->offsets[i + 1] = (int32_t)batch->text.size;
+  batch->count++;
+  return 0;
+}
+
+static int is_blank(const char *line, size_t length) {
+  return json_skip_ws(line, line + length) == line + length;
+}
+
+static int host_is_little_endian(void) {
+  const uint16_t probe = 1;
+  return *(const uint8_t *)&probe == 1;
+}
+
+/* Start of an NDJSON object: {"index":N[,"id":...] */
+static int append_record_head(stream_buffer_t *out,
+                              const stream_batch_t *batch, int i,
+                              long long index) {
+  char head[48];
+  snprintf(head, sizeof(head), "{\"index\":%lld", index);
+  if (buffer_append_string(out, head) != 0) {
+    return -1;
+  }
+  if (batch->id_lengths[i] > 0) {
+    if (buffer_append_string(out, ",\"id\":") != 0 ||
+        buffer_append(out, batch->ids.data + batch->id_offsets[i],
+                      batch->id_lengths[i]) != 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+static const char *record_error(const stream_batch_t *batch, int i) {
+  if (batch->errors[i]) {
+    return batch->errors[i];
+  }
+  if (batch->statuses[i] == FASTEMBED_STATUS_OK) {
+    return NULL;
+  }
+  return batch->statuses[i] == FASTEMBED_STATUS_INVALID_TEXT
+             ? ERROR_INVALID_TEXT
+             : ERROR_GENERATION;
+}
+
+static int write_ndjson(stream_batch_t *batch, int dimension,
+                        long long first_index) {
+  stream_buffer_t *out = &batch->lines;
+  out->size = 0;
+
+  for (int i = 0; i < batch->count; i++) {
+    const char *error = record_error(batch, i);
+    if (append_record_head(out, batch, i, first_index + i) != 0) {
+      return -1;
+    }
+    if (error) {
+      if (buffer_append_string(out, ",\"error\":\"") != 0 ||
+          buffer_append_string(out, error) != 0 ||
+          buffer_append_string(out, "\"}\n") != 0) {
+        return -1;
+      }
+      continue;
+    }
+
+    /* Up to 16 bytes per "%.6f," of a unit-length embedding */
+    const float *row = batch->output + (size_t)i * dimension;
+    if (buffer_append_string(out, ",\"embedding\":[") != 0 ||
+        buffer_reserve(out, (size_t)dimension * 16 + 4) != 0) {
+      return -1;
+    }
+    for (int d = 0; d < dimension; d++) {
+      if (buffer_reserve(out, 32) != 0) {
+        return -1;
+      }
+      int written = snprintf(out->data + out->size, 32,
+                             d + 1 < dimension ? "%.6f," : "%.6f",
+                             (double)row[d]);
+      out->size += (size_t)written;
+    }
+    if (buffer_append_string(out, "]}\n") != 0) {
+      return -1;
+    }
+  }
+  return fwrite(out->data, 1, out->size, stdout) == out->size ? 0 : -1;
+}
+
+static int write_f32le(stream_batch_t *batch, int dimension,
+                       long long first_index) {
+  for (int i = 0; i < batch->count; i++) {
+    const char *error = record_error(batch, i);
+    if (!error) {
+      continue;
+    }
+    memset(batch->output + (size_t)i * dimension, 0,
+           sizeof(float) * dimension);
+    fprintf(stderr, "{\"index\":%lld,\"error\":\"%s\"}\n", first_index + i,
+            error);
+  }
+
+  size_t values = (size_t)batch->count * dimension;
+  if (!host_is_little_endian()) {
+    uint8_t *bytes = (uint8_t *)batch->output;
+    for (size_t v = 0; v < values; v++, bytes += 4) {
+      uint8_t swap = bytes[0];
+      bytes[0] = bytes[3];
+      bytes[3] = swap;
+      swap = bytes[1];
+      bytes[1] = bytes[2];
+      bytes[2] = swap;
+    }
+  }
+  return fwrite(batch->output, sizeof(float), values, stdout) == values ? 0
+                                                                         : -1;
+}
+
+static int process_batch(const cli_stream_options_t *options, int dimension,
+                         cli_embed_fn embed, void *user_data,
+                         stream_batch_t *batch, long long first_index) {
+  int parsed = 0;
+  for (int i = 0; i < batch->count; i++) {
+    batch->statuses[i] = FASTEMBED_STATUS_INVALID_TEXT;
+    parsed += batch->errors[i] == NULL;
+  }
+
+  /* Unparsed records are empty spans; their statuses are overridden */
+  if (parsed > 0 &&
+      embed(user_data, batch->text.data, batch->offsets, batch->count,
+            batch->output, batch->statuses, options->num_threads) < 0) {
+    fprintf(stderr, "{\"error\":\"Failed to generate embeddings\"}\n");
+    return -1;
+  }
+
+  int result = options->format == CLI_STREAM_F32LE
+                   ? write_f32le(batch, dimension, first_index)
+                   : write_ndjson(batch, dimension, first_index);
+  if (result != 0 || fflush(stdout) != 0) {
+    fprintf(stderr, "{\"error\":\"Failed to write output\"}\n");
+    return -1;
+  }
+  return 0;
+}
+
+int cli_stream_embeddings(const cli_stream_options_t *options, int dimension,
+                          cli_embed_fn embed, void *user_data) {
+  cli_line_reader_t reader;
+  stream_batch_t batch;
+
+  if (cli_line_reader_init(&reader) != 0) {
+    fprintf(stderr, "{\"error\":\"Out of memory\"}\n");
+    return 1;
+  }
+  if (batch_init(&batch, options->batch_size, dimension) != 0) {
+    cli_line_reader_free(&reader);
+    fprintf(stderr, "{\"error\":\"Out of memory\"}\n");
+    return 1;
+  }
+#ifdef _WIN32
+  if (options->format == CLI_STREAM_F32LE) {
+    _setmode(_fileno(stdout), _O_BINARY);
+  }
+#endif
+
+  long long next_index = 0;
+  int exit_code = 0;
+  int done = 0;
+
+  while (!done) {
+    batch_reset(&batch);
+
+    /* Block only for the first record; cut the batch when input runs dry */
+    while (batch.count < batch.capacity) {
+      char *line;
+      size_t length;
+      int status = cli_line_reader_next(&reader, batch.count == 0, &line,
+                                        &length);
+      if (status == CLI_LINE_WOULD_BLOCK) {
+        break;
+      }
+      if (status == CLI_LINE_END || status == CLI_LINE_ERROR) {
+        if (status == CLI_LINE_ERROR) {
+          fprintf(stderr, "{\"error\":\"Failed to read input\"}\n");
+          exit_code = 1;
+        }
+        done = 1;
+        break;
+      }
+      if (status == CLI_LINE_READY && is_blank(line, length)) {
+        continue;
+      }
+      if (batch_add(&batch, line, length, status == CLI_LINE_TOO_LONG) != 0) {
+        fprintf(stderr, "{\"error\":\"Out of memory\"}\n");
+        exit_code = 1;
+        done = 1;
+        break;
+      }
+    }
+
+    if (batch.count > 0 &&
+        process_batch(options, dimension, embed, user_data, &batch,
+                      next_index) != 0) {
+      exit_code = 1;
+      break;
+    }
+    next_index += batch.count;
+  }
+
+  batch_free(&batch);
+  cli_line_reader_free(&reader);
+  return exit_code;
+}
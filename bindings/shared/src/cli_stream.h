@@ -0,0 +1,144 @@
+/**
+ * @file cli_stream.h
+ * @brief NDJSON streaming mode shared by the CLI tools
+ *
+ * With --stream the CLI tools stay running and process one JSON record per
+ * input line until end of input, so a pipeline pays the process start and
+ * model load once instead of once per record. Lines are read in large
+ * chunks and grouped into batches: a batch ends when it holds --batch
+ * records or when no further complete line is buffered, so both bulk pipes
+ * and interactive request/reply callers are served without extra latency.
+ * Results are written in input order and flushed after every batch.
+ *
+ * Internal header - not part of the public API.
+ */
+
+#ifndef FASTEMBED_CLI_STREAM_H
+#define FASTEMBED_CLI_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Output encoding of the embedding streaming mode
+ */
+typedef enum {
+  CLI_STREAM_NDJSON = 0, /**< One JSON object per record */
+  CLI_STREAM_F32LE = 1,  /**< Raw little-endian float32 rows, no framing */
+} cli_stream_format_t;
+
+/**
+ * @brief Options of the embedding streaming mode
+ */
+typedef struct {
+  int enabled;     /**< --stream was given */
+  int batch_size;  /**< Records per batch (--batch) */
+  int num_threads; /**< Batch threads, including the caller (0 = whole pool) */
+  int format;      /**< cli_stream_format_t (--format) */
+} cli_stream_options_t;
+
+/**
+ * @brief Reset options to the defaults (streaming off,
+ * FASTEMBED_CLI_STREAM_BATCH records per batch, whole pool, NDJSON)
+ */
+void cli_stream_options_init(cli_stream_options_t *options);
+
+/**
+ * @brief Parse one streaming option at argv[*index]
+ *
+ * Recognizes --stream, --batch N, --threads N and --format ndjson|f32le
+ * and advances *index past the option and its value.
+ *
+ * @return 1 if an option was consumed, 0 if argv[*index] is not a streaming
+ * option, -1 on a missing or invalid value (reported on stderr)
+ */
+int cli_stream_parse_option(int argc, char **argv, int *index,
+                            cli_stream_options_t *options);
+
+/**
+ * @brief Embed a batch of concatenated texts
+ *
+ * Same contract as fastembed_batch_generate_contiguous(): text i is
+ * text_data[offsets[i], offsets[i + 1]), its embedding is row i of output
+ * and its fastembed_status_t is statuses[i].
+ *
+ * @return Number of failed texts, -1 if the whole call failed
+ */
+typedef int (*cli_embed_fn)(void *user_data, const char *text_data,
+                            const int32_t *offsets, int count, float *output,
+                            int *statuses, int num_threads);
+
+/**
+ * @brief Run the embedding streaming mode on stdin/stdout
+ *
+ * Each non-blank input line is a JSON string or an object with a "text"
+ * string and an optional "id" (any JSON value, echoed back verbatim).
+ *
+ * NDJSON output is one line per record, in input order:
+ * {"index":N,"id":...,"embedding":[...]} or {"index":N,"id":...,
+ * "error":"..."}, where N counts records from 0. f32le output is one row of
+ * dimension floats per record; failed records give a zero row and an
+ * NDJSON error object on stderr.
+ *
+ * @param options Streaming options
+ * @param dimension Floats per embedding
+ * @param embed Batch embedding callback
+ * @param user_data Passed to embed
+ * @return 0 at end of input, 1 on a read/write error or if embed fails
+ * as a whole
+ */
+int cli_stream_embeddings(const cli_stream_options_t *options, int dimension,
+                          cli_embed_fn embed, void *user_data);
+
+/**
+ * @brief Result of cli_line_reader_next()
+ */
+typedef enum {
+  CLI_LINE_READY = 1,       /**< *line holds the next line */
+  CLI_LINE_END = 0,         /**< End of input */
+  CLI_LINE_WOULD_BLOCK = 2, /**< No complete line buffered (wait == 0) */
+  CLI_LINE_TOO_LONG = 3,    /**< A line over FASTEMBED_CLI_STREAM_MAX_LINE
+                                 bytes was skipped */
+  CLI_LINE_ERROR = -1,      /**< Read error */
+} cli_line_status_t;
+
+/**
+ * @brief Buffered line reader over the stdin file descriptor
+ *
+ * Reads in chunks of at least FASTEMBED_JSON_BUFFER_SIZE bytes and grows up
+ * to FASTEMBED_CLI_STREAM_MAX_LINE bytes per line.
+ */
+typedef struct {
+  int fd;
+  char *data;
+  size_t capacity;
+  size_t begin;   /* First unread byte */
+  size_t end;     /* One past the last buffered byte */
+  size_t scanned; /* Bytes after begin known not to contain '\n' */
+  int eof;
+  int skipping; /* Dropping the rest of an overlong line */
+} cli_line_reader_t;
+
+/**
+ * @brief Start reading lines from stdin
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+int cli_line_reader_init(cli_line_reader_t *reader);
+
+void cli_line_reader_free(cli_line_reader_t *reader);
+
+/**
+ * @brief Return the next input line
+ *
+ * On CLI_LINE_READY, *line is the line without its "\n" or "\r\n",
+ * null-terminated and writable; it stays valid until the next call with
+ * wait != 0.
+ *
+ * @param wait Nonzero to block for input; 0 to return CLI_LINE_WOULD_BLOCK
+ * instead of reading when no complete line is buffered
+ */
+int cli_line_reader_next(cli_line_reader_t *reader, int wait, char **line,
+                         size_t *length);
+
+#endif /* FASTEMBED_CLI_STREAM_H */
@@ -0,0 +1,643 @@
+/**
+ * @file embedding_cache.c
+ * @brief Sharded LRU embedding cache with a persistent store-file tier
+ *
+ * Each shard is a chained hash table (power-of-two buckets, doubled when
+ * the entry count reaches the bucket count) threaded on a doubly linked LRU
+ * list, guarded by its own mutex. A key selects its shard from the high
+ * bits and its bucket from the low bits, so a shard's buckets stay evenly
+ * filled.
+ *
+ * Attached stores are searched by binary search on their sorted id table
+ * (the cache key) under g_cache_mutex; the mapped vectors are never copied
+ * except for hits.
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+#include "embedding_cache.h"
+#include "fastembed_platform.h"
+
+/* ------------------------------------------------------------------------ */
+/* XXH64                                                                     */
+/* ------------------------------------------------------------------------ */
+
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+static uint64_t xxh_rotl(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t xxh_read64(const unsigned char *p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static uint32_t xxh_read32(const unsigned char *p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static uint64_t xxh_round(uint64_t acc, uint64_t input) {
+  acc += input * XXH_PRIME64_2;
+  acc = xxh_rotl(acc, 31);
+  return acc * XXH_PRIME64_1;
+}
+
+static uint64_t xxh_merge_round(uint64_t acc, uint64_t value) {
+  acc ^= xxh_round(0, value);
+  return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+/** XXH64 of data (input words read in native byte order) */
+static uint64_t xxh64(const void *data, size_t length, uint64_t seed) {
+  const unsigned char *p = (const unsigned char *)data;
+  const unsigned char *end = p + length;
+  uint64_t hash;
+
+  if (length >= 32) {
+    const unsigned char *limit = end - 32;
+    uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    uint64_t v2 = seed + XXH_PRIME64_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - XXH_PRIME64_1;
+    do {
+      v1 = xxh_round(v1, xxh_read64(p));
+      v2 = xxh_round(v2, xxh_read64(p + 8));
+      v3 = xxh_round(v3, xxh_read64(p + 16));
+      v4 = xxh_round(v4, xxh_read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    hash = xxh_rotl(v1, 1) + xxh_rotl(v2, 7) + xxh_rotl(v3, 12) +
+           xxh_rotl(v4, 18);
+    hash = xxh_merge_round(hash, v1);
+    hash = xxh_merge_round(hash, v2);
+    hash = xxh_merge_round(hash, v3);
+    hash = xxh_merge_round(hash, v4);
+  } else {
+    hash = seed + XXH_PRIME64_5;
+  }
+
+  hash += (uint64_t)length;
+  while (p + 8 <= end) {
+    hash ^= xxh_round(0, xxh_read64(p));
+    hash = xxh_rotl(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    p += 8;
+  }
+  if (p + 4 <= end) {
+    hash ^= (uint64_t)xxh_read32(p) * XXH_PRIME64_1;
+    hash = xxh_rotl(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+    p += 4;
+  }
+  while (p < end) {
+    hash ^= (uint64_t)(*p) * XXH_PRIME64_5;
+    hash = xxh_rotl(hash, 11) * XXH_PRIME64_1;
+    p++;
+  }
+
+  hash ^= hash >> 33;
+  hash *= XXH_PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= XXH_PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+uint64_t embedding_cache_seed(const char *model_id, const char *tokenizer_id,
+                              int pooling, int dimension) {
+  uint64_t seed = xxh64(model_id, strlen(model_id), 0);
+  if (tokenizer_id) {
+    seed = xxh64(tokenizer_id, strlen(tokenizer_id), seed);
+  }
+  int32_t config[2] = {pooling, dimension};
+  return xxh64(config, sizeof(config), seed);
+}
+
+uint64_t embedding_cache_key(uint64_t seed, const char *text, size_t length) {
+  return xxh64(text, length, seed);
+}
+
+/* ------------------------------------------------------------------------ */
+/* State                                                                     */
+/* ------------------------------------------------------------------------ */
+
+#define CACHE_INITIAL_BUCKETS 64
+
+typedef struct cache_entry {
+  uint64_t key;
+  struct cache_entry *hash_next;
+  struct cache_entry *lru_prev; /* Towards the most recently used end */
+  struct cache_entry *lru_next;
+  int dimension;
+  float vector[];
+} cache_entry_t;
+
+typedef struct {
+  fastembed_mutex_t mutex;
+  cache_entry_t **buckets;
+  size_t bucket_count; /* 0 or a power of two */
+  size_t entry_count;
+  cache_entry_t *lru_head; /* Most recently used */
+  cache_entry_t *lru_tail;
+  size_t bytes;
+  size_t budget;
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t insertions;
+  uint64_t evictions;
+} cache_shard_t;
+
+typedef struct {
+  fastembed_store_t *store;
+  const int64_t *ids; /* Sorted cache keys */
+  const float *vectors;
+  int count;
+  int dimension;
+} cache_store_t;
+
+/*
+ * g_cache_mutex guards the configuration, shard setup and the attached
+ * stores; each shard's mutex guards its table. The two are never held
+ * together by lookups or inserts.
+ */
+static fastembed_mutex_t g_cache_mutex = FASTEMBED_MUTEX_INITIALIZER;
+static cache_shard_t g_shards[FASTEMBED_EMBEDDING_CACHE_SHARDS];
+static int32_t g_shards_ready = 0;
+static int32_t g_cache_enabled = 0;
+static size_t g_capacity = 0;
+static cache_store_t g_stores[FASTEMBED_EMBEDDING_CACHE_MAX_STORES];
+static int32_t g_store_count = 0;
+static uint64_t g_store_hits = 0;
+
+/** Called with g_cache_mutex held */
+static void cache_init_shards(void) {
+  if (g_shards_ready) {
+    return;
+  }
+  fastembed_mutex_t mutex_init = FASTEMBED_MUTEX_INITIALIZER;
+  for (int i = 0; i < FASTEMBED_EMBEDDING_CACHE_SHARDS; i++) {
+    memset(&g_shards[i], 0, sizeof(g_shards[i]));
+    g_shards[i].mutex = mutex_init;
+  }
+  fastembed_atomic_store(&g_shards_ready, 1);
+}
+
+/** Called with g_cache_mutex held */
+static void cache_update_enabled(void) {
+  fastembed_atomic_store(&g_cache_enabled,
+                         g_capacity > 0 || g_store_count > 0);
+}
+
+int embedding_cache_enabled(void) {
+  return fastembed_atomic_load(&g_cache_enabled);
+}
+
+static cache_shard_t *cache_shard(uint64_t key) {
+  return &g_shards[(key >> 32) % FASTEMBED_EMBEDDING_CACHE_SHARDS];
+}
+
+static size_t cache_entry_bytes(int dimension) {
+  return sizeof(cache_entry_t) + (size_t)dimension * sizeof(float);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Shard tables (called with the shard mutex held)                           */
+/* ------------------------------------------------------------------------ */
+
+static cache_entry_t *shard_find(const cache_shard_t *shard, uint64_t key) {
+  if (shard->bucket_count == 0) {
+    return NULL;
+  }
+  cache_entry_t *entry = shard->buckets[key & (shard->bucket_count - 1)];
+  while (entry && entry->key != key) {
+    entry = entry->hash_next;
+  }
+  return entry;
+}
+
+static void shard_lru_unlink(cache_shard_t *shard, cache_entry_t *entry) {
+  if (entry->lru_prev) {
+    entry->lru_prev->lru_next = entry->lru_next;
+  } else {
+    shard->lru_head = entry->lru_next;
+  }
+  if (entry->lru_next) {
+    entry->lru_next->lru_prev = entry->lru_prev;
+  } else {
+    shard->lru_tail = entry->lru_prev;
+  }
+}
+
+static void shard_lru_push_front(cache_shard_t *shard, cache_entry_t *entry) {
+  entry->lru_prev = NULL;
+  entry->lru_next = shard->lru_head;
+  if (shard->lru_head) {
+    shard->lru_head->lru_prev = entry;
+  } else {
+    shard->lru_tail = entry;
+  }
+  shard->lru_head = entry;
+}
+
+static void shard_remove(cache_shard_t *shard, cache_entry_t *entry) {
+  cache_entry_t **link = &shard->buckets[entry->key & (shard->bucket_count - 1)];
+  while (*link != entry) {
+    link = &(*link)->hash_next;
+  }
+  *link = entry->hash_next;
+  shard_lru_unlink(shard, entry);
+  shard->entry_count--;
+  shard->bytes -= cache_entry_bytes(entry->dimension);
+  free(entry);
+}
+
+/** Evict least recently used entries until bytes + incoming fit the budget */
+static void shard_evict(cache_shard_t *shard, size_t incoming) {
+  while (shard->lru_tail && shard->bytes + incoming > shard->budget) {
+    shard_remove(shard, shard->lru_tail);
+    shard->evictions++;
+  }
+}
+
+/** Double the bucket array; on allocation failure chains just get longer */
+static int shard_grow(cache_shard_t *shard) {
+  size_t count =
+      shard->bucket_count ? shard->bucket_count * 2 : CACHE_INITIAL_BUCKETS;
+  cache_entry_t **buckets =
+      (cache_entry_t **)calloc(count, sizeof(cache_entry_t *));
+  if (!buckets) {
+    return shard->bucket_count ? 0 : -1;
+  }
+  for (size_t i = 0; i < shard->bucket_count; i++) {
+    cache_entry_t *entry = shard->buckets[i];
+    while (entry) {
+      cache_entry_t *next = entry->hash_next;
+      size_t bucket = entry->key & (count - 1);
+      entry->hash_next = buckets[bucket];
+      buckets[bucket] = entry;
+      entry = next;
+    }
+  }
+  free(shard->buckets);
+  shard->buckets = buckets;
+  shard->bucket_count = count;
+  return 0;
+}
+
+static void shard_clear(cache_shard_t *shard) {
+  cache_entry_t *entry = shard->lru_head;
+  while (entry) {
+    cache_entry_t *next = entry->lru_next;
+    free(entry);
+    entry = next;
+  }
+  free(shard->buckets);
+  shard->buckets = NULL;
+  shard->bucket_count = 0;
+  shard->entry_count = 0;
+  shard->lru_head = NULL;
+  shard->lru_tail = NULL;
+  shard->bytes = 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Lookup and insert                                                         */
+/* ------------------------------------------------------------------------ */
+
+/** Binary search of the attached stores; called without shard locks */
+static int store_lookup(uint64_t key, int dimension, float *output) {
+  int64_t id = (int64_t)key;
+  int found = 0;
+
+  fastembed_mutex_lock(&g_cache_mutex);
+  for (int s = 0; s < g_store_count && !found; s++) {
+    const cache_store_t *store = &g_stores[s];
+    if (store->dimension != dimension) {
+      continue;
+    }
+    int low = 0;
+    int high = store->count;
+    while (low < high) {
+      int mid = low + (high - low) / 2;
+      if (store->ids[mid] < id) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    if (low < store->count && store->ids[low] == id) {
+      memcpy(output, store->vectors + (size_t)low * (size_t)dimension,
+             (size_t)dimension * sizeof(float));
+      g_store_hits++;
+      found = 1;
+    }
+  }
+  fastembed_mutex_unlock(&g_cache_mutex);
+  return found;
+}
+
+int embedding_cache_lookup(uint64_t key, int dimension, float *output) {
+  if (!fastembed_atomic_load(&g_shards_ready)) {
+    return 0;
+  }
+
+  cache_shard_t *shard = cache_shard(key);
+  fastembed_mutex_lock(&shard->mutex);
+  cache_entry_t *entry = shard_find(shard, key);
+  if (entry && entry->dimension == dimension) {
+    shard_lru_unlink(shard, entry);
+    shard_lru_push_front(shard, entry);
+    memcpy(output, entry->vector, (size_t)dimension * sizeof(float));
+    shard->hits++;
+    fastembed_mutex_unlock(&shard->mutex);
+    return 1;
+  }
+  shard->misses++;
+  fastembed_mutex_unlock(&shard->mutex);
+
+  if (fastembed_atomic_load(&g_store_count) == 0 ||
+      !store_lookup(key, dimension, output)) {
+    return 0;
+  }
+  embedding_cache_insert(key, dimension, output);
+  return 1;
+}
+
+void embedding_cache_insert(uint64_t key, int dimension, const float *vector) {
+  if (!fastembed_atomic_load(&g_shards_ready) || dimension <= 0) {
+    return;
+  }
+
+  size_t entry_bytes = cache_entry_bytes(dimension);
+  cache_shard_t *shard = cache_shard(key);
+
+  /* Allocate outside the lock; freed again if the entry is not needed */
+  cache_entry_t *entry = (cache_entry_t *)malloc(entry_bytes);
+  if (!entry) {
+    return;
+  }
+  entry->key = key;
+  entry->dimension = dimension;
+  memcpy(entry->vector, vector, (size_t)dimension * sizeof(float));
+
+  fastembed_mutex_lock(&shard->mutex);
+  if (entry_bytes > shard->budget) {
+    fastembed_mutex_unlock(&shard->mutex);
+    free(entry);
+    return;
+  }
+  cache_entry_t *existing = shard_find(shard, key);
+  if (existing) {
+    shard_remove(shard, existing);
+  }
+  if (shard->entry_count >= shard->bucket_count && shard_grow(shard) != 0) {
+    fastembed_mutex_unlock(&shard->mutex);
+    free(entry);
+    return;
+  }
+  shard_evict(shard, entry_bytes);
+
+  size_t bucket = key & (shard->bucket_count - 1);
+  entry->hash_next = shard->buckets[bucket];
+  shard->buckets[bucket] = entry;
+  shard_lru_push_front(shard, entry);
+  shard->entry_count++;
+  shard->bytes += entry_bytes;
+  shard->insertions++;
+  fastembed_mutex_unlock(&shard->mutex);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------ */
+
+FASTEMBED_EXPORT int fastembed_embedding_cache_set_capacity(size_t max_bytes) {
+  fastembed_mutex_lock(&g_cache_mutex);
+  cache_init_shards();
+  g_capacity = max_bytes;
+  for (int i = 0; i < FASTEMBED_EMBEDDING_CACHE_SHARDS; i++) {
+    cache_shard_t *shard = &g_shards[i];
+    fastembed_mutex_lock(&shard->mutex);
+    shard->budget = max_bytes / FASTEMBED_EMBEDDING_CACHE_SHARDS;
+    if (shard->budget == 0) {
+      shard_clear(shard);
+    } else {
+      shard_evict(shard, 0);
+    }
+    fastembed_mutex_unlock(&shard->mutex);
+  }
+  cache_update_enabled();
+  fastembed_mutex_unlock(&g_cache_mutex);
+  return 0;
+}
+
+FASTEMBED_EXPORT void fastembed_embedding_cache_clear(void) {
+  fastembed_mutex_lock(&g_cache_mutex);
+  if (g_shards_ready) {
+    for (int i = 0; i < FASTEMBED_EMBEDDING_CACHE_SHARDS; i++) {
+      fastembed_mutex_lock(&g_shards[i].mutex);
+      shard_clear(&g_shards[i]);
+      fastembed_mutex_unlock(&g_shards[i].mutex);
+    }
+  }
+  fastembed_mutex_unlock(&g_cache_mutex);
+}
+
+FASTEMBED_EXPORT int
+fastembed_embedding_cache_get_stats(fastembed_embedding_cache_stats_t *stats) {
+  if (!stats) {
+    return -1;
+  }
+  memset(stats, 0, sizeof(*stats));
+
+  fastembed_mutex_lock(&g_cache_mutex);
+  uint64_t memory_misses = 0;
+  if (g_shards_ready) {
+    for (int i = 0; i < FASTEMBED_EMBEDDING_CACHE_SHARDS; i++) {
+      cache_shard_t *shard = &g_shards[i];
+      fastembed_mutex_lock(&shard->mutex);
+      stats->hits += shard->hits;
+      memory_misses += shard->misses;
+      stats->insertions += shard->insertions;
+      stats->evictions += shard->evictions;
+      stats->entries += shard->entry_count;
+      stats->bytes += shard->bytes;
+      fastembed_mutex_unlock(&shard->mutex);
+    }
+  }
+  /* Store hits were first counted as memory misses */
+  stats->store_hits = g_store_hits;
+  stats->hits += g_store_hits;
+  stats->misses =
+      memory_misses > g_store_hits ? memory_misses - g_store_hits : 0;
+  stats->capacity_bytes = g_capacity;
+  stats->stores = g_store_count;
+  fastembed_mutex_unlock(&g_cache_mutex);
+  return 0;
+}
+
+FASTEMBED_EXPORT void fastembed_embedding_cache_reset_stats(void) {
+  fastembed_mutex_lock(&g_cache_mutex);
+  if (g_shards_ready) {
+    for (int i = 0; i < FASTEMBED_EMBEDDING_CACHE_SHARDS; i++) {
+      cache_shard_t *shard = &g_shards[i];
+      fastembed_mutex_lock(&shard->mutex);
+      shard->hits = 0;
+      shard->misses = 0;
+      shard->insertions = 0;
+      shard->evictions = 0;
+      fastembed_mutex_unlock(&shard->mutex);
+    }
+  }
+  g_store_hits = 0;
+  fastembed_mutex_unlock(&g_cache_mutex);
+}
+
+typedef struct {
+  int64_t key;
+  size_t row;
+} cache_snapshot_row_t;
+
+static int compare_snapshot_rows(const void *a, const void *b) {
+  int64_t ka = ((const cache_snapshot_row_t *)a)->key;
+  int64_t kb = ((const cache_snapshot_row_t *)b)->key;
+  return (ka > kb) - (ka < kb);
+}
+
+FASTEMBED_EXPORT int fastembed_embedding_cache_save(const char *path,
+                                                    int dimension) {
+  if (!path || dimension <= 0 || dimension > FASTEMBED_MAX_DIMENSION) {
+    return -1;
+  }
+
+  /* Copy the entries out so inference is not blocked by disk writes */
+  cache_snapshot_row_t *rows = NULL;
+  float *vectors = NULL;
+  size_t count = 0;
+  size_t capacity = 0;
+  int ok = 1;
+
+  fastembed_mutex_lock(&g_cache_mutex);
+  for (int i = 0; ok && g_shards_ready && i < FASTEMBED_EMBEDDING_CACHE_SHARDS;
+       i++) {
+    cache_shard_t *shard = &g_shards[i];
+    fastembed_mutex_lock(&shard->mutex);
+    for (cache_entry_t *entry = shard->lru_head; entry && ok;
+         entry = entry->lru_next) {
+      if (entry->dimension != dimension) {
+        continue;
+      }
+      if (count == capacity) {
+        size_t grown = capacity ? capacity * 2 : 1024;
+        cache_snapshot_row_t *grown_rows = (cache_snapshot_row_t *)realloc(
+            rows, grown * sizeof(cache_snapshot_row_t));
+        if (grown_rows) {
+          rows = grown_rows;
+        }
+        float *grown_vectors = (float *)realloc(
+            vectors, grown * (size_t)dimension * sizeof(float));
+        if (grown_vectors) {
+          vectors = grown_vectors;
+        }
+        if (!grown_rows || !grown_vectors || grown > INT32_MAX) {
+          ok = 0;
+          break;
+        }
+        capacity = grown;
+      }
+      rows[count].key = (int64_t)entry->key;
+      rows[count].row = count;
+      memcpy(vectors + count * (size_t)dimension, entry->vector,
+             (size_t)dimension * sizeof(float));
+      count++;
+    }
+    fastembed_mutex_unlock(&shard->mutex);
+  }
+  fastembed_mutex_unlock(&g_cache_mutex);
+
+  fastembed_store_writer_t *writer =
+      ok ? fastembed_store_writer_open(path, dimension, FASTEMBED_QUANT_NONE,
+                                       FASTEMBED_STORE_IDS)
+         : NULL;
+  if (writer) {
+    /* Sorted ids let attached stores be searched with a binary search */
+    if (count > 0) {
+      qsort(rows, count, sizeof(cache_snapshot_row_t), compare_snapshot_rows);
+    }
+    for (size_t i = 0; i < count; i++) {
+      if (fastembed_store_writer_append(
+              writer, vectors + rows[i].row * (size_t)dimension, 1,
+              &rows[i].key) != 0) {
+        break;
+      }
+    }
+    ok = fastembed_store_writer_close(writer) == 0;
+  } else {
+    ok = 0;
+  }
+
+  free(rows);
+  free(vectors);
+  return ok ? (int)count : -1;
+}
+
+FASTEMBED_EXPORT int fastembed_embedding_cache_attach_store(const char *path) {
+  if (!path) {
+    return -1;
+  }
+  fastembed_store_t *store = fastembed_store_open(path);
+  if (!store) {
+    return -1;
+  }
+
+  const int64_t *ids = fastembed_store_ids(store);
+  int count = fastembed_store_count(store);
+  int valid = ids != NULL && fastembed_store_dtype(store) == FASTEMBED_QUANT_NONE;
+  for (int i = 1; valid && i < count; i++) {
+    valid = ids[i - 1] <= ids[i];
+  }
+  if (!valid) {
+    fastembed_store_close(store);
+    return -1;
+  }
+
+  fastembed_mutex_lock(&g_cache_mutex);
+  if (g_store_count == FASTEMBED_EMBEDDING_CACHE_MAX_STORES) {
+    fastembed_mutex_unlock(&g_cache_mutex);
+    fastembed_store_close(store);
+    return -1;
+  }
+  cache_init_shards();
+  cache_store_t *slot = &g_stores[g_store_count];
+  slot->store = store;
+  slot->ids = ids;
+  slot->vectors = (const float *)fastembed_store_vectors(store);
+  slot->count = count;
+  slot->dimension = fastembed_store_dimension(store);
+  fastembed_atomic_store(&g_store_count, g_store_count + 1);
+  cache_update_enabled();
+  fastembed_mutex_unlock(&g_cache_mutex);
+  return 0;
+}
+
+FASTEMBED_EXPORT void fastembed_embedding_cache_detach_stores(void) {
+  fastembed_mutex_lock(&g_cache_mutex);
+  for (int i = 0; i < g_store_count; i++) {
+    fastembed_store_close(g_stores[i].store);
+    memset(&g_stores[i], 0, sizeof(g_stores[i]));
+  }
+  fastembed_atomic_store(&g_store_count, 0);
+  cache_update_enabled();
+  fastembed_mutex_unlock(&g_cache_mutex);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file embedding_cache.h
+ * @brief Content-addressed embedding cache in front of ONNX inference
+ *
+ * Embeddings are keyed by a 64-bit XXH64 hash of the text, seeded with the
+ * model identity (resolved model path, tokenizer path, pooling and output
+ * dimension), so the same text embedded by two models or two poolings gets
+ * two entries.
+ *
+ * The in-memory tier is FASTEMBED_EMBEDDING_CACHE_SHARDS LRU shards, each with
+ * its own lock and an equal share of the byte budget, so concurrent batch
+ * workers rarely contend. Lookups that miss in memory fall through to the
+ * attached store files (fastembed_embedding_cache_attach_store()); store
+ * hits are copied into memory.
+ *
+ * Internal header - not part of the public API.
+ */
+
+#ifndef FASTEMBED_EMBEDDING_CACHE_H
+#define FASTEMBED_EMBEDDING_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Whether lookups can hit (memory budget > 0 or a store attached)
+ *
+ * A single atomic load, so callers can skip hashing while the cache is off.
+ */
+int embedding_cache_enabled(void);
+
+/**
+ * @brief Hash seed for one model configuration
+ *
+ * @param model_id Resolved model path
+ * @param tokenizer_id Tokenizer path (NULL = discovered next to the model)
+ * @param pooling Pooling mode (fastembed_pooling_t)
+ * @param dimension Output dimension
+ */
+uint64_t embedding_cache_seed(const char *model_id, const char *tokenizer_id,
+                              int pooling, int dimension);
+
+/**
+ * @brief Cache key of a text under a model seed
+ */
+uint64_t embedding_cache_key(uint64_t seed, const char *text, size_t length);
+
+/**
+ * @brief Copy a cached embedding into output
+ *
+ * @return 1 on a hit (output written), 0 on a miss
+ */
+int embedding_cache_lookup(uint64_t key, int dimension, float *output);
+
+/**
+ * @brief Add an embedding, evicting least recently used entries of its shard
+ *
+ * No-op when the memory budget is 0 or allocation fails; an existing entry
+ * for key is replaced.
+ */
+void embedding_cache_insert(uint64_t key, int dimension, const float *vector);
+
+#endif /* FASTEMBED_EMBEDDING_CACHE_H */
@@ -22,23 +22,41 @@
  *
  *   # Pipeline processing
  *   cat file1.txt file2.txt | ./embedding_gen_cli
+ *
+ *   # Streaming mode: one JSON record per line, one result per line
+ *   printf '{"id":1,"text":"Hello"}\n"world"\n' | ./embedding_gen_cli --stream
+ *
+ *   # Streaming mode with raw float32 output, 8 threads, 512-dim embeddings
+ *   ./embedding_gen_cli --stream --format f32le --threads 8 --dim 512 \
+ *       < records.ndjson > embeddings.f32
  * @endcode
  *
+ * Options:
+ * - --dim N: Embedding dimension (128, 256, 512, 768, 1024, 2048; default 768)
+ * - --stream: Process NDJSON records until end of input (see cli_stream.h)
+ * - --batch N: Records per batch in streaming mode (default 256)
+ * - --threads N: Batch threads in streaming mode (default 0 = all CPUs)
+ * - --format ndjson|f32le: Streaming output encoding (default ndjson)
+ *
  * Output format:
  * - Success: JSON array of floats: [0.123456, -0.789012, ...]
  * - Error: JSON error object: {"error":"Failed to generate embedding"}
+ * - Streaming: {"index":N,"id":...,"embedding":[...]} per record, or
+ *   dimension little-endian floats per record with --format f32le
  *
  * Exit codes:
- * - 0: Success
- * - 1: Error (I/O error, generation failure)
+ * - 0: Success (streaming: end of input; per-record errors are reported in
+ *   the output)
+ * - 1: Error (invalid arguments, I/O error, generation failure)
  *
  * @note This tool uses hash-based embeddings, not neural network models
  * @note For ONNX model embeddings, use onnx_embedding_cli instead
- * @note Embedding dimension is fixed at 768 (BERT-base size)
+ * @note Embedding dimension defaults to 768 (BERT-base size)
  */
 
 #include "../include/fastembed.h"
 #include "../include/fastembed_config.h"
+#include "cli_stream.h"
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -48,20 +66,43 @@
 #define MAX_TEXT_LENGTH FASTEMBED_MAX_TEXT_LENGTH
 #define EMBEDDING_DIM FASTEMBED_EMBEDDING_DIM
 
+/**
+ * @brief Streaming batch callback: hash embeddings on the thread pool
+ *
+ * @param user_data Pointer to the embedding dimension
+ */
+static int embed_hash_batch(void *user_data, const char *text_data,
+                            const int32_t *offsets, int count, float *output,
+                            int *statuses, int num_threads) {
+  int dimension = *(const int *)user_data;
+  return fastembed_batch_generate_contiguous(text_data, offsets, count, output,
+                                             dimension, statuses, num_threads);
+}
+
+static void print_usage(const char *program) {
+  fprintf(stderr, "Usage: echo \"text\" | %s [--dim N]\n", program);
+  fprintf(stderr,
+          "   or: %s --stream [--dim N] [--batch N] [--threads N] "
+          "[--format ndjson|f32le] < records.ndjson\n",
+          program);
+}
+
 /**
  * @brief Main entry point for embedding generation CLI tool
  *
  * Processes text input from stdin, generates embedding using hash-based
- * algorithm, and outputs result as JSON array.
+ * algorithm, and outputs result as JSON array. With --stream, processes
+ * NDJSON records until end of input instead (see cli_stream_embeddings()).
  *
  * Workflow:
- * 1. Read text from stdin (up to MAX_TEXT_LENGTH characters)
- * 2. Remove trailing newline character if present
- * 3. Generate embedding using hash-based algorithm (assembly-optimized)
- * 4. Output embedding vector as JSON array
+ * 1. Parse options (--dim and the streaming options)
+ * 2. Read text from stdin (up to MAX_TEXT_LENGTH characters)
+ * 3. Remove trailing newline character if present
+ * 4. Generate embedding using hash-based algorithm (assembly-optimized)
+ * 5. Output embedding vector as JSON array
  *
- * @param argc Number of command-line arguments (currently unused)
- * @param argv Command-line arguments array (currently unused)
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments array (options only)
  * @return Exit code: 0 on success, 1 on error
  *
  * @note Text is read from stdin, not command-line arguments
@@ -70,7 +111,46 @@
  */
 int main(int argc, char *argv[]) {
   char text_buffer[MAX_TEXT_LENGTH];
-  float output[EMBEDDING_DIM];
+  float output[FASTEMBED_MAX_DIMENSION];
+  cli_stream_options_t stream;
+  int dimension = EMBEDDING_DIM;
+
+  /* Parse options */
+  cli_stream_options_init(&stream);
+  for (int i = 1; i < argc;) {
+    int parsed = cli_stream_parse_option(argc, argv, &i, &stream);
+    if (parsed < 0) {
+      return 1;
+    }
+    if (parsed > 0) {
+      continue;
+    }
+    if (strcmp(argv[i], "--dim") == 0 && i + 1 < argc) {
+      char *end;
+      long value = strtol(argv[i + 1], &end, 10);
+      if (end == argv[i + 1] || *end != '\0' || value <= 0 ||
+          value > FASTEMBED_MAX_DIMENSION) {
+        fprintf(stderr, "{\"error\":\"Invalid value for --dim\"}\n");
+        return 1;
+      }
+      dimension = (int)value;
+      i += 2;
+      continue;
+    }
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  /* Reject unsupported dimensions before reading any input */
+  if (fastembed_generate("dimension", output, dimension) != 0) {
+    fprintf(stderr, "{\"error\":\"Unsupported dimension\"}\n");
+    return 1;
+  }
+
+  if (stream.enabled) {
+    return cli_stream_embeddings(&stream, dimension, embed_hash_batch,
+                                 &dimension);
+  }
 
   /* Read text from stdin (supports piping and redirection) */
   if (fgets(text_buffer, sizeof(text_buffer), stdin) == NULL) {
@@ -85,7 +165,7 @@ int main(int argc, char *argv[]) {
   }
 
   /* Generate embedding using hash-based algorithm (assembly-optimized) */
-  if (fastembed_generate(text_buffer, output, EMBEDDING_DIM) != 0) {
+  if (fastembed_generate(text_buffer, output, dimension) != 0) {
     fprintf(stderr, "{\"error\":\"Failed to generate embedding\"}\n");
     return 1;
   }
@@ -93,9 +173,9 @@ int main(int argc, char *argv[]) {
   /* Output embedding as JSON array for easy parsing */
   /* Format: [0.123456, -0.789012, ...] */
   printf("[");
-  for (int i = 0; i < EMBEDDING_DIM; i++) {
+  for (int i = 0; i < dimension; i++) {
     printf("%.6f", output[i]);
-    if (i < EMBEDDING_DIM - 1) {
+    if (i < dimension - 1) {
       printf(",");
     }
   }
@@ -49,6 +49,13 @@ section .data
     scale_2_31: dd 0x4F000000     ; 2^31 (2147483648.0) as float32
     scale_2_31_int: dq 2147483648 ; 2^31 as integer
 
+    ; Packed constants for generate_embedding_asm
+    align 16
+    mask_31_ps: times 4 dd 0x7FFFFFFF
+    inv_2_31_ps: times 4 dd 0x30000000  ; 2^-31 as float32
+    two_ps: times 4 dd 0x40000000       ; 2.0 as float32
+    one_ps: times 4 dd 0x3F800000       ; 1.0 as float32
+
 section .bss
     align 16
     ; Storage for generated embedding
@@ -486,13 +493,23 @@ generate_combined_hash_asm:
 ; Function: generate_embedding_asm
 ; Generate embedding with Square Root normalization and positional hashing
 ; 
-; Algorithm:
-;   For each dimension i:
-;     1. Generate positional hash (character position aware)
-;     2. Generate secondary hash (seed * 37)
-;     3. Combine hashes: hash1 XOR (hash2 << 16)
-;     4. Normalize with √x: sqrt((hash / 2^31)) * 2 - 1
-;     5. Store in output[i]
+; Algorithm (per dimension i, same output as calling the functions above):
+;   1. hash1 = positional_hash(text, seed = i)
+;   2. hash2 = positional_hash(text, seed = i * 37)
+;   3. Combine hashes: hash1 XOR (hash2 << 16)
+;   4. Normalize with √x: sqrt((hash / 2^31)) * 2 - 1
+;   5. Store in output[i]
+;
+; Single pass over the text:
+;   positional_hash is linear in its seed (mod 2^64):
+;     positional_hash(text, seed) = seed * 31^len + positional_hash(text, 0)
+;   so one walk over the text yields H = positional_hash(text, 0) and
+;   P = 31^len, and every dimension is then hash1 = H + i*P,
+;   hash2 = H + 37*i*P. Only the low 31 bits of the combined hash are used,
+;   so 32-bit lanes are exact: four SSE2 lanes per iteration, stepped by
+;   4P / 4Q (Q = 37P). cvtdq2ps / sqrtps round like the scalar cvtsi2ss /
+;   sqrtss and the 2^-31 scale is exact, so the result is bit-identical to
+;   the per-dimension functions in O(len + dimension).
 ; 
 ; Quality:
 ;   - Typo tolerance: 0.40+ similarity
@@ -508,38 +525,19 @@ generate_combined_hash_asm:
 ; ============================================
 global generate_embedding_asm
 generate_embedding_asm:
-    ; Prologue
+    ; Prologue (leaf function: no calls, so no shadow space or alignment)
     push rbp
     mov rbp, rsp
-    
-    ; CRITICAL: Save parameters IMMEDIATELY before pushing registers
-    ; Parameters come in rdi, rsi, rdx (System V) or rcx, rdx, r8 (Windows)
-    ; We need to save them before push operations that might clobber them
-    mov r10, PARAM1    ; Save text pointer to temporary register
-    mov r11, PARAM2    ; Save output pointer to temporary register
-    mov r9, PARAM3     ; Save dimension to temporary register
-    
-    ; Save callee-saved registers (System V ABI: r12, r13, r14, r15, rbx)
     push r12
     push r13
     push r14
     push r15
     push rbx
     
-    ; Stack layout after pushes:
-    ; rbp-0:  saved rbp (at rbp)
-    ; rbp-8:  saved r12
-    ; rbp-16: saved r13
-    ; rbp-24: saved r14
-    ; rbp-32: saved r15
-    ; rbp-40: saved rbx
-    ; After 6 pushes: 48 bytes (48 mod 16 = 0, already aligned!)
-    ; rsp now points to saved rbx (rbp-40)
-    
-    ; Now move parameters to callee-saved registers
-    mov r12, r10       ; text pointer (callee-saved, safe)
-    mov r13, r11       ; output pointer (callee-saved, safe)
-    mov r14, r9        ; dimension (callee-saved, safe)
+    mov r12, PARAM1    ; text pointer
+    mov r13, PARAM2    ; output pointer
+    mov r14, PARAM3    ; dimension
+    mov r14d, r14d     ; zero-extend (int parameter)
     
     ; Step 1: Input Validation
     test r12, r12      ; Check text pointer
@@ -564,80 +562,96 @@ generate_embedding_asm:
     jmp .error         ; Invalid dimension
     
 .dimension_ok:
-    ; Step 2: Calculate text length
-    mov r15, r12       ; text pointer for length calculation
-    xor rbx, rbx       ; text_length counter
+    ; Step 2: One pass over the text: length, H = positional_hash(text, 0)
+    ; and P = 31^length (mod 2^64)
+    xor rbx, rbx       ; position index (j) = text_length when done
+    xor rax, rax       ; H
+    mov r15, 1         ; P
+    
+.text_loop:
+    movzx rcx, byte [r12 + rbx]
+    test rcx, rcx      ; Check for null terminator
+    jz .text_done
+    cmp rbx, 8192      ; MAX_TEXT_LENGTH
+    jae .error
+    
+    lea rdx, [rbx + 1] ; position_weight = j + 1
+    imul rcx, rdx      ; char * position_weight
+    imul rax, rax, 31  ; H = H * 31 + char * position_weight
+    add rax, rcx
+    imul r15, r15, 31  ; P *= 31
     
-.text_length_loop:
-    cmp byte [r15], 0
-    je .text_length_done
     inc rbx
-    inc r15
-    jmp .text_length_loop
+    jmp .text_loop
     
-.text_length_done:
+.text_done:
     test rbx, rbx      ; Check if empty
     jz .error
-    cmp rbx, 8192      ; MAX_TEXT_LENGTH
-    jg .error
     
-    ; Step 3: Embedding Generation Loop
-    xor r15, r15       ; dimension index (i) - use r15 instead of rax!
+    ; Step 3: Lane setup (low 32 bits only)
+    ; xmm0 = hash1 lanes [H, H+P, H+2P, H+3P]
+    lea ecx, [rax + r15]
+    movd xmm0, eax
+    movd xmm2, ecx
+    punpckldq xmm0, xmm2
+    lea edx, [rcx + r15]
+    add ecx, r15d
+    add ecx, r15d
+    movd xmm2, edx
+    movd xmm3, ecx
+    punpckldq xmm2, xmm3
+    punpcklqdq xmm0, xmm2
+    
+    ; xmm1 = hash2 lanes [H, H+37P, H+74P, H+111P]
+    imul r8d, r15d, 37 ; Q = 37 * P
+    lea ecx, [rax + r8]
+    movd xmm1, eax
+    movd xmm2, ecx
+    punpckldq xmm1, xmm2
+    lea edx, [rcx + r8]
+    add ecx, r8d
+    add ecx, r8d
+    movd xmm2, edx
+    movd xmm3, ecx
+    punpckldq xmm2, xmm3
+    punpcklqdq xmm1, xmm2
+    
+    ; Per-iteration steps: xmm4 = 4P, xmm5 = 4Q
+    lea ecx, [r15 * 4]
+    movd xmm4, ecx
+    pshufd xmm4, xmm4, 0
+    lea ecx, [r8 * 4]
+    movd xmm5, ecx
+    pshufd xmm5, xmm5, 0
+    
+    ; Step 4: Embedding Generation Loop (dimension is a multiple of 4;
+    ; only xmm0-xmm5 are used, so nothing to save on Windows x64)
+    xor rcx, rcx       ; dimension index (i)
     
 .embedding_loop:
-    cmp r15, r14       ; Check if i < dimension
-    jge .embedding_done
-    
-    ; Step 3.1-3.3: Generate Combined Hash
-    ; Prepare parameters for generate_combined_hash_asm
-    ; Stack alignment: rsp points to saved rbx (rbp-40)
-    ; rsp = rbp - 40, so rsp % 16 = (rbp - 40) % 16
-    ; If rbp % 16 == 0, then (rbp - 40) % 16 = (0 - 40) % 16 = (-40) % 16 = 8
-    ; So rsp is misaligned by 8 bytes before first call
-    ; We need to align it: sub rsp, 8 to make it aligned
-    sub rsp, 8         ; Align stack to 16 bytes (rsp % 16 == 0)
-    ; Pass loop index as seed
-%ifidn __OUTPUT_FORMAT__,elf64
-    mov rdi, r12       ; text
-    mov rsi, rbx       ; text_length
-    mov rdx, r15       ; seed = i
-%else
-    mov rcx, r12       ; text
-    mov rdx, rbx       ; text_length
-    mov r8, r15        ; seed = i
-%endif
-    call generate_combined_hash_asm
-    ; Combined hash is in rax
-    ; After call, rsp % 16 == 0 (call pushed 8 bytes, but we did sub rsp, 8 before, so aligned)
-    ; We need to pass it to hash_to_float_sin_asm
-    ; Save hash to a caller-saved register (we'll use it immediately)
-    mov r10, rax       ; Save hash in r10 (caller-saved, but we use it immediately)
-    
-    ; Step 3.4: Normalize with Square Root
-    ; Prepare parameter for hash_to_float_sqrt_asm
-    ; Stack alignment: after previous call, rsp % 16 == 0 (aligned)
-    ; Before next call, we need rsp % 16 == 0 (already aligned!)
-%ifidn __OUTPUT_FORMAT__,elf64
-    mov rdi, r10       ; Pass hash as parameter
-%else
-    mov rcx, r10       ; Pass hash as parameter
-%endif
-    call hash_to_float_sqrt_asm
-    ; After call, rsp % 16 == 8 (misaligned)
-    ; Restore stack alignment for next iteration
-    add rsp, 8         ; Restore stack (counteract the sub rsp, 8 from start of iteration)
-    ; XMM0 now contains sqrt-normalized value in [-1, 1]
-    
-    ; Step 3.5: Store in output array
-    ; CRITICAL: Use r15 (loop counter) instead of rax (which was overwritten)!
-    movss [r13 + r15*4], xmm0  ; output[i] = sqrt_value
-    
-    ; Next iteration
-    inc r15
-    jmp .embedding_loop
-    
-.embedding_done:
-    ; Success (stack is already aligned - we restored it at end of each iteration)
+    ; Combine: hash1 ^ (hash2 << 16), keep 31 bits
+    movdqa xmm2, xmm1
+    pslld xmm2, 16
+    pxor xmm2, xmm0
+    pand xmm2, [rel mask_31_ps]
+    
+    ; Normalize with Square Root: sqrt(hash / 2^31) * 2 - 1
+    cvtdq2ps xmm2, xmm2
+    mulps xmm2, [rel inv_2_31_ps]
+    sqrtps xmm2, xmm2
+    mulps xmm2, [rel two_ps]
+    subps xmm2, [rel one_ps]
+    
+    movups [r13 + rcx*4], xmm2  ; output[i..i+3]
+    
+    paddd xmm0, xmm4   ; hash1 lanes += 4P
+    paddd xmm1, xmm5   ; hash2 lanes += 4Q
+    
+    add rcx, 4
+    cmp rcx, r14
+    jb .embedding_loop
+    
+    ; Success
     xor rax, rax
     jmp .done
     
@@ -653,4 +667,3 @@ generate_embedding_asm:
     pop r12
     pop rbp
     ret
-
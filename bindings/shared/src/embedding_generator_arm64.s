@@ -323,13 +323,19 @@ _generate_combined_hash_asm:
 // Function: generate_embedding_asm
 // Generate embedding with Square Root normalization and positional hashing
 // 
-// Algorithm:
-//   For each dimension i:
-//     1. Generate positional hash (character position aware)
-//     2. Generate secondary hash (seed * 37)
-//     3. Combine hashes: hash1 XOR (hash2 << 16)
-//     4. Normalize with √x: sqrt((hash / 2^31)) * 2 - 1
-//     5. Store in output[i]
+// Algorithm (per dimension i, same output as calling the functions above):
+//   1. hash1 = positional_hash(text, seed = i)
+//   2. hash2 = positional_hash(text, seed = i * 37)
+//   3. Combine hashes: hash1 XOR (hash2 << 16)
+//   4. Normalize with √x: sqrt((hash / 2^31)) * 2 - 1
+//   5. Store in output[i]
+//
+// Single pass over the text (see embedding_generator.asm):
+//   positional_hash(text, seed) = seed * 31^len + positional_hash(text, 0)
+//   (mod 2^64), so one walk yields H and P = 31^len and every dimension is
+//   hash1 = H + i*P, hash2 = H + 37*i*P. Only the low 31 bits are used, so
+//   four 32-bit NEON lanes per iteration are exact; scvtf / fsqrt round like
+//   the scalar path and the 2^-31 scale is exact (bit-identical output).
 // 
 // Quality:
 //   - Typo tolerance: 0.40+ similarity
@@ -345,86 +351,114 @@ _generate_combined_hash_asm:
 // ============================================
     .global _generate_embedding_asm
 _generate_embedding_asm:
-    // Prologue
-    stp x29, x30, [sp, #-80]!
+    // Leaf function: only caller-saved registers (x9-x15, v0-v7, v16-v19)
+    stp x29, x30, [sp, #-16]!
     mov x29, sp
-    stp x19, x20, [sp, #16]
-    stp x21, x22, [sp, #32]
-    stp x23, x24, [sp, #48]
-    stp x25, x26, [sp, #64]
-    
-    // Save parameters immediately
-    mov x19, x0                  // text
-    mov x20, x1                  // output
-    mov x21, x2                  // dimension
     
     // Step 1: Input Validation
-    cbz x19, .Lerror
+    cbz x0, .Lerror
     
-    cbz x20, .Lerror
+    cbz x1, .Lerror
     
     // Check dimension (must be in {128, 256, 512, 768, 1024, 2048})
-    cmp w21, #128
+    cmp w2, #128
     beq .Ldimension_ok
-    cmp w21, #256
+    cmp w2, #256
     beq .Ldimension_ok
-    cmp w21, #512
+    cmp w2, #512
     beq .Ldimension_ok
-    cmp w21, #768
+    cmp w2, #768
     beq .Ldimension_ok
-    cmp w21, #1024
+    cmp w2, #1024
     beq .Ldimension_ok
-    cmp w21, #2048
+    cmp w2, #2048
     beq .Ldimension_ok
     b .Lerror                    // Invalid dimension
     
 .Ldimension_ok:
-    // Step 2: Calculate text length
-    mov x22, x19                 // text pointer for length calculation
-    mov x23, #0                  // text_length counter
-    
-.Ltext_length_loop:
-    ldrb w9, [x22]
-    cbz w9, .Ltext_length_done
-    add x23, x23, #1
-    add x22, x22, #1
-    b .Ltext_length_loop
-    
-.Ltext_length_done:
-    cbz x23, .Lerror             // Check if empty
-    mov x9, #8192
-    cmp x23, x9                  // MAX_TEXT_LENGTH
-    bgt .Lerror
-    
-    // Step 3: Embedding Generation Loop
-    mov x22, #0                  // dimension index (i)
+    // Step 2: One pass over the text: length, H = positional_hash(text, 0)
+    // and P = 31^length (mod 2^64)
+    mov x9, #0                   // position index (j) = text_length when done
+    mov x10, #0                  // H
+    mov x11, #1                  // P
+    mov x12, #31
+    mov x15, #8192               // MAX_TEXT_LENGTH
+    
+.Ltext_loop:
+    ldrb w13, [x0, x9]
+    cbz w13, .Ltext_done         // Check for null terminator
+    cmp x9, x15
+    bhs .Lerror
+    
+    add x14, x9, #1              // position_weight = j + 1
+    mul x13, x13, x14            // char * position_weight
+    madd x10, x10, x12, x13      // H = H * 31 + char * position_weight
+    mul x11, x11, x12            // P *= 31
+    
+    add x9, x9, #1
+    b .Ltext_loop
+    
+.Ltext_done:
+    cbz x9, .Lerror              // Check if empty
+    
+    // Step 3: Lane setup (low 32 bits only)
+    // v0 = hash1 lanes [H, H+P, H+2P, H+3P]
+    fmov s0, w10
+    add w13, w10, w11
+    mov v0.s[1], w13
+    add w13, w13, w11
+    mov v0.s[2], w13
+    add w13, w13, w11
+    mov v0.s[3], w13
+    
+    // v1 = hash2 lanes [H, H+Q, H+2Q, H+3Q], Q = 37 * P
+    mov w14, #37
+    mul w14, w11, w14
+    fmov s1, w10
+    add w13, w10, w14
+    mov v1.s[1], w13
+    add w13, w13, w14
+    mov v1.s[2], w13
+    add w13, w13, w14
+    mov v1.s[3], w13
+    
+    // Per-iteration steps: v4 = 4P, v5 = 4Q
+    lsl w13, w11, #2
+    dup v4.4s, w13
+    lsl w13, w14, #2
+    dup v5.4s, w13
+    
+    // Constants: 31-bit mask, 2^-31, 2.0, 1.0
+    mvni v16.4s, #0x80, lsl #24  // 0x7FFFFFFF
+    mov w13, #0x30000000         // 2^-31 as float32
+    dup v17.4s, w13
+    fmov v18.4s, #2.0
+    fmov v19.4s, #1.0
+    
+    // Step 4: Embedding Generation Loop (dimension is a multiple of 4)
+    mov w9, w2                   // remaining dimensions
     
 .Lembedding_loop:
-    cmp x22, x21                 // Check if i < dimension
-    bge .Lembedding_done
+    // Combine: hash1 ^ (hash2 << 16), keep 31 bits
+    shl v2.4s, v1.4s, #16
+    eor v2.16b, v2.16b, v0.16b
+    and v2.16b, v2.16b, v16.16b
+    
+    // Normalize with Square Root: sqrt(hash / 2^31) * 2 - 1
+    scvtf v2.4s, v2.4s
+    fmul v2.4s, v2.4s, v17.4s
+    fsqrt v2.4s, v2.4s
+    fmul v2.4s, v2.4s, v18.4s
+    fsub v2.4s, v2.4s, v19.4s
+    
+    str q2, [x1], #16            // output[i..i+3]
+    
+    add v0.4s, v0.4s, v4.4s      // hash1 lanes += 4P
+    add v1.4s, v1.4s, v5.4s      // hash2 lanes += 4Q
+    
+    subs w9, w9, #4
+    bne .Lembedding_loop
     
-    // Step 3.1-3.3: Generate Combined Hash
-    mov x0, x19                  // text
-    mov x1, x23                  // text_length
-    mov x2, x22                  // seed = i
-    bl _generate_combined_hash_asm
-    // Combined hash is in X0
-    mov x10, x0                  // Save hash in X10
-    
-    // Step 3.4: Normalize with Square Root
-    mov x0, x10                  // Pass hash as parameter
-    bl _hash_to_float_sqrt_asm
-    // S0 now contains sqrt-normalized value in [-1, 1]
-    
-    // Step 3.5: Store in output array
-    add x11, x20, x22, lsl #2    // output + i*4
-    str s0, [x11]                // output[i] = sqrt_value
-    
-    // Next iteration
-    add x22, x22, #1
-    b .Lembedding_loop
-    
-.Lembedding_done:
     // Success
     mov x0, #0
     b .Ldone
@@ -433,11 +467,5 @@ _generate_embedding_asm:
     mov x0, #-1
     
 .Ldone:
-    // Restore callee-saved registers
-    ldp x25, x26, [sp, #64]
-    ldp x23, x24, [sp, #48]
-    ldp x21, x22, [sp, #32]
-    ldp x19, x20, [sp, #16]
-    ldp x29, x30, [sp], #80
+    ldp x29, x30, [sp], #16
     ret
-
@@ -17,6 +17,10 @@
     %define PARAM4 rcx
     %define PARAM5 r8
     %define PARAM6 r9
+    %define PARAM1D edi
+    %define PARAM2D esi
+    %define PARAM3D edx
+    %define PARAM4D ecx
     %define SHADOW_SPACE 0
 %elifidn __OUTPUT_FORMAT__,win64
     ; Windows x64 calling convention
@@ -26,6 +30,10 @@
     %define PARAM4 r9
     %define PARAM5 rsp+32
     %define PARAM6 rsp+40
+    %define PARAM1D ecx
+    %define PARAM2D edx
+    %define PARAM3D r8d
+    %define PARAM4D r9d
     %define SHADOW_SPACE 32
 %elifidn __OUTPUT_FORMAT__,macho64
     ; macOS System V ABI (same as Linux)
@@ -35,6 +43,10 @@
     %define PARAM4 rcx
     %define PARAM5 r8
     %define PARAM6 r9
+    %define PARAM1D edi
+    %define PARAM2D esi
+    %define PARAM3D edx
+    %define PARAM4D ecx
     %define SHADOW_SPACE 0
 %else
     %error "Unsupported output format. Supported: elf64 (Linux), win64 (Windows), macho64 (macOS)"
@@ -49,18 +61,425 @@ section .data
     
     ; Embedding dimension (768 for nomic-embed-text)
     embedding_dim: dd 768
+
+    ; Active kernels: every *_asm entry point jumps through its slot.
+    ; Slots start at a resolver that runs CPUID once and installs the best
+    ; kernel set; simd_select_level_asm can lower it afterwards.
+    align 8
+    dot_product_impl: dq dot_product_resolve
+    cosine_similarity_impl: dq cosine_similarity_resolve
+    vector_norm_impl: dq vector_norm_resolve
+    normalize_vector_impl: dq normalize_vector_resolve
+    add_vectors_impl: dq add_vectors_resolve
+    dot_product_x4_impl: dq dot_product_x4_resolve
+    int8_dot_impl: dq int8_dot_resolve
+    hamming_impl: dq hamming_resolve
+    f16_to_f32_impl: dq f16_to_f32_resolve
+    f32_to_f16_impl: dq f32_to_f16_resolve
+    bf16_to_f32_impl: dq bf16_to_f32_resolve
+    f32_to_bf16_impl: dq f32_to_bf16_resolve
+    simd_level: dd 0       ; Installed level (0 = not selected yet)
+
+    ; Dimension-specialized kernels of the installed level, used by the
+    ; dot/cosine/norm entry points for positive multiples of 128 and indexed
+    ; by min(dimension / 128, 3): generic kernel, 128, 256, 128-float blocks
+    align 8
+    dot_product_fixed: times 4 dq dot_product_resolve
+    cosine_similarity_fixed: times 4 dq cosine_similarity_resolve
+    vector_norm_fixed: times 4 dq vector_norm_resolve
+
+    ; vmaskmovps masks for AVX2 tails: 8 set lanes followed by 8 clear ones,
+    ; loading from (32 - 4 * remaining) bytes in sets the first lanes only
+    align 32
+    avx2_tail_mask: dd -1, -1, -1, -1, -1, -1, -1, -1
+                    dd 0, 0, 0, 0, 0, 0, 0, 0
+
+    ; Bit-count masks for the SWAR popcount (CPUs without POPCNT)
+    align 8
+    popcnt_m1: dq 0x5555555555555555
+    popcnt_m2: dq 0x3333333333333333
+    popcnt_m4: dq 0x0F0F0F0F0F0F0F0F
+    popcnt_h01: dq 0x0101010101010101
+
+    ; float -> bfloat16 round-to-nearest-even: x + 0x7FFF + bit 16 of x,
+    ; NaNs keep their top bits with the quiet bit (0x40) set
+    align 32
+    bf16_lsb: times 8 dd 1
+    bf16_round: times 8 dd 0x7FFF
+    bf16_qnan: times 8 dd 0x40
     
 section .bss
     align 16
     ; Temporary storage for calculations
     temp_vector: resd 768   ; 768 floats = 3072 bytes
 
+; SIMD levels (match fastembed_simd_level_t)
+%define SIMD_LEVEL_SSE 1
+%define SIMD_LEVEL_AVX2 3
+%define SIMD_LEVEL_AVX512 4
+
 section .text
 default rel    ; Use RIP-relative addressing for PIC
 
 ; ============================================
-; Function: dot_product
-; Calculate dot product of two embedding vectors
+; Dispatch entry points
+; Public vector functions keep their signatures; each one is a single
+; indirect jump to the kernel installed for the current CPU (dot, cosine
+; and norm first pick the dimension-specialized variant, if any).
+; ============================================
+
+; Jump to the %2 kernel specialized for the dimension in %1 when it is a
+; positive multiple of 128 (every supported embedding dimension), to the
+; generic kernel otherwise. Uses only eax and r10, which are volatile and
+; no kernel reads on entry.
+%macro FIXED_DIM_DISPATCH 2
+    mov eax, %1
+    test eax, 0x8000007F
+    jnz .generic
+    shr eax, 7                ; 0 only for dimension 0 (generic slot)
+    mov r10d, 3
+    cmp eax, r10d
+    cmova eax, r10d
+    lea r10, [rel %{2}_fixed]
+    jmp qword [r10 + rax*8]
+.generic:
+    jmp qword [rel %{2}_impl]
+%endmacro
+
+global dot_product_asm
+dot_product_asm:
+    FIXED_DIM_DISPATCH PARAM3D, dot_product
+
+global cosine_similarity_asm
+cosine_similarity_asm:
+    FIXED_DIM_DISPATCH PARAM3D, cosine_similarity
+
+global vector_norm_asm
+vector_norm_asm:
+    FIXED_DIM_DISPATCH PARAM2D, vector_norm
+
+global normalize_vector_asm
+normalize_vector_asm:
+    jmp qword [rel normalize_vector_impl]
+
+global add_vectors_asm
+add_vectors_asm:
+    jmp qword [rel add_vectors_impl]
+
+global dot_product_x4_asm
+dot_product_x4_asm:
+    jmp qword [rel dot_product_x4_impl]
+
+global int8_dot_product_asm
+int8_dot_product_asm:
+    jmp qword [rel int8_dot_impl]
+
+global hamming_distance_asm
+hamming_distance_asm:
+    jmp qword [rel hamming_impl]
+
+global f16_to_f32_asm
+f16_to_f32_asm:
+    jmp qword [rel f16_to_f32_impl]
+
+global f32_to_f16_asm
+f32_to_f16_asm:
+    jmp qword [rel f32_to_f16_impl]
+
+global bf16_to_f32_asm
+bf16_to_f32_asm:
+    jmp qword [rel bf16_to_f32_impl]
+
+global f32_to_bf16_asm
+f32_to_bf16_asm:
+    jmp qword [rel f32_to_bf16_impl]
+
+; Resolver used on the first call: saves the argument registers of both
+; ABIs, installs the best kernel set, then tail-jumps to the new kernel.
+%macro SIMD_RESOLVER 1
+    push rdi
+    push rsi
+    push rdx
+    push rcx
+    push r8
+    push r9
+    sub rsp, 8 + SHADOW_SPACE       ; Keep rsp 16-byte aligned for the call
+    mov PARAM1D, SIMD_LEVEL_AVX512
+    call simd_select_level_asm
+    add rsp, 8 + SHADOW_SPACE
+    pop r9
+    pop r8
+    pop rcx
+    pop rdx
+    pop rsi
+    pop rdi
+    jmp qword [rel %1]
+%endmacro
+
+dot_product_resolve:
+    SIMD_RESOLVER dot_product_impl
+
+cosine_similarity_resolve:
+    SIMD_RESOLVER cosine_similarity_impl
+
+vector_norm_resolve:
+    SIMD_RESOLVER vector_norm_impl
+
+normalize_vector_resolve:
+    SIMD_RESOLVER normalize_vector_impl
+
+add_vectors_resolve:
+    SIMD_RESOLVER add_vectors_impl
+
+dot_product_x4_resolve:
+    SIMD_RESOLVER dot_product_x4_impl
+
+int8_dot_resolve:
+    SIMD_RESOLVER int8_dot_impl
+
+hamming_resolve:
+    SIMD_RESOLVER hamming_impl
+
+f16_to_f32_resolve:
+    SIMD_RESOLVER f16_to_f32_impl
+
+f32_to_f16_resolve:
+    SIMD_RESOLVER f32_to_f16_impl
+
+bf16_to_f32_resolve:
+    SIMD_RESOLVER bf16_to_f32_impl
+
+f32_to_bf16_resolve:
+    SIMD_RESOLVER f32_to_bf16_impl
+
+; ============================================
+; Function: simd_detect_level
+; Detect the best SIMD level supported by the CPU and the OS
+; AVX2 level requires AVX2 + FMA + F16C with YMM state enabled (XCR0);
+; AVX-512 level additionally requires AVX-512F with ZMM/opmask state.
+; Returns:
+;   EAX = SIMD_LEVEL_SSE, SIMD_LEVEL_AVX2 or SIMD_LEVEL_AVX512
+; ============================================
+simd_detect_level:
+    push rbx                  ; CPUID clobbers rbx (callee-saved)
+    mov r11d, SIMD_LEVEL_SSE
+
+    xor eax, eax
+    cpuid
+    cmp eax, 7                ; Leaf 7 (extended features) available?
+    jl .done
+
+    mov eax, 1
+    cpuid
+    mov r8d, ecx
+    and r8d, 0x38001000       ; OSXSAVE (27) | AVX (28) | F16C (29) | FMA (12)
+    cmp r8d, 0x38001000
+    jne .done
+
+    xor ecx, ecx
+    xgetbv                    ; EAX = XCR0 low bits (OS-enabled state)
+    mov r9d, eax
+    and eax, 0x06             ; XMM | YMM state
+    cmp eax, 0x06
+    jne .done
+
+    mov eax, 7
+    xor ecx, ecx
+    cpuid
+    test ebx, 0x20            ; AVX2 (bit 5)
+    jz .done
+    mov r11d, SIMD_LEVEL_AVX2
+
+    test ebx, 0x10000         ; AVX-512F (bit 16)
+    jz .done
+    and r9d, 0xE6             ; + opmask | ZMM_Hi256 | Hi16_ZMM state
+    cmp r9d, 0xE6
+    jne .done
+    mov r11d, SIMD_LEVEL_AVX512
+
+.done:
+    mov eax, r11d
+    pop rbx
+    ret
+
+; ============================================
+; Function: simd_detect_avx512_ext
+; Detect the AVX-512 extensions used by the quantized kernels
+; Only called once the AVX-512 level is known to be usable.
+; Returns:
+;   EAX bit 0 = AVX512-VNNI + AVX512BW (int8 dot product)
+;   EAX bit 1 = AVX512-VPOPCNTDQ (Hamming distance)
+; ============================================
+simd_detect_avx512_ext:
+    push rbx
+    mov eax, 7
+    xor ecx, ecx
+    cpuid
+    xor eax, eax
+    test ebx, 0x40000000      ; AVX512BW (bit 30)
+    jz .popcnt
+    test ecx, 0x800           ; AVX512_VNNI (bit 11)
+    jz .popcnt
+    or eax, 1
+.popcnt:
+    test ecx, 0x4000          ; AVX512_VPOPCNTDQ (bit 14)
+    jz .done
+    or eax, 2
+.done:
+    pop rbx
+    ret
+
+; ============================================
+; Function: simd_select_level_asm
+; Install the best kernel set up to a maximum level
+; Parameters:
+;   PARAM1 = int max_level (fastembed_simd_level_t)
+; Returns:
+;   EAX = installed level (lower than max_level if the CPU lacks support)
+; ============================================
+; Install kernel %1_%2 and its dimension-specialized variants (uses rcx)
+%macro INSTALL_FIXED 2
+    lea rcx, [rel %{1}_%{2}]
+    mov [rel %{1}_impl], rcx
+    mov [rel %{1}_fixed], rcx
+    lea rcx, [rel %{1}_%{2}_d128]
+    mov [rel %{1}_fixed + 8], rcx
+    lea rcx, [rel %{1}_%{2}_d256]
+    mov [rel %{1}_fixed + 16], rcx
+    lea rcx, [rel %{1}_%{2}_blocks]
+    mov [rel %{1}_fixed + 24], rcx
+%endmacro
+
+global simd_select_level_asm
+simd_select_level_asm:
+    push rbp
+    mov rbp, rsp
+    push r12
+    sub rsp, 8 + SHADOW_SPACE
+
+    mov r12d, PARAM1D         ; max_level
+    call simd_detect_level
+    cmp r12d, eax
+    cmovl eax, r12d           ; eax = min(max_level, detected)
+
+    cmp eax, SIMD_LEVEL_AVX512
+    jge .install_avx512
+    cmp eax, SIMD_LEVEL_AVX2
+    jge .install_avx2
+
+    INSTALL_FIXED dot_product, sse
+    INSTALL_FIXED cosine_similarity, sse
+    INSTALL_FIXED vector_norm, sse
+    lea rcx, [rel normalize_vector_sse]
+    mov [rel normalize_vector_impl], rcx
+    lea rcx, [rel add_vectors_sse]
+    mov [rel add_vectors_impl], rcx
+    lea rcx, [rel dot_product_x4_sse]
+    mov [rel dot_product_x4_impl], rcx
+    lea rcx, [rel int8_dot_sse]
+    mov [rel int8_dot_impl], rcx
+    lea rcx, [rel hamming_swar]
+    mov [rel hamming_impl], rcx
+    lea rcx, [rel half_convert_none]  ; No F16C in the baseline
+    mov [rel f16_to_f32_impl], rcx
+    mov [rel f32_to_f16_impl], rcx
+    lea rcx, [rel bf16_to_f32_sse]
+    mov [rel bf16_to_f32_impl], rcx
+    lea rcx, [rel f32_to_bf16_sse]
+    mov [rel f32_to_bf16_impl], rcx
+    mov eax, SIMD_LEVEL_SSE
+    jmp .done
+
+.install_avx2:
+    INSTALL_FIXED dot_product, avx2
+    INSTALL_FIXED cosine_similarity, avx2
+    INSTALL_FIXED vector_norm, avx2
+    lea rcx, [rel normalize_vector_avx2]
+    mov [rel normalize_vector_impl], rcx
+    lea rcx, [rel add_vectors_avx2]
+    mov [rel add_vectors_impl], rcx
+    lea rcx, [rel dot_product_x4_avx2]
+    mov [rel dot_product_x4_impl], rcx
+    lea rcx, [rel int8_dot_avx2]
+    mov [rel int8_dot_impl], rcx
+    lea rcx, [rel hamming_popcnt]
+    mov [rel hamming_impl], rcx
+    lea rcx, [rel f16_to_f32_f16c]
+    mov [rel f16_to_f32_impl], rcx
+    lea rcx, [rel f32_to_f16_f16c]
+    mov [rel f32_to_f16_impl], rcx
+    lea rcx, [rel bf16_to_f32_avx2]
+    mov [rel bf16_to_f32_impl], rcx
+    lea rcx, [rel f32_to_bf16_avx2]
+    mov [rel f32_to_bf16_impl], rcx
+    mov eax, SIMD_LEVEL_AVX2
+    jmp .done
+
+.install_avx512:
+    ; VNNI / VPOPCNTDQ kernels when present, AVX2-level ones otherwise
+    call simd_detect_avx512_ext
+    lea rcx, [rel int8_dot_avx2]
+    test eax, 1
+    jz .int8_selected
+    lea rcx, [rel int8_dot_vnni]
+.int8_selected:
+    mov [rel int8_dot_impl], rcx
+    lea rcx, [rel hamming_popcnt]
+    test eax, 2
+    jz .hamming_selected
+    lea rcx, [rel hamming_avx512]
+.hamming_selected:
+    mov [rel hamming_impl], rcx
+
+    INSTALL_FIXED dot_product, avx512
+    INSTALL_FIXED cosine_similarity, avx512
+    INSTALL_FIXED vector_norm, avx512
+    lea rcx, [rel normalize_vector_avx512]
+    mov [rel normalize_vector_impl], rcx
+    lea rcx, [rel add_vectors_avx512]
+    mov [rel add_vectors_impl], rcx
+    lea rcx, [rel dot_product_x4_avx512]
+    mov [rel dot_product_x4_impl], rcx
+    lea rcx, [rel f16_to_f32_avx512]
+    mov [rel f16_to_f32_impl], rcx
+    lea rcx, [rel f32_to_f16_avx512]
+    mov [rel f32_to_f16_impl], rcx
+    lea rcx, [rel bf16_to_f32_avx512]
+    mov [rel bf16_to_f32_impl], rcx
+    lea rcx, [rel f32_to_bf16_avx512]
+    mov [rel f32_to_bf16_impl], rcx
+    mov eax, SIMD_LEVEL_AVX512
+
+.done:
+    ; Slots are written before the level, so a reader that sees the level
+    ; also sees the matching kernels (x86 stores are not reordered)
+    mov [rel simd_level], eax
+    add rsp, 8 + SHADOW_SPACE
+    pop r12
+    pop rbp
+    ret
+
+; ============================================
+; Function: simd_get_level_asm
+; Get the installed SIMD level (selects the best one if none yet)
+; Returns:
+;   EAX = installed level (fastembed_simd_level_t)
+; ============================================
+global simd_get_level_asm
+simd_get_level_asm:
+    mov eax, [rel simd_level]
+    test eax, eax
+    jnz .done
+    sub rsp, 8 + SHADOW_SPACE
+    mov PARAM1D, SIMD_LEVEL_AVX512
+    call simd_select_level_asm
+    add rsp, 8 + SHADOW_SPACE
+.done:
+    ret
+
+; ============================================
+; Function: dot_product_sse
+; Calculate dot product of two embedding vectors (SSE kernel)
 ; Parameters (Windows x64 calling convention):
 ;   RCX = float* vector_a (pointer to first vector)
 ;   RDX = float* vector_b (pointer to second vector)
@@ -68,8 +487,7 @@ default rel    ; Use RIP-relative addressing for PIC
 ; Returns:
 ;   XMM0 = dot product (float)
 ; ============================================
-global dot_product_asm
-dot_product_asm:
+dot_product_sse:
     ; Prologue
     push rbp
     mov rbp, rsp
@@ -154,112 +572,98 @@ dot_product_asm:
 
 
 ; ============================================
-; Function: cosine_similarity_asm
-; Calculate cosine similarity between two embedding vectors
+; Function: cosine_similarity_sse
+; Calculate cosine similarity between two embedding vectors (SSE kernel)
 ; cosine_similarity = dot(a,b) / (||a|| * ||b||)
+; a·b, a·a and b·b are accumulated in a single pass over both vectors.
 ; Parameters:
 ;   RCX = float* vector_a
 ;   RDX = float* vector_b
 ;   R8  = int dimension
 ; Returns:
-;   XMM0 = cosine similarity (float)
+;   XMM0 = cosine similarity (float), 0 if either vector has zero norm
 ; ============================================
-global cosine_similarity_asm
-cosine_similarity_asm:
-    ; Prologue
-    push rbp           ; rsp -= 8
-    mov rbp, rsp
-    
-    ; Save callee-saved registers (System V ABI requires r12, r13, r14, r15, rbx)
-    push r12           ; rsp -= 8  (total: 16)
-    push r13           ; rsp -= 8  (total: 24)
-    push r14           ; rsp -= 8  (total: 32) - save r14 for parameters
-    
-    ; Stack layout after pushes:
-    ; rsp+0:  r14 (saved, will store dimension)
-    ; rsp+8:  r13 (saved, will store vector_b)
-    ; rsp+16: r12 (saved, will store vector_a)
-    ; rsp+24: rbp (saved)
-    ; rsp+32: return address
-    
-    ; Allocate space for local variables (dot_product, norm_a, norm_b = 3 floats = 12 bytes, round to 16)
-    ; After 4 pushes: 32 bytes (32 mod 16 = 0, already aligned!)
-    ; Add 16 bytes for local variables
-    sub rsp, 16        ; Space for: dot_product (rsp+0), norm_a (rsp+4), norm_b (rsp+8)
-    
-    ; Save parameters to callee-saved registers and stack
-    ; Parameters: PARAM1=vector_a, PARAM2=vector_b, PARAM3=dimension
-    mov r12, PARAM1    ; vector_a (callee-saved, safe)
-    mov r13, PARAM2    ; vector_b (callee-saved, safe)
-    mov r14, PARAM3    ; dimension (callee-saved, safe)
-    
-    ; Step 1: Calculate dot product
-    ; Stack is now aligned: after 4 pushes (32 bytes, aligned) + 16 bytes locals = 48 total
-    ; Before call, rsp must be aligned: 48 mod 16 = 0 ✓
-%ifidn __OUTPUT_FORMAT__,elf64
-    mov rdi, r12       ; vector_a
-    mov rsi, r13       ; vector_b
-    mov rdx, r14       ; dimension
-%else
-    mov rcx, r12       ; Windows: vector_a
-    mov rdx, r13       ; Windows: vector_b
-    mov r8, r14        ; Windows: dimension
-%endif
-    call dot_product_asm
-    movss [rsp + 0], xmm0   ; Save dot_product
-    
-    ; Step 2: Calculate ||vector_a|| (L2 norm)
-    ; Stack is still aligned after call (call preserved alignment)
-%ifidn __OUTPUT_FORMAT__,elf64
-    mov rdi, r12       ; vector_a
-    mov rsi, r14       ; dimension
-%else
-    mov rcx, r12       ; Windows: vector_a
-    mov rdx, r14       ; Windows: dimension
-%endif
-    call vector_norm_asm
-    movss [rsp + 4], xmm0   ; Save norm_a
-    
-    ; Step 3: Calculate ||vector_b|| (L2 norm)
-    ; Stack is still aligned
-%ifidn __OUTPUT_FORMAT__,elf64
-    mov rdi, r13       ; vector_b
-    mov rsi, r14       ; dimension
-%else
-    mov rcx, r13       ; Windows: vector_b
-    mov rdx, r14       ; Windows: dimension
-%endif
-    call vector_norm_asm
-    movss [rsp + 8], xmm0   ; Save norm_b
-    
-    ; Step 4: Calculate cosine = dot / (norm_a * norm_b)
-    movss xmm0, [rsp + 0]   ; xmm0 = dot_product
-    movss xmm1, [rsp + 4]   ; xmm1 = norm_a
-    mulss xmm1, [rsp + 8]   ; xmm1 = norm_a * norm_b
-    
+cosine_similarity_sse:
+    ; Leaf function: only volatile registers (xmm0-xmm5) are used
+    mov r10, PARAM1     ; vector_a
+    mov r11, PARAM2     ; vector_b
+    movsxd r9, PARAM3D  ; dimension
+
+    xorps xmm0, xmm0    ; xmm0 = sum(a*b)
+    xorps xmm1, xmm1    ; xmm1 = sum(a*a)
+    xorps xmm2, xmm2    ; xmm2 = sum(b*b)
+
+    mov rcx, r9
+    and rcx, -4         ; Elements handled 4 at a time
+    xor rax, rax
+
+.simd_loop:
+    cmp rax, rcx
+    jge .scalar_loop
+    movups xmm3, [r10 + rax*4]   ; xmm3 = vector_a[i:i+4]
+    movups xmm4, [r11 + rax*4]   ; xmm4 = vector_b[i:i+4]
+    movaps xmm5, xmm3
+    mulps xmm5, xmm4
+    addps xmm0, xmm5             ; a*b
+    mulps xmm3, xmm3
+    addps xmm1, xmm3             ; a*a
+    mulps xmm4, xmm4
+    addps xmm2, xmm4             ; b*b
+    add rax, 4
+    jmp .simd_loop
+
+.scalar_loop:
+    ; Remaining elements go into lane 0 (SSE scalar ops keep lanes 1-3)
+    cmp rax, r9
+    jge .reduce
+    movss xmm3, [r10 + rax*4]
+    movss xmm4, [r11 + rax*4]
+    movss xmm5, xmm3
+    mulss xmm5, xmm4
+    addss xmm0, xmm5
+    mulss xmm3, xmm3
+    addss xmm1, xmm3
+    mulss xmm4, xmm4
+    addss xmm2, xmm4
+    inc rax
+    jmp .scalar_loop
+
+.reduce:
+    ; Horizontal sums: ab and aa are reduced together
+    movaps xmm3, xmm0
+    unpcklps xmm0, xmm1          ; [ab0, aa0, ab1, aa1]
+    unpckhps xmm3, xmm1          ; [ab2, aa2, ab3, aa3]
+    addps xmm0, xmm3             ; [ab0+ab2, aa0+aa2, ab1+ab3, aa1+aa3]
+    movhlps xmm3, xmm0
+    addps xmm0, xmm3             ; xmm0[0] = ab, xmm0[1] = aa
+    movhlps xmm3, xmm2
+    addps xmm2, xmm3
+    movaps xmm3, xmm2
+    shufps xmm3, xmm3, 0x55
+    addss xmm2, xmm3             ; xmm2[0] = bb
+
+    movaps xmm1, xmm0
+    shufps xmm1, xmm1, 0x55      ; xmm1[0] = aa
+    sqrtss xmm1, xmm1            ; ||a||
+    sqrtss xmm2, xmm2            ; ||b||
+    mulss xmm1, xmm2             ; ||a|| * ||b||
+
     ; Avoid division by zero
-    movss xmm2, xmm1
-    comiss xmm2, [rel float_zero]
-    je .return_zero           ; If norm == 0, return 0
-    
-    divss xmm0, xmm1          ; xmm0 = dot / (norm_a * norm_b)
-    jmp .done
-    
+    xorps xmm2, xmm2
+    comiss xmm1, xmm2
+    je .return_zero
+
+    divss xmm0, xmm1             ; xmm0 = dot / (norm_a * norm_b)
+    ret
+
 .return_zero:
-    xorps xmm0, xmm0          ; Return 0
-    
-.done:
-    add rsp, 16         ; Free local variables space
-    pop r14              ; Restore callee-saved registers
-    pop r13
-    pop r12
-    pop rbp
+    xorps xmm0, xmm0             ; Return 0
     ret
 
 
 ; ============================================
-; Function: vector_norm_asm
-; Calculate L2 norm (Euclidean norm) of a vector
+; Function: vector_norm_sse
+; Calculate L2 norm (Euclidean norm) of a vector (SSE kernel)
 ; ||v|| = sqrt(sum(v[i]^2))
 ; Parameters:
 ;   RCX = float* vector
@@ -267,8 +671,7 @@ cosine_similarity_asm:
 ; Returns:
 ;   XMM0 = norm (float)
 ; ============================================
-global vector_norm_asm
-vector_norm_asm:
+vector_norm_sse:
     ; Prologue
     push rbp
     mov rbp, rsp
@@ -337,8 +740,8 @@ vector_norm_asm:
 
 
 ; ============================================
-; Function: normalize_vector_asm
-; Normalize a vector to unit length (in-place)
+; Function: normalize_vector_sse
+; Normalize a vector to unit length (in-place, SSE kernel)
 ; v_normalized = v / ||v||
 ; Parameters:
 ;   RCX = float* vector (modified in-place)
@@ -346,8 +749,7 @@ vector_norm_asm:
 ; Returns:
 ;   Nothing (vector is modified in-place)
 ; ============================================
-global normalize_vector_asm
-normalize_vector_asm:
+normalize_vector_sse:
     ; Prologue
     push rbp
     mov rbp, rsp
@@ -360,7 +762,7 @@ normalize_vector_asm:
     mov r10, PARAM1    ; vector
     mov r12, PARAM2    ; dimension
     
-    ; Calculate norm inline (same logic as vector_norm_asm)
+    ; Calculate norm inline (same logic as vector_norm_sse)
     ; Initialize sum of squares to zero
     xorps xmm0, xmm0
     xorps xmm1, xmm1
@@ -462,8 +864,8 @@ normalize_vector_asm:
 
 
 ; ============================================
-; Function: add_vectors_asm
-; Add two vectors element-wise: result = a + b
+; Function: add_vectors_sse
+; Add two vectors element-wise: result = a + b (SSE kernel)
 ; Parameters:
 ;   RCX = float* vector_a
 ;   RDX = float* vector_b
@@ -472,8 +874,7 @@ normalize_vector_asm:
 ; Returns:
 ;   Nothing (result written to memory)
 ; ============================================
-global add_vectors_asm
-add_vectors_asm:
+add_vectors_sse:
     push rbp
     mov rbp, rsp
     sub rsp, SHADOW_SPACE
@@ -537,3 +938,2082 @@ add_vectors_asm:
     pop rbp
     ret
 
+
+
+; ============================================
+; Function: dot_product_x4_sse
+; Dot products of one vector with four consecutive rows (SSE kernel)
+; Register tile for similarity matrices: each element of the vector is
+; loaded once and multiplied with the matching element of four rows.
+; Parameters:
+;   PARAM1 = float* vector
+;   PARAM2 = float* rows (4 rows of dimension floats, row-major)
+;   PARAM3 = int dimension
+;   PARAM4 = float* out (4 floats: out[k] = dot(vector, rows + k*dimension))
+; ============================================
+dot_product_x4_sse:
+    movsxd rax, PARAM3D       ; dimension (read first: PARAM4 may be r9)
+    mov r8, PARAM4            ; out
+    mov r9, rax               ; r9 = elements left
+    mov r10, PARAM1           ; vector pointer (advances)
+    mov r11, PARAM2           ; row 0 pointer (advances)
+    lea rdx, [rax*4]          ; rdx = row stride in bytes
+    lea rcx, [rdx + rdx*2]    ; rcx = 3 * stride
+
+    xorps xmm0, xmm0          ; Row accumulators 0-3
+    xorps xmm1, xmm1
+    xorps xmm2, xmm2
+    xorps xmm3, xmm3
+
+.simd_loop:
+    cmp r9, 4
+    jl .scalar_loop
+    movups xmm4, [r10]
+    movups xmm5, [r11]
+    mulps xmm5, xmm4
+    addps xmm0, xmm5
+    movups xmm5, [r11 + rdx]
+    mulps xmm5, xmm4
+    addps xmm1, xmm5
+    movups xmm5, [r11 + rdx*2]
+    mulps xmm5, xmm4
+    addps xmm2, xmm5
+    movups xmm5, [r11 + rcx]
+    mulps xmm5, xmm4
+    addps xmm3, xmm5
+    add r10, 16
+    add r11, 16
+    sub r9, 4
+    jmp .simd_loop
+
+.scalar_loop:
+    ; Remaining elements go into lane 0 (SSE scalar ops keep lanes 1-3)
+    test r9, r9
+    jz .reduce
+    movss xmm4, [r10]
+    movss xmm5, [r11]
+    mulss xmm5, xmm4
+    addss xmm0, xmm5
+    movss xmm5, [r11 + rdx]
+    mulss xmm5, xmm4
+    addss xmm1, xmm5
+    movss xmm5, [r11 + rdx*2]
+    mulss xmm5, xmm4
+    addss xmm2, xmm5
+    movss xmm5, [r11 + rcx]
+    mulss xmm5, xmm4
+    addss xmm3, xmm5
+    add r10, 4
+    add r11, 4
+    dec r9
+    jmp .scalar_loop
+
+.reduce:
+    ; 4x4 transpose-add: xmm0 = [sum0, sum1, sum2, sum3]
+    movaps xmm4, xmm0
+    unpcklps xmm0, xmm1       ; [a0, b0, a1, b1]
+    unpckhps xmm4, xmm1       ; [a2, b2, a3, b3]
+    addps xmm0, xmm4
+    movaps xmm4, xmm2
+    unpcklps xmm2, xmm3       ; [c0, d0, c1, d1]
+    unpckhps xmm4, xmm3       ; [c2, d2, c3, d3]
+    addps xmm2, xmm4
+    movaps xmm4, xmm0
+    movlhps xmm0, xmm2        ; [a02, b02, c02, d02]
+    movhlps xmm2, xmm4        ; [a13, b13, c13, d13]
+    addps xmm0, xmm2
+    movups [r8], xmm0
+    ret
+
+
+; ============================================
+; AVX2 + FMA kernels
+; Leaf functions (no stack frame). Four independent 8-wide accumulators
+; hide the FMA latency; only xmm0-xmm5 are used, so no callee-saved
+; vector registers need to be preserved on Windows. vzeroupper before every
+; return avoids AVX-SSE transition penalties in the caller.
+; ============================================
+
+; Horizontal sum of the four floats in xmm0 (result in xmm0[0], uses xmm1)
+%macro HSUM_XMM0 0
+    vmovhlps xmm1, xmm0, xmm0
+    vaddps xmm0, xmm0, xmm1
+    vmovshdup xmm1, xmm0
+    vaddss xmm0, xmm0, xmm1
+%endmacro
+
+; Finish a fused cosine from 8-wide partial sums ymm0 = a*b, ymm2 = a*a,
+; ymm4 = b*b: leaves xmm0[0] = a·b and xmm1[0] = ||a|| * ||b||
+%macro COSINE_FINISH_YMM 0
+    vhaddps ymm0, ymm0, ymm2  ; [ab01, ab23, aa01, aa23 | ab45, ab67, aa45, aa67]
+    vhaddps ymm4, ymm4, ymm4  ; [bb01, bb23, bb01, bb23 | bb45, bb67, ...]
+    vhaddps ymm0, ymm0, ymm4  ; [ab0-3, aa0-3, bb0-3, bb0-3 | 4-7 ...]
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1   ; [ab, aa, bb, bb]
+    vsqrtps xmm1, xmm0        ; lane 1 = ||a||, lane 2 = ||b||
+    vmovshdup xmm2, xmm1      ; lane 0 = ||a||, lane 2 = ||b||
+    vmovhlps xmm3, xmm2, xmm2 ; lane 0 = ||b||
+    vmulss xmm1, xmm2, xmm3
+%endmacro
+
+; ============================================
+; Function: dot_product_avx2
+; Parameters: PARAM1 = float* a, PARAM2 = float* b, PARAM3 = int dimension
+; Returns: XMM0 = dot product
+; ============================================
+dot_product_avx2:
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    movsxd r9, PARAM3D        ; dimension
+    vxorps xmm0, xmm0, xmm0   ; Accumulators 0-3
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    vxorps xmm5, xmm5, xmm5   ; Scalar tail accumulator
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -32              ; Elements handled 32 at a time
+.loop32:
+    cmp rax, rcx
+    jge .tail8
+    vmovups ymm4, [r10 + rax*4]
+    vfmadd231ps ymm0, ymm4, [r11 + rax*4]
+    vmovups ymm4, [r10 + rax*4 + 32]
+    vfmadd231ps ymm1, ymm4, [r11 + rax*4 + 32]
+    vmovups ymm4, [r10 + rax*4 + 64]
+    vfmadd231ps ymm2, ymm4, [r11 + rax*4 + 64]
+    vmovups ymm4, [r10 + rax*4 + 96]
+    vfmadd231ps ymm3, ymm4, [r11 + rax*4 + 96]
+    add rax, 32
+    jmp .loop32
+
+.tail8:
+    mov rcx, r9
+    and rcx, -8
+.loop8:
+    cmp rax, rcx
+    jge .tail1
+    vmovups ymm4, [r10 + rax*4]
+    vfmadd231ps ymm0, ymm4, [r11 + rax*4]
+    add rax, 8
+    jmp .loop8
+
+.tail1:
+    cmp rax, r9
+    jge .reduce
+    vmovss xmm4, [r10 + rax*4]
+    vfmadd231ss xmm5, xmm4, [r11 + rax*4]
+    inc rax
+    jmp .tail1
+
+.reduce:
+    vaddps ymm0, ymm0, ymm1
+    vaddps ymm2, ymm2, ymm3
+    vaddps ymm0, ymm0, ymm2
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1
+    HSUM_XMM0
+    vaddss xmm0, xmm0, xmm5
+    vzeroupper
+    ret
+
+; ============================================
+; Function: vector_norm_avx2
+; Parameters: PARAM1 = float* vector, PARAM2 = int dimension
+; Returns: XMM0 = L2 norm
+; ============================================
+vector_norm_avx2:
+    mov r10, PARAM1           ; vector
+    movsxd r9, PARAM2D        ; dimension
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    vxorps xmm5, xmm5, xmm5
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -32
+.loop32:
+    cmp rax, rcx
+    jge .tail8
+    vmovups ymm4, [r10 + rax*4]
+    vfmadd231ps ymm0, ymm4, ymm4
+    vmovups ymm4, [r10 + rax*4 + 32]
+    vfmadd231ps ymm1, ymm4, ymm4
+    vmovups ymm4, [r10 + rax*4 + 64]
+    vfmadd231ps ymm2, ymm4, ymm4
+    vmovups ymm4, [r10 + rax*4 + 96]
+    vfmadd231ps ymm3, ymm4, ymm4
+    add rax, 32
+    jmp .loop32
+
+.tail8:
+    mov rcx, r9
+    and rcx, -8
+.loop8:
+    cmp rax, rcx
+    jge .tail1
+    vmovups ymm4, [r10 + rax*4]
+    vfmadd231ps ymm0, ymm4, ymm4
+    add rax, 8
+    jmp .loop8
+
+.tail1:
+    cmp rax, r9
+    jge .reduce
+    vmovss xmm4, [r10 + rax*4]
+    vfmadd231ss xmm5, xmm4, xmm4
+    inc rax
+    jmp .tail1
+
+.reduce:
+    vaddps ymm0, ymm0, ymm1
+    vaddps ymm2, ymm2, ymm3
+    vaddps ymm0, ymm0, ymm2
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1
+    HSUM_XMM0
+    vaddss xmm0, xmm0, xmm5
+    vsqrtss xmm0, xmm0, xmm0
+    vzeroupper
+    ret
+
+; ============================================
+; Function: cosine_similarity_avx2
+; Parameters: PARAM1 = float* a, PARAM2 = float* b, PARAM3 = int dimension
+; Returns: XMM0 = dot(a, b) / (||a|| * ||b||), 0 if either norm is 0
+; a·b, a·a and b·b are accumulated in one pass (two 8-wide accumulators
+; each); the last partial block uses a masked load.
+; ============================================
+cosine_similarity_avx2:
+%ifidn __OUTPUT_FORMAT__,win64
+    sub rsp, 40               ; xmm6/xmm7 are callee-saved on Windows
+    vmovups [rsp], xmm6
+    vmovups [rsp + 16], xmm7
+%endif
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    movsxd r9, PARAM3D        ; dimension
+    vxorps xmm0, xmm0, xmm0   ; a*b
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2   ; a*a
+    vxorps xmm3, xmm3, xmm3
+    vxorps xmm4, xmm4, xmm4   ; b*b
+    vxorps xmm5, xmm5, xmm5
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -16
+.loop16:
+    cmp rax, rcx
+    jge .tail8
+    vmovups ymm6, [r10 + rax*4]
+    vmovups ymm7, [r11 + rax*4]
+    vfmadd231ps ymm0, ymm6, ymm7
+    vfmadd231ps ymm2, ymm6, ymm6
+    vfmadd231ps ymm4, ymm7, ymm7
+    vmovups ymm6, [r10 + rax*4 + 32]
+    vmovups ymm7, [r11 + rax*4 + 32]
+    vfmadd231ps ymm1, ymm6, ymm7
+    vfmadd231ps ymm3, ymm6, ymm6
+    vfmadd231ps ymm5, ymm7, ymm7
+    add rax, 16
+    jmp .loop16
+
+.tail8:
+    vaddps ymm0, ymm0, ymm1
+    vaddps ymm2, ymm2, ymm3
+    vaddps ymm4, ymm4, ymm5
+    mov rcx, r9
+    sub rcx, rax              ; Remaining elements (0-15)
+    cmp rcx, 8
+    jl .masked
+    vmovups ymm6, [r10 + rax*4]
+    vmovups ymm7, [r11 + rax*4]
+    vfmadd231ps ymm0, ymm6, ymm7
+    vfmadd231ps ymm2, ymm6, ymm6
+    vfmadd231ps ymm4, ymm7, ymm7
+    add rax, 8
+    sub rcx, 8
+
+.masked:
+    test rcx, rcx
+    jz .reduce
+    lea rdx, [rel avx2_tail_mask]
+    neg rcx
+    vmovups ymm1, [rdx + rcx*4 + 32] ; First (remaining) lanes set
+    vmaskmovps ymm6, ymm1, [r10 + rax*4]
+    vmaskmovps ymm7, ymm1, [r11 + rax*4]
+    vfmadd231ps ymm0, ymm6, ymm7
+    vfmadd231ps ymm2, ymm6, ymm6
+    vfmadd231ps ymm4, ymm7, ymm7
+
+.reduce:
+    COSINE_FINISH_YMM
+    vxorps xmm2, xmm2, xmm2
+    vcomiss xmm1, xmm2
+    je .return_zero
+    vdivss xmm0, xmm0, xmm1
+    jmp .done
+
+.return_zero:
+    vxorps xmm0, xmm0, xmm0
+
+.done:
+    vzeroupper
+%ifidn __OUTPUT_FORMAT__,win64
+    vmovups xmm6, [rsp]
+    vmovups xmm7, [rsp + 16]
+    add rsp, 40
+%endif
+    ret
+
+; ============================================
+; Function: normalize_vector_avx2
+; Parameters: PARAM1 = float* vector (in-place), PARAM2 = int dimension
+; ============================================
+normalize_vector_avx2:
+    push rbp
+    mov rbp, rsp
+    push r12
+    push r13
+    sub rsp, SHADOW_SPACE
+
+    mov r12, PARAM1           ; vector
+    movsxd r13, PARAM2D       ; dimension
+    call vector_norm_avx2     ; Arguments are still in place
+
+    vxorps xmm1, xmm1, xmm1
+    vcomiss xmm0, xmm1
+    je .done                  ; Zero vector: leave unchanged
+
+    vmovss xmm1, [rel float_one]
+    vdivss xmm1, xmm1, xmm0
+    vbroadcastss ymm4, xmm1   ; ymm4 = 1 / norm
+
+    xor rax, rax
+    mov rcx, r13
+    and rcx, -32
+.loop32:
+    cmp rax, rcx
+    jge .tail8
+    vmulps ymm0, ymm4, [r12 + rax*4]
+    vmulps ymm1, ymm4, [r12 + rax*4 + 32]
+    vmulps ymm2, ymm4, [r12 + rax*4 + 64]
+    vmulps ymm3, ymm4, [r12 + rax*4 + 96]
+    vmovups [r12 + rax*4], ymm0
+    vmovups [r12 + rax*4 + 32], ymm1
+    vmovups [r12 + rax*4 + 64], ymm2
+    vmovups [r12 + rax*4 + 96], ymm3
+    add rax, 32
+    jmp .loop32
+
+.tail8:
+    mov rcx, r13
+    and rcx, -8
+.loop8:
+    cmp rax, rcx
+    jge .tail1
+    vmulps ymm0, ymm4, [r12 + rax*4]
+    vmovups [r12 + rax*4], ymm0
+    add rax, 8
+    jmp .loop8
+
+.tail1:
+    cmp rax, r13
+    jge .done
+    vmulss xmm0, xmm4, [r12 + rax*4]
+    vmovss [r12 + rax*4], xmm0
+    inc rax
+    jmp .tail1
+
+.done:
+    vzeroupper
+    add rsp, SHADOW_SPACE
+    pop r13
+    pop r12
+    pop rbp
+    ret
+
+; ============================================
+; Function: add_vectors_avx2
+; Parameters: PARAM1 = float* a, PARAM2 = float* b, PARAM3 = float* result,
+;             PARAM4 = int dimension
+; ============================================
+add_vectors_avx2:
+    movsxd r9, PARAM4D        ; dimension (read first: PARAM4 may be rcx)
+    mov r8, PARAM3            ; result
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -32
+.loop32:
+    cmp rax, rcx
+    jge .tail8
+    vmovups ymm0, [r10 + rax*4]
+    vmovups ymm1, [r10 + rax*4 + 32]
+    vmovups ymm2, [r10 + rax*4 + 64]
+    vmovups ymm3, [r10 + rax*4 + 96]
+    vaddps ymm0, ymm0, [r11 + rax*4]
+    vaddps ymm1, ymm1, [r11 + rax*4 + 32]
+    vaddps ymm2, ymm2, [r11 + rax*4 + 64]
+    vaddps ymm3, ymm3, [r11 + rax*4 + 96]
+    vmovups [r8 + rax*4], ymm0
+    vmovups [r8 + rax*4 + 32], ymm1
+    vmovups [r8 + rax*4 + 64], ymm2
+    vmovups [r8 + rax*4 + 96], ymm3
+    add rax, 32
+    jmp .loop32
+
+.tail8:
+    mov rcx, r9
+    and rcx, -8
+.loop8:
+    cmp rax, rcx
+    jge .tail1
+    vmovups ymm0, [r10 + rax*4]
+    vaddps ymm0, ymm0, [r11 + rax*4]
+    vmovups [r8 + rax*4], ymm0
+    add rax, 8
+    jmp .loop8
+
+.tail1:
+    cmp rax, r9
+    jge .done
+    vmovss xmm0, [r10 + rax*4]
+    vaddss xmm0, xmm0, [r11 + rax*4]
+    vmovss [r8 + rax*4], xmm0
+    inc rax
+    jmp .tail1
+
+.done:
+    vzeroupper
+    ret
+
+
+; ============================================
+; Function: dot_product_x4_avx2
+; Parameters: PARAM1 = float* vector, PARAM2 = float* rows (4 x dimension),
+;             PARAM3 = int dimension, PARAM4 = float* out (4 floats)
+; Each 8-float block of the vector is loaded once and FMA'd against the
+; four rows as memory operands; the tail uses masked loads.
+; ============================================
+dot_product_x4_avx2:
+    movsxd rax, PARAM3D       ; dimension (read first: PARAM4 may be r9)
+    mov r8, PARAM4            ; out
+    mov r9, rax               ; r9 = elements left
+    mov r10, PARAM1           ; vector pointer (advances)
+    mov r11, PARAM2           ; row 0 pointer (advances)
+    lea rdx, [rax*4]          ; rdx = row stride in bytes
+    lea rcx, [rdx + rdx*2]    ; rcx = 3 * stride
+
+    vxorps xmm0, xmm0, xmm0   ; Row accumulators 0-3
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+
+.loop8:
+    cmp r9, 8
+    jl .masked
+    vmovups ymm4, [r10]
+    vfmadd231ps ymm0, ymm4, [r11]
+    vfmadd231ps ymm1, ymm4, [r11 + rdx]
+    vfmadd231ps ymm2, ymm4, [r11 + rdx*2]
+    vfmadd231ps ymm3, ymm4, [r11 + rcx]
+    add r10, 32
+    add r11, 32
+    sub r9, 8
+    jmp .loop8
+
+.masked:
+    test r9, r9
+    jz .reduce
+    lea rax, [rel avx2_tail_mask]
+    neg r9
+    vmovups ymm5, [rax + r9*4 + 32] ; First (remaining) lanes set
+    vmaskmovps ymm4, ymm5, [r10]
+    vmaskmovps ymm5, ymm5, [r11]    ; Mask is consumed by the last use
+    vfmadd231ps ymm0, ymm4, ymm5
+    vmovups ymm5, [rax + r9*4 + 32]
+    vmaskmovps ymm5, ymm5, [r11 + rdx]
+    vfmadd231ps ymm1, ymm4, ymm5
+    vmovups ymm5, [rax + r9*4 + 32]
+    vmaskmovps ymm5, ymm5, [r11 + rdx*2]
+    vfmadd231ps ymm2, ymm4, ymm5
+    vmovups ymm5, [rax + r9*4 + 32]
+    vmaskmovps ymm5, ymm5, [r11 + rcx]
+    vfmadd231ps ymm3, ymm4, ymm5
+
+.reduce:
+    vhaddps ymm0, ymm0, ymm1  ; [a01, a23, b01, b23 | a45, a67, b45, b67]
+    vhaddps ymm2, ymm2, ymm3  ; [c01, c23, d01, d23 | ...]
+    vhaddps ymm0, ymm0, ymm2  ; [a0-3, b0-3, c0-3, d0-3 | a4-7, ...]
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1
+    vmovups [r8], xmm0
+    vzeroupper
+    ret
+
+
+; ============================================
+; AVX-512F kernels
+; Same structure as the AVX2 kernels with four 16-wide accumulators; the
+; last partial block uses a masked load instead of a scalar loop.
+; ============================================
+
+; Build k1 = (1 << count) - 1 for the count (1-15) remaining elements in rcx
+%macro TAIL_MASK_K1 0
+    mov edx, 1
+    shl edx, cl
+    dec edx
+    kmovw k1, edx
+%endmacro
+
+; Reduce zmm0-zmm3 to a single float in xmm0 (uses zmm1-zmm2)
+%macro REDUCE_ZMM0_3 0
+    vaddps zmm0, zmm0, zmm1
+    vaddps zmm2, zmm2, zmm3
+    vaddps zmm0, zmm0, zmm2
+    vextractf64x4 ymm1, zmm0, 1
+    vaddps ymm0, ymm0, ymm1
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1
+    HSUM_XMM0
+%endmacro
+
+; ============================================
+; Function: dot_product_avx512
+; Parameters: PARAM1 = float* a, PARAM2 = float* b, PARAM3 = int dimension
+; Returns: XMM0 = dot product
+; ============================================
+dot_product_avx512:
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    movsxd r9, PARAM3D        ; dimension
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -64              ; Elements handled 64 at a time
+.loop64:
+    cmp rax, rcx
+    jge .tail16
+    vmovups zmm4, [r10 + rax*4]
+    vfmadd231ps zmm0, zmm4, [r11 + rax*4]
+    vmovups zmm4, [r10 + rax*4 + 64]
+    vfmadd231ps zmm1, zmm4, [r11 + rax*4 + 64]
+    vmovups zmm4, [r10 + rax*4 + 128]
+    vfmadd231ps zmm2, zmm4, [r11 + rax*4 + 128]
+    vmovups zmm4, [r10 + rax*4 + 192]
+    vfmadd231ps zmm3, zmm4, [r11 + rax*4 + 192]
+    add rax, 64
+    jmp .loop64
+
+.tail16:
+    mov rcx, r9
+    and rcx, -16
+.loop16:
+    cmp rax, rcx
+    jge .masked
+    vmovups zmm4, [r10 + rax*4]
+    vfmadd231ps zmm0, zmm4, [r11 + rax*4]
+    add rax, 16
+    jmp .loop16
+
+.masked:
+    mov rcx, r9
+    sub rcx, rax              ; Remaining elements (0-15)
+    jz .reduce
+    TAIL_MASK_K1
+    vmovups zmm4{k1}{z}, [r10 + rax*4]
+    vmovups zmm5{k1}{z}, [r11 + rax*4]
+    vfmadd231ps zmm0, zmm4, zmm5
+
+.reduce:
+    REDUCE_ZMM0_3
+    vzeroupper
+    ret
+
+; ============================================
+; Function: vector_norm_avx512
+; Parameters: PARAM1 = float* vector, PARAM2 = int dimension
+; Returns: XMM0 = L2 norm
+; ============================================
+vector_norm_avx512:
+    mov r10, PARAM1           ; vector
+    movsxd r9, PARAM2D        ; dimension (read before rdx is reused)
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -64
+.loop64:
+    cmp rax, rcx
+    jge .tail16
+    vmovups zmm4, [r10 + rax*4]
+    vfmadd231ps zmm0, zmm4, zmm4
+    vmovups zmm4, [r10 + rax*4 + 64]
+    vfmadd231ps zmm1, zmm4, zmm4
+    vmovups zmm4, [r10 + rax*4 + 128]
+    vfmadd231ps zmm2, zmm4, zmm4
+    vmovups zmm4, [r10 + rax*4 + 192]
+    vfmadd231ps zmm3, zmm4, zmm4
+    add rax, 64
+    jmp .loop64
+
+.tail16:
+    mov rcx, r9
+    and rcx, -16
+.loop16:
+    cmp rax, rcx
+    jge .masked
+    vmovups zmm4, [r10 + rax*4]
+    vfmadd231ps zmm0, zmm4, zmm4
+    add rax, 16
+    jmp .loop16
+
+.masked:
+    mov rcx, r9
+    sub rcx, rax
+    jz .reduce
+    TAIL_MASK_K1
+    vmovups zmm4{k1}{z}, [r10 + rax*4]
+    vfmadd231ps zmm0, zmm4, zmm4
+
+.reduce:
+    REDUCE_ZMM0_3
+    vsqrtss xmm0, xmm0, xmm0
+    vzeroupper
+    ret
+
+; ============================================
+; Function: cosine_similarity_avx512
+; Parameters: PARAM1 = float* a, PARAM2 = float* b, PARAM3 = int dimension
+; Returns: XMM0 = dot(a, b) / (||a|| * ||b||), 0 if either norm is 0
+; Single pass like cosine_similarity_avx2; loads go to zmm16/zmm17, which
+; are volatile in both ABIs.
+; ============================================
+cosine_similarity_avx512:
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    movsxd r9, PARAM3D        ; dimension
+    vxorps xmm0, xmm0, xmm0   ; a*b
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2   ; a*a
+    vxorps xmm3, xmm3, xmm3
+    vxorps xmm4, xmm4, xmm4   ; b*b
+    vxorps xmm5, xmm5, xmm5
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -32
+.loop32:
+    cmp rax, rcx
+    jge .tail16
+    vmovups zmm16, [r10 + rax*4]
+    vmovups zmm17, [r11 + rax*4]
+    vfmadd231ps zmm0, zmm16, zmm17
+    vfmadd231ps zmm2, zmm16, zmm16
+    vfmadd231ps zmm4, zmm17, zmm17
+    vmovups zmm16, [r10 + rax*4 + 64]
+    vmovups zmm17, [r11 + rax*4 + 64]
+    vfmadd231ps zmm1, zmm16, zmm17
+    vfmadd231ps zmm3, zmm16, zmm16
+    vfmadd231ps zmm5, zmm17, zmm17
+    add rax, 32
+    jmp .loop32
+
+.tail16:
+    vaddps zmm0, zmm0, zmm1
+    vaddps zmm2, zmm2, zmm3
+    vaddps zmm4, zmm4, zmm5
+    mov rcx, r9
+    sub rcx, rax              ; Remaining elements (0-31)
+    cmp rcx, 16
+    jl .masked
+    vmovups zmm16, [r10 + rax*4]
+    vmovups zmm17, [r11 + rax*4]
+    vfmadd231ps zmm0, zmm16, zmm17
+    vfmadd231ps zmm2, zmm16, zmm16
+    vfmadd231ps zmm4, zmm17, zmm17
+    add rax, 16
+    sub rcx, 16
+
+.masked:
+    test rcx, rcx
+    jz .reduce
+    TAIL_MASK_K1
+    vmovups zmm16{k1}{z}, [r10 + rax*4]
+    vmovups zmm17{k1}{z}, [r11 + rax*4]
+    vfmadd231ps zmm0, zmm16, zmm17
+    vfmadd231ps zmm2, zmm16, zmm16
+    vfmadd231ps zmm4, zmm17, zmm17
+
+.reduce:
+    vextractf64x4 ymm1, zmm0, 1
+    vaddps ymm0, ymm0, ymm1
+    vextractf64x4 ymm3, zmm2, 1
+    vaddps ymm2, ymm2, ymm3
+    vextractf64x4 ymm5, zmm4, 1
+    vaddps ymm4, ymm4, ymm5
+    COSINE_FINISH_YMM
+    vxorps xmm2, xmm2, xmm2
+    vcomiss xmm1, xmm2
+    je .return_zero
+    vdivss xmm0, xmm0, xmm1
+    jmp .done
+
+.return_zero:
+    vxorps xmm0, xmm0, xmm0
+
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: normalize_vector_avx512
+; Parameters: PARAM1 = float* vector (in-place), PARAM2 = int dimension
+; ============================================
+normalize_vector_avx512:
+    push rbp
+    mov rbp, rsp
+    push r12
+    push r13
+    sub rsp, SHADOW_SPACE
+
+    mov r12, PARAM1           ; vector
+    movsxd r13, PARAM2D       ; dimension
+    call vector_norm_avx512
+
+    vxorps xmm1, xmm1, xmm1
+    vcomiss xmm0, xmm1
+    je .done
+
+    vmovss xmm1, [rel float_one]
+    vdivss xmm1, xmm1, xmm0
+    vbroadcastss zmm4, xmm1   ; zmm4 = 1 / norm
+
+    xor rax, rax
+    mov rcx, r13
+    and rcx, -64
+.loop64:
+    cmp rax, rcx
+    jge .tail16
+    vmulps zmm0, zmm4, [r12 + rax*4]
+    vmulps zmm1, zmm4, [r12 + rax*4 + 64]
+    vmulps zmm2, zmm4, [r12 + rax*4 + 128]
+    vmulps zmm3, zmm4, [r12 + rax*4 + 192]
+    vmovups [r12 + rax*4], zmm0
+    vmovups [r12 + rax*4 + 64], zmm1
+    vmovups [r12 + rax*4 + 128], zmm2
+    vmovups [r12 + rax*4 + 192], zmm3
+    add rax, 64
+    jmp .loop64
+
+.tail16:
+    mov rcx, r13
+    and rcx, -16
+.loop16:
+    cmp rax, rcx
+    jge .masked
+    vmulps zmm0, zmm4, [r12 + rax*4]
+    vmovups [r12 + rax*4], zmm0
+    add rax, 16
+    jmp .loop16
+
+.masked:
+    mov rcx, r13
+    sub rcx, rax
+    jz .done
+    TAIL_MASK_K1
+    vmovups zmm0{k1}{z}, [r12 + rax*4]
+    vmulps zmm0, zmm0, zmm4
+    vmovups [r12 + rax*4]{k1}, zmm0
+
+.done:
+    vzeroupper
+    add rsp, SHADOW_SPACE
+    pop r13
+    pop r12
+    pop rbp
+    ret
+
+; ============================================
+; Function: add_vectors_avx512
+; Parameters: PARAM1 = float* a, PARAM2 = float* b, PARAM3 = float* result,
+;             PARAM4 = int dimension
+; ============================================
+add_vectors_avx512:
+    movsxd r9, PARAM4D        ; dimension (read first: PARAM4 may be rcx)
+    mov r8, PARAM3            ; result
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -64
+.loop64:
+    cmp rax, rcx
+    jge .tail16
+    vmovups zmm0, [r10 + rax*4]
+    vmovups zmm1, [r10 + rax*4 + 64]
+    vmovups zmm2, [r10 + rax*4 + 128]
+    vmovups zmm3, [r10 + rax*4 + 192]
+    vaddps zmm0, zmm0, [r11 + rax*4]
+    vaddps zmm1, zmm1, [r11 + rax*4 + 64]
+    vaddps zmm2, zmm2, [r11 + rax*4 + 128]
+    vaddps zmm3, zmm3, [r11 + rax*4 + 192]
+    vmovups [r8 + rax*4], zmm0
+    vmovups [r8 + rax*4 + 64], zmm1
+    vmovups [r8 + rax*4 + 128], zmm2
+    vmovups [r8 + rax*4 + 192], zmm3
+    add rax, 64
+    jmp .loop64
+
+.tail16:
+    mov rcx, r9
+    and rcx, -16
+.loop16:
+    cmp rax, rcx
+    jge .masked
+    vmovups zmm0, [r10 + rax*4]
+    vaddps zmm0, zmm0, [r11 + rax*4]
+    vmovups [r8 + rax*4], zmm0
+    add rax, 16
+    jmp .loop16
+
+.masked:
+    mov rcx, r9
+    sub rcx, rax
+    jz .done
+    TAIL_MASK_K1
+    vmovups zmm0{k1}{z}, [r10 + rax*4]
+    vmovups zmm1{k1}{z}, [r11 + rax*4]
+    vaddps zmm0, zmm0, zmm1
+    vmovups [r8 + rax*4]{k1}, zmm0
+
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: dot_product_x4_avx512
+; Parameters: PARAM1 = float* vector, PARAM2 = float* rows (4 x dimension),
+;             PARAM3 = int dimension, PARAM4 = float* out (4 floats)
+; Two 16-float blocks per iteration into eight accumulators (zmm0-3 and
+; the volatile zmm16-19) to hide FMA latency; masked tail.
+; ============================================
+dot_product_x4_avx512:
+    movsxd rax, PARAM3D       ; dimension (read first: PARAM4 may be r9)
+    mov r8, PARAM4            ; out
+    mov r9, rax               ; r9 = elements left
+    mov r10, PARAM1           ; vector pointer (advances)
+    mov r11, PARAM2           ; row 0 pointer (advances)
+    lea rdx, [rax*4]          ; rdx = row stride in bytes
+    lea rcx, [rdx + rdx*2]    ; rcx = 3 * stride
+
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    vpxord zmm16, zmm16, zmm16
+    vpxord zmm17, zmm17, zmm17
+    vpxord zmm18, zmm18, zmm18
+    vpxord zmm19, zmm19, zmm19
+
+.loop32:
+    cmp r9, 32
+    jl .loop16
+    vmovups zmm4, [r10]
+    vmovups zmm5, [r10 + 64]
+    vfmadd231ps zmm0, zmm4, [r11]
+    vfmadd231ps zmm16, zmm5, [r11 + 64]
+    vfmadd231ps zmm1, zmm4, [r11 + rdx]
+    vfmadd231ps zmm17, zmm5, [r11 + rdx + 64]
+    vfmadd231ps zmm2, zmm4, [r11 + rdx*2]
+    vfmadd231ps zmm18, zmm5, [r11 + rdx*2 + 64]
+    vfmadd231ps zmm3, zmm4, [r11 + rcx]
+    vfmadd231ps zmm19, zmm5, [r11 + rcx + 64]
+    add r10, 128
+    add r11, 128
+    sub r9, 32
+    jmp .loop32
+
+.loop16:
+    cmp r9, 16
+    jl .masked
+    vmovups zmm4, [r10]
+    vfmadd231ps zmm0, zmm4, [r11]
+    vfmadd231ps zmm1, zmm4, [r11 + rdx]
+    vfmadd231ps zmm2, zmm4, [r11 + rdx*2]
+    vfmadd231ps zmm3, zmm4, [r11 + rcx]
+    add r10, 64
+    add r11, 64
+    sub r9, 16
+
+.masked:
+    test r9, r9
+    jz .reduce
+    mov rax, rcx              ; TAIL_MASK_K1 uses ecx/edx
+    mov rcx, r9
+    mov r9, rdx
+    TAIL_MASK_K1
+    vmovups zmm4{k1}{z}, [r10]
+    vmovups zmm5{k1}{z}, [r11]
+    vfmadd231ps zmm0, zmm4, zmm5
+    vmovups zmm5{k1}{z}, [r11 + r9]
+    vfmadd231ps zmm1, zmm4, zmm5
+    vmovups zmm5{k1}{z}, [r11 + r9*2]
+    vfmadd231ps zmm2, zmm4, zmm5
+    vmovups zmm5{k1}{z}, [r11 + rax]
+    vfmadd231ps zmm3, zmm4, zmm5
+
+.reduce:
+    vaddps zmm0, zmm0, zmm16
+    vaddps zmm1, zmm1, zmm17
+    vaddps zmm2, zmm2, zmm18
+    vaddps zmm3, zmm3, zmm19
+    vextractf64x4 ymm4, zmm0, 1
+    vaddps ymm0, ymm0, ymm4
+    vextractf64x4 ymm4, zmm1, 1
+    vaddps ymm1, ymm1, ymm4
+    vextractf64x4 ymm4, zmm2, 1
+    vaddps ymm2, ymm2, ymm4
+    vextractf64x4 ymm4, zmm3, 1
+    vaddps ymm3, ymm3, ymm4
+    vhaddps ymm0, ymm0, ymm1
+    vhaddps ymm2, ymm2, ymm3
+    vhaddps ymm0, ymm0, ymm2
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1
+    vmovups [r8], xmm0
+    vzeroupper
+    ret
+
+; ============================================
+; Dimension-specialized kernels
+; Every supported embedding dimension is a multiple of 128 floats, so these
+; variants process whole 128-float blocks with no tail: the _d128 and _d256
+; kernels are fully unrolled, the _blocks kernel loops over dimension / 128
+; blocks (larger dimensions). Each kernel is generated by FIXED_KERNEL from
+; the <KIND>_START, <KIND>_BLOCK and <KIND>_FINISH macros below and keeps
+; the register use of the generic kernel at the same level. Loads stay
+; unaligned: on aligned rows (fastembed_alloc_matrix) they cost the same as
+; aligned loads, and callers need not guarantee alignment.
+; ============================================
+
+; Emit kernel %1 of kind %2 for %3 unrolled 128-float blocks, or for
+; %4 / 128 blocks in a loop when %3 is 0 (%4 = dimension parameter, a
+; positive multiple of 128). Blocks read [r10] and [r11] from the byte
+; offset given to %2_BLOCK; kinds with a single input ignore r11.
+%macro FIXED_KERNEL 4
+%1:
+    %{2}_START
+%if %3 == 0
+    mov eax, %4
+    shr eax, 7                ; 128-float blocks
+.blocks:
+    %{2}_BLOCK 0
+    add r10, 512
+    add r11, 512
+    dec eax
+    jnz .blocks
+%else
+%assign fixed_block 0
+%rep %3
+    %{2}_BLOCK fixed_block * 512
+%assign fixed_block fixed_block + 1
+%endrep
+%endif
+    %{2}_FINISH
+%endmacro
+
+; --- SSE: four 4-wide accumulators (xmm0-xmm3), loads in xmm4/xmm5 ---
+
+%macro DOT_SSE_START 0
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    xorps xmm0, xmm0
+    xorps xmm1, xmm1
+    xorps xmm2, xmm2
+    xorps xmm3, xmm3
+%endmacro
+
+%macro DOT_SSE_BLOCK 1
+%assign fixed_off %1
+%rep 8
+    movups xmm4, [r10 + fixed_off]
+    movups xmm5, [r11 + fixed_off]
+    mulps xmm4, xmm5
+    addps xmm0, xmm4
+    movups xmm4, [r10 + fixed_off + 16]
+    movups xmm5, [r11 + fixed_off + 16]
+    mulps xmm4, xmm5
+    addps xmm1, xmm4
+    movups xmm4, [r10 + fixed_off + 32]
+    movups xmm5, [r11 + fixed_off + 32]
+    mulps xmm4, xmm5
+    addps xmm2, xmm4
+    movups xmm4, [r10 + fixed_off + 48]
+    movups xmm5, [r11 + fixed_off + 48]
+    mulps xmm4, xmm5
+    addps xmm3, xmm4
+%assign fixed_off fixed_off + 64
+%endrep
+%endmacro
+
+; Sum xmm0-xmm3 into xmm0[0] (uses xmm1)
+%macro REDUCE_XMM0_3 0
+    addps xmm0, xmm1
+    addps xmm2, xmm3
+    addps xmm0, xmm2
+    movhlps xmm1, xmm0
+    addps xmm0, xmm1
+    movaps xmm1, xmm0
+    shufps xmm1, xmm1, 0x55
+    addss xmm0, xmm1
+%endmacro
+
+%macro DOT_SSE_FINISH 0
+    REDUCE_XMM0_3
+    ret
+%endmacro
+
+%macro NORM_SSE_START 0
+    mov r10, PARAM1           ; vector
+    xorps xmm0, xmm0
+    xorps xmm1, xmm1
+    xorps xmm2, xmm2
+    xorps xmm3, xmm3
+%endmacro
+
+%macro NORM_SSE_BLOCK 1
+%assign fixed_off %1
+%rep 8
+    movups xmm4, [r10 + fixed_off]
+    mulps xmm4, xmm4
+    addps xmm0, xmm4
+    movups xmm4, [r10 + fixed_off + 16]
+    mulps xmm4, xmm4
+    addps xmm1, xmm4
+    movups xmm4, [r10 + fixed_off + 32]
+    mulps xmm4, xmm4
+    addps xmm2, xmm4
+    movups xmm4, [r10 + fixed_off + 48]
+    mulps xmm4, xmm4
+    addps xmm3, xmm4
+%assign fixed_off fixed_off + 64
+%endrep
+%endmacro
+
+%macro NORM_SSE_FINISH 0
+    REDUCE_XMM0_3
+    sqrtss xmm0, xmm0
+    ret
+%endmacro
+
+; Cosine: one accumulator each for a*b (xmm0), a*a (xmm1) and b*b (xmm2),
+; as in cosine_similarity_sse
+%macro COSINE_SSE_START 0
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    xorps xmm0, xmm0
+    xorps xmm1, xmm1
+    xorps xmm2, xmm2
+%endmacro
+
+%macro COSINE_SSE_BLOCK 1
+%assign fixed_off %1
+%rep 32
+    movups xmm3, [r10 + fixed_off]
+    movups xmm4, [r11 + fixed_off]
+    movaps xmm5, xmm3
+    mulps xmm5, xmm4
+    addps xmm0, xmm5
+    mulps xmm3, xmm3
+    addps xmm1, xmm3
+    mulps xmm4, xmm4
+    addps xmm2, xmm4
+%assign fixed_off fixed_off + 16
+%endrep
+%endmacro
+
+%macro COSINE_SSE_FINISH 0
+    movaps xmm3, xmm0
+    unpcklps xmm0, xmm1          ; [ab0, aa0, ab1, aa1]
+    unpckhps xmm3, xmm1          ; [ab2, aa2, ab3, aa3]
+    addps xmm0, xmm3
+    movhlps xmm3, xmm0
+    addps xmm0, xmm3             ; xmm0[0] = ab, xmm0[1] = aa
+    movhlps xmm3, xmm2
+    addps xmm2, xmm3
+    movaps xmm3, xmm2
+    shufps xmm3, xmm3, 0x55
+    addss xmm2, xmm3             ; xmm2[0] = bb
+    movaps xmm1, xmm0
+    shufps xmm1, xmm1, 0x55
+    sqrtss xmm1, xmm1            ; ||a||
+    sqrtss xmm2, xmm2            ; ||b||
+    mulss xmm1, xmm2
+    xorps xmm2, xmm2
+    comiss xmm1, xmm2
+    je .return_zero
+    divss xmm0, xmm1
+    ret
+.return_zero:
+    xorps xmm0, xmm0
+    ret
+%endmacro
+
+; --- AVX2: four 8-wide FMA accumulators (ymm0-ymm3), loads in ymm4 ---
+
+%macro DOT_AVX2_START 0
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+%endmacro
+
+%macro DOT_AVX2_BLOCK 1
+%assign fixed_off %1
+%rep 4
+    vmovups ymm4, [r10 + fixed_off]
+    vfmadd231ps ymm0, ymm4, [r11 + fixed_off]
+    vmovups ymm4, [r10 + fixed_off + 32]
+    vfmadd231ps ymm1, ymm4, [r11 + fixed_off + 32]
+    vmovups ymm4, [r10 + fixed_off + 64]
+    vfmadd231ps ymm2, ymm4, [r11 + fixed_off + 64]
+    vmovups ymm4, [r10 + fixed_off + 96]
+    vfmadd231ps ymm3, ymm4, [r11 + fixed_off + 96]
+%assign fixed_off fixed_off + 128
+%endrep
+%endmacro
+
+; Sum ymm0-ymm3 into xmm0[0] (uses ymm1, ymm2)
+%macro REDUCE_YMM0_3 0
+    vaddps ymm0, ymm0, ymm1
+    vaddps ymm2, ymm2, ymm3
+    vaddps ymm0, ymm0, ymm2
+    vextractf128 xmm1, ymm0, 1
+    vaddps xmm0, xmm0, xmm1
+    HSUM_XMM0
+%endmacro
+
+%macro DOT_AVX2_FINISH 0
+    REDUCE_YMM0_3
+    vzeroupper
+    ret
+%endmacro
+
+%macro NORM_AVX2_START 0
+    mov r10, PARAM1           ; vector
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+%endmacro
+
+%macro NORM_AVX2_BLOCK 1
+%assign fixed_off %1
+%rep 4
+    vmovups ymm4, [r10 + fixed_off]
+    vfmadd231ps ymm0, ymm4, ymm4
+    vmovups ymm4, [r10 + fixed_off + 32]
+    vfmadd231ps ymm1, ymm4, ymm4
+    vmovups ymm4, [r10 + fixed_off + 64]
+    vfmadd231ps ymm2, ymm4, ymm4
+    vmovups ymm4, [r10 + fixed_off + 96]
+    vfmadd231ps ymm3, ymm4, ymm4
+%assign fixed_off fixed_off + 128
+%endrep
+%endmacro
+
+%macro NORM_AVX2_FINISH 0
+    REDUCE_YMM0_3
+    vsqrtss xmm0, xmm0, xmm0
+    vzeroupper
+    ret
+%endmacro
+
+; Cosine: two accumulators each for a*b (ymm0/1), a*a (ymm2/3) and b*b
+; (ymm4/5), loads in ymm6/ymm7 (saved on Windows), as in
+; cosine_similarity_avx2
+%macro COSINE_AVX2_START 0
+%ifidn __OUTPUT_FORMAT__,win64
+    sub rsp, 40               ; xmm6/xmm7 are callee-saved on Windows
+    vmovups [rsp], xmm6
+    vmovups [rsp + 16], xmm7
+%endif
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    vxorps xmm4, xmm4, xmm4
+    vxorps xmm5, xmm5, xmm5
+%endmacro
+
+%macro COSINE_AVX2_BLOCK 1
+%assign fixed_off %1
+%rep 8
+    vmovups ymm6, [r10 + fixed_off]
+    vmovups ymm7, [r11 + fixed_off]
+    vfmadd231ps ymm0, ymm6, ymm7
+    vfmadd231ps ymm2, ymm6, ymm6
+    vfmadd231ps ymm4, ymm7, ymm7
+    vmovups ymm6, [r10 + fixed_off + 32]
+    vmovups ymm7, [r11 + fixed_off + 32]
+    vfmadd231ps ymm1, ymm6, ymm7
+    vfmadd231ps ymm3, ymm6, ymm6
+    vfmadd231ps ymm5, ymm7, ymm7
+%assign fixed_off fixed_off + 64
+%endrep
+%endmacro
+
+%macro COSINE_AVX2_FINISH 0
+    vaddps ymm0, ymm0, ymm1
+    vaddps ymm2, ymm2, ymm3
+    vaddps ymm4, ymm4, ymm5
+    COSINE_FINISH_YMM
+    vxorps xmm2, xmm2, xmm2
+    vcomiss xmm1, xmm2
+    je .return_zero
+    vdivss xmm0, xmm0, xmm1
+    jmp .done
+.return_zero:
+    vxorps xmm0, xmm0, xmm0
+.done:
+    vzeroupper
+%ifidn __OUTPUT_FORMAT__,win64
+    vmovups xmm6, [rsp]
+    vmovups xmm7, [rsp + 16]
+    add rsp, 40
+%endif
+    ret
+%endmacro
+
+; --- AVX-512F: four 16-wide FMA accumulators (zmm0-zmm3), loads in zmm4 ---
+
+%macro DOT_AVX512_START 0
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+%endmacro
+
+%macro DOT_AVX512_BLOCK 1
+%assign fixed_off %1
+%rep 2
+    vmovups zmm4, [r10 + fixed_off]
+    vfmadd231ps zmm0, zmm4, [r11 + fixed_off]
+    vmovups zmm4, [r10 + fixed_off + 64]
+    vfmadd231ps zmm1, zmm4, [r11 + fixed_off + 64]
+    vmovups zmm4, [r10 + fixed_off + 128]
+    vfmadd231ps zmm2, zmm4, [r11 + fixed_off + 128]
+    vmovups zmm4, [r10 + fixed_off + 192]
+    vfmadd231ps zmm3, zmm4, [r11 + fixed_off + 192]
+%assign fixed_off fixed_off + 256
+%endrep
+%endmacro
+
+%macro DOT_AVX512_FINISH 0
+    REDUCE_ZMM0_3
+    vzeroupper
+    ret
+%endmacro
+
+%macro NORM_AVX512_START 0
+    mov r10, PARAM1           ; vector
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+%endmacro
+
+%macro NORM_AVX512_BLOCK 1
+%assign fixed_off %1
+%rep 2
+    vmovups zmm4, [r10 + fixed_off]
+    vfmadd231ps zmm0, zmm4, zmm4
+    vmovups zmm4, [r10 + fixed_off + 64]
+    vfmadd231ps zmm1, zmm4, zmm4
+    vmovups zmm4, [r10 + fixed_off + 128]
+    vfmadd231ps zmm2, zmm4, zmm4
+    vmovups zmm4, [r10 + fixed_off + 192]
+    vfmadd231ps zmm3, zmm4, zmm4
+%assign fixed_off fixed_off + 256
+%endrep
+%endmacro
+
+%macro NORM_AVX512_FINISH 0
+    REDUCE_ZMM0_3
+    vsqrtss xmm0, xmm0, xmm0
+    vzeroupper
+    ret
+%endmacro
+
+; Cosine: as cosine_similarity_avx512 (zmm0-zmm5, loads in zmm16/zmm17)
+%macro COSINE_AVX512_START 0
+    mov r10, PARAM1           ; vector_a
+    mov r11, PARAM2           ; vector_b
+    vxorps xmm0, xmm0, xmm0
+    vxorps xmm1, xmm1, xmm1
+    vxorps xmm2, xmm2, xmm2
+    vxorps xmm3, xmm3, xmm3
+    vxorps xmm4, xmm4, xmm4
+    vxorps xmm5, xmm5, xmm5
+%endmacro
+
+%macro COSINE_AVX512_BLOCK 1
+%assign fixed_off %1
+%rep 4
+    vmovups zmm16, [r10 + fixed_off]
+    vmovups zmm17, [r11 + fixed_off]
+    vfmadd231ps zmm0, zmm16, zmm17
+    vfmadd231ps zmm2, zmm16, zmm16
+    vfmadd231ps zmm4, zmm17, zmm17
+    vmovups zmm16, [r10 + fixed_off + 64]
+    vmovups zmm17, [r11 + fixed_off + 64]
+    vfmadd231ps zmm1, zmm16, zmm17
+    vfmadd231ps zmm3, zmm16, zmm16
+    vfmadd231ps zmm5, zmm17, zmm17
+%assign fixed_off fixed_off + 128
+%endrep
+%endmacro
+
+%macro COSINE_AVX512_FINISH 0
+    vaddps zmm0, zmm0, zmm1
+    vaddps zmm2, zmm2, zmm3
+    vaddps zmm4, zmm4, zmm5
+    vextractf64x4 ymm1, zmm0, 1
+    vaddps ymm0, ymm0, ymm1
+    vextractf64x4 ymm3, zmm2, 1
+    vaddps ymm2, ymm2, ymm3
+    vextractf64x4 ymm5, zmm4, 1
+    vaddps ymm4, ymm4, ymm5
+    COSINE_FINISH_YMM
+    vxorps xmm2, xmm2, xmm2
+    vcomiss xmm1, xmm2
+    je .return_zero
+    vdivss xmm0, xmm0, xmm1
+    jmp .done
+.return_zero:
+    vxorps xmm0, xmm0, xmm0
+.done:
+    vzeroupper
+    ret
+%endmacro
+
+; Parameters and results as the generic kernels of the same name
+FIXED_KERNEL dot_product_sse_d128, DOT_SSE, 1, PARAM3D
+FIXED_KERNEL dot_product_sse_d256, DOT_SSE, 2, PARAM3D
+FIXED_KERNEL dot_product_sse_blocks, DOT_SSE, 0, PARAM3D
+FIXED_KERNEL vector_norm_sse_d128, NORM_SSE, 1, PARAM2D
+FIXED_KERNEL vector_norm_sse_d256, NORM_SSE, 2, PARAM2D
+FIXED_KERNEL vector_norm_sse_blocks, NORM_SSE, 0, PARAM2D
+FIXED_KERNEL cosine_similarity_sse_d128, COSINE_SSE, 1, PARAM3D
+FIXED_KERNEL cosine_similarity_sse_d256, COSINE_SSE, 2, PARAM3D
+FIXED_KERNEL cosine_similarity_sse_blocks, COSINE_SSE, 0, PARAM3D
+
+FIXED_KERNEL dot_product_avx2_d128, DOT_AVX2, 1, PARAM3D
+FIXED_KERNEL dot_product_avx2_d256, DOT_AVX2, 2, PARAM3D
+FIXED_KERNEL dot_product_avx2_blocks, DOT_AVX2, 0, PARAM3D
+FIXED_KERNEL vector_norm_avx2_d128, NORM_AVX2, 1, PARAM2D
+FIXED_KERNEL vector_norm_avx2_d256, NORM_AVX2, 2, PARAM2D
+FIXED_KERNEL vector_norm_avx2_blocks, NORM_AVX2, 0, PARAM2D
+FIXED_KERNEL cosine_similarity_avx2_d128, COSINE_AVX2, 1, PARAM3D
+FIXED_KERNEL cosine_similarity_avx2_d256, COSINE_AVX2, 2, PARAM3D
+FIXED_KERNEL cosine_similarity_avx2_blocks, COSINE_AVX2, 0, PARAM3D
+
+FIXED_KERNEL dot_product_avx512_d128, DOT_AVX512, 1, PARAM3D
+FIXED_KERNEL dot_product_avx512_d256, DOT_AVX512, 2, PARAM3D
+FIXED_KERNEL dot_product_avx512_blocks, DOT_AVX512, 0, PARAM3D
+FIXED_KERNEL vector_norm_avx512_d128, NORM_AVX512, 1, PARAM2D
+FIXED_KERNEL vector_norm_avx512_d256, NORM_AVX512, 2, PARAM2D
+FIXED_KERNEL vector_norm_avx512_blocks, NORM_AVX512, 0, PARAM2D
+FIXED_KERNEL cosine_similarity_avx512_d128, COSINE_AVX512, 1, PARAM3D
+FIXED_KERNEL cosine_similarity_avx512_d256, COSINE_AVX512, 2, PARAM3D
+FIXED_KERNEL cosine_similarity_avx512_blocks, COSINE_AVX512, 0, PARAM3D
+
+; ============================================
+; Quantized kernels
+; int8 dot products return the exact int32 sum of a[i] * b[i]; the
+; pmaddubsw (AVX2) kernel requires b[i] != -128, which holds for
+; fastembed_quantize_int8() output ([-127, 127]).
+; Hamming distances count differing bits of two packed bit vectors.
+; ============================================
+
+; ============================================
+; Function: int8_dot_sse
+; Parameters: PARAM1 = int8_t* a, PARAM2 = int8_t* b, PARAM3 = int n
+; Returns: EAX = dot product (int32)
+; SSE2: bytes are sign-extended to words (unpack + arithmetic shift) and
+; multiplied pairwise into dwords with pmaddwd.
+; ============================================
+int8_dot_sse:
+    mov r10, PARAM1           ; a
+    mov r11, PARAM2           ; b
+    movsxd r9, PARAM3D        ; n
+    pxor xmm0, xmm0           ; Accumulators (4 x int32 each)
+    pxor xmm1, xmm1
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -16              ; Bytes handled 16 at a time
+.loop16:
+    cmp rax, rcx
+    jge .reduce
+    movdqu xmm2, [r10 + rax]
+    movdqu xmm3, [r11 + rax]
+    movdqa xmm4, xmm2
+    punpcklbw xmm4, xmm4      ; Each word = byte:byte
+    psraw xmm4, 8             ; -> sign-extended bytes 0-7
+    punpckhbw xmm2, xmm2
+    psraw xmm2, 8             ; -> sign-extended bytes 8-15
+    movdqa xmm5, xmm3
+    punpcklbw xmm5, xmm5
+    psraw xmm5, 8
+    punpckhbw xmm3, xmm3
+    psraw xmm3, 8
+    pmaddwd xmm4, xmm5
+    pmaddwd xmm2, xmm3
+    paddd xmm0, xmm4
+    paddd xmm1, xmm2
+    add rax, 16
+    jmp .loop16
+
+.reduce:
+    paddd xmm0, xmm1
+    pshufd xmm1, xmm0, 0x4E
+    paddd xmm0, xmm1
+    pshufd xmm1, xmm0, 0xB1
+    paddd xmm0, xmm1
+    movd edx, xmm0
+
+.tail1:
+    cmp rax, r9
+    jge .done
+    movsx r8d, byte [r10 + rax]
+    movsx ecx, byte [r11 + rax]
+    imul r8d, ecx
+    add edx, r8d
+    inc rax
+    jmp .tail1
+
+.done:
+    mov eax, edx
+    ret
+
+; ============================================
+; Function: int8_dot_avx2
+; Parameters: PARAM1 = int8_t* a, PARAM2 = int8_t* b, PARAM3 = int n
+; Returns: EAX = dot product (int32)
+; vpmaddubsw multiplies unsigned by signed bytes, so |a| is paired with
+; b carrying the sign of a (vpsignb); pair sums stay below 2^15 for
+; b in [-127, 127]. vpmaddwd with ones widens them to dwords.
+; ============================================
+int8_dot_avx2:
+    mov r10, PARAM1           ; a
+    mov r11, PARAM2           ; b
+    movsxd r9, PARAM3D        ; n
+    vpxor xmm0, xmm0, xmm0    ; Accumulators (8 x int32 each)
+    vpxor xmm1, xmm1, xmm1
+    vpcmpeqw ymm5, ymm5, ymm5
+    vpsrlw ymm5, ymm5, 15     ; ymm5 = 16 x int16 1
+    xor rax, rax
+
+    mov rcx, r9
+    and rcx, -64              ; Bytes handled 64 at a time
+.loop64:
+    cmp rax, rcx
+    jge .tail32
+    vmovdqu ymm2, [r10 + rax]
+    vmovdqu ymm3, [r11 + rax]
+    vpsignb ymm3, ymm3, ymm2  ; b * sign(a)
+    vpabsb ymm2, ymm2         ; |a|
+    vpmaddubsw ymm2, ymm2, ymm3
+    vpmaddwd ymm2, ymm2, ymm5
+    vpaddd ymm0, ymm0, ymm2
+    vmovdqu ymm4, [r10 + rax + 32]
+    vmovdqu ymm3, [r11 + rax + 32]
+    vpsignb ymm3, ymm3, ymm4
+    vpabsb ymm4, ymm4
+    vpmaddubsw ymm4, ymm4, ymm3
+    vpmaddwd ymm4, ymm4, ymm5
+    vpaddd ymm1, ymm1, ymm4
+    add rax, 64
+    jmp .loop64
+
+.tail32:
+    lea rcx, [rax + 32]
+    cmp rcx, r9
+    jg .reduce
+    vmovdqu ymm2, [r10 + rax]
+    vmovdqu ymm3, [r11 + rax]
+    vpsignb ymm3, ymm3, ymm2
+    vpabsb ymm2, ymm2
+    vpmaddubsw ymm2, ymm2, ymm3
+    vpmaddwd ymm2, ymm2, ymm5
+    vpaddd ymm0, ymm0, ymm2
+    add rax, 32
+
+.reduce:
+    vpaddd ymm0, ymm0, ymm1
+    vextracti128 xmm1, ymm0, 1
+    vpaddd xmm0, xmm0, xmm1
+    vpshufd xmm1, xmm0, 0x4E
+    vpaddd xmm0, xmm0, xmm1
+    vpshufd xmm1, xmm0, 0xB1
+    vpaddd xmm0, xmm0, xmm1
+    vmovd edx, xmm0
+    vzeroupper
+
+.tail1:
+    cmp rax, r9
+    jge .done
+    movsx r8d, byte [r10 + rax]
+    movsx ecx, byte [r11 + rax]
+    imul r8d, ecx
+    add edx, r8d
+    inc rax
+    jmp .tail1
+
+.done:
+    mov eax, edx
+    ret
+
+; ============================================
+; Function: int8_dot_vnni
+; Parameters: PARAM1 = int8_t* a, PARAM2 = int8_t* b, PARAM3 = int n
+; Returns: EAX = dot product (int32)
+; AVX512-VNNI vpdpbusd takes unsigned x signed bytes: a is biased to
+; a + 128 (xor 0x80) and 128 * sum(b) is accumulated separately and
+; subtracted, which is exact for every input. Masked tail (AVX512BW).
+; ============================================
+int8_dot_vnni:
+    mov r10, PARAM1           ; a (advances)
+    mov r11, PARAM2           ; b (advances)
+    movsxd r9, PARAM3D        ; bytes left
+    vpxord zmm0, zmm0, zmm0   ; sum((a + 128) * b)
+    vpxord zmm1, zmm1, zmm1   ; sum(128 * b)
+    mov eax, 0x80808080
+    vpbroadcastd zmm5, eax    ; zmm5 = 64 x 0x80
+
+.loop64:
+    cmp r9, 64
+    jl .masked
+    vpxord zmm2, zmm5, [r10]
+    vmovdqu32 zmm3, [r11]
+    vpdpbusd zmm0, zmm2, zmm3
+    vpdpbusd zmm1, zmm5, zmm3
+    add r10, 64
+    add r11, 64
+    sub r9, 64
+    jmp .loop64
+
+.masked:
+    test r9, r9
+    jz .reduce
+    mov rcx, r9
+    mov rax, 1
+    shl rax, cl
+    dec rax                   ; rax = (1 << left) - 1
+    kmovq k1, rax
+    vmovdqu8 zmm2{k1}{z}, [r10]
+    vmovdqu8 zmm3{k1}{z}, [r11] ; b = 0 in unused lanes
+    vpxord zmm2, zmm2, zmm5
+    vpdpbusd zmm0, zmm2, zmm3
+    vpdpbusd zmm1, zmm5, zmm3
+
+.reduce:
+    vpsubd zmm0, zmm0, zmm1
+    vextracti64x4 ymm1, zmm0, 1
+    vpaddd ymm0, ymm0, ymm1
+    vextracti128 xmm1, ymm0, 1
+    vpaddd xmm0, xmm0, xmm1
+    vpshufd xmm1, xmm0, 0x4E
+    vpaddd xmm0, xmm0, xmm1
+    vpshufd xmm1, xmm0, 0xB1
+    vpaddd xmm0, xmm0, xmm1
+    vmovd eax, xmm0
+    vzeroupper
+    ret
+
+; Population count of a 64-bit register without POPCNT
+; %1 = value (replaced by its bit count), %2 = scratch
+%macro POPCNT_SWAR 2
+    mov %2, %1
+    shr %2, 1
+    and %2, [rel popcnt_m1]
+    sub %1, %2                ; 2-bit counts
+    mov %2, %1
+    shr %2, 2
+    and %1, [rel popcnt_m2]
+    and %2, [rel popcnt_m2]
+    add %1, %2                ; 4-bit counts
+    mov %2, %1
+    shr %2, 4
+    add %1, %2
+    and %1, [rel popcnt_m4]   ; Byte counts
+    imul %1, [rel popcnt_h01]
+    shr %1, 56                ; Sum of bytes
+%endmacro
+
+; ============================================
+; Function: hamming_swar
+; Parameters: PARAM1 = uint8_t* a, PARAM2 = uint8_t* b, PARAM3 = int bytes
+; Returns: EAX = number of differing bits
+; Baseline kernel (POPCNT is not part of the x86-64 baseline).
+; ============================================
+hamming_swar:
+    mov r10, PARAM1           ; a
+    mov r11, PARAM2           ; b
+    movsxd r9, PARAM3D        ; bytes
+    xor eax, eax              ; Bit count
+    xor edx, edx              ; Byte index
+
+.loop8:
+    lea rcx, [rdx + 8]
+    cmp rcx, r9
+    jg .tail1
+    mov rcx, [r10 + rdx]
+    xor rcx, [r11 + rdx]
+    POPCNT_SWAR rcx, r8
+    add rax, rcx
+    add rdx, 8
+    jmp .loop8
+
+.tail1:
+    cmp rdx, r9
+    jge .done
+    movzx ecx, byte [r10 + rdx]
+    movzx r8d, byte [r11 + rdx]
+    xor ecx, r8d
+    POPCNT_SWAR rcx, r8
+    add rax, rcx
+    inc rdx
+    jmp .tail1
+
+.done:
+    ret
+
+; ============================================
+; Function: hamming_popcnt
+; Parameters: PARAM1 = uint8_t* a, PARAM2 = uint8_t* b, PARAM3 = int bytes
+; Returns: EAX = number of differing bits
+; POPCNT over 64-bit words, 32 bytes per iteration (every AVX2 CPU has
+; POPCNT).
+; ============================================
+hamming_popcnt:
+    mov r10, PARAM1           ; a
+    mov r11, PARAM2           ; b
+    movsxd r9, PARAM3D        ; bytes
+    xor eax, eax              ; Bit count
+    xor edx, edx              ; Byte index
+
+.loop32:
+    lea rcx, [rdx + 32]
+    cmp rcx, r9
+    jg .loop8
+    mov rcx, [r10 + rdx]
+    xor rcx, [r11 + rdx]
+    popcnt rcx, rcx
+    mov r8, [r10 + rdx + 8]
+    xor r8, [r11 + rdx + 8]
+    popcnt r8, r8
+    add rax, rcx
+    add rax, r8
+    mov rcx, [r10 + rdx + 16]
+    xor rcx, [r11 + rdx + 16]
+    popcnt rcx, rcx
+    mov r8, [r10 + rdx + 24]
+    xor r8, [r11 + rdx + 24]
+    popcnt r8, r8
+    add rax, rcx
+    add rax, r8
+    add rdx, 32
+    jmp .loop32
+
+.loop8:
+    lea rcx, [rdx + 8]
+    cmp rcx, r9
+    jg .tail1
+    mov rcx, [r10 + rdx]
+    xor rcx, [r11 + rdx]
+    popcnt rcx, rcx
+    add rax, rcx
+    add rdx, 8
+    jmp .loop8
+
+.tail1:
+    cmp rdx, r9
+    jge .done
+    movzx ecx, byte [r10 + rdx]
+    movzx r8d, byte [r11 + rdx]
+    xor ecx, r8d
+    popcnt ecx, ecx
+    add rax, rcx
+    inc rdx
+    jmp .tail1
+
+.done:
+    ret
+
+; ============================================
+; Function: hamming_avx512
+; Parameters: PARAM1 = uint8_t* a, PARAM2 = uint8_t* b, PARAM3 = int bytes
+; Returns: EAX = number of differing bits
+; AVX512-VPOPCNTDQ over 64-byte blocks, POPCNT for the remainder.
+; ============================================
+hamming_avx512:
+    mov r10, PARAM1           ; a
+    mov r11, PARAM2           ; b
+    movsxd r9, PARAM3D        ; bytes
+    vpxorq zmm0, zmm0, zmm0   ; 8 x int64 bit counts
+    xor edx, edx              ; Byte index
+
+.loop64:
+    lea rcx, [rdx + 64]
+    cmp rcx, r9
+    jg .reduce
+    vmovdqu64 zmm1, [r10 + rdx]
+    vpxorq zmm1, zmm1, [r11 + rdx]
+    vpopcntq zmm1, zmm1
+    vpaddq zmm0, zmm0, zmm1
+    add rdx, 64
+    jmp .loop64
+
+.reduce:
+    vextracti64x4 ymm1, zmm0, 1
+    vpaddq ymm0, ymm0, ymm1
+    vextracti128 xmm1, ymm0, 1
+    vpaddq xmm0, xmm0, xmm1
+    vpshufd xmm1, xmm0, 0x4E
+    vpaddq xmm0, xmm0, xmm1
+    vmovq rax, xmm0
+    vzeroupper
+
+.loop8:
+    lea rcx, [rdx + 8]
+    cmp rcx, r9
+    jg .tail1
+    mov rcx, [r10 + rdx]
+    xor rcx, [r11 + rdx]
+    popcnt rcx, rcx
+    add rax, rcx
+    add rdx, 8
+    jmp .loop8
+
+.tail1:
+    cmp rdx, r9
+    jge .done
+    movzx ecx, byte [r10 + rdx]
+    movzx r8d, byte [r11 + rdx]
+    xor ecx, r8d
+    popcnt ecx, ecx
+    add rax, rcx
+    inc rdx
+    jmp .tail1
+
+.done:
+    ret
+
+; ============================================
+; Half-precision conversion kernels
+; Parameters: PARAM1 = source, PARAM2 = destination, PARAM3 = int n
+; Returns: EAX = number of leading elements converted (a multiple of the
+; vector width, 0 if the level has no kernel); the caller converts the
+; remaining elements with the portable C code.
+; ============================================
+half_convert_none:
+    xor eax, eax
+    ret
+
+; ============================================
+; Function: bf16_to_f32_sse
+; bfloat16 is the top half of a float: interleave zero words below it
+; ============================================
+bf16_to_f32_sse:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -8               ; Elements handled 8 at a time
+    pxor xmm2, xmm2
+    xor rax, rax
+.loop8:
+    cmp rax, rcx
+    jge .done
+    movdqu xmm0, [r10 + rax*2]
+    movdqa xmm1, xmm2
+    punpcklwd xmm1, xmm0      ; Elements 0-3 << 16
+    pxor xmm3, xmm3
+    punpckhwd xmm3, xmm0      ; Elements 4-7 << 16
+    movups [r11 + rax*4], xmm1
+    movups [r11 + rax*4 + 16], xmm3
+    add rax, 8
+    jmp .loop8
+.done:
+    ret
+
+; Round 4 floats in %1 to bfloat16 in the low halves of %2 (SSE2)
+; Clobbers xmm4 and xmm5
+%macro BF16_ROUND_SSE 2
+    movdqa %2, %1
+    psrld %2, 16
+    pand %2, [rel bf16_lsb]
+    paddd %2, [rel bf16_round]
+    paddd %2, %1
+    psrld %2, 16              ; Rounded
+    movaps xmm4, %1
+    cmpunordps xmm4, %1       ; NaN lanes
+    movdqa xmm5, %1
+    psrld xmm5, 16
+    por xmm5, [rel bf16_qnan] ; Quieted NaN
+    pand xmm5, xmm4
+    pandn xmm4, %2
+    por xmm4, xmm5
+    pslld xmm4, 16            ; Sign-extend so packssdw keeps all 16 bits
+    psrad xmm4, 16
+    movdqa %2, xmm4
+%endmacro
+
+; ============================================
+; Function: f32_to_bf16_sse
+; ============================================
+f32_to_bf16_sse:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -8               ; Elements handled 8 at a time
+    xor rax, rax
+.loop8:
+    cmp rax, rcx
+    jge .done
+    movups xmm0, [r10 + rax*4]
+    BF16_ROUND_SSE xmm0, xmm2
+    movups xmm0, [r10 + rax*4 + 16]
+    BF16_ROUND_SSE xmm0, xmm3
+    packssdw xmm2, xmm3
+    movdqu [r11 + rax*2], xmm2
+    add rax, 8
+    jmp .loop8
+.done:
+    ret
+
+; ============================================
+; Function: f16_to_f32_f16c
+; F16C vcvtph2ps, 16 elements per iteration
+; ============================================
+f16_to_f32_f16c:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -16
+    xor rax, rax
+.loop16:
+    cmp rax, rcx
+    jge .done
+    vcvtph2ps ymm0, [r10 + rax*2]
+    vcvtph2ps ymm1, [r10 + rax*2 + 16]
+    vmovups [r11 + rax*4], ymm0
+    vmovups [r11 + rax*4 + 32], ymm1
+    add rax, 16
+    jmp .loop16
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: f32_to_f16_f16c
+; F16C vcvtps2ph with round-to-nearest-even (imm8 = 0)
+; ============================================
+f32_to_f16_f16c:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -16
+    xor rax, rax
+.loop16:
+    cmp rax, rcx
+    jge .done
+    vmovups ymm0, [r10 + rax*4]
+    vmovups ymm1, [r10 + rax*4 + 32]
+    vcvtps2ph [r11 + rax*2], ymm0, 0
+    vcvtps2ph [r11 + rax*2 + 16], ymm1, 0
+    add rax, 16
+    jmp .loop16
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: bf16_to_f32_avx2
+; ============================================
+bf16_to_f32_avx2:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -16
+    xor rax, rax
+.loop16:
+    cmp rax, rcx
+    jge .done
+    vpmovzxwd ymm0, [r10 + rax*2]
+    vpmovzxwd ymm1, [r10 + rax*2 + 16]
+    vpslld ymm0, ymm0, 16
+    vpslld ymm1, ymm1, 16
+    vmovups [r11 + rax*4], ymm0
+    vmovups [r11 + rax*4 + 32], ymm1
+    add rax, 16
+    jmp .loop16
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: f32_to_bf16_avx2
+; Same rounding as the SSE kernel, 8 elements per iteration
+; ============================================
+f32_to_bf16_avx2:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -8
+    xor rax, rax
+.loop8:
+    cmp rax, rcx
+    jge .done
+    vmovups ymm0, [r10 + rax*4]
+    vpsrld ymm1, ymm0, 16
+    vpand ymm1, ymm1, [rel bf16_lsb]
+    vpaddd ymm1, ymm1, [rel bf16_round]
+    vpaddd ymm1, ymm1, ymm0
+    vpsrld ymm1, ymm1, 16     ; Rounded
+    vpsrld ymm2, ymm0, 16
+    vpor ymm2, ymm2, [rel bf16_qnan]
+    vcmpunordps ymm3, ymm0, ymm0
+    vblendvps ymm1, ymm1, ymm2, ymm3
+    vextracti128 xmm2, ymm1, 1
+    vpackusdw xmm1, xmm1, xmm2
+    vmovdqu [r11 + rax*2], xmm1
+    add rax, 8
+    jmp .loop8
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: f16_to_f32_avx512
+; ============================================
+f16_to_f32_avx512:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -32
+    xor rax, rax
+.loop32:
+    cmp rax, rcx
+    jge .done
+    vcvtph2ps zmm0, [r10 + rax*2]
+    vcvtph2ps zmm1, [r10 + rax*2 + 32]
+    vmovups [r11 + rax*4], zmm0
+    vmovups [r11 + rax*4 + 64], zmm1
+    add rax, 32
+    jmp .loop32
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: f32_to_f16_avx512
+; ============================================
+f32_to_f16_avx512:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -32
+    xor rax, rax
+.loop32:
+    cmp rax, rcx
+    jge .done
+    vmovups zmm0, [r10 + rax*4]
+    vmovups zmm1, [r10 + rax*4 + 64]
+    vcvtps2ph [r11 + rax*2], zmm0, 0
+    vcvtps2ph [r11 + rax*2 + 32], zmm1, 0
+    add rax, 32
+    jmp .loop32
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: bf16_to_f32_avx512
+; ============================================
+bf16_to_f32_avx512:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -32
+    xor rax, rax
+.loop32:
+    cmp rax, rcx
+    jge .done
+    vpmovzxwd zmm0, [r10 + rax*2]
+    vpmovzxwd zmm1, [r10 + rax*2 + 32]
+    vpslld zmm0, zmm0, 16
+    vpslld zmm1, zmm1, 16
+    vmovups [r11 + rax*4], zmm0
+    vmovups [r11 + rax*4 + 64], zmm1
+    add rax, 32
+    jmp .loop32
+.done:
+    vzeroupper
+    ret
+
+; ============================================
+; Function: f32_to_bf16_avx512
+; Integer rounding (AVX-512F only, so results match the other levels);
+; vpmovdw narrows the 16 dwords to words
+; ============================================
+f32_to_bf16_avx512:
+    mov r10, PARAM1           ; Source
+    mov r11, PARAM2           ; Destination
+    movsxd rcx, PARAM3D
+    and rcx, -16
+    vpbroadcastd zmm3, [rel bf16_lsb]
+    vpbroadcastd zmm4, [rel bf16_round]
+    vpbroadcastd zmm5, [rel bf16_qnan]
+    xor rax, rax
+.loop16:
+    cmp rax, rcx
+    jge .done
+    vmovups zmm0, [r10 + rax*4]
+    vpsrld zmm1, zmm0, 16
+    vpandd zmm1, zmm1, zmm3
+    vpaddd zmm1, zmm1, zmm4
+    vpaddd zmm1, zmm1, zmm0
+    vpsrld zmm1, zmm1, 16     ; Rounded
+    vcmpunordps k1, zmm0, zmm0
+    vpsrld zmm2, zmm0, 16
+    vpord zmm1{k1}, zmm2, zmm5
+    vpmovdw [r11 + rax*2], zmm1
+    add rax, 16
+    jmp .loop16
+.done:
+    vzeroupper
+    ret
@@ -120,72 +120,76 @@ _dot_product_asm:
 // Function: cosine_similarity_asm
 // Calculate cosine similarity between two embedding vectors
 // cosine_similarity = dot(a,b) / (||a|| * ||b||)
+// a·b, a·a and b·b are accumulated in a single pass over both vectors.
 // Parameters:
 //   X0 = float* vector_a
 //   X1 = float* vector_b
 //   X2 = int dimension
 // Returns:
-//   S0 = cosine similarity (float)
+//   S0 = cosine similarity (float), 0 if either vector has zero norm
 // ============================================
     .global _cosine_similarity_asm
 _cosine_similarity_asm:
-    // Prologue
-    stp x29, x30, [sp, #-64]!    // Save frame pointer and link register
-    mov x29, sp
-    stp x19, x20, [sp, #16]      // Save callee-saved registers
-    stp x21, x22, [sp, #32]
-    str d8, [sp, #48]            // Save callee-saved NEON register
-    
-    // Save parameters to callee-saved registers
-    mov x19, x0                  // vector_a
-    mov x20, x1                  // vector_b
-    mov x21, x2                  // dimension
-    
-    // Step 1: Calculate dot product
-    mov x0, x19                  // vector_a
-    mov x1, x20                  // vector_b
-    mov x2, x21                  // dimension
-    bl _dot_product_asm
-    fmov s8, s0                  // Save dot_product in S8 (callee-saved)
-    
-    // Step 2: Calculate ||vector_a|| (L2 norm)
-    mov x0, x19                  // vector_a
-    mov x1, x21                  // dimension
-    bl _vector_norm_asm
-    fmov s9, s0                  // Save norm_a in S9
-    
-    // Step 3: Calculate ||vector_b|| (L2 norm)
-    mov x0, x20                  // vector_b
-    mov x1, x21                  // dimension
-    bl _vector_norm_asm
-    fmov s10, s0                 // Save norm_b in S10
-    
-    // Step 4: Calculate cosine = dot / (norm_a * norm_b)
-    fmov s0, s8                  // S0 = dot_product
-    fmov s1, s9                  // S1 = norm_a
-    fmul s1, s1, s10             // S1 = norm_a * norm_b
-    
+    // Leaf function: only caller-saved registers (v0-v7, x9-x11) are used
+    eor v0.16b, v0.16b, v0.16b   // V0 = sum(a*b)
+    eor v1.16b, v1.16b, v1.16b   // V1 = sum(a*a)
+    eor v2.16b, v2.16b, v2.16b   // V2 = sum(b*b)
+    eor v5.16b, v5.16b, v5.16b   // S5-S7 = scalar tail sums
+    eor v6.16b, v6.16b, v6.16b   // (scalar writes clear the upper lanes,
+    eor v7.16b, v7.16b, v7.16b   //  so they cannot share V0-V2)
+
+    sxtw x9, w2                  // X9 = dimension
+    and x10, x9, #0xFFFFFFFFFFFFFFFC  // X10 = dimension & ~3
+    mov x11, #0                  // X11 = index counter
+
+.Lcos_simd_loop:
+    cmp x11, x10
+    bge .Lcos_scalar_loop
+    ld1 {v3.4s}, [x0], #16       // V3 = vector_a[i:i+4]
+    ld1 {v4.4s}, [x1], #16       // V4 = vector_b[i:i+4]
+    fmla v0.4s, v3.4s, v4.4s
+    fmla v1.4s, v3.4s, v3.4s
+    fmla v2.4s, v4.4s, v4.4s
+    add x11, x11, #4
+    b .Lcos_simd_loop
+
+.Lcos_scalar_loop:
+    cmp x11, x9
+    bge .Lcos_reduce
+    ldr s3, [x0], #4
+    ldr s4, [x1], #4
+    fmadd s5, s3, s4, s5
+    fmadd s6, s3, s3, s6
+    fmadd s7, s4, s4, s7
+    add x11, x11, #1
+    b .Lcos_scalar_loop
+
+.Lcos_reduce:
+    faddp v0.4s, v0.4s, v0.4s
+    faddp s0, v0.2s              // S0 = a·b (vector part)
+    faddp v1.4s, v1.4s, v1.4s
+    faddp s1, v1.2s              // S1 = a·a
+    faddp v2.4s, v2.4s, v2.4s
+    faddp s2, v2.2s              // S2 = b·b
+    fadd s0, s0, s5
+    fadd s1, s1, s6
+    fadd s2, s2, s7
+
+    fsqrt s1, s1                 // ||a||
+    fsqrt s2, s2                 // ||b||
+    fmul s1, s1, s2              // ||a|| * ||b||
+
     // Avoid division by zero
-    adrp x9, float_zero@PAGE
-    add x9, x9, float_zero@PAGEOFF
-    ldr s2, [x9]
-    fcmp s1, s2
-    beq .Lcos_return_zero        // If norm == 0, return 0
-    
+    fcmp s1, #0.0
+    beq .Lcos_return_zero
+
     fdiv s0, s0, s1              // S0 = dot / (norm_a * norm_b)
-    b .Lcos_done
-    
+    ret
+
 .Lcos_return_zero:
     fmov s0, wzr                 // Return 0.0
-    
-.Lcos_done:
-    ldr d8, [sp, #48]            // Restore callee-saved NEON register
-    ldp x21, x22, [sp, #32]      // Restore callee-saved registers
-    ldp x19, x20, [sp, #16]
-    ldp x29, x30, [sp], #64
     ret
 
-
 // ============================================
 // Function: vector_norm_asm
 // Calculate L2 norm (Euclidean norm) of a vector
@@ -448,3 +452,291 @@ _add_vectors_asm:
     ldp x29, x30, [sp], #64
     ret
 
+
+
+// ============================================
+// Function: dot_product_x4_asm
+// Dot products of one vector with four consecutive rows
+// Register tile for similarity matrices: each element of the vector is
+// loaded once and multiplied with the matching element of four rows.
+// Parameters:
+//   X0 = float* vector
+//   X1 = float* rows (4 rows of dimension floats, row-major)
+//   X2 = int dimension
+//   X3 = float* out (4 floats: out[k] = dot(vector, rows + k*dimension))
+// ============================================
+    .global _dot_product_x4_asm
+_dot_product_x4_asm:
+    // Leaf function: only caller-saved registers (v0-v7, v16, x9-x14)
+    eor v0.16b, v0.16b, v0.16b   // V0-V3 = row accumulators
+    eor v1.16b, v1.16b, v1.16b
+    eor v2.16b, v2.16b, v2.16b
+    eor v3.16b, v3.16b, v3.16b
+    eor v16.16b, v16.16b, v16.16b // V16 = [tail0, tail1, tail2, tail3]
+
+    sxtw x9, w2                  // X9 = elements left
+    add x10, x1, x9, lsl #2      // X10-X12 = rows 1-3
+    add x11, x10, x9, lsl #2
+    add x12, x11, x9, lsl #2
+
+.Lx4_simd_loop:
+    cmp x9, #4
+    blt .Lx4_scalar_loop
+    ld1 {v4.4s}, [x0], #16       // V4 = vector[i:i+4]
+    ld1 {v5.4s}, [x1], #16
+    ld1 {v6.4s}, [x10], #16
+    ld1 {v7.4s}, [x11], #16
+    fmla v0.4s, v4.4s, v5.4s
+    ld1 {v5.4s}, [x12], #16
+    fmla v1.4s, v4.4s, v6.4s
+    fmla v2.4s, v4.4s, v7.4s
+    fmla v3.4s, v4.4s, v5.4s
+    sub x9, x9, #4
+    b .Lx4_simd_loop
+
+.Lx4_scalar_loop:
+    // Gather one element of each row into V5 lanes 0-3
+    cbz x9, .Lx4_reduce
+    ldr s4, [x0], #4
+    ld1 {v5.s}[0], [x1], #4
+    ld1 {v5.s}[1], [x10], #4
+    ld1 {v5.s}[2], [x11], #4
+    ld1 {v5.s}[3], [x12], #4
+    fmla v16.4s, v5.4s, v4.s[0]
+    sub x9, x9, #1
+    b .Lx4_scalar_loop
+
+.Lx4_reduce:
+    faddp v0.4s, v0.4s, v1.4s    // [a01, a23, b01, b23]
+    faddp v2.4s, v2.4s, v3.4s    // [c01, c23, d01, d23]
+    faddp v0.4s, v0.4s, v2.4s    // [a, b, c, d]
+    fadd v0.4s, v0.4s, v16.4s
+    st1 {v0.4s}, [x3]
+    ret
+
+// ============================================
+// Function: int8_dot_product_asm
+// Exact dot product of two int8 vectors
+// smull/smull2 widen byte products to int16 (|a*b| <= 2^14), sadalp
+// accumulates adjacent pairs into int32 lanes.
+// Parameters:
+//   X0 = int8_t* a
+//   X1 = int8_t* b
+//   X2 = int n
+// Returns:
+//   W0 = dot product (int32)
+// ============================================
+    .global _int8_dot_product_asm
+_int8_dot_product_asm:
+    // Leaf function: only caller-saved registers (v0-v7, x9-x14)
+    movi v0.4s, #0               // Accumulators (4 x int32 each)
+    movi v1.4s, #0
+    sxtw x9, w2                  // X9 = bytes left
+    mov w10, #0                  // W10 = scalar tail sum
+
+.Li8_simd_loop:
+    cmp x9, #16
+    blt .Li8_scalar_loop
+    ld1 {v2.16b}, [x0], #16
+    ld1 {v3.16b}, [x1], #16
+    smull v4.8h, v2.8b, v3.8b    // Bytes 0-7
+    smull2 v5.8h, v2.16b, v3.16b // Bytes 8-15
+    sadalp v0.4s, v4.8h
+    sadalp v1.4s, v5.8h
+    sub x9, x9, #16
+    b .Li8_simd_loop
+
+.Li8_scalar_loop:
+    cbz x9, .Li8_reduce
+    ldrsb w11, [x0], #1
+    ldrsb w12, [x1], #1
+    madd w10, w11, w12, w10
+    sub x9, x9, #1
+    b .Li8_scalar_loop
+
+.Li8_reduce:
+    add v0.4s, v0.4s, v1.4s
+    addv s0, v0.4s
+    fmov w11, s0
+    add w0, w10, w11
+    ret
+
+// ============================================
+// Function: hamming_distance_asm
+// Number of differing bits between two packed bit vectors
+// cnt counts bits per byte of a XOR b; uaddlp/uadalp widen the counts
+// into int32 lanes.
+// Parameters:
+//   X0 = uint8_t* a
+//   X1 = uint8_t* b
+//   X2 = int num_bytes
+// Returns:
+//   W0 = distance
+// ============================================
+    .global _hamming_distance_asm
+_hamming_distance_asm:
+    // Leaf function: only caller-saved registers (v0-v7, x9-x14)
+    movi v0.4s, #0               // 4 x int32 bit counts
+    sxtw x9, w2                  // X9 = bytes left
+    mov w10, #0                  // W10 = scalar tail count
+
+.Lham_simd_loop:
+    cmp x9, #16
+    blt .Lham_scalar_loop
+    ld1 {v2.16b}, [x0], #16
+    ld1 {v3.16b}, [x1], #16
+    eor v2.16b, v2.16b, v3.16b
+    cnt v2.16b, v2.16b           // Bits per byte (0-8)
+    uaddlp v2.8h, v2.16b
+    uadalp v0.4s, v2.8h
+    sub x9, x9, #16
+    b .Lham_simd_loop
+
+.Lham_scalar_loop:
+    cbz x9, .Lham_reduce
+    ldrb w11, [x0], #1
+    ldrb w12, [x1], #1
+    eor w11, w11, w12
+    fmov s1, w11
+    cnt v1.8b, v1.8b
+    umov w11, v1.b[0]
+    add w10, w10, w11
+    sub x9, x9, #1
+    b .Lham_scalar_loop
+
+.Lham_reduce:
+    addv s0, v0.4s
+    fmov w11, s0
+    add w0, w10, w11
+    ret
+
+// ============================================
+// Half-precision conversion kernels
+// Parameters:
+//   X0 = source
+//   X1 = destination
+//   X2 = int n
+// Returns:
+//   W0 = number of leading elements converted (a multiple of 8); the
+//   caller converts the remaining elements with the portable C code
+// ============================================
+
+// ============================================
+// Function: f16_to_f32_asm
+// fcvtl widens IEEE half to float exactly (subnormals included)
+// ============================================
+    .global _f16_to_f32_asm
+_f16_to_f32_asm:
+    sxtw x9, w2
+    and x9, x9, #-8              // X9 = elements handled 8 at a time
+    mov x10, #0
+
+.Lf16_load_loop:
+    cmp x10, x9
+    b.ge .Lf16_load_done
+    ld1 {v0.8h}, [x0], #16
+    fcvtl v1.4s, v0.4h
+    fcvtl2 v2.4s, v0.8h
+    st1 {v1.4s, v2.4s}, [x1], #32
+    add x10, x10, #8
+    b .Lf16_load_loop
+
+.Lf16_load_done:
+    mov w0, w9
+    ret
+
+// ============================================
+// Function: f32_to_f16_asm
+// fcvtn rounds with the FPCR mode (round-to-nearest-even by default)
+// ============================================
+    .global _f32_to_f16_asm
+_f32_to_f16_asm:
+    sxtw x9, w2
+    and x9, x9, #-8
+    mov x10, #0
+
+.Lf16_store_loop:
+    cmp x10, x9
+    b.ge .Lf16_store_done
+    ld1 {v0.4s, v1.4s}, [x0], #32
+    fcvtn v2.4h, v0.4s
+    fcvtn2 v2.8h, v1.4s
+    st1 {v2.8h}, [x1], #16
+    add x10, x10, #8
+    b .Lf16_store_loop
+
+.Lf16_store_done:
+    mov w0, w9
+    ret
+
+// ============================================
+// Function: bf16_to_f32_asm
+// bfloat16 is the top half of a float: shll by 16
+// ============================================
+    .global _bf16_to_f32_asm
+_bf16_to_f32_asm:
+    sxtw x9, w2
+    and x9, x9, #-8
+    mov x10, #0
+
+.Lbf16_load_loop:
+    cmp x10, x9
+    b.ge .Lbf16_load_done
+    ld1 {v0.8h}, [x0], #16
+    shll v1.4s, v0.4h, #16
+    shll2 v2.4s, v0.8h, #16
+    st1 {v1.4s, v2.4s}, [x1], #32
+    add x10, x10, #8
+    b .Lbf16_load_loop
+
+.Lbf16_load_done:
+    mov w0, w9
+    ret
+
+// ============================================
+// Function: f32_to_bf16_asm
+// Round-to-nearest-even: x + 0x7FFF + bit 16 of x, then the top half;
+// NaNs keep their top bits with the quiet bit (0x40) set
+// ============================================
+    .global _f32_to_bf16_asm
+_f32_to_bf16_asm:
+    // Leaf function: only caller-saved registers (v0-v7, v16-v19, x9-x10)
+    sxtw x9, w2
+    and x9, x9, #-8
+    mov x10, #0
+    movi v5.4s, #0x7f, msl #8    // 0x7FFF
+    movi v6.4s, #0x40            // Quiet bit
+    movi v7.4s, #1
+
+.Lbf16_store_loop:
+    cmp x10, x9
+    b.ge .Lbf16_store_done
+    ld1 {v0.4s, v1.4s}, [x0], #32
+
+    ushr v3.4s, v0.4s, #16       // Top halves (truncated)
+    and v2.16b, v3.16b, v7.16b
+    add v2.4s, v2.4s, v5.4s
+    add v2.4s, v2.4s, v0.4s
+    ushr v2.4s, v2.4s, #16       // Rounded
+    orr v3.16b, v3.16b, v6.16b   // Quieted NaN
+    fcmeq v4.4s, v0.4s, v0.4s    // All ones unless NaN
+    bif v2.16b, v3.16b, v4.16b
+
+    ushr v17.4s, v1.4s, #16
+    and v16.16b, v17.16b, v7.16b
+    add v16.4s, v16.4s, v5.4s
+    add v16.4s, v16.4s, v1.4s
+    ushr v16.4s, v16.4s, #16
+    orr v17.16b, v17.16b, v6.16b
+    fcmeq v18.4s, v1.4s, v1.4s
+    bif v16.16b, v17.16b, v18.16b
+
+    xtn v2.4h, v2.4s
+    xtn2 v2.8h, v16.4s
+    st1 {v2.8h}, [x1], #16
+    add x10, x10, #8
+    b .Lbf16_store_loop
+
+.Lbf16_store_done:
+    mov w0, w9
+    ret
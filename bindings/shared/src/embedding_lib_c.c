@@ -26,6 +26,7 @@
 #include "embedding_lib_c.h"
 #include "../include/fastembed.h"
 #include "../include/fastembed_config.h"
+#include "thread_pool.h"
 #include <ctype.h>
 #include <math.h>
 #include <stdint.h>
@@ -64,15 +65,27 @@ static float dot_product_asm(float *vector_a, float *vector_b, int dimension) {
   return sum;
 }
 
-/** C implementation: cosine similarity */
+/** C implementation: cosine similarity (single pass, 4 partial sums per
+ * reduction so the compiler can keep them in one vector register) */
 static float cosine_similarity_asm(float *vector_a, float *vector_b,
                                    int dimension) {
-  float dot = 0.0f, norm_a = 0.0f, norm_b = 0.0f;
-  for (int i = 0; i < dimension; i++) {
-    dot += vector_a[i] * vector_b[i];
-    norm_a += vector_a[i] * vector_a[i];
-    norm_b += vector_b[i] * vector_b[i];
+  float dot4[4] = {0}, norm_a4[4] = {0}, norm_b4[4] = {0};
+  int i = 0;
+  for (; i + 4 <= dimension; i += 4) {
+    for (int k = 0; k < 4; k++) {
+      dot4[k] += vector_a[i + k] * vector_b[i + k];
+      norm_a4[k] += vector_a[i + k] * vector_a[i + k];
+      norm_b4[k] += vector_b[i + k] * vector_b[i + k];
+    }
   }
+  for (; i < dimension; i++) {
+    dot4[0] += vector_a[i] * vector_b[i];
+    norm_a4[0] += vector_a[i] * vector_a[i];
+    norm_b4[0] += vector_b[i] * vector_b[i];
+  }
+  float dot = (dot4[0] + dot4[1]) + (dot4[2] + dot4[3]);
+  float norm_a = (norm_a4[0] + norm_a4[1]) + (norm_a4[2] + norm_a4[3]);
+  float norm_b = (norm_b4[0] + norm_b4[1]) + (norm_b4[2] + norm_b4[3]);
   float magnitude = sqrtf(norm_a) * sqrtf(norm_b);
   return (magnitude > 0.0f) ? (dot / magnitude) : 0.0f;
 }
@@ -104,19 +117,29 @@ static void add_vectors_asm(float *vector_a, float *vector_b, float *result,
   }
 }
 
-/** C implementation: generate embedding (placeholder - calls hash function) */
+/** C implementation: generate embedding (placeholder - calls hash function)
+ *
+ * One pass over the text updates every dimension's hash (one lane per
+ * dimension, a loop the compiler vectorizes) instead of re-reading the text
+ * per dimension; the output is the same. */
 static int generate_embedding_asm(const char *text, float *output,
                                   int dimension) {
   /* Simple hash-based implementation for C-only mode */
   size_t text_len = strlen(text);
+  uint32_t hashes[FASTEMBED_MAX_DIMENSION];
   for (int i = 0; i < dimension; i++) {
-    /* Use simple hash function with position-dependent seed */
-    uint32_t hash = 2166136261u; /* FNV-1a offset basis */
-    for (size_t j = 0; j < text_len; j++) {
-      hash ^= (uint8_t)text[j];
-      hash *= 16777619u;         /* FNV-1a prime */
-      hash ^= (uint32_t)(i + j); /* Position-dependent mixing */
+    hashes[i] = 2166136261u; /* FNV-1a offset basis */
+  }
+  for (size_t j = 0; j < text_len; j++) {
+    uint32_t c = (uint8_t)text[j];
+    uint32_t position = (uint32_t)j;
+    for (int i = 0; i < dimension; i++) {
+      uint32_t hash = (hashes[i] ^ c) * 16777619u; /* FNV-1a prime */
+      hashes[i] = hash ^ ((uint32_t)i + position); /* Position mixing */
     }
+  }
+  for (int i = 0; i < dimension; i++) {
+    uint32_t hash = hashes[i];
     /* Normalize to [-1, 1] range using sine */
     /* Use fmodf to ensure input to sinf stays in valid range */
     float normalized = (float)hash / (float)UINT32_MAX;
@@ -152,6 +175,29 @@ static int is_valid_dimension(int dimension) {
           dimension == 768 || dimension == 1024 || dimension == 2048);
 }
 
+/**
+ * @brief Embed text[0, text_len), which need not be null-terminated
+ *
+ * Lowercases into a stack buffer and hashes it. Shared by
+ * fastembed_generate() and the contiguous batch API; the caller has
+ * validated the dimension and 0 < text_len <= FASTEMBED_MAX_TEXT_LENGTH.
+ *
+ * @return 0 on success, -1 on generation failure
+ */
+static int generate_text_span(const char *text, size_t text_len, float *output,
+                              int dimension) {
+  /* Use stack buffer for normalized text (max 8192 chars + null terminator) */
+  char normalized_text[FASTEMBED_MAX_TEXT_LENGTH + 1];
+  for (size_t i = 0; i < text_len; i++) {
+    normalized_text[i] = (char)tolower((unsigned char)text[i]);
+  }
+  normalized_text[text_len] = '\0';
+
+  /* Generate embedding using assembly-optimized function */
+  return generate_embedding_asm(normalized_text, output, dimension) == 0 ? 0
+                                                                         : -1;
+}
+
 /**
  * @brief Generate text embedding using improved hash-based algorithm
  *
@@ -183,7 +229,8 @@ static int is_valid_dimension(int dimension) {
  * @note This function uses hash-based embedding, not learned model embeddings.
  *       For ML model embeddings, use fastembed_onnx_generate() instead.
  * @note Default dimension is 128 (changed from 768 in v1.0.1)
- * @note Performance: ~0.01-0.05ms for 128D, ~0.05-0.15ms for 768D
+ * @note Performance: one pass over the text plus O(dimension) SIMD work,
+ *       ~0.5us for 768D on a short text (assembly path)
  * @note For BERT compatibility, use dimension=768 explicitly
  */
 FASTEMBED_EXPORT int fastembed_generate(const char *text, float *output,
@@ -210,21 +257,7 @@ FASTEMBED_EXPORT int fastembed_generate(const char *text, float *output,
     return -1;
   }
 
-  /* Use stack buffer for normalized text (max 8192 chars + null terminator) */
-  char normalized_text[FASTEMBED_MAX_TEXT_LENGTH + 1];
-  for (size_t i = 0; i < text_len; i++) {
-    normalized_text[i] = (char)tolower((unsigned char)text[i]);
-  }
-  normalized_text[text_len] = '\0';
-
-  /* Generate embedding using assembly-optimized function */
-  int result = generate_embedding_asm(normalized_text, output, dimension);
-
-  if (result != 0) {
-    return -1;
-  }
-
-  return 0;
+  return generate_text_span(text, text_len, output, dimension);
 }
 
 /**
@@ -285,6 +318,28 @@ FASTEMBED_EXPORT float fastembed_cosine_similarity(const float *vec1,
   return cosine_similarity_asm((float *)vec1, (float *)vec2, dimension);
 }
 
+/**
+ * @brief Cosine similarity of two unit-length vectors
+ *
+ * For L2-normalized inputs (fastembed_normalize() output and all ONNX
+ * embeddings) cosine similarity equals the dot product, so the norms are not
+ * computed.
+ *
+ * @param vec1 First unit vector (read-only)
+ * @param vec2 Second unit vector (read-only)
+ * @param dimension Number of elements in vectors (must match for both)
+ * @return Cosine similarity, or 0.0f on error (invalid parameters)
+ */
+FASTEMBED_EXPORT float fastembed_cosine_similarity_normalized(const float *vec1,
+                                                              const float *vec2,
+                                                              int dimension) {
+  if (!vec1 || !vec2 || dimension <= 0) {
+    return 0.0f;
+  }
+
+  return dot_product_asm((float *)vec1, (float *)vec2, dimension);
+}
+
 /**
  * @brief Calculate L2 (Euclidean) norm of a vector
  *
@@ -362,6 +417,85 @@ FASTEMBED_EXPORT void fastembed_add_vectors(const float *vec1,
   add_vectors_asm((float *)vec1, (float *)vec2, result, dimension);
 }
 
+/**
+ * @brief Get the SIMD level used by the vector operations
+ *
+ * @return Active fastembed_simd_level_t value
+ */
+FASTEMBED_EXPORT int fastembed_get_simd_level(void) {
+#if defined(USE_ONLY_C)
+  return FASTEMBED_SIMD_SCALAR;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  return FASTEMBED_SIMD_NEON;
+#else
+  /** Assembly: detected level (runs CPUID dispatch on first use) */
+  extern int simd_get_level_asm(void);
+  return simd_get_level_asm();
+#endif
+}
+
+/**
+ * @brief Cap the SIMD level used by the vector operations
+ *
+ * @param level Maximum fastembed_simd_level_t value
+ * @return Level actually installed, or -1 if level is out of range
+ */
+FASTEMBED_EXPORT int fastembed_set_simd_level(int level) {
+  if (level < FASTEMBED_SIMD_SCALAR || level > FASTEMBED_SIMD_AVX512) {
+    return -1;
+  }
+
+#if defined(USE_ONLY_C) || defined(__aarch64__) || defined(_M_ARM64)
+  /* Single implementation: nothing to select */
+  return fastembed_get_simd_level();
+#else
+  /** Assembly: install min(level, detected) kernels, returns installed level */
+  extern int simd_select_level_asm(int max_level);
+  return simd_select_level_asm(level);
+#endif
+}
+
+#ifdef USE_ONNX_RUNTIME
+/**
+ * @brief Resolve and validate the output dimension for an ONNX model
+ *
+ * Detects the model output dimension and checks the requested dimension
+ * against it. A requested dimension of 0 means auto-detect.
+ *
+ * @param model_path Path to .onnx model file
+ * @param dimension Requested dimension (0 = use model dimension)
+ * @return Dimension to use on success, -1 on error (detection failure,
+ * out of range or mismatch with model output)
+ */
+static int resolve_onnx_dimension(const char *model_path, int dimension) {
+  extern int onnx_get_model_dimension(const char *model_path);
+  int model_dimension = onnx_get_model_dimension(model_path);
+
+  if (model_dimension <= 0) {
+    return -1; /* Failed to detect model dimension */
+  }
+
+  /* Auto-detect dimension if not provided (0 means auto-detect) */
+  int actual_dimension = dimension;
+  if (dimension == 0) {
+    actual_dimension = model_dimension; /* Use detected dimension */
+  }
+
+  /* Validate dimension */
+  if (actual_dimension <= 0 || actual_dimension > FASTEMBED_MAX_OUTPUT_DIM) {
+    return -1;
+  }
+
+  /* Validate dimension matches model */
+  if (actual_dimension != model_dimension) {
+    /* Dimension mismatch - return error */
+    return -1;
+  }
+
+  return actual_dimension;
+}
+#endif
+
 /**
  * @brief Generate embedding using ONNX model
  *
@@ -393,27 +527,8 @@ int fastembed_onnx_generate(const char *model_path, const char *text,
 #ifdef USE_ONNX_RUNTIME
   /* Get model dimension (auto-detect if dimension is 0, or validate if
    * provided) */
-  extern int onnx_get_model_dimension(const char *model_path);
-  int model_dimension = onnx_get_model_dimension(model_path);
-
-  if (model_dimension <= 0) {
-    return -1; /* Failed to detect model dimension */
-  }
-
-  /* Auto-detect dimension if not provided (0 means auto-detect) */
-  int actual_dimension = dimension;
-  if (dimension == 0) {
-    actual_dimension = model_dimension; /* Use detected dimension */
-  }
-
-  /* Validate dimension */
-  if (actual_dimension <= 0 || actual_dimension > FASTEMBED_MAX_OUTPUT_DIM) {
-    return -1;
-  }
-
-  /* Validate dimension matches model */
-  if (actual_dimension != model_dimension) {
-    /* Dimension mismatch - return error */
+  int actual_dimension = resolve_onnx_dimension(model_path, dimension);
+  if (actual_dimension < 0) {
     return -1;
   }
 
@@ -431,127 +546,1046 @@ int fastembed_onnx_generate(const char *model_path, const char *text,
 #endif
 }
 
-int fastembed_onnx_unload(void) {
+/**
+ * @brief Generate ONNX embeddings for multiple texts in batched inference
+ *
+ * Tokenizes all texts, pads them to a common length with an attention mask
+ * and runs one [N, seq_len] inference per group of up to
+ * FASTEMBED_ONNX_MAX_BATCH_SIZE texts. Falls back to hash-based batch
+ * generation if ONNX Runtime is not available.
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @param texts Array of text strings (null-terminated) to embed
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
+ * dimension)
+ * @param dimension Requested embedding dimension (0 = auto-detect)
+ * @return 0 on success, -1 on error
+ */
+int fastembed_onnx_batch_generate(const char *model_path, const char **texts,
+                                  int num_texts, float **outputs,
+                                  int dimension) {
+  if (!model_path || !texts || !outputs || num_texts <= 0) {
+    return -1;
+  }
+
 #ifdef USE_ONNX_RUNTIME
-  extern int onnx_unload_model(void);
-  return onnx_unload_model();
+  int actual_dimension = resolve_onnx_dimension(model_path, dimension);
+  if (actual_dimension < 0) {
+    return -1;
+  }
+
+  extern int onnx_generate_embeddings_batch(const char *model_path,
+                                            const char **texts, int num_texts,
+                                            float **outputs, int output_dim);
+  return onnx_generate_embeddings_batch(model_path, texts, num_texts, outputs,
+                                        actual_dimension);
 #else
-  /* Nothing to unload if ONNX Runtime not available */
-  return 0;
+  /* Fallback to hash-based batch generation if ONNX Runtime unavailable */
+  return fastembed_batch_generate(texts, num_texts, outputs, dimension);
 #endif
 }
 
-int fastembed_onnx_get_last_error(char *error_buffer, size_t buffer_size) {
+/**
+ * @brief Set the padded-token budget for batched ONNX inference
+ *
+ * Controls how fastembed_onnx_batch_generate() packs length-sorted texts into
+ * sub-batches: each Run() processes at most max_tokens padded tokens
+ * (batch_size * seq_len). 0 restores FASTEMBED_ONNX_BATCH_TOKEN_BUDGET.
+ *
+ * @param max_tokens Token budget per inference call (0 = default)
+ * @return 0 on success, -1 on invalid value
+ */
+int fastembed_onnx_set_batch_token_budget(int max_tokens) {
+  if (max_tokens < 0) {
+    return -1;
+  }
+
 #ifdef USE_ONNX_RUNTIME
-  extern int onnx_get_last_error(char *error_buffer, size_t buffer_size);
-  return onnx_get_last_error(error_buffer, buffer_size);
+  extern int onnx_set_batch_token_budget(int max_tokens);
+  return onnx_set_batch_token_budget(max_tokens);
 #else
-  /* No error message available if ONNX Runtime not compiled */
-  if (error_buffer && buffer_size > 0) {
-    snprintf(error_buffer, buffer_size,
-             "ONNX Runtime not available (not compiled with USE_ONNX_RUNTIME)");
-  }
-  return -1;
+  /* No batching scheduler without ONNX Runtime */
+  return 0;
 #endif
 }
 
 /**
- * @brief Get ONNX model output dimension
- *
- * Returns the output dimension of an ONNX embedding model. If the model is
- * already loaded (cached), returns the cached dimension immediately.
- * Otherwise, loads the model to detect the dimension.
+ * @brief Initialize ONNX session options with defaults
  *
- * This function is useful to determine the correct dimension parameter before
- * calling fastembed_onnx_generate().
+ * @param options Options to initialize
+ */
+void fastembed_onnx_options_init(fastembed_onnx_options_t *options) {
+  if (!options) {
+    return;
+  }
+
+  memset(options, 0, sizeof(*options));
+  options->intra_op_threads = 0; /* ONNX Runtime default */
+  options->inter_op_threads = 0; /* ONNX Runtime default */
+  options->graph_opt_level = FASTEMBED_GRAPH_OPT_ALL;
+  options->enable_mem_pattern = 1;
+  options->enable_cpu_mem_arena = 1;
+  options->num_execution_providers = 0; /* CPU only */
+  options->device_id = 0;
+  options->optimized_model_path = NULL;
+  options->tokenizer_path = NULL; /* Discover next to the model */
+  options->pooling = FASTEMBED_POOLING_CLS;
+}
+
+/**
+ * @brief Open a reference-counted handle to an ONNX model
  *
  * @param model_path Path to .onnx model file (must be readable)
- * @return Model output dimension on success, -1 on error (model not found,
- * invalid model, dimension detection failed)
- *
- * @note The dimension is cached per model path for performance
- * @note Returns -1 if ONNX Runtime is not available
- * @note Use this function to validate dimension before calling
- * fastembed_onnx_generate()
+ * @return Model handle on success, NULL on error (or without ONNX Runtime)
+ */
+fastembed_model_t *fastembed_model_open(const char *model_path) {
+  return fastembed_model_open_with_options(model_path, NULL);
+}
+
+/**
+ * @brief Open a handle to an ONNX model with session options
  *
- * @example
- * ```c
- * int dim = fastembed_onnx_get_model_dimension("model.onnx");
- * if (dim > 0) {
- *   float *output = malloc(dim * sizeof(float));
- *   fastembed_onnx_generate("model.onnx", "text", output, dim);
- * }
- * ```
+ * @param model_path Path to .onnx model file (must be readable)
+ * @param options Session options (NULL = defaults)
+ * @return Model handle on success, NULL on error (or without ONNX Runtime)
  */
-int fastembed_onnx_get_model_dimension(const char *model_path) {
+fastembed_model_t *
+fastembed_model_open_with_options(const char *model_path,
+                                  const fastembed_onnx_options_t *options) {
   if (!model_path) {
-    return -1;
+    return NULL;
   }
 
 #ifdef USE_ONNX_RUNTIME
-  extern int onnx_get_model_dimension(const char *model_path);
-  return onnx_get_model_dimension(model_path);
+  extern fastembed_model_t *onnx_model_open(
+      const char *model_path, const fastembed_onnx_options_t *options);
+  return onnx_model_open(model_path, options);
 #else
-  return -1; /* ONNX Runtime not available */
+  (void)options;
+  return NULL; /* ONNX Runtime not available */
 #endif
 }
 
 /**
- * @brief Generate embeddings for multiple texts in batch
- *
- * Processes an array of texts and generates embeddings for each one.
- * This function provides batching capability for efficient processing
- * of multiple texts at once.
- *
- * The function processes texts sequentially. If any text fails to generate
- * an embedding, the function returns immediately with an error.
- *
- * @param texts Array of text strings (null-terminated) to embed
- * @param num_texts Number of texts in the array (must match outputs array size)
- * @param outputs Array of output arrays for embeddings (each must be
- * pre-allocated, size >= dimension)
- * @param dimension Embedding dimension (same for all texts). Supported
- * dimensions: 128, 256, 512, 768, 1024, 2048. If 0, uses default dimension 128.
- * @return 0 on success (all embeddings generated), -1 on error (validation or
- * generation failure)
+ * @brief Get the execution provider an open model runs on
  *
- * @note Arrays texts and outputs must have num_texts elements
- * @note Each output array must be pre-allocated with size >= dimension
- * @note On error, some embeddings may have been generated (partial results)
- * @note Supported dimensions: 128, 256, 512, 768, 1024, 2048
- * @note Uses hash-based embeddings (fastembed_generate) for all texts
+ * @param model Model handle
+ * @return fastembed_execution_provider_t value, -1 on error
  */
-FASTEMBED_EXPORT int fastembed_batch_generate(const char **texts, int num_texts,
-                                              float **outputs, int dimension) {
-  if (!texts || !outputs || num_texts <= 0) {
+int fastembed_model_get_execution_provider(const fastembed_model_t *model) {
+  if (!model) {
     return -1;
   }
 
-  /* Use default dimension if 0 is specified */
-  if (dimension == 0) {
-    dimension = 128; /* Default dimension */
-  }
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_model_get_execution_provider(const fastembed_model_t *model);
+  return onnx_model_get_execution_provider(model);
+#else
+  return -1;
+#endif
+}
 
-  /* Validate dimension */
-  if (dimension <= 0 || !is_valid_dimension(dimension)) {
-    return -1;
+/**
+ * @brief Get the tokenizer an open model uses
+ *
+ * @param model Model handle
+ * @return Tokenizer, or NULL for the hash-based fallback / on error
+ */
+const fastembed_tokenizer_t *
+fastembed_model_get_tokenizer(const fastembed_model_t *model) {
+  if (!model) {
+    return NULL;
   }
 
-  /* Process each text sequentially */
-  for (int i = 0; i < num_texts; i++) {
-    /* Validate current text and output pointers */
-    if (!texts[i] || !outputs[i]) {
-      return -1;
-    }
+#ifdef USE_ONNX_RUNTIME
+  extern const fastembed_tokenizer_t *onnx_model_get_tokenizer(
+      const fastembed_model_t *model);
+  return onnx_model_get_tokenizer(model);
+#else
+  return NULL;
+#endif
+}
 
-    /* Generate embedding for current text */
-    int result = fastembed_generate(texts[i], outputs[i], dimension);
-    if (result != 0) {
-      return -1;
-    }
+/**
+ * @brief Close a model handle returned by fastembed_model_open()
+ *
+ * @param model Model handle
+ * @return 0 on success, -1 on error
+ */
+int fastembed_model_close(fastembed_model_t *model) {
+  if (!model) {
+    return -1;
   }
 
-  return 0;
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_model_close(fastembed_model_t * model);
+  return onnx_model_close(model);
+#else
+  return -1;
+#endif
+}
+
+/**
+ * @brief Run warmup inferences on an open model
+ *
+ * @param model Model handle
+ * @return 0 on success, -1 on error
+ */
+int fastembed_model_warmup(fastembed_model_t *model) {
+  if (!model) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_model_warmup(fastembed_model_t * model);
+  return onnx_model_warmup(model);
+#else
+  return -1;
+#endif
+}
+
+/**
+ * @brief Load an ONNX model into the session cache and warm it up
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Session options (NULL = defaults)
+ * @return 0 on success, -1 on error (or without ONNX Runtime)
+ */
+int fastembed_onnx_preload(const char *model_path,
+                           const fastembed_onnx_options_t *options) {
+  if (!model_path) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_preload(const char *model_path,
+                          const fastembed_onnx_options_t *options);
+  return onnx_preload(model_path, options);
+#else
+  (void)options;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Start fastembed_onnx_preload() on a background thread
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Session options (NULL = defaults)
+ * @return Preload handle, NULL on error (or without ONNX Runtime)
+ */
+fastembed_preload_t *
+fastembed_onnx_preload_async(const char *model_path,
+                             const fastembed_onnx_options_t *options) {
+  if (!model_path) {
+    return NULL;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern fastembed_preload_t *onnx_preload_async(
+      const char *model_path, const fastembed_onnx_options_t *options);
+  return onnx_preload_async(model_path, options);
+#else
+  (void)options;
+  return NULL;
+#endif
+}
+
+/**
+ * @brief Check whether a background preload has finished
+ *
+ * @param preload Handle from fastembed_onnx_preload_async()
+ * @return 1 if finished, 0 if running, -1 on error
+ */
+int fastembed_onnx_preload_done(const fastembed_preload_t *preload) {
+  if (!preload) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_preload_done(const fastembed_preload_t *preload);
+  return onnx_preload_done(preload);
+#else
+  return -1;
+#endif
+}
+
+/**
+ * @brief Wait for a background preload and free its handle
+ *
+ * @param preload Handle from fastembed_onnx_preload_async()
+ * @return 0 if the preload succeeded, -1 on error
+ */
+int fastembed_onnx_preload_wait(fastembed_preload_t *preload) {
+  if (!preload) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_preload_wait(fastembed_preload_t * preload);
+  return onnx_preload_wait(preload);
+#else
+  return -1;
+#endif
+}
+
+/**
+ * @brief Get output dimension of an open model
+ *
+ * @param model Model handle
+ * @return Output dimension on success, -1 on error
+ */
+int fastembed_model_get_dimension(const fastembed_model_t *model) {
+  if (!model) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_model_get_dimension(const fastembed_model_t *model);
+  return onnx_model_get_dimension(model);
+#else
+  return -1;
+#endif
+}
+
+/**
+ * @brief Generate embeddings for multiple texts with an open model
+ *
+ * @param model Model handle
+ * @param texts Array of text strings (null-terminated) to embed
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
+ * dimension)
+ * @param dimension Requested embedding dimension (0 = model dimension)
+ * @return 0 on success, -1 on error
+ */
+int fastembed_model_batch_generate(fastembed_model_t *model,
+                                   const char **texts, int num_texts,
+                                   float **outputs, int dimension) {
+  if (!model || !texts || !outputs || num_texts <= 0) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  int model_dimension = fastembed_model_get_dimension(model);
+  if (model_dimension <= 0) {
+    return -1;
+  }
+  if (dimension == 0) {
+    dimension = model_dimension;
+  }
+  if (dimension != model_dimension) {
+    return -1; /* Dimension mismatch */
+  }
+
+  extern int onnx_model_generate_batch(fastembed_model_t * model,
+                                       const char **texts, int num_texts,
+                                       float **outputs, int output_dim);
+  return onnx_model_generate_batch(model, texts, num_texts, outputs,
+                                   dimension);
+#else
+  (void)dimension;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Generate embeddings for many texts with an open model on the shared
+ * thread pool
+ *
+ * @param model Model handle
+ * @param texts Array of text strings (null-terminated) to embed
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
+ * dimension)
+ * @param dimension Requested embedding dimension (0 = model dimension)
+ * @param statuses Optional per-text fastembed_status_t output
+ * @param num_threads Threads including the caller (0 = whole pool)
+ * @return Number of failed texts, -1 on invalid arguments
+ */
+int fastembed_model_batch_generate_parallel(fastembed_model_t *model,
+                                            const char **texts, int num_texts,
+                                            float **outputs, int dimension,
+                                            int *statuses, int num_threads) {
+  if (!model || !texts || !outputs || num_texts <= 0 || num_threads < 0) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  int model_dimension = fastembed_model_get_dimension(model);
+  if (model_dimension <= 0) {
+    return -1;
+  }
+  if (dimension == 0) {
+    dimension = model_dimension;
+  }
+  if (dimension != model_dimension) {
+    return -1; /* Dimension mismatch */
+  }
+
+  extern int onnx_model_generate_batch_parallel(
+      fastembed_model_t * model, const char **texts, int num_texts,
+      float **outputs, int output_dim, int *statuses, int num_threads);
+  return onnx_model_generate_batch_parallel(model, texts, num_texts, outputs,
+                                            dimension, statuses, num_threads);
+#else
+  (void)dimension;
+  (void)statuses;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Generate embeddings for concatenated texts with an open model into
+ * one matrix
+ *
+ * @param model Model handle
+ * @param text_data Concatenated UTF-8 texts (need not be null-terminated)
+ * @param offsets num_texts + 1 byte offsets into text_data
+ * @param num_texts Number of texts
+ * @param output Row-major float[num_texts * dimension]
+ * @param dimension Requested embedding dimension (0 = model dimension)
+ * @param statuses Optional per-text fastembed_status_t output
+ * @param num_threads Threads including the caller (0 = whole pool)
+ * @return Number of failed texts (their rows are zeroed), -1 on invalid
+ * arguments
+ */
+int fastembed_model_batch_generate_contiguous(
+    fastembed_model_t *model, const char *text_data, const int32_t *offsets,
+    int num_texts, float *output, int dimension, int *statuses,
+    int num_threads) {
+  if (!model || !text_data || !offsets || !output || num_texts <= 0 ||
+      num_threads < 0) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  int model_dimension = fastembed_model_get_dimension(model);
+  if (model_dimension <= 0) {
+    return -1;
+  }
+  if (dimension == 0) {
+    dimension = model_dimension;
+  }
+  if (dimension != model_dimension) {
+    return -1; /* Dimension mismatch */
+  }
+
+  extern int onnx_model_generate_contiguous_parallel(
+      fastembed_model_t * model, const char *text_data,
+      const int32_t *offsets, int num_texts, float *output, int output_dim,
+      int *statuses, int num_threads);
+  return onnx_model_generate_contiguous_parallel(model, text_data, offsets,
+                                                 num_texts, output, dimension,
+                                                 statuses, num_threads);
+#else
+  (void)dimension;
+  (void)statuses;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Generate embedding for one text with an open model
+ *
+ * @param model Model handle
+ * @param text Input text to embed (null-terminated string)
+ * @param output Output array (pre-allocated, size >= dimension)
+ * @param dimension Requested embedding dimension (0 = model dimension)
+ * @return 0 on success, -1 on error
+ */
+int fastembed_model_generate(fastembed_model_t *model, const char *text,
+                             float *output, int dimension) {
+  if (!text || !output) {
+    return -1;
+  }
+  return fastembed_model_batch_generate(model, &text, 1, &output, dimension);
+}
+
+/**
+ * @brief Initialize chunking options with defaults
+ *
+ * @param options Options to initialize
+ */
+void fastembed_chunk_options_init(fastembed_chunk_options_t *options) {
+  if (!options) {
+    return;
+  }
+
+  memset(options, 0, sizeof(*options));
+  options->window_tokens = FASTEMBED_CHUNK_DEFAULT_WINDOW_TOKENS;
+  options->overlap_tokens = FASTEMBED_CHUNK_DEFAULT_OVERLAP_TOKENS;
+  options->on_chunk = NULL;
+  options->user_data = NULL;
+}
+
+/**
+ * @brief Start embedding a document in overlapping token windows
+ *
+ * @param model Model handle
+ * @param options Chunking options (NULL = defaults)
+ * @return Document, NULL on error (or without ONNX Runtime)
+ */
+fastembed_document_t *
+fastembed_document_begin(fastembed_model_t *model,
+                         const fastembed_chunk_options_t *options) {
+  if (!model) {
+    return NULL;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = fastembed_model_get_dimension(model);
+  if (dimension <= 0) {
+    return NULL;
+  }
+
+  extern fastembed_document_t *onnx_document_begin(
+      fastembed_model_t * model, const fastembed_chunk_options_t *options,
+      int dimension);
+  return onnx_document_begin(model, options, dimension);
+#else
+  (void)options;
+  return NULL; /* ONNX Runtime not available */
+#endif
+}
+
+/**
+ * @brief Append text to a document
+ *
+ * @param document Document returned by fastembed_document_begin()
+ * @param text UTF-8 text (need not be null-terminated)
+ * @param length Bytes of text
+ * @return 0 on success, -1 on error
+ */
+int fastembed_document_feed(fastembed_document_t *document, const char *text,
+                            size_t length) {
+  if (!document) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_document_feed(fastembed_document_t * document,
+                                const char *text, size_t length);
+  return onnx_document_feed(document, text, length);
+#else
+  (void)text;
+  (void)length;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Embed the remaining windows and pool the document vector
+ *
+ * @param document Document returned by fastembed_document_begin()
+ * @param output float[dimension] document vector (may be NULL)
+ * @return Number of windows, -1 on error
+ */
+int fastembed_document_finish(fastembed_document_t *document, float *output) {
+  if (!document) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_document_finish(fastembed_document_t * document,
+                                  float *output);
+  return onnx_document_finish(document, output);
+#else
+  (void)output;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Free a document returned by fastembed_document_begin()
+ *
+ * @param document Document (NULL is ignored)
+ */
+void fastembed_document_free(fastembed_document_t *document) {
+  if (!document) {
+    return;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern void onnx_document_free(fastembed_document_t * document);
+  onnx_document_free(document);
+#endif
+}
+
+/**
+ * @brief Embed a whole document in overlapping token windows
+ *
+ * @param model Model handle
+ * @param text UTF-8 document text
+ * @param length Bytes of text
+ * @param options Chunking options (NULL = defaults)
+ * @param output float[dimension] document vector (may be NULL)
+ * @return Number of windows, -1 on error
+ */
+int fastembed_model_embed_document(fastembed_model_t *model, const char *text,
+                                   size_t length,
+                                   const fastembed_chunk_options_t *options,
+                                   float *output) {
+  if (!text) {
+    return -1;
+  }
+
+  fastembed_document_t *document = fastembed_document_begin(model, options);
+  if (!document) {
+    return -1;
+  }
+  int chunks = fastembed_document_feed(document, text, length) == 0
+                   ? fastembed_document_finish(document, output)
+                   : -1;
+  fastembed_document_free(document);
+  return chunks;
+}
+
+/**
+ * @brief Initialize pipeline options with defaults
+ *
+ * @param options Options to initialize
+ */
+void fastembed_pipeline_options_init(fastembed_pipeline_options_t *options) {
+  if (!options) {
+    return;
+  }
+
+  memset(options, 0, sizeof(*options));
+  options->tokenizer_threads = FASTEMBED_PIPELINE_DEFAULT_TOKENIZER_THREADS;
+  options->inference_threads = FASTEMBED_PIPELINE_DEFAULT_INFERENCE_THREADS;
+  options->queue_depth = FASTEMBED_PIPELINE_DEFAULT_QUEUE_DEPTH;
+  options->quantization = FASTEMBED_QUANT_NONE;
+}
+
+/**
+ * @brief Embed many texts with tokenization, inference and post-processing
+ * overlapped
+ *
+ * @param model Model handle
+ * @param texts Array of input texts
+ * @param num_texts Number of texts
+ * @param dimension Requested embedding dimension (0 = model dimension)
+ * @param statuses Optional per-text fastembed_status_t output
+ * @param options Pipeline options
+ * @return Number of failed texts, -1 on error (or without ONNX Runtime)
+ */
+int fastembed_model_batch_generate_pipelined(
+    fastembed_model_t *model, const char **texts, int num_texts, int dimension,
+    int *statuses, const fastembed_pipeline_options_t *options) {
+  if (!model || !texts || num_texts <= 0 || !options) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  int model_dimension = fastembed_model_get_dimension(model);
+  if (model_dimension <= 0) {
+    return -1;
+  }
+  if (dimension == 0) {
+    dimension = model_dimension;
+  }
+  if (dimension != model_dimension) {
+    return -1; /* Dimension mismatch */
+  }
+
+  extern int onnx_model_generate_pipelined(
+      fastembed_model_t * model, const char **texts, int num_texts,
+      int output_dim, int *statuses,
+      const fastembed_pipeline_options_t *options);
+  return onnx_model_generate_pipelined(model, texts, num_texts, dimension,
+                                       statuses, options);
+#else
+  (void)dimension;
+  (void)statuses;
+  return -1;
+#endif
+}
+
+/**
+ * @brief Set how many idle ONNX sessions stay cached
+ *
+ * @param capacity Maximum number of cached models (>= 1)
+ * @return 0 on success, -1 on invalid capacity
+ */
+int fastembed_onnx_set_cache_capacity(int capacity) {
+  if (capacity < 1) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_set_model_cache_capacity(int capacity);
+  return onnx_set_model_cache_capacity(capacity);
+#else
+  return 0; /* Nothing is cached without ONNX Runtime */
+#endif
+}
+
+int fastembed_onnx_unload(void) {
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_unload_model(void);
+  return onnx_unload_model();
+#else
+  /* Nothing to unload if ONNX Runtime not available */
+  return 0;
+#endif
+}
+
+int fastembed_onnx_get_last_error(char *error_buffer, size_t buffer_size) {
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_get_last_error(char *error_buffer, size_t buffer_size);
+  return onnx_get_last_error(error_buffer, buffer_size);
+#else
+  /* No error message available if ONNX Runtime not compiled */
+  if (error_buffer && buffer_size > 0) {
+    snprintf(error_buffer, buffer_size,
+             "ONNX Runtime not available (not compiled with USE_ONNX_RUNTIME)");
+  }
+  return -1;
+#endif
+}
+
+/**
+ * @brief Get ONNX model output dimension
+ *
+ * Returns the output dimension of an ONNX embedding model. If the model is
+ * already loaded (cached), returns the cached dimension immediately.
+ * Otherwise, loads the model to detect the dimension.
+ *
+ * This function is useful to determine the correct dimension parameter before
+ * calling fastembed_onnx_generate().
+ *
+ * @param model_path Path to .onnx model file (must be readable)
+ * @return Model output dimension on success, -1 on error (model not found,
+ * invalid model, dimension detection failed)
+ *
+ * @note The dimension is cached per model path for performance
+ * @note Returns -1 if ONNX Runtime is not available
+ * @note Use this function to validate dimension before calling
+ * fastembed_onnx_generate()
+ *
+ * @example
+ * ```c
+ * int dim = fastembed_onnx_get_model_dimension("model.onnx");
+ * if (dim > 0) {
+ *   float *output = malloc(dim * sizeof(float));
+ *   fastembed_onnx_generate("model.onnx", "text", output, dim);
+ * }
+ * ```
+ */
+int fastembed_onnx_get_model_dimension(const char *model_path) {
+  if (!model_path) {
+    return -1;
+  }
+
+#ifdef USE_ONNX_RUNTIME
+  extern int onnx_get_model_dimension(const char *model_path);
+  return onnx_get_model_dimension(model_path);
+#else
+  return -1; /* ONNX Runtime not available */
+#endif
+}
+
+/**
+ * @brief Generate embeddings for multiple texts in batch
+ *
+ * Processes an array of texts and generates embeddings for each one.
+ * This function provides batching capability for efficient processing
+ * of multiple texts at once.
+ *
+ * The function processes texts sequentially. If any text fails to generate
+ * an embedding, the function returns immediately with an error. See
+ * fastembed_batch_generate_parallel() for a multithreaded version that
+ * reports a status per text.
+ *
+ * @param texts Array of text strings (null-terminated) to embed
+ * @param num_texts Number of texts in the array (must match outputs array size)
+ * @param outputs Array of output arrays for embeddings (each must be
+ * pre-allocated, size >= dimension)
+ * @param dimension Embedding dimension (same for all texts). Supported
+ * dimensions: 128, 256, 512, 768, 1024, 2048. If 0, uses default dimension 128.
+ * @return 0 on success (all embeddings generated), -1 on error (validation or
+ * generation failure)
+ *
+ * @note Arrays texts and outputs must have num_texts elements
+ * @note Each output array must be pre-allocated with size >= dimension
+ * @note On error, some embeddings may have been generated (partial results)
+ * @note Supported dimensions: 128, 256, 512, 768, 1024, 2048
+ * @note Uses hash-based embeddings (fastembed_generate) for all texts
+ */
+FASTEMBED_EXPORT int fastembed_batch_generate(const char **texts, int num_texts,
+                                              float **outputs, int dimension) {
+  if (!texts || !outputs || num_texts <= 0) {
+    return -1;
+  }
+
+  /* Use default dimension if 0 is specified */
+  if (dimension == 0) {
+    dimension = 128; /* Default dimension */
+  }
+
+  /* Validate dimension */
+  if (dimension <= 0 || !is_valid_dimension(dimension)) {
+    return -1;
+  }
+
+  /* Process each text sequentially */
+  for (int i = 0; i < num_texts; i++) {
+    /* Validate current text and output pointers */
+    if (!texts[i] || !outputs[i]) {
+      return -1;
+    }
+
+    /* Generate embedding for current text */
+    int result = fastembed_generate(texts[i], outputs[i], dimension);
+    if (result != 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/** Arguments shared by the fastembed_batch_generate_parallel() tasks */
+typedef struct {
+  const char **texts;
+  float **outputs;
+  int dimension;
+  int *statuses;
+  int failures[FASTEMBED_THREAD_POOL_MAX_THREADS]; /* Per worker */
+} batch_generate_job_t;
+
+/** Embed one text of a parallel batch; returns a fastembed_status_t */
+static int batch_generate_item(const char *text, float *output,
+                               int dimension) {
+  if (!text || !output) {
+    return FASTEMBED_STATUS_NULL_INPUT;
+  }
+  size_t text_len = strlen(text);
+  if (text_len == 0 || text_len > FASTEMBED_MAX_TEXT_LENGTH) {
+    return FASTEMBED_STATUS_INVALID_TEXT;
+  }
+  return fastembed_generate(text, output, dimension) == 0
+             ? FASTEMBED_STATUS_OK
+             : FASTEMBED_STATUS_ERROR;
+}
+
+/** Thread pool task: embed texts [begin, end) */
+static void batch_generate_task(void *arg, int begin, int end, int worker) {
+  batch_generate_job_t *job = (batch_generate_job_t *)arg;
+  for (int i = begin; i < end; i++) {
+    int status =
+        batch_generate_item(job->texts[i], job->outputs[i], job->dimension);
+    if (job->statuses) {
+      job->statuses[i] = status;
+    }
+    if (status != FASTEMBED_STATUS_OK) {
+      job->failures[worker]++;
+    }
+  }
+}
+
+/**
+ * @brief Generate embeddings for many texts on the shared thread pool
+ *
+ * Unlike fastembed_batch_generate(), texts are spread over the pool threads
+ * and a failing text does not stop the batch: its status is recorded and
+ * the remaining texts are still embedded.
+ *
+ * @param texts Array of text strings (null-terminated) to embed
+ * @param num_texts Number of texts in the array
+ * @param outputs Array of output arrays (each pre-allocated, size >=
+ * dimension)
+ * @param dimension Embedding dimension (0 = 128)
+ * @param statuses Optional per-text fastembed_status_t output (may be NULL)
+ * @param num_threads Threads including the caller (0 = whole pool)
+ * @return Number of failed texts (0 = all succeeded), -1 on invalid
+ * arguments
+ */
+FASTEMBED_EXPORT int fastembed_batch_generate_parallel(const char **texts,
+                                                       int num_texts,
+                                                       float **outputs,
+                                                       int dimension,
+                                                       int *statuses,
+                                                       int num_threads) {
+  if (!texts || !outputs || num_texts <= 0 || num_threads < 0) {
+    return -1;
+  }
+
+  /* Use default dimension if 0 is specified */
+  if (dimension == 0) {
+    dimension = 128; /* Default dimension */
+  }
+  if (!is_valid_dimension(dimension)) {
+    return -1;
+  }
+
+  batch_generate_job_t job;
+  memset(&job, 0, sizeof(job));
+  job.texts = texts;
+  job.outputs = outputs;
+  job.dimension = dimension;
+  job.statuses = statuses;
+
+  int workers = thread_pool_workers(num_threads);
+  thread_pool_run(num_texts, FASTEMBED_BATCH_GRAIN, workers,
+                  batch_generate_task, &job);
+
+  int failures = 0;
+  for (int i = 0; i < workers; i++) {
+    failures += job.failures[i];
+  }
+  return failures;
+}
+
+/**
+ * @brief Check span i of an offsets array and find its bytes
+ *
+ * @return FASTEMBED_STATUS_OK with *text / *text_len set, or
+ * FASTEMBED_STATUS_INVALID_TEXT for a negative, decreasing, empty, too long
+ * or NUL-containing span
+ */
+static int contiguous_text_span(const char *text_data, const int32_t *offsets,
+                                int i, const char **text, size_t *text_len) {
+  int32_t begin = offsets[i];
+  int32_t end = offsets[i + 1];
+  if (begin < 0 || end <= begin || end - begin > FASTEMBED_MAX_TEXT_LENGTH) {
+    return FASTEMBED_STATUS_INVALID_TEXT;
+  }
+  *text = text_data + begin;
+  *text_len = (size_t)(end - begin);
+  if (memchr(*text, '\0', *text_len) != NULL) {
+    return FASTEMBED_STATUS_INVALID_TEXT;
+  }
+  return FASTEMBED_STATUS_OK;
+}
+
+/**
+ * @brief Allocate a 64-byte aligned row-major matrix
+ *
+ * Over-allocates and keeps the malloc() pointer just before the aligned
+ * block, so no platform-specific aligned allocator is needed.
+ *
+ * @param rows Number of rows
+ * @param dimension Floats per row
+ * @return Aligned zeroed matrix, or NULL on invalid size or allocation failure
+ */
+FASTEMBED_EXPORT float *fastembed_alloc_matrix(int rows, int dimension) {
+  if (rows <= 0 || dimension <= 0 ||
+      (size_t)rows > SIZE_MAX / sizeof(float) / (size_t)dimension) {
+    return NULL;
+  }
+  size_t bytes = (size_t)rows * (size_t)dimension * sizeof(float);
+  size_t extra = FASTEMBED_MATRIX_ALIGNMENT + sizeof(void *);
+  if (bytes > SIZE_MAX - extra) {
+    return NULL;
+  }
+
+  char *base = (char *)calloc(1, bytes + extra);
+  if (!base) {
+    return NULL;
+  }
+  uintptr_t start = (uintptr_t)(base + sizeof(void *));
+  uintptr_t aligned = (start + FASTEMBED_MATRIX_ALIGNMENT - 1) &
+                      ~(uintptr_t)(FASTEMBED_MATRIX_ALIGNMENT - 1);
+  ((void **)aligned)[-1] = base;
+  return (float *)aligned;
+}
+
+/**
+ * @brief Free a matrix from fastembed_alloc_matrix() (NULL is ignored)
+ */
+FASTEMBED_EXPORT void fastembed_free_matrix(float *matrix) {
+  if (matrix) {
+    free(((void **)matrix)[-1]);
+  }
+}
+
+/** Arguments shared by the fastembed_batch_generate_contiguous() tasks */
+typedef struct {
+  const char *text_data;
+  const int32_t *offsets;
+  float *output;
+  int dimension;
+  int *statuses;
+  int failures[FASTEMBED_THREAD_POOL_MAX_THREADS]; /* Per worker */
+} contiguous_generate_job_t;
+
+/** Thread pool task: embed spans [begin, end) into their output rows */
+static void contiguous_generate_task(void *arg, int begin, int end,
+                                     int worker) {
+  contiguous_generate_job_t *job = (contiguous_generate_job_t *)arg;
+  for (int i = begin; i < end; i++) {
+    float *row = job->output + (size_t)i * (size_t)job->dimension;
+    const char *text;
+    size_t text_len;
+    int status =
+        contiguous_text_span(job->text_data, job->offsets, i, &text, &text_len);
+    if (status == FASTEMBED_STATUS_OK &&
+        generate_text_span(text, text_len, row, job->dimension) != 0) {
+      status = FASTEMBED_STATUS_ERROR;
+    }
+    if (status != FASTEMBED_STATUS_OK) {
+      memset(row, 0, (size_t)job->dimension * sizeof(float));
+      job->failures[worker]++;
+    }
+    if (job->statuses) {
+      job->statuses[i] = status;
+    }
+  }
+}
+
+/**
+ * @brief Generate hash embeddings for concatenated texts into one matrix
+ *
+ * Text i is text_data[offsets[i], offsets[i + 1]) (Arrow string layout) and
+ * its embedding is row i of output. Spans are hashed in place, so there are
+ * no per-text allocations, copies into C strings or strlen() calls.
+ *
+ * @param text_data Concatenated UTF-8 texts (need not be null-terminated)
+ * @param offsets num_texts + 1 byte offsets into text_data
+ * @param num_texts Number of texts
+ * @param output Row-major float[num_texts * dimension]
+ * @param dimension Embedding dimension (0 = 128)
+ * @param statuses Optional per-text fastembed_status_t output (may be NULL)
+ * @param num_threads Threads including the caller (0 = whole pool)
+ * @return Number of failed texts (their rows are zeroed), -1 on invalid
+ * arguments
+ */
+FASTEMBED_EXPORT int fastembed_batch_generate_contiguous(
+    const char *text_data, const int32_t *offsets, int num_texts,
+    float *output, int dimension, int *statuses, int num_threads) {
+  if (!text_data || !offsets || !output || num_texts <= 0 ||
+      num_threads < 0) {
+    return -1;
+  }
+
+  /* Use default dimension if 0 is specified */
+  if (dimension == 0) {
+    dimension = 128; /* Default dimension */
+  }
+  if (!is_valid_dimension(dimension)) {
+    return -1;
+  }
+
+  contiguous_generate_job_t job;
+  memset(&job, 0, sizeof(job));
+  job.text_data = text_data;
+  job.offsets = offsets;
+  job.output = output;
+  job.dimension = dimension;
+  job.statuses = statuses;
+
+  int workers = thread_pool_workers(num_threads);
+  thread_pool_run(num_texts, FASTEMBED_BATCH_GRAIN, workers,
+                  contiguous_generate_task, &job);
+
+  int failures = 0;
+  for (int i = 0; i < workers; i++) {
+    failures += job.failures[i];
+  }
+  return failures;
 }
 
 /**
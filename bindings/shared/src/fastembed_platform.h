@@ -0,0 +1,294 @@
+/**
+ * @file fastembed_platform.h
+ * @brief Internal portability helpers (mutexes, condition variables, threads,
+ * thread-local storage, atomics, file mapping)
+ *
+ * Thin wrappers over pthreads (Linux/macOS) and Win32 primitives so library
+ * modules can share state between threads without depending on C11
+ * <threads.h>, which is missing on macOS and older MSVC.
+ *
+ * Internal header - not part of the public API.
+ */
+
+#ifndef FASTEMBED_PLATFORM_H
+#define FASTEMBED_PLATFORM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+/** Statically initializable mutex (SRW lock on Windows) */
+typedef SRWLOCK fastembed_mutex_t;
+#define FASTEMBED_MUTEX_INITIALIZER SRWLOCK_INIT
+
+static inline void fastembed_mutex_lock(fastembed_mutex_t *mutex) {
+  AcquireSRWLockExclusive(mutex);
+}
+
+static inline void fastembed_mutex_unlock(fastembed_mutex_t *mutex) {
+  ReleaseSRWLockExclusive(mutex);
+}
+
+/** Statically initializable condition variable (used with fastembed_mutex_t) */
+typedef CONDITION_VARIABLE fastembed_cond_t;
+#define FASTEMBED_COND_INITIALIZER CONDITION_VARIABLE_INIT
+
+static inline void fastembed_cond_wait(fastembed_cond_t *cond,
+                                       fastembed_mutex_t *mutex) {
+  SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+
+static inline void fastembed_cond_broadcast(fastembed_cond_t *cond) {
+  WakeAllConditionVariable(cond);
+}
+
+/** Thread-local storage class specifier */
+#define FASTEMBED_THREAD_LOCAL __declspec(thread)
+
+/** Thread handle and entry point (return 0 from the entry point) */
+typedef HANDLE fastembed_thread_t;
+typedef DWORD(WINAPI *fastembed_thread_fn)(LPVOID arg);
+#define FASTEMBED_THREAD_FUNC(name) static DWORD WINAPI name(LPVOID arg)
+
+/** Start a thread; returns 0 on success, -1 on failure */
+static inline int fastembed_thread_create(fastembed_thread_t *thread,
+                                          fastembed_thread_fn fn, void *arg) {
+  *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+  return *thread != NULL ? 0 : -1;
+}
+
+static inline void fastembed_thread_join(fastembed_thread_t thread) {
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+}
+
+/** Number of online logical CPUs (at least 1) */
+static inline int fastembed_cpu_count(void) {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+/** Read-only mapping of a whole file */
+typedef struct {
+  const void *data;
+  size_t size;
+  HANDLE file;
+  HANDLE mapping;
+} fastembed_file_map_t;
+
+/** Map a file read-only; returns 0 on success, -1 on failure or empty file */
+static inline int fastembed_map_file(const char *path,
+                                     fastembed_file_map_t *map) {
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+    CloseHandle(file);
+    return -1;
+  }
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    CloseHandle(file);
+    return -1;
+  }
+  const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == NULL) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return -1;
+  }
+  map->data = data;
+  map->size = (size_t)size.QuadPart;
+  map->file = file;
+  map->mapping = mapping;
+  return 0;
+}
+
+static inline void fastembed_unmap_file(fastembed_file_map_t *map) {
+  UnmapViewOfFile(map->data);
+  CloseHandle(map->mapping);
+  CloseHandle(map->file);
+}
+
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Statically initializable mutex (pthread mutex on POSIX) */
+typedef pthread_mutex_t fastembed_mutex_t;
+#define FASTEMBED_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+
+static inline void fastembed_mutex_lock(fastembed_mutex_t *mutex) {
+  pthread_mutex_lock(mutex);
+}
+
+static inline void fastembed_mutex_unlock(fastembed_mutex_t *mutex) {
+  pthread_mutex_unlock(mutex);
+}
+
+/** Statically initializable condition variable (used with fastembed_mutex_t) */
+typedef pthread_cond_t fastembed_cond_t;
+#define FASTEMBED_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+
+static inline void fastembed_cond_wait(fastembed_cond_t *cond,
+                                       fastembed_mutex_t *mutex) {
+  pthread_cond_wait(cond, mutex);
+}
+
+static inline void fastembed_cond_broadcast(fastembed_cond_t *cond) {
+  pthread_cond_broadcast(cond);
+}
+
+/** Thread-local storage class specifier */
+#define FASTEMBED_THREAD_LOCAL __thread
+
+/** Thread handle and entry point (return 0 from the entry point) */
+typedef pthread_t fastembed_thread_t;
+typedef void *(*fastembed_thread_fn)(void *arg);
+#define FASTEMBED_THREAD_FUNC(name) static void *name(void *arg)
+
+/** Start a thread; returns 0 on success, -1 on failure */
+static inline int fastembed_thread_create(fastembed_thread_t *thread,
+                                          fastembed_thread_fn fn, void *arg) {
+  return pthread_create(thread, NULL, fn, arg) == 0 ? 0 : -1;
+}
+
+static inline void fastembed_thread_join(fastembed_thread_t thread) {
+  pthread_join(thread, NULL);
+}
+
+/** Number of online logical CPUs (at least 1) */
+static inline int fastembed_cpu_count(void) {
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (int)count : 1;
+}
+
+/** Read-only mapping of a whole file */
+typedef struct {
+  const void *data;
+  size_t size;
+} fastembed_file_map_t;
+
+/** Map a file read-only; returns 0 on success, -1 on failure or empty file */
+static inline int fastembed_map_file(const char *path,
+                                     fastembed_file_map_t *map) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return -1;
+  }
+  void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); /* The mapping keeps the file open */
+  if (data == MAP_FAILED) {
+    return -1;
+  }
+  map->data = data;
+  map->size = (size_t)st.st_size;
+  return 0;
+}
+
+static inline void fastembed_unmap_file(fastembed_file_map_t *map) {
+  munmap((void *)map->data, map->size);
+}
+
+#endif /* _WIN32 */
+
+/*
+ * 32-bit atomic load (acquire) and store (release), for data written under a
+ * lock and read without one: a reader that loads a value also sees every
+ * write the writer made before storing it.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+static inline int32_t fastembed_atomic_load(const int32_t *ptr) {
+  return (int32_t)ReadAcquire((const volatile LONG *)ptr);
+}
+
+static inline void fastembed_atomic_store(int32_t *ptr, int32_t value) {
+  WriteRelease((volatile LONG *)ptr, (LONG)value);
+}
+#else
+static inline int32_t fastembed_atomic_load(const int32_t *ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void fastembed_atomic_store(int32_t *ptr, int32_t value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+#endif
+
+/*
+ * Relaxed 64-bit counter updates (statistics): atomic, but with no ordering
+ * against surrounding memory accesses.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+static inline int32_t fastembed_atomic_fetch_add(int32_t *ptr, int32_t value) {
+  return (int32_t)InterlockedExchangeAdd((volatile LONG *)ptr, (LONG)value);
+}
+
+static inline void fastembed_atomic_add64(uint64_t *ptr, uint64_t value) {
+  InterlockedExchangeAdd64((volatile LONG64 *)ptr, (LONG64)value);
+}
+
+static inline uint64_t fastembed_atomic_load64(const uint64_t *ptr) {
+  return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)ptr, 0, 0);
+}
+
+static inline void fastembed_atomic_store64(uint64_t *ptr, uint64_t value) {
+  InterlockedExchange64((volatile LONG64 *)ptr, (LONG64)value);
+}
+
+/** Raise *ptr to value if it is larger */
+static inline void fastembed_atomic_max64(uint64_t *ptr, uint64_t value) {
+  uint64_t current = fastembed_atomic_load64(ptr);
+  while (current < value) {
+    uint64_t seen = (uint64_t)InterlockedCompareExchange64(
+        (volatile LONG64 *)ptr, (LONG64)value, (LONG64)current);
+    if (seen == current)
+      break;
+    current = seen;
+  }
+}
+#else
+static inline int32_t fastembed_atomic_fetch_add(int32_t *ptr, int32_t value) {
+  return __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
+}
+
+static inline void fastembed_atomic_add64(uint64_t *ptr, uint64_t value) {
+  __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t fastembed_atomic_load64(const uint64_t *ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+}
+
+static inline void fastembed_atomic_store64(uint64_t *ptr, uint64_t value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+}
+
+/** Raise *ptr to value if it is larger */
+static inline void fastembed_atomic_max64(uint64_t *ptr, uint64_t value) {
+  uint64_t current = __atomic_load_n(ptr, __ATOMIC_RELAXED);
+  while (current < value &&
+         !__atomic_compare_exchange_n(ptr, &current, value, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+#endif
+
+#endif /* FASTEMBED_PLATFORM_H */
@@ -0,0 +1,339 @@
+/**
+ * @file fastembed_stats.c
+ * @brief Per-thread latency histograms and counters for ONNX calls
+ *
+ * Each thread records into one of FASTEMBED_STATS_THREAD_SLOTS slots
+ * (assigned round-robin on first use) with relaxed atomic adds, so
+ * recording takes no locks and threads with their own slot never share a
+ * cache line. Threads beyond the slot count share slots; the adds stay
+ * exact.
+ *
+ * Histograms are log-linear (HDR style): values below 8 get a bucket each,
+ * larger values 8 buckets per power of two up to 2^40 (about 18 minutes
+ * in nanoseconds), so any percentile is within 1/16 of the true value.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* clock_gettime() with -std=c11 */
+#endif
+
+#include <limits.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+#include "fastembed_platform.h"
+#include "fastembed_stats.h"
+
+#define STATS_SUB_BITS 3
+#define STATS_SUB_BUCKETS (1 << STATS_SUB_BITS)
+#define STATS_MAX_EXPONENT 40
+#define STATS_BUCKETS                                                          \
+  ((STATS_MAX_EXPONENT - STATS_SUB_BITS + 2) * STATS_SUB_BUCKETS)
+
+typedef struct {
+  uint64_t buckets[STATS_BUCKETS];
+  uint64_t sum;
+  uint64_t max;
+  uint64_t inverted_min; /* max of ~value, so min can use atomic max */
+} stats_histogram_t;
+
+/* Only uint64_t fields: fastembed_stats_reset() clears slots word by word */
+typedef struct {
+  stats_histogram_t stages[FASTEMBED_STAGE_COUNT];
+  stats_histogram_t batch_rows;
+  uint64_t texts;
+  uint64_t errors;
+  uint64_t tokens;
+  uint64_t padded_tokens;
+} stats_slot_t;
+
+static stats_slot_t g_slots[FASTEMBED_STATS_THREAD_SLOTS];
+static int32_t g_next_slot = 0;
+static int32_t g_stats_enabled = 1;
+static FASTEMBED_THREAD_LOCAL stats_slot_t *t_slot = NULL;
+
+static const char *const k_stage_names[FASTEMBED_STAGE_COUNT] = {
+    "resolve", "load", "tokenize", "bind", "run", "pool", "generate"};
+
+static stats_slot_t *stats_slot(void) {
+  if (t_slot == NULL) {
+    uint32_t slot = (uint32_t)fastembed_atomic_fetch_add(&g_next_slot, 1);
+    t_slot = &g_slots[slot % FASTEMBED_STATS_THREAD_SLOTS];
+  }
+  return t_slot;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Histograms                                                                */
+/* ------------------------------------------------------------------------ */
+
+/** Index of the highest set bit (value > 0) */
+static int stats_msb(uint64_t value) {
+  int bit = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if (value >> shift) {
+      value >>= shift;
+      bit += shift;
+    }
+  }
+  return bit;
+}
+
+static int stats_bucket(uint64_t value) {
+  if (value < STATS_SUB_BUCKETS) {
+    return (int)value;
+  }
+  int exponent = stats_msb(value);
+  if (exponent > STATS_MAX_EXPONENT) {
+    return STATS_BUCKETS - 1;
+  }
+  return (exponent - STATS_SUB_BITS + 1) * STATS_SUB_BUCKETS +
+         (int)((value >> (exponent - STATS_SUB_BITS)) &
+               (STATS_SUB_BUCKETS - 1));
+}
+
+/** Midpoint of a bucket's value range */
+static uint64_t stats_bucket_value(int bucket) {
+  if (bucket < STATS_SUB_BUCKETS) {
+    return (uint64_t)bucket;
+  }
+  int exponent = bucket / STATS_SUB_BUCKETS + STATS_SUB_BITS - 1;
+  uint64_t width = (uint64_t)1 << (exponent - STATS_SUB_BITS);
+  uint64_t low = (uint64_t)(STATS_SUB_BUCKETS + bucket % STATS_SUB_BUCKETS)
+                 << (exponent - STATS_SUB_BITS);
+  return low + width / 2;
+}
+
+static void stats_histogram_add(stats_histogram_t *histogram, uint64_t value) {
+  fastembed_atomic_max64(&histogram->max, value);
+  fastembed_atomic_max64(&histogram->inverted_min, ~value);
+  fastembed_atomic_add64(&histogram->sum, value);
+  fastembed_atomic_add64(&histogram->buckets[stats_bucket(value)], 1);
+}
+
+/** Merge one histogram of every slot and summarize it */
+static void stats_histogram_summary(const stats_histogram_t *slot_histograms,
+                                    size_t slot_stride,
+                                    fastembed_histogram_t *summary) {
+  uint64_t buckets[STATS_BUCKETS];
+  uint64_t inverted_min = 0;
+  memset(buckets, 0, sizeof(buckets));
+  memset(summary, 0, sizeof(*summary));
+
+  const char *base = (const char *)slot_histograms;
+  for (int s = 0; s < FASTEMBED_STATS_THREAD_SLOTS; s++) {
+    const stats_histogram_t *histogram =
+        (const stats_histogram_t *)(base + (size_t)s * slot_stride);
+    for (int b = 0; b < STATS_BUCKETS; b++) {
+      buckets[b] += fastembed_atomic_load64(&histogram->buckets[b]);
+    }
+    summary->sum += fastembed_atomic_load64(&histogram->sum);
+    uint64_t max = fastembed_atomic_load64(&histogram->max);
+    uint64_t slot_min = fastembed_atomic_load64(&histogram->inverted_min);
+    if (max > summary->max) {
+      summary->max = max;
+    }
+    if (slot_min > inverted_min) {
+      inverted_min = slot_min;
+    }
+  }
+  /* Count from the buckets so percentiles and count always agree */
+  for (int b = 0; b < STATS_BUCKETS; b++) {
+    summary->count += buckets[b];
+  }
+  if (summary->count == 0) {
+    return;
+  }
+  /* A sample still being recorded may not have updated min/max yet */
+  summary->min = ~inverted_min;
+  if (summary->min > summary->max) {
+    summary->min = summary->max;
+  }
+
+  static const uint64_t permille[4] = {500, 900, 990, 999};
+  uint64_t *out[4] = {&summary->p50, &summary->p90, &summary->p99,
+                      &summary->p999};
+  uint64_t seen = 0;
+  int b = 0;
+  for (int q = 0; q < 4; q++) {
+    uint64_t rank = (summary->count * permille[q] + 999) / 1000;
+    if (rank == 0) {
+      rank = 1;
+    }
+    while (b < STATS_BUCKETS - 1 && seen + buckets[b] < rank) {
+      seen += buckets[b];
+      b++;
+    }
+    uint64_t value = stats_bucket_value(b);
+    if (value < summary->min) {
+      value = summary->min;
+    }
+    if (value > summary->max) {
+      value = summary->max;
+    }
+    *out[q] = value;
+  }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Recording                                                                 */
+/* ------------------------------------------------------------------------ */
+
+uint64_t stats_now(void) {
+  if (!fastembed_atomic_load(&g_stats_enabled)) {
+    return 0;
+  }
+  uint64_t ns;
+#ifdef _WIN32
+  LARGE_INTEGER counter;
+  LARGE_INTEGER frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  uint64_t ticks = (uint64_t)counter.QuadPart;
+  uint64_t hz = (uint64_t)frequency.QuadPart;
+  ns = ticks / hz * 1000000000ULL + ticks % hz * 1000000000ULL / hz;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+  return ns ? ns : 1;
+}
+
+uint64_t stats_record_stage(int stage, uint64_t start) {
+  if (start == 0 || stage < 0 || stage >= FASTEMBED_STAGE_COUNT) {
+    return 0;
+  }
+  uint64_t end = stats_now();
+  if (end == 0) {
+    return 0;
+  }
+  stats_histogram_add(&stats_slot()->stages[stage],
+                      end > start ? end - start : 0);
+  return end;
+}
+
+void stats_record_batch(int rows, uint64_t tokens, uint64_t padded_tokens) {
+  if (!fastembed_atomic_load(&g_stats_enabled)) {
+    return;
+  }
+  stats_slot_t *slot = stats_slot();
+  stats_histogram_add(&slot->batch_rows, (uint64_t)rows);
+  fastembed_atomic_add64(&slot->tokens, tokens);
+  fastembed_atomic_add64(&slot->padded_tokens, padded_tokens);
+}
+
+void stats_record_texts(int texts, int failed) {
+  if (!fastembed_atomic_load(&g_stats_enabled)) {
+    return;
+  }
+  stats_slot_t *slot = stats_slot();
+  fastembed_atomic_add64(&slot->texts, (uint64_t)texts);
+  if (failed) {
+    fastembed_atomic_add64(&slot->errors, 1);
+  }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------ */
+
+FASTEMBED_EXPORT int fastembed_stats_snapshot(fastembed_stats_t *stats) {
+  if (!stats) {
+    return -1;
+  }
+  memset(stats, 0, sizeof(*stats));
+
+  for (int stage = 0; stage < FASTEMBED_STAGE_COUNT; stage++) {
+    stats_histogram_summary(&g_slots[0].stages[stage], sizeof(stats_slot_t),
+                            &stats->stages[stage]);
+  }
+  stats_histogram_summary(&g_slots[0].batch_rows, sizeof(stats_slot_t),
+                          &stats->batch_rows);
+  for (int s = 0; s < FASTEMBED_STATS_THREAD_SLOTS; s++) {
+    stats->texts += fastembed_atomic_load64(&g_slots[s].texts);
+    stats->errors += fastembed_atomic_load64(&g_slots[s].errors);
+    stats->tokens += fastembed_atomic_load64(&g_slots[s].tokens);
+    stats->padded_tokens += fastembed_atomic_load64(&g_slots[s].padded_tokens);
+  }
+  stats->enabled = fastembed_atomic_load(&g_stats_enabled);
+  return 0;
+}
+
+/** snprintf at buffer + *length, advancing *length by the full output */
+static void json_append(char *buffer, size_t size, size_t *length,
+                        const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  char *at = *length < size ? buffer + *length : NULL;
+  int written = vsnprintf(at, at ? size - *length : 0, format, args);
+  va_end(args);
+  if (written > 0) {
+    *length += (size_t)written;
+  }
+}
+
+static void json_histogram(char *buffer, size_t size, size_t *length,
+                           const char *name, const char *unit,
+                           const fastembed_histogram_t *h) {
+  json_append(buffer, size, length,
+              "\"%s\":{\"count\":%llu,\"sum%s\":%llu,\"min%s\":%llu,"
+              "\"max%s\":%llu,\"p50%s\":%llu,\"p90%s\":%llu,"
+              "\"p99%s\":%llu,\"p999%s\":%llu}",
+              name, (unsigned long long)h->count, unit,
+              (unsigned long long)h->sum, unit, (unsigned long long)h->min,
+              unit, (unsigned long long)h->max, unit,
+              (unsigned long long)h->p50, unit, (unsigned long long)h->p90,
+              unit, (unsigned long long)h->p99, unit,
+              (unsigned long long)h->p999);
+}
+
+FASTEMBED_EXPORT int fastembed_stats_snapshot_json(char *buffer, size_t size) {
+  if (!buffer && size > 0) {
+    return -1;
+  }
+  fastembed_stats_t stats;
+  fastembed_stats_snapshot(&stats);
+
+  size_t length = 0;
+  json_append(buffer, size, &length,
+              "{\"enabled\":%d,\"texts\":%llu,\"errors\":%llu,"
+              "\"tokens\":%llu,\"padded_tokens\":%llu,",
+              stats.enabled, (unsigned long long)stats.texts,
+              (unsigned long long)stats.errors,
+              (unsigned long long)stats.tokens,
+              (unsigned long long)stats.padded_tokens);
+  json_histogram(buffer, size, &length, "batch_rows", "", &stats.batch_rows);
+  json_append(buffer, size, &length, ",\"stages\":{");
+  for (int stage = 0; stage < FASTEMBED_STAGE_COUNT; stage++) {
+    if (stage > 0) {
+      json_append(buffer, size, &length, ",");
+    }
+    json_histogram(buffer, size, &length, k_stage_names[stage], "_ns",
+                   &stats.stages[stage]);
+  }
+  json_append(buffer, size, &length, "}}");
+
+  if (size > 0 && length >= size) {
+    buffer[size - 1] = '\0';
+  }
+  return length > INT_MAX ? -1 : (int)length;
+}
+
+FASTEMBED_EXPORT void fastembed_stats_reset(void) {
+  for (int s = 0; s < FASTEMBED_STATS_THREAD_SLOTS; s++) {
+    uint64_t *words = (uint64_t *)&g_slots[s];
+    for (size_t i = 0; i < sizeof(stats_slot_t) / sizeof(uint64_t); i++) {
+      fastembed_atomic_store64(&words[i], 0);
+    }
+  }
+}
+
+FASTEMBED_EXPORT void fastembed_stats_set_enabled(int enabled) {
+  fastembed_atomic_store(&g_stats_enabled, enabled != 0);
+}
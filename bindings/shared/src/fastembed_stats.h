@@ -0,0 +1,49 @@
+/**
+ * @file fastembed_stats.h
+ * @brief Hot-path instrumentation: per-stage latency histograms and counters
+ *
+ * Callers time a stage with stats_now() / stats_record_stage(); both are
+ * no-ops returning 0 while instrumentation is disabled, so a stage costs
+ * two clock reads and a few relaxed atomic adds into the calling thread's
+ * slot. fastembed_stats_snapshot() merges the slots.
+ *
+ * Internal header - not part of the public API.
+ */
+
+#ifndef FASTEMBED_STATS_H
+#define FASTEMBED_STATS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Monotonic timestamp in nanoseconds
+ *
+ * @return Timestamp (never 0), or 0 if instrumentation is disabled
+ */
+uint64_t stats_now(void);
+
+/**
+ * @brief Record a stage that started at start (from stats_now())
+ *
+ * @param stage fastembed_stage_t
+ * @param start Start timestamp; 0 records nothing
+ * @return End timestamp, usable as the start of the next stage (0 if
+ * nothing was recorded)
+ */
+uint64_t stats_record_stage(int stage, uint64_t start);
+
+/**
+ * @brief Record one inference call of rows sequences
+ *
+ * @param rows Batch size
+ * @param tokens Real tokens in the batch
+ * @param padded_tokens rows * padded sequence length
+ */
+void stats_record_batch(int rows, uint64_t tokens, uint64_t padded_tokens);
+
+/**
+ * @brief Record a generate batch of texts and whether it failed
+ */
+void stats_record_texts(int texts, int failed);
+
+#endif /* FASTEMBED_STATS_H */
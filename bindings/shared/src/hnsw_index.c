@@ -0,0 +1,1351 @@
+/**
+ * @file hnsw_index.c
+ * @brief Approximate nearest neighbour index (HNSW) over embedding vectors
+ *
+ * Hierarchical Navigable Small World graph (Malkov & Yashunin, 2016): every
+ * vector is a node on level 0 and, with probability 1/m per level, on the
+ * sparser levels above. Searches descend greedily from the top level and
+ * run a best-first search with ef candidates on level 0, so a query visits
+ * a few thousand nodes instead of the whole collection.
+ *
+ * Layout:
+ * - Each node is one fixed-size block: level, flags, squared norm, the
+ * level-0 neighbour list (count + 2 * m ids) and the vector
+ * - Blocks live in segments that double in size and are never moved, so a
+ * growing index never invalidates memory a concurrent search is reading
+ * - The saved file is a header, the node blocks back to back and the
+ * upper-level lists; fastembed_hnsw_load_mmap() points the segments into
+ * the mapped file without copying
+ *
+ * Concurrency:
+ * - Inserts take the index mutex only to allocate a node id and to raise
+ * the entry point; neighbour lists are updated under striped mutexes, one
+ * at a time, so inserts on different parts of the graph run in parallel
+ * - Searches take no locks: list counts and ids are written with release
+ * stores and read with acquire loads, so every id a search reads refers to
+ * a fully written node
+ *
+ * Distances go through fastembed_dot_product(): cosine vectors are
+ * normalized when added (cosine = dot), Euclidean uses ||a||^2 + ||b||^2 -
+ * 2 a.b with the norm stored in the node.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+#include "fastembed_platform.h"
+#include "thread_pool.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HNSW_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define HNSW_PREFETCH(ptr) ((void)0)
+#endif
+
+/** File format */
+#define HNSW_MAGIC "FEHNSW1"
+#define HNSW_VERSION 1
+#define HNSW_BYTE_ORDER_MARK 0x01020304u
+#define HNSW_NODES_OFFSET 128
+
+/** Segment s holds (1 << (s + HNSW_FIRST_SEGMENT_SHIFT)) nodes */
+#define HNSW_FIRST_SEGMENT_SHIFT 10
+#define HNSW_MAX_SEGMENTS (32 - HNSW_FIRST_SEGMENT_SHIFT)
+#define HNSW_MAX_NODES (INT32_MAX - (1 << HNSW_FIRST_SEGMENT_SHIFT))
+
+/** Highest node level (reached with probability m^-16) */
+#define HNSW_MAX_LEVEL 16
+
+/** Mutexes guarding neighbour lists (node id modulo the stripe count) */
+#define HNSW_LOCK_STRIPES 1024
+
+/** Fewest vectors per thread in fastembed_hnsw_add_batch() */
+#define HNSW_MIN_VECTORS_PER_THREAD 256
+
+/** Vectors inserted per pool work item in fastembed_hnsw_add_batch() */
+#define HNSW_ADD_GRAIN 16
+
+/** Node block fields (int32 slots); the level-0 list starts at LINKS */
+#define HNSW_NODE_LEVEL 0
+#define HNSW_NODE_FLAGS 1
+#define HNSW_NODE_SQ_NORM 2
+#define HNSW_NODE_LINKS 3
+
+#define HNSW_FLAG_DELETED 1
+
+/**
+ * @brief On-disk header (native byte order, padded to HNSW_NODES_OFFSET)
+ */
+typedef struct {
+  char magic[8];
+  uint32_t byte_order;
+  uint32_t version;
+  uint32_t dimension;
+  uint32_t metric;
+  uint32_t m;
+  uint32_t ef_construction;
+  uint32_t ef_search;
+  uint32_t node_bytes;
+  int32_t count;
+  int32_t entry_point;
+  uint64_t rng_state;
+  uint64_t upper_offset; /* Byte offset of the upper-level lists */
+  uint64_t file_bytes;
+} hnsw_file_header_t;
+
+typedef struct {
+  float distance;
+  int32_t id;
+} hnsw_candidate_t;
+
+/**
+ * @brief Per-search scratch memory, pooled per index
+ */
+typedef struct hnsw_search_context {
+  /* Visited marks: node v was visited in this search if visited[v] == epoch */
+  uint16_t *visited;
+  size_t visited_capacity;
+  uint16_t epoch;
+  hnsw_candidate_t *candidates; /* Min-heap of nodes to expand */
+  int candidates_capacity;
+  hnsw_candidate_t *results; /* Max-heap of the ef closest nodes */
+  int results_capacity;
+  int num_results;
+  float *query; /* Normalized copy of the query (cosine) */
+  struct hnsw_search_context *next;
+} hnsw_search_context_t;
+
+struct fastembed_hnsw {
+  int dimension;
+  int metric;
+  int m;  /* Neighbours per node on levels >= 1 */
+  int m0; /* Neighbours per node on level 0 */
+  int ef_construction;
+  int32_t ef_search; /* Atomic */
+  double level_mult;
+  size_t node_bytes;
+  int vector_slot; /* int32 offset of the vector in a node block */
+
+  /* Written under mutex with atomic stores */
+  int32_t count; /* Node ids allocated */
+  int32_t live_count;
+  int32_t entry_point; /* -1 when empty */
+  uint64_t rng_state;
+  fastembed_mutex_t mutex;
+
+  unsigned char *segment_nodes[HNSW_MAX_SEGMENTS];
+  int32_t **segment_upper[HNSW_MAX_SEGMENTS]; /* Upper lists per node */
+  fastembed_mutex_t link_locks[HNSW_LOCK_STRIPES];
+
+  fastembed_mutex_t pool_mutex;
+  hnsw_search_context_t *idle_contexts;
+
+  /* Set for fastembed_hnsw_load_mmap() indexes (read-only) */
+  int mapped;
+  fastembed_file_map_t map;
+};
+
+/* ------------------------------------------------------------------------ */
+/* Node access                                                               */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief Segment holding a node id, and the node's offset in it
+ */
+static inline int hnsw_segment_of(int32_t id, uint32_t *offset) {
+  uint32_t x = (uint32_t)id + (1u << HNSW_FIRST_SEGMENT_SHIFT);
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long high;
+  _BitScanReverse(&high, x);
+#else
+  int high = 31 - __builtin_clz(x);
+#endif
+  *offset = x - (1u << high);
+  return (int)high - HNSW_FIRST_SEGMENT_SHIFT;
+}
+
+/** First node id of a segment */
+static inline int32_t hnsw_segment_start(int segment) {
+  return (int32_t)((1u << (segment + HNSW_FIRST_SEGMENT_SHIFT)) -
+                   (1u << HNSW_FIRST_SEGMENT_SHIFT));
+}
+
+/** Number of nodes in a segment */
+static inline int32_t hnsw_segment_size(int segment) {
+  return (int32_t)(1u << (segment + HNSW_FIRST_SEGMENT_SHIFT));
+}
+
+static inline int32_t *hnsw_node(const fastembed_hnsw_t *index, int32_t id) {
+  uint32_t offset;
+  int segment = hnsw_segment_of(id, &offset);
+  return (int32_t *)(index->segment_nodes[segment] +
+                     (size_t)offset * index->node_bytes);
+}
+
+static inline const float *hnsw_vector(const fastembed_hnsw_t *index,
+                                       const int32_t *node) {
+  return (const float *)(node + index->vector_slot);
+}
+
+static inline float hnsw_sq_norm(const int32_t *node) {
+  return ((const float *)node)[HNSW_NODE_SQ_NORM];
+}
+
+static inline int hnsw_is_deleted(const int32_t *node) {
+  return (fastembed_atomic_load(&node[HNSW_NODE_FLAGS]) & HNSW_FLAG_DELETED) !=
+         0;
+}
+
+/**
+ * @brief Neighbour list of a node on a level: count followed by the ids
+ */
+static inline int32_t *hnsw_links(const fastembed_hnsw_t *index, int32_t id,
+                                  int level) {
+  if (level == 0) {
+    return hnsw_node(index, id) + HNSW_NODE_LINKS;
+  }
+  uint32_t offset;
+  int segment = hnsw_segment_of(id, &offset);
+  return index->segment_upper[segment][offset] +
+         (size_t)(level - 1) * (index->m + 1);
+}
+
+static inline int hnsw_max_links(const fastembed_hnsw_t *index, int level) {
+  return level == 0 ? index->m0 : index->m;
+}
+
+static inline fastembed_mutex_t *hnsw_link_lock(fastembed_hnsw_t *index,
+                                                int32_t id) {
+  return &index->link_locks[(uint32_t)id & (HNSW_LOCK_STRIPES - 1)];
+}
+
+/**
+ * @brief Distance from a (prepared) query to a node; smaller is closer
+ *
+ * Negated dot product for cosine / dot, squared L2 for Euclidean.
+ */
+static inline float hnsw_distance(const fastembed_hnsw_t *index,
+                                  const float *query, float query_sq,
+                                  const int32_t *node) {
+  float dot =
+      fastembed_dot_product(query, hnsw_vector(index, node), index->dimension);
+  if (index->metric == FASTEMBED_METRIC_EUCLIDEAN) {
+    return query_sq + hnsw_sq_norm(node) - 2.0f * dot;
+  }
+  return -dot;
+}
+
+/** Reported score for a distance (similarity, or L2 distance) */
+static inline float hnsw_score(const fastembed_hnsw_t *index, float distance) {
+  if (index->metric == FASTEMBED_METRIC_EUCLIDEAN) {
+    return distance > 0.0f ? sqrtf(distance) : 0.0f;
+  }
+  return -distance;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Heaps and scratch memory                                                  */
+/* ------------------------------------------------------------------------ */
+
+/** Total order: closer first, then lower id */
+static inline int hnsw_before(hnsw_candidate_t a, hnsw_candidate_t b) {
+  return a.distance < b.distance ||
+         (a.distance == b.distance && a.id < b.id);
+}
+
+/** Heap order: min-heap keeps the closest on top, max-heap the farthest */
+static inline int hnsw_heap_above(hnsw_candidate_t a, hnsw_candidate_t b,
+                                  int max_heap) {
+  return max_heap ? hnsw_before(b, a) : hnsw_before(a, b);
+}
+
+static void hnsw_heap_push(hnsw_candidate_t *heap, int *size,
+                           hnsw_candidate_t item, int max_heap) {
+  int pos = (*size)++;
+  while (pos > 0) {
+    int parent = (pos - 1) / 2;
+    if (!hnsw_heap_above(item, heap[parent], max_heap)) {
+      break;
+    }
+    heap[pos] = heap[parent];
+    pos = parent;
+  }
+  heap[pos] = item;
+}
+
+static hnsw_candidate_t hnsw_heap_pop(hnsw_candidate_t *heap, int *size,
+                                      int max_heap) {
+  hnsw_candidate_t top = heap[0];
+  hnsw_candidate_t last = heap[--(*size)];
+  int pos = 0;
+  for (;;) {
+    int child = 2 * pos + 1;
+    if (child >= *size) {
+      break;
+    }
+    if (child + 1 < *size &&
+        hnsw_heap_above(heap[child + 1], heap[child], max_heap)) {
+      child++;
+    }
+    if (!hnsw_heap_above(heap[child], last, max_heap)) {
+      break;
+    }
+    heap[pos] = heap[child];
+    pos = child;
+  }
+  if (*size > 0) {
+    heap[pos] = last;
+  }
+  return top;
+}
+
+static int hnsw_compare_candidates(const void *a, const void *b) {
+  hnsw_candidate_t x = *(const hnsw_candidate_t *)a;
+  hnsw_candidate_t y = *(const hnsw_candidate_t *)b;
+  return hnsw_before(x, y) ? -1 : (hnsw_before(y, x) ? 1 : 0);
+}
+
+/**
+ * @brief Grow a candidate array to at least needed entries
+ * @return 0 on success, -1 on allocation failure
+ */
+static int hnsw_reserve(hnsw_candidate_t **array, int *capacity, int needed) {
+  if (needed <= *capacity) {
+    return 0;
+  }
+  int new_capacity = *capacity > 0 ? *capacity : 64;
+  while (new_capacity < needed) {
+    new_capacity *= 2;
+  }
+  hnsw_candidate_t *grown = (hnsw_candidate_t *)realloc(
+      *array, (size_t)new_capacity * sizeof(hnsw_candidate_t));
+  if (!grown) {
+    return -1;
+  }
+  *array = grown;
+  *capacity = new_capacity;
+  return 0;
+}
+
+/**
+ * @brief Grow the visited marks to cover node ids below needed
+ */
+static int hnsw_reserve_visited(hnsw_search_context_t *ctx, size_t needed) {
+  if (needed <= ctx->visited_capacity) {
+    return 0;
+  }
+  size_t new_capacity = ctx->visited_capacity * 2;
+  if (new_capacity < needed) {
+    new_capacity = needed;
+  }
+  uint16_t *grown =
+      (uint16_t *)realloc(ctx->visited, new_capacity * sizeof(uint16_t));
+  if (!grown) {
+    return -1;
+  }
+  memset(grown + ctx->visited_capacity, 0,
+         (new_capacity - ctx->visited_capacity) * sizeof(uint16_t));
+  ctx->visited = grown;
+  ctx->visited_capacity = new_capacity;
+  return 0;
+}
+
+static hnsw_search_context_t *hnsw_acquire_context(fastembed_hnsw_t *index) {
+  fastembed_mutex_lock(&index->pool_mutex);
+  hnsw_search_context_t *ctx = index->idle_contexts;
+  if (ctx) {
+    index->idle_contexts = ctx->next;
+  }
+  fastembed_mutex_unlock(&index->pool_mutex);
+
+  if (!ctx) {
+    ctx = (hnsw_search_context_t *)calloc(1, sizeof(hnsw_search_context_t));
+    if (ctx) {
+      ctx->query = (float *)malloc((size_t)index->dimension * sizeof(float));
+      if (!ctx->query) {
+        free(ctx);
+        ctx = NULL;
+      }
+    }
+  }
+  return ctx;
+}
+
+static void hnsw_release_context(fastembed_hnsw_t *index,
+                                 hnsw_search_context_t *ctx) {
+  fastembed_mutex_lock(&index->pool_mutex);
+  ctx->next = index->idle_contexts;
+  index->idle_contexts = ctx;
+  fastembed_mutex_unlock(&index->pool_mutex);
+}
+
+static void hnsw_free_context(hnsw_search_context_t *ctx) {
+  free(ctx->visited);
+  free(ctx->candidates);
+  free(ctx->results);
+  free(ctx->query);
+  free(ctx);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Graph search                                                              */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief Greedy walk towards the query on levels top_level .. stop_level + 1
+ *
+ * @return Closest node found on level stop_level + 1
+ */
+static int32_t hnsw_greedy_descent(const fastembed_hnsw_t *index,
+                                   const float *query, float query_sq,
+                                   int32_t entry, int top_level,
+                                   int stop_level) {
+  float best = hnsw_distance(index, query, query_sq, hnsw_node(index, entry));
+
+  for (int level = top_level; level > stop_level; level--) {
+    int max_links = hnsw_max_links(index, level);
+    int changed = 1;
+    while (changed) {
+      changed = 0;
+      const int32_t *links = hnsw_links(index, entry, level);
+      int count = fastembed_atomic_load(&links[0]);
+      if (count > max_links) {
+        count = max_links;
+      }
+      for (int i = 0; i < count; i++) {
+        int32_t neighbour = fastembed_atomic_load(&links[1 + i]);
+        float distance = hnsw_distance(index, query, query_sq,
+                                       hnsw_node(index, neighbour));
+        if (distance < best) {
+          best = distance;
+          entry = neighbour;
+          changed = 1;
+        }
+      }
+    }
+  }
+  return entry;
+}
+
+/**
+ * @brief Best-first search of one level (algorithm 2 of the HNSW paper)
+ *
+ * Leaves the ef closest nodes found in ctx->results, a max-heap of
+ * ctx->num_results entries. Deleted nodes are still expanded but, with
+ * skip_deleted, not returned.
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+static int hnsw_search_level(const fastembed_hnsw_t *index,
+                             hnsw_search_context_t *ctx, const float *query,
+                             float query_sq, int32_t entry, int ef, int level,
+                             int skip_deleted) {
+  if (hnsw_reserve_visited(
+          ctx, (size_t)fastembed_atomic_load(&index->count)) != 0 ||
+      hnsw_reserve(&ctx->results, &ctx->results_capacity, ef + 1) != 0 ||
+      hnsw_reserve(&ctx->candidates, &ctx->candidates_capacity, ef + 1) !=
+          0) {
+    return -1;
+  }
+  if (++ctx->epoch == 0) {
+    memset(ctx->visited, 0, ctx->visited_capacity * sizeof(uint16_t));
+    ctx->epoch = 1;
+  }
+
+  const int max_links = hnsw_max_links(index, level);
+  int num_candidates = 0;
+  int num_results = 0;
+
+  const int32_t *entry_node = hnsw_node(index, entry);
+  hnsw_candidate_t start = {hnsw_distance(index, query, query_sq, entry_node),
+                            entry};
+  ctx->visited[entry] = ctx->epoch;
+  hnsw_heap_push(ctx->candidates, &num_candidates, start, 0);
+  if (!skip_deleted || !hnsw_is_deleted(entry_node)) {
+    hnsw_heap_push(ctx->results, &num_results, start, 1);
+  }
+
+  while (num_candidates > 0) {
+    hnsw_candidate_t current = ctx->candidates[0];
+    if (num_results >= ef && current.distance > ctx->results[0].distance) {
+      break; /* Every remaining candidate is farther than the ef-th result */
+    }
+    hnsw_heap_pop(ctx->candidates, &num_candidates, 0);
+
+    const int32_t *links = hnsw_links(index, current.id, level);
+    int count = fastembed_atomic_load(&links[0]);
+    if (count > max_links) {
+      count = max_links;
+    }
+    for (int i = 0; i < count; i++) {
+      int32_t neighbour = fastembed_atomic_load(&links[1 + i]);
+      if (i + 1 < count) {
+        HNSW_PREFETCH(hnsw_node(index, fastembed_atomic_load(&links[2 + i])));
+      }
+      if ((size_t)neighbour >= ctx->visited_capacity &&
+          hnsw_reserve_visited(ctx, (size_t)neighbour + 1) != 0) {
+        return -1; /* Node added after this search started */
+      }
+      if (ctx->visited[neighbour] == ctx->epoch) {
+        continue;
+      }
+      ctx->visited[neighbour] = ctx->epoch;
+
+      const int32_t *node = hnsw_node(index, neighbour);
+      float distance = hnsw_distance(index, query, query_sq, node);
+      if (num_results < ef || distance < ctx->results[0].distance) {
+        hnsw_candidate_t item = {distance, neighbour};
+        if (hnsw_reserve(&ctx->candidates, &ctx->candidates_capacity,
+                         num_candidates + 1) != 0) {
+          return -1;
+        }
+        hnsw_heap_push(ctx->candidates, &num_candidates, item, 0);
+        if (!skip_deleted || !hnsw_is_deleted(node)) {
+          hnsw_heap_push(ctx->results, &num_results, item, 1);
+          if (num_results > ef) {
+            hnsw_heap_pop(ctx->results, &num_results, 1);
+          }
+        }
+      }
+    }
+  }
+
+  ctx->num_results = num_results;
+  return 0;
+}
+
+/**
+ * @brief Pick diverse neighbours (heuristic of algorithm 4 of the paper)
+ *
+ * Sorts candidates by distance to the base node and keeps a candidate only
+ * if it is closer to the base than to every neighbour already kept, so
+ * links spread out in different directions instead of into one cluster.
+ * The kept candidates are moved to the front of the array.
+ *
+ * @return Number of neighbours kept (at most max_neighbours)
+ */
+static int hnsw_select_neighbours(const fastembed_hnsw_t *index,
+                                  hnsw_candidate_t *candidates,
+                                  int num_candidates, int max_neighbours) {
+  qsort(candidates, (size_t)num_candidates, sizeof(hnsw_candidate_t),
+        hnsw_compare_candidates);
+
+  int selected = 0;
+  for (int i = 0; i < num_candidates && selected < max_neighbours; i++) {
+    const int32_t *node = hnsw_node(index, candidates[i].id);
+    const float *vector = hnsw_vector(index, node);
+    float sq_norm = hnsw_sq_norm(node);
+
+    int keep = 1;
+    for (int j = 0; j < selected; j++) {
+      if (hnsw_distance(index, vector, sq_norm,
+                        hnsw_node(index, candidates[j].id)) <
+          candidates[i].distance) {
+        keep = 0;
+        break;
+      }
+    }
+    if (keep) {
+      candidates[selected++] = candidates[i];
+    }
+  }
+  return selected;
+}
+
+/**
+ * @brief Replace a neighbour list (caller holds the node's link lock)
+ */
+static void hnsw_write_links(int32_t *links, const hnsw_candidate_t *items,
+                             int count) {
+  for (int i = 0; i < count; i++) {
+    fastembed_atomic_store(&links[1 + i], items[i].id);
+  }
+  fastembed_atomic_store(&links[0], count);
+}
+
+/**
+ * @brief Add a link from node to new_id on a level, pruning a full list
+ */
+static void hnsw_connect(fastembed_hnsw_t *index, int32_t node,
+                         int32_t new_id, int level) {
+  const int max_links = hnsw_max_links(index, level);
+  fastembed_mutex_t *lock = hnsw_link_lock(index, node);
+
+  fastembed_mutex_lock(lock);
+  int32_t *links = hnsw_links(index, node, level);
+  int count = links[0];
+
+  if (count < max_links) {
+    fastembed_atomic_store(&links[1 + count], new_id);
+    fastembed_atomic_store(&links[0], count + 1);
+  } else {
+    hnsw_candidate_t pruned[2 * FASTEMBED_HNSW_MAX_M + 1];
+    const int32_t *base = hnsw_node(index, node);
+    const float *vector = hnsw_vector(index, base);
+    float sq_norm = hnsw_sq_norm(base);
+
+    for (int i = 0; i < count; i++) {
+      pruned[i].id = links[1 + i];
+      pruned[i].distance = hnsw_distance(index, vector, sq_norm,
+                                         hnsw_node(index, pruned[i].id));
+    }
+    pruned[count].id = new_id;
+    pruned[count].distance =
+        hnsw_distance(index, vector, sq_norm, hnsw_node(index, new_id));
+
+    int kept = hnsw_select_neighbours(index, pruned, count + 1, max_links);
+    hnsw_write_links(links, pruned, kept);
+  }
+  fastembed_mutex_unlock(lock);
+}
+
+/**
+ * @brief Draw a node level: floor(-ln(U) * level_mult), U in (0, 1]
+ *
+ * Called with index->mutex held.
+ */
+static int hnsw_random_level(fastembed_hnsw_t *index) {
+  /* xorshift64* */
+  uint64_t x = index->rng_state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  index->rng_state = x;
+  uint64_t bits = (x * 0x2545F4914F6CDD1DULL) >> 11;
+  double uniform = ((double)bits + 1.0) / 9007199254740992.0;
+
+  int level = (int)(-log(uniform) * index->level_mult);
+  return level > HNSW_MAX_LEVEL ? HNSW_MAX_LEVEL : level;
+}
+
+/**
+ * @brief Allocate and initialize a node (id, segment, upper lists)
+ *
+ * Only the vector is written by the caller afterwards; the node is not
+ * linked into the graph yet.
+ *
+ * @return New node id, or -1 if the index is full or allocation fails
+ */
+static int32_t hnsw_allocate_node(fastembed_hnsw_t *index) {
+  fastembed_mutex_lock(&index->mutex);
+
+  int32_t id = index->count;
+  if (id >= HNSW_MAX_NODES) {
+    fastembed_mutex_unlock(&index->mutex);
+    return -1;
+  }
+
+  uint32_t offset;
+  int segment = hnsw_segment_of(id, &offset);
+  if (offset == 0 && index->segment_nodes[segment] == NULL) {
+    size_t nodes = (size_t)hnsw_segment_size(segment);
+    index->segment_nodes[segment] =
+        (unsigned char *)malloc(nodes * index->node_bytes);
+    index->segment_upper[segment] =
+        (int32_t **)calloc(nodes, sizeof(int32_t *));
+    if (!index->segment_nodes[segment] || !index->segment_upper[segment]) {
+      free(index->segment_nodes[segment]);
+      free(index->segment_upper[segment]);
+      index->segment_nodes[segment] = NULL;
+      index->segment_upper[segment] = NULL;
+      fastembed_mutex_unlock(&index->mutex);
+      return -1;
+    }
+  }
+
+  int level = hnsw_random_level(index);
+  if (level > 0) {
+    int32_t *upper = (int32_t *)calloc((size_t)level * (index->m + 1),
+                                       sizeof(int32_t));
+    if (!upper) {
+      fastembed_mutex_unlock(&index->mutex);
+      return -1;
+    }
+    index->segment_upper[segment][offset] = upper;
+  } else {
+    index->segment_upper[segment][offset] = NULL;
+  }
+
+  int32_t *node = hnsw_node(index, id);
+  node[HNSW_NODE_LEVEL] = level;
+  node[HNSW_NODE_FLAGS] = 0;
+  node[HNSW_NODE_LINKS] = 0;
+
+  fastembed_atomic_store(&index->count, id + 1);
+  fastembed_atomic_store(&index->live_count, index->live_count + 1);
+  fastembed_mutex_unlock(&index->mutex);
+  return id;
+}
+
+/**
+ * @brief Insert one vector (algorithm 1 of the HNSW paper)
+ *
+ * @return New node id, or -1 on error
+ */
+static int32_t hnsw_insert(fastembed_hnsw_t *index, hnsw_search_context_t *ctx,
+                           const float *vector) {
+  int32_t id = hnsw_allocate_node(index);
+  if (id < 0) {
+    return -1;
+  }
+
+  int32_t *node = hnsw_node(index, id);
+  float *stored = (float *)(node + index->vector_slot);
+  memcpy(stored, vector, (size_t)index->dimension * sizeof(float));
+  if (index->metric == FASTEMBED_METRIC_COSINE) {
+    fastembed_normalize(stored, index->dimension);
+  }
+  ((float *)node)[HNSW_NODE_SQ_NORM] =
+      index->metric == FASTEMBED_METRIC_EUCLIDEAN
+          ? fastembed_dot_product(stored, stored, index->dimension)
+          : 0.0f;
+  const float sq_norm = hnsw_sq_norm(node);
+  const int level = node[HNSW_NODE_LEVEL];
+
+  fastembed_mutex_lock(&index->mutex);
+  int32_t entry = index->entry_point;
+  if (entry < 0) {
+    fastembed_atomic_store(&index->entry_point, id);
+    fastembed_mutex_unlock(&index->mutex);
+    return id;
+  }
+  fastembed_mutex_unlock(&index->mutex);
+
+  const int entry_level = hnsw_node(index, entry)[HNSW_NODE_LEVEL];
+  if (level < entry_level) {
+    entry = hnsw_greedy_descent(index, stored, sq_norm, entry, entry_level,
+                                level);
+  }
+
+  for (int l = level < entry_level ? level : entry_level; l >= 0; l--) {
+    if (hnsw_search_level(index, ctx, stored, sq_norm, entry,
+                          index->ef_construction, l, 0) != 0) {
+      return -1;
+    }
+
+    /* Reuse the candidate heap as the selection buffer; a concurrent insert
+     * may already have linked this node, so drop it from its own results */
+    hnsw_candidate_t *selected = ctx->candidates;
+    int num_selected = 0;
+    for (int i = 0; i < ctx->num_results; i++) {
+      if (ctx->results[i].id != id) {
+        selected[num_selected++] = ctx->results[i];
+      }
+    }
+    if (num_selected == 0) {
+      continue;
+    }
+    num_selected =
+        hnsw_select_neighbours(index, selected, num_selected, index->m);
+    entry = selected[0].id; /* Closest node starts the next level */
+
+    fastembed_mutex_t *lock = hnsw_link_lock(index, id);
+    fastembed_mutex_lock(lock);
+    hnsw_write_links(hnsw_links(index, id, l), selected, num_selected);
+    fastembed_mutex_unlock(lock);
+
+    for (int i = 0; i < num_selected; i++) {
+      hnsw_connect(index, selected[i].id, id, l);
+    }
+  }
+
+  if (level > entry_level) {
+    fastembed_mutex_lock(&index->mutex);
+    if (level > hnsw_node(index, index->entry_point)[HNSW_NODE_LEVEL]) {
+      fastembed_atomic_store(&index->entry_point, id);
+    }
+    fastembed_mutex_unlock(&index->mutex);
+  }
+  return id;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Index lifetime                                                            */
+/* ------------------------------------------------------------------------ */
+
+FASTEMBED_EXPORT void
+fastembed_hnsw_options_init(fastembed_hnsw_options_t *options) {
+  if (!options) {
+    return;
+  }
+  memset(options, 0, sizeof(*options));
+  options->m = FASTEMBED_HNSW_DEFAULT_M;
+  options->ef_construction = FASTEMBED_HNSW_DEFAULT_EF_CONSTRUCTION;
+  options->ef_search = FASTEMBED_HNSW_DEFAULT_EF_SEARCH;
+  options->metric = FASTEMBED_METRIC_COSINE;
+  options->seed = 0;
+}
+
+/**
+ * @brief Allocate an empty index with the given parameters
+ */
+static fastembed_hnsw_t *hnsw_alloc(int dimension, int metric, int m,
+                                    int ef_construction, int ef_search) {
+  fastembed_hnsw_t *index =
+      (fastembed_hnsw_t *)calloc(1, sizeof(fastembed_hnsw_t));
+  if (!index) {
+    return NULL;
+  }
+
+  index->dimension = dimension;
+  index->metric = metric;
+  index->m = m;
+  index->m0 = 2 * m;
+  index->ef_construction = ef_construction < m ? m : ef_construction;
+  index->ef_search = ef_search;
+  index->level_mult = 1.0 / log((double)m);
+  index->vector_slot = HNSW_NODE_LINKS + 1 + index->m0;
+  index->node_bytes = ((size_t)index->vector_slot + dimension) * sizeof(int32_t);
+  index->entry_point = -1;
+
+  fastembed_mutex_t mutex_init = FASTEMBED_MUTEX_INITIALIZER;
+  index->mutex = mutex_init;
+  index->pool_mutex = mutex_init;
+  for (int i = 0; i < HNSW_LOCK_STRIPES; i++) {
+    index->link_locks[i] = mutex_init;
+  }
+  return index;
+}
+
+FASTEMBED_EXPORT fastembed_hnsw_t *
+fastembed_hnsw_create(int dimension, const fastembed_hnsw_options_t *options) {
+  fastembed_hnsw_options_t defaults;
+  if (!options) {
+    fastembed_hnsw_options_init(&defaults);
+    options = &defaults;
+  }
+
+  if (dimension <= 0 || dimension > FASTEMBED_MAX_DIMENSION ||
+      options->m < 2 || options->m > FASTEMBED_HNSW_MAX_M ||
+      options->ef_construction <= 0 || options->ef_search <= 0) {
+    return NULL;
+  }
+  if (options->metric != FASTEMBED_METRIC_DOT &&
+      options->metric != FASTEMBED_METRIC_COSINE &&
+      options->metric != FASTEMBED_METRIC_EUCLIDEAN) {
+    return NULL;
+  }
+
+  fastembed_hnsw_t *index =
+      hnsw_alloc(dimension, options->metric, options->m,
+                 options->ef_construction, options->ef_search);
+  if (index) {
+    index->rng_state =
+        (((uint64_t)options->seed << 1) | 1) * 0x9E3779B97F4A7C15ULL;
+  }
+  return index;
+}
+
+FASTEMBED_EXPORT void fastembed_hnsw_free(fastembed_hnsw_t *index) {
+  if (!index) {
+    return;
+  }
+
+  while (index->idle_contexts) {
+    hnsw_search_context_t *next = index->idle_contexts->next;
+    hnsw_free_context(index->idle_contexts);
+    index->idle_contexts = next;
+  }
+
+  for (int s = 0; s < HNSW_MAX_SEGMENTS; s++) {
+    if (!index->mapped) {
+      int32_t start = hnsw_segment_start(s);
+      int32_t end = start + hnsw_segment_size(s);
+      if (end > index->count) {
+        end = index->count;
+      }
+      for (int32_t id = start; index->segment_upper[s] && id < end; id++) {
+        free(index->segment_upper[s][id - start]);
+      }
+      free(index->segment_nodes[s]);
+    }
+    free(index->segment_upper[s]);
+  }
+
+  if (index->mapped) {
+    fastembed_unmap_file(&index->map);
+  }
+  free(index);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Insert / remove / search                                                  */
+/* ------------------------------------------------------------------------ */
+
+FASTEMBED_EXPORT int fastembed_hnsw_add(fastembed_hnsw_t *index,
+                                        const float *vector) {
+  if (!index || !vector || index->mapped) {
+    return -1;
+  }
+
+  hnsw_search_context_t *ctx = hnsw_acquire_context(index);
+  if (!ctx) {
+    return -1;
+  }
+  int32_t id = hnsw_insert(index, ctx, vector);
+  hnsw_release_context(index, ctx);
+  return id;
+}
+
+/**
+ * @brief Shared state of one fastembed_hnsw_add_batch() call
+ */
+typedef struct {
+  fastembed_hnsw_t *index;
+  const float *vectors;
+  int *out_ids;
+  int failed[FASTEMBED_THREAD_POOL_MAX_THREADS]; /* Per pool worker */
+} hnsw_add_batch_t;
+
+/** thread_pool_task_fn: insert vectors [begin, end) */
+static void hnsw_add_range(void *arg, int begin, int end, int worker) {
+  hnsw_add_batch_t *batch = (hnsw_add_batch_t *)arg;
+  fastembed_hnsw_t *index = batch->index;
+  hnsw_search_context_t *ctx = hnsw_acquire_context(index);
+  if (!ctx) {
+    batch->failed[worker] = 1;
+    return;
+  }
+
+  for (int i = begin; i < end; i++) {
+    int32_t id = hnsw_insert(
+        index, ctx, batch->vectors + (size_t)i * index->dimension);
+    if (batch->out_ids) {
+      batch->out_ids[i] = id;
+    }
+    if (id < 0) {
+      batch->failed[worker] = 1;
+    }
+  }
+  hnsw_release_context(index, ctx);
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_add_batch(fastembed_hnsw_t *index,
+                                              const float *vectors,
+                                              int num_vectors, int *out_ids,
+                                              int num_threads) {
+  if (!index || !vectors || num_vectors <= 0 || index->mapped) {
+    return -1;
+  }
+
+  /* Only start the shared pool when more than one thread is worthwhile */
+  int workers = 1;
+  int by_size = num_vectors / HNSW_MIN_VECTORS_PER_THREAD;
+  if (num_threads != 1 && by_size > 1) {
+    workers = thread_pool_workers(num_threads);
+    if (workers > by_size) {
+      workers = by_size;
+    }
+  }
+
+  hnsw_add_batch_t batch = {index, vectors, out_ids, {0}};
+  thread_pool_run(num_vectors, HNSW_ADD_GRAIN, workers, hnsw_add_range,
+                  &batch);
+
+  for (int w = 0; w < workers; w++) {
+    if (batch.failed[w]) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_remove(fastembed_hnsw_t *index, int id) {
+  if (!index || index->mapped) {
+    return -1;
+  }
+
+  fastembed_mutex_lock(&index->mutex);
+  if (id < 0 || id >= index->count) {
+    fastembed_mutex_unlock(&index->mutex);
+    return -1;
+  }
+  int32_t *node = hnsw_node(index, id);
+  int32_t flags = node[HNSW_NODE_FLAGS];
+  if (flags & HNSW_FLAG_DELETED) {
+    fastembed_mutex_unlock(&index->mutex);
+    return -1;
+  }
+  fastembed_atomic_store(&node[HNSW_NODE_FLAGS], flags | HNSW_FLAG_DELETED);
+  fastembed_atomic_store(&index->live_count, index->live_count - 1);
+  fastembed_mutex_unlock(&index->mutex);
+  return 0;
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_search(fastembed_hnsw_t *index,
+                                           const float *query, int k,
+                                           int *out_ids, float *out_scores) {
+  if (!index || !query || k <= 0 || !out_ids || !out_scores) {
+    return -1;
+  }
+
+  int32_t entry = fastembed_atomic_load(&index->entry_point);
+  if (entry < 0) {
+    return 0;
+  }
+
+  hnsw_search_context_t *ctx = hnsw_acquire_context(index);
+  if (!ctx) {
+    return -1;
+  }
+
+  const float *prepared = query;
+  float query_sq = 0.0f;
+  if (index->metric == FASTEMBED_METRIC_COSINE) {
+    memcpy(ctx->query, query, (size_t)index->dimension * sizeof(float));
+    fastembed_normalize(ctx->query, index->dimension);
+    prepared = ctx->query;
+  } else if (index->metric == FASTEMBED_METRIC_EUCLIDEAN) {
+    query_sq = fastembed_dot_product(query, query, index->dimension);
+  }
+
+  int ef = fastembed_atomic_load(&index->ef_search);
+  if (ef < k) {
+    ef = k;
+  }
+
+  int top_level = hnsw_node(index, entry)[HNSW_NODE_LEVEL];
+  entry = hnsw_greedy_descent(index, prepared, query_sq, entry, top_level, 0);
+  if (hnsw_search_level(index, ctx, prepared, query_sq, entry, ef, 0, 1) !=
+      0) {
+    hnsw_release_context(index, ctx);
+    return -1;
+  }
+
+  /* Drop the farthest results, then pop the rest worst-first */
+  while (ctx->num_results > k) {
+    hnsw_heap_pop(ctx->results, &ctx->num_results, 1);
+  }
+  int count = ctx->num_results;
+  for (int i = count - 1; i >= 0; i--) {
+    hnsw_candidate_t item = hnsw_heap_pop(ctx->results, &ctx->num_results, 1);
+    out_ids[i] = item.id;
+    out_scores[i] = hnsw_score(index, item.distance);
+  }
+
+  hnsw_release_context(index, ctx);
+  return count;
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_set_ef_search(fastembed_hnsw_t *index,
+                                                  int ef_search) {
+  if (!index || ef_search <= 0) {
+    return -1;
+  }
+  fastembed_atomic_store(&index->ef_search, ef_search);
+  return 0;
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_size(const fastembed_hnsw_t *index) {
+  return index ? fastembed_atomic_load(&index->live_count) : -1;
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_dimension(const fastembed_hnsw_t *index) {
+  return index ? index->dimension : -1;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Persistence                                                               */
+/* ------------------------------------------------------------------------ */
+
+/** int32 entries in a node's upper-level lists */
+static size_t hnsw_upper_ints(const fastembed_hnsw_t *index, int level) {
+  return (size_t)level * (index->m + 1);
+}
+
+FASTEMBED_EXPORT int fastembed_hnsw_save(fastembed_hnsw_t *index,
+                                         const char *path) {
+  if (!index || !path) {
+    return -1;
+  }
+
+  hnsw_file_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, HNSW_MAGIC, sizeof(HNSW_MAGIC));
+  header.byte_order = HNSW_BYTE_ORDER_MARK;
+  header.version = HNSW_VERSION;
+  header.dimension = (uint32_t)index->dimension;
+  header.metric = (uint32_t)index->metric;
+  header.m = (uint32_t)index->m;
+  header.ef_construction = (uint32_t)index->ef_construction;
+  header.ef_search = (uint32_t)fastembed_atomic_load(&index->ef_search);
+  header.node_bytes = (uint32_t)index->node_bytes;
+
+  fastembed_mutex_lock(&index->mutex);
+  header.count = index->count;
+  header.entry_point = index->entry_point;
+  header.rng_state = index->rng_state;
+  fastembed_mutex_unlock(&index->mutex);
+
+  size_t upper_total = 0;
+  for (int32_t id = 0; id < header.count; id++) {
+    upper_total += hnsw_upper_ints(index, hnsw_node(index, id)[HNSW_NODE_LEVEL]);
+  }
+  header.upper_offset =
+      HNSW_NODES_OFFSET + (uint64_t)header.count * index->node_bytes;
+  header.file_bytes = header.upper_offset + upper_total * sizeof(int32_t);
+
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    return -1;
+  }
+
+  unsigned char padded[HNSW_NODES_OFFSET];
+  memset(padded, 0, sizeof(padded));
+  memcpy(padded, &header, sizeof(header));
+  int ok = fwrite(padded, 1, sizeof(padded), file) == sizeof(padded);
+
+  for (int s = 0; ok && s < HNSW_MAX_SEGMENTS; s++) {
+    int32_t start = hnsw_segment_start(s);
+    if (start >= header.count) {
+      break;
+    }
+    int32_t nodes = header.count - start < hnsw_segment_size(s)
+                        ? header.count - start
+                        : hnsw_segment_size(s);
+    ok = fwrite(index->segment_nodes[s], index->node_bytes, (size_t)nodes,
+                file) == (size_t)nodes;
+  }
+
+  for (int32_t id = 0; ok && id < header.count; id++) {
+    int level = hnsw_node(index, id)[HNSW_NODE_LEVEL];
+    if (level > 0) {
+      size_t ints = hnsw_upper_ints(index, level);
+      ok = fwrite(hnsw_links(index, id, 1), sizeof(int32_t), ints, file) ==
+           ints;
+    }
+  }
+
+  if (fclose(file) != 0) {
+    ok = 0;
+  }
+  if (!ok) {
+    remove(path);
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Check a loaded header and create the matching empty index
+ */
+static fastembed_hnsw_t *hnsw_from_header(const hnsw_file_header_t *header,
+                                          uint64_t file_bytes) {
+  if (memcmp(header->magic, HNSW_MAGIC, sizeof(HNSW_MAGIC)) != 0 ||
+      header->byte_order != HNSW_BYTE_ORDER_MARK ||
+      header->version != HNSW_VERSION) {
+    return NULL;
+  }
+  if (header->dimension == 0 || header->dimension > FASTEMBED_MAX_DIMENSION ||
+      header->m < 2 || header->m > FASTEMBED_HNSW_MAX_M ||
+      header->ef_construction == 0 || header->ef_search == 0 ||
+      header->ef_search > (uint32_t)INT32_MAX ||
+      header->ef_construction > (uint32_t)INT32_MAX ||
+      header->metric > FASTEMBED_METRIC_EUCLIDEAN || header->count < 0 ||
+      header->count > HNSW_MAX_NODES || header->file_bytes != file_bytes) {
+    return NULL;
+  }
+
+  fastembed_hnsw_t *index =
+      hnsw_alloc((int)header->dimension, (int)header->metric, (int)header->m,
+                 (int)header->ef_construction, (int)header->ef_search);
+  if (!index) {
+    return NULL;
+  }
+  if (index->node_bytes != header->node_bytes ||
+      header->upper_offset !=
+          HNSW_NODES_OFFSET + (uint64_t)header->count * index->node_bytes ||
+      header->upper_offset > file_bytes ||
+      (file_bytes - header->upper_offset) % sizeof(int32_t) != 0 ||
+      (header->count == 0) != (header->entry_point < 0) ||
+      header->entry_point >= header->count) {
+    free(index);
+    return NULL;
+  }
+  index->rng_state = header->rng_state;
+  return index;
+}
+
+/**
+ * @brief Check every level and link of a loaded graph; counts live nodes
+ *
+ * Levels were checked while the upper lists were attached.
+ */
+static int hnsw_validate(fastembed_hnsw_t *index, int32_t count,
+                         int32_t entry_point) {
+  int32_t live = 0;
+  for (int32_t id = 0; id < count; id++) {
+    const int32_t *node = hnsw_node(index, id);
+    int level = node[HNSW_NODE_LEVEL];
+    for (int l = 0; l <= level; l++) {
+      const int32_t *links = hnsw_links(index, id, l);
+      if (links[0] < 0 || links[0] > hnsw_max_links(index, l)) {
+        return -1;
+      }
+      for (int i = 0; i < links[0]; i++) {
+        int32_t neighbour = links[1 + i];
+        if (neighbour < 0 || neighbour >= count ||
+            hnsw_node(index, neighbour)[HNSW_NODE_LEVEL] < l) {
+          return -1;
+        }
+      }
+    }
+    if (!(node[HNSW_NODE_FLAGS] & HNSW_FLAG_DELETED)) {
+      live++;
+    }
+  }
+
+  index->count = count;
+  index->live_count = live;
+  index->entry_point = entry_point;
+  return 0;
+}
+
+FASTEMBED_EXPORT fastembed_hnsw_t *fastembed_hnsw_load(const char *path) {
+  if (!path) {
+    return NULL;
+  }
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    return NULL;
+  }
+
+  unsigned char padded[HNSW_NODES_OFFSET];
+  hnsw_file_header_t header;
+  long file_bytes = -1;
+  if (fread(padded, 1, sizeof(padded), file) == sizeof(padded) &&
+      fseek(file, 0, SEEK_END) == 0) {
+    file_bytes = ftell(file);
+  }
+  memcpy(&header, padded, sizeof(header));
+  fastembed_hnsw_t *index =
+      file_bytes > 0 ? hnsw_from_header(&header, (uint64_t)file_bytes) : NULL;
+  if (!index || fseek(file, HNSW_NODES_OFFSET, SEEK_SET) != 0) {
+    fastembed_hnsw_free(index);
+    fclose(file);
+    return NULL;
+  }
+
+  /* Node blocks, one segment at a time */
+  int ok = 1;
+  for (int s = 0; ok && s < HNSW_MAX_SEGMENTS; s++) {
+    int32_t start = hnsw_segment_start(s);
+    if (start >= header.count) {
+      break;
+    }
+    size_t capacity = (size_t)hnsw_segment_size(s);
+    size_t nodes = (size_t)(header.count - start) < capacity
+                       ? (size_t)(header.count - start)
+                       : capacity;
+    index->segment_nodes[s] =
+        (unsigned char *)malloc(capacity * index->node_bytes);
+    index->segment_upper[s] = (int32_t **)calloc(capacity, sizeof(int32_t *));
+    ok = index->segment_nodes[s] && index->segment_upper[s] &&
+         fread(index->segment_nodes[s], index->node_bytes, nodes, file) ==
+             nodes;
+    index->count = start + (int32_t)nodes; /* Lets free() see the lists */
+  }
+
+  /* Upper-level lists, in node order */
+  uint64_t upper_bytes = 0;
+  for (int32_t id = 0; ok && id < header.count; id++) {
+    int level = hnsw_node(index, id)[HNSW_NODE_LEVEL];
+    if (level < 0 || level > HNSW_MAX_LEVEL) {
+      ok = 0;
+      break;
+    }
+    if (level == 0) {
+      continue;
+    }
+    size_t ints = hnsw_upper_ints(index, level);
+    int32_t *upper = (int32_t *)malloc(ints * sizeof(int32_t));
+    uint32_t offset;
+    int segment = hnsw_segment_of(id, &offset);
+    index->segment_upper[segment][offset] = upper;
+    ok = upper && fread(upper, sizeof(int32_t), ints, file) == ints;
+    upper_bytes += ints * sizeof(int32_t);
+  }
+  fclose(file);
+
+  if (!ok || header.upper_offset + upper_bytes != header.file_bytes ||
+      hnsw_validate(index, header.count, header.entry_point) != 0) {
+    fastembed_hnsw_free(index);
+    return NULL;
+  }
+  return index;
+}
+
+FASTEMBED_EXPORT fastembed_hnsw_t *fastembed_hnsw_load_mmap(const char *path) {
+  fastembed_file_map_t map;
+  if (!path || fastembed_map_file(path, &map) != 0) {
+    return NULL;
+  }
+
+  hnsw_file_header_t header;
+  fastembed_hnsw_t *index = NULL;
+  if (map.size >= HNSW_NODES_OFFSET) {
+    memcpy(&header, map.data, sizeof(header));
+    index = hnsw_from_header(&header, (uint64_t)map.size);
+  }
+  if (!index) {
+    fastembed_unmap_file(&map);
+    return NULL;
+  }
+  index->mapped = 1;
+  index->map = map;
+
+  /* Point the segments into the mapping */
+  const unsigned char *base = (const unsigned char *)map.data;
+  int ok = 1;
+  for (int s = 0; ok && s < HNSW_MAX_SEGMENTS; s++) {
+    int32_t start = hnsw_segment_start(s);
+    if (start >= header.count) {
+      break;
+    }
+    size_t nodes = (size_t)(header.count - start) < (size_t)hnsw_segment_size(s)
+                       ? (size_t)(header.count - start)
+                       : (size_t)hnsw_segment_size(s);
+    index->segment_nodes[s] = (unsigned char *)(base + HNSW_NODES_OFFSET +
+                                                (size_t)start * index->node_bytes);
+    index->segment_upper[s] = (int32_t **)calloc(nodes, sizeof(int32_t *));
+    ok = index->segment_upper[s] != NULL;
+  }
+
+  uint64_t upper_offset = header.upper_offset;
+  for (int32_t id = 0; ok && id < header.count; id++) {
+    int level = hnsw_node(index, id)[HNSW_NODE_LEVEL];
+    if (level < 0 || level > HNSW_MAX_LEVEL) {
+      ok = 0;
+      break;
+    }
+    if (level == 0) {
+      continue;
+    }
+    uint64_t bytes = hnsw_upper_ints(index, level) * sizeof(int32_t);
+    if (upper_offset + bytes > map.size) {
+      ok = 0;
+      break;
+    }
+    uint32_t offset;
+    int segment = hnsw_segment_of(id, &offset);
+    index->segment_upper[segment][offset] =
+        (int32_t *)(base + upper_offset);
+    upper_offset += bytes;
+  }
+
+  if (!ok || upper_offset != map.size ||
+      hnsw_validate(index, header.count, header.entry_point) != 0) {
+    fastembed_hnsw_free(index);
+    return NULL;
+  }
+  return index;
+}
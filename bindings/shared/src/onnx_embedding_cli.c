@@ -22,20 +22,36 @@
  *
  *   # Pipe from file
  *   cat input.txt | ./onnx_embedding_cli models/nomic-embed-text.onnx
+ *
+ *   # Streaming mode: the model is loaded once for all records
+ *   ./onnx_embedding_cli models/nomic-embed-text.onnx --stream \
+ *       < records.ndjson > embeddings.ndjson
  * @endcode
  *
+ * Streaming options (after the model path):
+ * - --stream: Process NDJSON records until end of input (see cli_stream.h)
+ * - --batch N: Records per batch (default 256)
+ * - --threads N: Batch threads (default 0 = all CPUs); with more than one,
+ *   each ONNX Runtime session runs single-threaded to avoid oversubscription
+ * - --format ndjson|f32le: Output encoding (default ndjson)
+ *
  * Output format:
  * - Success: JSON array of floats: [0.123, -0.456, ...]
  * - Error: JSON error object: {"error":"Failed to generate embedding"}
  * - Warning: JSON warning object (if fallback used)
+ * - Streaming: {"index":N,"id":...,"embedding":[...]} per record, or
+ *   model-dimension little-endian floats per record with --format f32le
  *
  * Exit codes:
- * - 0: Success
- * - 1: Error (invalid arguments, failed inference, I/O error)
+ * - 0: Success (streaming: end of input; per-record errors are reported in
+ *   the output)
+ * - 1: Error (invalid arguments, failed inference or model load, I/O error)
  */
 
+#include "../include/fastembed.h"
 #include "../include/fastembed_config.h"
 #include "../include/fastembed_internal.h"
+#include "cli_stream.h"
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -50,12 +66,86 @@
 #define MAX_TEXT_LENGTH FASTEMBED_MAX_TEXT_LENGTH
 #define EMBEDDING_DIM FASTEMBED_EMBEDDING_DIM
 
+#ifdef USE_ONNX_RUNTIME
+extern fastembed_model_t *onnx_model_open(const char *model_path,
+                                          const fastembed_onnx_options_t *options);
+extern int onnx_model_close(fastembed_model_t *model);
+extern int onnx_model_get_dimension(const fastembed_model_t *model);
+extern int onnx_model_warmup(fastembed_model_t *model);
+extern int onnx_model_generate_contiguous_parallel(
+    fastembed_model_t *model, const char *text_data, const int32_t *offsets,
+    int num_texts, float *output, int output_dim, int *statuses,
+    int num_threads);
+
+/**
+ * @brief Streaming batch callback: ONNX inference on the thread pool
+ *
+ * @param user_data Open model handle
+ */
+static int embed_onnx_batch(void *user_data, const char *text_data,
+                            const int32_t *offsets, int count, float *output,
+                            int *statuses, int num_threads) {
+  fastembed_model_t *model = (fastembed_model_t *)user_data;
+  return onnx_model_generate_contiguous_parallel(
+      model, text_data, offsets, count, output,
+      onnx_model_get_dimension(model), statuses, num_threads);
+}
+#else
+/**
+ * @brief Streaming batch callback: hash-based fallback
+ */
+static int embed_hash_batch(void *user_data, const char *text_data,
+                            const int32_t *offsets, int count, float *output,
+                            int *statuses, int num_threads) {
+  (void)user_data;
+  return fastembed_batch_generate_contiguous(
+      text_data, offsets, count, output, EMBEDDING_DIM, statuses, num_threads);
+}
+#endif
+
+/**
+ * @brief Run the streaming mode with the model loaded once
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Parsed streaming options
+ * @return Exit code: 0 at end of input, 1 on error
+ */
+static int run_stream(const char *model_path,
+                      const cli_stream_options_t *options) {
+#ifdef USE_ONNX_RUNTIME
+  /* Parallelism comes from the batch threads when there are several */
+  fastembed_onnx_options_t session_options;
+  fastembed_onnx_options_init(&session_options);
+  if (options->num_threads != 1) {
+    session_options.intra_op_threads = 1;
+  }
+
+  fastembed_model_t *model = onnx_model_open(model_path, &session_options);
+  if (!model) {
+    fprintf(stderr, "{\"error\":\"Failed to load model\"}\n");
+    return 1;
+  }
+  onnx_model_warmup(model);
+
+  int result = cli_stream_embeddings(
+      options, onnx_model_get_dimension(model), embed_onnx_batch, model);
+  onnx_model_close(model);
+  return result;
+#else
+  (void)model_path;
+  fprintf(stderr, "{\"warning\":\"ONNX Runtime not available, using hash-based "
+                  "embedding\"}\n");
+  return cli_stream_embeddings(options, EMBEDDING_DIM, embed_hash_batch, NULL);
+#endif
+}
+
 /**
  * @brief Main entry point for ONNX embedding CLI tool
  *
  * Processes command-line arguments, reads input text (from stdin or argv),
  * generates embedding using ONNX model or fallback method, and outputs
- * result as JSON array.
+ * result as JSON array. With --stream, processes NDJSON records until end
+ * of input instead (see run_stream()).
  *
  * Workflow:
  * 1. Validate command-line arguments (at least model path required)
@@ -68,7 +158,7 @@
  *              - argv[0]: Program name
  *              - argv[1]: Path to .onnx model file (required)
  *              - argv[2]: Optional text input (if not provided, reads from
- * stdin)
+ * stdin), or the streaming options
  * @return Exit code: 0 on success, 1 on error
  */
 int main(int argc, char *argv[]) {
@@ -76,11 +166,36 @@ int main(int argc, char *argv[]) {
   if (argc < 2) {
     fprintf(stderr, "Usage: %s <model.onnx> [text]\n", argv[0]);
     fprintf(stderr, "   or: echo \"text\" | %s <model.onnx>\n", argv[0]);
+    fprintf(stderr,
+            "   or: %s <model.onnx> --stream [--batch N] [--threads N] "
+            "[--format ndjson|f32le] < records.ndjson\n",
+            argv[0]);
     return 1;
   }
 
   /* Extract model path from arguments */
   const char *model_path = argv[1];
+
+  /* Options instead of a text argument select the streaming mode */
+  if (argc >= 3 && strncmp(argv[2], "--", 2) == 0) {
+    cli_stream_options_t stream;
+    cli_stream_options_init(&stream);
+    for (int i = 2; i < argc;) {
+      int parsed = cli_stream_parse_option(argc, argv, &i, &stream);
+      if (parsed < 0) {
+        return 1;
+      }
+      if (parsed == 0) {
+        fprintf(stderr, "{\"error\":\"Unknown option: %s\"}\n", argv[i]);
+        return 1;
+      }
+    }
+    if (stream.enabled) {
+      return run_stream(model_path, &stream);
+    }
+    fprintf(stderr, "{\"error\":\"Streaming options require --stream\"}\n");
+    return 1;
+  }
   char text_buffer[MAX_TEXT_LENGTH];
   float output[EMBEDDING_DIM];
 
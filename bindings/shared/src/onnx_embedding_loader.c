@@ -10,17 +10,44 @@
  * Features:
  * - Direct ONNX model loading and inference using standard C API
  * - **Model session caching**: Models are loaded once and reused across
- * multiple calls
- * - Simplified tokenization for BERT-like models
- * - Automatic tensor creation and management
- * - L2 normalization of output embeddings
+ * multiple calls (multi-model registry with reference-counted handles)
+ * - WordPiece tokenization with the model's own vocabulary (vocab.txt or
+ * tokenizer.json found next to the model); a hash-based tokenizer is used
+ * when no vocabulary is available
+ * - Batched inference: texts are padded into [N, seq_len] tensors with an
+ * attention mask and embedded with a single Run() per batch
+ * - Length-bucketed scheduling: batches group texts of similar token count
+ * under a padded-token budget to minimize wasted compute on padding
+ * - Session tuning: thread counts, graph optimization level, memory
+ * pattern / arena, execution providers with CPU fallback and an optional
+ * optimized-model cache (fastembed_onnx_options_t)
+ * - Pooled inference contexts: input/output buffers, tensors and an
+ * IoBinding are kept per session and reused, so steady-state calls make no
+ * heap allocations; a single pooled embedding is written directly into the
+ * caller's output array
+ * - Pooling of [N, L, H] outputs (CLS, mask-aware mean, max or last token)
+ * followed by L2 normalization of output embeddings
+ * - float16 / bfloat16 models: the half-precision output is bound as-is
+ * (half the output bandwidth) and widened with the SIMD conversion kernels
+ * before pooling
+ * - Chunked documents: text of any length is streamed in, tokenized a
+ * segment at a time and embedded as overlapping token windows with bounded
+ * memory (fastembed_document_t)
  *
  * Performance:
  * - First call with a model: loads model into memory (~100-500ms depending on
  * model size)
  * - Subsequent calls: reuse cached session (no reload overhead)
- * - Automatic model switching: if different model_path is provided, previous
- * model is unloaded
+ * - Multiple models: sessions are kept in a registry keyed by resolved model
+ * path, so alternating between models does not reload them; idle sessions
+ * beyond the cache capacity are evicted least-recently-used first
+ *
+ * Thread safety:
+ * - The registry is mutex-protected and sessions are reference counted, so
+ * concurrent callers share one loaded session per model
+ * - Each in-flight call uses its own inference context from the session's
+ * pool, so concurrent calls never share buffers
+ * - Error messages are stored per thread
  *
  * Requires: ONNX Runtime C API (libonnxruntime.so / onnxruntime.dll)
  */
@@ -34,6 +61,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -49,14 +77,18 @@
 #endif
 #endif
 
+#include "../include/fastembed.h"
 #include "../include/fastembed_config.h"
+#include "embedding_cache.h"
+#include "fastembed_platform.h"
+#include "fastembed_stats.h"
+#include "thread_pool.h"
 #include <onnxruntime_c_api.h>
 
 #define MAX_TEXT_LENGTH FASTEMBED_MAX_TEXT_LENGTH
 #define MAX_OUTPUT_DIM FASTEMBED_MAX_OUTPUT_DIM
 #define MAX_SEQUENCE_LENGTH FASTEMBED_MAX_SEQUENCE_LENGTH
 #define VOCAB_SIZE FASTEMBED_VOCAB_SIZE
-#define MAX_MODEL_PATH 512
 
 /**
  * @brief Global ONNX Runtime API instance
@@ -66,34 +98,112 @@
 static const OrtApi *g_ort = NULL;
 
 /**
- * @brief Cached model session structure
+ * @brief Reusable per-call inference state for one session
  *
- * Stores loaded ONNX model session and related resources for reuse.
+ * Contexts are pooled per model entry: a call takes one from the pool (or
+ * creates one), and returns it when done, so concurrent calls never share
+ * buffers. Buffers only grow, and the input/output tensors and the
+ * IoBinding are rebuilt only when the padded batch shape or the output
+ * buffer changes, so steady-state calls make no heap allocations.
  */
-typedef struct {
-  char model_path[MAX_MODEL_PATH];    /* Resolved path to model file */
-  OrtEnv *env;                        /* ONNX environment (singleton) */
-  OrtMemoryInfo *memory_info;         /* CPU memory info */
+typedef struct inference_context {
+  int (*schedule)[3]; /* FASTEMBED_ONNX_SCHEDULE_WINDOW entries */
+  int64_t *scratch;   /* MAX_SEQUENCE_LENGTH tokens */
+  int64_t *token_pool; /* Unpadded tokens of the current window */
+  size_t pool_capacity;
+  int64_t *batch_inputs; /* input_ids | attention_mask | token_type_ids */
+  size_t batch_capacity;
+  float *output_buffer; /* Whole output tensor when not bound to caller */
+  size_t output_capacity;
+  uint16_t *half_buffer; /* fp16 / bf16 output tensor, widened into
+                            output_buffer after Run() */
+  size_t half_capacity;
+  OrtIoBinding *binding;
+  OrtValue *input_tensors[3]; /* Wrap batch_inputs at input_shape */
+  const int64_t *input_data;  /* batch_inputs the tensors were built on */
+  int64_t input_shape[2];
+  OrtValue *output_tensor;    /* Wraps output_data at output_shape */
+  const void *output_data;
+  int64_t output_shape[3];
+  int bind_output;      /* 0 = let ORT allocate outputs (fallback path) */
+  int output_on_device; /* Output bound with BindOutputToDevice */
+  const char **miss_texts; /* Embedding cache misses of the current call */
+  size_t miss_texts_capacity;
+  float **miss_outputs;
+  size_t miss_outputs_capacity;
+  uint64_t *miss_keys;
+  size_t miss_keys_capacity;
+  struct inference_context *next;
+} InferenceContext;
+
+/**
+ * @brief Loaded model session (registry entry and public model handle)
+ *
+ * One entry exists per resolved model path and session options. Entries
+ * are reference counted:
+ * every open handle (fastembed_model_open) and every in-flight path-based
+ * call holds a reference. Idle entries (refcount == 0) stay cached until
+ * evicted by the LRU policy or onnx_unload_model().
+ */
+struct fastembed_model {
+  char *model_path;                   /* Resolved path (registry key) */
+  char *open_path;                    /* Path as first passed by caller */
   OrtSessionOptions *session_options; /* Session options */
   OrtSession *session;                /* Loaded session */
-  OrtAllocator *allocator;            /* Allocator for names */
   char *output_name;                  /* Cached output name */
+  fastembed_onnx_options_t options;   /* Options the session was created with */
+  char *optimized_model_path;         /* Owned copy of options path */
+  char *tokenizer_path;               /* Owned copy of options path */
+  fastembed_tokenizer_t *tokenizer;   /* NULL = hash-based fallback */
+  int64_t pad_token_id;               /* Padding ID for batched inputs */
+  int execution_provider; /* Provider in use (fastembed_execution_provider_t) */
   int output_dimension; /* Cached output dimension (-1 if not detected) */
-  int is_loaded;        /* Flag: is session loaded */
-} CachedModelSession;
+  int output_rank;      /* Output tensor rank (0 if not detected) */
+  int output_type; /* ONNXTensorElementDataType of the output (float, fp16
+                      or bf16) */
+  struct inference_context *idle_contexts; /* Pooled inference contexts */
+  int idle_context_count;
+  fastembed_mutex_t context_mutex; /* Guards idle_contexts */
+  int refcount;         /* Open handles + in-flight calls */
+  int in_registry;      /* 0 once unloaded while still referenced */
+  uint64_t last_used;   /* LRU tick of last acquire */
+  struct fastembed_model *next;
+};
+
+typedef struct fastembed_model ModelEntry;
+
+/**
+ * @brief Process-wide ONNX Runtime state shared by all sessions
+ */
+static OrtEnv *g_env = NULL;                 /* ONNX environment (singleton) */
+static OrtMemoryInfo *g_memory_info = NULL;  /* CPU memory info */
+static OrtAllocator *g_allocator = NULL;     /* Allocator for names */
 
 /**
- * @brief Global cached session (single model support)
+ * @brief Session registry (keyed by resolved model path, LRU eviction)
  *
- * For multiple models, this could be extended to a hash table or array.
+ * g_registry_mutex guards the entry list, refcounts and LRU ticks.
+ * g_load_mutex serializes model loading so two threads opening the same
+ * model read it from disk only once, without blocking lookups of models
+ * that are already loaded.
  */
-static CachedModelSession g_cached_session = {0};
+static ModelEntry *g_registry = NULL;
+static int g_registry_count = 0;
+static int g_registry_capacity = FASTEMBED_ONNX_MODEL_CACHE_SIZE;
+static uint64_t g_registry_tick = 0;
+static fastembed_mutex_t g_registry_mutex = FASTEMBED_MUTEX_INITIALIZER;
+static fastembed_mutex_t g_load_mutex = FASTEMBED_MUTEX_INITIALIZER;
 
 /**
- * @brief Last error message buffer (for detailed error reporting)
+ * @brief Last error message buffer (per thread, for detailed error reporting)
  */
 #define MAX_ERROR_MESSAGE 512
-static char g_last_error[MAX_ERROR_MESSAGE] = {0};
+static FASTEMBED_THREAD_LOCAL char g_last_error[MAX_ERROR_MESSAGE] = {0};
+
+/**
+ * @brief Padded-token budget per batched Run() (batch_size * seq_len)
+ */
+static int g_batch_token_budget = FASTEMBED_ONNX_BATCH_TOKEN_BUDGET;
 
 /**
  * @brief Helper macro to save error message
@@ -214,167 +324,825 @@ skip_standard_init:
   } while (0)
 
 /**
- * @brief Load or retrieve cached ONNX model session
+ * @brief Release an inference context and everything it owns
+ */
+static void destroy_inference_context(InferenceContext *ctx) {
+  if (ctx == NULL)
+    return;
+
+  if (ctx->binding)
+    g_ort->ReleaseIoBinding(ctx->binding);
+  for (int i = 0; i < 3; i++) {
+    if (ctx->input_tensors[i])
+      g_ort->ReleaseValue(ctx->input_tensors[i]);
+  }
+  if (ctx->output_tensor)
+    g_ort->ReleaseValue(ctx->output_tensor);
+
+  free(ctx->schedule);
+  free(ctx->scratch);
+  free(ctx->token_pool);
+  free(ctx->batch_inputs);
+  free(ctx->output_buffer);
+  free(ctx->half_buffer);
+  free(ctx->miss_texts);
+  free(ctx->miss_outputs);
+  free(ctx->miss_keys);
+  free(ctx);
+}
+
+/**
+ * @brief Whether an output element type is stored as 16-bit halves
+ */
+static int is_half_output(int element_type) {
+  return element_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16 ||
+         element_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16;
+}
+
+/**
+ * @brief Widen an fp16 / bf16 output tensor to floats
  *
- * If model is already loaded (same path), returns cached session.
- * Otherwise, loads the model and caches it for future use.
+ * @return 0 on success, -1 on error
+ */
+static int widen_half_output(int element_type, const uint16_t *input,
+                             float *output, size_t count) {
+  /* The conversion functions take int counts */
+  const size_t chunk = (size_t)1 << 30;
+  for (size_t offset = 0; offset < count; offset += chunk) {
+    int n = (int)(count - offset < chunk ? count - offset : chunk);
+    int result =
+        element_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16
+            ? fastembed_bf16_to_f32(input + offset, output + offset, n)
+            : fastembed_f16_to_f32(input + offset, output + offset, n);
+    if (result != 0)
+      return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Release all ONNX resources owned by a model entry
+ *
+ * @param entry Entry to destroy (must not be referenced or in the registry)
+ */
+static void destroy_model_entry(ModelEntry *entry) {
+  if (entry == NULL)
+    return;
+
+  while (entry->idle_contexts) {
+    InferenceContext *next = entry->idle_contexts->next;
+    destroy_inference_context(entry->idle_contexts);
+    entry->idle_contexts = next;
+  }
+  if (entry->output_name && g_allocator)
+    g_allocator->Free(g_allocator, entry->output_name);
+  if (entry->session)
+    g_ort->ReleaseSession(entry->session);
+  if (entry->session_options)
+    g_ort->ReleaseSessionOptions(entry->session_options);
+
+  free(entry->model_path);
+  free(entry->open_path);
+  free(entry->optimized_model_path);
+  free(entry->tokenizer_path);
+  fastembed_tokenizer_free(entry->tokenizer);
+  free(entry);
+}
+
+/**
+ * @brief Duplicate a string with malloc (strdup is not C11)
+ */
+static char *copy_string(const char *str) {
+  size_t len = strlen(str) + 1;
+  char *copy = (char *)malloc(len);
+  if (copy != NULL)
+    memcpy(copy, str, len);
+  return copy;
+}
+
+/**
+ * @brief Create process-wide ORT state (API, environment, memory info)
+ *
+ * Called with g_load_mutex held.
  *
- * @param model_path Path to .onnx model file
- * @param cached Pointer to cached session structure
  * @return 0 on success, -1 on error
  */
-static int load_or_get_cached_session(const char *model_path,
-                                      CachedModelSession *cached) {
-  char resolved_path[PATH_MAX];
+static int init_shared_state(void) {
+  if (init_onnx_api() != 0) {
+    SAVE_ERROR("Failed to initialize ONNX Runtime API - check if "
+               "onnxruntime.dll is available");
+    return -1;
+  }
 
-  /* Resolve model path */
-#ifdef _WIN32
-  if (_fullpath(resolved_path, model_path, PATH_MAX) == NULL)
-#else
-  if (realpath(model_path, resolved_path) == NULL)
-#endif
-  {
-    SAVE_ERROR("Model file not found or cannot resolve path: %s", model_path);
-    fprintf(stderr, "Model file not found: %s\n", model_path);
+  /* Create environment (singleton, never released) */
+  if (g_env == NULL) {
+    CHECK_ORT_STATUS(
+        g_ort->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "FastEmbed", &g_env));
+  }
+
+  /* CPU memory info is shared by all sessions */
+  if (g_memory_info == NULL) {
+    CHECK_ORT_STATUS(g_ort->CreateCpuMemoryInfo(
+        OrtArenaAllocator, OrtMemTypeDefault, &g_memory_info));
+  }
+
+  if (g_allocator == NULL) {
+    CHECK_ORT_STATUS(g_ort->GetAllocatorWithDefaultOptions(&g_allocator));
+  }
+
+  return 0;
+
+cleanup:
+  return -1;
+}
+
+/**
+ * @brief Check session options for out-of-range values
+ *
+ * @param options Options to validate
+ * @return 0 if valid, -1 otherwise (error saved)
+ */
+static int validate_options(const fastembed_onnx_options_t *options) {
+  if (options->intra_op_threads < 0 || options->inter_op_threads < 0) {
+    SAVE_ERROR("Invalid thread count: intra_op_threads=%d, inter_op_threads=%d",
+               options->intra_op_threads, options->inter_op_threads);
+    return -1;
+  }
+
+  switch (options->graph_opt_level) {
+  case FASTEMBED_GRAPH_OPT_DISABLE:
+  case FASTEMBED_GRAPH_OPT_BASIC:
+  case FASTEMBED_GRAPH_OPT_EXTENDED:
+  case FASTEMBED_GRAPH_OPT_ALL:
+    break;
+  default:
+    SAVE_ERROR("Invalid graph_opt_level: %d", options->graph_opt_level);
     return -1;
   }
 
-  /* Check if same model is already loaded */
-  if (cached->is_loaded && strcmp(cached->model_path, resolved_path) == 0) {
-    return 0; /* Already loaded, reuse */
+  if (options->num_execution_providers < 0 ||
+      options->num_execution_providers > FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS) {
+    SAVE_ERROR("Invalid num_execution_providers: %d (max %d)",
+               options->num_execution_providers,
+               FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS);
+    return -1;
   }
 
-  /* Unload previous model if different */
-  if (cached->is_loaded) {
-    if (cached->output_name && cached->allocator) {
-      cached->allocator->Free(cached->allocator, cached->output_name);
-      cached->output_name = NULL;
+  for (int i = 0; i < options->num_execution_providers; i++) {
+    int provider = options->execution_providers[i];
+    if (provider < FASTEMBED_EP_CPU || provider > FASTEMBED_EP_XNNPACK) {
+      SAVE_ERROR("Invalid execution provider: %d", provider);
+      return -1;
     }
-    if (cached->session)
-      g_ort->ReleaseSession(cached->session);
-    if (cached->session_options)
-      g_ort->ReleaseSessionOptions(cached->session_options);
-    if (cached->memory_info)
-      g_ort->ReleaseMemoryInfo(cached->memory_info);
-    /* Note: env is singleton, don't release it */
+  }
+
+  if (options->device_id < 0) {
+    SAVE_ERROR("Invalid device_id: %d", options->device_id);
+    return -1;
+  }
+
+  if (options->pooling < FASTEMBED_POOLING_CLS ||
+      options->pooling > FASTEMBED_POOLING_LAST_TOKEN) {
+    SAVE_ERROR("Invalid pooling: %d", options->pooling);
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Compare two optional strings (NULL only equals NULL)
+ */
+static int optional_strings_equal(const char *a, const char *b) {
+  if (a == NULL || b == NULL)
+    return a == b;
+  return strcmp(a, b) == 0;
+}
+
+/**
+ * @brief Compare two option sets (registry key)
+ *
+ * @return Non-zero if sessions created with a and b are interchangeable
+ */
+static int options_equal(const fastembed_onnx_options_t *a,
+                         const fastembed_onnx_options_t *b) {
+  if (a->intra_op_threads != b->intra_op_threads ||
+      a->inter_op_threads != b->inter_op_threads ||
+      a->graph_opt_level != b->graph_opt_level ||
+      (a->enable_mem_pattern != 0) != (b->enable_mem_pattern != 0) ||
+      (a->enable_cpu_mem_arena != 0) != (b->enable_cpu_mem_arena != 0) ||
+      a->num_execution_providers != b->num_execution_providers ||
+      a->device_id != b->device_id || a->pooling != b->pooling)
+    return 0;
+
+  for (int i = 0; i < a->num_execution_providers; i++) {
+    if (a->execution_providers[i] != b->execution_providers[i])
+      return 0;
+  }
+
+  return optional_strings_equal(a->optimized_model_path,
+                                b->optimized_model_path) &&
+         optional_strings_equal(a->tokenizer_path, b->tokenizer_path);
+}
+
+/**
+ * @brief Check whether an optimized-model cache file can be loaded directly
+ *
+ * The cache is stale when it is older than the source model.
+ *
+ * @return Non-zero if cache_path exists and is not older than model_path
+ */
+static int is_optimized_cache_fresh(const char *model_path,
+                                    const char *cache_path) {
+  struct stat model_stat, cache_stat;
+  if (stat(model_path, &model_stat) != 0 || stat(cache_path, &cache_stat) != 0)
+    return 0;
+  return cache_stat.st_size > 0 && cache_stat.st_mtime >= model_stat.st_mtime;
+}
+
+#ifdef _WIN32
+/**
+ * @brief Convert a UTF-8 path to the wide string ONNX Runtime expects
+ */
+static void to_wide_path(const char *path, wchar_t *wide_path) {
+  MultiByteToWideChar(CP_UTF8, 0, path, -1, wide_path, PATH_MAX);
+}
+#endif
+
+/**
+ * @brief Append one execution provider to session options
+ *
+ * @param session_options Session options to modify
+ * @param provider fastembed_execution_provider_t value (not CPU)
+ * @param options Options (device id, thread count)
+ * @return NULL on success, ORT status on failure (caller releases)
+ */
+static OrtStatus *append_execution_provider(
+    OrtSessionOptions *session_options, int provider,
+    const fastembed_onnx_options_t *options) {
+  char device_id[16];
+  snprintf(device_id, sizeof(device_id), "%d", options->device_id);
+
+  switch (provider) {
+  case FASTEMBED_EP_CUDA: {
+    OrtCUDAProviderOptions cuda_options;
+    memset(&cuda_options, 0, sizeof(cuda_options));
+    cuda_options.device_id = options->device_id;
+    cuda_options.gpu_mem_limit = SIZE_MAX;
+    cuda_options.do_copy_in_default_stream = 1;
+    return g_ort->SessionOptionsAppendExecutionProvider_CUDA(session_options,
+                                                             &cuda_options);
+  }
+  case FASTEMBED_EP_TENSORRT: {
+    OrtTensorRTProviderOptionsV2 *trt_options = NULL;
+    OrtStatus *status = g_ort->CreateTensorRTProviderOptions(&trt_options);
+    if (status != NULL)
+      return status;
+    const char *keys[] = {"device_id"};
+    const char *values[] = {device_id};
+    status = g_ort->UpdateTensorRTProviderOptions(trt_options, keys, values, 1);
+    if (status == NULL)
+      status = g_ort->SessionOptionsAppendExecutionProvider_TensorRT_V2(
+          session_options, trt_options);
+    g_ort->ReleaseTensorRTProviderOptions(trt_options);
+    return status;
+  }
+  case FASTEMBED_EP_COREML:
+    return g_ort->SessionOptionsAppendExecutionProvider(session_options,
+                                                        "CoreML", NULL, NULL, 0);
+  case FASTEMBED_EP_XNNPACK: {
+    /* XNNPACK runs its own thread pool sized like the intra-op pool */
+    char threads[16];
+    snprintf(threads, sizeof(threads), "%d", options->intra_op_threads);
+    const char *keys[] = {"intra_op_num_threads"};
+    const char *values[] = {threads};
+    return g_ort->SessionOptionsAppendExecutionProvider(
+        session_options, "XNNPACK", keys, values,
+        options->intra_op_threads > 0 ? 1 : 0);
+  }
+  default:
+    return g_ort->CreateStatus(ORT_INVALID_ARGUMENT,
+                               "Unknown execution provider");
+  }
+}
 
-    memset(cached, 0, sizeof(CachedModelSession));
+/**
+ * @brief Create ORT session options from fastembed options
+ *
+ * Execution providers are appended in order of preference; providers that
+ * are not available in the loaded ONNX Runtime build are skipped.
+ *
+ * @param options Session options
+ * @param use_providers Zero to create CPU-only options (fallback)
+ * @param load_from_cache Non-zero when loading a cached optimized model
+ * @param out Created session options
+ * @param active_provider First provider that was appended (CPU if none)
+ * @return 0 on success, -1 on error
+ */
+static int create_session_options(const fastembed_onnx_options_t *options,
+                                  int use_providers, int load_from_cache,
+                                  OrtSessionOptions **out,
+                                  int *active_provider) {
+  OrtSessionOptions *session_options = NULL;
+  *active_provider = FASTEMBED_EP_CPU;
+
+  CHECK_ORT_STATUS(g_ort->CreateSessionOptions(&session_options));
+
+  if (options->intra_op_threads > 0)
+    CHECK_ORT_STATUS(g_ort->SetIntraOpNumThreads(session_options,
+                                                 options->intra_op_threads));
+  if (options->inter_op_threads > 0) {
+    CHECK_ORT_STATUS(g_ort->SetInterOpNumThreads(session_options,
+                                                 options->inter_op_threads));
+    /* Inter-op threads are only used in parallel execution mode */
+    if (options->inter_op_threads > 1)
+      CHECK_ORT_STATUS(
+          g_ort->SetSessionExecutionMode(session_options, ORT_PARALLEL));
   }
 
-  /* Create or get environment (singleton) */
-  if (cached->env == NULL) {
+  /* The cached model is already optimized: don't optimize it again */
+  GraphOptimizationLevel level =
+      load_from_cache ? ORT_DISABLE_ALL
+                      : (GraphOptimizationLevel)options->graph_opt_level;
+  CHECK_ORT_STATUS(g_ort->SetSessionGraphOptimizationLevel(session_options,
+                                                           level));
+
+  if (options->enable_mem_pattern)
+    CHECK_ORT_STATUS(g_ort->EnableMemPattern(session_options));
+  else
+    CHECK_ORT_STATUS(g_ort->DisableMemPattern(session_options));
+
+  if (options->enable_cpu_mem_arena)
+    CHECK_ORT_STATUS(g_ort->EnableCpuMemArena(session_options));
+  else
+    CHECK_ORT_STATUS(g_ort->DisableCpuMemArena(session_options));
+
+  if (options->optimized_model_path != NULL && !load_from_cache) {
+#ifdef _WIN32
+    wchar_t wide_cache_path[PATH_MAX];
+    to_wide_path(options->optimized_model_path, wide_cache_path);
     CHECK_ORT_STATUS(
-        g_ort->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "FastEmbed", &cached->env));
+        g_ort->SetOptimizedModelFilePath(session_options, wide_cache_path));
+#else
+    CHECK_ORT_STATUS(g_ort->SetOptimizedModelFilePath(
+        session_options, options->optimized_model_path));
+#endif
+  }
+
+  for (int i = 0; use_providers && i < options->num_execution_providers; i++) {
+    int provider = options->execution_providers[i];
+    if (provider == FASTEMBED_EP_CPU)
+      break; /* CPU handles everything: later providers would be unused */
+
+    OrtStatus *status =
+        append_execution_provider(session_options, provider, options);
+    if (status != NULL) {
+      /* Not available in this build: fall back to the next provider */
+      g_ort->ReleaseStatus(status);
+      continue;
+    }
+    if (*active_provider == FASTEMBED_EP_CPU)
+      *active_provider = provider;
   }
 
-  /* Create CPU memory info */
-  CHECK_ORT_STATUS(g_ort->CreateCpuMemoryInfo(
-      OrtArenaAllocator, OrtMemTypeDefault, &cached->memory_info));
+  *out = session_options;
+  return 0;
 
-  /* Create session options */
-  CHECK_ORT_STATUS(g_ort->CreateSessionOptions(&cached->session_options));
+cleanup:
+  if (session_options)
+    g_ort->ReleaseSessionOptions(session_options);
+  return -1;
+}
 
-  /* Create session from file */
+/**
+ * @brief Create a session for an entry, falling back to CPU on failure
+ *
+ * Some providers only fail when the session is created (missing GPU,
+ * driver mismatch); in that case the session is recreated CPU-only.
+ *
+ * @param entry Entry with options set (session fields are filled in)
+ * @param resolved_path Resolved path to .onnx model file
+ * @return 0 on success, -1 on error
+ */
+static int create_entry_session(ModelEntry *entry, const char *resolved_path) {
+  const fastembed_onnx_options_t *options = &entry->options;
+  int load_from_cache =
+      options->optimized_model_path != NULL &&
+      is_optimized_cache_fresh(resolved_path, options->optimized_model_path);
+  const char *session_path =
+      load_from_cache ? options->optimized_model_path : resolved_path;
+
+  for (int use_providers = 1; use_providers >= 0; use_providers--) {
+    if (create_session_options(options, use_providers, load_from_cache,
+                               &entry->session_options,
+                               &entry->execution_provider) != 0)
+      return -1;
+
+    /* Create session from file */
 #ifdef _WIN32
-  /* Convert path to wide string for Windows */
-  wchar_t wide_path[PATH_MAX];
-  MultiByteToWideChar(CP_UTF8, 0, resolved_path, -1, wide_path, PATH_MAX);
-  CHECK_ORT_STATUS(g_ort->CreateSession(
-      cached->env, wide_path, cached->session_options, &cached->session));
+    /* Convert path to wide string for Windows */
+    wchar_t wide_path[PATH_MAX];
+    to_wide_path(session_path, wide_path);
+    OrtStatus *status = g_ort->CreateSession(
+        g_env, wide_path, entry->session_options, &entry->session);
 #else
-  CHECK_ORT_STATUS(g_ort->CreateSession(
-      cached->env, resolved_path, cached->session_options, &cached->session));
+    OrtStatus *status = g_ort->CreateSession(
+        g_env, session_path, entry->session_options, &entry->session);
+#endif
+    if (status == NULL)
+      return 0;
+
+    SAVE_ERROR("ORT Error: %s", g_ort->GetErrorMessage(status));
+    g_ort->ReleaseStatus(status);
+    g_ort->ReleaseSessionOptions(entry->session_options);
+    entry->session_options = NULL;
+    entry->session = NULL;
+
+    /* Nothing to fall back from if no provider was enabled */
+    if (entry->execution_provider == FASTEMBED_EP_CPU)
+      break;
+  }
+  return -1;
+}
+
+/**
+ * @brief Load the tokenizer for a model entry
+ *
+ * Uses options.tokenizer_path if set. Otherwise looks for tokenizer.json,
+ * then vocab.txt, in the model directory and its parent (Hugging Face
+ * exports keep model.onnx in an onnx/ subdirectory). Discovered files that
+ * cannot be loaded (e.g. BPE tokenizers) are skipped; without a vocabulary
+ * the entry falls back to simple_tokenize().
+ *
+ * @param entry Entry with options set
+ * @param resolved_path Resolved path to .onnx model file
+ * @return 0 on success (including fallback), -1 if tokenizer_path is set but
+ * cannot be loaded
+ */
+static int load_entry_tokenizer(ModelEntry *entry, const char *resolved_path) {
+  static const char *const candidates[] = {"tokenizer.json", "vocab.txt",
+                                           "../tokenizer.json",
+                                           "../vocab.txt"};
+
+  if (entry->options.tokenizer_path != NULL) {
+    entry->tokenizer = fastembed_tokenizer_load(entry->options.tokenizer_path);
+    if (entry->tokenizer == NULL) {
+      SAVE_ERROR("Failed to load tokenizer (vocab.txt or WordPiece "
+                 "tokenizer.json expected): %s",
+                 entry->options.tokenizer_path);
+      return -1;
+    }
+  } else {
+    char directory[PATH_MAX];
+    char candidate[PATH_MAX];
+    snprintf(directory, sizeof(directory), "%s", resolved_path);
+    char *separator = strrchr(directory, '/');
+#ifdef _WIN32
+    char *backslash = strrchr(directory, '\\');
+    if (backslash != NULL && (separator == NULL || backslash > separator))
+      separator = backslash;
 #endif
+    if (separator == NULL)
+      return 0;
+    *separator = '\0';
+
+    for (size_t i = 0;
+         i < sizeof(candidates) / sizeof(candidates[0]) && !entry->tokenizer;
+         i++) {
+      int written = snprintf(candidate, sizeof(candidate), "%s/%s", directory,
+                             candidates[i]);
+      if (written > 0 && (size_t)written < sizeof(candidate))
+        entry->tokenizer = fastembed_tokenizer_load(candidate);
+    }
+  }
+
+  entry->pad_token_id = entry->tokenizer
+                            ? fastembed_tokenizer_get_pad_id(entry->tokenizer)
+                            : FASTEMBED_PAD_TOKEN_ID;
+  return 0;
+}
+
+/**
+ * @brief Load an ONNX model into a new (unregistered) entry
+ *
+ * Loads the tokenizer, creates the session and caches the output name and
+ * output dimension. Called with g_load_mutex held.
+ *
+ * @param resolved_path Resolved path to .onnx model file
+ * @param options Validated session options (copied into the entry)
+ * @return New entry on success, NULL on error
+ */
+static ModelEntry *load_model_entry(const char *resolved_path,
+                                    const fastembed_onnx_options_t *options) {
+  ModelEntry *entry = (ModelEntry *)calloc(1, sizeof(ModelEntry));
+  if (entry == NULL) {
+    SAVE_ERROR("Failed to allocate model entry for: %.400s", resolved_path);
+    return NULL;
+  }
+  fastembed_mutex_t mutex_init = FASTEMBED_MUTEX_INITIALIZER;
+  entry->context_mutex = mutex_init;
+  entry->output_dimension = -1; /* Initialize as unknown */
+  entry->output_type = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+
+  /* Keep a private copy of the options (the caller owns the path string) */
+  entry->options = *options;
+  if (options->optimized_model_path != NULL) {
+    entry->optimized_model_path = copy_string(options->optimized_model_path);
+    if (entry->optimized_model_path == NULL) {
+      SAVE_ERROR("Failed to allocate optimized model path");
+      goto cleanup;
+    }
+  }
+  entry->options.optimized_model_path = entry->optimized_model_path;
+  if (options->tokenizer_path != NULL) {
+    entry->tokenizer_path = copy_string(options->tokenizer_path);
+    if (entry->tokenizer_path == NULL) {
+      SAVE_ERROR("Failed to allocate tokenizer path");
+      goto cleanup;
+    }
+  }
+  entry->options.tokenizer_path = entry->tokenizer_path;
+
+  if (load_entry_tokenizer(entry, resolved_path) != 0)
+    goto cleanup;
 
-  /* Get allocator */
-  CHECK_ORT_STATUS(g_ort->GetAllocatorWithDefaultOptions(&cached->allocator));
+  if (create_entry_session(entry, resolved_path) != 0)
+    goto cleanup;
 
   /* Get output name (cache it) */
   size_t num_output_nodes = 0;
   CHECK_ORT_STATUS(
-      g_ort->SessionGetOutputCount(cached->session, &num_output_nodes));
+      g_ort->SessionGetOutputCount(entry->session, &num_output_nodes));
 
   if (num_output_nodes > 0) {
     CHECK_ORT_STATUS(g_ort->SessionGetOutputName(
-        cached->session, 0, cached->allocator, &cached->output_name));
+        entry->session, 0, g_allocator, &entry->output_name));
   }
 
-  if (cached->output_name == NULL) {
-    fprintf(stderr, "Failed to get output name from model\n");
-    return -1;
+  if (entry->output_name == NULL) {
+    SAVE_ERROR("Failed to get output name from model: %.400s", resolved_path);
+    goto cleanup;
   }
 
   /* Get output dimension from model metadata */
   OrtTypeInfo *type_info = NULL;
-  OrtTensorTypeAndShapeInfo *tensor_info = NULL;
-  cached->output_dimension = -1; /* Initialize as unknown */
-
   CHECK_ORT_STATUS(
-      g_ort->SessionGetOutputTypeInfo(cached->session, 0, &type_info));
+      g_ort->SessionGetOutputTypeInfo(entry->session, 0, &type_info));
 
   if (type_info != NULL) {
     const OrtTensorTypeAndShapeInfo *tensor_info_const = NULL;
-    CHECK_ORT_STATUS(
-        g_ort->CastTypeInfoToTensorInfo(type_info, &tensor_info_const));
+    OrtStatus *status =
+        g_ort->CastTypeInfoToTensorInfo(type_info, &tensor_info_const);
 
-    if (tensor_info_const != NULL) {
+    if (status == NULL && tensor_info_const != NULL) {
       size_t num_dims = 0;
-      CHECK_ORT_STATUS(g_ort->GetDimensionsCount(tensor_info_const, &num_dims));
-
-      if (num_dims >= 2) {
-        /* Output shape is typically [batch_size, sequence_length, hidden_dim]
-         * or [batch_size, hidden_dim] */
-        /* For embeddings, we want the last dimension (hidden_dim) */
-        int64_t *dims = (int64_t *)malloc(num_dims * sizeof(int64_t));
-        if (dims != NULL) {
-          CHECK_ORT_STATUS(
-              g_ort->GetDimensions(tensor_info_const, dims, num_dims));
-          /* Get last dimension (embedding dimension) */
-          cached->output_dimension = (int)dims[num_dims - 1];
-          free(dims);
+      status = g_ort->GetDimensionsCount(tensor_info_const, &num_dims);
+
+      /* Output shape is typically [batch_size, sequence_length, hidden_dim]
+       * or [batch_size, hidden_dim]; the last dimension is the embedding
+       * dimension */
+      if (status == NULL && num_dims >= 1 && num_dims <= 8) {
+        int64_t dims[8];
+        status = g_ort->GetDimensions(tensor_info_const, dims, num_dims);
+        if (status == NULL) {
+          entry->output_dimension = (int)dims[num_dims - 1];
+          entry->output_rank = (int)num_dims;
         }
-      } else if (num_dims == 1) {
-        /* Single dimension output */
-        int64_t dim = 0;
-        CHECK_ORT_STATUS(g_ort->GetDimensions(tensor_info_const, &dim, 1));
-        cached->output_dimension = (int)dim;
       }
+
+      /* fp16 / bf16 exports are bound as such and widened after Run() */
+      ONNXTensorElementDataType element_type =
+          ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+      if (status == NULL)
+        status = g_ort->GetTensorElementType(tensor_info_const, &element_type);
+      if (status == NULL && is_half_output(element_type))
+        entry->output_type = element_type;
     }
 
-    if (type_info) {
-      g_ort->ReleaseTypeInfo(type_info);
+    if (status != NULL) {
+      SAVE_ERROR("ORT Error: %s", g_ort->GetErrorMessage(status));
+      g_ort->ReleaseStatus(status);
     }
+    g_ort->ReleaseTypeInfo(type_info);
   }
 
-  /* Save resolved path and mark as loaded */
-  strncpy(cached->model_path, resolved_path, MAX_MODEL_PATH - 1);
-  cached->model_path[MAX_MODEL_PATH - 1] = '\0';
-  cached->is_loaded = 1;
+  entry->model_path = copy_string(resolved_path);
+  if (entry->model_path == NULL) {
+    SAVE_ERROR("Failed to allocate model path for: %.400s", resolved_path);
+    goto cleanup;
+  }
 
-  return 0;
+  return entry;
 
 cleanup:
   /* Cleanup on error */
-  if (cached->session) {
-    g_ort->ReleaseSession(cached->session);
-    cached->session = NULL;
+  destroy_model_entry(entry);
+  return NULL;
+}
+
+/**
+ * @brief Evict least recently used idle entries above the capacity
+ *
+ * Entries referenced by open handles or in-flight calls are never evicted,
+ * so the registry can temporarily hold more than g_registry_capacity models.
+ * Called with g_registry_mutex held; evicted entries are appended to
+ * *evicted so they can be destroyed after the lock is released.
+ */
+static void evict_idle_entries(ModelEntry **evicted) {
+  while (g_registry_count > g_registry_capacity) {
+    ModelEntry **victim_link = NULL;
+    for (ModelEntry **link = &g_registry; *link; link = &(*link)->next) {
+      if ((*link)->refcount == 0 &&
+          (victim_link == NULL || (*link)->last_used < (*victim_link)->last_used))
+        victim_link = link;
+    }
+    if (victim_link == NULL)
+      return; /* Everything is in use */
+
+    ModelEntry *victim = *victim_link;
+    *victim_link = victim->next;
+    victim->in_registry = 0;
+    victim->next = *evicted;
+    *evicted = victim;
+    g_registry_count--;
+  }
+}
+
+/**
+ * @brief Destroy a list of evicted entries (outside the registry lock)
+ */
+static void destroy_entry_list(ModelEntry *list) {
+  while (list != NULL) {
+    ModelEntry *next = list->next;
+    destroy_model_entry(list);
+    list = next;
+  }
+}
+
+/**
+ * @brief Check whether a path is absolute (cwd-independent)
+ */
+static int is_absolute_path(const char *path) {
+#ifdef _WIN32
+  return (path[0] == '\\' || path[0] == '/') ||
+         (isalpha((unsigned char)path[0]) && path[1] == ':' &&
+          (path[2] == '\\' || path[2] == '/'));
+#else
+  return path[0] == '/';
+#endif
+}
+
+/**
+ * @brief Find a registered entry by path and take a reference
+ *
+ * Called with g_registry_mutex held.
+ *
+ * @param path Path to match
+ * @param match_open_path Non-zero to match the caller-supplied alias,
+ * zero to match the resolved path
+ * @param options Session options the entry must have been created with
+ * @return Referenced entry, or NULL if not registered
+ */
+static ModelEntry *find_and_ref_entry(const char *path, int match_open_path,
+                                      const fastembed_onnx_options_t *options) {
+  for (ModelEntry *entry = g_registry; entry; entry = entry->next) {
+    const char *key = match_open_path ? entry->open_path : entry->model_path;
+    if (key && strcmp(key, path) == 0 &&
+        options_equal(&entry->options, options)) {
+      entry->refcount++;
+      entry->last_used = ++g_registry_tick;
+      return entry;
+    }
   }
-  if (cached->session_options) {
-    g_ort->ReleaseSessionOptions(cached->session_options);
-    cached->session_options = NULL;
+  return NULL;
+}
+
+/**
+ * @brief Get a referenced session for a model path, loading it if needed
+ *
+ * Looks the path up in the registry (first as given, then resolved), and
+ * loads the model on a miss. Every successful call must be paired with
+ * release_model_entry().
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Session options (NULL = defaults)
+ * @return Referenced entry on success, NULL on error
+ */
+static ModelEntry *acquire_model_entry(const char *model_path,
+                                       const fastembed_onnx_options_t *options) {
+  ModelEntry *entry = NULL;
+  fastembed_onnx_options_t default_options;
+  uint64_t start = stats_now();
+
+  if (options == NULL) {
+    fastembed_onnx_options_init(&default_options);
+    options = &default_options;
+  } else if (validate_options(options) != 0) {
+    return NULL;
   }
-  if (cached->memory_info) {
-    g_ort->ReleaseMemoryInfo(cached->memory_info);
-    cached->memory_info = NULL;
+
+  /* Fast path: same absolute path string as a previous open, no filesystem
+   * access. Relative paths are always resolved since the working directory
+   * may have changed. */
+  if (is_absolute_path(model_path)) {
+    fastembed_mutex_lock(&g_registry_mutex);
+    entry = find_and_ref_entry(model_path, 1, options);
+    fastembed_mutex_unlock(&g_registry_mutex);
+    if (entry != NULL) {
+      stats_record_stage(FASTEMBED_STAGE_RESOLVE, start);
+      return entry;
+    }
   }
-  return -1;
+
+  char resolved_path[PATH_MAX];
+
+  /* Resolve model path */
+#ifdef _WIN32
+  if (_fullpath(resolved_path, model_path, PATH_MAX) == NULL)
+#else
+  if (realpath(model_path, resolved_path) == NULL)
+#endif
+  {
+    SAVE_ERROR("Model file not found or cannot resolve path: %s", model_path);
+    return NULL;
+  }
+
+  fastembed_mutex_lock(&g_load_mutex);
+
+  /* Another thread may have loaded it while we waited */
+  fastembed_mutex_lock(&g_registry_mutex);
+  entry = find_and_ref_entry(resolved_path, 0, options);
+  fastembed_mutex_unlock(&g_registry_mutex);
+  /* Includes waiting for another thread's model load */
+  uint64_t load_start = stats_record_stage(FASTEMBED_STAGE_RESOLVE, start);
+
+  if (entry == NULL) {
+    if (init_shared_state() != 0) {
+      fastembed_mutex_unlock(&g_load_mutex);
+      return NULL;
+    }
+
+    /* Load outside the registry lock: other models stay usable */
+    entry = load_model_entry(resolved_path, options);
+    if (entry == NULL) {
+      fastembed_mutex_unlock(&g_load_mutex);
+      return NULL;
+    }
+    stats_record_stage(FASTEMBED_STAGE_LOAD, load_start);
+    entry->open_path =
+        is_absolute_path(model_path) ? copy_string(model_path) : NULL;
+
+    ModelEntry *evicted = NULL;
+    fastembed_mutex_lock(&g_registry_mutex);
+    entry->refcount = 1;
+    entry->in_registry = 1;
+    entry->last_used = ++g_registry_tick;
+    entry->next = g_registry;
+    g_registry = entry;
+    g_registry_count++;
+    evict_idle_entries(&evicted);
+    fastembed_mutex_unlock(&g_registry_mutex);
+    destroy_entry_list(evicted);
+  }
+
+  fastembed_mutex_unlock(&g_load_mutex);
+  return entry;
+}
+
+/**
+ * @brief Drop a reference taken by acquire_model_entry()
+ *
+ * Idle entries stay cached; entries already removed from the registry
+ * (onnx_unload_model() while in use) are destroyed with the last reference.
+ */
+static void release_model_entry(ModelEntry *entry) {
+  if (entry == NULL)
+    return;
+
+  ModelEntry *evicted = NULL;
+  int destroy = 0;
+
+  fastembed_mutex_lock(&g_registry_mutex);
+  entry->refcount--;
+  if (entry->refcount == 0) {
+    if (!entry->in_registry)
+      destroy = 1;
+    else
+      evict_idle_entries(&evicted);
+  }
+  fastembed_mutex_unlock(&g_registry_mutex);
+
+  if (destroy)
+    destroy_model_entry(entry);
+  destroy_entry_list(evicted);
 }
 
 /**
  * @brief Simple tokenization (word-based with hash for IDs)
  *
  * Converts text into token IDs using a simple word-based tokenization strategy.
- * This is a placeholder for proper tokenization (e.g., WordPiece, BPE).
+ * Fallback for models without a vocabulary file: the IDs do not match the
+ * model's embedding table.
  *
  * @param text Input text to tokenize
  * @param token_ids Output array of token IDs (must be pre-allocated)
@@ -426,6 +1194,26 @@ static int simple_tokenize(const char *text, int64_t *token_ids,
   return token_count;
 }
 
+/**
+ * @brief Tokenize text for a model
+ *
+ * Uses the model's WordPiece tokenizer, or simple_tokenize() when the model
+ * has no vocabulary.
+ *
+ * @param model Model entry
+ * @param text Input text to tokenize
+ * @param token_ids Output array of token IDs (must be pre-allocated)
+ * @param max_length Maximum sequence length
+ * @return Number of tokens generated, or -1 on error
+ */
+static int tokenize_text(const ModelEntry *model, const char *text,
+                         int64_t *token_ids, int max_length) {
+  if (model->tokenizer != NULL)
+    return fastembed_tokenizer_encode(model->tokenizer, text, token_ids,
+                                      max_length);
+  return simple_tokenize(text, token_ids, max_length);
+}
+
 /**
  * @brief L2 normalize vector in-place
  *
@@ -453,240 +1241,2618 @@ static void normalize_l2(float *vec, int dim) {
 }
 
 /**
- * @brief Generate embedding using ONNX Runtime model (STANDARD C API)
+ * @brief Pool one row of token embeddings into a normalized embedding
  *
- * Loads an ONNX embedding model and generates embeddings for the input text.
- * The function performs tokenization, runs inference, extracts the [CLS] token
- * embedding, and normalizes the result.
+ * Reduces the [seq_len, hidden_dim] token embeddings of one text directly
+ * in the output tensor, skipping tokens whose attention mask is 0. Only the
+ * first output_dim features of each token are read, and the loops run over
+ * contiguous features so they vectorize. Mean pooling leaves out the
+ * division by the token count because the L2 normalization cancels it.
  *
- * @param model_path Path to .onnx model file
- * @param text Input text to embed (null-terminated string)
- * @param output Output array for embedding vector (must be pre-allocated)
- * @param output_dim Requested output dimension (must match model output)
- * @return 0 on success, -1 on error
+ * @param pooling Pooling mode (fastembed_pooling_t)
+ * @param tokens Token embeddings of one row (seq_len * hidden_dim)
+ * @param attention_mask Attention mask of the row (seq_len elements)
+ * @param seq_len Padded sequence length
+ * @param hidden_dim Hidden size (row stride of tokens)
+ * @param output Output array (size >= output_dim)
+ * @param output_dim Number of features to pool
  */
-int onnx_generate_embedding(const char *model_path, const char *text,
-                            float *output, int output_dim) {
-  /* Clear previous error */
-  g_last_error[0] = '\0';
+static void pool_token_embeddings(int pooling, const float *tokens,
+                                  const int64_t *attention_mask, int seq_len,
+                                  int hidden_dim, float *output,
+                                  int output_dim) {
+  int selected = 0; /* CLS: first token */
+
+  if (pooling == FASTEMBED_POOLING_MEAN || pooling == FASTEMBED_POOLING_MAX) {
+    int pooled = 0;
+    for (int t = 0; t < seq_len; t++) {
+      if (attention_mask[t] == 0)
+        continue;
+      const float *token = tokens + (size_t)t * hidden_dim;
+      if (!pooled) {
+        memcpy(output, token, output_dim * sizeof(float));
+        pooled = 1;
+      } else if (pooling == FASTEMBED_POOLING_MEAN) {
+        for (int h = 0; h < output_dim; h++)
+          output[h] += token[h];
+      } else {
+        for (int h = 0; h < output_dim; h++)
+          output[h] = token[h] > output[h] ? token[h] : output[h];
+      }
+    }
+    if (!pooled)
+      memset(output, 0, output_dim * sizeof(float));
+    normalize_l2(output, output_dim);
+    return;
+  }
 
-  /* Validate inputs */
-  if (!model_path || !text || !output || output_dim <= 0 ||
-      output_dim > MAX_OUTPUT_DIM) {
-    SAVE_ERROR("Invalid input parameters: model_path=%p, text=%p, output=%p, "
-               "output_dim=%d",
-               model_path, text, output, output_dim);
-    fprintf(stderr, "Invalid input parameters\n");
-    return -1;
+  if (pooling == FASTEMBED_POOLING_LAST_TOKEN) {
+    for (int t = 0; t < seq_len; t++) {
+      if (attention_mask[t] != 0)
+        selected = t;
+    }
   }
+  memcpy(output, tokens + (size_t)selected * hidden_dim,
+         output_dim * sizeof(float));
+  normalize_l2(output, output_dim);
+}
 
-  /* Initialize ONNX Runtime API */
-  if (init_onnx_api() != 0) {
-    SAVE_ERROR("Failed to initialize ONNX Runtime API - check if "
-               "onnxruntime.dll is available");
-    fprintf(stderr, "Failed to initialize ONNX Runtime API\n");
-    return -1;
+/**
+ * @brief Take an inference context from the model's pool (or create one)
+ *
+ * @param model Loaded session (referenced by the caller)
+ * @return Context owned by the caller until release_inference_context(),
+ * NULL on allocation failure (error message saved)
+ */
+static InferenceContext *acquire_inference_context(ModelEntry *model) {
+  fastembed_mutex_lock(&model->context_mutex);
+  InferenceContext *ctx = model->idle_contexts;
+  if (ctx != NULL) {
+    model->idle_contexts = ctx->next;
+    model->idle_context_count--;
+  }
+  fastembed_mutex_unlock(&model->context_mutex);
+  if (ctx != NULL)
+    return ctx;
+
+  ctx = (InferenceContext *)calloc(1, sizeof(InferenceContext));
+  if (ctx == NULL) {
+    SAVE_ERROR("Failed to allocate inference context");
+    return NULL;
+  }
+  ctx->schedule =
+      malloc((size_t)FASTEMBED_ONNX_SCHEDULE_WINDOW * sizeof(*ctx->schedule));
+  ctx->scratch = (int64_t *)malloc(MAX_SEQUENCE_LENGTH * sizeof(int64_t));
+  if (ctx->schedule == NULL || ctx->scratch == NULL) {
+    SAVE_ERROR("Failed to allocate scheduler buffers");
+    destroy_inference_context(ctx);
+    return NULL;
   }
 
-  /* Load or get cached session */
-  if (load_or_get_cached_session(model_path, &g_cached_session) != 0) {
-    SAVE_ERROR("Failed to load model session for: %s", model_path);
-    fprintf(stderr, "Failed to load model session\n");
-    return -1;
+  OrtStatus *status = g_ort->CreateIoBinding(model->session, &ctx->binding);
+  if (status != NULL) {
+    SAVE_ERROR("ORT Error: %s", g_ort->GetErrorMessage(status));
+    g_ort->ReleaseStatus(status);
+    destroy_inference_context(ctx);
+    return NULL;
+  }
+
+  /* Preallocated outputs need the output layout known up front */
+  ctx->bind_output = (model->output_rank == 2 || model->output_rank == 3) &&
+                     model->output_dimension > 0;
+  return ctx;
+}
+
+/**
+ * @brief Return an inference context to the model's pool
+ *
+ * At most FASTEMBED_ONNX_MAX_IDLE_CONTEXTS are kept; extra contexts (left
+ * over from a burst of concurrent calls) are freed.
+ */
+static void release_inference_context(ModelEntry *model,
+                                      InferenceContext *ctx) {
+  if (ctx == NULL)
+    return;
+
+  fastembed_mutex_lock(&model->context_mutex);
+  int keep = model->idle_context_count < FASTEMBED_ONNX_MAX_IDLE_CONTEXTS;
+  if (keep) {
+    ctx->next = model->idle_contexts;
+    model->idle_contexts = ctx;
+    model->idle_context_count++;
   }
+  fastembed_mutex_unlock(&model->context_mutex);
 
-  /* Use cached session resources */
-  OrtSession *session = g_cached_session.session;
-  OrtMemoryInfo *memory_info = g_cached_session.memory_info;
-  const char *output_name = g_cached_session.output_name;
+  if (!keep)
+    destroy_inference_context(ctx);
+}
 
-  OrtValue *input_tensor = NULL;
-  OrtValue *token_type_tensor = NULL;
-  OrtValue *attention_mask_tensor = NULL;
-  OrtValue *output_tensor = NULL;
+/**
+ * @brief Grow a context buffer to hold at least count elements
+ *
+ * Capacity doubles so buffers settle after a few calls.
+ *
+ * @return 0 on success, -1 on allocation failure (buffer left unchanged)
+ */
+static int reserve_buffer(void **buffer, size_t *capacity, size_t count,
+                          size_t elem_size) {
+  if (count <= *capacity)
+    return 0;
+
+  size_t grown_capacity = *capacity ? *capacity * 2 : 4096;
+  while (grown_capacity < count)
+    grown_capacity *= 2;
+  void *grown = realloc(*buffer, grown_capacity * elem_size);
+  if (grown == NULL)
+    return -1;
+  *buffer = grown;
+  *capacity = grown_capacity;
+  return 0;
+}
 
+/**
+ * @brief Bind ctx->batch_inputs as [batch, seq_len] input tensors
+ *
+ * Tensors are only recreated when the shape or the buffer changed since the
+ * last call on this context.
+ *
+ * @return 0 on success, -1 on error
+ */
+static int bind_context_inputs(InferenceContext *ctx, int batch_size,
+                               int seq_len) {
+  static const char *const input_names[3] = {"input_ids", "attention_mask",
+                                             "token_type_ids"};
   int result = -1;
 
-  /* Tokenize input text */
-  int64_t input_ids[MAX_SEQUENCE_LENGTH];
-  int sequence_length = simple_tokenize(text, input_ids, MAX_SEQUENCE_LENGTH);
-  if (sequence_length < 0) {
-    SAVE_ERROR("Failed to tokenize text (length: %zu)", strlen(text));
-    fprintf(stderr, "Failed to tokenize text\n");
-    goto cleanup;
+  if (ctx->input_tensors[0] != NULL && ctx->input_data == ctx->batch_inputs &&
+      ctx->input_shape[0] == batch_size && ctx->input_shape[1] == seq_len)
+    return 0;
+
+  g_ort->ClearBoundInputs(ctx->binding);
+  for (int i = 0; i < 3; i++) {
+    if (ctx->input_tensors[i]) {
+      g_ort->ReleaseValue(ctx->input_tensors[i]);
+      ctx->input_tensors[i] = NULL;
+    }
+  }
+  ctx->input_data = NULL;
+
+  size_t elems = (size_t)batch_size * seq_len;
+  int64_t input_shape[2] = {batch_size, seq_len};
+  for (int i = 0; i < 3; i++) {
+    CHECK_ORT_STATUS(g_ort->CreateTensorWithDataAsOrtValue(
+        g_memory_info, ctx->batch_inputs + elems * i, elems * sizeof(int64_t),
+        input_shape, 2, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64,
+        &ctx->input_tensors[i]));
+    CHECK_ORT_STATUS(
+        g_ort->BindInput(ctx->binding, input_names[i], ctx->input_tensors[i]));
   }
 
-  /* Create token_type_ids (all zeros for single sequence) */
-  int64_t token_type_ids[MAX_SEQUENCE_LENGTH];
-  memset(token_type_ids, 0, sequence_length * sizeof(int64_t));
+  ctx->input_data = ctx->batch_inputs;
+  ctx->input_shape[0] = batch_size;
+  ctx->input_shape[1] = seq_len;
+  result = 0;
 
-  /* Create attention_mask (all ones) */
-  int64_t attention_mask_arr[MAX_SEQUENCE_LENGTH];
-  for (int i = 0; i < sequence_length; i++)
-    attention_mask_arr[i] = 1;
+cleanup:
+  return result;
+}
 
-  /* Prepare input arrays */
-  const char *input_names[3] = {"input_ids", "token_type_ids",
-                                "attention_mask"};
-  const OrtValue *inputs[3];
-  size_t actual_input_count = 3;
+/**
+ * @brief Bind a preallocated buffer as the session output
+ *
+ * The tensor is only recreated when the buffer or shape changed.
+ *
+ * @param data Buffer holding the whole output tensor (floats, or uint16_t
+ * values for fp16 / bf16 models)
+ * @param shape Output shape (model->output_rank dimensions)
+ * @return 0 on success, -1 on error
+ */
+static int bind_context_output(ModelEntry *model, InferenceContext *ctx,
+                               void *data, const int64_t *shape) {
+  size_t rank = (size_t)model->output_rank;
+  size_t count = 1;
+  int result = -1;
 
-  /* Create input tensors */
-  int64_t input_shape[2] = {1, sequence_length};
+  if (ctx->output_tensor != NULL && ctx->output_data == data &&
+      memcmp(ctx->output_shape, shape, rank * sizeof(int64_t)) == 0)
+    return 0;
 
-  CHECK_ORT_STATUS(g_ort->CreateTensorWithDataAsOrtValue(
-      memory_info, input_ids, sequence_length * sizeof(int64_t), input_shape, 2,
-      ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &input_tensor));
+  g_ort->ClearBoundOutputs(ctx->binding);
+  ctx->output_on_device = 0;
+  if (ctx->output_tensor) {
+    g_ort->ReleaseValue(ctx->output_tensor);
+    ctx->output_tensor = NULL;
+  }
+  ctx->output_data = NULL;
 
+  for (size_t i = 0; i < rank; i++)
+    count *= (size_t)shape[i];
+  size_t element_size =
+      is_half_output(model->output_type) ? sizeof(uint16_t) : sizeof(float);
   CHECK_ORT_STATUS(g_ort->CreateTensorWithDataAsOrtValue(
-      memory_info, token_type_ids, sequence_length * sizeof(int64_t),
-      input_shape, 2, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &token_type_tensor));
+      g_memory_info, data, count * element_size, shape, rank,
+      (ONNXTensorElementDataType)model->output_type, &ctx->output_tensor));
+  CHECK_ORT_STATUS(
+      g_ort->BindOutput(ctx->binding, model->output_name, ctx->output_tensor));
 
-  CHECK_ORT_STATUS(g_ort->CreateTensorWithDataAsOrtValue(
-      memory_info, attention_mask_arr, sequence_length * sizeof(int64_t),
-      input_shape, 2, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64,
-      &attention_mask_tensor));
-
-  /* Populate input arrays */
-  inputs[0] = input_tensor;
-  inputs[1] = token_type_tensor;
-  inputs[2] = attention_mask_tensor;
-
-  /* Run inference using standard API */
-  const char *output_names_arr[1] = {output_name};
-  CHECK_ORT_STATUS(g_ort->Run(session, NULL, input_names, inputs,
-                              actual_input_count, output_names_arr, 1,
-                              &output_tensor));
-
-  if (output_tensor == NULL) {
-    SAVE_ERROR("Inference failed: output tensor is NULL after Run()");
-    fprintf(stderr, "Inference failed: output tensor is NULL\n");
+  ctx->output_data = data;
+  memcpy(ctx->output_shape, shape, rank * sizeof(int64_t));
+  result = 0;
+
+cleanup:
+  return result;
+}
+
+/**
+ * @brief Check whether an ORT error message reports a shape mismatch
+ *
+ * ORT rejects a preallocated output whose shape differs from the one the
+ * model produces ("Shape mismatch attempting to re-use buffer ...").
+ */
+static int is_shape_error(const char *message) {
+  static const char word[] = "shape";
+  for (const char *p = message; p != NULL && *p != '\0'; p++) {
+    size_t i = 0;
+    while (word[i] != '\0' &&
+           tolower((unsigned char)p[i]) == (unsigned char)word[i])
+      i++;
+    if (word[i] == '\0')
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Run with ORT-allocated outputs and copy embeddings out
+ *
+ * Fallback for models whose output layout is not known up front or that
+ * reject a preallocated output tensor.
+ *
+ * @param start stats_now() at the start of binding
+ * @param out_dims If not NULL, receives the produced output shape (unused
+ * trailing entries are 0)
+ * @param out_rank If not NULL, receives the produced output rank
+ * @return 0 on success, -1 on error
+ */
+static int run_with_device_output(ModelEntry *model, InferenceContext *ctx,
+                                  int batch_size, int seq_len, float **outputs,
+                                  int output_dim, uint64_t start,
+                                  int64_t *out_dims, size_t *out_rank) {
+  OrtValue **bound_outputs = NULL;
+  size_t bound_count = 0;
+  OrtTensorTypeAndShapeInfo *output_info = NULL;
+  int result = -1;
+
+  if (!ctx->output_on_device) {
+    g_ort->ClearBoundOutputs(ctx->binding);
+    if (ctx->output_tensor) {
+      g_ort->ReleaseValue(ctx->output_tensor);
+      ctx->output_tensor = NULL;
+    }
+    ctx->output_data = NULL;
+    CHECK_ORT_STATUS(g_ort->BindOutputToDevice(
+        ctx->binding, model->output_name, g_memory_info));
+    ctx->output_on_device = 1;
+  }
+
+  start = stats_record_stage(FASTEMBED_STAGE_BIND, start);
+  CHECK_ORT_STATUS(g_ort->RunWithBinding(model->session, NULL, ctx->binding));
+  start = stats_record_stage(FASTEMBED_STAGE_RUN, start);
+  CHECK_ORT_STATUS(g_ort->GetBoundOutputValues(ctx->binding, g_allocator,
+                                               &bound_outputs, &bound_count));
+
+  if (bound_count < 1 || bound_outputs[0] == NULL) {
+    SAVE_ERROR("Inference failed: no output tensor after Run()");
+    goto cleanup;
+  }
+
+  /* Inspect actual output shape to locate each row's embedding */
+  CHECK_ORT_STATUS(
+      g_ort->GetTensorTypeAndShape(bound_outputs[0], &output_info));
+
+  size_t num_dims = 0;
+  int64_t dims[3] = {0, 0, 0};
+  CHECK_ORT_STATUS(g_ort->GetDimensionsCount(output_info, &num_dims));
+  if (num_dims != 2 && num_dims != 3) {
+    SAVE_ERROR("Unsupported output tensor rank: %zu (expected 2 or 3)",
+               num_dims);
+    goto cleanup;
+  }
+  CHECK_ORT_STATUS(g_ort->GetDimensions(output_info, dims, num_dims));
+  if (out_dims)
+    memcpy(out_dims, dims, sizeof(dims));
+  if (out_rank)
+    *out_rank = num_dims;
+
+  int64_t hidden_dim = dims[num_dims - 1];
+  /* [N, L, H]: one [L, H] block per row; [N, H]: one row each */
+  size_t row_stride =
+      (num_dims == 3) ? (size_t)(dims[1] * dims[2]) : (size_t)dims[1];
+
+  if (dims[0] != batch_size || hidden_dim < output_dim) {
+    SAVE_ERROR("Unexpected output shape: batch=%lld hidden=%lld (expected "
+               "batch=%d, hidden>=%d)",
+               (long long)dims[0], (long long)hidden_dim, batch_size,
+               output_dim);
+    goto cleanup;
+  }
+
+  if (num_dims == 3 && dims[1] != seq_len) {
+    SAVE_ERROR("Unexpected output sequence length: %lld (expected %d)",
+               (long long)dims[1], seq_len);
+    goto cleanup;
+  }
+
+  ONNXTensorElementDataType element_type =
+      ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+  CHECK_ORT_STATUS(g_ort->GetTensorElementType(output_info, &element_type));
+  if (element_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT &&
+      !is_half_output(element_type)) {
+    SAVE_ERROR("Unsupported output element type: %d (expected float, "
+               "float16 or bfloat16)",
+               (int)element_type);
     goto cleanup;
   }
 
-  /* Extract embeddings from output tensor */
   float *output_data = NULL;
   CHECK_ORT_STATUS(
-      g_ort->GetTensorMutableData(output_tensor, (void **)&output_data));
+      g_ort->GetTensorMutableData(bound_outputs[0], (void **)&output_data));
+
+  if (is_half_output(element_type)) {
+    size_t count = (size_t)dims[0] * row_stride;
+    if (reserve_buffer((void **)&ctx->output_buffer, &ctx->output_capacity,
+                       count, sizeof(float)) != 0) {
+      SAVE_ERROR("Failed to allocate output buffer (%zu values)", count);
+      goto cleanup;
+    }
+    if (widen_half_output(element_type, (const uint16_t *)output_data,
+                          ctx->output_buffer, count) != 0) {
+      SAVE_ERROR("Failed to convert half-precision output");
+      goto cleanup;
+    }
+    output_data = ctx->output_buffer;
+  }
 
-  /* Extract [CLS] token embedding (first token) */
-  if (output_dim <= MAX_OUTPUT_DIM) {
-    memcpy(output, output_data, output_dim * sizeof(float));
-    normalize_l2(output, output_dim);
+  const int64_t *attention_mask =
+      ctx->batch_inputs + (size_t)batch_size * seq_len;
+  for (int b = 0; b < batch_size; b++) {
+    if (num_dims == 3) {
+      pool_token_embeddings(model->options.pooling,
+                            output_data + (size_t)b * row_stride,
+                            attention_mask + (size_t)b * seq_len, seq_len,
+                            (int)hidden_dim, outputs[b], output_dim);
+    } else {
+      memcpy(outputs[b], output_data + (size_t)b * row_stride,
+             output_dim * sizeof(float));
+      normalize_l2(outputs[b], output_dim);
+    }
   }
+  stats_record_stage(FASTEMBED_STAGE_POOL, start);
 
   result = 0;
 
 cleanup:
-  /* Cleanup only tensor values (session resources are cached) */
-  if (input_tensor)
-    g_ort->ReleaseValue(input_tensor);
-  if (token_type_tensor)
-    g_ort->ReleaseValue(token_type_tensor);
-  if (attention_mask_tensor)
-    g_ort->ReleaseValue(attention_mask_tensor);
-  if (output_tensor)
-    g_ort->ReleaseValue(output_tensor);
-
+  if (output_info)
+    g_ort->ReleaseTensorTypeAndShapeInfo(output_info);
+  if (bound_outputs) {
+    for (size_t i = 0; i < bound_count; i++)
+      g_ort->ReleaseValue(bound_outputs[i]);
+    g_allocator->Free(g_allocator, bound_outputs);
+  }
   return result;
 }
 
 /**
- * @brief Unload cached model session
+ * @brief Run one padded [batch, seq_len] inference and extract embeddings
  *
- * Frees all cached resources. Can be called to free memory when done with
- * model. Subsequent calls will reload the model automatically.
+ * Inputs are read from ctx->batch_inputs (input_ids, attention_mask and
+ * token_type_ids, each batch_size * seq_len elements). The session runs
+ * once through the context's IoBinding and one embedding per row is
+ * written into outputs. Both [batch, seq_len, hidden] (last_hidden_state,
+ * reduced with the model's pooling mode) and [batch, hidden] (pooled
+ * sentence embedding) outputs are supported.
  *
- * @return 0 on success, -1 if not initialized
+ * The output is written into a preallocated buffer: the caller's own
+ * output for a single [1, hidden] row, the context's buffer otherwise. If
+ * ORT rejects the preallocated tensor with a shape error, the call is
+ * rerun with ORT-allocated outputs, and the context keeps using those only
+ * if the produced shape really differs from the bound one. Other Run()
+ * failures are returned with ORT's message.
+ *
+ * @param model Loaded session (referenced by the caller)
+ * @param ctx Inference context with inputs filled in
+ * @param batch_size Number of rows
+ * @param seq_len Padded sequence length of every row
+ * @param outputs Output arrays, one per row (each size >= output_dim)
+ * @param output_dim Number of values to copy per row
+ * @return 0 on success, -1 on error
  */
-int onnx_unload_model(void) {
-  if (g_ort == NULL) {
+static int run_padded_batch(ModelEntry *model, InferenceContext *ctx,
+                            int batch_size, int seq_len, float **outputs,
+                            int output_dim) {
+  uint64_t start = stats_now();
+  if (bind_context_inputs(ctx, batch_size, seq_len) != 0)
+    return -1;
+
+  if (!ctx->bind_output)
+    return run_with_device_output(model, ctx, batch_size, seq_len, outputs,
+                                  output_dim, start, NULL, NULL);
+
+  int hidden_dim = model->output_dimension;
+  if (hidden_dim < output_dim) {
+    SAVE_ERROR("Unexpected output shape: batch=%d hidden=%d (expected "
+               "batch=%d, hidden>=%d)",
+               batch_size, hidden_dim, batch_size, output_dim);
     return -1;
   }
 
-  if (!g_cached_session.is_loaded) {
-    return 0; /* Nothing to unload */
+  int64_t shape[3] = {batch_size, seq_len, hidden_dim};
+  size_t row_stride = (size_t)hidden_dim;
+  if (model->output_rank == 2)
+    shape[1] = hidden_dim;
+  else
+    row_stride *= (size_t)seq_len;
+
+  /* A single pooled float row can be written straight into the caller's
+   * array */
+  int half = is_half_output(model->output_type);
+  int direct = !half && model->output_rank == 2 && batch_size == 1 &&
+               output_dim == hidden_dim;
+  size_t count = (size_t)batch_size * row_stride;
+  float *data = outputs[0];
+  if (!direct) {
+    if (reserve_buffer((void **)&ctx->output_buffer, &ctx->output_capacity,
+                       count, sizeof(float)) != 0 ||
+        (half && reserve_buffer((void **)&ctx->half_buffer,
+                                &ctx->half_capacity, count,
+                                sizeof(uint16_t)) != 0)) {
+      SAVE_ERROR("Failed to allocate output buffer (%d x %zu)", batch_size,
+                 row_stride);
+      return -1;
+    }
+    data = ctx->output_buffer;
   }
 
-  /* Free cached resources */
-  if (g_cached_session.output_name && g_cached_session.allocator) {
-    g_cached_session.allocator->Free(g_cached_session.allocator,
-                                     g_cached_session.output_name);
-    g_cached_session.output_name = NULL;
+  if (bind_context_output(model, ctx,
+                          half ? (void *)ctx->half_buffer : (void *)data,
+                          shape) != 0)
+    return -1;
+  start = stats_record_stage(FASTEMBED_STAGE_BIND, start);
+
+  OrtStatus *status =
+      g_ort->RunWithBinding(model->session, NULL, ctx->binding);
+  if (status != NULL) {
+    const char *msg = g_ort->GetErrorMessage(status);
+    if (!is_shape_error(msg)) {
+      SAVE_ERROR("ORT Error: %s", msg);
+      fprintf(stderr, "ONNX Runtime Error: %s\n", msg);
+      g_ort->ReleaseStatus(status);
+      return -1;
+    }
+    g_ort->ReleaseStatus(status);
+
+    /* Output shape may differ from the model metadata: let ORT allocate */
+    int64_t produced[3] = {0, 0, 0};
+    size_t produced_rank = 0;
+    if (run_with_device_output(model, ctx, batch_size, seq_len, outputs,
+                               output_dim, stats_now(), produced,
+                               &produced_rank) != 0)
+      return -1;
+    if (produced_rank != (size_t)model->output_rank ||
+        memcmp(produced, shape, produced_rank * sizeof(int64_t)) != 0)
+      ctx->bind_output = 0; /* Preallocated outputs cannot fit this model */
+    return 0;
   }
+  start = stats_record_stage(FASTEMBED_STAGE_RUN, start);
 
-  if (g_cached_session.session) {
-    g_ort->ReleaseSession(g_cached_session.session);
-    g_cached_session.session = NULL;
+  if (half && widen_half_output(model->output_type, ctx->half_buffer, data,
+                                count) != 0) {
+    SAVE_ERROR("Failed to convert half-precision output");
+    return -1;
   }
 
-  if (g_cached_session.session_options) {
-    g_ort->ReleaseSessionOptions(g_cached_session.session_options);
-    g_cached_session.session_options = NULL;
+  const int64_t *attention_mask =
+      ctx->batch_inputs + (size_t)batch_size * seq_len;
+  for (int b = 0; b < batch_size; b++) {
+    if (model->output_rank == 3) {
+      pool_token_embeddings(model->options.pooling,
+                            data + (size_t)b * row_stride,
+                            attention_mask + (size_t)b * seq_len, seq_len,
+                            hidden_dim, outputs[b], output_dim);
+    } else {
+      if (!direct)
+        memcpy(outputs[b], data + (size_t)b * row_stride,
+               output_dim * sizeof(float));
+      normalize_l2(outputs[b], output_dim);
+    }
   }
+  stats_record_stage(FASTEMBED_STAGE_POOL, start);
+  return 0;
+}
+
+/**
+ * @brief Compare scheduled texts by token count (index breaks ties)
+ */
+static int compare_by_token_count(const void *a, const void *b) {
+  const int *ia = (const int *)a;
+  const int *ib = (const int *)b;
+  if (ia[1] != ib[1])
+    return ia[1] < ib[1] ? -1 : 1;
+  return ia[0] < ib[0] ? -1 : (ia[0] > ib[0]);
+}
+
+/**
+ * @brief Set the padded-token budget for one batched inference call
+ *
+ * @param max_tokens Maximum batch_size * seq_len per Run() (0 = default)
+ * @return 0 on success, -1 if max_tokens is negative
+ */
+int onnx_set_batch_token_budget(int max_tokens) {
+  if (max_tokens < 0)
+    return -1;
+  g_batch_token_budget =
+      (max_tokens == 0) ? FASTEMBED_ONNX_BATCH_TOKEN_BUDGET : max_tokens;
+  return 0;
+}
 
-  if (g_cached_session.memory_info) {
-    g_ort->ReleaseMemoryInfo(g_cached_session.memory_info);
-    g_cached_session.memory_info = NULL;
+/**
+ * @brief Validate texts/outputs arrays and output dimension for batch calls
+ *
+ * @return 0 if valid, -1 otherwise (error message saved)
+ */
+static int validate_batch_args(const char **texts, int num_texts,
+                               float **outputs, int output_dim) {
+  if (!texts || !outputs || num_texts <= 0 || output_dim <= 0 ||
+      output_dim > MAX_OUTPUT_DIM) {
+    SAVE_ERROR("Invalid input parameters: texts=%p, outputs=%p, "
+               "num_texts=%d, output_dim=%d",
+               (void *)texts, (void *)outputs, num_texts, output_dim);
+    return -1;
+  }
+  for (int i = 0; i < num_texts; i++) {
+    if (!texts[i] || !outputs[i]) {
+      SAVE_ERROR("Invalid input parameters: texts[%d]=%p, outputs[%d]=%p", i,
+                 texts[i], i, (void *)outputs[i]);
+      return -1;
+    }
   }
+  return 0;
+}
 
-  /* Note: env is singleton, don't release it */
+/**
+ * @brief Number of sorted sequences from schedule[pos] packed into one batch
+ *
+ * The schedule is sorted by ascending token count, so the last admitted
+ * sequence sets the padded length; sequences are added while batch_size *
+ * seq_len stays within the token budget (and batch_size <=
+ * FASTEMBED_ONNX_MAX_BATCH_SIZE).
+ */
+static int schedule_batch_size(int (*schedule)[3], int pos, int count) {
+  int token_budget = g_batch_token_budget;
+  int batch_size = 1;
+  while (pos + batch_size < count &&
+         batch_size < FASTEMBED_ONNX_MAX_BATCH_SIZE &&
+         (int64_t)(batch_size + 1) * schedule[pos + batch_size][1] <=
+             token_budget) {
+    batch_size++;
+  }
+  return batch_size;
+}
 
-  /* Clear cache */
-  memset(&g_cached_session, 0, sizeof(CachedModelSession));
+/**
+ * @brief Build padded [batch_size, seq_len] input tensors
+ *
+ * @param model Loaded session (pad token)
+ * @param inputs input_ids | attention_mask | token_type_ids, 3 *
+ * batch_size * seq_len elements
+ * @param token_pool Unpadded token sequences, back to back
+ * @param schedule batch_size entries of {output index, token count, pool
+ * offset}
+ * @return Real tokens in the batch
+ */
+static uint64_t fill_padded_batch(const ModelEntry *model, int64_t *inputs,
+                                  const int64_t *token_pool,
+                                  int (*schedule)[3], int batch_size,
+                                  int seq_len) {
+  size_t elems = (size_t)batch_size * seq_len;
+  int64_t *input_ids = inputs;
+  int64_t *attention_mask = inputs + elems;
+  int64_t *token_type_ids = inputs + elems * 2;
+
+  uint64_t batch_tokens = 0;
+  for (int b = 0; b < batch_size; b++) {
+    int64_t *ids_row = input_ids + (size_t)b * seq_len;
+    int64_t *mask_row = attention_mask + (size_t)b * seq_len;
+    int tokens = schedule[b][1];
+    batch_tokens += (uint64_t)tokens;
+
+    memcpy(ids_row, token_pool + schedule[b][2], tokens * sizeof(int64_t));
+    for (int t = 0; t < tokens; t++)
+      mask_row[t] = 1;
+    for (int t = tokens; t < seq_len; t++) {
+      ids_row[t] = model->pad_token_id;
+      mask_row[t] = 0;
+    }
+  }
+  memset(token_type_ids, 0, elems * sizeof(int64_t));
+  return batch_tokens;
+}
 
+/**
+ * @brief Run tokenized sequences as length-bucketed padded batches
+ *
+ * Sorts the schedule by token count, then packs the sorted sequences into
+ * sub-batches with schedule_batch_size(). Results are written straight to
+ * the caller's output arrays, so order is preserved without extra copies.
+ *
+ * @param model Loaded session (referenced by the caller)
+ * @param ctx Inference context of model, owned by the calling thread
+ * @param token_pool Unpadded token sequences, back to back
+ * @param schedule count entries of {output index, token count, pool offset}
+ * (reordered)
+ * @param count Number of sequences
+ * @param outputs Output arrays indexed by schedule[i][0]
+ * @param output_dim Requested output dimension (must match model output)
+ * @return 0 on success, -1 on error
+ */
+static int run_token_schedule(ModelEntry *model, InferenceContext *ctx,
+                              const int64_t *token_pool, int (*schedule)[3],
+                              int count, float **outputs, int output_dim) {
+  float *batch_outputs[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+
+  /* Bucket by length: ascending token count */
+  qsort(schedule, count, sizeof(*schedule), compare_by_token_count);
+
+  int pos = 0;
+  while (pos < count) {
+    int batch_size = schedule_batch_size(schedule, pos, count);
+    int seq_len = schedule[pos + batch_size - 1][1];
+
+    /* Build padded [batch_size, seq_len] tensors */
+    size_t elems = (size_t)batch_size * seq_len;
+    if (reserve_buffer((void **)&ctx->batch_inputs, &ctx->batch_capacity,
+                       elems * 3, sizeof(int64_t)) != 0) {
+      SAVE_ERROR("Failed to allocate input tensors (%d x %d)", batch_size,
+                 seq_len);
+      return -1;
+    }
+    uint64_t batch_tokens =
+        fill_padded_batch(model, ctx->batch_inputs, token_pool,
+                          schedule + pos, batch_size, seq_len);
+    /* Scatter targets: callers' original positions */
+    for (int b = 0; b < batch_size; b++)
+      batch_outputs[b] = outputs[schedule[pos + b][0]];
+
+    if (run_padded_batch(model, ctx, batch_size, seq_len, batch_outputs,
+                         output_dim) != 0) {
+      return -1;
+    }
+    stats_record_batch(batch_size, batch_tokens, elems);
+    pos += batch_size;
+  }
   return 0;
 }
 
 /**
- * @brief Get model output dimension
+ * @brief Batched inference for a loaded model (length-bucketed scheduler)
  *
- * Returns the output dimension of the ONNX model. If the model is already
- * loaded (cached), returns the cached dimension. Otherwise, loads the model
- * to detect the dimension.
+ * Texts are tokenized in windows of FASTEMBED_ONNX_SCHEDULE_WINDOW and each
+ * window goes through run_token_schedule(), which groups similar lengths
+ * together. Mixing short queries with long documents therefore no longer
+ * pads every query to the longest document, which matters because attention
+ * cost grows quadratically with the padded length.
  *
- * @param model_path Path to .onnx model file
- * @return Model output dimension on success, -1 on error (model not found,
- * invalid model, dimension detection failed)
+ * All buffers come from the caller's InferenceContext, so repeated calls
+ * reuse them instead of allocating per call.
  *
- * @note The dimension is cached per model path
- * @note Returns -1 if ONNX Runtime is not available
+ * @param model Loaded session (referenced by the caller)
+ * @param ctx Inference context of model, owned by the calling thread
+ * @param texts Array of input texts (null-terminated strings)
+ * @param num_texts Number of texts
+ * @param outputs Array of output arrays, one per text (each size >=
+ * output_dim)
+ * @param output_dim Requested output dimension (must match model output)
+ * @return 0 on success, -1 on error (on error, some outputs may already
+ * have been written)
  */
-int onnx_get_model_dimension(const char *model_path) {
+static int run_text_batch(ModelEntry *model, InferenceContext *ctx,
+                          const char **texts, int num_texts, float **outputs,
+                          int output_dim) {
+  int window = num_texts < FASTEMBED_ONNX_SCHEDULE_WINDOW
+                   ? num_texts
+                   : FASTEMBED_ONNX_SCHEDULE_WINDOW;
+
+  /* schedule[i] = {text index, token count, pool offset} */
+  int (*schedule)[3] = ctx->schedule;
+
+  for (int window_start = 0; window_start < num_texts;
+       window_start += window) {
+    int window_size = (num_texts - window_start < window)
+                          ? num_texts - window_start
+                          : window;
+
+    /* Tokenize the window into a compact pool */
+    uint64_t start = stats_now();
+    size_t pool_used = 0;
+    for (int i = 0; i < window_size; i++) {
+      int text_index = window_start + i;
+      int count = tokenize_text(model, texts[text_index], ctx->scratch,
+                                MAX_SEQUENCE_LENGTH);
+      if (count < 0) {
+        SAVE_ERROR("Failed to tokenize text %d (length: %zu)", text_index,
+                   strlen(texts[text_index]));
+        return -1;
+      }
+      if (reserve_buffer((void **)&ctx->token_pool, &ctx->pool_capacity,
+                         pool_used + count, sizeof(int64_t)) != 0) {
+        SAVE_ERROR("Failed to allocate token buffer (%zu tokens)",
+                   pool_used + count);
+        return -1;
+      }
+      memcpy(ctx->token_pool + pool_used, ctx->scratch,
+             count * sizeof(int64_t));
+      schedule[i][0] = text_index;
+      schedule[i][1] = count;
+      schedule[i][2] = (int)pool_used;
+      pool_used += count;
+    }
+    stats_record_stage(FASTEMBED_STAGE_TOKENIZE, start);
+
+    if (run_token_schedule(model, ctx, ctx->token_pool, schedule, window_size,
+                           outputs, output_dim) != 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Batched inference behind the embedding cache
+ *
+ * Looks every text up in the embedding cache first and sends only the
+ * misses to run_text_batch(); their embeddings are then added to the cache.
+ *
+ * @return 0 on success, -1 on error (see run_text_batch())
+ */
+static int generate_batch_cached(ModelEntry *model, InferenceContext *ctx,
+                                 const char **texts, int num_texts,
+                                 float **outputs, int output_dim) {
+  if (reserve_buffer((void **)&ctx->miss_texts, &ctx->miss_texts_capacity,
+                     num_texts, sizeof(const char *)) != 0 ||
+      reserve_buffer((void **)&ctx->miss_outputs, &ctx->miss_outputs_capacity,
+                     num_texts, sizeof(float *)) != 0 ||
+      reserve_buffer((void **)&ctx->miss_keys, &ctx->miss_keys_capacity,
+                     num_texts, sizeof(uint64_t)) != 0) {
+    SAVE_ERROR("Failed to allocate cache buffers (%d texts)", num_texts);
+    return -1;
+  }
+
+  uint64_t seed = embedding_cache_seed(model->model_path,
+                                       model->tokenizer_path,
+                                       model->options.pooling, output_dim);
+  int misses = 0;
+  for (int i = 0; i < num_texts; i++) {
+    uint64_t key = embedding_cache_key(seed, texts[i], strlen(texts[i]));
+    if (embedding_cache_lookup(key, output_dim, outputs[i]))
+      continue;
+    ctx->miss_texts[misses] = texts[i];
+    ctx->miss_outputs[misses] = outputs[i];
+    ctx->miss_keys[misses] = key;
+    misses++;
+  }
+  if (misses == 0)
+    return 0;
+
+  if (run_text_batch(model, ctx, ctx->miss_texts, misses, ctx->miss_outputs,
+                     output_dim) != 0)
+    return -1;
+  for (int i = 0; i < misses; i++)
+    embedding_cache_insert(ctx->miss_keys[i], output_dim,
+                           ctx->miss_outputs[i]);
+  return 0;
+}
+
+/**
+ * @brief Batched inference for a loaded model, through the embedding cache
+ * when it is enabled, recorded in the instrumentation statistics
+ *
+ * @return 0 on success, -1 on error (see run_text_batch())
+ */
+static int generate_batch_with_context(ModelEntry *model,
+                                       InferenceContext *ctx,
+                                       const char **texts, int num_texts,
+                                       float **outputs, int output_dim) {
+  uint64_t start = stats_now();
+  int result =
+      embedding_cache_enabled()
+          ? generate_batch_cached(model, ctx, texts, num_texts, outputs,
+                                  output_dim)
+          : run_text_batch(model, ctx, texts, num_texts, outputs, output_dim);
+  stats_record_stage(FASTEMBED_STAGE_GENERATE, start);
+  stats_record_texts(num_texts, result != 0);
+  return result;
+}
+
+/**
+ * @brief Batched inference with a context taken from the model's pool
+ *
+ * See generate_batch_with_context().
+ */
+static int generate_batch_with_model(ModelEntry *model, const char **texts,
+                                     int num_texts, float **outputs,
+                                     int output_dim) {
+  InferenceContext *ctx = acquire_inference_context(model);
+  if (ctx == NULL)
+    return -1;
+
+  int result = generate_batch_with_context(model, ctx, texts, num_texts,
+                                           outputs, output_dim);
+  release_inference_context(model, ctx);
+  return result;
+}
+
+/**
+ * @brief Generate embeddings for multiple texts with batched inference
+ *
+ * Path-based entry point: takes a registry reference on the model for the
+ * duration of the call, then runs generate_batch_with_model().
+ *
+ * @param model_path Path to .onnx model file
+ * @param texts Array of input texts (null-terminated strings)
+ * @param num_texts Number of texts
+ * @param outputs Array of output arrays, one per text (each size >=
+ * output_dim)
+ * @param output_dim Requested output dimension (must match model output)
+ * @return 0 on success, -1 on error (on error, some outputs may already
+ * have been written)
+ */
+int onnx_generate_embeddings_batch(const char *model_path, const char **texts,
+                                   int num_texts, float **outputs,
+                                   int output_dim) {
   /* Clear previous error */
   g_last_error[0] = '\0';
 
-  /* Validate input */
+  /* Validate inputs */
   if (!model_path) {
     SAVE_ERROR("Invalid model_path: NULL");
     return -1;
   }
-
-#ifdef USE_ONNX_RUNTIME
-  /* Initialize ONNX Runtime API */
-  if (init_onnx_api() != 0) {
-    SAVE_ERROR("Failed to initialize ONNX Runtime API");
+  if (validate_batch_args(texts, num_texts, outputs, output_dim) != 0)
     return -1;
-  }
 
-  /* Load or get cached session (this will detect dimension if not cached) */
-  if (load_or_get_cached_session(model_path, &g_cached_session) != 0) {
+  /* Load or get cached session */
+  ModelEntry *model = acquire_model_entry(model_path, NULL);
+  if (model == NULL) {
     SAVE_ERROR("Failed to load model session for: %s", model_path);
     return -1;
   }
 
-  /* Return cached dimension */
-  if (g_cached_session.output_dimension > 0) {
-    return g_cached_session.output_dimension;
-  }
+  int result =
+      generate_batch_with_model(model, texts, num_texts, outputs, output_dim);
+  release_model_entry(model);
+  return result;
+}
 
-  /* Dimension detection failed */
-  SAVE_ERROR("Failed to detect model output dimension for: %s", model_path);
-  return -1;
-#else
-  SAVE_ERROR("ONNX Runtime not available (compiled without USE_ONNX_RUNTIME)");
-  return -1;
-#endif
+/**
+ * @brief Generate embedding using ONNX Runtime model (STANDARD C API)
+ *
+ * Loads an ONNX embedding model and generates embeddings for the input text.
+ * The function performs tokenization, runs inference, extracts the [CLS] token
+ * embedding, and normalizes the result.
+ *
+ * Implemented as a batch of one on top of onnx_generate_embeddings_batch().
+ *
+ * @param model_path Path to .onnx model file
+ * @param text Input text to embed (null-terminated string)
+ * @param output Output array for embedding vector (must be pre-allocated)
+ * @param output_dim Requested output dimension (must match model output)
+ * @return 0 on success, -1 on error
+ */
+int onnx_generate_embedding(const char *model_path, const char *text,
+                            float *output, int output_dim) {
+  if (!text || !output) {
+    g_last_error[0] = '\0';
+    SAVE_ERROR("Invalid input parameters: model_path=%p, text=%p, output=%p, "
+               "output_dim=%d",
+               model_path, text, output, output_dim);
+    return -1;
+  }
+
+  return onnx_generate_embeddings_batch(model_path, &text, 1, &output,
+                                        output_dim);
+}
+
+/**
+ * @brief Unload all cached model sessions
+ *
+ * Frees every idle session in the registry. Sessions still referenced by
+ * open handles or in-flight calls are removed from the registry and freed
+ * when their last reference is dropped. Subsequent path-based calls reload
+ * the model automatically.
+ *
+ * @return 0 on success, -1 if not initialized
+ */
+int onnx_unload_model(void) {
+  if (g_ort == NULL) {
+    return -1;
+  }
+
+  ModelEntry *idle = NULL;
+
+  fastembed_mutex_lock(&g_registry_mutex);
+  ModelEntry *entry = g_registry;
+  while (entry != NULL) {
+    ModelEntry *next = entry->next;
+    entry->in_registry = 0;
+    if (entry->refcount == 0) {
+      entry->next = idle;
+      idle = entry;
+    } else {
+      entry->next = NULL; /* Freed by release_model_entry() */
+    }
+    entry = next;
+  }
+  g_registry = NULL;
+  g_registry_count = 0;
+  fastembed_mutex_unlock(&g_registry_mutex);
+
+  /* Note: env and memory info are process-wide, don't release them */
+  destroy_entry_list(idle);
+
+  return 0;
+}
+
+/**
+ * @brief Get model output dimension
+ *
+ * Returns the output dimension of the ONNX model. If the model is already
+ * loaded (cached), returns the cached dimension. Otherwise, loads the model
+ * to detect the dimension.
+ *
+ * @param model_path Path to .onnx model file
+ * @return Model output dimension on success, -1 on error (model not found,
+ * invalid model, dimension detection failed)
+ *
+ * @note The dimension is cached per model path
+ * @note Returns -1 if ONNX Runtime is not available
+ */
+int onnx_get_model_dimension(const char *model_path) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  /* Validate input */
+  if (!model_path) {
+    SAVE_ERROR("Invalid model_path: NULL");
+    return -1;
+  }
+
+  /* Load or get cached session (this will detect dimension if not cached) */
+  ModelEntry *model = acquire_model_entry(model_path, NULL);
+  if (model == NULL) {
+    SAVE_ERROR("Failed to load model session for: %s", model_path);
+    return -1;
+  }
+
+  int dimension = model->output_dimension;
+  release_model_entry(model);
+
+  /* Return cached dimension */
+  if (dimension > 0) {
+    return dimension;
+  }
+
+  /* Dimension detection failed */
+  SAVE_ERROR("Failed to detect model output dimension for: %s", model_path);
+  return -1;
+}
+
+/**
+ * @brief Open a reference-counted handle to a model
+ *
+ * Returns the registry entry for the model (loading it on first use) with
+ * one reference taken. Sessions are shared: opening the same model twice
+ * with the same options, from any thread, returns the same handle without
+ * reloading it.
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Session options (NULL = defaults)
+ * @return Model handle on success, NULL on error
+ */
+struct fastembed_model *
+onnx_model_open(const char *model_path,
+                const fastembed_onnx_options_t *options) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (!model_path) {
+    SAVE_ERROR("Invalid model_path: NULL");
+    return NULL;
+  }
+
+  ModelEntry *model = acquire_model_entry(model_path, options);
+  if (model == NULL) {
+    /* Keep the detailed error (invalid options, ORT failure) if there is one */
+    if (g_last_error[0] == '\0')
+      SAVE_ERROR("Failed to load model session for: %s", model_path);
+    return NULL;
+  }
+  return model;
+}
+
+/**
+ * @brief Close a handle returned by onnx_model_open()
+ *
+ * The session stays cached (subject to LRU eviction) after the last handle
+ * is closed.
+ *
+ * @param model Model handle
+ * @return 0 on success, -1 if model is NULL
+ */
+int onnx_model_close(struct fastembed_model *model) {
+  if (model == NULL)
+    return -1;
+  release_model_entry(model);
+  return 0;
+}
+
+/**
+ * @brief Get output dimension of an open model
+ *
+ * @param model Model handle
+ * @return Output dimension, or -1 if unknown / model is NULL
+ */
+int onnx_model_get_dimension(const struct fastembed_model *model) {
+  if (model == NULL || model->output_dimension <= 0)
+    return -1;
+  return model->output_dimension;
+}
+
+/**
+ * @brief Get the execution provider an open model runs on
+ *
+ * @param model Model handle
+ * @return fastembed_execution_provider_t value, or -1 if model is NULL
+ */
+int onnx_model_get_execution_provider(const struct fastembed_model *model) {
+  if (model == NULL)
+    return -1;
+  return model->execution_provider;
+}
+
+/**
+ * @brief Get the tokenizer of an open model
+ *
+ * @param model Model handle
+ * @return Tokenizer, or NULL if the model uses the hash-based fallback
+ */
+const fastembed_tokenizer_t *
+onnx_model_get_tokenizer(const struct fastembed_model *model) {
+  return model ? model->tokenizer : NULL;
+}
+
+/**
+ * @brief Batched inference with an open model handle
+ *
+ * Same as onnx_generate_embeddings_batch() but skips the registry lookup.
+ *
+ * @param model Model handle
+ * @param texts Array of input texts (null-terminated strings)
+ * @param num_texts Number of texts
+ * @param outputs Array of output arrays, one per text (each size >=
+ * output_dim)
+ * @param output_dim Requested output dimension (must match model output)
+ * @return 0 on success, -1 on error
+ */
+int onnx_model_generate_batch(struct fastembed_model *model,
+                              const char **texts, int num_texts,
+                              float **outputs, int output_dim) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (model == NULL) {
+    SAVE_ERROR("Invalid model handle: NULL");
+    return -1;
+  }
+  if (validate_batch_args(texts, num_texts, outputs, output_dim) != 0)
+    return -1;
+
+  return generate_batch_with_model(model, texts, num_texts, outputs,
+                                   output_dim);
+}
+
+/** Bytes of per-worker scratch for one group of contiguous texts */
+#define CONTIGUOUS_SCRATCH_SIZE                                                \
+  ((size_t)FASTEMBED_ONNX_MAX_BATCH_SIZE * (MAX_TEXT_LENGTH + 1))
+
+/**
+ * Arguments shared by the onnx_model_generate_batch_parallel() and
+ * onnx_model_generate_contiguous_parallel() tasks. Contiguous calls set
+ * text_data / offsets / matrix instead of texts / outputs.
+ */
+typedef struct {
+  ModelEntry *model;
+  const char **texts;
+  float **outputs;
+  const char *text_data;
+  const int32_t *offsets;
+  float *matrix;
+  int output_dim;
+  int *statuses;
+  /* Per worker: context kept for the whole call, failed text count and
+   * (contiguous calls) null-terminated copies of the current group */
+  InferenceContext *contexts[FASTEMBED_THREAD_POOL_MAX_THREADS];
+  int failures[FASTEMBED_THREAD_POOL_MAX_THREADS];
+  char *scratch[FASTEMBED_THREAD_POOL_MAX_THREADS];
+} ParallelBatchJob;
+
+/**
+ * @brief Resolve text i of a parallel job to a C string and output row
+ *
+ * Contiguous spans are copied into the worker's scratch slot, because the
+ * tokenizers take null-terminated text.
+ *
+ * @return FASTEMBED_STATUS_OK, or the status the text fails with
+ */
+static int parallel_batch_item(ParallelBatchJob *job, int i, int worker,
+                               int slot, const char **text, float **output) {
+  if (job->text_data == NULL) {
+    if (!job->texts[i] || !job->outputs[i])
+      return FASTEMBED_STATUS_NULL_INPUT;
+    *text = job->texts[i];
+    *output = job->outputs[i];
+    return FASTEMBED_STATUS_OK;
+  }
+
+  int32_t begin = job->offsets[i];
+  int32_t end = job->offsets[i + 1];
+  if (begin < 0 || end <= begin || end - begin > MAX_TEXT_LENGTH ||
+      memchr(job->text_data + begin, '\0', (size_t)(end - begin)) != NULL)
+    return FASTEMBED_STATUS_INVALID_TEXT;
+
+  if (job->scratch[worker] == NULL)
+    job->scratch[worker] = (char *)malloc(CONTIGUOUS_SCRATCH_SIZE);
+  if (job->scratch[worker] == NULL)
+    return FASTEMBED_STATUS_ERROR;
+
+  char *copy = job->scratch[worker] + (size_t)slot * (MAX_TEXT_LENGTH + 1);
+  memcpy(copy, job->text_data + begin, (size_t)(end - begin));
+  copy[end - begin] = '\0';
+  *text = copy;
+  *output = job->matrix + (size_t)i * (size_t)job->output_dim;
+  return FASTEMBED_STATUS_OK;
+}
+
+/** Record a failed text; contiguous calls also zero its output row */
+static void parallel_batch_fail(ParallelBatchJob *job, int i, int worker,
+                                int status) {
+  if (job->statuses)
+    job->statuses[i] = status;
+  if (job->matrix)
+    memset(job->matrix + (size_t)i * (size_t)job->output_dim, 0,
+           (size_t)job->output_dim * sizeof(float));
+  job->failures[worker]++;
+}
+
+/**
+ * @brief Thread pool task: embed texts [begin, end) with the worker's
+ * context
+ *
+ * Valid texts run as one batch; if it fails they are retried one at a time
+ * so a single bad text only fails itself.
+ */
+static void parallel_batch_task(void *arg, int begin, int end, int worker) {
+  ParallelBatchJob *job = (ParallelBatchJob *)arg;
+  const char *texts[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  float *outputs[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  int indices[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  int count = 0;
+
+  for (int i = begin; i < end; i++) {
+    int status = parallel_batch_item(job, i, worker, count, &texts[count],
+                                     &outputs[count]);
+    if (status != FASTEMBED_STATUS_OK) {
+      parallel_batch_fail(job, i, worker, status);
+      continue;
+    }
+    indices[count] = i;
+    count++;
+  }
+  if (count == 0)
+    return;
+
+  if (job->contexts[worker] == NULL)
+    job->contexts[worker] = acquire_inference_context(job->model);
+  InferenceContext *ctx = job->contexts[worker];
+
+  int batch_ok = ctx != NULL &&
+                 generate_batch_with_context(job->model, ctx, texts, count,
+                                             outputs, job->output_dim) == 0;
+  for (int b = 0; b < count; b++) {
+    int ok = batch_ok ||
+             (ctx != NULL && count > 1 &&
+              generate_batch_with_context(job->model, ctx, &texts[b], 1,
+                                          &outputs[b], job->output_dim) == 0);
+    if (!ok)
+      parallel_batch_fail(job, indices[b], worker, FASTEMBED_STATUS_ERROR);
+    else if (job->statuses)
+      job->statuses[indices[b]] = FASTEMBED_STATUS_OK;
+  }
+}
+
+/** Run a prepared parallel job, release its per-worker state, count failures */
+static int run_parallel_batch(ParallelBatchJob *job, int num_texts,
+                              int num_threads) {
+  int workers = thread_pool_workers(num_threads);
+  thread_pool_run(num_texts, FASTEMBED_ONNX_MAX_BATCH_SIZE, workers,
+                  parallel_batch_task, job);
+
+  int failures = 0;
+  for (int i = 0; i < workers; i++) {
+    release_inference_context(job->model, job->contexts[i]);
+    free(job->scratch[i]);
+    failures += job->failures[i];
+  }
+
+  if (failures > 0)
+    SAVE_ERROR("%d of %d texts failed", failures, num_texts);
+  return failures;
+}
+
+/**
+ * @brief Batched inference spread over the shared thread pool
+ *
+ * Each pool thread takes chunks of FASTEMBED_ONNX_MAX_BATCH_SIZE texts and
+ * runs them through generate_batch_with_context() with its own inference
+ * context, acquired on its first chunk and returned to the model's pool at
+ * the end. Failures are reported per text instead of failing the call.
+ *
+ * @param model Model handle
+ * @param texts Array of input texts (NULL entries fail individually)
+ * @param num_texts Number of texts
+ * @param outputs Array of output arrays, one per text (each size >=
+ * output_dim)
+ * @param output_dim Requested output dimension (must match model output)
+ * @param statuses Optional per-text fastembed_status_t output
+ * @param num_threads Threads including the caller (0 = whole pool)
+ * @return Number of failed texts, -1 on invalid arguments
+ */
+int onnx_model_generate_batch_parallel(struct fastembed_model *model,
+                                       const char **texts, int num_texts,
+                                       float **outputs, int output_dim,
+                                       int *statuses, int num_threads) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (model == NULL || !texts || !outputs || num_texts <= 0 ||
+      output_dim <= 0 || output_dim > MAX_OUTPUT_DIM) {
+    SAVE_ERROR("Invalid input parameters: model=%p, texts=%p, outputs=%p, "
+               "num_texts=%d, output_dim=%d",
+               (void *)model, (void *)texts, (void *)outputs, num_texts,
+               output_dim);
+    return -1;
+  }
+
+  ParallelBatchJob *job = (ParallelBatchJob *)calloc(1, sizeof(*job));
+  if (job == NULL) {
+    SAVE_ERROR("Failed to allocate batch state");
+    return -1;
+  }
+  job->model = model;
+  job->texts = texts;
+  job->outputs = outputs;
+  job->output_dim = output_dim;
+  job->statuses = statuses;
+
+  int failures = run_parallel_batch(job, num_texts, num_threads);
+  free(job);
+  return failures;
+}
+
+/**
+ * @brief Parallel batched inference from concatenated texts into one matrix
+ *
+ * Like onnx_model_generate_batch_parallel(), with text i taken from
+ * text_data[offsets[i], offsets[i + 1]) and written to row i of output.
+ * Rows of failed texts are zeroed.
+ *
+ * @param model Model handle
+ * @param text_data Concatenated UTF-8 texts
+ * @param offsets num_texts + 1 byte offsets into text_data
+ * @param num_texts Number of texts
+ * @param output Row-major float[num_texts * output_dim]
+ * @param output_dim Requested output dimension (must match model output)
+ * @param statuses Optional per-text fastembed_status_t output
+ * @param num_threads Threads including the caller (0 = whole pool)
+ * @return Number of failed texts, -1 on invalid arguments
+ */
+int onnx_model_generate_contiguous_parallel(struct fastembed_model *model,
+                                            const char *text_data,
+                                            const int32_t *offsets,
+                                            int num_texts, float *output,
+                                            int output_dim, int *statuses,
+                                            int num_threads) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (model == NULL || !text_data || !offsets || !output || num_texts <= 0 ||
+      output_dim <= 0 || output_dim > MAX_OUTPUT_DIM) {
+    SAVE_ERROR("Invalid input parameters: model=%p, text_data=%p, "
+               "offsets=%p, output=%p, num_texts=%d, output_dim=%d",
+               (void *)model, (const void *)text_data, (const void *)offsets,
+               (void *)output, num_texts, output_dim);
+    return -1;
+  }
+
+  ParallelBatchJob *job = (ParallelBatchJob *)calloc(1, sizeof(*job));
+  if (job == NULL) {
+    SAVE_ERROR("Failed to allocate batch state");
+    return -1;
+  }
+  job->model = model;
+  job->text_data = text_data;
+  job->offsets = offsets;
+  job->matrix = output;
+  job->output_dim = output_dim;
+  job->statuses = statuses;
+
+  int failures = run_parallel_batch(job, num_texts, num_threads);
+  free(job);
+  return failures;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Chunked documents                                                         */
+/* ------------------------------------------------------------------------ */
+
+#if FASTEMBED_CHUNK_SEGMENT_BYTES + 2 > MAX_SEQUENCE_LENGTH
+#error "FASTEMBED_CHUNK_SEGMENT_BYTES must leave room for [CLS] and [SEP]"
+#endif
+
+#define CHUNK_WINDOWS FASTEMBED_CHUNK_BATCH_WINDOWS
+
+/**
+ * @brief Streaming state of one chunked document
+ *
+ * Fed text collects in a segment buffer that is tokenized whenever it fills
+ * up; the tokens go to a sliding buffer from which full windows are cut, and
+ * the windows wait in a batch until CHUNK_WINDOWS of them are ready to run.
+ * Every buffer has a fixed size set by the options.
+ */
+struct fastembed_document {
+  ModelEntry *model; /* Referenced until fastembed_document_free() */
+  fastembed_chunk_options_t options;
+  int dimension;
+  int content_tokens; /* Window tokens without [CLS] / [SEP] */
+  int stride;         /* Tokens between window starts */
+  int64_t cls_id;
+  int64_t sep_id;
+
+  char *text; /* Untokenized text, FASTEMBED_CHUNK_SEGMENT_BYTES + 1 */
+  size_t text_used;
+  int64_t *scratch; /* Tokens of one segment, MAX_SEQUENCE_LENGTH */
+
+  int64_t *tokens; /* Tokens not yet past a window start */
+  int token_count;
+  int64_t token_base;  /* Document index of tokens[0] */
+  int64_t covered_end; /* Document tokens up to here are in some window */
+
+  int64_t *windows; /* CHUNK_WINDOWS * window_tokens pending windows */
+  int (*schedule)[3];
+  int window_offsets[CHUNK_WINDOWS];
+  int window_lengths[CHUNK_WINDOWS]; /* Document tokens per window */
+  int pending;
+  float *embeddings; /* CHUNK_WINDOWS * dimension */
+
+  double *sum; /* Token-weighted sum of window embeddings */
+  double weight;
+  int chunks;
+  int failed;
+  int finished;
+};
+
+/**
+ * @brief Embed the pending windows and report them in document order
+ *
+ * @return 0 on success, -1 on error or callback abort
+ */
+static int document_flush(fastembed_document_t *doc) {
+  if (doc->pending == 0)
+    return 0;
+
+  float *outputs[CHUNK_WINDOWS];
+  for (int i = 0; i < doc->pending; i++) {
+    doc->schedule[i][0] = i;
+    doc->schedule[i][1] = doc->window_lengths[i] + 2;
+    doc->schedule[i][2] = i * doc->options.window_tokens;
+    outputs[i] = doc->embeddings + (size_t)i * doc->dimension;
+  }
+
+  InferenceContext *ctx = acquire_inference_context(doc->model);
+  if (ctx == NULL)
+    return -1;
+  int result = run_token_schedule(doc->model, ctx, doc->windows,
+                                  doc->schedule, doc->pending, outputs,
+                                  doc->dimension);
+  release_inference_context(doc->model, ctx);
+  if (result != 0)
+    return -1;
+
+  for (int i = 0; i < doc->pending; i++) {
+    const float *embedding = outputs[i];
+    double weight = doc->window_lengths[i] > 0 ? doc->window_lengths[i] : 1;
+    for (int h = 0; h < doc->dimension; h++)
+      doc->sum[h] += weight * embedding[h];
+    doc->weight += weight;
+
+    if (doc->options.on_chunk != NULL &&
+        doc->options.on_chunk(doc->options.user_data, doc->chunks, embedding,
+                              doc->dimension, doc->window_offsets[i],
+                              doc->window_lengths[i]) != 0) {
+      SAVE_ERROR("Document aborted by the chunk callback at window %d",
+                 doc->chunks);
+      return -1;
+    }
+    doc->chunks++;
+  }
+  doc->pending = 0;
+  return 0;
+}
+
+/**
+ * @brief Queue a window of the first length buffered tokens
+ *
+ * @return 0 on success, -1 on error
+ */
+static int document_add_window(fastembed_document_t *doc, int length) {
+  if (doc->token_base + length > INT_MAX) {
+    SAVE_ERROR("Document exceeds %d tokens", INT_MAX);
+    return -1;
+  }
+
+  int64_t *window =
+      doc->windows + (size_t)doc->pending * doc->options.window_tokens;
+  window[0] = doc->cls_id;
+  memcpy(window + 1, doc->tokens, (size_t)length * sizeof(int64_t));
+  window[length + 1] = doc->sep_id;
+  doc->window_offsets[doc->pending] = (int)doc->token_base;
+  doc->window_lengths[doc->pending] = length;
+  doc->pending++;
+
+  if (doc->token_base + length > doc->covered_end)
+    doc->covered_end = doc->token_base + length;
+  return doc->pending == CHUNK_WINDOWS ? document_flush(doc) : 0;
+}
+
+/**
+ * @brief Tokenize length bytes of the segment buffer and cut full windows
+ *
+ * @return 0 on success, -1 on error
+ */
+static int document_tokenize(fastembed_document_t *doc, size_t length) {
+  uint64_t start = stats_now();
+  char saved = doc->text[length];
+  doc->text[length] = '\0';
+  int count =
+      tokenize_text(doc->model, doc->text, doc->scratch, MAX_SEQUENCE_LENGTH);
+  doc->text[length] = saved;
+  stats_record_stage(FASTEMBED_STAGE_TOKENIZE, start);
+  if (count < 2) {
+    SAVE_ERROR("Failed to tokenize document segment (%zu bytes)", length);
+    return -1;
+  }
+
+  /* Strip [CLS] / [SEP]; windows get their own */
+  memcpy(doc->tokens + doc->token_count, doc->scratch + 1,
+         (size_t)(count - 2) * sizeof(int64_t));
+  doc->token_count += count - 2;
+  memmove(doc->text, doc->text + length, doc->text_used - length);
+  doc->text_used -= length;
+
+  while (doc->token_count >= doc->content_tokens) {
+    if (document_add_window(doc, doc->content_tokens) != 0)
+      return -1;
+    doc->token_count -= doc->stride;
+    memmove(doc->tokens, doc->tokens + doc->stride,
+            (size_t)doc->token_count * sizeof(int64_t));
+    doc->token_base += doc->stride;
+  }
+  return 0;
+}
+
+/**
+ * @brief Bytes of the full segment buffer to tokenize now
+ *
+ * Cuts after the last whitespace so no word is split; a segment without
+ * whitespace is cut at the last UTF-8 character boundary.
+ */
+static size_t document_cut(const fastembed_document_t *doc) {
+  const unsigned char *text = (const unsigned char *)doc->text;
+  for (size_t i = doc->text_used; i > 0; i--) {
+    if (isspace(text[i - 1]))
+      return i;
+  }
+  size_t cut = doc->text_used;
+  while (cut > 1 && (text[cut - 1] & 0xC0) == 0x80)
+    cut--;
+  /* text[cut - 1] is a lead byte: keep the whole character together */
+  return cut > 1 ? cut - 1 : doc->text_used;
+}
+
+/**
+ * @brief Free a document and drop its model reference
+ *
+ * @param doc Document (NULL is ignored)
+ */
+void onnx_document_free(fastembed_document_t *doc) {
+  if (doc == NULL)
+    return;
+  release_model_entry(doc->model);
+  free(doc->text);
+  free(doc->scratch);
+  free(doc->tokens);
+  free(doc->windows);
+  free(doc->schedule);
+  free(doc->embeddings);
+  free(doc->sum);
+  free(doc);
+}
+
+/**
+ * @brief Start a chunked document on an open model
+ *
+ * @param model Model handle
+ * @param options Chunking options (NULL = defaults)
+ * @param dimension Model output dimension
+ * @return Document, NULL on invalid options or allocation failure
+ */
+fastembed_document_t *
+onnx_document_begin(struct fastembed_model *model,
+                    const fastembed_chunk_options_t *options, int dimension) {
+  g_last_error[0] = '\0';
+
+  fastembed_chunk_options_t defaults;
+  if (options == NULL) {
+    fastembed_chunk_options_init(&defaults);
+    options = &defaults;
+  }
+  if (model == NULL || dimension <= 0 || dimension > MAX_OUTPUT_DIM ||
+      options->window_tokens < 3 ||
+      options->window_tokens > MAX_SEQUENCE_LENGTH ||
+      options->overlap_tokens < 0 ||
+      options->overlap_tokens > options->window_tokens - 3) {
+    SAVE_ERROR("Invalid document parameters: model=%p, window_tokens=%d, "
+               "overlap_tokens=%d",
+               (void *)model, options->window_tokens,
+               options->overlap_tokens);
+    return NULL;
+  }
+
+  fastembed_document_t *doc =
+      (fastembed_document_t *)calloc(1, sizeof(*doc));
+  if (doc == NULL) {
+    SAVE_ERROR("Failed to allocate document");
+    return NULL;
+  }
+  doc->options = *options;
+  doc->dimension = dimension;
+  doc->content_tokens = options->window_tokens - 2;
+  doc->stride = doc->content_tokens - options->overlap_tokens;
+
+  size_t window_tokens = (size_t)options->window_tokens;
+  doc->text = (char *)malloc(FASTEMBED_CHUNK_SEGMENT_BYTES + 1);
+  doc->scratch = (int64_t *)malloc(MAX_SEQUENCE_LENGTH * sizeof(int64_t));
+  doc->tokens = (int64_t *)malloc(
+      ((size_t)doc->content_tokens + FASTEMBED_CHUNK_SEGMENT_BYTES) *
+      sizeof(int64_t));
+  doc->windows =
+      (int64_t *)malloc(CHUNK_WINDOWS * window_tokens * sizeof(int64_t));
+  doc->schedule = (int(*)[3])malloc(CHUNK_WINDOWS * sizeof(*doc->schedule));
+  doc->embeddings =
+      (float *)malloc((size_t)CHUNK_WINDOWS * dimension * sizeof(float));
+  doc->sum = (double *)calloc((size_t)dimension, sizeof(double));
+  if (!doc->text || !doc->scratch || !doc->tokens || !doc->windows ||
+      !doc->schedule || !doc->embeddings || !doc->sum) {
+    SAVE_ERROR("Failed to allocate document buffers (window of %d tokens)",
+               options->window_tokens);
+    onnx_document_free(doc);
+    return NULL;
+  }
+
+  /* [CLS] / [SEP] ids as the model's tokenizer emits them */
+  if (tokenize_text(model, "", doc->scratch, MAX_SEQUENCE_LENGTH) != 2) {
+    SAVE_ERROR("Tokenizer did not produce [CLS] [SEP] for empty text");
+    onnx_document_free(doc);
+    return NULL;
+  }
+  doc->cls_id = doc->scratch[0];
+  doc->sep_id = doc->scratch[1];
+
+  fastembed_mutex_lock(&g_registry_mutex);
+  model->refcount++;
+  fastembed_mutex_unlock(&g_registry_mutex);
+  doc->model = model;
+  return doc;
+}
+
+/**
+ * @brief Append text to a document, embedding the windows it completes
+ *
+ * @return 0 on success, -1 on error (the document is failed)
+ */
+int onnx_document_feed(fastembed_document_t *doc, const char *text,
+                       size_t length) {
+  g_last_error[0] = '\0';
+  if (doc == NULL || doc->failed || doc->finished ||
+      (text == NULL && length > 0)) {
+    SAVE_ERROR("Invalid document feed: document=%p, text=%p", (void *)doc,
+               (const void *)text);
+    if (doc != NULL)
+      doc->failed = 1;
+    return -1;
+  }
+
+  while (length > 0) {
+    size_t room = FASTEMBED_CHUNK_SEGMENT_BYTES - doc->text_used;
+    size_t take = length < room ? length : room;
+    memcpy(doc->text + doc->text_used, text, take);
+    doc->text_used += take;
+    text += take;
+    length -= take;
+
+    if (doc->text_used == FASTEMBED_CHUNK_SEGMENT_BYTES &&
+        document_tokenize(doc, document_cut(doc)) != 0) {
+      doc->failed = 1;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Embed the last windows and write the pooled document vector
+ *
+ * @return Number of windows, -1 on error
+ */
+int onnx_document_finish(fastembed_document_t *doc, float *output) {
+  g_last_error[0] = '\0';
+  if (doc == NULL || doc->failed || doc->finished) {
+    SAVE_ERROR("Invalid document finish: document=%p", (void *)doc);
+    return -1;
+  }
+  doc->finished = 1;
+
+  if ((doc->text_used > 0 && document_tokenize(doc, doc->text_used) != 0) ||
+      ((doc->token_base + doc->token_count > doc->covered_end ||
+        (doc->chunks == 0 && doc->pending == 0)) &&
+       document_add_window(doc, doc->token_count) != 0) ||
+      document_flush(doc) != 0) {
+    doc->failed = 1;
+    return -1;
+  }
+
+  if (output != NULL) {
+    for (int h = 0; h < doc->dimension; h++)
+      output[h] = (float)(doc->sum[h] / doc->weight);
+    normalize_l2(output, doc->dimension);
+  }
+  return doc->chunks;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Pipelined batches                                                         */
+/* ------------------------------------------------------------------------ */
+
+#define PIPELINE_WINDOW FASTEMBED_PIPELINE_WINDOW
+
+/**
+ * @brief One padded batch moving through the pipeline
+ *
+ * Batches cycle free -> ready (tokenized) -> done (embedded) -> free. A
+ * batch with seq_len 0 carries texts that failed before inference and is
+ * passed through to post-processing. Buffers only grow, so a steady-state
+ * pipeline allocates nothing per batch.
+ */
+typedef struct pipeline_batch {
+  int count;
+  int seq_len;
+  int indices[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  int tokens[FASTEMBED_ONNX_MAX_BATCH_SIZE]; /* Real tokens per row */
+  int statuses[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  float scales[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  int64_t *inputs; /* input_ids | attention_mask | token_type_ids */
+  size_t input_capacity;
+  float *embeddings; /* FASTEMBED_ONNX_MAX_BATCH_SIZE * dimension */
+  void *rows;        /* Quantized rows (non-float quantization) */
+  struct pipeline_batch *next;
+} PipelineBatch;
+
+/** FIFO of batches, guarded by the pipeline mutex */
+typedef struct {
+  PipelineBatch *head;
+  PipelineBatch *tail;
+} PipelineQueue;
+
+/**
+ * @brief Shared state of one onnx_model_generate_pipelined() call
+ *
+ * Queues, counters and the abort flag are guarded by mutex; aborted is also
+ * read without it by the tokenizers between texts.
+ */
+typedef struct {
+  ModelEntry *model;
+  const char **texts;
+  int num_texts;
+  int output_dim;
+  size_t row_bytes; /* Bytes per row in options.quantization */
+  fastembed_pipeline_options_t options;
+  int32_t next_window; /* First text of the next untaken window */
+
+  fastembed_mutex_t mutex;
+  fastembed_cond_t space; /* Tokenizers: batch freed or abort */
+  fastembed_cond_t ready_cond; /* Inference: batch queued or input done */
+  fastembed_cond_t done_cond;  /* Caller: batch embedded or inference done */
+  PipelineBatch *free_list;
+  PipelineQueue ready;
+  PipelineQueue done;
+  int tokenizers_running;
+  int inference_running;
+  int32_t aborted;
+  char error[MAX_ERROR_MESSAGE]; /* First fatal stage error */
+
+  PipelineBatch *batches; /* queue_depth batches */
+} Pipeline;
+
+static void pipeline_push(PipelineQueue *queue, PipelineBatch *batch) {
+  batch->next = NULL;
+  if (queue->tail != NULL)
+    queue->tail->next = batch;
+  else
+    queue->head = batch;
+  queue->tail = batch;
+}
+
+static PipelineBatch *pipeline_pop(PipelineQueue *queue) {
+  PipelineBatch *batch = queue->head;
+  if (batch != NULL) {
+    queue->head = batch->next;
+    if (queue->head == NULL)
+      queue->tail = NULL;
+  }
+  return batch;
+}
+
+/** Stop every stage; the first message is kept (mutex held) */
+static void pipeline_abort_locked(Pipeline *p, const char *message) {
+  if (!p->aborted)
+    snprintf(p->error, sizeof(p->error), "%s", message);
+  fastembed_atomic_store(&p->aborted, 1);
+  fastembed_cond_broadcast(&p->space);
+  fastembed_cond_broadcast(&p->ready_cond);
+}
+
+static void pipeline_abort(Pipeline *p, const char *message) {
+  fastembed_mutex_lock(&p->mutex);
+  pipeline_abort_locked(p, message);
+  fastembed_mutex_unlock(&p->mutex);
+}
+
+/**
+ * @brief Take a free batch, waiting while queue_depth batches are in flight
+ *
+ * @return Batch, NULL once the pipeline is aborted
+ */
+static PipelineBatch *pipeline_take_free(Pipeline *p) {
+  fastembed_mutex_lock(&p->mutex);
+  while (p->free_list == NULL && !p->aborted)
+    fastembed_cond_wait(&p->space, &p->mutex);
+  PipelineBatch *batch = NULL;
+  if (!p->aborted) {
+    batch = p->free_list;
+    p->free_list = batch->next;
+  }
+  fastembed_mutex_unlock(&p->mutex);
+  return batch;
+}
+
+/** Queue a tokenized batch for inference */
+static void pipeline_submit(Pipeline *p, PipelineBatch *batch) {
+  fastembed_mutex_lock(&p->mutex);
+  pipeline_push(&p->ready, batch);
+  fastembed_cond_broadcast(&p->ready_cond);
+  fastembed_mutex_unlock(&p->mutex);
+}
+
+/**
+ * @brief Queue texts that failed before inference, in batches
+ *
+ * @param failed count entries of {text index, fastembed_status_t}
+ * @return 0 on success, -1 once the pipeline is aborted
+ */
+static int pipeline_submit_failed(Pipeline *p, int (*failed)[2], int count) {
+  for (int pos = 0; pos < count; pos += FASTEMBED_ONNX_MAX_BATCH_SIZE) {
+    PipelineBatch *batch = pipeline_take_free(p);
+    if (batch == NULL)
+      return -1;
+    batch->count = count - pos < FASTEMBED_ONNX_MAX_BATCH_SIZE
+                       ? count - pos
+                       : FASTEMBED_ONNX_MAX_BATCH_SIZE;
+    batch->seq_len = 0;
+    for (int b = 0; b < batch->count; b++) {
+      batch->indices[b] = failed[pos + b][0];
+      batch->statuses[b] = failed[pos + b][1];
+      batch->tokens[b] = 0;
+    }
+    pipeline_submit(p, batch);
+  }
+  return 0;
+}
+
+/**
+ * @brief Tokenize one window of texts and queue it as padded batches
+ *
+ * @param scratch MAX_SEQUENCE_LENGTH tokens
+ * @param token_pool Grown as needed; kept across windows
+ * @param schedule PIPELINE_WINDOW entries
+ * @param failed PIPELINE_WINDOW entries
+ * @return 0 on success, -1 once the pipeline is aborted
+ */
+static int pipeline_tokenize_window(Pipeline *p, int window_start,
+                                    int64_t *scratch, int64_t **token_pool,
+                                    size_t *pool_capacity, int (*schedule)[3],
+                                    int (*failed)[2]) {
+  int window_size = p->num_texts - window_start < PIPELINE_WINDOW
+                        ? p->num_texts - window_start
+                        : PIPELINE_WINDOW;
+  int count = 0;
+  int failed_count = 0;
+  size_t pool_used = 0;
+
+  uint64_t start = stats_now();
+  for (int i = 0; i < window_size; i++) {
+    int text_index = window_start + i;
+    const char *text = p->texts[text_index];
+    int tokens = text != NULL ? tokenize_text(p->model, text, scratch,
+                                              MAX_SEQUENCE_LENGTH)
+                              : -1;
+    if (tokens > 0 && reserve_buffer((void **)token_pool, pool_capacity,
+                                     pool_used + tokens,
+                                     sizeof(int64_t)) != 0)
+      tokens = -1;
+    if (tokens <= 0) {
+      failed[failed_count][0] = text_index;
+      failed[failed_count][1] =
+          text != NULL ? FASTEMBED_STATUS_ERROR : FASTEMBED_STATUS_NULL_INPUT;
+      failed_count++;
+      continue;
+    }
+    memcpy(*token_pool + pool_used, scratch, tokens * sizeof(int64_t));
+    schedule[count][0] = text_index;
+    schedule[count][1] = tokens;
+    schedule[count][2] = (int)pool_used;
+    pool_used += tokens;
+    count++;
+  }
+  stats_record_stage(FASTEMBED_STAGE_TOKENIZE, start);
+
+  if (pipeline_submit_failed(p, failed, failed_count) != 0)
+    return -1;
+
+  qsort(schedule, count, sizeof(*schedule), compare_by_token_count);
+  int pos = 0;
+  while (pos < count) {
+    int batch_size = schedule_batch_size(schedule, pos, count);
+    int seq_len = schedule[pos + batch_size - 1][1];
+    PipelineBatch *batch = pipeline_take_free(p);
+    if (batch == NULL)
+      return -1;
+
+    batch->count = batch_size;
+    batch->seq_len = seq_len;
+    for (int b = 0; b < batch_size; b++) {
+      batch->indices[b] = schedule[pos + b][0];
+      batch->tokens[b] = schedule[pos + b][1];
+      batch->statuses[b] = FASTEMBED_STATUS_OK;
+    }
+    if (reserve_buffer((void **)&batch->inputs, &batch->input_capacity,
+                       (size_t)batch_size * seq_len * 3,
+                       sizeof(int64_t)) == 0) {
+      fill_padded_batch(p->model, batch->inputs, *token_pool,
+                        schedule + pos, batch_size, seq_len);
+    } else {
+      batch->seq_len = 0;
+      for (int b = 0; b < batch_size; b++)
+        batch->statuses[b] = FASTEMBED_STATUS_ERROR;
+    }
+    pipeline_submit(p, batch);
+    pos += batch_size;
+  }
+  return 0;
+}
+
+/**
+ * @brief Tokenizer stage: take windows until the texts run out
+ */
+FASTEMBED_THREAD_FUNC(pipeline_tokenizer_main) {
+  Pipeline *p = (Pipeline *)arg;
+  int64_t *scratch = (int64_t *)malloc(MAX_SEQUENCE_LENGTH * sizeof(int64_t));
+  int (*schedule)[3] =
+      (int (*)[3])malloc(PIPELINE_WINDOW * sizeof(*schedule));
+  int (*failed)[2] = (int (*)[2])malloc(PIPELINE_WINDOW * sizeof(*failed));
+  int64_t *token_pool = NULL;
+  size_t pool_capacity = 0;
+
+  if (scratch == NULL || schedule == NULL || failed == NULL) {
+    pipeline_abort(p, "Failed to allocate tokenizer buffers");
+  } else {
+    while (!fastembed_atomic_load(&p->aborted)) {
+      int window_start =
+          fastembed_atomic_fetch_add(&p->next_window, PIPELINE_WINDOW);
+      if (window_start >= p->num_texts ||
+          pipeline_tokenize_window(p, window_start, scratch, &token_pool,
+                                   &pool_capacity, schedule, failed) != 0)
+        break;
+    }
+  }
+
+  free(token_pool);
+  free(failed);
+  free(schedule);
+  free(scratch);
+
+  fastembed_mutex_lock(&p->mutex);
+  if (--p->tokenizers_running == 0)
+    fastembed_cond_broadcast(&p->ready_cond);
+  fastembed_mutex_unlock(&p->mutex);
+  return 0;
+}
+
+/**
+ * @brief Run one tokenized batch; if it fails, retry its texts one by one
+ */
+static void pipeline_run_batch(Pipeline *p, InferenceContext *ctx,
+                               PipelineBatch *batch) {
+  ModelEntry *model = p->model;
+  float *outputs[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+  for (int b = 0; b < batch->count; b++)
+    outputs[b] = batch->embeddings + (size_t)b * p->output_dim;
+
+  size_t elems = (size_t)batch->count * batch->seq_len;
+  if (ctx != NULL &&
+      reserve_buffer((void **)&ctx->batch_inputs, &ctx->batch_capacity,
+                     elems * 3, sizeof(int64_t)) == 0) {
+    memcpy(ctx->batch_inputs, batch->inputs, elems * 3 * sizeof(int64_t));
+    if (run_padded_batch(model, ctx, batch->count, batch->seq_len, outputs,
+                         p->output_dim) == 0) {
+      uint64_t batch_tokens = 0;
+      for (int b = 0; b < batch->count; b++)
+        batch_tokens += (uint64_t)batch->tokens[b];
+      stats_record_batch(batch->count, batch_tokens, elems);
+      return;
+    }
+  }
+
+  for (int b = 0; b < batch->count; b++) {
+    int tokens = batch->tokens[b];
+    int ok = ctx != NULL && batch->count > 1 &&
+             reserve_buffer((void **)&ctx->batch_inputs, &ctx->batch_capacity,
+                            (size_t)tokens * 3, sizeof(int64_t)) == 0;
+    if (ok) {
+      memcpy(ctx->batch_inputs, batch->inputs + (size_t)b * batch->seq_len,
+             tokens * sizeof(int64_t));
+      for (int t = 0; t < tokens; t++) {
+        ctx->batch_inputs[tokens + t] = 1;
+        ctx->batch_inputs[tokens * 2 + t] = 0;
+      }
+      ok = run_padded_batch(model, ctx, 1, tokens, &outputs[b],
+                            p->output_dim) == 0;
+      if (ok)
+        stats_record_batch(1, (uint64_t)tokens, (uint64_t)tokens);
+    }
+    if (!ok)
+      batch->statuses[b] = FASTEMBED_STATUS_ERROR;
+  }
+}
+
+/**
+ * @brief Inference stage: embed queued batches until the tokenizers finish
+ *
+ * After an abort, queued batches are passed on unprocessed so that the
+ * caller can return them to the free list.
+ */
+FASTEMBED_THREAD_FUNC(pipeline_inference_main) {
+  Pipeline *p = (Pipeline *)arg;
+  InferenceContext *ctx = acquire_inference_context(p->model);
+
+  for (;;) {
+    fastembed_mutex_lock(&p->mutex);
+    while (p->ready.head == NULL && p->tokenizers_running > 0)
+      fastembed_cond_wait(&p->ready_cond, &p->mutex);
+    PipelineBatch *batch = pipeline_pop(&p->ready);
+    int aborted = p->aborted;
+    fastembed_mutex_unlock(&p->mutex);
+    if (batch == NULL)
+      break;
+
+    if (batch->seq_len > 0 && !aborted)
+      pipeline_run_batch(p, ctx, batch);
+
+    fastembed_mutex_lock(&p->mutex);
+    pipeline_push(&p->done, batch);
+    fastembed_cond_broadcast(&p->done_cond);
+    fastembed_mutex_unlock(&p->mutex);
+  }
+
+  release_inference_context(p->model, ctx);
+  fastembed_mutex_lock(&p->mutex);
+  if (--p->inference_running == 0)
+    fastembed_cond_broadcast(&p->done_cond);
+  fastembed_mutex_unlock(&p->mutex);
+  return 0;
+}
+
+/** Convert embedded rows to the requested quantization */
+static const void *pipeline_quantize(Pipeline *p, PipelineBatch *batch) {
+  const float *embeddings = batch->embeddings;
+  int count = batch->count;
+  int dim = p->output_dim;
+  switch (p->options.quantization) {
+  case FASTEMBED_QUANT_INT8:
+    fastembed_quantize_int8(embeddings, count, dim, (int8_t *)batch->rows,
+                            batch->scales);
+    return batch->rows;
+  case FASTEMBED_QUANT_BINARY:
+    fastembed_quantize_binary(embeddings, count, dim, (uint8_t *)batch->rows);
+    return batch->rows;
+  case FASTEMBED_QUANT_FP16:
+    fastembed_f32_to_f16(embeddings, (uint16_t *)batch->rows, count * dim);
+    return batch->rows;
+  case FASTEMBED_QUANT_BF16:
+    fastembed_f32_to_bf16(embeddings, (uint16_t *)batch->rows, count * dim);
+    return batch->rows;
+  default:
+    return embeddings;
+  }
+}
+
+/**
+ * @brief Post-processing stage for one embedded batch (calling thread)
+ *
+ * @return Failed texts in the batch, -1 if the store or on_batch failed
+ */
+static int pipeline_deliver(Pipeline *p, PipelineBatch *batch, int *statuses) {
+  const fastembed_pipeline_options_t *options = &p->options;
+  int dim = p->output_dim;
+  int failures = 0;
+
+  for (int b = 0; b < batch->count; b++) {
+    if (statuses)
+      statuses[batch->indices[b]] = batch->statuses[b];
+    if (batch->statuses[b] != FASTEMBED_STATUS_OK) {
+      memset(batch->embeddings + (size_t)b * dim, 0, dim * sizeof(float));
+      failures++;
+    }
+  }
+  stats_record_texts(batch->count, failures > 0);
+
+  const void *rows = pipeline_quantize(p, batch);
+  int int8 = options->quantization == FASTEMBED_QUANT_INT8;
+  if (options->output != NULL) {
+    for (int b = 0; b < batch->count; b++) {
+      size_t index = (size_t)batch->indices[b];
+      memcpy((char *)options->output + index * p->row_bytes,
+             (const char *)rows + (size_t)b * p->row_bytes, p->row_bytes);
+      if (int8)
+        options->scales[index] = batch->scales[b];
+    }
+  }
+
+  if (options->store != NULL) {
+    /* Append runs of successful rows, with text indices as ids */
+    int64_t ids[FASTEMBED_ONNX_MAX_BATCH_SIZE];
+    int b = 0;
+    while (b < batch->count) {
+      if (batch->statuses[b] != FASTEMBED_STATUS_OK) {
+        b++;
+        continue;
+      }
+      int run = 0;
+      while (b + run < batch->count &&
+             batch->statuses[b + run] == FASTEMBED_STATUS_OK) {
+        ids[run] = batch->indices[b + run];
+        run++;
+      }
+      if (fastembed_store_writer_append(options->store,
+                                        batch->embeddings + (size_t)b * dim,
+                                        run, ids) != 0) {
+        pipeline_abort(p, "Failed to append embeddings to the store");
+        return -1;
+      }
+      b += run;
+    }
+  }
+
+  if (options->on_batch != NULL &&
+      options->on_batch(options->user_data, batch->indices, batch->statuses,
+                        batch->count, rows, int8 ? batch->scales : NULL,
+                        dim) != 0) {
+    pipeline_abort(p, "Pipelined batch aborted by the batch callback");
+    return -1;
+  }
+  return failures;
+}
+
+/** Bytes per embedding row in a fastembed_quantization_t (0 = invalid) */
+static size_t pipeline_row_bytes(int quantization, int dimension) {
+  switch (quantization) {
+  case FASTEMBED_QUANT_NONE:
+    return (size_t)dimension * sizeof(float);
+  case FASTEMBED_QUANT_INT8:
+    return (size_t)dimension;
+  case FASTEMBED_QUANT_BINARY:
+    return (size_t)FASTEMBED_BINARY_BYTES(dimension);
+  case FASTEMBED_QUANT_FP16:
+  case FASTEMBED_QUANT_BF16:
+    return (size_t)dimension * sizeof(uint16_t);
+  default:
+    return 0;
+  }
+}
+
+/** Allocate the pipeline's batches and put them on the free list */
+static int pipeline_alloc_batches(Pipeline *p) {
+  int depth = p->options.queue_depth;
+  p->batches = (PipelineBatch *)calloc((size_t)depth, sizeof(PipelineBatch));
+  if (p->batches == NULL)
+    return -1;
+  for (int i = 0; i < depth; i++) {
+    PipelineBatch *batch = &p->batches[i];
+    batch->embeddings = (float *)malloc((size_t)FASTEMBED_ONNX_MAX_BATCH_SIZE *
+                                        p->output_dim * sizeof(float));
+    if (batch->embeddings == NULL)
+      return -1;
+    if (p->options.quantization != FASTEMBED_QUANT_NONE) {
+      batch->rows =
+          malloc((size_t)FASTEMBED_ONNX_MAX_BATCH_SIZE * p->row_bytes);
+      if (batch->rows == NULL)
+        return -1;
+    }
+    batch->next = p->free_list;
+    p->free_list = batch;
+  }
+  return 0;
+}
+
+static void pipeline_free_batches(Pipeline *p) {
+  if (p->batches == NULL)
+    return;
+  for (int i = 0; i < p->options.queue_depth; i++) {
+    free(p->batches[i].inputs);
+    free(p->batches[i].embeddings);
+    free(p->batches[i].rows);
+  }
+  free(p->batches);
+}
+
+/**
+ * @brief Validate pipeline options (defaults filled in by the wrapper)
+ *
+ * @return 0 if valid, -1 otherwise (error message saved)
+ */
+static int validate_pipeline_options(const fastembed_pipeline_options_t *o,
+                                     int output_dim) {
+  if (o->tokenizer_threads < 1 ||
+      o->tokenizer_threads > FASTEMBED_PIPELINE_MAX_THREADS ||
+      o->inference_threads < 1 ||
+      o->inference_threads > FASTEMBED_PIPELINE_MAX_THREADS ||
+      o->queue_depth < 1) {
+    SAVE_ERROR("Invalid pipeline threads or queue depth: tokenizer=%d, "
+               "inference=%d, queue_depth=%d",
+               o->tokenizer_threads, o->inference_threads, o->queue_depth);
+    return -1;
+  }
+  if (pipeline_row_bytes(o->quantization, output_dim) == 0 ||
+      (o->quantization == FASTEMBED_QUANT_INT8 && o->output != NULL &&
+       o->scales == NULL)) {
+    SAVE_ERROR("Invalid pipeline quantization: %d", o->quantization);
+    return -1;
+  }
+  if (o->output == NULL && o->store == NULL && o->on_batch == NULL) {
+    SAVE_ERROR("Pipeline needs output, store or on_batch");
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Batched inference with tokenization, inference and
+ * post-processing running concurrently
+ *
+ * Starts options->tokenizer_threads tokenizer threads and
+ * options->inference_threads inference threads, and post-processes finished
+ * batches on the calling thread until every text is delivered. At most
+ * queue_depth batches exist, and a batch goes back to the tokenizers once
+ * delivered; that bounds memory and makes the tokenizers wait for slower
+ * stages instead of running ahead.
+ *
+ * @param model Model handle
+ * @param texts Array of input texts (NULL entries fail individually)
+ * @param num_texts Number of texts
+ * @param output_dim Requested output dimension (must match model output)
+ * @param statuses Optional per-text fastembed_status_t output
+ * @param options Pipeline options (required, defaults filled in)
+ * @return Number of failed texts, -1 on invalid arguments, abort or store
+ * failure
+ */
+int onnx_model_generate_pipelined(struct fastembed_model *model,
+                                  const char **texts, int num_texts,
+                                  int output_dim, int *statuses,
+                                  const fastembed_pipeline_options_t *options) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (model == NULL || !texts || num_texts <= 0 || !options ||
+      output_dim <= 0 || output_dim > MAX_OUTPUT_DIM) {
+    SAVE_ERROR("Invalid input parameters: model=%p, texts=%p, "
+               "num_texts=%d, output_dim=%d",
+               (void *)model, (void *)texts, num_texts, output_dim);
+    return -1;
+  }
+  if (validate_pipeline_options(options, output_dim) != 0)
+    return -1;
+
+  Pipeline *p = (Pipeline *)calloc(1, sizeof(*p));
+  if (p == NULL) {
+    SAVE_ERROR("Failed to allocate pipeline state");
+    return -1;
+  }
+  fastembed_mutex_t mutex_init = FASTEMBED_MUTEX_INITIALIZER;
+  fastembed_cond_t cond_init = FASTEMBED_COND_INITIALIZER;
+  p->mutex = mutex_init;
+  p->space = cond_init;
+  p->ready_cond = cond_init;
+  p->done_cond = cond_init;
+  p->model = model;
+  p->texts = texts;
+  p->num_texts = num_texts;
+  p->output_dim = output_dim;
+  p->options = *options;
+  p->row_bytes = pipeline_row_bytes(options->quantization, output_dim);
+
+  int result = -1;
+  fastembed_thread_t tokenizers[FASTEMBED_PIPELINE_MAX_THREADS];
+  fastembed_thread_t inference[FASTEMBED_PIPELINE_MAX_THREADS];
+  int started_tokenizers = 0;
+  int started_inference = 0;
+
+  if (pipeline_alloc_batches(p) != 0) {
+    SAVE_ERROR("Failed to allocate %d pipeline batches (dimension %d)",
+               options->queue_depth, output_dim);
+    goto cleanup;
+  }
+
+  /* Counters first: a stage that finishes early must not see zero */
+  p->tokenizers_running = options->tokenizer_threads;
+  p->inference_running = options->inference_threads;
+  for (; started_tokenizers < options->tokenizer_threads;
+       started_tokenizers++) {
+    if (fastembed_thread_create(&tokenizers[started_tokenizers],
+                                pipeline_tokenizer_main, p) != 0)
+      break;
+  }
+  for (; started_inference < options->inference_threads; started_inference++) {
+    if (fastembed_thread_create(&inference[started_inference],
+                                pipeline_inference_main, p) != 0)
+      break;
+  }
+  fastembed_mutex_lock(&p->mutex);
+  p->tokenizers_running -= options->tokenizer_threads - started_tokenizers;
+  p->inference_running -= options->inference_threads - started_inference;
+  if (started_tokenizers < options->tokenizer_threads ||
+      started_inference == 0)
+    pipeline_abort_locked(p, "Failed to start pipeline threads");
+  /* Wake inference threads if no tokenizer will ever signal */
+  fastembed_cond_broadcast(&p->ready_cond);
+  fastembed_mutex_unlock(&p->mutex);
+
+  /* Post-processing stage; batches left after an abort are only recycled */
+  int failures = 0;
+  for (;;) {
+    fastembed_mutex_lock(&p->mutex);
+    while (p->done.head == NULL && p->inference_running > 0)
+      fastembed_cond_wait(&p->done_cond, &p->mutex);
+    PipelineBatch *batch = pipeline_pop(&p->done);
+    int aborted = p->aborted;
+    fastembed_mutex_unlock(&p->mutex);
+    if (batch == NULL)
+      break;
+
+    if (!aborted) {
+      int delivered = pipeline_deliver(p, batch, statuses);
+      if (delivered > 0)
+        failures += delivered;
+    }
+
+    fastembed_mutex_lock(&p->mutex);
+    batch->next = p->free_list;
+    p->free_list = batch;
+    fastembed_cond_broadcast(&p->space);
+    fastembed_mutex_unlock(&p->mutex);
+  }
+  for (int i = 0; i < started_tokenizers; i++)
+    fastembed_thread_join(tokenizers[i]);
+  for (int i = 0; i < started_inference; i++)
+    fastembed_thread_join(inference[i]);
+
+  if (p->aborted) {
+    SAVE_ERROR("%s", p->error);
+  } else {
+    if (failures > 0)
+      SAVE_ERROR("%d of %d texts failed", failures, num_texts);
+    result = failures;
+  }
+
+cleanup:
+  pipeline_free_batches(p);
+  free(p);
+  return result;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Preload and warmup                                                        */
+/* ------------------------------------------------------------------------ */
+
+#if FASTEMBED_ONNX_WARMUP_LONG_TOKENS + 2 > MAX_SEQUENCE_LENGTH
+#error "FASTEMBED_ONNX_WARMUP_LONG_TOKENS must leave room for [CLS] and [SEP]"
+#endif
+
+#define WARMUP_WORD "the " /* One token in BERT-style vocabularies */
+
+/**
+ * @brief Run warmup inferences at representative shapes
+ *
+ * One text of about FASTEMBED_ONNX_WARMUP_SHORT_TOKENS tokens (query shape),
+ * then a batch of FASTEMBED_ONNX_WARMUP_BATCH_SIZE texts of about
+ * FASTEMBED_ONNX_WARMUP_LONG_TOKENS tokens (document shape). Bypasses the
+ * embedding cache, so no entries are added for the warmup texts.
+ *
+ * @param model Loaded session (referenced by the caller)
+ * @return 0 on success, -1 on error
+ */
+static int warmup_model(ModelEntry *model) {
+  int dimension = model->output_dimension;
+  if (dimension <= 0 || dimension > MAX_OUTPUT_DIM) {
+    SAVE_ERROR("Cannot warm up model with unknown output dimension: %s",
+               model->model_path);
+    return -1;
+  }
+
+  char short_text[FASTEMBED_ONNX_WARMUP_SHORT_TOKENS * sizeof(WARMUP_WORD)];
+  char long_text[FASTEMBED_ONNX_WARMUP_LONG_TOKENS * sizeof(WARMUP_WORD)];
+  size_t word_length = sizeof(WARMUP_WORD) - 1;
+  for (int i = 0; i < FASTEMBED_ONNX_WARMUP_LONG_TOKENS; i++)
+    memcpy(long_text + i * word_length, WARMUP_WORD, word_length);
+  long_text[FASTEMBED_ONNX_WARMUP_LONG_TOKENS * word_length - 1] = '\0';
+  memcpy(short_text, long_text,
+         FASTEMBED_ONNX_WARMUP_SHORT_TOKENS * word_length);
+  short_text[FASTEMBED_ONNX_WARMUP_SHORT_TOKENS * word_length - 1] = '\0';
+
+  float *block = (float *)malloc((size_t)FASTEMBED_ONNX_WARMUP_BATCH_SIZE *
+                                 dimension * sizeof(float));
+  if (block == NULL) {
+    SAVE_ERROR("Failed to allocate warmup outputs");
+    return -1;
+  }
+  const char *texts[FASTEMBED_ONNX_WARMUP_BATCH_SIZE];
+  float *outputs[FASTEMBED_ONNX_WARMUP_BATCH_SIZE];
+  for (int i = 0; i < FASTEMBED_ONNX_WARMUP_BATCH_SIZE; i++) {
+    texts[i] = long_text;
+    outputs[i] = block + (size_t)i * dimension;
+  }
+  const char *short_texts[1] = {short_text};
+
+  int result = -1;
+  InferenceContext *ctx = acquire_inference_context(model);
+  if (ctx != NULL) {
+    result = run_text_batch(model, ctx, short_texts, 1, outputs, dimension);
+    if (result == 0)
+      result = run_text_batch(model, ctx, texts,
+                              FASTEMBED_ONNX_WARMUP_BATCH_SIZE, outputs,
+                              dimension);
+    release_inference_context(model, ctx);
+  }
+  free(block);
+  return result;
+}
+
+/**
+ * @brief Run warmup inferences on an open model handle
+ *
+ * @param model Model handle
+ * @return 0 on success, -1 on error
+ */
+int onnx_model_warmup(struct fastembed_model *model) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (model == NULL) {
+    SAVE_ERROR("Invalid model handle: NULL");
+    return -1;
+  }
+  return warmup_model(model);
+}
+
+/**
+ * @brief Load a model into the session cache and warm it up
+ *
+ * Initializes ONNX Runtime and the shared environment if needed, creates (or
+ * reuses) the session for model_path and options, runs warmup_model() and
+ * drops the reference: the session stays cached for later calls with the
+ * same path and options.
+ *
+ * @param model_path Path to .onnx model file
+ * @param options Session options (NULL = defaults, as used by the path-based
+ * functions)
+ * @return 0 on success, -1 on error
+ */
+int onnx_preload(const char *model_path,
+                 const fastembed_onnx_options_t *options) {
+  ModelEntry *model = onnx_model_open(model_path, options);
+  if (model == NULL)
+    return -1;
+
+  int result = warmup_model(model);
+  release_model_entry(model);
+  return result;
+}
+
+/**
+ * Background preload started by onnx_preload_async(). Owns copies of the
+ * path and option strings, and carries the thread's error message back to
+ * the thread that waits for it.
+ */
+struct fastembed_preload {
+  fastembed_thread_t thread;
+  char *model_path;
+  fastembed_onnx_options_t options;
+  int has_options;
+  char *optimized_model_path;
+  char *tokenizer_path;
+  int result;
+  int32_t done;
+  char error[MAX_ERROR_MESSAGE];
+};
+
+static void free_preload(fastembed_preload_t *preload) {
+  free(preload->model_path);
+  free(preload->optimized_model_path);
+  free(preload->tokenizer_path);
+  free(preload);
+}
+
+FASTEMBED_THREAD_FUNC(preload_thread_main) {
+  fastembed_preload_t *preload = (fastembed_preload_t *)arg;
+  preload->result = onnx_preload(
+      preload->model_path, preload->has_options ? &preload->options : NULL);
+  if (preload->result != 0)
+    memcpy(preload->error, g_last_error, MAX_ERROR_MESSAGE);
+  fastembed_atomic_store(&preload->done, 1);
+  return 0;
+}
+
+/**
+ * @brief Start onnx_preload() on a new thread
+ *
+ * @param model_path Path to .onnx model file (copied)
+ * @param options Session options (copied, NULL = defaults)
+ * @return Preload handle to pass to onnx_preload_wait(), NULL on error
+ */
+fastembed_preload_t *
+onnx_preload_async(const char *model_path,
+                   const fastembed_onnx_options_t *options) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (!model_path) {
+    SAVE_ERROR("Invalid model_path: NULL");
+    return NULL;
+  }
+
+  fastembed_preload_t *preload =
+      (fastembed_preload_t *)calloc(1, sizeof(fastembed_preload_t));
+  if (preload == NULL) {
+    SAVE_ERROR("Failed to allocate preload state");
+    return NULL;
+  }
+  preload->model_path = copy_string(model_path);
+  int failed = preload->model_path == NULL;
+  if (options != NULL) {
+    preload->options = *options;
+    preload->has_options = 1;
+    if (options->optimized_model_path != NULL) {
+      preload->optimized_model_path =
+          copy_string(options->optimized_model_path);
+      failed |= preload->optimized_model_path == NULL;
+    }
+    if (options->tokenizer_path != NULL) {
+      preload->tokenizer_path = copy_string(options->tokenizer_path);
+      failed |= preload->tokenizer_path == NULL;
+    }
+    preload->options.optimized_model_path = preload->optimized_model_path;
+    preload->options.tokenizer_path = preload->tokenizer_path;
+  }
+  if (failed) {
+    SAVE_ERROR("Failed to allocate preload state");
+    free_preload(preload);
+    return NULL;
+  }
+
+  if (fastembed_thread_create(&preload->thread, preload_thread_main,
+                              preload) != 0) {
+    SAVE_ERROR("Failed to start preload thread");
+    free_preload(preload);
+    return NULL;
+  }
+  return preload;
+}
+
+/**
+ * @brief Check whether a background preload has finished
+ *
+ * @return 1 if finished, 0 if still running, -1 if preload is NULL
+ */
+int onnx_preload_done(const fastembed_preload_t *preload) {
+  if (preload == NULL)
+    return -1;
+  return fastembed_atomic_load(&preload->done) ? 1 : 0;
+}
+
+/**
+ * @brief Wait for a background preload and free it
+ *
+ * The preload's error message (if it failed) becomes the calling thread's
+ * last error.
+ *
+ * @param preload Handle from onnx_preload_async()
+ * @return Result of onnx_preload(), -1 if preload is NULL
+ */
+int onnx_preload_wait(fastembed_preload_t *preload) {
+  /* Clear previous error */
+  g_last_error[0] = '\0';
+
+  if (preload == NULL) {
+    SAVE_ERROR("Invalid preload handle: NULL");
+    return -1;
+  }
+
+  fastembed_thread_join(preload->thread);
+  int result = preload->result;
+  if (result != 0)
+    memcpy(g_last_error, preload->error, MAX_ERROR_MESSAGE);
+  free_preload(preload);
+  return result;
+}
+
+/**
+ * @brief Set the maximum number of idle sessions kept in the registry
+ *
+ * Least recently used idle sessions beyond the capacity are unloaded
+ * immediately. Sessions with open handles are never evicted.
+ *
+ * @param capacity Maximum cached models (>= 1)
+ * @return 0 on success, -1 on invalid capacity
+ */
+int onnx_set_model_cache_capacity(int capacity) {
+  if (capacity < 1)
+    return -1;
+
+  ModelEntry *evicted = NULL;
+  fastembed_mutex_lock(&g_registry_mutex);
+  g_registry_capacity = capacity;
+  evict_idle_entries(&evicted);
+  fastembed_mutex_unlock(&g_registry_mutex);
+
+  destroy_entry_list(evicted);
+  return 0;
 }
 
 /**
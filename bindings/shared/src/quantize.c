@@ -0,0 +1,555 @@
+/**
+ * @file quantize.c
+ * @brief Int8 and binary quantization of embeddings and their distance
+ * kernels
+ *
+ * Quantized embeddings trade a little accuracy for much smaller, faster
+ * collections:
+ * - int8: symmetric scalar quantization with one float scale per vector
+ * (x ~ code * scale, codes in [-127, 127]), 4x smaller than float32
+ * - binary: one sign bit per dimension (bit set when x > 0), 32x smaller;
+ * vectors are compared by Hamming distance
+ * - fp16 / bf16: IEEE half precision or bfloat16 (the top half of a float),
+ * 2x smaller; converted back to float for scoring
+ *
+ * Kernels (same runtime SIMD dispatch as the float kernels):
+ * - int8_dot_product_asm(): SSE2 pmaddwd, AVX2 pmaddubsw, AVX-512 VNNI
+ * vpdpbusd, NEON smull + sadalp
+ * - hamming_distance_asm(): SWAR / POPCNT, AVX-512 VPOPCNTDQ, NEON cnt
+ * - f16_to_f32_asm() / f32_to_f16_asm(): F16C, AVX-512, NEON fcvtl/fcvtn
+ * (the SSE level has no half-precision instructions and uses the C code)
+ * - bf16_to_f32_asm() / f32_to_bf16_asm(): SSE2, AVX2, AVX-512, NEON
+ *
+ * A typical pipeline searches binary codes for a shortlist
+ * (fastembed_topk_binary()) and reranks it with the float vectors
+ * (fastembed_topk_rescore()).
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+
+#ifndef USE_ONLY_C
+/** External assembly function: exact int32 dot product of int8 vectors */
+extern int32_t int8_dot_product_asm(const int8_t *a, const int8_t *b, int n);
+
+/** External assembly function: number of differing bits */
+extern int hamming_distance_asm(const uint8_t *a, const uint8_t *b,
+                                int num_bytes);
+
+/**
+ * External assembly functions: convert the leading elements (a multiple of
+ * the vector width) and return how many were converted
+ */
+extern int f16_to_f32_asm(const uint16_t *input, float *output, int count);
+extern int f32_to_f16_asm(const float *input, uint16_t *output, int count);
+extern int bf16_to_f32_asm(const uint16_t *input, float *output, int count);
+extern int f32_to_bf16_asm(const float *input, uint16_t *output, int count);
+#else
+/** C implementation: exact int32 dot product of int8 vectors */
+static int32_t int8_dot_product_asm(const int8_t *a, const int8_t *b, int n) {
+  int32_t sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += (int32_t)a[i] * (int32_t)b[i];
+  }
+  return sum;
+}
+
+/** C implementation: population count of a 64-bit word */
+static int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/** C implementation: number of differing bits */
+static int hamming_distance_asm(const uint8_t *a, const uint8_t *b,
+                                int num_bytes) {
+  int distance = 0;
+  int i = 0;
+  for (; i + 8 <= num_bytes; i += 8) {
+    uint64_t x = 0;
+    for (int j = 0; j < 8; j++) {
+      x |= (uint64_t)(a[i + j] ^ b[i + j]) << (8 * j);
+    }
+    distance += popcount64(x);
+  }
+  for (; i < num_bytes; i++) {
+    distance += popcount64((uint64_t)(a[i] ^ b[i]));
+  }
+  return distance;
+}
+
+/* No vector kernels: the portable conversions below handle every element */
+static int f16_to_f32_asm(const uint16_t *input, float *output, int count) {
+  (void)input;
+  (void)output;
+  (void)count;
+  return 0;
+}
+
+static int f32_to_f16_asm(const float *input, uint16_t *output, int count) {
+  (void)input;
+  (void)output;
+  (void)count;
+  return 0;
+}
+
+static int bf16_to_f32_asm(const uint16_t *input, float *output, int count) {
+  (void)input;
+  (void)output;
+  (void)count;
+  return 0;
+}
+
+static int f32_to_bf16_asm(const float *input, uint16_t *output, int count) {
+  (void)input;
+  (void)output;
+  (void)count;
+  return 0;
+}
+#endif /* USE_ONLY_C */
+
+/** Bit pattern of a float */
+static uint32_t float_bits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/** Float with the given bit pattern */
+static float bits_float(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief IEEE half to float (exact, subnormals included)
+ */
+static float half_to_float(uint16_t half) {
+  uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+
+  if (exponent == 0x1F) {
+    return bits_float(sign | 0x7F800000 | (mantissa << 13)); /* Inf / NaN */
+  }
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      return bits_float(sign);
+    }
+    /* Subnormal: shift the leading 1 into the implicit bit */
+    int shift = 0;
+    while (!(mantissa & 0x400)) {
+      mantissa <<= 1;
+      shift++;
+    }
+    return bits_float(sign | ((uint32_t)(113 - shift) << 23) |
+                      ((mantissa & 0x3FF) << 13));
+  }
+  return bits_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+/**
+ * @brief Float to IEEE half, rounding to nearest even
+ *
+ * Overflow gives infinity, tiny values round to subnormals or zero and NaNs
+ * stay (quiet) NaNs.
+ */
+static uint16_t float_to_half(float value) {
+  uint32_t bits = float_bits(value);
+  uint32_t sign = (bits >> 16) & 0x8000;
+  int exponent = (int)((bits >> 23) & 0xFF);
+  uint32_t mantissa = bits & 0x7FFFFF;
+
+  if (exponent == 0xFF) {
+    return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 | (mantissa >> 13) : 0));
+  }
+
+  int half_exponent = exponent - 127 + 15;
+  if (half_exponent >= 0x1F) {
+    return (uint16_t)(sign | 0x7C00);
+  }
+
+  uint32_t half_mantissa;
+  uint32_t remainder;
+  uint32_t halfway;
+  if (half_exponent <= 0) {
+    if (half_exponent < -10) {
+      return (uint16_t)sign; /* Below half the smallest subnormal */
+    }
+    /* Subnormal result: the implicit bit becomes explicit */
+    mantissa |= 0x800000;
+    int shift = 14 - half_exponent;
+    half_mantissa = mantissa >> shift;
+    remainder = mantissa & ((1u << shift) - 1);
+    halfway = 1u << (shift - 1);
+  } else {
+    half_mantissa = ((uint32_t)half_exponent << 10) | (mantissa >> 13);
+    remainder = mantissa & 0x1FFF;
+    halfway = 0x1000;
+  }
+
+  /* A carry out of the mantissa correctly bumps the exponent */
+  if (remainder > halfway || (remainder == halfway && (half_mantissa & 1))) {
+    half_mantissa++;
+  }
+  return (uint16_t)(sign | half_mantissa);
+}
+
+/**
+ * @brief Float to bfloat16, rounding to nearest even (NaNs stay quiet NaNs)
+ */
+static uint16_t float_to_bf16(float value) {
+  uint32_t bits = float_bits(value);
+  if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+    return (uint16_t)((bits >> 16) | 0x40);
+  }
+  return (uint16_t)((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+}
+
+/**
+ * @brief Quantize float vectors to int8 with one scale per vector
+ *
+ * @param vectors Row-major [num_vectors x dimension] floats
+ * @param num_vectors Number of vectors
+ * @param dimension Vector dimension
+ * @param out_codes Output [num_vectors x dimension] codes in [-127, 127]
+ * @param out_scales Output [num_vectors] scales (0 for zero vectors)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_quantize_int8(const float *vectors,
+                                             int num_vectors, int dimension,
+                                             int8_t *out_codes,
+                                             float *out_scales) {
+  if (!vectors || !out_codes || !out_scales || num_vectors <= 0 ||
+      dimension <= 0) {
+    return -1;
+  }
+
+  for (int v = 0; v < num_vectors; v++) {
+    const float *vector = vectors + (size_t)v * dimension;
+    int8_t *codes = out_codes + (size_t)v * dimension;
+
+    float max_abs = 0.0f;
+    for (int i = 0; i < dimension; i++) {
+      float a = fabsf(vector[i]);
+      if (a > max_abs) {
+        max_abs = a;
+      }
+    }
+
+    if (!(max_abs > 0.0f) || !isfinite(max_abs)) {
+      /* Zero vector (or NaN / Inf components): all codes 0 */
+      for (int i = 0; i < dimension; i++) {
+        codes[i] = 0;
+      }
+      out_scales[v] = 0.0f;
+      continue;
+    }
+
+    float inv_scale = 127.0f / max_abs;
+    for (int i = 0; i < dimension; i++) {
+      long q = lrintf(vector[i] * inv_scale);
+      if (q > 127) {
+        q = 127;
+      } else if (q < -127) {
+        q = -127;
+      }
+      codes[i] = (int8_t)q;
+    }
+    out_scales[v] = max_abs / 127.0f;
+  }
+  return 0;
+}
+
+/**
+ * @brief Reconstruct float vectors from int8 codes (code * scale)
+ *
+ * @param codes Row-major [num_vectors x dimension] codes
+ * @param scales Per-vector scales [num_vectors]
+ * @param num_vectors Number of vectors
+ * @param dimension Vector dimension
+ * @param out_vectors Output [num_vectors x dimension] floats
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_dequantize_int8(const int8_t *codes,
+                                               const float *scales,
+                                               int num_vectors, int dimension,
+                                               float *out_vectors) {
+  if (!codes || !scales || !out_vectors || num_vectors <= 0 ||
+      dimension <= 0) {
+    return -1;
+  }
+
+  for (int v = 0; v < num_vectors; v++) {
+    const int8_t *row = codes + (size_t)v * dimension;
+    float *out = out_vectors + (size_t)v * dimension;
+    for (int i = 0; i < dimension; i++) {
+      out[i] = (float)row[i] * scales[v];
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Pack the sign bits of float vectors
+ *
+ * Bit i of a vector is byte i / 8, bit i % 8 (LSB first); it is set when
+ * component i is positive. Unused bits of the last byte are 0.
+ *
+ * @param vectors Row-major [num_vectors x dimension] floats
+ * @param num_vectors Number of vectors
+ * @param dimension Vector dimension
+ * @param out_bits Output [num_vectors x FASTEMBED_BINARY_BYTES(dimension)]
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_quantize_binary(const float *vectors,
+                                               int num_vectors, int dimension,
+                                               uint8_t *out_bits) {
+  if (!vectors || !out_bits || num_vectors <= 0 || dimension <= 0) {
+    return -1;
+  }
+
+  const int row_bytes = FASTEMBED_BINARY_BYTES(dimension);
+  for (int v = 0; v < num_vectors; v++) {
+    const float *vector = vectors + (size_t)v * dimension;
+    uint8_t *bits = out_bits + (size_t)v * row_bytes;
+
+    for (int b = 0; b < row_bytes; b++) {
+      int begin = b * 8;
+      int end = begin + 8 < dimension ? begin + 8 : dimension;
+      unsigned byte = 0;
+      for (int i = begin; i < end; i++) {
+        byte |= (unsigned)(vector[i] > 0.0f) << (i - begin);
+      }
+      bits[b] = (uint8_t)byte;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Exact dot product of two int8 vectors
+ *
+ * @see fastembed_quantize_int8()
+ */
+FASTEMBED_EXPORT int32_t fastembed_int8_dot_product(const int8_t *vec1,
+                                                    const int8_t *vec2,
+                                                    int dimension) {
+  if (!vec1 || !vec2 || dimension <= 0) {
+    return 0;
+  }
+  return int8_dot_product_asm(vec1, vec2, dimension);
+}
+
+/**
+ * @brief Number of differing bits between two packed bit vectors
+ *
+ * @see fastembed_quantize_binary()
+ */
+FASTEMBED_EXPORT int fastembed_hamming_distance(const uint8_t *bits1,
+                                                const uint8_t *bits2,
+                                                int num_bytes) {
+  if (!bits1 || !bits2 || num_bytes <= 0) {
+    return -1;
+  }
+  return hamming_distance_asm(bits1, bits2, num_bytes);
+}
+
+/**
+ * @brief Convert floats to IEEE half precision (round to nearest even)
+ *
+ * @param input Floats [count]
+ * @param output Half-precision values [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_f32_to_f16(const float *input,
+                                          uint16_t *output, int count) {
+  if (!input || !output || count <= 0) {
+    return -1;
+  }
+  for (int i = f32_to_f16_asm(input, output, count); i < count; i++) {
+    output[i] = float_to_half(input[i]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Convert IEEE half-precision values to floats (exact)
+ *
+ * @param input Half-precision values [count]
+ * @param output Floats [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_f16_to_f32(const uint16_t *input,
+                                          float *output, int count) {
+  if (!input || !output || count <= 0) {
+    return -1;
+  }
+  for (int i = f16_to_f32_asm(input, output, count); i < count; i++) {
+    output[i] = half_to_float(input[i]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Convert floats to bfloat16 (round to nearest even)
+ *
+ * @param input Floats [count]
+ * @param output bfloat16 values [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_f32_to_bf16(const float *input,
+                                           uint16_t *output, int count) {
+  if (!input || !output || count <= 0) {
+    return -1;
+  }
+  for (int i = f32_to_bf16_asm(input, output, count); i < count; i++) {
+    output[i] = float_to_bf16(input[i]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Convert bfloat16 values to floats (exact)
+ *
+ * @param input bfloat16 values [count]
+ * @param output Floats [count]
+ * @param count Number of values
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_bf16_to_f32(const uint16_t *input,
+                                           float *output, int count) {
+  if (!input || !output || count <= 0) {
+    return -1;
+  }
+  for (int i = bf16_to_f32_asm(input, output, count); i < count; i++) {
+    output[i] = bits_float((uint32_t)input[i] << 16);
+  }
+  return 0;
+}
+
+/**
+ * @brief Quantize one freshly generated float embedding into output
+ */
+static int quantize_embedding(const float *embedding, int dimension,
+                              void *output, float *scale, int quantization) {
+  switch (quantization) {
+  case FASTEMBED_QUANT_INT8:
+    return fastembed_quantize_int8(embedding, 1, dimension, (int8_t *)output,
+                                   scale);
+  case FASTEMBED_QUANT_FP16:
+    return fastembed_f32_to_f16(embedding, (uint16_t *)output, dimension);
+  case FASTEMBED_QUANT_BF16:
+    return fastembed_f32_to_bf16(embedding, (uint16_t *)output, dimension);
+  default:
+    return fastembed_quantize_binary(embedding, 1, dimension,
+                                     (uint8_t *)output);
+  }
+}
+
+/**
+ * @brief Check the quantization mode and output pointers
+ */
+static int valid_quantized_output(const void *output, const float *scale,
+                                  int quantization) {
+  if (!output) {
+    return 0;
+  }
+  if (quantization == FASTEMBED_QUANT_INT8) {
+    return scale != NULL;
+  }
+  return quantization == FASTEMBED_QUANT_BINARY ||
+         quantization == FASTEMBED_QUANT_FP16 ||
+         quantization == FASTEMBED_QUANT_BF16;
+}
+
+/**
+ * @brief Generate a hash-based embedding directly in quantized form
+ *
+ * @param text Input text
+ * @param output int8_t[dimension], uint8_t[FASTEMBED_BINARY_BYTES(dimension)]
+ * or uint16_t[dimension] (fp16 / bf16)
+ * @param scale Per-vector scale for FASTEMBED_QUANT_INT8 (may be NULL
+ * otherwise)
+ * @param dimension Embedding dimension (0 = default)
+ * @param quantization fastembed_quantization_t
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_generate_quantized(const char *text,
+                                                  void *output, float *scale,
+                                                  int dimension,
+                                                  int quantization) {
+  if (!text || !valid_quantized_output(output, scale, quantization)) {
+    return -1;
+  }
+  if (dimension == 0) {
+    dimension = FASTEMBED_DEFAULT_DIMENSION;
+  }
+  if (dimension < 0 || dimension > FASTEMBED_MAX_DIMENSION) {
+    return -1;
+  }
+
+  float embedding[FASTEMBED_MAX_DIMENSION];
+  if (fastembed_generate(text, embedding, dimension) != 0) {
+    return -1;
+  }
+  return quantize_embedding(embedding, dimension, output, scale,
+                            quantization);
+}
+
+/**
+ * @brief Generate an ONNX embedding directly in quantized form
+ *
+ * @param model_path Path to .onnx model file
+ * @param text Input text
+ * @param output int8_t[dimension], uint8_t[FASTEMBED_BINARY_BYTES(dimension)]
+ * or uint16_t[dimension] (fp16 / bf16)
+ * @param scale Per-vector scale for FASTEMBED_QUANT_INT8 (may be NULL
+ * otherwise)
+ * @param dimension Model output dimension (0 = auto-detect)
+ * @param quantization fastembed_quantization_t
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_onnx_generate_quantized(const char *model_path,
+                                                       const char *text,
+                                                       void *output,
+                                                       float *scale,
+                                                       int dimension,
+                                                       int quantization) {
+  if (!model_path || !text ||
+      !valid_quantized_output(output, scale, quantization)) {
+    return -1;
+  }
+  if (dimension == 0) {
+#ifdef USE_ONNX_RUNTIME
+    dimension = fastembed_onnx_get_model_dimension(model_path);
+#else
+    dimension = FASTEMBED_DEFAULT_DIMENSION; /* Hash-based fallback */
+#endif
+  }
+  if (dimension <= 0 || dimension > FASTEMBED_MAX_OUTPUT_DIM) {
+    return -1;
+  }
+
+  float embedding[FASTEMBED_MAX_OUTPUT_DIM];
+  if (fastembed_onnx_generate(model_path, text, embedding, dimension) != 0) {
+    return -1;
+  }
+  return quantize_embedding(embedding, dimension, output, scale,
+                            quantization);
+}
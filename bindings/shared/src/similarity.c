@@ -0,0 +1,1031 @@
+/**
+ * @file similarity.c
+ * @brief Batched similarity scoring over row-major embedding matrices
+ *
+ * Scores every query against every corpus row in one call, so bindings can
+ * score a query against a whole collection without one FFI crossing per
+ * vector.
+ *
+ * Performance:
+ * - Register tile: dot_product_x4_asm() loads each query element once and
+ * multiplies it with four corpus rows (SSE / AVX2 / AVX-512 / NEON, same
+ * runtime dispatch as the other vector kernels)
+ * - Cache blocking: the corpus is processed in blocks of about
+ * FASTEMBED_SIMILARITY_BLOCK_BYTES and all queries are scored against a
+ * block while it is in L2, so each corpus row is read from memory once
+ * - Norms for cosine / Euclidean are computed once per vector, not per pair
+ * - Optional threads split the corpus rows; each range runs on the shared
+ * batch thread pool and writes a disjoint set of output columns, so no
+ * locking is needed
+ * - Top-k search scores rows straight into a bounded min-heap per thread,
+ * so no corpus-sized score array is ever allocated. For dot product a row
+ * that cannot enter the heap costs one compare; cosine / Euclidean rows also
+ * need their norm (a second pass over the row, which is still in L1), unless
+ * a bound from the dot product alone already rules the row out
+ * - The same heaps rank int8 codes, binary codes (Hamming distance) and a
+ * shortlist of float rows being rescored
+ * - fp16 / bf16 corpora are widened block by block (tile by tile for top-k)
+ * into small per-thread float buffers, so they are read from memory at half
+ * the bandwidth and still scored by the float kernels
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+#include "fastembed_platform.h"
+#include "thread_pool.h"
+
+#ifndef USE_ONLY_C
+/** External assembly function: dot products of a vector with 4 rows */
+extern void dot_product_x4_asm(const float *vector, const float *rows,
+                               int dimension, float *out);
+#else
+/** C implementation: dot products of a vector with 4 rows */
+static void dot_product_x4_asm(const float *vector, const float *rows,
+                               int dimension, float *out) {
+  const float *row1 = rows + dimension;
+  const float *row2 = row1 + dimension;
+  const float *row3 = row2 + dimension;
+  float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+  for (int i = 0; i < dimension; i++) {
+    float v = vector[i];
+    sum0 += v * rows[i];
+    sum1 += v * row1[i];
+    sum2 += v * row2[i];
+    sum3 += v * row3[i];
+  }
+  out[0] = sum0;
+  out[1] = sum1;
+  out[2] = sum2;
+  out[3] = sum3;
+}
+#endif /* USE_ONLY_C */
+
+/**
+ * @brief Work item: all queries against corpus rows [row_begin, row_end)
+ */
+typedef struct {
+  const float *queries;
+  const float *corpus;
+  const uint16_t *half_corpus; /* Used instead of corpus when not NULL */
+  int half_format;             /* FASTEMBED_QUANT_FP16 / FASTEMBED_QUANT_BF16 */
+  float *block_buffer;         /* Widened half_corpus block */
+  float *out;
+  /* Per-vector norm terms (NULL for dot product): 1 / ||v|| for cosine
+   * (0 for zero vectors), ||v||^2 for Euclidean */
+  const float *query_norms;
+  float *corpus_norms;
+  int num_queries;
+  int num_corpus;
+  int dimension;
+  int metric;
+  int row_begin;
+  int row_end;
+} similarity_task_t;
+
+/**
+ * @brief Norm term of one vector for the given metric
+ */
+static float norm_term(const float *vector, int dimension, int metric) {
+  float norm = fastembed_vector_norm(vector, dimension);
+  if (metric == FASTEMBED_METRIC_EUCLIDEAN) {
+    return norm * norm;
+  }
+  return norm > 0.0f ? 1.0f / norm : 0.0f;
+}
+
+/**
+ * @brief Check for a supported half-precision storage format
+ */
+static int valid_half_format(int format) {
+  return format == FASTEMBED_QUANT_FP16 || format == FASTEMBED_QUANT_BF16;
+}
+
+/**
+ * @brief Widen count half-precision values to floats
+ */
+static void widen_half(const uint16_t *input, int format, size_t count,
+                       float *output) {
+  if (format == FASTEMBED_QUANT_BF16) {
+    fastembed_bf16_to_f32(input, output, (int)count);
+  } else {
+    fastembed_f16_to_f32(input, output, (int)count);
+  }
+}
+
+/**
+ * @brief Number of corpus rows per cache block (multiple of 4, at least 4)
+ */
+static int block_rows_for(int dimension) {
+  size_t rows = FASTEMBED_SIMILARITY_BLOCK_BYTES /
+                ((size_t)dimension * sizeof(float));
+  rows &= ~(size_t)3;
+  if (rows < 4) {
+    rows = 4;
+  }
+  return rows > INT32_MAX ? INT32_MAX & ~3 : (int)rows;
+}
+
+/**
+ * @brief Score all queries against the task's corpus rows
+ */
+static void run_similarity_task(const similarity_task_t *task) {
+  const int dimension = task->dimension;
+  const int block_rows = block_rows_for(dimension);
+
+  for (int block = task->row_begin; block < task->row_end;
+       block += block_rows) {
+    int block_end = task->row_end - block > block_rows ? block + block_rows
+                                                       : task->row_end;
+    const float *block_base;
+    if (task->half_corpus != NULL) {
+      widen_half(task->half_corpus + (size_t)block * dimension,
+                 task->half_format, (size_t)(block_end - block) * dimension,
+                 task->block_buffer);
+      block_base = task->block_buffer;
+    } else {
+      block_base = task->corpus + (size_t)block * dimension;
+    }
+
+    if (task->corpus_norms != NULL) {
+      for (int r = block; r < block_end; r++) {
+        task->corpus_norms[r] =
+            norm_term(block_base + (size_t)(r - block) * dimension, dimension,
+                      task->metric);
+      }
+    }
+
+    for (int q = 0; q < task->num_queries; q++) {
+      const float *query = task->queries + (size_t)q * dimension;
+      float *out_row = task->out + (size_t)q * task->num_corpus;
+      const float *row = block_base;
+
+      int r = block;
+      for (; r + 4 <= block_end; r += 4, row += (size_t)4 * dimension) {
+        dot_product_x4_asm(query, row, dimension, out_row + r);
+      }
+      for (; r < block_end; r++, row += dimension) {
+        out_row[r] = fastembed_dot_product(query, row, dimension);
+      }
+
+      if (task->metric == FASTEMBED_METRIC_COSINE) {
+        float query_inv = task->query_norms[q];
+        for (r = block; r < block_end; r++) {
+          out_row[r] *= query_inv * task->corpus_norms[r];
+        }
+      } else if (task->metric == FASTEMBED_METRIC_EUCLIDEAN) {
+        float query_sq = task->query_norms[q];
+        for (r = block; r < block_end; r++) {
+          /* ||q - c||^2 = ||q||^2 + ||c||^2 - 2 q·c; clamp rounding */
+          float dist_sq =
+              query_sq + task->corpus_norms[r] - 2.0f * out_row[r];
+          out_row[r] = dist_sq > 0.0f ? sqrtf(dist_sq) : 0.0f;
+        }
+      }
+    }
+  }
+}
+
+/** thread_pool_task_fn over an array of similarity_task_t ranges */
+static void similarity_pool_task(void *arg, int begin, int end, int worker) {
+  const similarity_task_t *tasks = (const similarity_task_t *)arg;
+  (void)worker;
+  for (int t = begin; t < end; t++) {
+    run_similarity_task(&tasks[t]);
+  }
+}
+
+/**
+ * @brief Number of pool threads worth using for a matrix of this size
+ *
+ * Only starts the shared pool when more than one thread is worthwhile.
+ */
+static int effective_thread_count(int num_threads, int num_queries,
+                                  int num_corpus, int dimension) {
+  int limit = FASTEMBED_SIMILARITY_MAX_THREADS;
+
+  double work = (double)num_queries * num_corpus * dimension;
+  double by_work = work / FASTEMBED_SIMILARITY_MIN_WORK_PER_THREAD;
+  if (by_work < limit) {
+    limit = (int)by_work;
+  }
+
+  /* Each thread gets at least one 4-row tile */
+  int by_rows = num_corpus / 4;
+  if (by_rows < limit) {
+    limit = by_rows;
+  }
+  if (limit <= 1 || num_threads == 1) {
+    return 1;
+  }
+
+  int workers = thread_pool_workers(num_threads);
+  return workers < limit ? workers : limit;
+}
+
+/**
+ * @brief Shared body of the float and half-precision matrix functions
+ *
+ * Exactly one of corpus and half_corpus is set.
+ */
+static int similarity_matrix_run(const float *queries, int num_queries,
+                                 const float *corpus,
+                                 const uint16_t *half_corpus, int half_format,
+                                 int num_corpus, int dimension, float *out,
+                                 int metric, int num_threads) {
+  if (!queries || (!corpus && !half_corpus) || !out || num_queries <= 0 ||
+      num_corpus <= 0 || dimension <= 0) {
+    return -1;
+  }
+  if (metric != FASTEMBED_METRIC_DOT && metric != FASTEMBED_METRIC_COSINE &&
+      metric != FASTEMBED_METRIC_EUCLIDEAN) {
+    return -1;
+  }
+  if ((size_t)num_queries > SIZE_MAX / sizeof(float) / (size_t)num_corpus) {
+    return -1;
+  }
+
+  float *norms = NULL;
+  if (metric != FASTEMBED_METRIC_DOT) {
+    norms = (float *)malloc(((size_t)num_queries + (size_t)num_corpus) *
+                            sizeof(float));
+    if (!norms) {
+      return -1;
+    }
+    for (int q = 0; q < num_queries; q++) {
+      norms[q] =
+          norm_term(queries + (size_t)q * dimension, dimension, metric);
+    }
+  }
+
+  int thread_count =
+      effective_thread_count(num_threads, num_queries, num_corpus, dimension);
+
+  /* One widened block per thread; never more rows than the corpus has */
+  float *block_buffers = NULL;
+  size_t buffer_floats = 0;
+  if (half_corpus != NULL) {
+    int buffer_rows = block_rows_for(dimension);
+    if (buffer_rows > num_corpus) {
+      buffer_rows = num_corpus;
+    }
+    buffer_floats = (size_t)buffer_rows * dimension;
+    block_buffers = (float *)malloc((size_t)thread_count * buffer_floats *
+                                    sizeof(float));
+    if (!block_buffers) {
+      free(norms);
+      return -1;
+    }
+  }
+
+  similarity_task_t base;
+  base.queries = queries;
+  base.corpus = corpus;
+  base.half_corpus = half_corpus;
+  base.half_format = half_format;
+  base.block_buffer = block_buffers;
+  base.out = out;
+  base.query_norms = norms;
+  base.corpus_norms = norms ? norms + num_queries : NULL;
+  base.num_queries = num_queries;
+  base.num_corpus = num_corpus;
+  base.dimension = dimension;
+  base.metric = metric;
+  base.row_begin = 0;
+  base.row_end = num_corpus;
+
+  if (thread_count <= 1) {
+    run_similarity_task(&base);
+    free(block_buffers);
+    free(norms);
+    return 0;
+  }
+
+  similarity_task_t tasks[FASTEMBED_SIMILARITY_MAX_THREADS];
+
+  /* Contiguous row ranges, split on 4-row tile boundaries */
+  int tiles = (num_corpus + 3) / 4;
+  for (int t = 0; t < thread_count; t++) {
+    tasks[t] = base;
+    int tile_begin = (int)((long long)tiles * t / thread_count);
+    int tile_end = (int)((long long)tiles * (t + 1) / thread_count);
+    tasks[t].row_begin = tile_begin * 4;
+    tasks[t].row_end = tile_end * 4 < num_corpus ? tile_end * 4 : num_corpus;
+    if (block_buffers) {
+      tasks[t].block_buffer = block_buffers + (size_t)t * buffer_floats;
+    }
+  }
+
+  /* One range per pool thread, the calling thread included */
+  thread_pool_run(thread_count, 1, thread_count, similarity_pool_task, tasks);
+
+  free(block_buffers);
+  free(norms);
+  return 0;
+}
+
+/**
+ * @brief Score queries against corpus rows, optionally multithreaded
+ *
+ * @param queries Row-major [num_queries x dimension] matrix
+ * @param num_queries Number of query rows (1 for one-to-many)
+ * @param corpus Row-major [num_corpus x dimension] matrix
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension
+ * @param out Row-major [num_queries x num_corpus] output
+ * @param metric fastembed_metric_t
+ * @param num_threads Threads to split corpus rows over (0 = all CPUs)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_similarity_matrix_threaded(
+    const float *queries, int num_queries, const float *corpus, int num_corpus,
+    int dimension, float *out, int metric, int num_threads) {
+  if (!corpus) {
+    return -1;
+  }
+  return similarity_matrix_run(queries, num_queries, corpus, NULL, 0,
+                               num_corpus, dimension, out, metric,
+                               num_threads);
+}
+
+/**
+ * @brief Score float queries against a half-precision corpus
+ *
+ * @param queries Row-major [num_queries x dimension] matrix
+ * @param num_queries Number of query rows
+ * @param corpus Row-major [num_corpus x dimension] fp16 / bf16 matrix
+ * @param format FASTEMBED_QUANT_FP16 or FASTEMBED_QUANT_BF16
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension
+ * @param out Row-major [num_queries x num_corpus] output
+ * @param metric fastembed_metric_t
+ * @param num_threads Threads to split corpus rows over (0 = all CPUs)
+ * @return 0 on success, -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_similarity_matrix_half(
+    const float *queries, int num_queries, const uint16_t *corpus, int format,
+    int num_corpus, int dimension, float *out, int metric, int num_threads) {
+  if (!corpus || !valid_half_format(format)) {
+    return -1;
+  }
+  return similarity_matrix_run(queries, num_queries, NULL, corpus, format,
+                               num_corpus, dimension, out, metric,
+                               num_threads);
+}
+
+/**
+ * @brief Score queries against corpus rows on the calling thread
+ *
+ * @see fastembed_similarity_matrix_threaded()
+ */
+FASTEMBED_EXPORT int fastembed_similarity_matrix(const float *queries,
+                                                 int num_queries,
+                                                 const float *corpus,
+                                                 int num_corpus, int dimension,
+                                                 float *out, int metric) {
+  return fastembed_similarity_matrix_threaded(queries, num_queries, corpus,
+                                              num_corpus, dimension, out,
+                                              metric, 1);
+}
+
+/**
+ * @brief Top-k candidate; larger key ranks higher
+ */
+typedef struct {
+  float key;
+  int id;
+} topk_entry_t;
+
+/**
+ * @brief How a top-k task scores its rows
+ */
+typedef enum {
+  TOPK_FLOAT = 0,  /* Float rows with a fastembed_metric_t */
+  TOPK_RESCORE,    /* Float rows listed in candidates[] */
+  TOPK_INT8,       /* int8 codes, key = dequantized dot product */
+  TOPK_BINARY,     /* Packed bits, key = -Hamming distance */
+  TOPK_HALF        /* fp16 / bf16 rows with a fastembed_metric_t */
+} topk_kind_t;
+
+/**
+ * @brief Work item: best k corpus rows in [row_begin, row_end)
+ */
+typedef struct {
+  const float *query;
+  const float *corpus;
+  /* 1 / ||q|| for cosine (0 for a zero query), ||q||^2 for Euclidean,
+   * query scale for int8 */
+  float query_term;
+  int dimension;
+  int metric;
+  int kind;
+  const int *candidates;  /* TOPK_RESCORE: row r is corpus row candidates[r] */
+  const void *codes_query; /* TOPK_INT8 / TOPK_BINARY */
+  const void *codes_corpus;
+  const float *corpus_scales; /* TOPK_INT8 */
+  const uint16_t *half_corpus; /* TOPK_HALF */
+  int half_format;
+  float *scratch; /* TOPK_HALF: one widened 4-row tile */
+  int row_begin;
+  int row_end;
+  int k;
+  topk_entry_t *heap; /* Min-heap of up to k entries, worst at heap[0] */
+  int count;
+} topk_task_t;
+
+/**
+ * @brief Total order used for ranking: higher key, then lower id
+ */
+static int topk_better(const topk_entry_t *a, const topk_entry_t *b) {
+  return a->key > b->key || (a->key == b->key && a->id < b->id);
+}
+
+/**
+ * @brief Restore the min-heap property below position i
+ */
+static void topk_sift_down(topk_entry_t *heap, int count, int i) {
+  topk_entry_t entry = heap[i];
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= count) {
+      break;
+    }
+    if (child + 1 < count && topk_better(&heap[child], &heap[child + 1])) {
+      child++;
+    }
+    if (!topk_better(&entry, &heap[child])) {
+      break;
+    }
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = entry;
+}
+
+/**
+ * @brief Offer a candidate to a bounded min-heap of capacity k
+ */
+static void topk_push(topk_entry_t *heap, int *count, int k, float key,
+                      int id) {
+  topk_entry_t entry = {key, id};
+  if (*count < k) {
+    int i = (*count)++;
+    while (i > 0) {
+      int parent = (i - 1) / 2;
+      if (!topk_better(&heap[parent], &entry)) {
+        break;
+      }
+      heap[i] = heap[parent];
+      i = parent;
+    }
+    heap[i] = entry;
+  } else if (topk_better(&entry, &heap[0])) {
+    heap[0] = entry;
+    topk_sift_down(heap, *count, 0);
+  }
+}
+
+/**
+ * @brief Ranking key of one corpus row from its dot product with the query
+ */
+static float topk_key(const topk_task_t *task, float dot, const float *row) {
+  if (task->metric == FASTEMBED_METRIC_COSINE) {
+    return dot * task->query_term *
+           norm_term(row, task->dimension, FASTEMBED_METRIC_COSINE);
+  }
+  if (task->metric == FASTEMBED_METRIC_EUCLIDEAN) {
+    /* Negated squared distance, so that nearer rows rank higher */
+    return 2.0f * dot - task->query_term -
+           norm_term(row, task->dimension, FASTEMBED_METRIC_EUCLIDEAN);
+  }
+  return dot;
+}
+
+/**
+ * @brief Offer one float corpus row to the task's heap
+ *
+ * Once the heap is full, the row norm is skipped when the dot product alone
+ * bounds the key below the heap minimum: a cosine key has the sign of the
+ * dot product, and ||r|| >= |q·r| / ||q|| (Cauchy-Schwarz) bounds the
+ * Euclidean key by -(||q||^2 - q·r)^2 / ||q||^2.
+ */
+static void topk_offer(topk_task_t *task, float dot, const float *row,
+                       int id) {
+  if (task->count == task->k) {
+    float threshold = task->heap[0].key;
+    if (task->metric == FASTEMBED_METRIC_COSINE) {
+      if (dot < 0.0f && threshold > 0.0f) {
+        return;
+      }
+    } else if (task->metric == FASTEMBED_METRIC_EUCLIDEAN) {
+      float query_sq = task->query_term;
+      float gap = query_sq - dot;
+      /* Margin for the rounding of the computed key */
+      float margin = 1e-4f * (query_sq + fabsf(threshold));
+      if (query_sq > 0.0f &&
+          -(gap * gap) / query_sq < threshold - margin) {
+        return;
+      }
+    }
+  }
+  topk_push(task->heap, &task->count, task->k, topk_key(task, dot, row), id);
+}
+
+/**
+ * @brief Score quantized or shortlisted rows into the task's heap
+ */
+static void run_topk_task_rows(topk_task_t *task) {
+  const int dimension = task->dimension;
+
+  if (task->kind == TOPK_RESCORE) {
+    for (int r = task->row_begin; r < task->row_end; r++) {
+      int id = task->candidates[r];
+      const float *row = task->corpus + (size_t)id * dimension;
+      float dot = fastembed_dot_product(task->query, row, dimension);
+      topk_offer(task, dot, row, id);
+    }
+  } else if (task->kind == TOPK_INT8) {
+    const int8_t *query = (const int8_t *)task->codes_query;
+    const int8_t *row =
+        (const int8_t *)task->codes_corpus + (size_t)task->row_begin * dimension;
+    for (int r = task->row_begin; r < task->row_end; r++, row += dimension) {
+      int32_t dot = fastembed_int8_dot_product(query, row, dimension);
+      topk_push(task->heap, &task->count, task->k,
+                (float)dot * task->query_term * task->corpus_scales[r], r);
+    }
+  } else {
+    const int row_bytes = FASTEMBED_BINARY_BYTES(dimension);
+    const uint8_t *query = (const uint8_t *)task->codes_query;
+    const uint8_t *row = (const uint8_t *)task->codes_corpus +
+                         (size_t)task->row_begin * row_bytes;
+    for (int r = task->row_begin; r < task->row_end; r++, row += row_bytes) {
+      int distance = fastembed_hamming_distance(query, row, row_bytes);
+      topk_push(task->heap, &task->count, task->k, -(float)distance, r);
+    }
+  }
+}
+
+/**
+ * @brief Widen and score half-precision rows into the task's heap
+ */
+static void run_topk_task_half(topk_task_t *task) {
+  const int dimension = task->dimension;
+  const uint16_t *row =
+      task->half_corpus + (size_t)task->row_begin * dimension;
+  float *tile = task->scratch;
+  float dots[4];
+
+  int r = task->row_begin;
+  for (; r + 4 <= task->row_end; r += 4, row += (size_t)4 * dimension) {
+    widen_half(row, task->half_format, (size_t)4 * dimension, tile);
+    dot_product_x4_asm(task->query, tile, dimension, dots);
+    for (int j = 0; j < 4; j++) {
+      topk_offer(task, dots[j], tile + (size_t)j * dimension, r + j);
+    }
+  }
+  for (; r < task->row_end; r++, row += dimension) {
+    widen_half(row, task->half_format, (size_t)dimension, tile);
+    float dot = fastembed_dot_product(task->query, tile, dimension);
+    topk_offer(task, dot, tile, r);
+  }
+}
+
+/**
+ * @brief Score the task's corpus rows into its heap
+ */
+static void run_topk_task(topk_task_t *task) {
+  if (task->kind == TOPK_HALF) {
+    run_topk_task_half(task);
+    return;
+  }
+  if (task->kind != TOPK_FLOAT) {
+    run_topk_task_rows(task);
+    return;
+  }
+
+  const int dimension = task->dimension;
+  const float *row = task->corpus + (size_t)task->row_begin * dimension;
+  float dots[4];
+
+  int r = task->row_begin;
+  for (; r + 4 <= task->row_end; r += 4, row += (size_t)4 * dimension) {
+    dot_product_x4_asm(task->query, row, dimension, dots);
+    for (int j = 0; j < 4; j++) {
+      topk_offer(task, dots[j], row + (size_t)j * dimension, r + j);
+    }
+  }
+  for (; r < task->row_end; r++, row += dimension) {
+    float dot = fastembed_dot_product(task->query, row, dimension);
+    topk_offer(task, dot, row, r);
+  }
+}
+
+/** thread_pool_task_fn over an array of topk_task_t ranges */
+static void topk_pool_task(void *arg, int begin, int end, int worker) {
+  topk_task_t *tasks = (topk_task_t *)arg;
+  (void)worker;
+  for (int t = begin; t < end; t++) {
+    run_topk_task(&tasks[t]);
+  }
+}
+
+/**
+ * @brief Task template with no corpus, rows or heap assigned yet
+ */
+static topk_task_t topk_task_defaults(const float *query, int dimension,
+                                      int metric) {
+  topk_task_t task;
+  task.query = query;
+  task.corpus = NULL;
+  task.query_term = 0.0f;
+  task.dimension = dimension;
+  task.metric = metric;
+  task.kind = TOPK_FLOAT;
+  task.candidates = NULL;
+  task.codes_query = NULL;
+  task.codes_corpus = NULL;
+  task.corpus_scales = NULL;
+  task.half_corpus = NULL;
+  task.half_format = 0;
+  task.scratch = NULL;
+  task.row_begin = 0;
+  task.row_end = 0;
+  task.k = 0;
+  task.heap = NULL;
+  task.count = 0;
+  return task;
+}
+
+/**
+ * @brief Rank num_rows rows of a task template, optionally multithreaded
+ *
+ * @param base Task with everything but the row range and heap set
+ * @param num_rows Number of rows to rank
+ * @param k Number of results wanted
+ * @param num_threads Threads to split rows over (0 = all CPUs)
+ * @param out_results Set to a malloc'ed array of the results, best first
+ * (caller frees)
+ * @return Number of results (min(k, num_rows)), -1 on allocation failure
+ */
+static int topk_run(const topk_task_t *base, int num_rows, int k,
+                    int num_threads, topk_entry_t **out_results) {
+  if (k > num_rows) {
+    k = num_rows;
+  }
+
+  /* Work per row in float multiply-adds: quantized rows are cheaper */
+  int row_work = base->dimension;
+  if (base->kind == TOPK_BINARY) {
+    row_work = FASTEMBED_BINARY_BYTES(base->dimension);
+  } else if (base->kind == TOPK_INT8) {
+    row_work = (base->dimension + 3) / 4;
+  }
+  int thread_count = effective_thread_count(num_threads, 1, num_rows,
+                                            row_work > 0 ? row_work : 1);
+
+  /* One heap per thread plus the merge heap */
+  topk_entry_t *heaps = (topk_entry_t *)malloc(
+      ((size_t)thread_count + 1) * (size_t)k * sizeof(topk_entry_t));
+  if (!heaps) {
+    return -1;
+  }
+
+  /* Half-precision rows are widened one 4-row tile at a time */
+  float *scratch = NULL;
+  if (base->kind == TOPK_HALF) {
+    scratch = (float *)malloc((size_t)thread_count * 4 * base->dimension *
+                              sizeof(float));
+    if (!scratch) {
+      free(heaps);
+      return -1;
+    }
+  }
+
+  topk_task_t tasks[FASTEMBED_SIMILARITY_MAX_THREADS];
+
+  /* Contiguous row ranges, split on 4-row tile boundaries */
+  int tiles = (num_rows + 3) / 4;
+  for (int t = 0; t < thread_count; t++) {
+    int tile_begin = (int)((long long)tiles * t / thread_count);
+    int tile_end = (int)((long long)tiles * (t + 1) / thread_count);
+    tasks[t] = *base;
+    tasks[t].row_begin = tile_begin * 4;
+    tasks[t].row_end = tile_end * 4 < num_rows ? tile_end * 4 : num_rows;
+    tasks[t].k = k;
+    tasks[t].heap = heaps + (size_t)t * k;
+    tasks[t].count = 0;
+    if (scratch) {
+      tasks[t].scratch = scratch + (size_t)t * 4 * base->dimension;
+    }
+  }
+
+  /* One range per pool thread, the calling thread included */
+  thread_pool_run(thread_count, 1, thread_count, topk_pool_task, tasks);
+  free(scratch);
+
+  /* Merge the per-thread heaps */
+  topk_entry_t *merged = heaps + (size_t)thread_count * k;
+  int count = 0;
+  for (int t = 0; t < thread_count; t++) {
+    for (int i = 0; i < tasks[t].count; i++) {
+      topk_push(merged, &count, k, tasks[t].heap[i].key, tasks[t].heap[i].id);
+    }
+  }
+
+  /* Pop worst-first into the back: the array ends up sorted best-first */
+  for (int remaining = count; remaining > 0; remaining--) {
+    topk_entry_t worst = merged[0];
+    merged[0] = merged[remaining - 1];
+    topk_sift_down(merged, remaining - 1, 0);
+    merged[remaining - 1] = worst;
+  }
+
+  /* Hand the results to the caller at the front of the allocation */
+  for (int i = 0; i < count; i++) {
+    heaps[i] = merged[i];
+  }
+  *out_results = heaps;
+  return count;
+}
+
+/**
+ * @brief Write ranked float results as scores (distances for Euclidean)
+ */
+static void topk_emit_scores(const topk_entry_t *results, int count,
+                             int metric, int *out_ids, float *out_scores) {
+  for (int i = 0; i < count; i++) {
+    float score = results[i].key;
+    if (metric == FASTEMBED_METRIC_EUCLIDEAN) {
+      score = score < 0.0f ? sqrtf(-score) : 0.0f;
+    }
+    out_ids[i] = results[i].id;
+    out_scores[i] = score;
+  }
+}
+
+/**
+ * @brief Find the k corpus rows most similar to a query, optionally
+ * multithreaded
+ *
+ * @param query Query vector [dimension]
+ * @param corpus Row-major [num_corpus x dimension] matrix
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension
+ * @param k Number of results wanted
+ * @param out_ids Row indices, best first [k]
+ * @param out_scores Scores of those rows [k]
+ * @param metric fastembed_metric_t
+ * @param num_threads Threads to split corpus rows over (0 = all CPUs)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_threaded(const float *query,
+                                             const float *corpus,
+                                             int num_corpus, int dimension,
+                                             int k, int *out_ids,
+                                             float *out_scores, int metric,
+                                             int num_threads) {
+  if (!query || !corpus || !out_ids || !out_scores || num_corpus <= 0 ||
+      dimension <= 0 || k <= 0) {
+    return -1;
+  }
+  if (metric != FASTEMBED_METRIC_DOT && metric != FASTEMBED_METRIC_COSINE &&
+      metric != FASTEMBED_METRIC_EUCLIDEAN) {
+    return -1;
+  }
+
+  topk_task_t base = topk_task_defaults(query, dimension, metric);
+  base.corpus = corpus;
+  if (metric != FASTEMBED_METRIC_DOT) {
+    base.query_term = norm_term(query, dimension, metric);
+  }
+
+  topk_entry_t *results = NULL;
+  int count = topk_run(&base, num_corpus, k, num_threads, &results);
+  if (count < 0) {
+    return -1;
+  }
+
+  topk_emit_scores(results, count, metric, out_ids, out_scores);
+
+  free(results);
+  return count;
+}
+
+/**
+ * @brief Find the k half-precision corpus rows most similar to a query
+ *
+ * @param query Query vector [dimension]
+ * @param corpus Row-major [num_corpus x dimension] fp16 / bf16 matrix
+ * @param format FASTEMBED_QUANT_FP16 or FASTEMBED_QUANT_BF16
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension
+ * @param k Number of results wanted
+ * @param out_ids Row indices, best first [k]
+ * @param out_scores Scores of those rows [k]
+ * @param metric fastembed_metric_t
+ * @param num_threads Threads to split corpus rows over (0 = all CPUs)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_half(const float *query,
+                                         const uint16_t *corpus, int format,
+                                         int num_corpus, int dimension, int k,
+                                         int *out_ids, float *out_scores,
+                                         int metric, int num_threads) {
+  if (!query || !corpus || !out_ids || !out_scores || num_corpus <= 0 ||
+      dimension <= 0 || k <= 0 || !valid_half_format(format)) {
+    return -1;
+  }
+  if (metric != FASTEMBED_METRIC_DOT && metric != FASTEMBED_METRIC_COSINE &&
+      metric != FASTEMBED_METRIC_EUCLIDEAN) {
+    return -1;
+  }
+
+  topk_task_t base = topk_task_defaults(query, dimension, metric);
+  base.kind = TOPK_HALF;
+  base.half_corpus = corpus;
+  base.half_format = format;
+  if (metric != FASTEMBED_METRIC_DOT) {
+    base.query_term = norm_term(query, dimension, metric);
+  }
+
+  topk_entry_t *results = NULL;
+  int count = topk_run(&base, num_corpus, k, num_threads, &results);
+  if (count < 0) {
+    return -1;
+  }
+
+  topk_emit_scores(results, count, metric, out_ids, out_scores);
+
+  free(results);
+  return count;
+}
+
+/**
+ * @brief Find the k corpus rows with the highest cosine similarity to a
+ * query on the calling thread
+ *
+ * @see fastembed_topk_threaded()
+ */
+FASTEMBED_EXPORT int fastembed_topk(const float *query, const float *corpus,
+                                    int num_corpus, int dimension, int k,
+                                    int *out_ids, float *out_scores) {
+  return fastembed_topk_threaded(query, corpus, num_corpus, dimension, k,
+                                 out_ids, out_scores, FASTEMBED_METRIC_COSINE,
+                                 1);
+}
+
+/**
+ * @brief Rerank a shortlist of corpus rows with exact float scores
+ *
+ * @param query Query vector [dimension]
+ * @param corpus Row-major [num_corpus x dimension] matrix
+ * @param num_corpus Number of corpus rows (bounds for candidate_ids)
+ * @param dimension Vector dimension
+ * @param candidate_ids Corpus rows to score (distinct) [num_candidates]
+ * @param num_candidates Number of candidates
+ * @param k Number of results wanted
+ * @param out_ids Corpus row indices, best first [k]
+ * @param out_scores Scores of those rows [k]
+ * @param metric fastembed_metric_t
+ * @return Number of results written (min(k, num_candidates)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_rescore(const float *query,
+                                            const float *corpus,
+                                            int num_corpus, int dimension,
+                                            const int *candidate_ids,
+                                            int num_candidates, int k,
+                                            int *out_ids, float *out_scores,
+                                            int metric) {
+  if (!query || !corpus || !candidate_ids || !out_ids || !out_scores ||
+      num_corpus <= 0 || dimension <= 0 || num_candidates <= 0 || k <= 0) {
+    return -1;
+  }
+  if (metric != FASTEMBED_METRIC_DOT && metric != FASTEMBED_METRIC_COSINE &&
+      metric != FASTEMBED_METRIC_EUCLIDEAN) {
+    return -1;
+  }
+  for (int i = 0; i < num_candidates; i++) {
+    if (candidate_ids[i] < 0 || candidate_ids[i] >= num_corpus) {
+      return -1;
+    }
+  }
+
+  topk_task_t base = topk_task_defaults(query, dimension, metric);
+  base.corpus = corpus;
+  base.kind = TOPK_RESCORE;
+  base.candidates = candidate_ids;
+  if (metric != FASTEMBED_METRIC_DOT) {
+    base.query_term = norm_term(query, dimension, metric);
+  }
+
+  /* Shortlists are small: random row access on the calling thread */
+  topk_entry_t *results = NULL;
+  int count = topk_run(&base, num_candidates, k, 1, &results);
+  if (count < 0) {
+    return -1;
+  }
+
+  topk_emit_scores(results, count, metric, out_ids, out_scores);
+
+  free(results);
+  return count;
+}
+
+/**
+ * @brief Find the k int8-quantized rows with the highest dot product
+ *
+ * @param query_codes Query codes [dimension]
+ * @param query_scale Query scale
+ * @param corpus_codes Row-major [num_corpus x dimension] codes
+ * @param corpus_scales Per-row scales [num_corpus]
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension
+ * @param k Number of results wanted
+ * @param out_ids Row indices, best first [k]
+ * @param out_scores Dot products of the dequantized vectors [k]
+ * @param num_threads Threads to split corpus rows over (0 = all CPUs)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_int8(const int8_t *query_codes,
+                                         float query_scale,
+                                         const int8_t *corpus_codes,
+                                         const float *corpus_scales,
+                                         int num_corpus, int dimension, int k,
+                                         int *out_ids, float *out_scores,
+                                         int num_threads) {
+  if (!query_codes || !corpus_codes || !corpus_scales || !out_ids ||
+      !out_scores || num_corpus <= 0 || dimension <= 0 || k <= 0) {
+    return -1;
+  }
+
+  topk_task_t base =
+      topk_task_defaults(NULL, dimension, FASTEMBED_METRIC_DOT);
+  base.kind = TOPK_INT8;
+  base.query_term = query_scale;
+  base.codes_query = query_codes;
+  base.codes_corpus = corpus_codes;
+  base.corpus_scales = corpus_scales;
+
+  topk_entry_t *results = NULL;
+  int count = topk_run(&base, num_corpus, k, num_threads, &results);
+  if (count < 0) {
+    return -1;
+  }
+
+  for (int i = 0; i < count; i++) {
+    out_ids[i] = results[i].id;
+    out_scores[i] = results[i].key;
+  }
+
+  free(results);
+  return count;
+}
+
+/**
+ * @brief Find the k binary-quantized rows nearest in Hamming distance
+ *
+ * @param query_bits Query bits [FASTEMBED_BINARY_BYTES(dimension)]
+ * @param corpus_bits Row-major [num_corpus x FASTEMBED_BINARY_BYTES(
+ * dimension)] bits
+ * @param num_corpus Number of corpus rows
+ * @param dimension Vector dimension in bits
+ * @param k Number of results wanted
+ * @param out_ids Row indices, nearest first [k]
+ * @param out_distances Hamming distances of those rows [k]
+ * @param num_threads Threads to split corpus rows over (0 = all CPUs)
+ * @return Number of results written (min(k, num_corpus)), -1 on error
+ */
+FASTEMBED_EXPORT int fastembed_topk_binary(const uint8_t *query_bits,
+                                           const uint8_t *corpus_bits,
+                                           int num_corpus, int dimension,
+                                           int k, int *out_ids,
+                                           int *out_distances,
+                                           int num_threads) {
+  if (!query_bits || !corpus_bits || !out_ids || !out_distances ||
+      num_corpus <= 0 || dimension <= 0 || k <= 0) {
+    return -1;
+  }
+
+  topk_task_t base =
+      topk_task_defaults(NULL, dimension, FASTEMBED_METRIC_DOT);
+  base.kind = TOPK_BINARY;
+  base.codes_query = query_bits;
+  base.codes_corpus = corpus_bits;
+
+  topk_entry_t *results = NULL;
+  int count = topk_run(&base, num_corpus, k, num_threads, &results);
+  if (count < 0) {
+    return -1;
+  }
+
+  for (int i = 0; i < count; i++) {
+    out_ids[i] = results[i].id;
+    out_distances[i] = (int)-results[i].key;
+  }
+
+  free(results);
+  return count;
+}
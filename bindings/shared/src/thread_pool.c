@@ -0,0 +1,339 @@
+/**
+ * @file thread_pool.c
+ * @brief Shared work-stealing thread pool for batch APIs
+ *
+ * Workers sleep on a condition variable between jobs, so a batch call costs
+ * one wake-up instead of creating threads. A job gives every participating
+ * thread a contiguous range of items guarded by its own small lock:
+ * - the owner takes grain items from the front of its range;
+ * - a thread whose range is empty takes the back half of the next
+ *   non-empty range (scanning from its right neighbour) and continues with
+ *   that as its own range;
+ * - a thread leaves the job when every range is empty.
+ *
+ * Only one job runs at a time; a second caller (or a nested call from a
+ * task) runs its items inline on its own thread.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* pthread_setaffinity_np() */
+#endif
+
+#include <stdint.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+#include "fastembed_platform.h"
+#include "thread_pool.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+/** One thread's share of a job; [begin, end) still to be taken */
+typedef struct {
+  fastembed_mutex_t lock;
+  int begin;
+  int end;
+  char padding[64]; /* Keep neighbouring ranges off one cache line */
+} pool_range_t;
+
+typedef struct {
+  thread_pool_task_fn fn;
+  void *arg;
+  int grain;
+  int participants;
+  pool_range_t ranges[FASTEMBED_THREAD_POOL_MAX_THREADS];
+} pool_job_t;
+
+/** Pool state; every field is guarded by mutex */
+static struct {
+  fastembed_mutex_t mutex;
+  fastembed_cond_t wake; /* Workers: new job or shutdown */
+  fastembed_cond_t idle; /* Callers: job finished */
+  int configured_size;   /* 0 = one thread per logical CPU */
+  int pin_threads;
+  int size; /* Threads including the caller; 0 = not started */
+  fastembed_thread_t threads[FASTEMBED_THREAD_POOL_MAX_THREADS];
+  pool_job_t *job;
+  unsigned generation;       /* Incremented per job */
+  unsigned start_generation; /* generation when the workers were started */
+  int pending;         /* Participating workers still running the job */
+  int busy;            /* A job (or a shutdown) is in progress */
+  int shutdown;
+} g_pool = {FASTEMBED_MUTEX_INITIALIZER, FASTEMBED_COND_INITIALIZER,
+            FASTEMBED_COND_INITIALIZER};
+
+/** Set on pool threads and while a caller runs a job: nested runs go inline */
+static FASTEMBED_THREAD_LOCAL int g_in_pool_task = 0;
+
+/**
+ * @brief Pin the calling thread to one logical CPU (best effort)
+ *
+ * No-op where the platform has no affinity API (macOS).
+ */
+static void pin_current_thread(int cpu) {
+#if defined(_WIN32)
+  int bits = (int)(sizeof(DWORD_PTR) * 8);
+  SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (cpu % bits));
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % CPU_SETSIZE, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+
+/** Take up to grain items from the front of a range; 0 if it is empty */
+static int take_front(pool_range_t *range, int grain, int *begin, int *end) {
+  fastembed_mutex_lock(&range->lock);
+  int taken = range->begin < range->end;
+  if (taken) {
+    *begin = range->begin;
+    *end = range->end - range->begin > grain ? range->begin + grain
+                                             : range->end;
+    range->begin = *end;
+  }
+  fastembed_mutex_unlock(&range->lock);
+  return taken;
+}
+
+/**
+ * @brief Move the back half of another thread's range into our own
+ *
+ * @return 1 if items were stolen, 0 if every other range is empty
+ */
+static int steal_range(pool_job_t *job, int self) {
+  for (int step = 1; step < job->participants; step++) {
+    pool_range_t *victim = &job->ranges[(self + step) % job->participants];
+
+    fastembed_mutex_lock(&victim->lock);
+    int remaining = victim->end - victim->begin;
+    int stolen_begin = victim->end - (remaining + 1) / 2;
+    int stolen_end = victim->end;
+    if (remaining > 0)
+      victim->end = stolen_begin;
+    fastembed_mutex_unlock(&victim->lock);
+
+    if (remaining > 0) {
+      /* Our range is empty, so no thief is touching it */
+      pool_range_t *own = &job->ranges[self];
+      fastembed_mutex_lock(&own->lock);
+      own->begin = stolen_begin;
+      own->end = stolen_end;
+      fastembed_mutex_unlock(&own->lock);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/** Work on a job until no items are left anywhere */
+static void run_participant(pool_job_t *job, int self) {
+  int begin, end;
+  for (;;) {
+    while (take_front(&job->ranges[self], job->grain, &begin, &end))
+      job->fn(job->arg, begin, end, self);
+    if (!steal_range(job, self))
+      return;
+  }
+}
+
+FASTEMBED_THREAD_FUNC(pool_worker_main) {
+  int self = (int)(intptr_t)arg;
+  g_in_pool_task = 1;
+
+  fastembed_mutex_lock(&g_pool.mutex);
+  if (g_pool.pin_threads)
+    pin_current_thread(self);
+  /* A job may have been posted before this thread first got the mutex */
+  unsigned seen = g_pool.start_generation;
+  for (;;) {
+    while (!g_pool.shutdown && g_pool.generation == seen)
+      fastembed_cond_wait(&g_pool.wake, &g_pool.mutex);
+    if (g_pool.shutdown)
+      break;
+
+    seen = g_pool.generation;
+    pool_job_t *job = g_pool.job;
+    /* A thread that is not needed may only wake after the job finished and
+     * its caller cleared g_pool.job (pending counts participants only) */
+    if (job == NULL || self >= job->participants)
+      continue;
+
+    fastembed_mutex_unlock(&g_pool.mutex);
+    run_participant(job, self);
+    fastembed_mutex_lock(&g_pool.mutex);
+
+    if (--g_pool.pending == 0)
+      fastembed_cond_broadcast(&g_pool.idle);
+  }
+  fastembed_mutex_unlock(&g_pool.mutex);
+  return 0;
+}
+
+/**
+ * @brief Start the worker threads (caller holds the mutex)
+ *
+ * Worker 0 is the calling thread, so size - 1 threads are created. If a
+ * thread fails to start, the pool runs with the ones that did.
+ */
+static void start_pool_locked(void) {
+  int size = g_pool.configured_size > 0 ? g_pool.configured_size
+                                        : fastembed_cpu_count();
+  if (size > FASTEMBED_THREAD_POOL_MAX_THREADS)
+    size = FASTEMBED_THREAD_POOL_MAX_THREADS;
+
+  g_pool.start_generation = g_pool.generation;
+  g_pool.size = 1;
+  for (int i = 1; i < size; i++) {
+    if (fastembed_thread_create(&g_pool.threads[i], pool_worker_main,
+                                (void *)(intptr_t)i) != 0)
+      break;
+    g_pool.size++;
+  }
+}
+
+/** Wait for the current job, then stop and join every worker */
+static void stop_pool(void) {
+  fastembed_mutex_lock(&g_pool.mutex);
+  while (g_pool.busy)
+    fastembed_cond_wait(&g_pool.idle, &g_pool.mutex);
+  int size = g_pool.size;
+  g_pool.busy = 1; /* Concurrent callers run inline meanwhile */
+  g_pool.shutdown = 1;
+  fastembed_cond_broadcast(&g_pool.wake);
+  fastembed_mutex_unlock(&g_pool.mutex);
+
+  for (int i = 1; i < size; i++)
+    fastembed_thread_join(g_pool.threads[i]);
+
+  fastembed_mutex_lock(&g_pool.mutex);
+  g_pool.size = 0;
+  g_pool.shutdown = 0;
+  g_pool.busy = 0;
+  fastembed_cond_broadcast(&g_pool.idle);
+  fastembed_mutex_unlock(&g_pool.mutex);
+}
+
+int thread_pool_workers(int num_threads) {
+  fastembed_mutex_lock(&g_pool.mutex);
+  if (g_pool.size == 0 && !g_pool.busy)
+    start_pool_locked();
+  int size = g_pool.size > 0 ? g_pool.size : 1;
+  fastembed_mutex_unlock(&g_pool.mutex);
+
+  return (num_threads > 0 && num_threads < size) ? num_threads : size;
+}
+
+/** Run every item on the calling thread, grain items per call */
+static void run_inline(int count, int grain, thread_pool_task_fn fn,
+                       void *arg) {
+  for (int begin = 0; begin < count; begin += grain)
+    fn(arg, begin, count - begin > grain ? begin + grain : count, 0);
+}
+
+void thread_pool_run(int count, int grain, int workers, thread_pool_task_fn fn,
+                     void *arg) {
+  if (count <= 0 || fn == NULL)
+    return;
+  if (grain < 1)
+    grain = 1;
+
+  int participants = (count + grain - 1) / grain;
+  if (participants > workers)
+    participants = workers;
+  if (participants <= 1 || g_in_pool_task) {
+    run_inline(count, grain, fn, arg);
+    return;
+  }
+
+  fastembed_mutex_lock(&g_pool.mutex);
+  if (g_pool.busy || g_pool.size < 2) {
+    fastembed_mutex_unlock(&g_pool.mutex);
+    run_inline(count, grain, fn, arg);
+    return;
+  }
+  if (participants > g_pool.size)
+    participants = g_pool.size;
+
+  pool_job_t job;
+  fastembed_mutex_t mutex_init = FASTEMBED_MUTEX_INITIALIZER;
+  job.fn = fn;
+  job.arg = arg;
+  job.grain = grain;
+  job.participants = participants;
+  for (int i = 0; i < participants; i++) {
+    job.ranges[i].lock = mutex_init;
+    job.ranges[i].begin = (int)((int64_t)count * i / participants);
+    job.ranges[i].end = (int)((int64_t)count * (i + 1) / participants);
+  }
+
+  g_pool.busy = 1;
+  g_pool.job = &job;
+  g_pool.pending = participants - 1;
+  g_pool.generation++;
+  fastembed_cond_broadcast(&g_pool.wake);
+  fastembed_mutex_unlock(&g_pool.mutex);
+
+  g_in_pool_task = 1;
+  run_participant(&job, 0);
+  g_in_pool_task = 0;
+
+  fastembed_mutex_lock(&g_pool.mutex);
+  while (g_pool.pending > 0)
+    fastembed_cond_wait(&g_pool.idle, &g_pool.mutex);
+  g_pool.job = NULL;
+  g_pool.busy = 0;
+  fastembed_cond_broadcast(&g_pool.idle);
+  fastembed_mutex_unlock(&g_pool.mutex);
+}
+
+/**
+ * @brief Set the size of the shared batch thread pool
+ *
+ * @param num_threads Threads including the calling thread (0 = one per
+ * logical CPU, at most FASTEMBED_THREAD_POOL_MAX_THREADS)
+ * @param pin_threads Non-zero to pin worker i to logical CPU i
+ * @return 0 on success, -1 on invalid arguments or when called from a pool
+ * task
+ */
+FASTEMBED_EXPORT int fastembed_thread_pool_configure(int num_threads,
+                                                     int pin_threads) {
+  if (num_threads < 0 || num_threads > FASTEMBED_THREAD_POOL_MAX_THREADS ||
+      g_in_pool_task) {
+    return -1;
+  }
+
+  stop_pool();
+
+  fastembed_mutex_lock(&g_pool.mutex);
+  g_pool.configured_size = num_threads;
+  g_pool.pin_threads = pin_threads != 0;
+  fastembed_mutex_unlock(&g_pool.mutex);
+  return 0;
+}
+
+/**
+ * @brief Get the number of threads batch calls use, including the caller
+ *
+ * Starts the pool if it is not running yet.
+ *
+ * @return Pool size (>= 1)
+ */
+FASTEMBED_EXPORT int fastembed_thread_pool_get_size(void) {
+  return thread_pool_workers(0);
+}
+
+/**
+ * @brief Stop the pool's worker threads
+ *
+ * Waits for a running batch to finish. The next parallel call starts the
+ * pool again with the configured size.
+ */
+FASTEMBED_EXPORT void fastembed_thread_pool_shutdown(void) {
+  if (!g_in_pool_task)
+    stop_pool();
+}
@@ -0,0 +1,52 @@
+/**
+ * @file thread_pool.h
+ * @brief Shared work-stealing thread pool for batch APIs
+ *
+ * One process-wide pool of worker threads, started on first use and sized
+ * by fastembed_thread_pool_configure() (default: one thread per logical
+ * CPU). thread_pool_run() splits [0, count) into one contiguous range per
+ * thread; each thread works through its range grain items at a time and,
+ * when it runs out, steals the back half of another thread's remaining
+ * range, so uneven items (long and short texts) still finish together.
+ *
+ * The calling thread takes part as worker 0. Calls made from inside a pool
+ * task, or while another caller's job is running, execute inline on the
+ * calling thread, so nesting and concurrent callers cannot deadlock.
+ *
+ * Internal header - not part of the public API.
+ */
+
+#ifndef FASTEMBED_THREAD_POOL_H
+#define FASTEMBED_THREAD_POOL_H
+
+/**
+ * Task callback: process items [begin, end) (at most grain items) on
+ * worker `worker`, 0 <= worker < the worker count passed to
+ * thread_pool_run(). A worker never runs two calls at once, so per-worker
+ * state indexed by `worker` needs no locking.
+ */
+typedef void (*thread_pool_task_fn)(void *arg, int begin, int end, int worker);
+
+/**
+ * @brief Resolve a thread count request against the pool
+ *
+ * Starts the pool if needed.
+ *
+ * @param num_threads Requested threads (0 = whole pool)
+ * @return Worker count to pass to thread_pool_run(), 1..pool size
+ */
+int thread_pool_workers(int num_threads);
+
+/**
+ * @brief Run fn over [0, count) and wait for it to finish
+ *
+ * @param count Number of items
+ * @param grain Items per task call (>= 1)
+ * @param workers Maximum worker count (from thread_pool_workers())
+ * @param fn Task callback
+ * @param arg Callback argument
+ */
+void thread_pool_run(int count, int grain, int workers, thread_pool_task_fn fn,
+                     void *arg);
+
+#endif /* FASTEMBED_THREAD_POOL_H */
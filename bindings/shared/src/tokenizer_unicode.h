@@ -0,0 +1,534 @@
+/**
+ * @file tokenizer_unicode.h
+ * @brief Unicode character tables for the WordPiece tokenizer
+ *
+ * Range tables used by the BERT-style normalizer and pre-tokenizer for
+ * codepoints outside ASCII (ASCII is handled by a class table in
+ * wordpiece_tokenizer.c). All tables are sorted by codepoint and searched
+ * with binary search.
+ *
+ * Generated from the Unicode 14.0 character database (general categories,
+ * simple lowercase mappings and canonical decompositions) for codepoints
+ * U+0080..U+2FFFF.
+ *
+ * Internal header - included by wordpiece_tokenizer.c only.
+ */
+
+#ifndef FASTEMBED_TOKENIZER_UNICODE_H
+#define FASTEMBED_TOKENIZER_UNICODE_H
+
+#include <stdint.h>
+
+/** Inclusive codepoint range */
+typedef struct {
+  uint32_t first;
+  uint32_t last;
+} fastembed_unicode_range_t;
+
+/** Lowercase run: first..last, every step-th codepoint maps to cp + delta */
+typedef struct {
+  uint32_t first;
+  uint32_t last;
+  int32_t step;
+  int32_t delta;
+} fastembed_unicode_case_t;
+
+/** Single codepoint mapping */
+typedef struct {
+  uint32_t from;
+  uint32_t to;
+} fastembed_unicode_map_t;
+
+/** Unicode general category P* (punctuation), excluding ASCII */
+static const fastembed_unicode_range_t k_punctuation_ranges[] = {
+    {0x00A1, 0x00A1}, {0x00A7, 0x00A7}, {0x00AB, 0x00AB}, {0x00B6, 0x00B7},
+    {0x00BB, 0x00BB}, {0x00BF, 0x00BF}, {0x037E, 0x037E}, {0x0387, 0x0387},
+    {0x055A, 0x055F}, {0x0589, 0x058A}, {0x05BE, 0x05BE}, {0x05C0, 0x05C0},
+    {0x05C3, 0x05C3}, {0x05C6, 0x05C6}, {0x05F3, 0x05F4}, {0x0609, 0x060A},
+    {0x060C, 0x060D}, {0x061B, 0x061B}, {0x061D, 0x061F}, {0x066A, 0x066D},
+    {0x06D4, 0x06D4}, {0x0700, 0x070D}, {0x07F7, 0x07F9}, {0x0830, 0x083E},
+    {0x085E, 0x085E}, {0x0964, 0x0965}, {0x0970, 0x0970}, {0x09FD, 0x09FD},
+    {0x0A76, 0x0A76}, {0x0AF0, 0x0AF0}, {0x0C77, 0x0C77}, {0x0C84, 0x0C84},
+    {0x0DF4, 0x0DF4}, {0x0E4F, 0x0E4F}, {0x0E5A, 0x0E5B}, {0x0F04, 0x0F12},
+    {0x0F14, 0x0F14}, {0x0F3A, 0x0F3D}, {0x0F85, 0x0F85}, {0x0FD0, 0x0FD4},
+    {0x0FD9, 0x0FDA}, {0x104A, 0x104F}, {0x10FB, 0x10FB}, {0x1360, 0x1368},
+    {0x1400, 0x1400}, {0x166E, 0x166E}, {0x169B, 0x169C}, {0x16EB, 0x16ED},
+    {0x1735, 0x1736}, {0x17D4, 0x17D6}, {0x17D8, 0x17DA}, {0x1800, 0x180A},
+    {0x1944, 0x1945}, {0x1A1E, 0x1A1F}, {0x1AA0, 0x1AA6}, {0x1AA8, 0x1AAD},
+    {0x1B5A, 0x1B60}, {0x1B7D, 0x1B7E}, {0x1BFC, 0x1BFF}, {0x1C3B, 0x1C3F},
+    {0x1C7E, 0x1C7F}, {0x1CC0, 0x1CC7}, {0x1CD3, 0x1CD3}, {0x2010, 0x2027},
+    {0x2030, 0x2043}, {0x2045, 0x2051}, {0x2053, 0x205E}, {0x207D, 0x207E},
+    {0x208D, 0x208E}, {0x2308, 0x230B}, {0x2329, 0x232A}, {0x2768, 0x2775},
+    {0x27C5, 0x27C6}, {0x27E6, 0x27EF}, {0x2983, 0x2998}, {0x29D8, 0x29DB},
+    {0x29FC, 0x29FD}, {0x2CF9, 0x2CFC}, {0x2CFE, 0x2CFF}, {0x2D70, 0x2D70},
+    {0x2E00, 0x2E2E}, {0x2E30, 0x2E4F}, {0x2E52, 0x2E5D}, {0x3001, 0x3003},
+    {0x3008, 0x3011}, {0x3014, 0x301F}, {0x3030, 0x3030}, {0x303D, 0x303D},
+    {0x30A0, 0x30A0}, {0x30FB, 0x30FB}, {0xA4FE, 0xA4FF}, {0xA60D, 0xA60F},
+    {0xA673, 0xA673}, {0xA67E, 0xA67E}, {0xA6F2, 0xA6F7}, {0xA874, 0xA877},
+    {0xA8CE, 0xA8CF}, {0xA8F8, 0xA8FA}, {0xA8FC, 0xA8FC}, {0xA92E, 0xA92F},
+    {0xA95F, 0xA95F}, {0xA9C1, 0xA9CD}, {0xA9DE, 0xA9DF}, {0xAA5C, 0xAA5F},
+    {0xAADE, 0xAADF}, {0xAAF0, 0xAAF1}, {0xABEB, 0xABEB}, {0xFD3E, 0xFD3F},
+    {0xFE10, 0xFE19}, {0xFE30, 0xFE52}, {0xFE54, 0xFE61}, {0xFE63, 0xFE63},
+    {0xFE68, 0xFE68}, {0xFE6A, 0xFE6B}, {0xFF01, 0xFF03}, {0xFF05, 0xFF0A},
+    {0xFF0C, 0xFF0F}, {0xFF1A, 0xFF1B}, {0xFF1F, 0xFF20}, {0xFF3B, 0xFF3D},
+    {0xFF3F, 0xFF3F}, {0xFF5B, 0xFF5B}, {0xFF5D, 0xFF5D}, {0xFF5F, 0xFF65},
+    {0x10100, 0x10102}, {0x1039F, 0x1039F}, {0x103D0, 0x103D0},
+    {0x1056F, 0x1056F}, {0x10857, 0x10857}, {0x1091F, 0x1091F},
+    {0x1093F, 0x1093F}, {0x10A50, 0x10A58}, {0x10A7F, 0x10A7F},
+    {0x10AF0, 0x10AF6}, {0x10B39, 0x10B3F}, {0x10B99, 0x10B9C},
+    {0x10EAD, 0x10EAD}, {0x10F55, 0x10F59}, {0x10F86, 0x10F89},
+    {0x11047, 0x1104D}, {0x110BB, 0x110BC}, {0x110BE, 0x110C1},
+    {0x11140, 0x11143}, {0x11174, 0x11175}, {0x111C5, 0x111C8},
+    {0x111CD, 0x111CD}, {0x111DB, 0x111DB}, {0x111DD, 0x111DF},
+    {0x11238, 0x1123D}, {0x112A9, 0x112A9}, {0x1144B, 0x1144F},
+    {0x1145A, 0x1145B}, {0x1145D, 0x1145D}, {0x114C6, 0x114C6},
+    {0x115C1, 0x115D7}, {0x11641, 0x11643}, {0x11660, 0x1166C},
+    {0x116B9, 0x116B9}, {0x1173C, 0x1173E}, {0x1183B, 0x1183B},
+    {0x11944, 0x11946}, {0x119E2, 0x119E2}, {0x11A3F, 0x11A46},
+    {0x11A9A, 0x11A9C}, {0x11A9E, 0x11AA2}, {0x11C41, 0x11C45},
+    {0x11C70, 0x11C71}, {0x11EF7, 0x11EF8}, {0x11FFF, 0x11FFF},
+    {0x12470, 0x12474}, {0x12FF1, 0x12FF2}, {0x16A6E, 0x16A6F},
+    {0x16AF5, 0x16AF5}, {0x16B37, 0x16B3B}, {0x16B44, 0x16B44},
+    {0x16E97, 0x16E9A}, {0x16FE2, 0x16FE2}, {0x1BC9F, 0x1BC9F},
+    {0x1DA87, 0x1DA8B}, {0x1E95E, 0x1E95F},
+};
+
+/** Unicode general category Zs (space separators), excluding ASCII */
+static const fastembed_unicode_range_t k_space_ranges[] = {
+    {0x00A0, 0x00A0}, {0x1680, 0x1680}, {0x2000, 0x200A}, {0x202F, 0x202F},
+    {0x205F, 0x205F}, {0x3000, 0x3000},
+};
+
+/** Unicode general categories Cc and Cf (control, format), excluding ASCII */
+static const fastembed_unicode_range_t k_control_ranges[] = {
+    {0x0080, 0x009F}, {0x00AD, 0x00AD}, {0x0600, 0x0605}, {0x061C, 0x061C},
+    {0x06DD, 0x06DD}, {0x070F, 0x070F}, {0x0890, 0x0891}, {0x08E2, 0x08E2},
+    {0x180E, 0x180E}, {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x2064},
+    {0x2066, 0x206F}, {0xFEFF, 0xFEFF}, {0xFFF9, 0xFFFB}, {0x110BD, 0x110BD},
+    {0x110CD, 0x110CD}, {0x13430, 0x13438}, {0x1BCA0, 0x1BCA3},
+    {0x1D173, 0x1D17A},
+};
+
+/** Unicode general category Mn (non-spacing marks, removed with accents) */
+static const fastembed_unicode_range_t k_nonspacing_mark_ranges[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0487}, {0x0591, 0x05BD}, {0x05BF, 0x05BF},
+    {0x05C1, 0x05C2}, {0x05C4, 0x05C5}, {0x05C7, 0x05C7}, {0x0610, 0x061A},
+    {0x064B, 0x065F}, {0x0670, 0x0670}, {0x06D6, 0x06DC}, {0x06DF, 0x06E4},
+    {0x06E7, 0x06E8}, {0x06EA, 0x06ED}, {0x0711, 0x0711}, {0x0730, 0x074A},
+    {0x07A6, 0x07B0}, {0x07EB, 0x07F3}, {0x07FD, 0x07FD}, {0x0816, 0x0819},
+    {0x081B, 0x0823}, {0x0825, 0x0827}, {0x0829, 0x082D}, {0x0859, 0x085B},
+    {0x0898, 0x089F}, {0x08CA, 0x08E1}, {0x08E3, 0x0902}, {0x093A, 0x093A},
+    {0x093C, 0x093C}, {0x0941, 0x0948}, {0x094D, 0x094D}, {0x0951, 0x0957},
+    {0x0962, 0x0963}, {0x0981, 0x0981}, {0x09BC, 0x09BC}, {0x09C1, 0x09C4},
+    {0x09CD, 0x09CD}, {0x09E2, 0x09E3}, {0x09FE, 0x09FE}, {0x0A01, 0x0A02},
+    {0x0A3C, 0x0A3C}, {0x0A41, 0x0A42}, {0x0A47, 0x0A48}, {0x0A4B, 0x0A4D},
+    {0x0A51, 0x0A51}, {0x0A70, 0x0A71}, {0x0A75, 0x0A75}, {0x0A81, 0x0A82},
+    {0x0ABC, 0x0ABC}, {0x0AC1, 0x0AC5}, {0x0AC7, 0x0AC8}, {0x0ACD, 0x0ACD},
+    {0x0AE2, 0x0AE3}, {0x0AFA, 0x0AFF}, {0x0B01, 0x0B01}, {0x0B3C, 0x0B3C},
+    {0x0B3F, 0x0B3F}, {0x0B41, 0x0B44}, {0x0B4D, 0x0B4D}, {0x0B55, 0x0B56},
+    {0x0B62, 0x0B63}, {0x0B82, 0x0B82}, {0x0BC0, 0x0BC0}, {0x0BCD, 0x0BCD},
+    {0x0C00, 0x0C00}, {0x0C04, 0x0C04}, {0x0C3C, 0x0C3C}, {0x0C3E, 0x0C40},
+    {0x0C46, 0x0C48}, {0x0C4A, 0x0C4D}, {0x0C55, 0x0C56}, {0x0C62, 0x0C63},
+    {0x0C81, 0x0C81}, {0x0CBC, 0x0CBC}, {0x0CBF, 0x0CBF}, {0x0CC6, 0x0CC6},
+    {0x0CCC, 0x0CCD}, {0x0CE2, 0x0CE3}, {0x0D00, 0x0D01}, {0x0D3B, 0x0D3C},
+    {0x0D41, 0x0D44}, {0x0D4D, 0x0D4D}, {0x0D62, 0x0D63}, {0x0D81, 0x0D81},
+    {0x0DCA, 0x0DCA}, {0x0DD2, 0x0DD4}, {0x0DD6, 0x0DD6}, {0x0E31, 0x0E31},
+    {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E}, {0x0EB1, 0x0EB1}, {0x0EB4, 0x0EBC},
+    {0x0EC8, 0x0ECD}, {0x0F18, 0x0F19}, {0x0F35, 0x0F35}, {0x0F37, 0x0F37},
+    {0x0F39, 0x0F39}, {0x0F71, 0x0F7E}, {0x0F80, 0x0F84}, {0x0F86, 0x0F87},
+    {0x0F8D, 0x0F97}, {0x0F99, 0x0FBC}, {0x0FC6, 0x0FC6}, {0x102D, 0x1030},
+    {0x1032, 0x1037}, {0x1039, 0x103A}, {0x103D, 0x103E}, {0x1058, 0x1059},
+    {0x105E, 0x1060}, {0x1071, 0x1074}, {0x1082, 0x1082}, {0x1085, 0x1086},
+    {0x108D, 0x108D}, {0x109D, 0x109D}, {0x135D, 0x135F}, {0x1712, 0x1714},
+    {0x1732, 0x1733}, {0x1752, 0x1753}, {0x1772, 0x1773}, {0x17B4, 0x17B5},
+    {0x17B7, 0x17BD}, {0x17C6, 0x17C6}, {0x17C9, 0x17D3}, {0x17DD, 0x17DD},
+    {0x180B, 0x180D}, {0x180F, 0x180F}, {0x1885, 0x1886}, {0x18A9, 0x18A9},
+    {0x1920, 0x1922}, {0x1927, 0x1928}, {0x1932, 0x1932}, {0x1939, 0x193B},
+    {0x1A17, 0x1A18}, {0x1A1B, 0x1A1B}, {0x1A56, 0x1A56}, {0x1A58, 0x1A5E},
+    {0x1A60, 0x1A60}, {0x1A62, 0x1A62}, {0x1A65, 0x1A6C}, {0x1A73, 0x1A7C},
+    {0x1A7F, 0x1A7F}, {0x1AB0, 0x1ABD}, {0x1ABF, 0x1ACE}, {0x1B00, 0x1B03},
+    {0x1B34, 0x1B34}, {0x1B36, 0x1B3A}, {0x1B3C, 0x1B3C}, {0x1B42, 0x1B42},
+    {0x1B6B, 0x1B73}, {0x1B80, 0x1B81}, {0x1BA2, 0x1BA5}, {0x1BA8, 0x1BA9},
+    {0x1BAB, 0x1BAD}, {0x1BE6, 0x1BE6}, {0x1BE8, 0x1BE9}, {0x1BED, 0x1BED},
+    {0x1BEF, 0x1BF1}, {0x1C2C, 0x1C33}, {0x1C36, 0x1C37}, {0x1CD0, 0x1CD2},
+    {0x1CD4, 0x1CE0}, {0x1CE2, 0x1CE8}, {0x1CED, 0x1CED}, {0x1CF4, 0x1CF4},
+    {0x1CF8, 0x1CF9}, {0x1DC0, 0x1DFF}, {0x20D0, 0x20DC}, {0x20E1, 0x20E1},
+    {0x20E5, 0x20F0}, {0x2CEF, 0x2CF1}, {0x2D7F, 0x2D7F}, {0x2DE0, 0x2DFF},
+    {0x302A, 0x302D}, {0x3099, 0x309A}, {0xA66F, 0xA66F}, {0xA674, 0xA67D},
+    {0xA69E, 0xA69F}, {0xA6F0, 0xA6F1}, {0xA802, 0xA802}, {0xA806, 0xA806},
+    {0xA80B, 0xA80B}, {0xA825, 0xA826}, {0xA82C, 0xA82C}, {0xA8C4, 0xA8C5},
+    {0xA8E0, 0xA8F1}, {0xA8FF, 0xA8FF}, {0xA926, 0xA92D}, {0xA947, 0xA951},
+    {0xA980, 0xA982}, {0xA9B3, 0xA9B3}, {0xA9B6, 0xA9B9}, {0xA9BC, 0xA9BD},
+    {0xA9E5, 0xA9E5}, {0xAA29, 0xAA2E}, {0xAA31, 0xAA32}, {0xAA35, 0xAA36},
+    {0xAA43, 0xAA43}, {0xAA4C, 0xAA4C}, {0xAA7C, 0xAA7C}, {0xAAB0, 0xAAB0},
+    {0xAAB2, 0xAAB4}, {0xAAB7, 0xAAB8}, {0xAABE, 0xAABF}, {0xAAC1, 0xAAC1},
+    {0xAAEC, 0xAAED}, {0xAAF6, 0xAAF6}, {0xABE5, 0xABE5}, {0xABE8, 0xABE8},
+    {0xABED, 0xABED}, {0xFB1E, 0xFB1E}, {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F},
+    {0x101FD, 0x101FD}, {0x102E0, 0x102E0}, {0x10376, 0x1037A},
+    {0x10A01, 0x10A03}, {0x10A05, 0x10A06}, {0x10A0C, 0x10A0F},
+    {0x10A38, 0x10A3A}, {0x10A3F, 0x10A3F}, {0x10AE5, 0x10AE6},
+    {0x10D24, 0x10D27}, {0x10EAB, 0x10EAC}, {0x10F46, 0x10F50},
+    {0x10F82, 0x10F85}, {0x11001, 0x11001}, {0x11038, 0x11046},
+    {0x11070, 0x11070}, {0x11073, 0x11074}, {0x1107F, 0x11081},
+    {0x110B3, 0x110B6}, {0x110B9, 0x110BA}, {0x110C2, 0x110C2},
+    {0x11100, 0x11102}, {0x11127, 0x1112B}, {0x1112D, 0x11134},
+    {0x11173, 0x11173}, {0x11180, 0x11181}, {0x111B6, 0x111BE},
+    {0x111C9, 0x111CC}, {0x111CF, 0x111CF}, {0x1122F, 0x11231},
+    {0x11234, 0x11234}, {0x11236, 0x11237}, {0x1123E, 0x1123E},
+    {0x112DF, 0x112DF}, {0x112E3, 0x112EA}, {0x11300, 0x11301},
+    {0x1133B, 0x1133C}, {0x11340, 0x11340}, {0x11366, 0x1136C},
+    {0x11370, 0x11374}, {0x11438, 0x1143F}, {0x11442, 0x11444},
+    {0x11446, 0x11446}, {0x1145E, 0x1145E}, {0x114B3, 0x114B8},
+    {0x114BA, 0x114BA}, {0x114BF, 0x114C0}, {0x114C2, 0x114C3},
+    {0x115B2, 0x115B5}, {0x115BC, 0x115BD}, {0x115BF, 0x115C0},
+    {0x115DC, 0x115DD}, {0x11633, 0x1163A}, {0x1163D, 0x1163D},
+    {0x1163F, 0x11640}, {0x116AB, 0x116AB}, {0x116AD, 0x116AD},
+    {0x116B0, 0x116B5}, {0x116B7, 0x116B7}, {0x1171D, 0x1171F},
+    {0x11722, 0x11725}, {0x11727, 0x1172B}, {0x1182F, 0x11837},
+    {0x11839, 0x1183A}, {0x1193B, 0x1193C}, {0x1193E, 0x1193E},
+    {0x11943, 0x11943}, {0x119D4, 0x119D7}, {0x119DA, 0x119DB},
+    {0x119E0, 0x119E0}, {0x11A01, 0x11A0A}, {0x11A33, 0x11A38},
+    {0x11A3B, 0x11A3E}, {0x11A47, 0x11A47}, {0x11A51, 0x11A56},
+    {0x11A59, 0x11A5B}, {0x11A8A, 0x11A96}, {0x11A98, 0x11A99},
+    {0x11C30, 0x11C36}, {0x11C38, 0x11C3D}, {0x11C3F, 0x11C3F},
+    {0x11C92, 0x11CA7}, {0x11CAA, 0x11CB0}, {0x11CB2, 0x11CB3},
+    {0x11CB5, 0x11CB6}, {0x11D31, 0x11D36}, {0x11D3A, 0x11D3A},
+    {0x11D3C, 0x11D3D}, {0x11D3F, 0x11D45}, {0x11D47, 0x11D47},
+    {0x11D90, 0x11D91}, {0x11D95, 0x11D95}, {0x11D97, 0x11D97},
+    {0x11EF3, 0x11EF4}, {0x16AF0, 0x16AF4}, {0x16B30, 0x16B36},
+    {0x16F4F, 0x16F4F}, {0x16F8F, 0x16F92}, {0x16FE4, 0x16FE4},
+    {0x1BC9D, 0x1BC9E}, {0x1CF00, 0x1CF2D}, {0x1CF30, 0x1CF46},
+    {0x1D167, 0x1D169}, {0x1D17B, 0x1D182}, {0x1D185, 0x1D18B},
+    {0x1D1AA, 0x1D1AD}, {0x1D242, 0x1D244}, {0x1DA00, 0x1DA36},
+    {0x1DA3B, 0x1DA6C}, {0x1DA75, 0x1DA75}, {0x1DA84, 0x1DA84},
+    {0x1DA9B, 0x1DA9F}, {0x1DAA1, 0x1DAAF}, {0x1E000, 0x1E006},
+    {0x1E008, 0x1E018}, {0x1E01B, 0x1E021}, {0x1E023, 0x1E024},
+    {0x1E026, 0x1E02A}, {0x1E130, 0x1E136}, {0x1E2AE, 0x1E2AE},
+    {0x1E2EC, 0x1E2EF}, {0x1E8D0, 0x1E8D6}, {0x1E944, 0x1E94A},
+};
+
+/** Lowercase mappings: codepoints first..last (every step-th) map to cp + delta */
+static const fastembed_unicode_case_t k_lowercase_ranges[] = {
+    {0x00C0, 0x00D6, 1, 32}, {0x00D8, 0x00DE, 1, 32}, {0x0100, 0x012E, 2, 1},
+    {0x0130, 0x0130, 1, -199}, {0x0132, 0x0136, 2, 1}, {0x0139, 0x0147, 2, 1},
+    {0x014A, 0x0176, 2, 1}, {0x0178, 0x0178, 1, -121}, {0x0179, 0x017D, 2, 1},
+    {0x0181, 0x0181, 1, 210}, {0x0182, 0x0184, 2, 1}, {0x0186, 0x0186, 1, 206},
+    {0x0187, 0x0187, 1, 1}, {0x0189, 0x018A, 1, 205}, {0x018B, 0x018B, 1, 1},
+    {0x018E, 0x018E, 1, 79}, {0x018F, 0x018F, 1, 202}, {0x0190, 0x0190, 1, 203},
+    {0x0191, 0x0191, 1, 1}, {0x0193, 0x0193, 1, 205}, {0x0194, 0x0194, 1, 207},
+    {0x0196, 0x0196, 1, 211}, {0x0197, 0x0197, 1, 209}, {0x0198, 0x0198, 1, 1},
+    {0x019C, 0x019C, 1, 211}, {0x019D, 0x019D, 1, 213},
+    {0x019F, 0x019F, 1, 214}, {0x01A0, 0x01A4, 2, 1}, {0x01A6, 0x01A6, 1, 218},
+    {0x01A7, 0x01A7, 1, 1}, {0x01A9, 0x01A9, 1, 218}, {0x01AC, 0x01AC, 1, 1},
+    {0x01AE, 0x01AE, 1, 218}, {0x01AF, 0x01AF, 1, 1}, {0x01B1, 0x01B2, 1, 217},
+    {0x01B3, 0x01B5, 2, 1}, {0x01B7, 0x01B7, 1, 219}, {0x01B8, 0x01B8, 1, 1},
+    {0x01BC, 0x01BC, 1, 1}, {0x01C4, 0x01C4, 1, 2}, {0x01C5, 0x01C5, 1, 1},
+    {0x01C7, 0x01C7, 1, 2}, {0x01C8, 0x01C8, 1, 1}, {0x01CA, 0x01CA, 1, 2},
+    {0x01CB, 0x01DB, 2, 1}, {0x01DE, 0x01EE, 2, 1}, {0x01F1, 0x01F1, 1, 2},
+    {0x01F2, 0x01F4, 2, 1}, {0x01F6, 0x01F6, 1, -97}, {0x01F7, 0x01F7, 1, -56},
+    {0x01F8, 0x021E, 2, 1}, {0x0220, 0x0220, 1, -130}, {0x0222, 0x0232, 2, 1},
+    {0x023A, 0x023A, 1, 10795}, {0x023B, 0x023B, 1, 1},
+    {0x023D, 0x023D, 1, -163}, {0x023E, 0x023E, 1, 10792},
+    {0x0241, 0x0241, 1, 1}, {0x0243, 0x0243, 1, -195}, {0x0244, 0x0244, 1, 69},
+    {0x0245, 0x0245, 1, 71}, {0x0246, 0x024E, 2, 1}, {0x0370, 0x0372, 2, 1},
+    {0x0376, 0x0376, 1, 1}, {0x037F, 0x037F, 1, 116}, {0x0386, 0x0386, 1, 38},
+    {0x0388, 0x038A, 1, 37}, {0x038C, 0x038C, 1, 64}, {0x038E, 0x038F, 1, 63},
+    {0x0391, 0x03A1, 1, 32}, {0x03A3, 0x03AB, 1, 32}, {0x03CF, 0x03CF, 1, 8},
+    {0x03D8, 0x03EE, 2, 1}, {0x03F4, 0x03F4, 1, -60}, {0x03F7, 0x03F7, 1, 1},
+    {0x03F9, 0x03F9, 1, -7}, {0x03FA, 0x03FA, 1, 1}, {0x03FD, 0x03FF, 1, -130},
+    {0x0400, 0x040F, 1, 80}, {0x0410, 0x042F, 1, 32}, {0x0460, 0x0480, 2, 1},
+    {0x048A, 0x04BE, 2, 1}, {0x04C0, 0x04C0, 1, 15}, {0x04C1, 0x04CD, 2, 1},
+    {0x04D0, 0x052E, 2, 1}, {0x0531, 0x0556, 1, 48}, {0x10A0, 0x10C5, 1, 7264},
+    {0x10C7, 0x10C7, 1, 7264}, {0x10CD, 0x10CD, 1, 7264},
+    {0x13A0, 0x13EF, 1, 38864}, {0x13F0, 0x13F5, 1, 8},
+    {0x1C90, 0x1CBA, 1, -3008}, {0x1CBD, 0x1CBF, 1, -3008},
+    {0x1E00, 0x1E94, 2, 1}, {0x1E9E, 0x1E9E, 1, -7615}, {0x1EA0, 0x1EFE, 2, 1},
+    {0x1F08, 0x1F0F, 1, -8}, {0x1F18, 0x1F1D, 1, -8}, {0x1F28, 0x1F2F, 1, -8},
+    {0x1F38, 0x1F3F, 1, -8}, {0x1F48, 0x1F4D, 1, -8}, {0x1F59, 0x1F5F, 2, -8},
+    {0x1F68, 0x1F6F, 1, -8}, {0x1F88, 0x1F8F, 1, -8}, {0x1F98, 0x1F9F, 1, -8},
+    {0x1FA8, 0x1FAF, 1, -8}, {0x1FB8, 0x1FB9, 1, -8}, {0x1FBA, 0x1FBB, 1, -74},
+    {0x1FBC, 0x1FBC, 1, -9}, {0x1FC8, 0x1FCB, 1, -86}, {0x1FCC, 0x1FCC, 1, -9},
+    {0x1FD8, 0x1FD9, 1, -8}, {0x1FDA, 0x1FDB, 1, -100}, {0x1FE8, 0x1FE9, 1, -8},
+    {0x1FEA, 0x1FEB, 1, -112}, {0x1FEC, 0x1FEC, 1, -7},
+    {0x1FF8, 0x1FF9, 1, -128}, {0x1FFA, 0x1FFB, 1, -126},
+    {0x1FFC, 0x1FFC, 1, -9}, {0x2126, 0x2126, 1, -7517},
+    {0x212A, 0x212A, 1, -8383}, {0x212B, 0x212B, 1, -8262},
+    {0x2132, 0x2132, 1, 28}, {0x2160, 0x216F, 1, 16}, {0x2183, 0x2183, 1, 1},
+    {0x24B6, 0x24CF, 1, 26}, {0x2C00, 0x2C2F, 1, 48}, {0x2C60, 0x2C60, 1, 1},
+    {0x2C62, 0x2C62, 1, -10743}, {0x2C63, 0x2C63, 1, -3814},
+    {0x2C64, 0x2C64, 1, -10727}, {0x2C67, 0x2C6B, 2, 1},
+    {0x2C6D, 0x2C6D, 1, -10780}, {0x2C6E, 0x2C6E, 1, -10749},
+    {0x2C6F, 0x2C6F, 1, -10783}, {0x2C70, 0x2C70, 1, -10782},
+    {0x2C72, 0x2C72, 1, 1}, {0x2C75, 0x2C75, 1, 1}, {0x2C7E, 0x2C7F, 1, -10815},
+    {0x2C80, 0x2CE2, 2, 1}, {0x2CEB, 0x2CED, 2, 1}, {0x2CF2, 0x2CF2, 1, 1},
+    {0xA640, 0xA66C, 2, 1}, {0xA680, 0xA69A, 2, 1}, {0xA722, 0xA72E, 2, 1},
+    {0xA732, 0xA76E, 2, 1}, {0xA779, 0xA77B, 2, 1}, {0xA77D, 0xA77D, 1, -35332},
+    {0xA77E, 0xA786, 2, 1}, {0xA78B, 0xA78B, 1, 1}, {0xA78D, 0xA78D, 1, -42280},
+    {0xA790, 0xA792, 2, 1}, {0xA796, 0xA7A8, 2, 1}, {0xA7AA, 0xA7AA, 1, -42308},
+    {0xA7AB, 0xA7AB, 1, -42319}, {0xA7AC, 0xA7AC, 1, -42315},
+    {0xA7AD, 0xA7AD, 1, -42305}, {0xA7AE, 0xA7AE, 1, -42308},
+    {0xA7B0, 0xA7B0, 1, -42258}, {0xA7B1, 0xA7B1, 1, -42282},
+    {0xA7B2, 0xA7B2, 1, -42261}, {0xA7B3, 0xA7B3, 1, 928},
+    {0xA7B4, 0xA7C2, 2, 1}, {0xA7C4, 0xA7C4, 1, -48},
+    {0xA7C5, 0xA7C5, 1, -42307}, {0xA7C6, 0xA7C6, 1, -35384},
+    {0xA7C7, 0xA7C9, 2, 1}, {0xA7D0, 0xA7D0, 1, 1}, {0xA7D6, 0xA7D8, 2, 1},
+    {0xA7F5, 0xA7F5, 1, 1}, {0xFF21, 0xFF3A, 1, 32}, {0x10400, 0x10427, 1, 40},
+    {0x104B0, 0x104D3, 1, 40}, {0x10570, 0x1057A, 1, 39},
+    {0x1057C, 0x1058A, 1, 39}, {0x1058C, 0x10592, 1, 39},
+    {0x10594, 0x10595, 1, 39}, {0x10C80, 0x10CB2, 1, 64},
+    {0x118A0, 0x118BF, 1, 32}, {0x16E40, 0x16E5F, 1, 32},
+    {0x1E900, 0x1E921, 1, 34},
+};
+
+/** Accent stripping: precomposed codepoint -> base codepoint of its NFD form */
+static const fastembed_unicode_map_t k_accent_base[] = {
+    {0x00C0, 0x0041}, {0x00C1, 0x0041}, {0x00C2, 0x0041}, {0x00C3, 0x0041},
+    {0x00C4, 0x0041}, {0x00C5, 0x0041}, {0x00C7, 0x0043}, {0x00C8, 0x0045},
+    {0x00C9, 0x0045}, {0x00CA, 0x0045}, {0x00CB, 0x0045}, {0x00CC, 0x0049},
+    {0x00CD, 0x0049}, {0x00CE, 0x0049}, {0x00CF, 0x0049}, {0x00D1, 0x004E},
+    {0x00D2, 0x004F}, {0x00D3, 0x004F}, {0x00D4, 0x004F}, {0x00D5, 0x004F},
+    {0x00D6, 0x004F}, {0x00D9, 0x0055}, {0x00DA, 0x0055}, {0x00DB, 0x0055},
+    {0x00DC, 0x0055}, {0x00DD, 0x0059}, {0x00E0, 0x0061}, {0x00E1, 0x0061},
+    {0x00E2, 0x0061}, {0x00E3, 0x0061}, {0x00E4, 0x0061}, {0x00E5, 0x0061},
+    {0x00E7, 0x0063}, {0x00E8, 0x0065}, {0x00E9, 0x0065}, {0x00EA, 0x0065},
+    {0x00EB, 0x0065}, {0x00EC, 0x0069}, {0x00ED, 0x0069}, {0x00EE, 0x0069},
+    {0x00EF, 0x0069}, {0x00F1, 0x006E}, {0x00F2, 0x006F}, {0x00F3, 0x006F},
+    {0x00F4, 0x006F}, {0x00F5, 0x006F}, {0x00F6, 0x006F}, {0x00F9, 0x0075},
+    {0x00FA, 0x0075}, {0x00FB, 0x0075}, {0x00FC, 0x0075}, {0x00FD, 0x0079},
+    {0x00FF, 0x0079}, {0x0100, 0x0041}, {0x0101, 0x0061}, {0x0102, 0x0041},
+    {0x0103, 0x0061}, {0x0104, 0x0041}, {0x0105, 0x0061}, {0x0106, 0x0043},
+    {0x0107, 0x0063}, {0x0108, 0x0043}, {0x0109, 0x0063}, {0x010A, 0x0043},
+    {0x010B, 0x0063}, {0x010C, 0x0043}, {0x010D, 0x0063}, {0x010E, 0x0044},
+    {0x010F, 0x0064}, {0x0112, 0x0045}, {0x0113, 0x0065}, {0x0114, 0x0045},
+    {0x0115, 0x0065}, {0x0116, 0x0045}, {0x0117, 0x0065}, {0x0118, 0x0045},
+    {0x0119, 0x0065}, {0x011A, 0x0045}, {0x011B, 0x0065}, {0x011C, 0x0047},
+    {0x011D, 0x0067}, {0x011E, 0x0047}, {0x011F, 0x0067}, {0x0120, 0x0047},
+    {0x0121, 0x0067}, {0x0122, 0x0047}, {0x0123, 0x0067}, {0x0124, 0x0048},
+    {0x0125, 0x0068}, {0x0128, 0x0049}, {0x0129, 0x0069}, {0x012A, 0x0049},
+    {0x012B, 0x0069}, {0x012C, 0x0049}, {0x012D, 0x0069}, {0x012E, 0x0049},
+    {0x012F, 0x0069}, {0x0130, 0x0049}, {0x0134, 0x004A}, {0x0135, 0x006A},
+    {0x0136, 0x004B}, {0x0137, 0x006B}, {0x0139, 0x004C}, {0x013A, 0x006C},
+    {0x013B, 0x004C}, {0x013C, 0x006C}, {0x013D, 0x004C}, {0x013E, 0x006C},
+    {0x0143, 0x004E}, {0x0144, 0x006E}, {0x0145, 0x004E}, {0x0146, 0x006E},
+    {0x0147, 0x004E}, {0x0148, 0x006E}, {0x014C, 0x004F}, {0x014D, 0x006F},
+    {0x014E, 0x004F}, {0x014F, 0x006F}, {0x0150, 0x004F}, {0x0151, 0x006F},
+    {0x0154, 0x0052}, {0x0155, 0x0072}, {0x0156, 0x0052}, {0x0157, 0x0072},
+    {0x0158, 0x0052}, {0x0159, 0x0072}, {0x015A, 0x0053}, {0x015B, 0x0073},
+    {0x015C, 0x0053}, {0x015D, 0x0073}, {0x015E, 0x0053}, {0x015F, 0x0073},
+    {0x0160, 0x0053}, {0x0161, 0x0073}, {0x0162, 0x0054}, {0x0163, 0x0074},
+    {0x0164, 0x0054}, {0x0165, 0x0074}, {0x0168, 0x0055}, {0x0169, 0x0075},
+    {0x016A, 0x0055}, {0x016B, 0x0075}, {0x016C, 0x0055}, {0x016D, 0x0075},
+    {0x016E, 0x0055}, {0x016F, 0x0075}, {0x0170, 0x0055}, {0x0171, 0x0075},
+    {0x0172, 0x0055}, {0x0173, 0x0075}, {0x0174, 0x0057}, {0x0175, 0x0077},
+    {0x0176, 0x0059}, {0x0177, 0x0079}, {0x0178, 0x0059}, {0x0179, 0x005A},
+    {0x017A, 0x007A}, {0x017B, 0x005A}, {0x017C, 0x007A}, {0x017D, 0x005A},
+    {0x017E, 0x007A}, {0x01A0, 0x004F}, {0x01A1, 0x006F}, {0x01AF, 0x0055},
+    {0x01B0, 0x0075}, {0x01CD, 0x0041}, {0x01CE, 0x0061}, {0x01CF, 0x0049},
+    {0x01D0, 0x0069}, {0x01D1, 0x004F}, {0x01D2, 0x006F}, {0x01D3, 0x0055},
+    {0x01D4, 0x0075}, {0x01D5, 0x0055}, {0x01D6, 0x0075}, {0x01D7, 0x0055},
+    {0x01D8, 0x0075}, {0x01D9, 0x0055}, {0x01DA, 0x0075}, {0x01DB, 0x0055},
+    {0x01DC, 0x0075}, {0x01DE, 0x0041}, {0x01DF, 0x0061}, {0x01E0, 0x0041},
+    {0x01E1, 0x0061}, {0x01E2, 0x00C6}, {0x01E3, 0x00E6}, {0x01E6, 0x0047},
+    {0x01E7, 0x0067}, {0x01E8, 0x004B}, {0x01E9, 0x006B}, {0x01EA, 0x004F},
+    {0x01EB, 0x006F}, {0x01EC, 0x004F}, {0x01ED, 0x006F}, {0x01EE, 0x01B7},
+    {0x01EF, 0x0292}, {0x01F0, 0x006A}, {0x01F4, 0x0047}, {0x01F5, 0x0067},
+    {0x01F8, 0x004E}, {0x01F9, 0x006E}, {0x01FA, 0x0041}, {0x01FB, 0x0061},
+    {0x01FC, 0x00C6}, {0x01FD, 0x00E6}, {0x01FE, 0x00D8}, {0x01FF, 0x00F8},
+    {0x0200, 0x0041}, {0x0201, 0x0061}, {0x0202, 0x0041}, {0x0203, 0x0061},
+    {0x0204, 0x0045}, {0x0205, 0x0065}, {0x0206, 0x0045}, {0x0207, 0x0065},
+    {0x0208, 0x0049}, {0x0209, 0x0069}, {0x020A, 0x0049}, {0x020B, 0x0069},
+    {0x020C, 0x004F}, {0x020D, 0x006F}, {0x020E, 0x004F}, {0x020F, 0x006F},
+    {0x0210, 0x0052}, {0x0211, 0x0072}, {0x0212, 0x0052}, {0x0213, 0x0072},
+    {0x0214, 0x0055}, {0x0215, 0x0075}, {0x0216, 0x0055}, {0x0217, 0x0075},
+    {0x0218, 0x0053}, {0x0219, 0x0073}, {0x021A, 0x0054}, {0x021B, 0x0074},
+    {0x021E, 0x0048}, {0x021F, 0x0068}, {0x0226, 0x0041}, {0x0227, 0x0061},
+    {0x0228, 0x0045}, {0x0229, 0x0065}, {0x022A, 0x004F}, {0x022B, 0x006F},
+    {0x022C, 0x004F}, {0x022D, 0x006F}, {0x022E, 0x004F}, {0x022F, 0x006F},
+    {0x0230, 0x004F}, {0x0231, 0x006F}, {0x0232, 0x0059}, {0x0233, 0x0079},
+    {0x0385, 0x00A8}, {0x0386, 0x0391}, {0x0388, 0x0395}, {0x0389, 0x0397},
+    {0x038A, 0x0399}, {0x038C, 0x039F}, {0x038E, 0x03A5}, {0x038F, 0x03A9},
+    {0x0390, 0x03B9}, {0x03AA, 0x0399}, {0x03AB, 0x03A5}, {0x03AC, 0x03B1},
+    {0x03AD, 0x03B5}, {0x03AE, 0x03B7}, {0x03AF, 0x03B9}, {0x03B0, 0x03C5},
+    {0x03CA, 0x03B9}, {0x03CB, 0x03C5}, {0x03CC, 0x03BF}, {0x03CD, 0x03C5},
+    {0x03CE, 0x03C9}, {0x03D3, 0x03D2}, {0x03D4, 0x03D2}, {0x0400, 0x0415},
+    {0x0401, 0x0415}, {0x0403, 0x0413}, {0x0407, 0x0406}, {0x040C, 0x041A},
+    {0x040D, 0x0418}, {0x040E, 0x0423}, {0x0419, 0x0418}, {0x0439, 0x0438},
+    {0x0450, 0x0435}, {0x0451, 0x0435}, {0x0453, 0x0433}, {0x0457, 0x0456},
+    {0x045C, 0x043A}, {0x045D, 0x0438}, {0x045E, 0x0443}, {0x0476, 0x0474},
+    {0x0477, 0x0475}, {0x04C1, 0x0416}, {0x04C2, 0x0436}, {0x04D0, 0x0410},
+    {0x04D1, 0x0430}, {0x04D2, 0x0410}, {0x04D3, 0x0430}, {0x04D6, 0x0415},
+    {0x04D7, 0x0435}, {0x04DA, 0x04D8}, {0x04DB, 0x04D9}, {0x04DC, 0x0416},
+    {0x04DD, 0x0436}, {0x04DE, 0x0417}, {0x04DF, 0x0437}, {0x04E2, 0x0418},
+    {0x04E3, 0x0438}, {0x04E4, 0x0418}, {0x04E5, 0x0438}, {0x04E6, 0x041E},
+    {0x04E7, 0x043E}, {0x04EA, 0x04E8}, {0x04EB, 0x04E9}, {0x04EC, 0x042D},
+    {0x04ED, 0x044D}, {0x04EE, 0x0423}, {0x04EF, 0x0443}, {0x04F0, 0x0423},
+    {0x04F1, 0x0443}, {0x04F2, 0x0423}, {0x04F3, 0x0443}, {0x04F4, 0x0427},
+    {0x04F5, 0x0447}, {0x04F8, 0x042B}, {0x04F9, 0x044B}, {0x0622, 0x0627},
+    {0x0623, 0x0627}, {0x0624, 0x0648}, {0x0625, 0x0627}, {0x0626, 0x064A},
+    {0x06C0, 0x06D5}, {0x06C2, 0x06C1}, {0x06D3, 0x06D2}, {0x0929, 0x0928},
+    {0x0931, 0x0930}, {0x0934, 0x0933}, {0x0958, 0x0915}, {0x0959, 0x0916},
+    {0x095A, 0x0917}, {0x095B, 0x091C}, {0x095C, 0x0921}, {0x095D, 0x0922},
+    {0x095E, 0x092B}, {0x095F, 0x092F}, {0x09DC, 0x09A1}, {0x09DD, 0x09A2},
+    {0x09DF, 0x09AF}, {0x0A33, 0x0A32}, {0x0A36, 0x0A38}, {0x0A59, 0x0A16},
+    {0x0A5A, 0x0A17}, {0x0A5B, 0x0A1C}, {0x0A5E, 0x0A2B}, {0x0B48, 0x0B47},
+    {0x0B5C, 0x0B21}, {0x0B5D, 0x0B22}, {0x0CC0, 0x0CD5}, {0x0CC7, 0x0CD5},
+    {0x0CC8, 0x0CD6}, {0x0CCA, 0x0CC2}, {0x0DDA, 0x0DD9}, {0x0F43, 0x0F42},
+    {0x0F4D, 0x0F4C}, {0x0F52, 0x0F51}, {0x0F57, 0x0F56}, {0x0F5C, 0x0F5B},
+    {0x0F69, 0x0F40}, {0x1026, 0x1025}, {0x1B3B, 0x1B35}, {0x1B3D, 0x1B35},
+    {0x1B43, 0x1B35}, {0x1E00, 0x0041}, {0x1E01, 0x0061}, {0x1E02, 0x0042},
+    {0x1E03, 0x0062}, {0x1E04, 0x0042}, {0x1E05, 0x0062}, {0x1E06, 0x0042},
+    {0x1E07, 0x0062}, {0x1E08, 0x0043}, {0x1E09, 0x0063}, {0x1E0A, 0x0044},
+    {0x1E0B, 0x0064}, {0x1E0C, 0x0044}, {0x1E0D, 0x0064}, {0x1E0E, 0x0044},
+    {0x1E0F, 0x0064}, {0x1E10, 0x0044}, {0x1E11, 0x0064}, {0x1E12, 0x0044},
+    {0x1E13, 0x0064}, {0x1E14, 0x0045}, {0x1E15, 0x0065}, {0x1E16, 0x0045},
+    {0x1E17, 0x0065}, {0x1E18, 0x0045}, {0x1E19, 0x0065}, {0x1E1A, 0x0045},
+    {0x1E1B, 0x0065}, {0x1E1C, 0x0045}, {0x1E1D, 0x0065}, {0x1E1E, 0x0046},
+    {0x1E1F, 0x0066}, {0x1E20, 0x0047}, {0x1E21, 0x0067}, {0x1E22, 0x0048},
+    {0x1E23, 0x0068}, {0x1E24, 0x0048}, {0x1E25, 0x0068}, {0x1E26, 0x0048},
+    {0x1E27, 0x0068}, {0x1E28, 0x0048}, {0x1E29, 0x0068}, {0x1E2A, 0x0048},
+    {0x1E2B, 0x0068}, {0x1E2C, 0x0049}, {0x1E2D, 0x0069}, {0x1E2E, 0x0049},
+    {0x1E2F, 0x0069}, {0x1E30, 0x004B}, {0x1E31, 0x006B}, {0x1E32, 0x004B},
+    {0x1E33, 0x006B}, {0x1E34, 0x004B}, {0x1E35, 0x006B}, {0x1E36, 0x004C},
+    {0x1E37, 0x006C}, {0x1E38, 0x004C}, {0x1E39, 0x006C}, {0x1E3A, 0x004C},
+    {0x1E3B, 0x006C}, {0x1E3C, 0x004C}, {0x1E3D, 0x006C}, {0x1E3E, 0x004D},
+    {0x1E3F, 0x006D}, {0x1E40, 0x004D}, {0x1E41, 0x006D}, {0x1E42, 0x004D},
+    {0x1E43, 0x006D}, {0x1E44, 0x004E}, {0x1E45, 0x006E}, {0x1E46, 0x004E},
+    {0x1E47, 0x006E}, {0x1E48, 0x004E}, {0x1E49, 0x006E}, {0x1E4A, 0x004E},
+    {0x1E4B, 0x006E}, {0x1E4C, 0x004F}, {0x1E4D, 0x006F}, {0x1E4E, 0x004F},
+    {0x1E4F, 0x006F}, {0x1E50, 0x004F}, {0x1E51, 0x006F}, {0x1E52, 0x004F},
+    {0x1E53, 0x006F}, {0x1E54, 0x0050}, {0x1E55, 0x0070}, {0x1E56, 0x0050},
+    {0x1E57, 0x0070}, {0x1E58, 0x0052}, {0x1E59, 0x0072}, {0x1E5A, 0x0052},
+    {0x1E5B, 0x0072}, {0x1E5C, 0x0052}, {0x1E5D, 0x0072}, {0x1E5E, 0x0052},
+    {0x1E5F, 0x0072}, {0x1E60, 0x0053}, {0x1E61, 0x0073}, {0x1E62, 0x0053},
+    {0x1E63, 0x0073}, {0x1E64, 0x0053}, {0x1E65, 0x0073}, {0x1E66, 0x0053},
+    {0x1E67, 0x0073}, {0x1E68, 0x0053}, {0x1E69, 0x0073}, {0x1E6A, 0x0054},
+    {0x1E6B, 0x0074}, {0x1E6C, 0x0054}, {0x1E6D, 0x0074}, {0x1E6E, 0x0054},
+    {0x1E6F, 0x0074}, {0x1E70, 0x0054}, {0x1E71, 0x0074}, {0x1E72, 0x0055},
+    {0x1E73, 0x0075}, {0x1E74, 0x0055}, {0x1E75, 0x0075}, {0x1E76, 0x0055},
+    {0x1E77, 0x0075}, {0x1E78, 0x0055}, {0x1E79, 0x0075}, {0x1E7A, 0x0055},
+    {0x1E7B, 0x0075}, {0x1E7C, 0x0056}, {0x1E7D, 0x0076}, {0x1E7E, 0x0056},
+    {0x1E7F, 0x0076}, {0x1E80, 0x0057}, {0x1E81, 0x0077}, {0x1E82, 0x0057},
+    {0x1E83, 0x0077}, {0x1E84, 0x0057}, {0x1E85, 0x0077}, {0x1E86, 0x0057},
+    {0x1E87, 0x0077}, {0x1E88, 0x0057}, {0x1E89, 0x0077}, {0x1E8A, 0x0058},
+    {0x1E8B, 0x0078}, {0x1E8C, 0x0058}, {0x1E8D, 0x0078}, {0x1E8E, 0x0059},
+    {0x1E8F, 0x0079}, {0x1E90, 0x005A}, {0x1E91, 0x007A}, {0x1E92, 0x005A},
+    {0x1E93, 0x007A}, {0x1E94, 0x005A}, {0x1E95, 0x007A}, {0x1E96, 0x0068},
+    {0x1E97, 0x0074}, {0x1E98, 0x0077}, {0x1E99, 0x0079}, {0x1E9B, 0x017F},
+    {0x1EA0, 0x0041}, {0x1EA1, 0x0061}, {0x1EA2, 0x0041}, {0x1EA3, 0x0061},
+    {0x1EA4, 0x0041}, {0x1EA5, 0x0061}, {0x1EA6, 0x0041}, {0x1EA7, 0x0061},
+    {0x1EA8, 0x0041}, {0x1EA9, 0x0061}, {0x1EAA, 0x0041}, {0x1EAB, 0x0061},
+    {0x1EAC, 0x0041}, {0x1EAD, 0x0061}, {0x1EAE, 0x0041}, {0x1EAF, 0x0061},
+    {0x1EB0, 0x0041}, {0x1EB1, 0x0061}, {0x1EB2, 0x0041}, {0x1EB3, 0x0061},
+    {0x1EB4, 0x0041}, {0x1EB5, 0x0061}, {0x1EB6, 0x0041}, {0x1EB7, 0x0061},
+    {0x1EB8, 0x0045}, {0x1EB9, 0x0065}, {0x1EBA, 0x0045}, {0x1EBB, 0x0065},
+    {0x1EBC, 0x0045}, {0x1EBD, 0x0065}, {0x1EBE, 0x0045}, {0x1EBF, 0x0065},
+    {0x1EC0, 0x0045}, {0x1EC1, 0x0065}, {0x1EC2, 0x0045}, {0x1EC3, 0x0065},
+    {0x1EC4, 0x0045}, {0x1EC5, 0x0065}, {0x1EC6, 0x0045}, {0x1EC7, 0x0065},
+    {0x1EC8, 0x0049}, {0x1EC9, 0x0069}, {0x1ECA, 0x0049}, {0x1ECB, 0x0069},
+    {0x1ECC, 0x004F}, {0x1ECD, 0x006F}, {0x1ECE, 0x004F}, {0x1ECF, 0x006F},
+    {0x1ED0, 0x004F}, {0x1ED1, 0x006F}, {0x1ED2, 0x004F}, {0x1ED3, 0x006F},
+    {0x1ED4, 0x004F}, {0x1ED5, 0x006F}, {0x1ED6, 0x004F}, {0x1ED7, 0x006F},
+    {0x1ED8, 0x004F}, {0x1ED9, 0x006F}, {0x1EDA, 0x004F}, {0x1EDB, 0x006F},
+    {0x1EDC, 0x004F}, {0x1EDD, 0x006F}, {0x1EDE, 0x004F}, {0x1EDF, 0x006F},
+    {0x1EE0, 0x004F}, {0x1EE1, 0x006F}, {0x1EE2, 0x004F}, {0x1EE3, 0x006F},
+    {0x1EE4, 0x0055}, {0x1EE5, 0x0075}, {0x1EE6, 0x0055}, {0x1EE7, 0x0075},
+    {0x1EE8, 0x0055}, {0x1EE9, 0x0075}, {0x1EEA, 0x0055}, {0x1EEB, 0x0075},
+    {0x1EEC, 0x0055}, {0x1EED, 0x0075}, {0x1EEE, 0x0055}, {0x1EEF, 0x0075},
+    {0x1EF0, 0x0055}, {0x1EF1, 0x0075}, {0x1EF2, 0x0059}, {0x1EF3, 0x0079},
+    {0x1EF4, 0x0059}, {0x1EF5, 0x0079}, {0x1EF6, 0x0059}, {0x1EF7, 0x0079},
+    {0x1EF8, 0x0059}, {0x1EF9, 0x0079}, {0x1F00, 0x03B1}, {0x1F01, 0x03B1},
+    {0x1F02, 0x03B1}, {0x1F03, 0x03B1}, {0x1F04, 0x03B1}, {0x1F05, 0x03B1},
+    {0x1F06, 0x03B1}, {0x1F07, 0x03B1}, {0x1F08, 0x0391}, {0x1F09, 0x0391},
+    {0x1F0A, 0x0391}, {0x1F0B, 0x0391}, {0x1F0C, 0x0391}, {0x1F0D, 0x0391},
+    {0x1F0E, 0x0391}, {0x1F0F, 0x0391}, {0x1F10, 0x03B5}, {0x1F11, 0x03B5},
+    {0x1F12, 0x03B5}, {0x1F13, 0x03B5}, {0x1F14, 0x03B5}, {0x1F15, 0x03B5},
+    {0x1F18, 0x0395}, {0x1F19, 0x0395}, {0x1F1A, 0x0395}, {0x1F1B, 0x0395},
+    {0x1F1C, 0x0395}, {0x1F1D, 0x0395}, {0x1F20, 0x03B7}, {0x1F21, 0x03B7},
+    {0x1F22, 0x03B7}, {0x1F23, 0x03B7}, {0x1F24, 0x03B7}, {0x1F25, 0x03B7},
+    {0x1F26, 0x03B7}, {0x1F27, 0x03B7}, {0x1F28, 0x0397}, {0x1F29, 0x0397},
+    {0x1F2A, 0x0397}, {0x1F2B, 0x0397}, {0x1F2C, 0x0397}, {0x1F2D, 0x0397},
+    {0x1F2E, 0x0397}, {0x1F2F, 0x0397}, {0x1F30, 0x03B9}, {0x1F31, 0x03B9},
+    {0x1F32, 0x03B9}, {0x1F33, 0x03B9}, {0x1F34, 0x03B9}, {0x1F35, 0x03B9},
+    {0x1F36, 0x03B9}, {0x1F37, 0x03B9}, {0x1F38, 0x0399}, {0x1F39, 0x0399},
+    {0x1F3A, 0x0399}, {0x1F3B, 0x0399}, {0x1F3C, 0x0399}, {0x1F3D, 0x0399},
+    {0x1F3E, 0x0399}, {0x1F3F, 0x0399}, {0x1F40, 0x03BF}, {0x1F41, 0x03BF},
+    {0x1F42, 0x03BF}, {0x1F43, 0x03BF}, {0x1F44, 0x03BF}, {0x1F45, 0x03BF},
+    {0x1F48, 0x039F}, {0x1F49, 0x039F}, {0x1F4A, 0x039F}, {0x1F4B, 0x039F},
+    {0x1F4C, 0x039F}, {0x1F4D, 0x039F}, {0x1F50, 0x03C5}, {0x1F51, 0x03C5},
+    {0x1F52, 0x03C5}, {0x1F53, 0x03C5}, {0x1F54, 0x03C5}, {0x1F55, 0x03C5},
+    {0x1F56, 0x03C5}, {0x1F57, 0x03C5}, {0x1F59, 0x03A5}, {0x1F5B, 0x03A5},
+    {0x1F5D, 0x03A5}, {0x1F5F, 0x03A5}, {0x1F60, 0x03C9}, {0x1F61, 0x03C9},
+    {0x1F62, 0x03C9}, {0x1F63, 0x03C9}, {0x1F64, 0x03C9}, {0x1F65, 0x03C9},
+    {0x1F66, 0x03C9}, {0x1F67, 0x03C9}, {0x1F68, 0x03A9}, {0x1F69, 0x03A9},
+    {0x1F6A, 0x03A9}, {0x1F6B, 0x03A9}, {0x1F6C, 0x03A9}, {0x1F6D, 0x03A9},
+    {0x1F6E, 0x03A9}, {0x1F6F, 0x03A9}, {0x1F70, 0x03B1}, {0x1F71, 0x03B1},
+    {0x1F72, 0x03B5}, {0x1F73, 0x03B5}, {0x1F74, 0x03B7}, {0x1F75, 0x03B7},
+    {0x1F76, 0x03B9}, {0x1F77, 0x03B9}, {0x1F78, 0x03BF}, {0x1F79, 0x03BF},
+    {0x1F7A, 0x03C5}, {0x1F7B, 0x03C5}, {0x1F7C, 0x03C9}, {0x1F7D, 0x03C9},
+    {0x1F80, 0x03B1}, {0x1F81, 0x03B1}, {0x1F82, 0x03B1}, {0x1F83, 0x03B1},
+    {0x1F84, 0x03B1}, {0x1F85, 0x03B1}, {0x1F86, 0x03B1}, {0x1F87, 0x03B1},
+    {0x1F88, 0x0391}, {0x1F89, 0x0391}, {0x1F8A, 0x0391}, {0x1F8B, 0x0391},
+    {0x1F8C, 0x0391}, {0x1F8D, 0x0391}, {0x1F8E, 0x0391}, {0x1F8F, 0x0391},
+    {0x1F90, 0x03B7}, {0x1F91, 0x03B7}, {0x1F92, 0x03B7}, {0x1F93, 0x03B7},
+    {0x1F94, 0x03B7}, {0x1F95, 0x03B7}, {0x1F96, 0x03B7}, {0x1F97, 0x03B7},
+    {0x1F98, 0x0397}, {0x1F99, 0x0397}, {0x1F9A, 0x0397}, {0x1F9B, 0x0397},
+    {0x1F9C, 0x0397}, {0x1F9D, 0x0397}, {0x1F9E, 0x0397}, {0x1F9F, 0x0397},
+    {0x1FA0, 0x03C9}, {0x1FA1, 0x03C9}, {0x1FA2, 0x03C9}, {0x1FA3, 0x03C9},
+    {0x1FA4, 0x03C9}, {0x1FA5, 0x03C9}, {0x1FA6, 0x03C9}, {0x1FA7, 0x03C9},
+    {0x1FA8, 0x03A9}, {0x1FA9, 0x03A9}, {0x1FAA, 0x03A9}, {0x1FAB, 0x03A9},
+    {0x1FAC, 0x03A9}, {0x1FAD, 0x03A9}, {0x1FAE, 0x03A9}, {0x1FAF, 0x03A9},
+    {0x1FB0, 0x03B1}, {0x1FB1, 0x03B1}, {0x1FB2, 0x03B1}, {0x1FB3, 0x03B1},
+    {0x1FB4, 0x03B1}, {0x1FB6, 0x03B1}, {0x1FB7, 0x03B1}, {0x1FB8, 0x0391},
+    {0x1FB9, 0x0391}, {0x1FBA, 0x0391}, {0x1FBB, 0x0391}, {0x1FBC, 0x0391},
+    {0x1FC1, 0x00A8}, {0x1FC2, 0x03B7}, {0x1FC3, 0x03B7}, {0x1FC4, 0x03B7},
+    {0x1FC6, 0x03B7}, {0x1FC7, 0x03B7}, {0x1FC8, 0x0395}, {0x1FC9, 0x0395},
+    {0x1FCA, 0x0397}, {0x1FCB, 0x0397}, {0x1FCC, 0x0397}, {0x1FCD, 0x1FBF},
+    {0x1FCE, 0x1FBF}, {0x1FCF, 0x1FBF}, {0x1FD0, 0x03B9}, {0x1FD1, 0x03B9},
+    {0x1FD2, 0x03B9}, {0x1FD3, 0x03B9}, {0x1FD6, 0x03B9}, {0x1FD7, 0x03B9},
+    {0x1FD8, 0x0399}, {0x1FD9, 0x0399}, {0x1FDA, 0x0399}, {0x1FDB, 0x0399},
+    {0x1FDD, 0x1FFE}, {0x1FDE, 0x1FFE}, {0x1FDF, 0x1FFE}, {0x1FE0, 0x03C5},
+    {0x1FE1, 0x03C5}, {0x1FE2, 0x03C5}, {0x1FE3, 0x03C5}, {0x1FE4, 0x03C1},
+    {0x1FE5, 0x03C1}, {0x1FE6, 0x03C5}, {0x1FE7, 0x03C5}, {0x1FE8, 0x03A5},
+    {0x1FE9, 0x03A5}, {0x1FEA, 0x03A5}, {0x1FEB, 0x03A5}, {0x1FEC, 0x03A1},
+    {0x1FED, 0x00A8}, {0x1FEE, 0x00A8}, {0x1FF2, 0x03C9}, {0x1FF3, 0x03C9},
+    {0x1FF4, 0x03C9}, {0x1FF6, 0x03C9}, {0x1FF7, 0x03C9}, {0x1FF8, 0x039F},
+    {0x1FF9, 0x039F}, {0x1FFA, 0x03A9}, {0x1FFB, 0x03A9}, {0x1FFC, 0x03A9},
+    {0x212B, 0x0041}, {0x219A, 0x2190}, {0x219B, 0x2192}, {0x21AE, 0x2194},
+    {0x21CD, 0x21D0}, {0x21CE, 0x21D4}, {0x21CF, 0x21D2}, {0x2204, 0x2203},
+    {0x2209, 0x2208}, {0x220C, 0x220B}, {0x2224, 0x2223}, {0x2226, 0x2225},
+    {0x2241, 0x223C}, {0x2244, 0x2243}, {0x2247, 0x2245}, {0x2249, 0x2248},
+    {0x2260, 0x003D}, {0x2262, 0x2261}, {0x226D, 0x224D}, {0x226E, 0x003C},
+    {0x226F, 0x003E}, {0x2270, 0x2264}, {0x2271, 0x2265}, {0x2274, 0x2272},
+    {0x2275, 0x2273}, {0x2278, 0x2276}, {0x2279, 0x2277}, {0x2280, 0x227A},
+    {0x2281, 0x227B}, {0x2284, 0x2282}, {0x2285, 0x2283}, {0x2288, 0x2286},
+    {0x2289, 0x2287}, {0x22AC, 0x22A2}, {0x22AD, 0x22A8}, {0x22AE, 0x22A9},
+    {0x22AF, 0x22AB}, {0x22E0, 0x227C}, {0x22E1, 0x227D}, {0x22E2, 0x2291},
+    {0x22E3, 0x2292}, {0x22EA, 0x22B2}, {0x22EB, 0x22B3}, {0x22EC, 0x22B4},
+    {0x22ED, 0x22B5}, {0x2ADC, 0x2ADD}, {0x304C, 0x304B}, {0x304E, 0x304D},
+    {0x3050, 0x304F}, {0x3052, 0x3051}, {0x3054, 0x3053}, {0x3056, 0x3055},
+    {0x3058, 0x3057}, {0x305A, 0x3059}, {0x305C, 0x305B}, {0x305E, 0x305D},
+    {0x3060, 0x305F}, {0x3062, 0x3061}, {0x3065, 0x3064}, {0x3067, 0x3066},
+    {0x3069, 0x3068}, {0x3070, 0x306F}, {0x3071, 0x306F}, {0x3073, 0x3072},
+    {0x3074, 0x3072}, {0x3076, 0x3075}, {0x3077, 0x3075}, {0x3079, 0x3078},
+    {0x307A, 0x3078}, {0x307C, 0x307B}, {0x307D, 0x307B}, {0x3094, 0x3046},
+    {0x309E, 0x309D}, {0x30AC, 0x30AB}, {0x30AE, 0x30AD}, {0x30B0, 0x30AF},
+    {0x30B2, 0x30B1}, {0x30B4, 0x30B3}, {0x30B6, 0x30B5}, {0x30B8, 0x30B7},
+    {0x30BA, 0x30B9}, {0x30BC, 0x30BB}, {0x30BE, 0x30BD}, {0x30C0, 0x30BF},
+    {0x30C2, 0x30C1}, {0x30C5, 0x30C4}, {0x30C7, 0x30C6}, {0x30C9, 0x30C8},
+    {0x30D0, 0x30CF}, {0x30D1, 0x30CF}, {0x30D3, 0x30D2}, {0x30D4, 0x30D2},
+    {0x30D6, 0x30D5}, {0x30D7, 0x30D5}, {0x30D9, 0x30D8}, {0x30DA, 0x30D8},
+    {0x30DC, 0x30DB}, {0x30DD, 0x30DB}, {0x30F4, 0x30A6}, {0x30F7, 0x30EF},
+    {0x30F8, 0x30F0}, {0x30F9, 0x30F1}, {0x30FA, 0x30F2}, {0x30FE, 0x30FD},
+    {0xFB1D, 0x05D9}, {0xFB1F, 0x05F2}, {0xFB2A, 0x05E9}, {0xFB2B, 0x05E9},
+    {0xFB2C, 0x05E9}, {0xFB2D, 0x05E9}, {0xFB2E, 0x05D0}, {0xFB2F, 0x05D0},
+    {0xFB30, 0x05D0}, {0xFB31, 0x05D1}, {0xFB32, 0x05D2}, {0xFB33, 0x05D3},
+    {0xFB34, 0x05D4}, {0xFB35, 0x05D5}, {0xFB36, 0x05D6}, {0xFB38, 0x05D8},
+    {0xFB39, 0x05D9}, {0xFB3A, 0x05DA}, {0xFB3B, 0x05DB}, {0xFB3C, 0x05DC},
+    {0xFB3E, 0x05DE}, {0xFB40, 0x05E0}, {0xFB41, 0x05E1}, {0xFB43, 0x05E3},
+    {0xFB44, 0x05E4}, {0xFB46, 0x05E6}, {0xFB47, 0x05E7}, {0xFB48, 0x05E8},
+    {0xFB49, 0x05E9}, {0xFB4A, 0x05EA}, {0xFB4B, 0x05D5}, {0xFB4C, 0x05D1},
+    {0xFB4D, 0x05DB}, {0xFB4E, 0x05E4}, {0x1109A, 0x11099}, {0x1109C, 0x1109B},
+    {0x110AB, 0x110A5}, {0x114BB, 0x114B9},
+};
+
+#endif /* FASTEMBED_TOKENIZER_UNICODE_H */
@@ -34,6 +34,9 @@
  *
  *   # Normalize vector
  *   echo '{"op":"normalize","vec1":[3,4,0],"dim":3}' | ./vector_ops_cli
+ *
+ *   # Streaming mode: one operation per line until end of input
+ *   ./vector_ops_cli --stream < operations.ndjson
  * @endcode
  *
  * Input format:
@@ -45,9 +48,12 @@
  * - Success: JSON object with "result" field (scalar for cosine/dot/norm, array
  * for normalize)
  * - Error: JSON object with "error" field containing error message
+ * - Streaming (--stream): one result or error object per input line, in
+ *   input order, all on stdout (see cli_stream.h)
  *
  * Exit codes:
- * - 0: Success
+ * - 0: Success (streaming: end of input; per-line errors are reported in the
+ *   output)
  * - 1: Error (I/O error, invalid format, unknown operation)
  *
  * @note This tool uses a simplified JSON parser. For production use, consider
@@ -58,6 +64,7 @@
 
 #include "../include/fastembed_config.h"
 #include "../include/fastembed_internal.h"
+#include "cli_stream.h"
 #include "embedding_lib_c.h"
 #include <math.h>
 #include <stdint.h>
@@ -188,45 +195,26 @@ int parse_json_simple(char *json, char *op, float *vec1, float *vec2,
   return (*dim > 0 && *dim <= MAX_DIMENSION) ? 0 : -1;
 }
 
+/** run_operation() results */
+#define OPERATION_OK 0
+#define OPERATION_INVALID_INPUT -1
+#define OPERATION_UNKNOWN -2
+
 /**
- * @brief Main entry point for vector operations CLI tool
- *
- * Processes JSON input from stdin, parses operation and vectors, executes
- * the requested vector operation using SIMD-optimized assembly functions,
- * and outputs result as JSON.
+ * @brief Parse one JSON operation and print its result on stdout
  *
- * Workflow:
- * 1. Read JSON input from stdin (up to JSON_BUFFER_SIZE characters)
- * 2. Parse JSON to extract operation, vectors, and dimension
- * 3. Validate input (operation type, vector dimensions)
- * 4. Execute operation using assembly-optimized functions
- * 5. Output result as JSON (scalar for cosine/dot/norm, array for normalize)
- *
- * @param argc Number of command-line arguments (currently unused)
- * @param argv Command-line arguments array (currently unused)
- * @return Exit code: 0 on success, 1 on error
- *
- * @note Input is read from stdin, not command-line arguments
- * @note Output is always to stdout, errors to stderr
- * @note All operations are SIMD-optimized using assembly code
+ * @param json Input JSON object (modified in-place during parsing)
+ * @param op Output buffer for operation name (at least 32 chars)
+ * @param vec1 Scratch vector (size >= MAX_DIMENSION)
+ * @param vec2 Scratch vector (size >= MAX_DIMENSION)
+ * @return OPERATION_OK, OPERATION_INVALID_INPUT or OPERATION_UNKNOWN
  */
-int main(int argc, char *argv[]) {
-  char buffer[JSON_BUFFER_SIZE];
-  char op[32] = {0};
-  float vec1[MAX_DIMENSION] = {0};
-  float vec2[MAX_DIMENSION] = {0};
+static int run_operation(char *json, char *op, float *vec1, float *vec2) {
   int dim = 0;
 
-  /* Read JSON input from stdin (supports piping and redirection) */
-  if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
-    fprintf(stderr, "{\"error\":\"Failed to read input\"}\n");
-    return 1;
-  }
-
   /* Parse JSON input to extract operation, vectors, and dimension */
-  if (parse_json_simple(buffer, op, vec1, vec2, &dim) != 0) {
-    fprintf(stderr, "{\"error\":\"Invalid input format\"}\n");
-    return 1;
+  if (parse_json_simple(json, op, vec1, vec2, &dim) != 0) {
+    return OPERATION_INVALID_INPUT;
   }
 
   /* Execute requested operation using SIMD-optimized assembly functions */
@@ -254,6 +242,131 @@ int main(int argc, char *argv[]) {
     }
     printf("]}\n");
   } else {
+    return OPERATION_UNKNOWN;
+  }
+  return OPERATION_OK;
+}
+
+/**
+ * @brief Streaming mode: one operation per input line until end of input
+ *
+ * Errors are written to stdout in place of the result, so output line i
+ * always answers input line i (blank lines are skipped). Output is flushed
+ * whenever no further complete input line is buffered.
+ *
+ * @return Exit code: 0 at end of input, 1 on a read/write error
+ */
+static int run_stream(void) {
+  static float vec1[MAX_DIMENSION];
+  static float vec2[MAX_DIMENSION];
+  char op[32];
+  cli_line_reader_t reader;
+  int unflushed = 0;
+  int exit_code = 0;
+
+  if (cli_line_reader_init(&reader) != 0) {
+    fprintf(stderr, "{\"error\":\"Out of memory\"}\n");
+    return 1;
+  }
+
+  for (;;) {
+    char *line;
+    size_t length;
+    int status = cli_line_reader_next(&reader, !unflushed, &line, &length);
+
+    if (status == CLI_LINE_WOULD_BLOCK) {
+      if (fflush(stdout) != 0) {
+        exit_code = 1;
+        break;
+      }
+      unflushed = 0;
+      continue;
+    }
+    if (status == CLI_LINE_END) {
+      break;
+    }
+    if (status == CLI_LINE_ERROR) {
+      fprintf(stderr, "{\"error\":\"Failed to read input\"}\n");
+      exit_code = 1;
+      break;
+    }
+
+    if (status == CLI_LINE_TOO_LONG) {
+      printf("{\"error\":\"Input line too long\"}\n");
+    } else if (strspn(line, " \t") == length) {
+      continue;
+    } else {
+      /* Fields missing from this line must not keep earlier values */
+      memset(vec1, 0, sizeof(vec1));
+      memset(vec2, 0, sizeof(vec2));
+      int result = run_operation(line, op, vec1, vec2);
+      if (result == OPERATION_INVALID_INPUT) {
+        printf("{\"error\":\"Invalid input format\"}\n");
+      } else if (result == OPERATION_UNKNOWN) {
+        printf("{\"error\":\"Unknown operation: %s\"}\n", op);
+      }
+    }
+    unflushed = 1;
+  }
+
+  if (fflush(stdout) != 0 || ferror(stdout)) {
+    fprintf(stderr, "{\"error\":\"Failed to write output\"}\n");
+    exit_code = 1;
+  }
+  cli_line_reader_free(&reader);
+  return exit_code;
+}
+
+/**
+ * @brief Main entry point for vector operations CLI tool
+ *
+ * Processes JSON input from stdin, parses operation and vectors, executes
+ * the requested vector operation using SIMD-optimized assembly functions,
+ * and outputs result as JSON. With --stream, processes one operation per
+ * line until end of input instead (see run_stream()).
+ *
+ * Workflow:
+ * 1. Read JSON input from stdin (up to JSON_BUFFER_SIZE characters)
+ * 2. Parse JSON to extract operation, vectors, and dimension
+ * 3. Validate input (operation type, vector dimensions)
+ * 4. Execute operation using assembly-optimized functions
+ * 5. Output result as JSON (scalar for cosine/dot/norm, array for normalize)
+ *
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments array (--stream or nothing)
+ * @return Exit code: 0 on success, 1 on error
+ *
+ * @note Input is read from stdin, not command-line arguments
+ * @note Output is always to stdout, errors to stderr (stdout in streaming
+ * mode)
+ * @note All operations are SIMD-optimized using assembly code
+ */
+int main(int argc, char *argv[]) {
+  char buffer[JSON_BUFFER_SIZE];
+  char op[32] = {0};
+  float vec1[MAX_DIMENSION] = {0};
+  float vec2[MAX_DIMENSION] = {0};
+
+  if (argc == 2 && strcmp(argv[1], "--stream") == 0) {
+    return run_stream();
+  }
+  if (argc > 1) {
+    fprintf(stderr, "Usage: echo '{\"op\":...}' | %s [--stream]\n", argv[0]);
+    return 1;
+  }
+
+  /* Read JSON input from stdin (supports piping and redirection) */
+  if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
+    fprintf(stderr, "{\"error\":\"Failed to read input\"}\n");
+    return 1;
+  }
+
+  int result = run_operation(buffer, op, vec1, vec2);
+  if (result == OPERATION_INVALID_INPUT) {
+    fprintf(stderr, "{\"error\":\"Invalid input format\"}\n");
+    return 1;
+  }
+  if (result == OPERATION_UNKNOWN) {
     fprintf(stderr, "{\"error\":\"Unknown operation: %s\"}\n", op);
     return 1;
   }
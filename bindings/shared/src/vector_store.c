@@ -0,0 +1,425 @@
+/**
+ * @file vector_store.c
+ * @brief Memory-mapped embedding store files with a streaming append writer
+ *
+ * File layout (native byte order):
+ * - A header padded to STORE_VECTORS_OFFSET bytes: magic, byte order mark,
+ * version, dimension, dtype, flags, count and the section offsets
+ * - The vector block: count rows of dimension floats or 16-bit halves, back
+ * to back, starting on a FASTEMBED_MATRIX_ALIGNMENT boundary
+ * - With FASTEMBED_STORE_IDS, an int64 id per row, also aligned
+ *
+ * The writer streams rows to disk as they are appended and keeps only the
+ * ids in memory. The header is written twice: zeroed first, then completed
+ * by fastembed_store_writer_close() once the ids are on disk, so a file
+ * from a crashed writer fails the size check and never opens.
+ *
+ * fastembed_store_open() maps the file and checks the header; the vector
+ * block is used in place, so opening costs the same for any corpus size.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/fastembed.h"
+#include "../include/fastembed_config.h"
+#include "fastembed_platform.h"
+
+/** File format */
+#define STORE_MAGIC "FESTORE"
+#define STORE_VERSION 1
+#define STORE_BYTE_ORDER_MARK 0x01020304u
+#define STORE_VECTORS_OFFSET 128
+
+#define STORE_KNOWN_FLAGS (FASTEMBED_STORE_NORMALIZED | FASTEMBED_STORE_IDS)
+
+/**
+ * @brief On-disk header (native byte order, padded to STORE_VECTORS_OFFSET)
+ */
+typedef struct {
+  char magic[8];
+  uint32_t byte_order;
+  uint32_t version;
+  uint32_t dimension;
+  uint32_t dtype;
+  uint32_t flags;
+  uint32_t row_bytes;
+  uint64_t count;
+  uint64_t vectors_offset;
+  uint64_t ids_offset; /* 0 without FASTEMBED_STORE_IDS */
+  uint64_t file_bytes;
+} store_file_header_t;
+
+struct fastembed_store_writer {
+  FILE *file;
+  char *path;
+  char *buffer; /* stdio buffer */
+  int dimension;
+  int dtype;
+  int flags;
+  size_t row_bytes;
+  int32_t count;
+  int64_t *ids;
+  size_t ids_capacity;
+  float *row;       /* Normalized copy of one row */
+  uint16_t *halves; /* One converted row */
+  int failed;
+};
+
+struct fastembed_store {
+  fastembed_file_map_t map;
+  int dimension;
+  int dtype;
+  int flags;
+  int32_t count;
+  const void *vectors;
+  const int64_t *ids;
+};
+
+static size_t store_element_bytes(int dtype) {
+  switch (dtype) {
+  case FASTEMBED_QUANT_NONE:
+    return sizeof(float);
+  case FASTEMBED_QUANT_FP16:
+  case FASTEMBED_QUANT_BF16:
+    return sizeof(uint16_t);
+  default:
+    return 0;
+  }
+}
+
+static uint64_t store_align(uint64_t offset) {
+  return (offset + FASTEMBED_MATRIX_ALIGNMENT - 1) &
+         ~(uint64_t)(FASTEMBED_MATRIX_ALIGNMENT - 1);
+}
+
+/** Write a zero-padded header block at the current file position */
+static int store_write_header(FILE *file, const store_file_header_t *header) {
+  unsigned char padded[STORE_VECTORS_OFFSET];
+  memset(padded, 0, sizeof(padded));
+  memcpy(padded, header, sizeof(*header));
+  return fwrite(padded, 1, sizeof(padded), file) == sizeof(padded) ? 0 : -1;
+}
+
+/** Write zeros up to an aligned offset */
+static int store_write_padding(FILE *file, uint64_t from, uint64_t to) {
+  static const unsigned char zeros[FASTEMBED_MATRIX_ALIGNMENT];
+  size_t bytes = (size_t)(to - from);
+  return fwrite(zeros, 1, bytes, file) == bytes ? 0 : -1;
+}
+
+static void store_writer_free(fastembed_store_writer_t *writer) {
+  free(writer->path);
+  free(writer->ids);
+  free(writer->row);
+  free(writer->halves);
+  free(writer->buffer);
+  free(writer);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Writer                                                                    */
+/* ------------------------------------------------------------------------ */
+
+FASTEMBED_EXPORT fastembed_store_writer_t *
+fastembed_store_writer_open(const char *path, int dimension, int dtype,
+                            int flags) {
+  if (!path || dimension <= 0 || dimension > FASTEMBED_MAX_DIMENSION ||
+      store_element_bytes(dtype) == 0 || (flags & ~STORE_KNOWN_FLAGS) != 0) {
+    return NULL;
+  }
+
+  fastembed_store_writer_t *writer =
+      (fastembed_store_writer_t *)calloc(1, sizeof(*writer));
+  if (!writer) {
+    return NULL;
+  }
+  writer->dimension = dimension;
+  writer->dtype = dtype;
+  writer->flags = flags;
+  writer->row_bytes = (size_t)dimension * store_element_bytes(dtype);
+
+  size_t path_bytes = strlen(path) + 1;
+  writer->path = (char *)malloc(path_bytes);
+  writer->buffer = (char *)malloc(FASTEMBED_STORE_WRITE_BUFFER);
+  writer->row = (float *)malloc((size_t)dimension * sizeof(float));
+  writer->halves = (uint16_t *)malloc((size_t)dimension * sizeof(uint16_t));
+  if (!writer->path || !writer->buffer || !writer->row || !writer->halves) {
+    store_writer_free(writer);
+    return NULL;
+  }
+  memcpy(writer->path, path, path_bytes);
+
+  writer->file = fopen(path, "wb");
+  if (!writer->file) {
+    store_writer_free(writer);
+    return NULL;
+  }
+  setvbuf(writer->file, writer->buffer, _IOFBF, FASTEMBED_STORE_WRITE_BUFFER);
+
+  /* Placeholder header: fails the size check until completed */
+  store_file_header_t header;
+  memset(&header, 0, sizeof(header));
+  if (store_write_header(writer->file, &header) != 0) {
+    writer->failed = 1;
+  }
+  return writer;
+}
+
+/** Write one row, normalized and converted as the store requires */
+static int store_write_row(fastembed_store_writer_t *writer,
+                           const float *vector) {
+  const float *row = vector;
+  if (writer->flags & FASTEMBED_STORE_NORMALIZED) {
+    memcpy(writer->row, vector, (size_t)writer->dimension * sizeof(float));
+    fastembed_normalize(writer->row, writer->dimension);
+    row = writer->row;
+  }
+
+  const void *out = row;
+  if (writer->dtype == FASTEMBED_QUANT_FP16) {
+    if (fastembed_f32_to_f16(row, writer->halves, writer->dimension) != 0) {
+      return -1;
+    }
+    out = writer->halves;
+  } else if (writer->dtype == FASTEMBED_QUANT_BF16) {
+    if (fastembed_f32_to_bf16(row, writer->halves, writer->dimension) != 0) {
+      return -1;
+    }
+    out = writer->halves;
+  }
+  return fwrite(out, 1, writer->row_bytes, writer->file) == writer->row_bytes
+             ? 0
+             : -1;
+}
+
+FASTEMBED_EXPORT int fastembed_store_writer_append(
+    fastembed_store_writer_t *writer, const float *vectors, int num_vectors,
+    const int64_t *ids) {
+  if (!writer || writer->failed) {
+    return -1;
+  }
+  if (num_vectors == 0) {
+    return 0;
+  }
+  int with_ids = (writer->flags & FASTEMBED_STORE_IDS) != 0;
+  if (!vectors || num_vectors < 0 || (with_ids && !ids) ||
+      num_vectors > INT32_MAX - writer->count) {
+    return -1;
+  }
+
+  if (with_ids) {
+    size_t needed = (size_t)writer->count + (size_t)num_vectors;
+    if (needed > writer->ids_capacity) {
+      size_t capacity = writer->ids_capacity ? writer->ids_capacity : 1024;
+      while (capacity < needed) {
+        capacity *= 2;
+      }
+      int64_t *grown =
+          (int64_t *)realloc(writer->ids, capacity * sizeof(int64_t));
+      if (!grown) {
+        writer->failed = 1;
+        return -1;
+      }
+      writer->ids = grown;
+      writer->ids_capacity = capacity;
+    }
+  }
+
+  int plain = writer->dtype == FASTEMBED_QUANT_NONE &&
+              !(writer->flags & FASTEMBED_STORE_NORMALIZED);
+  if (plain) {
+    size_t bytes = (size_t)num_vectors * writer->row_bytes;
+    if (fwrite(vectors, 1, bytes, writer->file) != bytes) {
+      writer->failed = 1;
+      return -1;
+    }
+  } else {
+    for (int i = 0; i < num_vectors; i++) {
+      if (store_write_row(writer,
+                          vectors + (size_t)i * (size_t)writer->dimension) !=
+          0) {
+        writer->failed = 1;
+        return -1;
+      }
+    }
+  }
+
+  if (with_ids) {
+    memcpy(writer->ids + writer->count, ids,
+           (size_t)num_vectors * sizeof(int64_t));
+  }
+  writer->count += num_vectors;
+  return 0;
+}
+
+FASTEMBED_EXPORT int
+fastembed_store_writer_close(fastembed_store_writer_t *writer) {
+  if (!writer) {
+    return -1;
+  }
+
+  store_file_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+  header.byte_order = STORE_BYTE_ORDER_MARK;
+  header.version = STORE_VERSION;
+  header.dimension = (uint32_t)writer->dimension;
+  header.dtype = (uint32_t)writer->dtype;
+  header.flags = (uint32_t)writer->flags;
+  header.row_bytes = (uint32_t)writer->row_bytes;
+  header.count = (uint64_t)writer->count;
+  header.vectors_offset = STORE_VECTORS_OFFSET;
+
+  uint64_t vectors_end =
+      STORE_VECTORS_OFFSET + (uint64_t)writer->count * writer->row_bytes;
+  header.file_bytes = vectors_end;
+
+  int ok = !writer->failed;
+  if (ok && (writer->flags & FASTEMBED_STORE_IDS)) {
+    header.ids_offset = store_align(vectors_end);
+    header.file_bytes =
+        header.ids_offset + (uint64_t)writer->count * sizeof(int64_t);
+    size_t ids = (size_t)writer->count;
+    ok = store_write_padding(writer->file, vectors_end, header.ids_offset) ==
+             0 &&
+         (ids == 0 ||
+          fwrite(writer->ids, sizeof(int64_t), ids, writer->file) == ids);
+  }
+
+  /* Complete the header last */
+  ok = ok && fflush(writer->file) == 0 &&
+       fseek(writer->file, 0, SEEK_SET) == 0 &&
+       store_write_header(writer->file, &header) == 0;
+  if (fclose(writer->file) != 0) {
+    ok = 0;
+  }
+  if (!ok) {
+    remove(writer->path);
+  }
+  store_writer_free(writer);
+  return ok ? 0 : -1;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Reader                                                                    */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief Check a mapped header against the file size
+ */
+static int store_check_header(const store_file_header_t *header,
+                              uint64_t file_bytes) {
+  if (memcmp(header->magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 ||
+      header->byte_order != STORE_BYTE_ORDER_MARK ||
+      header->version != STORE_VERSION) {
+    return -1;
+  }
+  size_t element_bytes = store_element_bytes((int)header->dtype);
+  if (header->dimension == 0 || header->dimension > FASTEMBED_MAX_DIMENSION ||
+      element_bytes == 0 || (header->flags & ~STORE_KNOWN_FLAGS) != 0 ||
+      header->row_bytes != header->dimension * element_bytes ||
+      header->count > (uint64_t)INT32_MAX ||
+      header->vectors_offset != STORE_VECTORS_OFFSET ||
+      header->file_bytes != file_bytes) {
+    return -1;
+  }
+
+  uint64_t vectors_end =
+      STORE_VECTORS_OFFSET + header->count * (uint64_t)header->row_bytes;
+  if (header->flags & FASTEMBED_STORE_IDS) {
+    return header->ids_offset == store_align(vectors_end) &&
+                   header->ids_offset + header->count * sizeof(int64_t) ==
+                       file_bytes
+               ? 0
+               : -1;
+  }
+  return header->ids_offset == 0 && vectors_end == file_bytes ? 0 : -1;
+}
+
+FASTEMBED_EXPORT fastembed_store_t *fastembed_store_open(const char *path) {
+  fastembed_file_map_t map;
+  if (!path || fastembed_map_file(path, &map) != 0) {
+    return NULL;
+  }
+
+  store_file_header_t header;
+  if (map.size < STORE_VECTORS_OFFSET) {
+    fastembed_unmap_file(&map);
+    return NULL;
+  }
+  memcpy(&header, map.data, sizeof(header));
+  fastembed_store_t *store = NULL;
+  if (store_check_header(&header, (uint64_t)map.size) == 0) {
+    store = (fastembed_store_t *)calloc(1, sizeof(*store));
+  }
+  if (!store) {
+    fastembed_unmap_file(&map);
+    return NULL;
+  }
+
+  const unsigned char *base = (const unsigned char *)map.data;
+  store->map = map;
+  store->dimension = (int)header.dimension;
+  store->dtype = (int)header.dtype;
+  store->flags = (int)header.flags;
+  store->count = (int32_t)header.count;
+  store->vectors = base + header.vectors_offset;
+  store->ids = (header.flags & FASTEMBED_STORE_IDS)
+                   ? (const int64_t *)(base + header.ids_offset)
+                   : NULL;
+  return store;
+}
+
+FASTEMBED_EXPORT void fastembed_store_close(fastembed_store_t *store) {
+  if (!store) {
+    return;
+  }
+  fastembed_unmap_file(&store->map);
+  free(store);
+}
+
+FASTEMBED_EXPORT int fastembed_store_count(const fastembed_store_t *store) {
+  return store ? store->count : -1;
+}
+
+FASTEMBED_EXPORT int fastembed_store_dimension(const fastembed_store_t *store) {
+  return store ? store->dimension : -1;
+}
+
+FASTEMBED_EXPORT int fastembed_store_dtype(const fastembed_store_t *store) {
+  return store ? store->dtype : -1;
+}
+
+FASTEMBED_EXPORT int fastembed_store_flags(const fastembed_store_t *store) {
+  return store ? store->flags : -1;
+}
+
+FASTEMBED_EXPORT const void *
+fastembed_store_vectors(const fastembed_store_t *store) {
+  return store ? store->vectors : NULL;
+}
+
+FASTEMBED_EXPORT const int64_t *
+fastembed_store_ids(const fastembed_store_t *store) {
+  return store ? store->ids : NULL;
+}
+
+FASTEMBED_EXPORT int fastembed_store_topk(const fastembed_store_t *store,
+                                          const float *query, int k,
+                                          int *out_ids, float *out_scores,
+                                          int metric, int num_threads) {
+  if (!store) {
+    return -1;
+  }
+  if (store->dtype == FASTEMBED_QUANT_NONE) {
+    return fastembed_topk_threaded(query, (const float *)store->vectors,
+                                   store->count, store->dimension, k, out_ids,
+                                   out_scores, metric, num_threads);
+  }
+  return fastembed_topk_half(query, (const uint16_t *)store->vectors,
+                             store->dtype, store->count, store->dimension, k,
+                             out_ids, out_scores, metric, num_threads);
+}
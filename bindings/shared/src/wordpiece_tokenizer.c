@@ -0,0 +1,1227 @@
+/**
+ * @file wordpiece_tokenizer.c
+ * @brief Native WordPiece tokenizer for BERT-style embedding models
+ *
+ * Loads a model vocabulary from a plain vocab.txt (one token per line, ID =
+ * line number) or a Hugging Face tokenizer.json with a WordPiece model, and
+ * converts text into the token IDs the model was trained on.
+ *
+ * Pipeline (same steps as the reference BertTokenizer):
+ * 1. Normalize: drop control characters, optionally lowercase and strip
+ * accents (uncased models)
+ * 2. Pre-tokenize: split on whitespace; punctuation and CJK ideographs
+ * become single-character words
+ * 3. WordPiece: greedy longest-match-first split of each word into vocabulary
+ * pieces ("##"-prefixed continuation pieces); words that cannot be split
+ * become [UNK]
+ * 4. Add [CLS] / [SEP] and truncate to the requested length
+ *
+ * Performance:
+ * - ASCII is classified with a lookup table; other codepoints use binary
+ * search over Unicode range tables (tokenizer_unicode.h)
+ * - The vocabulary is stored in a double-array trie: longest-match lookup
+ * walks each byte of a piece once, with no hashing or string compares
+ * - Encoding makes no heap allocations
+ *
+ * Thread safety: a loaded tokenizer is immutable and can be shared between
+ * threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/fastembed.h"
+#include "tokenizer_unicode.h"
+
+/** Free slot marker in the double-array check[] array */
+#define TRIE_FREE -1
+
+/** Bytes buffered per word (longer words become [UNK]) */
+#define WORD_BUFFER_SIZE 1024
+
+/** Maximum length of the unknown token / continuation prefix strings */
+#define MAX_SPECIAL_TOKEN_LENGTH 64
+
+/**
+ * @brief Loaded tokenizer
+ *
+ * The vocabulary is a double-array trie over token bytes: the child of node
+ * s for byte c is t = base[s] + c, valid if check[t] == s. value[t] is the
+ * token ID ending at node t, or -1.
+ */
+struct fastembed_tokenizer {
+  int32_t *base;
+  int32_t *check;
+  int32_t *value;
+  int32_t trie_size;
+  int32_t continuation_root; /* Node reached by the "##" prefix, -1 if none */
+  int vocab_size;            /* Highest token ID + 1 */
+  int cls_id;
+  int sep_id;
+  int unk_id;
+  int pad_id;
+  int lowercase;            /* Lowercase input (uncased models) */
+  int strip_accents;        /* Remove accents / combining marks */
+  int handle_chinese_chars; /* Split CJK ideographs into single characters */
+  int max_word_chars;       /* Longer words become [UNK] */
+};
+
+/**
+ * @brief Vocabulary entry collected while parsing
+ */
+typedef struct {
+  const char *text;
+  int length;
+  int id;
+} VocabEntry;
+
+typedef struct {
+  VocabEntry *entries;
+  int count;
+  int capacity;
+} VocabList;
+
+/**
+ * @brief Normalizer settings read from the vocabulary file
+ */
+typedef struct {
+  int lowercase;
+  int strip_accents;
+  int handle_chinese_chars;
+  int max_word_chars;
+  char unk_token[MAX_SPECIAL_TOKEN_LENGTH];
+  char continuation_prefix[MAX_SPECIAL_TOKEN_LENGTH];
+} TokenizerConfig;
+
+/* ========================================================================== */
+/* Character classes                                                          */
+/* ========================================================================== */
+
+enum {
+  CHAR_WORD = 0,  /* Part of a word */
+  CHAR_SPACE = 1, /* Word boundary */
+  CHAR_PUNCT = 2, /* Single-character word */
+  CHAR_DROP = 3   /* Removed (control characters) */
+};
+
+/**
+ * @brief ASCII character classes
+ *
+ * Tab, newline and carriage return are whitespace; other control characters
+ * are dropped. All non-alphanumeric printable characters are punctuation,
+ * as in BERT (including symbols such as $, + and ^).
+ */
+static const unsigned char k_ascii_class[128] = {
+    /* 0x00 */ 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 3, 3, 1, 3, 3,
+    /* 0x10 */ 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    /* 0x20 */ 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    /* 0x30 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2,
+    /* 0x40 */ 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0x50 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2,
+    /* 0x60 */ 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0x70 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3,
+};
+
+/**
+ * @brief Binary search a sorted range table
+ */
+static int in_ranges(const fastembed_unicode_range_t *ranges, size_t count,
+                     uint32_t cp) {
+  size_t lo = 0, hi = count;
+  if (count == 0 || cp < ranges[0].first || cp > ranges[count - 1].last)
+    return 0;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (cp < ranges[mid].first)
+      hi = mid;
+    else if (cp > ranges[mid].last)
+      lo = mid + 1;
+    else
+      return 1;
+  }
+  return 0;
+}
+
+#define IN_TABLE(table, cp)                                                    \
+  in_ranges(table, sizeof(table) / sizeof(table[0]), cp)
+
+/**
+ * @brief CJK ideograph blocks split by BERT (not Hangul, Hiragana or
+ * Katakana)
+ */
+static int is_cjk_ideograph(uint32_t cp) {
+  return (cp >= 0x4E00 && cp <= 0x9FFF) || (cp >= 0x3400 && cp <= 0x4DBF) ||
+         (cp >= 0x20000 && cp <= 0x2A6DF) ||
+         (cp >= 0x2A700 && cp <= 0x2B73F) ||
+         (cp >= 0x2B740 && cp <= 0x2B81F) ||
+         (cp >= 0x2B820 && cp <= 0x2CEAF) || (cp >= 0xF900 && cp <= 0xFAFF) ||
+         (cp >= 0x2F800 && cp <= 0x2FA1F);
+}
+
+/**
+ * @brief Simple lowercase mapping for a non-ASCII codepoint
+ */
+static uint32_t to_lower(uint32_t cp) {
+  size_t lo = 0, hi = sizeof(k_lowercase_ranges) / sizeof(k_lowercase_ranges[0]);
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    const fastembed_unicode_case_t *run = &k_lowercase_ranges[mid];
+    if (cp < run->first)
+      hi = mid;
+    else if (cp > run->last)
+      lo = mid + 1;
+    else
+      return ((cp - run->first) % (uint32_t)run->step == 0)
+                 ? (uint32_t)((int32_t)cp + run->delta)
+                 : cp;
+  }
+  return cp;
+}
+
+/**
+ * @brief Base character of a precomposed accented codepoint
+ */
+static uint32_t strip_accent(uint32_t cp) {
+  size_t lo = 0, hi = sizeof(k_accent_base) / sizeof(k_accent_base[0]);
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (cp < k_accent_base[mid].from)
+      hi = mid;
+    else if (cp > k_accent_base[mid].from)
+      lo = mid + 1;
+    else
+      return k_accent_base[mid].to;
+  }
+  return cp;
+}
+
+/**
+ * @brief Decode one UTF-8 sequence
+ *
+ * @param p Input (at least one non-NUL byte)
+ * @param cp Decoded codepoint (U+FFFD for invalid sequences)
+ * @return Number of bytes consumed (>= 1)
+ */
+static int decode_utf8(const unsigned char *p, uint32_t *cp) {
+  unsigned char c = p[0];
+  int length;
+  uint32_t value;
+
+  if (c >= 0xF0 && c <= 0xF4) {
+    length = 4;
+    value = c & 0x07;
+  } else if (c >= 0xE0 && c <= 0xEF) {
+    length = 3;
+    value = c & 0x0F;
+  } else if (c >= 0xC2 && c <= 0xDF) {
+    length = 2;
+    value = c & 0x1F;
+  } else {
+    *cp = 0xFFFD;
+    return 1;
+  }
+
+  for (int i = 1; i < length; i++) {
+    if ((p[i] & 0xC0) != 0x80) {
+      *cp = 0xFFFD;
+      return i;
+    }
+    value = (value << 6) | (p[i] & 0x3F);
+  }
+
+  /* Reject overlong forms, surrogates and out-of-range values */
+  if ((length == 3 && value < 0x800) || (length == 4 && value < 0x10000) ||
+      value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+    *cp = 0xFFFD;
+    return length;
+  }
+  *cp = value;
+  return length;
+}
+
+/**
+ * @brief Encode a codepoint as UTF-8
+ *
+ * @return Number of bytes written (1-4)
+ */
+static int encode_utf8(uint32_t cp, unsigned char *out) {
+  if (cp < 0x80) {
+    out[0] = (unsigned char)cp;
+    return 1;
+  }
+  if (cp < 0x800) {
+    out[0] = (unsigned char)(0xC0 | (cp >> 6));
+    out[1] = (unsigned char)(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    out[0] = (unsigned char)(0xE0 | (cp >> 12));
+    out[1] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = (unsigned char)(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  out[0] = (unsigned char)(0xF0 | (cp >> 18));
+  out[1] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+  out[2] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+  out[3] = (unsigned char)(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+/* ========================================================================== */
+/* Double-array trie                                                          */
+/* ========================================================================== */
+
+typedef struct {
+  int32_t *base;
+  int32_t *check;
+  int32_t *value;
+  int32_t capacity;
+  int32_t size;      /* Highest used slot + 1 */
+  int32_t next_free; /* Start of the base search */
+} TrieBuilder;
+
+/**
+ * @brief Grow the builder arrays to hold at least needed slots
+ */
+static int trie_reserve(TrieBuilder *builder, int32_t needed) {
+  if (needed <= builder->capacity)
+    return 0;
+
+  int32_t capacity = builder->capacity ? builder->capacity : 4096;
+  while (capacity < needed)
+    capacity *= 2;
+
+  int32_t *base = (int32_t *)realloc(builder->base, capacity * sizeof(int32_t));
+  if (base == NULL)
+    return -1;
+  builder->base = base;
+  int32_t *check =
+      (int32_t *)realloc(builder->check, capacity * sizeof(int32_t));
+  if (check == NULL)
+    return -1;
+  builder->check = check;
+  int32_t *value =
+      (int32_t *)realloc(builder->value, capacity * sizeof(int32_t));
+  if (value == NULL)
+    return -1;
+  builder->value = value;
+
+  for (int32_t i = builder->capacity; i < capacity; i++) {
+    builder->base[i] = 0;
+    builder->check[i] = TRIE_FREE;
+    builder->value[i] = -1;
+  }
+  builder->capacity = capacity;
+  return 0;
+}
+
+/**
+ * @brief Find a base offset where every child label lands on a free slot
+ *
+ * @param labels Child labels in ascending order
+ * @param count Number of labels (>= 1)
+ * @return Base offset (>= 1), or -1 on allocation failure
+ */
+static int32_t trie_find_base(TrieBuilder *builder,
+                              const unsigned char *labels, int count) {
+  while (builder->check[builder->next_free] != TRIE_FREE) {
+    builder->next_free++;
+    if (trie_reserve(builder, builder->next_free + 257) != 0)
+      return -1;
+  }
+
+  int32_t pos = builder->next_free;
+  if (pos <= labels[0])
+    pos = labels[0] + 1; /* Keep base >= 1 so no child lands on the root */
+  int32_t start = pos;
+  int32_t occupied = 0;
+
+  for (;; pos++) {
+    if (trie_reserve(builder, pos + 257) != 0)
+      return -1;
+    if (builder->check[pos] != TRIE_FREE) {
+      occupied++;
+      continue;
+    }
+
+    int32_t base = pos - labels[0];
+    int fits = 1;
+    for (int i = 1; i < count; i++) {
+      if (builder->check[base + labels[i]] != TRIE_FREE) {
+        fits = 0;
+        break;
+      }
+    }
+    if (!fits)
+      continue;
+
+    /* Skip over densely packed regions on later searches */
+    if (occupied * 20 >= (pos - start + 1) * 19)
+      builder->next_free = pos;
+    return base;
+  }
+}
+
+/**
+ * @brief Insert the sorted keys entries[lo, hi) below node
+ *
+ * All keys in the range share their first depth bytes (the path to node).
+ */
+static int trie_build_node(TrieBuilder *builder, int32_t node,
+                           const VocabEntry *entries, int lo, int hi,
+                           int depth) {
+  int i = lo;
+
+  /* Sorted order puts the key that ends at this node first */
+  if (i < hi && entries[i].length == depth) {
+    builder->value[node] = entries[i].id;
+    i++;
+  }
+  if (i == hi)
+    return 0;
+
+  unsigned char labels[256];
+  int count = 0;
+  for (int j = i; j < hi; j++) {
+    unsigned char c = (unsigned char)entries[j].text[depth];
+    if (count == 0 || labels[count - 1] != c)
+      labels[count++] = c;
+  }
+
+  int32_t base = trie_find_base(builder, labels, count);
+  if (base < 0)
+    return -1;
+  builder->base[node] = base;
+
+  /* Claim every child slot before recursing, then fill the subtrees */
+  for (int k = 0; k < count; k++) {
+    int32_t child = base + labels[k];
+    builder->check[child] = node;
+    if (child + 1 > builder->size)
+      builder->size = child + 1;
+  }
+
+  int group_start = i;
+  for (int k = 0; k < count; k++) {
+    int group_end = group_start;
+    while (group_end < hi &&
+           (unsigned char)entries[group_end].text[depth] == labels[k])
+      group_end++;
+    if (trie_build_node(builder, base + labels[k], entries, group_start,
+                        group_end, depth + 1) != 0)
+      return -1;
+    group_start = group_end;
+  }
+  return 0;
+}
+
+/**
+ * @brief Follow the edge labelled c from node
+ *
+ * @return Child node, or -1 if there is no such edge
+ */
+static inline int32_t trie_next(const fastembed_tokenizer_t *tokenizer,
+                                int32_t node, unsigned char c) {
+  int32_t next = tokenizer->base[node] + c;
+  return (next < tokenizer->trie_size && tokenizer->check[next] == node)
+             ? next
+             : -1;
+}
+
+/**
+ * @brief Walk a byte string from node
+ *
+ * @return Node reached, or -1 if the path does not exist
+ */
+static int32_t trie_walk(const fastembed_tokenizer_t *tokenizer, int32_t node,
+                         const char *text) {
+  for (const unsigned char *p = (const unsigned char *)text; *p && node >= 0;
+       p++)
+    node = trie_next(tokenizer, node, *p);
+  return node;
+}
+
+/**
+ * @brief Order vocabulary entries by bytes, then by ID
+ */
+static int compare_entries(const void *a, const void *b) {
+  const VocabEntry *ea = (const VocabEntry *)a;
+  const VocabEntry *eb = (const VocabEntry *)b;
+  int order = strcmp(ea->text, eb->text);
+  if (order != 0)
+    return order;
+  return (ea->id > eb->id) - (ea->id < eb->id);
+}
+
+/**
+ * @brief Build the trie from the collected vocabulary
+ *
+ * Duplicate tokens keep their last (highest) ID, as in the reference
+ * vocab.txt loader.
+ *
+ * @return 0 on success, -1 on allocation failure or empty vocabulary
+ */
+static int build_trie(fastembed_tokenizer_t *tokenizer, VocabList *vocab) {
+  VocabEntry *entries = vocab->entries;
+  int count = 0;
+
+  qsort(entries, vocab->count, sizeof(VocabEntry), compare_entries);
+  for (int i = 0; i < vocab->count; i++) {
+    if (count > 0 && strcmp(entries[count - 1].text, entries[i].text) == 0)
+      entries[count - 1] = entries[i];
+    else
+      entries[count++] = entries[i];
+  }
+  if (count == 0)
+    return -1;
+
+  TrieBuilder builder;
+  memset(&builder, 0, sizeof(builder));
+  if (trie_reserve(&builder, 4096) != 0)
+    goto fail;
+  builder.check[0] = 0; /* Root */
+  builder.size = 1;
+  builder.next_free = 1;
+
+  if (trie_build_node(&builder, 0, entries, 0, count, 0) != 0)
+    goto fail;
+
+  /* Trim unused tail slots */
+  tokenizer->trie_size = builder.size;
+  tokenizer->base = builder.base;
+  tokenizer->check = builder.check;
+  tokenizer->value = builder.value;
+  int32_t *shrunk;
+  if ((shrunk = (int32_t *)realloc(tokenizer->base,
+                                   builder.size * sizeof(int32_t))) != NULL)
+    tokenizer->base = shrunk;
+  if ((shrunk = (int32_t *)realloc(tokenizer->check,
+                                   builder.size * sizeof(int32_t))) != NULL)
+    tokenizer->check = shrunk;
+  if ((shrunk = (int32_t *)realloc(tokenizer->value,
+                                   builder.size * sizeof(int32_t))) != NULL)
+    tokenizer->value = shrunk;
+  return 0;
+
+fail:
+  free(builder.base);
+  free(builder.check);
+  free(builder.value);
+  return -1;
+}
+
+/* ========================================================================== */
+/* Vocabulary files                                                           */
+/* ========================================================================== */
+
+/**
+ * @brief Read a whole file into a NUL-terminated buffer
+ */
+static char *read_file(const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return NULL;
+
+  char *buffer = NULL;
+  if (fseek(file, 0, SEEK_END) != 0)
+    goto done;
+  long size = ftell(file);
+  if (size < 0 || fseek(file, 0, SEEK_SET) != 0)
+    goto done;
+
+  buffer = (char *)malloc((size_t)size + 1);
+  if (buffer == NULL)
+    goto done;
+  if (fread(buffer, 1, (size_t)size, file) != (size_t)size) {
+    free(buffer);
+    buffer = NULL;
+    goto done;
+  }
+  buffer[size] = '\0';
+
+done:
+  fclose(file);
+  return buffer;
+}
+
+static int vocab_add(VocabList *vocab, const char *text, int length, int id) {
+  if (vocab->count == vocab->capacity) {
+    int capacity = vocab->capacity ? vocab->capacity * 2 : 32768;
+    VocabEntry *grown =
+        (VocabEntry *)realloc(vocab->entries, capacity * sizeof(VocabEntry));
+    if (grown == NULL)
+      return -1;
+    vocab->entries = grown;
+    vocab->capacity = capacity;
+  }
+  vocab->entries[vocab->count].text = text;
+  vocab->entries[vocab->count].length = length;
+  vocab->entries[vocab->count].id = id;
+  vocab->count++;
+  return 0;
+}
+
+/**
+ * @brief Parse vocab.txt in place (one token per line, ID = line number)
+ *
+ * vocab.txt carries no normalizer settings: the model is treated as uncased
+ * unless a regular token contains an uppercase ASCII letter.
+ */
+static int parse_vocab_txt(char *buffer, VocabList *vocab,
+                           TokenizerConfig *config) {
+  int id = 0;
+  int cased = 0;
+  char *line = buffer;
+
+  while (*line) {
+    char *end = strchr(line, '\n');
+    char *next = end ? end + 1 : line + strlen(line);
+    if (end == NULL)
+      end = line + strlen(line);
+    if (end > line && end[-1] == '\r')
+      end--;
+    *end = '\0';
+
+    int length = (int)(end - line);
+    if (length > 0) {
+      if (vocab_add(vocab, line, length, id) != 0)
+        return -1;
+      /* Special tokens such as [CLS] are uppercase in uncased vocabularies */
+      if (!cased && line[0] != '[') {
+        for (const char *p = line; *p; p++) {
+          if (*p >= 'A' && *p <= 'Z') {
+            cased = 1;
+            break;
+          }
+        }
+      }
+    }
+    id++;
+    line = next;
+  }
+
+  config->lowercase = !cased;
+  config->strip_accents = !cased;
+  return 0;
+}
+
+static const char *json_skip_ws(const char *p) {
+  while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+    p++;
+  return p;
+}
+
+/**
+ * @brief Skip a JSON string (p at the opening quote)
+ *
+ * @return Position after the closing quote, or NULL if unterminated
+ */
+static const char *json_skip_string(const char *p) {
+  for (p++; *p && *p != '"'; p++) {
+    if (*p == '\\' && *++p == '\0')
+      return NULL;
+  }
+  return *p ? p + 1 : NULL;
+}
+
+/**
+ * @brief Skip any JSON value
+ *
+ * @return Position after the value, or NULL if malformed
+ */
+static const char *json_skip_value(const char *p) {
+  p = json_skip_ws(p);
+  if (*p == '"')
+    return json_skip_string(p);
+
+  if (*p == '{' || *p == '[') {
+    int depth = 0;
+    while (*p) {
+      if (*p == '"') {
+        p = json_skip_string(p);
+        if (p == NULL)
+          return NULL;
+        continue;
+      }
+      if (*p == '{' || *p == '[') {
+        depth++;
+      } else if (*p == '}' || *p == ']') {
+        if (--depth == 0)
+          return p + 1;
+      }
+      p++;
+    }
+    return NULL;
+  }
+
+  /* Number, true, false or null */
+  const char *start = p;
+  while (*p && *p != ',' && *p != '}' && *p != ']' && *p != ' ' &&
+         *p != '\t' && *p != '\n' && *p != '\r')
+    p++;
+  return p > start ? p : NULL;
+}
+
+/**
+ * @brief Check whether the JSON string at p equals text (no escapes)
+ */
+static int json_string_equals(const char *p, const char *text) {
+  if (p == NULL || *p != '"')
+    return 0;
+  size_t length = strlen(text);
+  return strncmp(p + 1, text, length) == 0 && p[1 + length] == '"';
+}
+
+/**
+ * @brief Read a JSON boolean, or default_value for null / other values
+ */
+static int json_read_bool(const char *p, int default_value) {
+  if (p != NULL && strncmp(p, "true", 4) == 0)
+    return 1;
+  if (p != NULL && strncmp(p, "false", 5) == 0)
+    return 0;
+  return default_value;
+}
+
+/**
+ * @brief Find a member of a JSON object (not recursive)
+ *
+ * @param object Position of the opening brace
+ * @param key Member name (must not need escaping)
+ * @return Position of the member value, or NULL if absent / malformed
+ */
+static const char *json_find_key(const char *object, const char *key) {
+  const char *p = json_skip_ws(object);
+  if (*p != '{')
+    return NULL;
+  p = json_skip_ws(p + 1);
+
+  while (*p == '"') {
+    int match = json_string_equals(p, key);
+    p = json_skip_string(p);
+    if (p == NULL)
+      return NULL;
+    p = json_skip_ws(p);
+    if (*p != ':')
+      return NULL;
+    p = json_skip_ws(p + 1);
+    if (match)
+      return p;
+    p = json_skip_value(p);
+    if (p == NULL)
+      return NULL;
+    p = json_skip_ws(p);
+    if (*p == ',')
+      p = json_skip_ws(p + 1);
+  }
+  return NULL;
+}
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+static int32_t json_read_hex4(const char *p) {
+  int32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    int digit = hex_value(p[i]);
+    if (digit < 0)
+      return -1;
+    value = (value << 4) | digit;
+  }
+  return value;
+}
+
+/**
+ * @brief Decode a JSON string in place
+ *
+ * The decoded UTF-8 bytes are written over the string contents (decoding
+ * never grows a string) and NUL-terminated.
+ *
+ * @param p Position of the opening quote
+ * @param length Decoded length in bytes
+ * @return Position after the closing quote, or NULL if malformed
+ */
+static char *json_decode_string(char *p, int *length) {
+  char *in = p + 1;
+  unsigned char *out = (unsigned char *)p + 1;
+
+  while (*in && *in != '"') {
+    if (*in != '\\') {
+      *out++ = (unsigned char)*in++;
+      continue;
+    }
+    in++;
+    switch (*in) {
+    case '"':
+    case '\\':
+    case '/':
+      *out++ = (unsigned char)*in++;
+      break;
+    case 'b':
+      *out++ = '\b';
+      in++;
+      break;
+    case 'f':
+      *out++ = '\f';
+      in++;
+      break;
+    case 'n':
+      *out++ = '\n';
+      in++;
+      break;
+    case 'r':
+      *out++ = '\r';
+      in++;
+      break;
+    case 't':
+      *out++ = '\t';
+      in++;
+      break;
+    case 'u': {
+      int32_t cp = json_read_hex4(in + 1);
+      if (cp <= 0)
+        return NULL; /* Malformed, or embedded NUL */
+      in += 5;
+      if (cp >= 0xD800 && cp <= 0xDBFF) {
+        int32_t low = (in[0] == '\\' && in[1] == 'u') ? json_read_hex4(in + 2)
+                                                      : -1;
+        if (low < 0xDC00 || low > 0xDFFF)
+          return NULL;
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        in += 6;
+      }
+      /* A \uXXXX escape is 6 bytes, its UTF-8 form at most 4 */
+      out += encode_utf8((uint32_t)cp, out);
+      break;
+    }
+    default:
+      return NULL;
+    }
+  }
+  if (*in != '"')
+    return NULL;
+
+  *length = (int)((char *)out - (p + 1));
+  *out = '\0';
+  return in + 1;
+}
+
+/**
+ * @brief Copy a JSON string value into a fixed buffer
+ */
+static int json_copy_string(char *p, char *out, size_t out_size) {
+  int length = 0;
+  if (p == NULL || *p != '"' || json_decode_string(p, &length) == NULL ||
+      (size_t)length >= out_size)
+    return -1;
+  memcpy(out, p + 1, (size_t)length + 1);
+  return 0;
+}
+
+/**
+ * @brief Apply one tokenizer.json normalizer object to the config
+ */
+static void apply_json_normalizer(const char *normalizer,
+                                  TokenizerConfig *config) {
+  const char *type = json_find_key(normalizer, "type");
+
+  if (json_string_equals(type, "BertNormalizer")) {
+    config->lowercase =
+        json_read_bool(json_find_key(normalizer, "lowercase"), 1);
+    /* strip_accents: null means "same as lowercase" */
+    config->strip_accents = json_read_bool(
+        json_find_key(normalizer, "strip_accents"), config->lowercase);
+    config->handle_chinese_chars =
+        json_read_bool(json_find_key(normalizer, "handle_chinese_chars"), 1);
+  } else if (json_string_equals(type, "Lowercase")) {
+    config->lowercase = 1;
+  } else if (json_string_equals(type, "StripAccents")) {
+    config->strip_accents = 1;
+  } else if (json_string_equals(type, "Sequence")) {
+    const char *p = json_find_key(normalizer, "normalizers");
+    if (p == NULL || *p != '[')
+      return;
+    p = json_skip_ws(p + 1);
+    while (*p == '{') {
+      apply_json_normalizer(p, config);
+      p = json_skip_value(p);
+      if (p == NULL)
+        return;
+      p = json_skip_ws(p);
+      if (*p != ',')
+        return;
+      p = json_skip_ws(p + 1);
+    }
+  }
+}
+
+/**
+ * @brief Parse a Hugging Face tokenizer.json (WordPiece models only)
+ *
+ * Keys are decoded in place, so the vocabulary entries point into buffer.
+ */
+static int parse_tokenizer_json(char *buffer, VocabList *vocab,
+                                TokenizerConfig *config) {
+  const char *root = json_skip_ws(buffer);
+  const char *model = json_find_key(root, "model");
+  if (model == NULL || *model != '{')
+    return -1;
+  if (!json_string_equals(json_find_key(model, "type"), "WordPiece"))
+    return -1; /* BPE / Unigram / WordLevel are not supported */
+
+  /* No normalizer: text is used as-is, CJK characters are not split */
+  const char *normalizer = json_find_key(root, "normalizer");
+  config->lowercase = 0;
+  config->strip_accents = 0;
+  config->handle_chinese_chars = 0;
+  if (normalizer != NULL && *normalizer == '{')
+    apply_json_normalizer(normalizer, config);
+
+  const char *max_chars = json_find_key(model, "max_input_chars_per_word");
+  if (max_chars != NULL && *max_chars >= '0' && *max_chars <= '9')
+    config->max_word_chars = atoi(max_chars);
+
+  /* Locate everything before decoding strings in place */
+  char *unk = (char *)json_find_key(model, "unk_token");
+  char *prefix = (char *)json_find_key(model, "continuing_subword_prefix");
+  char *p = (char *)json_find_key(model, "vocab");
+  if (p == NULL || *p != '{')
+    return -1;
+
+  if (unk != NULL && *unk == '"' &&
+      json_copy_string(unk, config->unk_token, sizeof(config->unk_token)) != 0)
+    return -1;
+  if (prefix != NULL && *prefix == '"' &&
+      json_copy_string(prefix, config->continuation_prefix,
+                       sizeof(config->continuation_prefix)) != 0)
+    return -1;
+
+  p = (char *)json_skip_ws(p + 1);
+  while (*p == '"') {
+    char *text = p + 1;
+    int length = 0;
+    p = json_decode_string(p, &length);
+    if (p == NULL)
+      return -1;
+    p = (char *)json_skip_ws(p);
+    if (*p != ':')
+      return -1;
+    p = (char *)json_skip_ws(p + 1);
+
+    char *end = NULL;
+    long id = strtol(p, &end, 10);
+    if (end == p || id < 0 || id > INT32_MAX)
+      return -1;
+    if (length > 0 && vocab_add(vocab, text, length, (int)id) != 0)
+      return -1;
+
+    p = (char *)json_skip_ws(end);
+    if (*p == ',')
+      p = (char *)json_skip_ws(p + 1);
+  }
+  return *p == '}' ? 0 : -1;
+}
+
+/* ========================================================================== */
+/* Public API                                                                 */
+/* ========================================================================== */
+
+/**
+ * @brief Load a WordPiece tokenizer from vocab.txt or tokenizer.json
+ *
+ * @param path Path to the vocabulary file (format detected from contents)
+ * @return Tokenizer on success, NULL on error (file not found, unsupported
+ * tokenizer model, missing [CLS] / [SEP] / unknown token)
+ */
+fastembed_tokenizer_t *fastembed_tokenizer_load(const char *path) {
+  if (path == NULL)
+    return NULL;
+
+  char *buffer = read_file(path);
+  if (buffer == NULL)
+    return NULL;
+
+  fastembed_tokenizer_t *tokenizer =
+      (fastembed_tokenizer_t *)calloc(1, sizeof(fastembed_tokenizer_t));
+  VocabList vocab = {NULL, 0, 0};
+  TokenizerConfig config;
+  memset(&config, 0, sizeof(config));
+  config.handle_chinese_chars = 1;
+  config.max_word_chars = FASTEMBED_TOKENIZER_MAX_WORD_CHARS;
+  strcpy(config.unk_token, "[UNK]");
+  strcpy(config.continuation_prefix, "##");
+
+  if (tokenizer == NULL)
+    goto fail;
+
+  /* Skip a UTF-8 byte order mark */
+  char *contents = buffer;
+  if ((unsigned char)contents[0] == 0xEF &&
+      (unsigned char)contents[1] == 0xBB && (unsigned char)contents[2] == 0xBF)
+    contents += 3;
+
+  int parsed = (*json_skip_ws(contents) == '{')
+                   ? parse_tokenizer_json(contents, &vocab, &config)
+                   : parse_vocab_txt(contents, &vocab, &config);
+  if (parsed != 0 || build_trie(tokenizer, &vocab) != 0)
+    goto fail;
+
+  for (int i = 0; i < vocab.count; i++) {
+    if (vocab.entries[i].id >= tokenizer->vocab_size)
+      tokenizer->vocab_size = vocab.entries[i].id + 1;
+  }
+  tokenizer->lowercase = config.lowercase;
+  tokenizer->strip_accents = config.strip_accents;
+  tokenizer->handle_chinese_chars = config.handle_chinese_chars;
+  tokenizer->max_word_chars = config.max_word_chars > 0
+                                  ? config.max_word_chars
+                                  : FASTEMBED_TOKENIZER_MAX_WORD_CHARS;
+  tokenizer->continuation_root =
+      trie_walk(tokenizer, 0, config.continuation_prefix);
+
+  tokenizer->cls_id = fastembed_tokenizer_token_to_id(tokenizer, "[CLS]");
+  tokenizer->sep_id = fastembed_tokenizer_token_to_id(tokenizer, "[SEP]");
+  tokenizer->unk_id =
+      fastembed_tokenizer_token_to_id(tokenizer, config.unk_token);
+  tokenizer->pad_id = fastembed_tokenizer_token_to_id(tokenizer, "[PAD]");
+  if (tokenizer->pad_id < 0)
+    tokenizer->pad_id = FASTEMBED_PAD_TOKEN_ID;
+  if (tokenizer->cls_id < 0 || tokenizer->sep_id < 0 || tokenizer->unk_id < 0)
+    goto fail;
+
+  free(vocab.entries);
+  free(buffer);
+  return tokenizer;
+
+fail:
+  free(vocab.entries);
+  free(buffer);
+  fastembed_tokenizer_free(tokenizer);
+  return NULL;
+}
+
+/**
+ * @brief Free a tokenizer returned by fastembed_tokenizer_load()
+ */
+void fastembed_tokenizer_free(fastembed_tokenizer_t *tokenizer) {
+  if (tokenizer == NULL)
+    return;
+  free(tokenizer->base);
+  free(tokenizer->check);
+  free(tokenizer->value);
+  free(tokenizer);
+}
+
+/**
+ * @brief Look up the ID of a vocabulary token
+ *
+ * @return Token ID, or -1 if the token is not in the vocabulary
+ */
+int fastembed_tokenizer_token_to_id(const fastembed_tokenizer_t *tokenizer,
+                                    const char *token) {
+  if (tokenizer == NULL || token == NULL || tokenizer->trie_size == 0)
+    return -1;
+  int32_t node = trie_walk(tokenizer, 0, token);
+  return node >= 0 ? tokenizer->value[node] : -1;
+}
+
+/**
+ * @brief Get the vocabulary size (highest token ID + 1)
+ */
+int fastembed_tokenizer_get_vocab_size(const fastembed_tokenizer_t *tokenizer) {
+  return tokenizer ? tokenizer->vocab_size : -1;
+}
+
+/**
+ * @brief Get the padding token ID ([PAD], or FASTEMBED_PAD_TOKEN_ID)
+ */
+int fastembed_tokenizer_get_pad_id(const fastembed_tokenizer_t *tokenizer) {
+  return tokenizer ? tokenizer->pad_id : -1;
+}
+
+/**
+ * @brief Output cursor for encoded token IDs
+ *
+ * IDs beyond limit are dropped (truncation) but still matched, so a word
+ * that turns out to be unknown can be rolled back to [UNK].
+ */
+typedef struct {
+  int64_t *ids;
+  int count;
+  int limit;
+} TokenWriter;
+
+static inline void emit_token(TokenWriter *writer, int id) {
+  if (writer->count < writer->limit)
+    writer->ids[writer->count++] = id;
+}
+
+/**
+ * @brief Split one normalized word into WordPiece tokens
+ *
+ * Greedy longest-match-first: each piece is the longest vocabulary entry
+ * that prefixes the rest of the word (pieces after the first use the
+ * continuation prefix). If some position has no match, the whole word
+ * becomes the unknown token.
+ */
+static void emit_word(const fastembed_tokenizer_t *tokenizer,
+                      const unsigned char *word, int length,
+                      TokenWriter *writer) {
+  int start_count = writer->count;
+  int start = 0;
+
+  while (start < length) {
+    int32_t node = (start == 0) ? 0 : tokenizer->continuation_root;
+    int match_end = -1;
+    int match_id = -1;
+
+    for (int i = start; i < length && node >= 0; i++) {
+      node = trie_next(tokenizer, node, word[i]);
+      if (node >= 0 && tokenizer->value[node] >= 0) {
+        match_end = i + 1;
+        match_id = tokenizer->value[node];
+      }
+    }
+
+    if (match_end < 0) {
+      writer->count = start_count;
+      emit_token(writer, tokenizer->unk_id);
+      return;
+    }
+    emit_token(writer, match_id);
+    start = match_end;
+  }
+}
+
+/**
+ * @brief Emit the buffered word (if any) and reset the buffer
+ */
+static inline void flush_word(const fastembed_tokenizer_t *tokenizer,
+                              const unsigned char *word, int *length,
+                              int *chars, TokenWriter *writer) {
+  if (*chars == 0)
+    return;
+  if (*chars > tokenizer->max_word_chars || *length > WORD_BUFFER_SIZE)
+    emit_token(writer, tokenizer->unk_id);
+  else
+    emit_word(tokenizer, word, *length, writer);
+  *length = 0;
+  *chars = 0;
+}
+
+/**
+ * @brief Append a codepoint to the word buffer
+ */
+static inline void append_codepoint(unsigned char *word, int *length,
+                                    int *chars, uint32_t cp) {
+  if (*length + 4 <= WORD_BUFFER_SIZE)
+    *length += encode_utf8(cp, word + *length);
+  else
+    *length = WORD_BUFFER_SIZE + 1; /* Overflow marker: emitted as [UNK] */
+  (*chars)++;
+}
+
+/**
+ * @brief Tokenize text into model input IDs
+ *
+ * Produces [CLS] tokens... [SEP], truncated to max_length IDs.
+ *
+ * @param tokenizer Tokenizer returned by fastembed_tokenizer_load()
+ * @param text Input text (UTF-8, null-terminated)
+ * @param token_ids Output array (size >= max_length)
+ * @param max_length Maximum number of IDs including [CLS] and [SEP] (>= 2)
+ * @return Number of IDs written, or -1 on invalid arguments
+ */
+int fastembed_tokenizer_encode(const fastembed_tokenizer_t *tokenizer,
+                               const char *text, int64_t *token_ids,
+                               int max_length) {
+  if (tokenizer == NULL || text == NULL || token_ids == NULL ||
+      max_length < 2)
+    return -1;
+
+  TokenWriter writer = {token_ids, 0, max_length - 1}; /* Room for [SEP] */
+  emit_token(&writer, tokenizer->cls_id);
+
+  unsigned char word[WORD_BUFFER_SIZE];
+  int word_length = 0;
+  int word_chars = 0;
+  const int lowercase = tokenizer->lowercase;
+  const unsigned char *p = (const unsigned char *)text;
+
+  while (*p && writer.count < writer.limit) {
+    /* ASCII fast path */
+    if (*p < 0x80) {
+      unsigned char c = *p++;
+      unsigned char char_class = k_ascii_class[c];
+      if (char_class == CHAR_WORD) {
+        if (word_length < WORD_BUFFER_SIZE)
+          word[word_length++] =
+              (lowercase && c >= 'A' && c <= 'Z') ? (unsigned char)(c | 0x20)
+                                                  : c;
+        else
+          word_length = WORD_BUFFER_SIZE + 1;
+        word_chars++;
+      } else if (char_class == CHAR_SPACE) {
+        flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+      } else if (char_class == CHAR_PUNCT) {
+        flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+        word[0] = c;
+        word_length = 1;
+        word_chars = 1;
+        flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+      }
+      continue;
+    }
+
+    uint32_t cp;
+    p += decode_utf8(p, &cp);
+
+    if (cp == 0xFFFD || IN_TABLE(k_control_ranges, cp))
+      continue;
+    if (IN_TABLE(k_space_ranges, cp)) {
+      flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+      continue;
+    }
+    if ((tokenizer->handle_chinese_chars && is_cjk_ideograph(cp)) ||
+        IN_TABLE(k_punctuation_ranges, cp)) {
+      flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+      append_codepoint(word, &word_length, &word_chars, cp);
+      flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+      continue;
+    }
+
+    if (lowercase)
+      cp = to_lower(cp);
+    if (tokenizer->strip_accents) {
+      if (IN_TABLE(k_nonspacing_mark_ranges, cp))
+        continue;
+      if (cp >= 0xAC00 && cp <= 0xD7A3) {
+        /* Hangul syllables decompose into leading/vowel/trailing jamo */
+        uint32_t index = cp - 0xAC00;
+        append_codepoint(word, &word_length, &word_chars, 0x1100 + index / 588);
+        append_codepoint(word, &word_length, &word_chars,
+                         0x1161 + (index % 588) / 28);
+        if (index % 28 != 0)
+          append_codepoint(word, &word_length, &word_chars,
+                           0x11A7 + index % 28);
+        continue;
+      }
+      cp = strip_accent(cp);
+    }
+    append_codepoint(word, &word_length, &word_chars, cp);
+  }
+
+  if (writer.count < writer.limit)
+    flush_word(tokenizer, word, &word_length, &word_chars, &writer);
+
+  token_ids[writer.count++] = tokenizer->sep_id;
+  return writer.count;
+}
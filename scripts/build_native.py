@@ -186,6 +186,20 @@ def compile_c_files():
             subprocess.run(cmd_verbose, shell=True)
             return False
         
+        # Compile pure C sources (no ONNX Runtime dependency)
+        for extra_c_file in ("wordpiece_tokenizer.c", "similarity.c", "hnsw_index.c", "quantize.c", "thread_pool.c", "vector_store.c", "embedding_cache.c", "fastembed_stats.c"):
+            extra_c_path = SRC_DIR / extra_c_file
+            extra_obj_file = BUILD_DIR / extra_c_path.with_suffix(".obj").name
+            print(f"  {extra_c_path.name} -> {extra_obj_file.name}")
+            extra_cmd = f'call "{vcvars}" && cl /O2 /W3 /c /I"{INC_DIR}" /DFASTEMBED_BUILDING_LIB "{extra_c_path}" /Fo:"{extra_obj_file}"'
+            try:
+                subprocess.run(extra_cmd, shell=True, check=True, capture_output=True)
+            except subprocess.CalledProcessError as e:
+                print(f"❌ ERROR: Failed to compile {extra_c_path.name}")
+                if e.stderr:
+                    print(f"   Error: {e.stderr.decode()}")
+                return False
+        
         # Compile ONNX loader if ONNX Runtime is available
         if use_onnx:
             onnx_c_file = "onnx_embedding_loader.c"
@@ -233,6 +247,23 @@ def compile_c_files():
             print(f"❌ ERROR: Failed to compile {c_file}")
             return False
         
+        # Compile pure C sources (no ONNX Runtime dependency)
+        for extra_c_file in ("wordpiece_tokenizer.c", "similarity.c", "hnsw_index.c", "quantize.c", "thread_pool.c", "vector_store.c", "embedding_cache.c", "fastembed_stats.c"):
+            extra_c_path = SRC_DIR / extra_c_file
+            extra_obj_file = BUILD_DIR / extra_c_path.with_suffix(".o").name
+            print(f"  {extra_c_path.name} -> {extra_obj_file.name}")
+            try:
+                subprocess.run([
+                    gcc, "-O2", "-Wall", "-c",
+                    f"-I{INC_DIR}",
+                    "-DFASTEMBED_BUILDING_LIB",
+                    str(extra_c_path),
+                    "-o", str(extra_obj_file)
+                ], check=True)
+            except subprocess.CalledProcessError:
+                print(f"❌ ERROR: Failed to compile {extra_c_path.name}")
+                return False
+        
         # Compile ONNX loader if ONNX Runtime is available
         if use_onnx:
             onnx_c_file = "onnx_embedding_loader.c"
@@ -270,6 +301,14 @@ def link_library(use_onnx=False):
             BUILD_DIR / "embedding_lib.obj",
             BUILD_DIR / "embedding_generator.obj",
             BUILD_DIR / "embedding_lib_c.obj",
+            BUILD_DIR / "wordpiece_tokenizer.obj",
+            BUILD_DIR / "similarity.obj",
+            BUILD_DIR / "hnsw_index.obj",
+            BUILD_DIR / "quantize.obj",
+            BUILD_DIR / "thread_pool.obj",
+            BUILD_DIR / "vector_store.obj",
+            BUILD_DIR / "embedding_cache.obj",
+            BUILD_DIR / "fastembed_stats.obj",
         ]
         
         # Add ONNX loader object if ONNX Runtime is available
@@ -375,6 +414,14 @@ def link_library(use_onnx=False):
             BUILD_DIR / "embedding_lib.o",
             BUILD_DIR / "embedding_generator.o",
             BUILD_DIR / "embedding_lib_c.o",
+            BUILD_DIR / "wordpiece_tokenizer.o",
+            BUILD_DIR / "similarity.o",
+            BUILD_DIR / "hnsw_index.o",
+            BUILD_DIR / "quantize.o",
+            BUILD_DIR / "thread_pool.o",
+            BUILD_DIR / "vector_store.o",
+            BUILD_DIR / "embedding_cache.o",
+            BUILD_DIR / "fastembed_stats.o",
         ]
         
         cmd = [
@@ -382,7 +429,7 @@ def link_library(use_onnx=False):
             "-shared",
             "-o", str(dylib_file),
             *[str(obj) for obj in obj_files],
-            "-lm"
+            "-lm", "-lpthread"
         ]
         
         try:
@@ -399,6 +446,14 @@ def link_library(use_onnx=False):
             BUILD_DIR / "embedding_lib.o",
             BUILD_DIR / "embedding_generator.o",
             BUILD_DIR / "embedding_lib_c.o",
+            BUILD_DIR / "wordpiece_tokenizer.o",
+            BUILD_DIR / "similarity.o",
+            BUILD_DIR / "hnsw_index.o",
+            BUILD_DIR / "quantize.o",
+            BUILD_DIR / "thread_pool.o",
+            BUILD_DIR / "vector_store.o",
+            BUILD_DIR / "embedding_cache.o",
+            BUILD_DIR / "fastembed_stats.o",
         ]
         
         cmd = [
@@ -406,7 +461,7 @@ def link_library(use_onnx=False):
             "-shared",
             "-o", str(so_file),
             *[str(obj) for obj in obj_files],
-            "-lm"
+            "-lm", "-lpthread"
         ]
         
         try:
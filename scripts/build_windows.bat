@@ -328,6 +328,78 @@ if errorlevel 1 (
     exit /b 1
 )
 
+REM Compile WordPiece tokenizer (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling wordpiece_tokenizer.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\wordpiece_tokenizer.c" /Fo:"!BUILD_DIR!\wordpiece_tokenizer.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile wordpiece_tokenizer.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\wordpiece_tokenizer.c" /Fo:"!BUILD_DIR!\wordpiece_tokenizer.obj"
+    exit /b 1
+)
+
+REM Compile batched similarity (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling similarity.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\similarity.c" /Fo:"!BUILD_DIR!\similarity.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile similarity.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\similarity.c" /Fo:"!BUILD_DIR!\similarity.obj"
+    exit /b 1
+)
+
+REM Compile HNSW index (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling hnsw_index.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\hnsw_index.c" /Fo:"!BUILD_DIR!\hnsw_index.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile hnsw_index.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\hnsw_index.c" /Fo:"!BUILD_DIR!\hnsw_index.obj"
+    exit /b 1
+)
+
+REM Compile quantization kernels (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling quantize.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\quantize.c" /Fo:"!BUILD_DIR!\quantize.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile quantize.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\quantize.c" /Fo:"!BUILD_DIR!\quantize.obj"
+    exit /b 1
+)
+
+REM Compile the batch thread pool (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling thread_pool.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\thread_pool.c" /Fo:"!BUILD_DIR!\thread_pool.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile thread_pool.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\thread_pool.c" /Fo:"!BUILD_DIR!\thread_pool.obj"
+    exit /b 1
+)
+
+REM Compile the embedding store (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling vector_store.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\vector_store.c" /Fo:"!BUILD_DIR!\vector_store.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile vector_store.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\vector_store.c" /Fo:"!BUILD_DIR!\vector_store.obj"
+    exit /b 1
+)
+
+REM Compile the embedding cache (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling embedding_cache.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\embedding_cache.c" /Fo:"!BUILD_DIR!\embedding_cache.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile embedding_cache.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\embedding_cache.c" /Fo:"!BUILD_DIR!\embedding_cache.obj"
+    exit /b 1
+)
+
+REM Compile the instrumentation statistics (pure C, no ONNX Runtime dependency)
+echo [INFO] Compiling fastembed_stats.c...
+cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\fastembed_stats.c" /Fo:"!BUILD_DIR!\fastembed_stats.obj" >nul 2>&1
+if errorlevel 1 (
+    echo [ERROR] Failed to compile fastembed_stats.c
+    cl /O2 /W3 /c /I"!INC_DIR!" /DFASTEMBED_BUILDING_LIB "!SRC_DIR!\fastembed_stats.c" /Fo:"!BUILD_DIR!\fastembed_stats.obj"
+    exit /b 1
+)
+
 REM Compile ONNX loader if ONNX Runtime is available
 if "!USE_ONNX!"=="1" (
     echo [INFO] Compiling onnx_embedding_loader.c with ONNX Runtime support...
@@ -346,7 +418,7 @@ echo Linking DLL...
 echo ========================================
 
 REM Build link command with ONNX support if available
-set "LINK_OBJS=!BUILD_DIR!\embedding_lib.obj !BUILD_DIR!\embedding_generator.obj !BUILD_DIR!\embedding_lib_c.obj"
+set "LINK_OBJS=!BUILD_DIR!\embedding_lib.obj !BUILD_DIR!\embedding_generator.obj !BUILD_DIR!\embedding_lib_c.obj !BUILD_DIR!\wordpiece_tokenizer.obj !BUILD_DIR!\similarity.obj !BUILD_DIR!\hnsw_index.obj !BUILD_DIR!\quantize.obj !BUILD_DIR!\thread_pool.obj !BUILD_DIR!\vector_store.obj !BUILD_DIR!\embedding_cache.obj !BUILD_DIR!\fastembed_stats.obj"
 set "LINK_LIBS=msvcrt.lib"
 set "LINK_LIBPATHS=/LIBPATH:"!VCToolsInstallDir!lib\x64""
 
@@ -384,7 +384,7 @@ function Invoke-CCompilation {
     
     Write-SectionHeader 'Compiling C Sources'
     
-    $cFiles = @('embedding_lib_c.c', 'onnx_embedding_loader.c')
+    $cFiles = @('embedding_lib_c.c', 'wordpiece_tokenizer.c', 'similarity.c', 'hnsw_index.c', 'quantize.c', 'thread_pool.c', 'vector_store.c', 'embedding_cache.c', 'fastembed_stats.c', 'onnx_embedding_loader.c')
     
     foreach ($file in $cFiles) {
         $srcPath = Join-Path $SourceDir $file
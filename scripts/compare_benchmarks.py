@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+Compare two FastEmbed benchmark suite reports
+
+Purpose:
+    Matches the cases of two benchmark_suite JSON reports (same operation,
+    kernel, dimension, batch, threads, text length and corpus) and fails
+    if any case got slower than the tolerance allows. Intended as a gate
+    for compiler, ONNX Runtime or library upgrades.
+
+Usage:
+    python scripts/compare_benchmarks.py baseline.json current.json
+    python scripts/compare_benchmarks.py baseline.json current.json --tolerance 0.05
+    python scripts/compare_benchmarks.py baseline.json current.json --metric p99_ns
+
+Requirements:
+    - Python 3.6+
+
+Exit Codes:
+    0 - No regression
+    1 - At least one case regressed (or a baseline case is missing)
+    2 - Invalid input (unreadable file, wrong schema)
+
+Author:
+    FastEmbed Team
+"""
+
+import sys
+import json
+import argparse
+from typing import Dict, Tuple
+
+SCHEMA_VERSION = 1
+KEY_FIELDS = ("op", "kernel", "dimension", "batch", "threads", "text_bytes",
+              "corpus")
+METRICS = ("p50_ns", "p99_ns", "mean_ns")
+
+
+def load_report(path: str) -> Dict[Tuple, dict]:
+    """Load a report and index its results by case key."""
+    try:
+        with open(path, "r", encoding="utf-8") as f:
+            report = json.load(f)
+    except (OSError, ValueError) as e:
+        print(f"[ERROR] Cannot read {path}: {e}", file=sys.stderr)
+        sys.exit(2)
+    if report.get("schema") != SCHEMA_VERSION:
+        print(f"[ERROR] {path}: unsupported schema {report.get('schema')}",
+              file=sys.stderr)
+        sys.exit(2)
+    return {tuple(r[k] for k in KEY_FIELDS): r for r in report["results"]}
+
+
+def describe(key: Tuple) -> str:
+    case = dict(zip(KEY_FIELDS, key))
+    text = (f"{case['op']:<18} {case['kernel']:<7} d={case['dimension']:<5} "
+            f"batch={case['batch']:<5} threads={case['threads']:<2}")
+    if case["text_bytes"]:
+        text += f" text={case['text_bytes']}"
+    if case["corpus"]:
+        text += f" corpus={case['corpus']}"
+    return text
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description="Fail if a benchmark suite report regressed")
+    parser.add_argument("baseline", help="Baseline report (benchmark_suite --json)")
+    parser.add_argument("current", help="Report to check")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="Allowed slowdown as a fraction (default 0.10)")
+    parser.add_argument("--metric", choices=METRICS, default="p50_ns",
+                        help="Latency compared per case (default p50_ns)")
+    parser.add_argument("--allow-missing", action="store_true",
+                        help="Do not fail on baseline cases absent from current")
+    parser.add_argument("--verbose", action="store_true",
+                        help="Also list cases within tolerance")
+    args = parser.parse_args()
+
+    baseline = load_report(args.baseline)
+    current = load_report(args.current)
+
+    regressions = 0
+    improvements = 0
+    missing = 0
+    for key, base in sorted(baseline.items()):
+        cur = current.get(key)
+        if cur is None:
+            missing += 1
+            print(f"[WARN]  missing    {describe(key)}")
+            continue
+        before = base[args.metric]
+        after = cur[args.metric]
+        change = (after - before) / before if before > 0 else 0.0
+        line = (f"{describe(key)}  {before:12.0f} -> {after:12.0f} ns "
+                f"({change:+.1%})")
+        if change > args.tolerance:
+            regressions += 1
+            print(f"[ERROR] regression {line}")
+        elif change < -args.tolerance:
+            improvements += 1
+            print(f"[INFO]  faster     {line}")
+        elif args.verbose:
+            print(f"[INFO]  ok         {line}")
+
+    new_cases = len(set(current) - set(baseline))
+    print(f"\n{len(baseline)} baseline cases: {regressions} regressed, "
+          f"{improvements} faster, {missing} missing, {new_cases} new "
+          f"({args.metric}, tolerance {args.tolerance:.0%})")
+
+    if regressions > 0 or (missing > 0 and not args.allow_missing):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except KeyboardInterrupt:
+        print("\n[WARN] Interrupted", file=sys.stderr)
+        sys.exit(130)
@@ -0,0 +1,830 @@
+/**
+ * FastEmbed Benchmark Suite
+ *
+ * Throughput / latency matrix over the public API:
+ * - Hash embeddings: dimension x text length, and parallel batches over
+ *   batch size x thread count
+ * - Vector operations (dot, cosine, norm, normalize, add): dimension x
+ *   SIMD kernel
+ * - Similarity matrix and top-k: dimension x kernel x thread count
+ * - ONNX end to end (with --model): batch size x text length x threads,
+ *   plus a corpus-sized batch through the thread pool and the pipeline
+ *
+ * Every case is warmed up, then timed in samples on a monotonic clock;
+ * each sample repeats the call enough times to be well above the clock
+ * resolution. Reported per case: p50 / p99 / mean latency of one call and
+ * items per second. --json writes the same as a machine-readable report
+ * for scripts/compare_benchmarks.py.
+ *
+ * Usage: benchmark_suite [--quick] [--json FILE] [--filter OP] [--pin]
+ *                        [--model PATH] [--min-time MS]
+ *
+ * Compile: gcc -O2 -o benchmark_suite benchmark_suite.c -L../build
+ * -lfastembed -lm -lpthread -I../include
+ * Run: LD_LIBRARY_PATH=.. ./benchmark_suite --json results.json
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* sched_setaffinity() */
+#endif
+
+#include "fastembed.h"
+#include "fastembed_config.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_MAX_SAMPLES 2000
+#define BENCH_MIN_SAMPLES 30
+#define BENCH_SAMPLE_NS 20000.0       /* Target duration of one sample */
+#define BENCH_CORPUS_FLOATS (1 << 22) /* 16 MiB corpus per dimension */
+#define BENCH_QUERIES 16
+#define BENCH_TOPK 10
+#define BENCH_MAX_THREAD_COUNTS 8
+#define BENCH_MAX_KERNELS 5
+
+static const int k_dimensions[] = {128, 256, 512, 768, 1024, 2048};
+static const int k_quick_dimensions[] = {128, 768};
+static const int k_text_bytes[] = {16, 128, 1024, 4096};
+static const int k_quick_text_bytes[] = {16, 1024};
+static const int k_batch_sizes[] = {16, 256, 1024};
+#ifdef USE_ONNX_RUNTIME
+static const int k_onnx_batch_sizes[] = {1, 8, 32};
+/* Corpus-sized batch for the pipelined vs. parallel comparison */
+#define ONNX_CORPUS_TEXTS (2 * FASTEMBED_PIPELINE_WINDOW)
+#endif
+
+static const char *k_words[] = {
+    "fast",     "embedding", "vector", "search", "native", "library",
+    "semantic", "query",     "index",  "model",  "token",  "batch"};
+
+/* ------------------------------------------------------------------------ */
+/* Configuration and results                                                */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+  int quick;
+  int pin;
+  double min_time_ns;
+  double warmup_ns;
+  const char *json_path;
+  const char *filter;
+  const char *model_path;
+} bench_config_t;
+
+/** One benchmark case */
+typedef struct {
+  const char *op;
+  const char *kernel;
+  int dimension;
+  int batch;      /* Items per call (texts, vectors or queries) */
+  int threads;    /* Thread argument of the call */
+  int text_bytes; /* 0 if not a text operation */
+  int corpus;     /* Corpus rows, 0 if not a search operation */
+  double items;   /* Items counted per call for items_per_s */
+} bench_case_t;
+
+typedef struct {
+  bench_case_t c;
+  int samples;
+  uint64_t calls;
+  double p50_ns;
+  double p99_ns;
+  double mean_ns;
+  double items_per_s;
+} bench_result_t;
+
+typedef int (*bench_fn)(void *ctx);
+
+static bench_config_t g_config;
+static bench_result_t *g_results = NULL;
+static int g_num_results = 0;
+static int g_capacity_results = 0;
+static int g_failures = 0;
+
+/* ------------------------------------------------------------------------ */
+/* Timing                                                                    */
+/* ------------------------------------------------------------------------ */
+
+/** Monotonic clock in nanoseconds */
+static double now_ns(void) {
+#ifdef _WIN32
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+/** Pin the calling thread to logical CPU 0 (best effort) */
+static int pin_main_thread(void) {
+#if defined(_WIN32)
+  return SetThreadAffinityMask(GetCurrentThread(), 1) != 0 ? 0 : -1;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(0, &set);
+  return sched_setaffinity(0, sizeof(set), &set);
+#else
+  return -1; /* macOS has no affinity API */
+#endif
+}
+
+static int compare_doubles(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/** Nearest-rank percentile of sorted values */
+static double percentile(const double *sorted, int count, double fraction) {
+  int rank = (int)(fraction * count + 0.999999);
+  if (rank < 1)
+    rank = 1;
+  if (rank > count)
+    rank = count;
+  return sorted[rank - 1];
+}
+
+/**
+ * Warm up and time fn, appending a result for c
+ *
+ * Each sample runs fn reps times (reps calibrated during warmup so that a
+ * sample lasts about BENCH_SAMPLE_NS); sampling stops after min_time_ns
+ * and at least BENCH_MIN_SAMPLES samples.
+ */
+static void bench_run(const bench_case_t *c, bench_fn fn, void *ctx) {
+  if (g_config.filter && strstr(c->op, g_config.filter) == NULL)
+    return;
+
+  /* Warmup, also measuring the cost of one call */
+  uint64_t warm_calls = 0;
+  double start = now_ns();
+  double elapsed = 0.0;
+  do {
+    if (fn(ctx) != 0) {
+      printf("  ✗ %-18s d=%-5d batch=%-5d threads=%-2d FAILED\n", c->op,
+             c->dimension, c->batch, c->threads);
+      g_failures++;
+      return;
+    }
+    warm_calls++;
+    elapsed = now_ns() - start;
+  } while (elapsed < g_config.warmup_ns);
+
+  double call_ns = elapsed / (double)warm_calls;
+  uint64_t reps = call_ns > 0.0 ? (uint64_t)(BENCH_SAMPLE_NS / call_ns) : 1;
+  if (reps < 1)
+    reps = 1;
+
+  static double samples[BENCH_MAX_SAMPLES];
+  int count = 0;
+  double total_ns = 0.0;
+  while (count < BENCH_MAX_SAMPLES &&
+         (count < BENCH_MIN_SAMPLES || total_ns < g_config.min_time_ns)) {
+    double t0 = now_ns();
+    for (uint64_t r = 0; r < reps; r++)
+      fn(ctx);
+    double sample_ns = now_ns() - t0;
+    total_ns += sample_ns;
+    samples[count++] = sample_ns / (double)reps;
+  }
+  qsort(samples, count, sizeof(double), compare_doubles);
+
+  if (g_num_results == g_capacity_results) {
+    int capacity = g_capacity_results ? g_capacity_results * 2 : 256;
+    bench_result_t *grown = (bench_result_t *)realloc(
+        g_results, (size_t)capacity * sizeof(bench_result_t));
+    if (grown == NULL) {
+      g_failures++;
+      return;
+    }
+    g_results = grown;
+    g_capacity_results = capacity;
+  }
+  bench_result_t *r = &g_results[g_num_results++];
+  r->c = *c;
+  r->samples = count;
+  r->calls = (uint64_t)count * reps;
+  r->p50_ns = percentile(samples, count, 0.50);
+  r->p99_ns = percentile(samples, count, 0.99);
+  r->mean_ns = total_ns / (double)r->calls;
+  r->items_per_s = c->items * (double)r->calls * 1e9 / total_ns;
+
+  printf("  %-18s %-7s d=%-5d batch=%-5d threads=%-2d", c->op, c->kernel,
+         c->dimension, c->batch, c->threads);
+  if (c->text_bytes > 0)
+    printf(" text=%-5d", c->text_bytes);
+  if (c->corpus > 0)
+    printf(" corpus=%-6d", c->corpus);
+  printf(" p50 %10.0f ns  p99 %10.0f ns  %12.0f items/s\n", r->p50_ns,
+         r->p99_ns, r->items_per_s);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Inputs                                                                    */
+/* ------------------------------------------------------------------------ */
+
+/** Deterministic text of exactly length bytes (words from k_words) */
+static char *make_text(int length, unsigned seed) {
+  char *text = (char *)malloc((size_t)length + 1);
+  if (text == NULL)
+    return NULL;
+  int pos = 0;
+  int num_words = (int)(sizeof(k_words) / sizeof(k_words[0]));
+  while (pos < length) {
+    seed = seed * 1103515245u + 12345u;
+    const char *word = k_words[(seed >> 16) % (unsigned)num_words];
+    for (const char *p = word; *p && pos < length; p++)
+      text[pos++] = *p;
+    if (pos < length)
+      text[pos++] = ' ';
+  }
+  if (length > 0 && text[length - 1] == ' ')
+    text[length - 1] = 'x';
+  text[length] = '\0';
+  return text;
+}
+
+/** Deterministic L2-normalized vectors */
+static void fill_vectors(float *vectors, size_t count, int dimension,
+                         unsigned seed) {
+  for (size_t i = 0; i < count * (size_t)dimension; i++) {
+    seed = seed * 1103515245u + 12345u;
+    vectors[i] = (float)((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+  }
+  for (size_t i = 0; i < count; i++)
+    fastembed_normalize(vectors + i * dimension, dimension);
+}
+
+static const char *kernel_name(int level) {
+  switch (level) {
+  case FASTEMBED_SIMD_SCALAR:
+    return "scalar";
+  case FASTEMBED_SIMD_SSE:
+    return "sse";
+  case FASTEMBED_SIMD_NEON:
+    return "neon";
+  case FASTEMBED_SIMD_AVX2:
+    return "avx2";
+  case FASTEMBED_SIMD_AVX512:
+    return "avx512";
+  default:
+    return "unknown";
+  }
+}
+
+/** SIMD levels that can be installed on this CPU and build */
+static int available_kernels(int *levels) {
+  int count = 0;
+  int best = fastembed_get_simd_level();
+  for (int level = FASTEMBED_SIMD_SCALAR; level <= FASTEMBED_SIMD_AVX512;
+       level++) {
+    if (level <= best && fastembed_set_simd_level(level) == level)
+      levels[count++] = level;
+  }
+  fastembed_set_simd_level(FASTEMBED_SIMD_AVX512); /* Automatic selection */
+  if (count == 0)
+    levels[count++] = best;
+  return count;
+}
+
+/** 1, 2, 4, ... up to the pool size, and the pool size itself */
+static int thread_counts(int *counts) {
+  int pool = fastembed_thread_pool_get_size();
+  int count = 0;
+  for (int t = 1; t < pool && count < BENCH_MAX_THREAD_COUNTS - 1; t *= 2)
+    counts[count++] = t;
+  counts[count++] = pool > 0 ? pool : 1;
+  return count;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Cases                                                                     */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+  const char **texts;
+  float **outputs;
+  float *a;
+  float *b;
+  float *out;
+  float *corpus;
+  int *ids;
+  float *scores;
+  int count;
+  int dimension;
+  int corpus_rows;
+  int threads;
+  float sink;
+#ifdef USE_ONNX_RUNTIME
+  fastembed_model_t *model;
+#endif
+} bench_ctx_t;
+
+static int run_generate(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  return fastembed_generate(ctx->texts[0], ctx->outputs[0], ctx->dimension);
+}
+
+static int run_batch_generate(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  return fastembed_batch_generate_parallel(ctx->texts, ctx->count,
+                                           ctx->outputs, ctx->dimension, NULL,
+                                           ctx->threads) == 0
+             ? 0
+             : -1;
+}
+
+static int run_dot(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  ctx->sink += fastembed_dot_product(ctx->a, ctx->b, ctx->dimension);
+  return 0;
+}
+
+static int run_cosine(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  ctx->sink += fastembed_cosine_similarity(ctx->a, ctx->b, ctx->dimension);
+  return 0;
+}
+
+static int run_norm(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  ctx->sink += fastembed_vector_norm(ctx->a, ctx->dimension);
+  return 0;
+}
+
+static int run_normalize(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  fastembed_normalize(ctx->out, ctx->dimension);
+  return 0;
+}
+
+static int run_add(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  fastembed_add_vectors(ctx->a, ctx->b, ctx->out, ctx->dimension);
+  return 0;
+}
+
+static int run_similarity_matrix(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  return fastembed_similarity_matrix_threaded(
+      ctx->a, ctx->count, ctx->corpus, ctx->corpus_rows, ctx->dimension,
+      ctx->out, FASTEMBED_METRIC_DOT, ctx->threads);
+}
+
+static int run_topk(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  return fastembed_topk_threaded(ctx->a, ctx->corpus, ctx->corpus_rows,
+                                 ctx->dimension, BENCH_TOPK, ctx->ids,
+                                 ctx->scores, FASTEMBED_METRIC_DOT,
+                                 ctx->threads) == BENCH_TOPK
+             ? 0
+             : -1;
+}
+
+static float **alloc_outputs(int count, int dimension) {
+  float **outputs = (float **)calloc((size_t)count, sizeof(float *));
+  float *block = (float *)calloc((size_t)count * dimension, sizeof(float));
+  if (outputs == NULL || block == NULL) {
+    free(outputs);
+    free(block);
+    return NULL;
+  }
+  for (int i = 0; i < count; i++)
+    outputs[i] = block + (size_t)i * dimension;
+  return outputs;
+}
+
+static void free_outputs(float **outputs) {
+  if (outputs != NULL)
+    free(outputs[0]);
+  free(outputs);
+}
+
+/** Texts of one length, count of them (distinct seeds) */
+static const char **make_texts(int count, int length) {
+  const char **texts = (const char **)calloc((size_t)count, sizeof(char *));
+  for (int i = 0; texts && i < count; i++) {
+    texts[i] = make_text(length, (unsigned)i * 7919u + (unsigned)length);
+    if (texts[i] == NULL) {
+      for (int j = 0; j < i; j++)
+        free((void *)texts[j]);
+      free(texts);
+      return NULL;
+    }
+  }
+  return texts;
+}
+
+static void free_texts(const char **texts, int count) {
+  if (texts == NULL)
+    return;
+  for (int i = 0; i < count; i++)
+    free((void *)texts[i]);
+  free(texts);
+}
+
+static void bench_hash(const int *dims, int num_dims, const int *lengths,
+                       int num_lengths, const int *threads, int num_threads) {
+  const char *kernel = kernel_name(fastembed_get_simd_level());
+  printf("\n=== Hash embeddings ===\n");
+
+  for (int l = 0; l < num_lengths; l++) {
+    const char **texts = make_texts(1, lengths[l]);
+    float **outputs = alloc_outputs(1, 2048);
+    if (texts && outputs) {
+      for (int d = 0; d < num_dims; d++) {
+        bench_ctx_t ctx = {0};
+        ctx.texts = texts;
+        ctx.outputs = outputs;
+        ctx.dimension = dims[d];
+        bench_case_t c = {"generate", kernel, dims[d], 1, 1, lengths[l], 0,
+                          1.0};
+        bench_run(&c, run_generate, &ctx);
+      }
+    }
+    free_texts(texts, 1);
+    free_outputs(outputs);
+  }
+
+  int max_batch = k_batch_sizes[sizeof(k_batch_sizes) / sizeof(int) - 1];
+  const char **texts = make_texts(max_batch, 128);
+  float **outputs = alloc_outputs(max_batch, 768);
+  if (texts && outputs) {
+    for (size_t b = 0; b < sizeof(k_batch_sizes) / sizeof(int); b++) {
+      for (int t = 0; t < num_threads; t++) {
+        bench_ctx_t ctx = {0};
+        ctx.texts = texts;
+        ctx.outputs = outputs;
+        ctx.count = k_batch_sizes[b];
+        ctx.dimension = 768;
+        ctx.threads = threads[t];
+        bench_case_t c = {"batch_generate", kernel,     768,
+                          k_batch_sizes[b], threads[t], 128,
+                          0,                (double)k_batch_sizes[b]};
+        bench_run(&c, run_batch_generate, &ctx);
+      }
+    }
+  }
+  free_texts(texts, max_batch);
+  free_outputs(outputs);
+}
+
+static void bench_vectors(const int *dims, int num_dims, const int *kernels,
+                          int num_kernels, const int *threads,
+                          int num_threads) {
+  static const struct {
+    const char *op;
+    bench_fn fn;
+  } k_ops[] = {{"dot", run_dot},
+               {"cosine", run_cosine},
+               {"norm", run_norm},
+               {"normalize", run_normalize},
+               {"add", run_add}};
+
+  printf("\n=== Vector operations, similarity matrix and top-k ===\n");
+  for (int d = 0; d < num_dims; d++) {
+    int dimension = dims[d];
+    int corpus_rows = BENCH_CORPUS_FLOATS / dimension;
+    size_t out_floats = (size_t)BENCH_QUERIES * corpus_rows;
+    if (out_floats < (size_t)dimension)
+      out_floats = (size_t)dimension;
+
+    float *a = fastembed_alloc_matrix(BENCH_QUERIES, dimension);
+    float *b = fastembed_alloc_matrix(1, dimension);
+    float *corpus = fastembed_alloc_matrix(corpus_rows, dimension);
+    float *out = (float *)calloc(out_floats, sizeof(float));
+    int ids[BENCH_TOPK];
+    float scores[BENCH_TOPK];
+    if (!a || !b || !corpus || !out) {
+      printf("  ✗ Allocation failed for d=%d\n", dimension);
+      g_failures++;
+      fastembed_free_matrix(a);
+      fastembed_free_matrix(b);
+      fastembed_free_matrix(corpus);
+      free(out);
+      continue;
+    }
+    fill_vectors(a, BENCH_QUERIES, dimension, 1u);
+    fill_vectors(b, 1, dimension, 2u);
+    fill_vectors(corpus, (size_t)corpus_rows, dimension, 3u);
+    memcpy(out, a, (size_t)dimension * sizeof(float));
+
+    for (int k = 0; k < num_kernels; k++) {
+      fastembed_set_simd_level(kernels[k]);
+      const char *kernel = kernel_name(kernels[k]);
+
+      bench_ctx_t ctx = {0};
+      ctx.a = a;
+      ctx.b = b;
+      ctx.out = out;
+      ctx.corpus = corpus;
+      ctx.ids = ids;
+      ctx.scores = scores;
+      ctx.dimension = dimension;
+      ctx.corpus_rows = corpus_rows;
+
+      for (size_t o = 0; o < sizeof(k_ops) / sizeof(k_ops[0]); o++) {
+        bench_case_t c = {k_ops[o].op, kernel, dimension, 1, 1, 0, 0, 1.0};
+        bench_run(&c, k_ops[o].fn, &ctx);
+      }
+      for (int t = 0; t < num_threads; t++) {
+        ctx.threads = threads[t];
+        ctx.count = BENCH_QUERIES;
+        bench_case_t matrix = {"similarity_matrix",
+                               kernel,
+                               dimension,
+                               BENCH_QUERIES,
+                               threads[t],
+                               0,
+                               corpus_rows,
+                               (double)BENCH_QUERIES * corpus_rows};
+        bench_run(&matrix, run_similarity_matrix, &ctx);
+
+        bench_case_t topk = {"topk", kernel,      dimension, 1,
+                             threads[t], 0,       corpus_rows,
+                             (double)corpus_rows};
+        bench_run(&topk, run_topk, &ctx);
+      }
+    }
+    fastembed_set_simd_level(FASTEMBED_SIMD_AVX512);
+
+    fastembed_free_matrix(a);
+    fastembed_free_matrix(b);
+    fastembed_free_matrix(corpus);
+    free(out);
+  }
+}
+
+#ifdef USE_ONNX_RUNTIME
+static int run_onnx(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  if (ctx->threads == 1)
+    return fastembed_model_batch_generate(ctx->model, ctx->texts, ctx->count,
+                                          ctx->outputs, ctx->dimension);
+  return fastembed_model_batch_generate_parallel(
+             ctx->model, ctx->texts, ctx->count, ctx->outputs,
+             ctx->dimension, NULL, ctx->threads) == 0
+             ? 0
+             : -1;
+}
+
+static int run_onnx_pipelined(void *p) {
+  bench_ctx_t *ctx = (bench_ctx_t *)p;
+  fastembed_pipeline_options_t options;
+  fastembed_pipeline_options_init(&options);
+  options.inference_threads = ctx->threads;
+  options.output = ctx->out;
+  return fastembed_model_batch_generate_pipelined(
+             ctx->model, ctx->texts, ctx->count, ctx->dimension, NULL,
+             &options) == 0
+             ? 0
+             : -1;
+}
+
+static void bench_onnx(const int *lengths, int num_lengths,
+                       const int *threads, int num_threads) {
+  printf("\n=== ONNX end to end ===\n");
+  if (g_config.model_path == NULL) {
+    printf("  ⚠ SKIP: pass --model PATH to benchmark ONNX inference\n");
+    return;
+  }
+  double load_start = now_ns();
+  fastembed_model_t *model = fastembed_model_open(g_config.model_path);
+  double load_ns = now_ns() - load_start;
+  if (model == NULL) {
+    char error[512];
+    fastembed_onnx_get_last_error(error, sizeof(error));
+    printf("  ✗ Failed to open %s: %s\n", g_config.model_path, error);
+    g_failures++;
+    return;
+  }
+  int dimension = fastembed_model_get_dimension(model);
+  const char *kernel = kernel_name(fastembed_get_simd_level());
+  printf("  Model load: %.1f ms, dimension %d\n", load_ns / 1e6, dimension);
+
+  int max_batch =
+      k_onnx_batch_sizes[sizeof(k_onnx_batch_sizes) / sizeof(int) - 1];
+  float **outputs = alloc_outputs(max_batch, dimension);
+  for (int l = 0; outputs && l < num_lengths; l++) {
+    const char **texts = make_texts(max_batch, lengths[l]);
+    if (texts == NULL)
+      break;
+    for (size_t b = 0; b < sizeof(k_onnx_batch_sizes) / sizeof(int); b++) {
+      for (int t = 0; t < num_threads; t++) {
+        if (threads[t] > k_onnx_batch_sizes[b])
+          continue;
+        bench_ctx_t ctx = {0};
+        ctx.model = model;
+        ctx.texts = texts;
+        ctx.outputs = outputs;
+        ctx.count = k_onnx_batch_sizes[b];
+        ctx.dimension = dimension;
+        ctx.threads = threads[t];
+        bench_case_t c = {"onnx_generate",       kernel,     dimension,
+                          k_onnx_batch_sizes[b], threads[t], lengths[l],
+                          0,                     (double)k_onnx_batch_sizes[b]};
+        bench_run(&c, run_onnx, &ctx);
+      }
+    }
+    free_texts(texts, max_batch);
+  }
+  free_outputs(outputs);
+
+  /* Whole corpus: thread-pool batches vs. overlapped pipeline stages */
+  outputs = alloc_outputs(ONNX_CORPUS_TEXTS, dimension);
+  float *matrix = (float *)malloc((size_t)ONNX_CORPUS_TEXTS * dimension *
+                                  sizeof(float));
+  for (int l = 0; outputs && matrix && l < num_lengths; l++) {
+    const char **texts = make_texts(ONNX_CORPUS_TEXTS, lengths[l]);
+    if (texts == NULL)
+      break;
+    for (int t = 0; t < num_threads; t++) {
+      if (threads[t] > FASTEMBED_PIPELINE_MAX_THREADS)
+        continue;
+      bench_ctx_t ctx = {0};
+      ctx.model = model;
+      ctx.texts = texts;
+      ctx.outputs = outputs;
+      ctx.out = matrix;
+      ctx.count = ONNX_CORPUS_TEXTS;
+      ctx.dimension = dimension;
+      ctx.threads = threads[t];
+      bench_case_t c = {"onnx_generate",   kernel,     dimension,
+                        ONNX_CORPUS_TEXTS, threads[t], lengths[l],
+                        0,                 (double)ONNX_CORPUS_TEXTS};
+      bench_run(&c, run_onnx, &ctx);
+      c.op = "onnx_pipelined";
+      bench_run(&c, run_onnx_pipelined, &ctx);
+    }
+    free_texts(texts, ONNX_CORPUS_TEXTS);
+  }
+  free(matrix);
+  free_outputs(outputs);
+  fastembed_model_close(model);
+}
+#endif
+
+/* ------------------------------------------------------------------------ */
+/* Report                                                                    */
+/* ------------------------------------------------------------------------ */
+
+static int write_json(const char *path, const int *kernels, int num_kernels) {
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    printf("✗ Cannot write %s\n", path);
+    return -1;
+  }
+  fprintf(f, "{\n  \"schema\": 1,\n  \"suite\": \"fastembed\",\n");
+  fprintf(f,
+          "  \"config\": {\"quick\": %d, \"pinned\": %d, \"min_time_ms\": "
+          "%.0f, \"warmup_ms\": %.0f},\n",
+          g_config.quick, g_config.pin, g_config.min_time_ns / 1e6,
+          g_config.warmup_ns / 1e6);
+  fprintf(f, "  \"host\": {\"pool_threads\": %d, \"simd_level\": \"%s\", ",
+          fastembed_thread_pool_get_size(),
+          kernel_name(fastembed_get_simd_level()));
+  fprintf(f, "\"kernels\": [");
+  for (int k = 0; k < num_kernels; k++)
+    fprintf(f, "%s\"%s\"", k ? ", " : "", kernel_name(kernels[k]));
+  fprintf(f, "], \"onnx\": %d},\n",
+#ifdef USE_ONNX_RUNTIME
+          1
+#else
+          0
+#endif
+  );
+  fprintf(f, "  \"results\": [\n");
+  for (int i = 0; i < g_num_results; i++) {
+    const bench_result_t *r = &g_results[i];
+    fprintf(f,
+            "    {\"op\": \"%s\", \"kernel\": \"%s\", \"dimension\": %d, "
+            "\"batch\": %d, \"threads\": %d, \"text_bytes\": %d, "
+            "\"corpus\": %d, \"samples\": %d, \"calls\": %llu, "
+            "\"p50_ns\": %.1f, \"p99_ns\": %.1f, \"mean_ns\": %.1f, "
+            "\"items_per_s\": %.1f}%s\n",
+            r->c.op, r->c.kernel, r->c.dimension, r->c.batch, r->c.threads,
+            r->c.text_bytes, r->c.corpus, r->samples,
+            (unsigned long long)r->calls, r->p50_ns, r->p99_ns, r->mean_ns,
+            r->items_per_s, i + 1 < g_num_results ? "," : "");
+  }
+  fprintf(f, "  ]");
+#ifdef USE_ONNX_RUNTIME
+  /* Per-stage breakdown of the ONNX cases */
+  int length = fastembed_stats_snapshot_json(NULL, 0);
+  char *stats = length > 0 ? (char *)malloc((size_t)length + 64) : NULL;
+  if (stats != NULL &&
+      fastembed_stats_snapshot_json(stats, (size_t)length + 64) <
+          length + 64)
+    fprintf(f, ",\n  \"onnx_stats\": %s", stats);
+  free(stats);
+#endif
+  fprintf(f, "\n}\n");
+  fclose(f);
+  return 0;
+}
+
+static void usage(const char *program) {
+  printf("Usage: %s [--quick] [--json FILE] [--filter OP] [--pin] "
+         "[--model PATH] [--min-time MS]\n",
+         program);
+  printf("  --quick        Fewer dimensions and text lengths, shorter runs\n");
+  printf("  --json FILE    Write results as JSON\n");
+  printf("  --filter OP    Only cases whose operation contains OP\n");
+  printf("  --pin          Pin the main thread and pool threads to CPUs\n");
+  printf("  --model PATH   ONNX model for the end-to-end cases\n");
+  printf("  --min-time MS  Minimum sampling time per case\n");
+}
+
+int main(int argc, char **argv) {
+  g_config.min_time_ns = 200e6;
+  g_config.warmup_ns = 50e6;
+  g_config.model_path = getenv("FASTEMBED_BENCH_MODEL");
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--quick") == 0) {
+      g_config.quick = 1;
+      g_config.min_time_ns = 50e6;
+      g_config.warmup_ns = 10e6;
+    } else if (strcmp(argv[i], "--pin") == 0) {
+      g_config.pin = 1;
+    } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      g_config.json_path = argv[++i];
+    } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      g_config.filter = argv[++i];
+    } else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+      g_config.model_path = argv[++i];
+    } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      g_config.min_time_ns = atof(argv[++i]) * 1e6;
+    } else {
+      usage(argv[0]);
+      return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+    }
+  }
+  printf("FastEmbed Benchmark Suite\n");
+  printf("=========================\n");
+
+  /* Pool threads pin themselves to CPU i; the caller takes CPU 0 */
+  if (g_config.pin) {
+    fastembed_thread_pool_configure(0, 1);
+    if (pin_main_thread() != 0)
+      printf("⚠ CPU pinning not supported on this platform\n");
+  }
+
+  int kernels[BENCH_MAX_KERNELS];
+  int num_kernels = available_kernels(kernels);
+  int threads[BENCH_MAX_THREAD_COUNTS];
+  int num_threads = thread_counts(threads);
+
+  printf("Kernels:");
+  for (int k = 0; k < num_kernels; k++)
+    printf(" %s", kernel_name(kernels[k]));
+  printf("\nThread counts:");
+  for (int t = 0; t < num_threads; t++)
+    printf(" %d", threads[t]);
+  printf("\nSampling: %.0f ms per case after %.0f ms warmup\n",
+         g_config.min_time_ns / 1e6, g_config.warmup_ns / 1e6);
+
+  const int *dims = g_config.quick ? k_quick_dimensions : k_dimensions;
+  int num_dims = g_config.quick
+                     ? (int)(sizeof(k_quick_dimensions) / sizeof(int))
+                     : (int)(sizeof(k_dimensions) / sizeof(int));
+  const int *lengths = g_config.quick ? k_quick_text_bytes : k_text_bytes;
+  int num_lengths = g_config.quick
+                        ? (int)(sizeof(k_quick_text_bytes) / sizeof(int))
+                        : (int)(sizeof(k_text_bytes) / sizeof(int));
+
+  bench_hash(dims, num_dims, lengths, num_lengths, threads, num_threads);
+  bench_vectors(dims, num_dims, kernels, num_kernels, threads, num_threads);
+#ifdef USE_ONNX_RUNTIME
+  fastembed_stats_reset();
+  bench_onnx(lengths, num_lengths, threads, num_threads);
+#endif
+
+  printf("\n%d cases, %d failed\n", g_num_results, g_failures);
+  int status = g_failures == 0 ? 0 : 1;
+  if (g_config.json_path &&
+      write_json(g_config.json_path, kernels, num_kernels) != 0)
+    status = 1;
+  else if (g_config.json_path)
+    printf("Results written to %s\n", g_config.json_path);
+
+  free(g_results);
+  fastembed_onnx_unload();
+  fastembed_thread_pool_shutdown();
+  return status;
+}
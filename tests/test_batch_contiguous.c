@@ -0,0 +1,352 @@
+/**
+ * FastEmbed Contiguous Batch Tests
+ *
+ * Tests for fastembed_batch_generate_contiguous() and fastembed_alloc_matrix():
+ * - Test rows are bit-identical to fastembed_generate() for every thread
+ *   count, with texts packed back to back (no null terminators)
+ * - Test per-text statuses for empty, too-long, decreasing, negative and
+ *   NUL-containing spans, and that failed rows are zeroed
+ * - Test invalid argument handling
+ * - Test fastembed_alloc_matrix() alignment and size checks
+ * - Measure pointer-array vs contiguous batch throughput
+ *
+ * Compile: gcc -o test_batch_contiguous test_batch_contiguous.c -L../build
+ * -lfastembed -lm -lpthread -I../include Run: LD_LIBRARY_PATH=..
+ * ./test_batch_contiguous
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define DIM 512
+#define NUM_TEXTS 300
+
+/** Packed corpus: text i is blob[offsets[i], offsets[i + 1]) */
+typedef struct {
+  char *blob;
+  int32_t offsets[NUM_TEXTS + 1];
+  char *strings[NUM_TEXTS]; /* Null-terminated copies for the reference */
+} Corpus;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** Mixed-case texts of uneven length, packed without separators */
+static int make_corpus(Corpus *corpus) {
+  size_t total = 0;
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    size_t len = (i % 11 == 0) ? 3000 : (size_t)(1 + (i * 53) % 150);
+    corpus->strings[i] = (char *)malloc(len + 1);
+    if (!corpus->strings[i])
+      return -1;
+    for (size_t c = 0; c < len; c++)
+      corpus->strings[i][c] =
+          (char)(((i + c) % 3 == 0 ? 'A' : 'a') + (i * 7 + c * 5) % 26);
+    corpus->strings[i][len] = '\0';
+    total += len;
+  }
+
+  corpus->blob = (char *)malloc(total);
+  if (!corpus->blob)
+    return -1;
+  int32_t offset = 0;
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    size_t len = strlen(corpus->strings[i]);
+    corpus->offsets[i] = offset;
+    memcpy(corpus->blob + offset, corpus->strings[i], len);
+    offset += (int32_t)len;
+  }
+  corpus->offsets[NUM_TEXTS] = offset;
+  return 0;
+}
+
+static void free_corpus(Corpus *corpus) {
+  for (int i = 0; i < NUM_TEXTS; i++)
+    free(corpus->strings[i]);
+  free(corpus->blob);
+}
+
+/**
+ * Test: Contiguous rows match fastembed_generate() for all thread counts
+ */
+static void test_matches_generate(const Corpus *corpus, const float *reference) {
+  printf("\nTest: Contiguous batch matches fastembed_generate()\n");
+
+  float *output = fastembed_alloc_matrix(NUM_TEXTS, DIM);
+  int *statuses = (int *)malloc(NUM_TEXTS * sizeof(int));
+  if (!output || !statuses) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    fastembed_free_matrix(output);
+    free(statuses);
+    return;
+  }
+
+  int thread_counts[] = {1, 2, 4, 0};
+  for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+       t++) {
+    memset(output, 0xff, (size_t)NUM_TEXTS * DIM * sizeof(float));
+    int failed = fastembed_batch_generate_contiguous(
+        corpus->blob, corpus->offsets, NUM_TEXTS, output, DIM, statuses,
+        thread_counts[t]);
+    ASSERT_EQ_INT(failed, 0);
+
+    int bad_status = 0;
+    for (int i = 0; i < NUM_TEXTS; i++)
+      bad_status += statuses[i] != FASTEMBED_STATUS_OK;
+    char message[96];
+    snprintf(message, sizeof(message),
+             "num_threads=%d: all statuses OK, rows bit-identical",
+             thread_counts[t]);
+    ASSERT_TRUE(bad_status == 0 &&
+                    memcmp(output, reference,
+                           (size_t)NUM_TEXTS * DIM * sizeof(float)) == 0,
+                message);
+  }
+
+  fastembed_free_matrix(output);
+  free(statuses);
+}
+
+/**
+ * Test: Bad spans fail on their own and their rows are zeroed
+ */
+static void test_statuses(void) {
+  printf("\nTest: Per-span statuses\n");
+
+  size_t long_len = FASTEMBED_MAX_TEXT_LENGTH + 1;
+  char *blob = (char *)malloc(long_len + 32);
+  memcpy(blob, "hello", 5);                   /* [0, 5)   ok */
+  memcpy(blob + 5, "wor\0ld", 6);             /* [5, 11)  embedded NUL */
+  memcpy(blob + 11, "Again", 5);              /* [11, 16) ok */
+  memset(blob + 16, 'x', long_len);           /* too long */
+  memcpy(blob + 16 + long_len, "tail", 4);
+
+  int32_t tail = (int32_t)(16 + long_len);
+  int32_t offsets[] = {0, 5, 11, 16, 16, tail, tail + 4, 2, -1, 3};
+  const int count = 9;
+  /* spans: ok, NUL, ok, empty, too long, ok, decreasing, negative end,
+   * negative begin */
+  float *output = fastembed_alloc_matrix(count, 128);
+  for (int i = 0; i < count * 128; i++)
+    output[i] = 7.0f;
+  int statuses[9];
+
+  int failed = fastembed_batch_generate_contiguous(blob, offsets, count,
+                                                   output, 0, statuses, 0);
+  ASSERT_EQ_INT(failed, 6);
+  ASSERT_EQ_INT(statuses[0], FASTEMBED_STATUS_OK);
+  ASSERT_EQ_INT(statuses[1], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[2], FASTEMBED_STATUS_OK);
+  ASSERT_EQ_INT(statuses[3], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[4], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[5], FASTEMBED_STATUS_OK);
+  ASSERT_EQ_INT(statuses[6], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[7], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[8], FASTEMBED_STATUS_INVALID_TEXT);
+
+  float expected[128];
+  int ok = fastembed_generate("hello", expected, 128) == 0 &&
+           memcmp(output, expected, sizeof(expected)) == 0;
+  ok = ok && fastembed_generate("again", expected, 128) == 0 &&
+       memcmp(output + 2 * 128, expected, sizeof(expected)) == 0;
+  ok = ok && fastembed_generate("tail", expected, 128) == 0 &&
+       memcmp(output + 5 * 128, expected, sizeof(expected)) == 0;
+  ASSERT_TRUE(ok, "Valid spans embedded (case-insensitive, default 128D)");
+
+  int zeroed = 1;
+  int failed_rows[] = {1, 3, 4, 6, 7, 8};
+  for (int r = 0; r < 6; r++) {
+    for (int d = 0; d < 128; d++) {
+      if (output[failed_rows[r] * 128 + d] != 0.0f)
+        zeroed = 0;
+    }
+  }
+  ASSERT_TRUE(zeroed, "Rows of failed spans are zeroed");
+
+  /* a span of exactly FASTEMBED_MAX_TEXT_LENGTH bytes is accepted */
+  int32_t max_offsets[] = {16, (int32_t)(16 + FASTEMBED_MAX_TEXT_LENGTH)};
+  ASSERT_EQ_INT(fastembed_batch_generate_contiguous(blob, max_offsets, 1,
+                                                    output, 128, statuses, 0),
+                0);
+
+  fastembed_free_matrix(output);
+  free(blob);
+}
+
+/**
+ * Test: Invalid arguments are rejected
+ */
+static void test_invalid_arguments(void) {
+  printf("\nTest: Invalid arguments\n");
+
+  const char *blob = "hello";
+  int32_t offsets[] = {0, 5};
+  float output[128];
+
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_contiguous(NULL, offsets, 1, output, 128, NULL,
+                                          0),
+      -1);
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_contiguous(blob, NULL, 1, output, 128, NULL, 0),
+      -1);
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_contiguous(blob, offsets, 1, NULL, 128, NULL, 0),
+      -1);
+  ASSERT_EQ_INT(fastembed_batch_generate_contiguous(blob, offsets, 0, output,
+                                                    128, NULL, 0),
+                -1);
+  ASSERT_EQ_INT(fastembed_batch_generate_contiguous(blob, offsets, 1, output,
+                                                    100, NULL, 0),
+                -1);
+  ASSERT_EQ_INT(fastembed_batch_generate_contiguous(blob, offsets, 1, output,
+                                                    128, NULL, -1),
+                -1);
+  ASSERT_EQ_INT(fastembed_model_batch_generate_contiguous(
+                    NULL, blob, offsets, 1, output, 0, NULL, 0),
+                -1);
+}
+
+/**
+ * Test: fastembed_alloc_matrix() alignment and size checks
+ */
+static void test_alloc_matrix(void) {
+  printf("\nTest: Aligned matrix allocation\n");
+
+  int aligned = 1;
+  int zeroed = 1;
+  for (int rows = 1; rows <= 17; rows += 4) {
+    float *matrix = fastembed_alloc_matrix(rows, 128);
+    if (!matrix) {
+      aligned = 0;
+      continue;
+    }
+    if ((uintptr_t)matrix % FASTEMBED_MATRIX_ALIGNMENT != 0)
+      aligned = 0;
+    for (int i = 0; i < rows * 128; i++) {
+      if (matrix[i] != 0.0f)
+        zeroed = 0;
+    }
+    fastembed_free_matrix(matrix);
+  }
+  ASSERT_TRUE(aligned, "Matrices are 64-byte aligned");
+  ASSERT_TRUE(zeroed, "Matrices are zeroed");
+
+  ASSERT_TRUE(fastembed_alloc_matrix(0, 128) == NULL, "rows = 0 rejected");
+  ASSERT_TRUE(fastembed_alloc_matrix(4, -1) == NULL, "dimension < 0 rejected");
+  /* rows * dimension * sizeof(float) can only exceed SIZE_MAX with 32-bit
+   * size_t; on 64-bit targets every int pair fits */
+  if (sizeof(size_t) == 4) {
+    ASSERT_TRUE(fastembed_alloc_matrix(0x40000000, 4) == NULL,
+                "Overflowing size rejected");
+  }
+  fastembed_free_matrix(NULL);
+}
+
+/**
+ * Benchmark: float** / const char** batch vs contiguous batch
+ */
+static void benchmark_batch(const Corpus *corpus) {
+  printf("\nBenchmark: Pointer-array vs contiguous batch (%d texts, %dD)\n",
+         NUM_TEXTS, DIM);
+
+  float *matrix = fastembed_alloc_matrix(NUM_TEXTS, DIM);
+  float *rows[NUM_TEXTS];
+  for (int i = 0; i < NUM_TEXTS; i++)
+    rows[i] = matrix + (size_t)i * DIM;
+  const int iterations = 20;
+
+  double start = now_seconds();
+  for (int it = 0; it < iterations; it++)
+    fastembed_batch_generate_parallel((const char **)corpus->strings,
+                                      NUM_TEXTS, rows, DIM, NULL, 0);
+  double pointers = (now_seconds() - start) / iterations;
+
+  start = now_seconds();
+  for (int it = 0; it < iterations; it++)
+    fastembed_batch_generate_contiguous(corpus->blob, corpus->offsets,
+                                        NUM_TEXTS, matrix, DIM, NULL, 0);
+  double contiguous = (now_seconds() - start) / iterations;
+
+  printf("  Pointer arrays: %.3f ms/batch\n", pointers * 1e3);
+  printf("  Contiguous:     %.3f ms/batch\n", contiguous * 1e3);
+
+  fastembed_free_matrix(matrix);
+}
+
+int main() {
+  printf("FastEmbed Contiguous Batch Tests\n");
+  printf("================================\n");
+
+  Corpus corpus;
+  float *reference = (float *)malloc((size_t)NUM_TEXTS * DIM * sizeof(float));
+  if (make_corpus(&corpus) != 0 || !reference) {
+    printf("✗ Allocation failed\n");
+    return 1;
+  }
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    if (fastembed_generate(corpus.strings[i], reference + (size_t)i * DIM,
+                           DIM) != 0) {
+      printf("✗ Reference generation failed\n");
+      return 1;
+    }
+  }
+
+  test_matches_generate(&corpus, reference);
+  test_statuses();
+  test_invalid_arguments();
+  test_alloc_matrix();
+  benchmark_batch(&corpus);
+
+  fastembed_thread_pool_shutdown();
+  free(reference);
+  free_corpus(&corpus);
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
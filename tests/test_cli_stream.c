@@ -0,0 +1,713 @@
+/**
+ * FastEmbed CLI Streaming Tests
+ *
+ * Tests for the NDJSON streaming mode shared by the CLI tools
+ * (cli_stream.c), driven with a fake embedding callback:
+ * - Test the line reader: CRLF and LF terminators, empty lines, a last line
+ *   without terminator, non-blocking reads and over-long lines
+ * - Test JSON string escapes, including surrogate pairs, and that bad
+ *   escapes are rejected
+ * - Test that invalid records keep their index and do not shift the
+ *   records after them, and that ids are echoed verbatim
+ * - Test that blank lines are skipped without using up an index
+ * - Test batching and the f32le row size and zeroed failed rows
+ *
+ * Compile: gcc -o test_cli_stream test_cli_stream.c
+ * ../bindings/shared/src/cli_stream.c -L../build -lfastembed -lm -lpthread
+ * -I../include Run: LD_LIBRARY_PATH=.. ./test_cli_stream
+ */
+
+#include "fastembed.h"
+#include "fastembed_config.h"
+#include "../bindings/shared/src/cli_stream.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define fileno _fileno
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define DIM 4
+#define MAX_SEEN 32
+
+/** What the fake embedding callback was given */
+typedef struct {
+  int calls;
+  int count;
+  char *texts[MAX_SEEN];
+  size_t lengths[MAX_SEEN];
+} Capture;
+
+/** Output of one cli_stream_embeddings() run */
+typedef struct {
+  int exit_code;
+  char *out;
+  size_t out_size;
+  char *err;
+  size_t err_size;
+} StreamResult;
+
+/**
+ * Fake embedding: row = {length, first byte, last byte, 0.5}. Empty texts
+ * and texts with a NUL fail as they do in fastembed_batch_generate_contiguous()
+ */
+static int fake_embed(void *user_data, const char *text_data,
+                      const int32_t *offsets, int count, float *output,
+                      int *statuses, int num_threads) {
+  Capture *capture = (Capture *)user_data;
+  int failed = 0;
+  (void)num_threads;
+
+  capture->calls++;
+  for (int i = 0; i < count; i++) {
+    const char *text = text_data + offsets[i];
+    size_t length = (size_t)(offsets[i + 1] - offsets[i]);
+    float *row = output + (size_t)i * DIM;
+
+    if (capture->count < MAX_SEEN) {
+      char *copy = (char *)malloc(length + 1);
+      if (copy) {
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+      }
+      capture->texts[capture->count] = copy;
+      capture->lengths[capture->count] = length;
+      capture->count++;
+    }
+
+    if (length == 0 || memchr(text, '\0', length) != NULL) {
+      memset(row, 0, sizeof(float) * DIM);
+      statuses[i] = FASTEMBED_STATUS_INVALID_TEXT;
+      failed++;
+      continue;
+    }
+    row[0] = (float)length;
+    row[1] = (float)(unsigned char)text[0];
+    row[2] = (float)(unsigned char)text[length - 1];
+    row[3] = 0.5f;
+    statuses[i] = FASTEMBED_STATUS_OK;
+  }
+  return failed;
+}
+
+static void capture_free(Capture *capture) {
+  for (int i = 0; i < capture->count; i++)
+    free(capture->texts[i]);
+  memset(capture, 0, sizeof(*capture));
+}
+
+static void result_free(StreamResult *result) {
+  free(result->out);
+  free(result->err);
+}
+
+/** Temporary file holding size bytes of data, positioned at the start */
+static FILE *file_with(const char *data, size_t size) {
+  FILE *file = tmpfile();
+  if (!file)
+    return NULL;
+  if (fwrite(data, 1, size, file) != size) {
+    fclose(file);
+    return NULL;
+  }
+  rewind(file);
+  return file;
+}
+
+/** Read a whole file into a null-terminated buffer */
+static char *read_all(FILE *file, size_t *size) {
+  long end;
+  char *data;
+
+  fflush(file);
+  fseek(file, 0, SEEK_END);
+  end = ftell(file);
+  rewind(file);
+  data = (char *)malloc((size_t)end + 1);
+  if (!data)
+    return NULL;
+  *size = fread(data, 1, (size_t)end, file);
+  data[*size] = '\0';
+  return data;
+}
+
+/**
+ * Run the streaming mode with stdin, stdout and stderr redirected to
+ * temporary files
+ */
+static int run_stream(const char *input, size_t input_size,
+                      const cli_stream_options_t *options, Capture *capture,
+                      StreamResult *result) {
+  FILE *in = file_with(input, input_size);
+  FILE *out = tmpfile();
+  FILE *err = tmpfile();
+  int saved[3];
+
+  memset(result, 0, sizeof(*result));
+  if (!in || !out || !err)
+    return -1;
+
+  fflush(stdout);
+  fflush(stderr);
+  saved[0] = dup(0);
+  saved[1] = dup(1);
+  saved[2] = dup(2);
+  dup2(fileno(in), 0);
+  dup2(fileno(out), 1);
+  dup2(fileno(err), 2);
+
+  result->exit_code =
+      cli_stream_embeddings(options, DIM, fake_embed, capture);
+
+  fflush(stdout);
+  fflush(stderr);
+  for (int fd = 0; fd < 3; fd++) {
+    dup2(saved[fd], fd);
+    close(saved[fd]);
+  }
+
+  result->out = read_all(out, &result->out_size);
+  result->err = read_all(err, &result->err_size);
+  fclose(in);
+  fclose(out);
+  fclose(err);
+  return result->out && result->err ? 0 : -1;
+}
+
+static int run_ndjson(const char *input, int batch_size, Capture *capture,
+                      StreamResult *result) {
+  cli_stream_options_t options;
+  cli_stream_options_init(&options);
+  options.enabled = 1;
+  options.batch_size = batch_size;
+  return run_stream(input, strlen(input), &options, capture, result);
+}
+
+/** Number of lines in an NDJSON output */
+static int count_lines(const char *text) {
+  int lines = 0;
+  for (; *text; text++)
+    lines += *text == '\n';
+  return lines;
+}
+
+/** Line number n (from 0) starts with prefix */
+static int line_starts_with(const char *text, int n, const char *prefix) {
+  for (int i = 0; i < n; i++) {
+    text = strchr(text, '\n');
+    if (!text)
+      return 0;
+    text++;
+  }
+  return strncmp(text, prefix, strlen(prefix)) == 0;
+}
+
+// ============================================================================
+// Line reader tests
+// ============================================================================
+
+static int reader_open(cli_line_reader_t *reader, FILE *file) {
+  if (!file || cli_line_reader_init(reader) != 0)
+    return -1;
+  reader->fd = fileno(file);
+  return 0;
+}
+
+void test_line_reader() {
+  printf("\n=== Testing line reader ===\n");
+
+  static const char input[] = "first\r\nsecond\n\ncr\rmid\nlast";
+  FILE *file = file_with(input, sizeof(input) - 1);
+  cli_line_reader_t reader;
+  char *line = NULL;
+  size_t length = 0;
+
+  if (reader_open(&reader, file) != 0) {
+    ASSERT_TRUE(0, "Line reader opened");
+    return;
+  }
+
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 0, &line, &length),
+                CLI_LINE_WOULD_BLOCK);
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(length == 5 && strcmp(line, "first") == 0,
+              "CRLF line is returned without its terminator");
+
+  /* Everything is buffered now, so non-blocking calls still make progress */
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 0, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(length == 6 && strcmp(line, "second") == 0,
+              "LF line is returned from the buffer without waiting");
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 0, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(length == 0 && line[0] == '\0', "Empty line has length 0");
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 0, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(length == 6 && memcmp(line, "cr\rmid", 6) == 0,
+              "Bare CR inside a line is kept");
+
+  /* The unterminated last line needs end of input, so waiting is required */
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 0, &line, &length),
+                CLI_LINE_WOULD_BLOCK);
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(length == 4 && strcmp(line, "last") == 0,
+              "Last line without terminator is returned at end of input");
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_END);
+
+  cli_line_reader_free(&reader);
+  fclose(file);
+}
+
+void test_line_reader_too_long() {
+  printf("\n=== Testing over-long lines ===\n");
+
+  const size_t max = FASTEMBED_CLI_STREAM_MAX_LINE;
+  size_t size = 0;
+  char *input = (char *)malloc(3 * max + 64);
+  if (!input) {
+    ASSERT_TRUE(0, "Input allocated");
+    return;
+  }
+
+  /* short, max + 1 bytes, exactly max bytes, after, max + 1 bytes at EOF */
+  memcpy(input + size, "short\n", 6);
+  size += 6;
+  memset(input + size, 'x', max + 1);
+  size += max + 1;
+  input[size++] = '\n';
+  memset(input + size, 'y', max);
+  size += max;
+  input[size++] = '\n';
+  memcpy(input + size, "after\n", 6);
+  size += 6;
+  memset(input + size, 'z', max + 1);
+  size += max + 1;
+
+  FILE *file = file_with(input, size);
+  cli_line_reader_t reader;
+  char *line = NULL;
+  size_t length = 0;
+  free(input);
+
+  if (reader_open(&reader, file) != 0) {
+    ASSERT_TRUE(0, "Line reader opened");
+    return;
+  }
+
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(strcmp(line, "short") == 0, "Line before the long one is read");
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_TOO_LONG);
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(length == max && line[0] == 'y' && line[max - 1] == 'y',
+              "Line of exactly FASTEMBED_CLI_STREAM_MAX_LINE bytes is kept");
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_READY);
+  ASSERT_TRUE(strcmp(line, "after") == 0,
+              "Reading resumes after the skipped line");
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_TOO_LONG);
+  ASSERT_EQ_INT(cli_line_reader_next(&reader, 1, &line, &length),
+                CLI_LINE_END);
+
+  cli_line_reader_free(&reader);
+  fclose(file);
+}
+
+// ============================================================================
+// Record parsing tests
+// ============================================================================
+
+void test_escapes() {
+  printf("\n=== Testing JSON escapes ===\n");
+
+  static const char input[] =
+      "{\"text\":\"a\\\"b\\\\c\\/d\\n\\t\\b\\f\\r\",\"id\":7}\n"
+      "\"\\u00e9\\u20ac\\ud83d\\ude00\\u0041\"\n"
+      "\"bad \\x escape\"\n"
+      "\"lone \\udc00 low\"\n"
+      "\"high \\ud83d alone\"\n"
+      "\"short \\u12\"\n"
+      "\"nul \\u0000 inside\"\n"
+      "{\"id\":\"first\",\"text\":\"x\",\"text\":\"\\u00e9\"}\n";
+  Capture capture = {0};
+  StreamResult result;
+
+  if (run_ndjson(input, FASTEMBED_CLI_STREAM_BATCH, &capture, &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT(count_lines(result.out), 8);
+  ASSERT_TRUE(capture.count >= 1 &&
+                  strcmp(capture.texts[0], "a\"b\\c/d\n\t\b\f\r") == 0,
+              "Simple escapes are decoded");
+  ASSERT_TRUE(capture.count >= 2 &&
+                  strcmp(capture.texts[1],
+                         "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80"
+                         "A") == 0,
+              "\\u escapes and surrogate pairs are decoded to UTF-8");
+  ASSERT_TRUE(line_starts_with(result.out, 0,
+                               "{\"index\":0,\"id\":7,\"embedding\":[12.0"),
+              "Record with an id echoes it and is embedded");
+  ASSERT_TRUE(line_starts_with(result.out, 1,
+                               "{\"index\":1,\"embedding\":[10.0"),
+              "Record without an id has no id member");
+  for (int i = 2; i <= 5; i++) {
+    char expected[64];
+    snprintf(expected, sizeof(expected),
+             "{\"index\":%d,\"error\":\"Invalid JSON record\"}", i);
+    ASSERT_TRUE(line_starts_with(result.out, i, expected),
+                "Bad escape or unpaired surrogate is an invalid record");
+  }
+  ASSERT_TRUE(line_starts_with(result.out, 6,
+                               "{\"index\":6,\"error\":\"Empty text or NUL "
+                               "character\"}"),
+              "\\u0000 reaches the embedder and is rejected there");
+  ASSERT_TRUE(capture.count == 8 && capture.lengths[2] == 0 &&
+                  capture.lengths[3] == 0 && capture.lengths[4] == 0 &&
+                  capture.lengths[5] == 0 && capture.lengths[6] == 12,
+              "Invalid records reach the embedder as empty spans");
+  ASSERT_TRUE(capture.count == 8 && strcmp(capture.texts[7], "\xc3\xa9") == 0,
+              "A repeated text key wins");
+  ASSERT_TRUE(line_starts_with(result.out, 7,
+                               "{\"index\":7,\"id\":\"first\",\"embedding\":"),
+              "String id is echoed verbatim");
+
+  result_free(&result);
+  capture_free(&capture);
+}
+
+void test_invalid_records() {
+  printf("\n=== Testing invalid records ===\n");
+
+  static const char input[] = "\"zero\"\n"
+                              "not json\n"
+                              "{\"id\":3}\n"
+                              "{\"text\":\"x\"} trailing\n"
+                              "{\"text\":42}\n"
+                              "\"\"\n"
+                              "\"unterminated\n"
+                              "{\"text\":\"seven\",\"id\":{\"a\":[1,2]}}\n";
+  Capture capture = {0};
+  StreamResult result;
+
+  if (run_ndjson(input, FASTEMBED_CLI_STREAM_BATCH, &capture, &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT(count_lines(result.out), 8);
+  ASSERT_TRUE(line_starts_with(result.out, 0, "{\"index\":0,\"embedding\":"),
+              "Valid record before the invalid ones is embedded");
+  ASSERT_TRUE(line_starts_with(result.out, 1,
+                               "{\"index\":1,\"error\":\"Invalid JSON "
+                               "record\"}\n"),
+              "Non-JSON line keeps its index");
+  ASSERT_TRUE(line_starts_with(result.out, 2,
+                               "{\"index\":2,\"error\":\"Record has no text "
+                               "string\"}\n"),
+              "Object without text keeps its index and drops its id");
+  ASSERT_TRUE(line_starts_with(result.out, 3,
+                               "{\"index\":3,\"error\":\"Invalid JSON "
+                               "record\"}\n"),
+              "Trailing garbage makes the record invalid");
+  ASSERT_TRUE(line_starts_with(result.out, 4,
+                               "{\"index\":4,\"error\":\"Record has no text "
+                               "string\"}\n"),
+              "Non-string text is a missing text");
+  ASSERT_TRUE(line_starts_with(result.out, 5,
+                               "{\"index\":5,\"error\":\"Empty text or NUL "
+                               "character\"}\n"),
+              "Empty text string is rejected by the embedder");
+  ASSERT_TRUE(line_starts_with(result.out, 6,
+                               "{\"index\":6,\"error\":\"Invalid JSON "
+                               "record\"}\n"),
+              "Unterminated string is invalid");
+  ASSERT_TRUE(line_starts_with(result.out, 7,
+                               "{\"index\":7,\"id\":{\"a\":[1,2]},"
+                               "\"embedding\":[5.000000,115.000000,"
+                               "110.000000,0.500000]}\n"),
+              "Record after the invalid ones keeps its own index and row");
+
+  result_free(&result);
+  capture_free(&capture);
+}
+
+void test_blank_lines() {
+  printf("\n=== Testing empty and blank lines ===\n");
+
+  static const char input[] = "\n"
+                              "\"a\"\n"
+                              "\n"
+                              "   \n"
+                              "\t \r\n"
+                              "\"b\"\r\n"
+                              "\n";
+  Capture capture = {0};
+  StreamResult result;
+
+  if (run_ndjson(input, FASTEMBED_CLI_STREAM_BATCH, &capture, &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT(count_lines(result.out), 2);
+  ASSERT_EQ_INT(capture.count, 2);
+  ASSERT_TRUE(line_starts_with(result.out, 0, "{\"index\":0,\"embedding\":"),
+              "First record after a blank line is index 0");
+  ASSERT_TRUE(line_starts_with(result.out, 1, "{\"index\":1,\"embedding\":"),
+              "Blank lines do not use up an index");
+  result_free(&result);
+  capture_free(&capture);
+
+  if (run_ndjson("\n  \n\r\n", FASTEMBED_CLI_STREAM_BATCH, &capture,
+                 &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT((int)result.out_size, 0);
+  ASSERT_EQ_INT(capture.calls, 0);
+  result_free(&result);
+  capture_free(&capture);
+
+  if (run_ndjson("", FASTEMBED_CLI_STREAM_BATCH, &capture, &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+  ASSERT_TRUE(result.exit_code == 0 && result.out_size == 0,
+              "Empty input gives no output");
+  result_free(&result);
+  capture_free(&capture);
+}
+
+void test_stream_too_long() {
+  printf("\n=== Testing over-long records in the stream ===\n");
+
+  const size_t max = FASTEMBED_CLI_STREAM_MAX_LINE;
+  char *input = (char *)malloc(max + 64);
+  size_t size = 0;
+  if (!input) {
+    ASSERT_TRUE(0, "Input allocated");
+    return;
+  }
+  memcpy(input, "\"before\"\n\"", 10);
+  size = 10;
+  memset(input + size, 'x', max);
+  size += max;
+  memcpy(input + size, "\"\n\"after\"\n", 10);
+  size += 10;
+
+  cli_stream_options_t options;
+  cli_stream_options_init(&options);
+  options.enabled = 1;
+  Capture capture = {0};
+  StreamResult result;
+  int ran = run_stream(input, size, &options, &capture, &result);
+  free(input);
+  if (ran != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT(count_lines(result.out), 3);
+  ASSERT_TRUE(line_starts_with(result.out, 1,
+                               "{\"index\":1,\"error\":\"Input line too "
+                               "long\"}\n"),
+              "Over-long line is reported at its index");
+  ASSERT_TRUE(line_starts_with(result.out, 2, "{\"index\":2,\"embedding\":"),
+              "Record after the over-long line is embedded");
+  ASSERT_TRUE(capture.count == 3 && capture.lengths[1] == 0,
+              "Over-long line reaches the embedder as an empty span");
+
+  result_free(&result);
+  capture_free(&capture);
+}
+
+// ============================================================================
+// Batching and output format tests
+// ============================================================================
+
+void test_batches() {
+  printf("\n=== Testing batching ===\n");
+
+  static const char input[] = "\"r0\"\n\"r1\"\nbad\n\"r3\"\n\"r4\"\n";
+  Capture capture = {0};
+  StreamResult result;
+
+  if (run_ndjson(input, 2, &capture, &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT(capture.calls, 3);
+  ASSERT_EQ_INT(count_lines(result.out), 5);
+  int ordered = 1;
+  for (int i = 0; i < 5; i++) {
+    char expected[32];
+    snprintf(expected, sizeof(expected), "{\"index\":%d,", i);
+    ordered &= line_starts_with(result.out, i, expected);
+  }
+  ASSERT_TRUE(ordered, "Indices run on across batches in input order");
+  ASSERT_TRUE(line_starts_with(result.out, 3,
+                               "{\"index\":3,\"embedding\":[2.000000,"
+                               "114.000000,51.000000,"),
+              "Row of a later batch belongs to its record");
+
+  result_free(&result);
+  capture_free(&capture);
+}
+
+void test_f32le() {
+  printf("\n=== Testing f32le output ===\n");
+
+  static const char input[] = "\"abc\"\n{broken\n\"\"\n{\"text\":\"hello\"}\n";
+  cli_stream_options_t options;
+  cli_stream_options_init(&options);
+  options.enabled = 1;
+  options.format = CLI_STREAM_F32LE;
+  Capture capture = {0};
+  StreamResult result;
+
+  if (run_stream(input, strlen(input), &options, &capture, &result) != 0) {
+    ASSERT_TRUE(0, "Stream ran");
+    return;
+  }
+
+  ASSERT_EQ_INT(result.exit_code, 0);
+  ASSERT_EQ_INT((int)result.out_size, 4 * DIM * 4);
+
+  /* Decode little-endian rows independently of the host byte order */
+  float rows[4][DIM];
+  for (int v = 0; v < 4 * DIM && result.out_size == 4 * DIM * 4; v++) {
+    const unsigned char *b = (const unsigned char *)result.out + v * 4;
+    uint32_t bits = (uint32_t)b[0] | (uint32_t)b[1] << 8 |
+                    (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+    memcpy(&rows[v / DIM][v % DIM], &bits, sizeof(float));
+  }
+  if (result.out_size == 4 * DIM * 4) {
+    ASSERT_TRUE(rows[0][0] == 3.0f && rows[0][1] == 'a' &&
+                    rows[0][2] == 'c' && rows[0][3] == 0.5f,
+                "First row holds the first record's embedding");
+    ASSERT_TRUE(rows[1][0] == 0.0f && rows[1][1] == 0.0f &&
+                    rows[1][2] == 0.0f && rows[1][3] == 0.0f,
+                "Invalid record gives a zero row");
+    ASSERT_TRUE(rows[2][0] == 0.0f && rows[2][3] == 0.0f,
+                "Rejected text gives a zero row");
+    ASSERT_TRUE(rows[3][0] == 5.0f && rows[3][1] == 'h',
+                "Row after the failed ones keeps its position");
+  }
+  ASSERT_TRUE(strstr(result.err,
+                     "{\"index\":1,\"error\":\"Invalid JSON record\"}\n") !=
+                  NULL,
+              "Invalid record is reported on stderr with its index");
+  ASSERT_TRUE(strstr(result.err, "{\"index\":2,\"error\":\"Empty text or NUL "
+                                 "character\"}\n") != NULL,
+              "Rejected text is reported on stderr with its index");
+  ASSERT_TRUE(strstr(result.err, "\"index\":0") == NULL &&
+                  strstr(result.err, "\"index\":3") == NULL,
+              "Embedded records are not reported");
+
+  result_free(&result);
+  capture_free(&capture);
+}
+
+void test_parse_options() {
+  printf("\n=== Testing option parsing ===\n");
+
+  char *argv[] = {"tool", "--stream", "--batch", "8",      "--format",
+                  "f32le", "--threads", "3",     "--batch", "0",
+                  "--other"};
+  int argc = (int)(sizeof(argv) / sizeof(argv[0]));
+  cli_stream_options_t options;
+  int index = 1;
+  cli_stream_options_init(&options);
+
+  ASSERT_EQ_INT(cli_stream_parse_option(argc, argv, &index, &options), 1);
+  ASSERT_EQ_INT(cli_stream_parse_option(argc, argv, &index, &options), 1);
+  ASSERT_EQ_INT(cli_stream_parse_option(argc, argv, &index, &options), 1);
+  ASSERT_EQ_INT(cli_stream_parse_option(argc, argv, &index, &options), 1);
+  ASSERT_TRUE(options.enabled && options.batch_size == 8 &&
+                  options.format == CLI_STREAM_F32LE &&
+                  options.num_threads == 3 && index == 8,
+              "Options are parsed and their values consumed");
+
+  ASSERT_EQ_INT(cli_stream_parse_option(argc, argv, &index, &options), -1);
+  index = 10;
+  ASSERT_EQ_INT(cli_stream_parse_option(argc, argv, &index, &options), 0);
+}
+
+int main() {
+  printf("FastEmbed CLI Streaming Tests\n");
+  printf("=============================\n");
+
+  test_line_reader();
+  test_line_reader_too_long();
+  test_escapes();
+  test_invalid_records();
+  test_blank_lines();
+  test_stream_too_long();
+  test_batches();
+  test_f32le();
+  test_parse_options();
+
+  fastembed_thread_pool_shutdown();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
@@ -0,0 +1,569 @@
+/**
+ * FastEmbed Half-Precision Tests
+ *
+ * Tests for fp16 / bf16 storage:
+ * - Test fastembed_f32_to_f16() / fastembed_f16_to_f32() and the bf16
+ *   conversions against scalar references at every SIMD level the CPU
+ *   supports, including tails and unaligned pointers
+ * - Test rounding to nearest even, overflow, subnormals, infinities and NaN
+ * - Test fastembed_generate_quantized() with FASTEMBED_QUANT_FP16 / BF16
+ * - Test fastembed_similarity_matrix_half() and fastembed_topk_half()
+ *   against the float functions on the widened corpus, across thread counts
+ * - Measure half vs float top-k throughput
+ *
+ * Compile: gcc -o test_half test_half.c -L../build -lfastembed -lm
+ * -I../include Run: LD_LIBRARY_PATH=.. ./test_half
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+static const char *level_name(int level) {
+  switch (level) {
+  case FASTEMBED_SIMD_SCALAR:
+    return "scalar";
+  case FASTEMBED_SIMD_SSE:
+    return "SSE";
+  case FASTEMBED_SIMD_NEON:
+    return "NEON";
+  case FASTEMBED_SIMD_AVX2:
+    return "AVX2";
+  case FASTEMBED_SIMD_AVX512:
+    return "AVX-512";
+  default:
+    return "unknown";
+  }
+}
+
+static void fill_random(float *v, int n) {
+  for (int i = 0; i < n; i++)
+    v[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static uint32_t bits_of(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+static float float_of(uint32_t u) {
+  float f;
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+/**
+ * Reference fp16 -> float by value: (-1)^s * 2^(e-15) * (1 + m/1024)
+ */
+static float reference_f16_to_f32(uint16_t h) {
+  int sign = h >> 15;
+  int exponent = (h >> 10) & 0x1F;
+  int mantissa = h & 0x3FF;
+  float value;
+  if (exponent == 0x1F)
+    value = mantissa ? NAN : INFINITY;
+  else if (exponent == 0)
+    value = ldexpf((float)mantissa, -24);
+  else
+    value = ldexpf((float)(mantissa | 0x400), exponent - 25);
+  return sign ? -value : value;
+}
+
+/**
+ * Reference float -> fp16: nearest of the two neighbouring halves, ties to
+ * the even one (searches the ordered half values)
+ */
+static uint16_t reference_f32_to_f16(float f) {
+  if (isnan(f))
+    return (uint16_t)((bits_of(f) >> 16 & 0x8000) | 0x7E00);
+  uint16_t sign = (uint16_t)(bits_of(f) >> 16 & 0x8000);
+  float a = fabsf(f);
+  /* Halves at or above 65520 round to infinity */
+  if (a >= 65520.0f)
+    return (uint16_t)(sign | 0x7C00);
+  uint16_t lo = 0, hi = 0x7BFF;
+  while (lo < hi) { /* Largest half <= a */
+    uint16_t mid = (uint16_t)((lo + hi + 1) / 2);
+    if (reference_f16_to_f32(mid) <= a)
+      lo = mid;
+    else
+      hi = (uint16_t)(mid - 1);
+  }
+  uint16_t below = lo;
+  if (reference_f16_to_f32(below) == a)
+    return (uint16_t)(sign | below);
+  uint16_t above = (uint16_t)(below + 1);
+  double d_below = (double)a - reference_f16_to_f32(below);
+  double d_above = (double)reference_f16_to_f32(above) - a;
+  uint16_t pick;
+  if (d_below < d_above)
+    pick = below;
+  else if (d_above < d_below)
+    pick = above;
+  else
+    pick = (below & 1) ? above : below;
+  return (uint16_t)(sign | pick);
+}
+
+/**
+ * Reference float -> bf16 with ties to even (NaN stays NaN)
+ */
+static uint16_t reference_f32_to_bf16(float f) {
+  uint32_t u = bits_of(f);
+  if (isnan(f))
+    return (uint16_t)((u >> 16) | 0x40);
+  uint32_t upper = u >> 16;
+  uint32_t lower = u & 0xFFFF;
+  if (lower > 0x8000 || (lower == 0x8000 && (upper & 1)))
+    upper++;
+  return (uint16_t)upper;
+}
+
+/**
+ * Random float with a wide spread of exponents (no NaN), so conversions
+ * see normals, half subnormals, overflow and exact ties
+ */
+static float random_wide_float(void) {
+  switch (rand() % 4) {
+  case 0:
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) *
+           ldexpf(1.0f, rand() % 40 - 30);
+  case 1: /* Exact halfway points between two halves */
+    return ldexpf((float)(2 * (rand() % 2048) + 1), rand() % 30 - 36) *
+           (rand() % 2 ? 1.0f : -1.0f);
+  case 2: /* Random bit patterns of finite normal floats */
+  {
+    uint32_t u = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    uint32_t exponent = 1 + (uint32_t)rand() % 254;
+    return float_of((u & 0x807FFFFF) | (exponent << 23));
+  }
+  default:
+    return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+}
+
+/**
+ * Compare all four conversions with the references at the current level
+ *
+ * @return Number of mismatches
+ */
+static int check_conversions(void) {
+  enum { MAX_N = 1100 };
+  static float input[MAX_N + 1], widened[MAX_N + 1];
+  static uint16_t halves[MAX_N + 1], codes[MAX_N + 1];
+  int failures = 0;
+
+  for (int i = 0; i <= MAX_N; i++) {
+    input[i] = random_wide_float();
+    codes[i] = (uint16_t)rand();
+  }
+
+  for (int n = 1; n <= MAX_N; n += (n < 70 ? 1 : 53)) {
+    /* Offset 1 exercises unaligned loads and stores */
+    for (int offset = 0; offset <= 1; offset++) {
+      if (n + offset > MAX_N + 1)
+        continue;
+      const float *in = input + offset;
+      const uint16_t *code = codes + offset;
+
+      fastembed_f32_to_f16(in, halves, n);
+      for (int i = 0; i < n; i++) {
+        if (halves[i] != reference_f32_to_f16(in[i])) {
+          printf("    f32->f16 mismatch at n %d i %d: %a -> 0x%04x\n", n, i,
+                 in[i], halves[i]);
+          failures++;
+          break;
+        }
+      }
+
+      fastembed_f32_to_bf16(in, halves, n);
+      for (int i = 0; i < n; i++) {
+        if (halves[i] != reference_f32_to_bf16(in[i])) {
+          printf("    f32->bf16 mismatch at n %d i %d\n", n, i);
+          failures++;
+          break;
+        }
+      }
+
+      fastembed_f16_to_f32(code, widened, n);
+      for (int i = 0; i < n; i++) {
+        float expected = reference_f16_to_f32(code[i]);
+        if (isnan(expected) ? !isnan(widened[i])
+                            : bits_of(widened[i]) != bits_of(expected)) {
+          printf("    f16->f32 mismatch at n %d i %d: 0x%04x\n", n, i,
+                 code[i]);
+          failures++;
+          break;
+        }
+      }
+
+      fastembed_bf16_to_f32(code, widened, n);
+      for (int i = 0; i < n; i++) {
+        if (bits_of(widened[i]) != (uint32_t)code[i] << 16) {
+          printf("    bf16->f32 mismatch at n %d i %d\n", n, i);
+          failures++;
+          break;
+        }
+      }
+    }
+  }
+
+  return failures;
+}
+
+/**
+ * Test: Conversions match the scalar references at every level
+ */
+static void test_conversions_all_levels(void) {
+  printf("\n=== Test: Half Conversions Match Reference ===\n");
+
+  int best = fastembed_get_simd_level();
+  const int levels[] = {FASTEMBED_SIMD_SSE, FASTEMBED_SIMD_AVX2,
+                        FASTEMBED_SIMD_AVX512};
+  int checked = 0;
+
+  for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+    if (best < FASTEMBED_SIMD_SSE || best == FASTEMBED_SIMD_NEON)
+      break; /* Single implementation, checked below */
+    if (levels[i] > best)
+      continue;
+    if (fastembed_set_simd_level(levels[i]) != levels[i])
+      continue;
+
+    char message[96];
+    snprintf(message, sizeof(message), "%s fp16 / bf16 conversions match",
+             level_name(levels[i]));
+    ASSERT_TRUE(check_conversions() == 0, message);
+    checked++;
+  }
+
+  if (checked == 0) {
+    char message[96];
+    snprintf(message, sizeof(message), "%s fp16 / bf16 conversions match",
+             level_name(best));
+    ASSERT_TRUE(check_conversions() == 0, message);
+  }
+
+  fastembed_set_simd_level(FASTEMBED_SIMD_AVX512);
+  ASSERT_EQ_INT(fastembed_get_simd_level(), best);
+}
+
+/**
+ * Test: Special values and rounding edge cases
+ */
+static void test_special_values(void) {
+  printf("\n=== Test: Half Special Values ===\n");
+
+  /* Longer than every vector width, so each value passes through the
+   * kernels as well as the scalar tail */
+  enum { N = 80 };
+  const float values[] = {0.0f,
+                          -0.0f,
+                          1.0f,
+                          -2.5f,
+                          65504.0f,           /* Largest half */
+                          65519.0f,           /* Rounds down to 65504 */
+                          65520.0f,           /* Rounds up to infinity */
+                          1e10f,              /* Overflow */
+                          ldexpf(1.0f, -24),  /* Smallest half subnormal */
+                          ldexpf(1.0f, -25),  /* Tie with zero: even = 0 */
+                          ldexpf(3.0f, -26),  /* Above the tie: rounds up */
+                          ldexpf(1.0f, -14),  /* Smallest half normal */
+                          1.0f + ldexpf(1.0f, -11), /* Tie: rounds to 1 */
+                          1.0f + ldexpf(3.0f, -11), /* Tie: rounds up */
+                          INFINITY,
+                          -INFINITY,
+                          NAN};
+  const uint16_t expected_f16[] = {0x0000, 0x8000, 0x3C00, 0xC100, 0x7BFF,
+                                   0x7BFF, 0x7C00, 0x7C00, 0x0001, 0x0000,
+                                   0x0001, 0x0400, 0x3C00, 0x3C02, 0x7C00,
+                                   0xFC00};
+  const int count = (int)(sizeof(values) / sizeof(values[0]));
+  float input[N];
+  uint16_t halves[N];
+  float widened[N];
+
+  for (int i = 0; i < N; i++)
+    input[i] = values[i % count];
+
+  ASSERT_EQ_INT(fastembed_f32_to_f16(input, halves, N), 0);
+  int mismatches = 0;
+  for (int i = 0; i < N; i++) {
+    int v = i % count;
+    if (isnan(values[v])) {
+      /* Quiet NaN: all exponent bits and the top mantissa bit set */
+      if ((halves[i] & 0x7E00) != 0x7E00)
+        mismatches++;
+    } else if (halves[i] != expected_f16[v]) {
+      printf("    %a -> 0x%04x (expected 0x%04x)\n", values[v], halves[i],
+             expected_f16[v]);
+      mismatches++;
+    }
+  }
+  ASSERT_TRUE(mismatches == 0, "fp16 rounding, overflow and NaN handling");
+
+  ASSERT_EQ_INT(fastembed_f16_to_f32(halves, widened, N), 0);
+  ASSERT_TRUE(widened[4] == 65504.0f && widened[8] == ldexpf(1.0f, -24) &&
+                  isinf(widened[6]) && isnan(widened[16]) &&
+                  signbit(widened[1]),
+              "fp16 widening keeps subnormals, signed zero, Inf and NaN");
+
+  ASSERT_EQ_INT(fastembed_f32_to_bf16(input, halves, N), 0);
+  ASSERT_EQ_INT(halves[2], 0x3F80);
+  ASSERT_EQ_INT(halves[7], 0x5015); /* 1e10 */
+  ASSERT_EQ_INT(halves[14], 0x7F80);
+  ASSERT_TRUE((halves[16] & 0x7FC0) == 0x7FC0, "bf16 keeps NaN quiet");
+
+  /* A NaN whose payload lives only in the low bits must stay a NaN */
+  float low_nan[N];
+  for (int i = 0; i < N; i++)
+    low_nan[i] = float_of(0x7F800001);
+  fastembed_f32_to_bf16(low_nan, halves, N);
+  fastembed_bf16_to_f32(halves, widened, N);
+  int nans = 0;
+  for (int i = 0; i < N; i++)
+    nans += isnan(widened[i]) != 0;
+  ASSERT_EQ_INT(nans, N);
+
+  ASSERT_EQ_INT(fastembed_f32_to_f16(NULL, halves, 4), -1);
+  ASSERT_EQ_INT(fastembed_f16_to_f32(halves, NULL, 4), -1);
+  ASSERT_EQ_INT(fastembed_f32_to_bf16(input, halves, 0), -1);
+  ASSERT_EQ_INT(fastembed_bf16_to_f32(halves, widened, -1), -1);
+}
+
+/**
+ * Test: Half-precision generation matches converting the float embedding
+ */
+static void test_generate_half(void) {
+  printf("\n=== Test: Half-Precision Generation ===\n");
+
+  const int dim = 768;
+  const char *text = "half precision embeddings";
+  float embedding[768];
+  uint16_t expected[768], halves[768];
+
+  ASSERT_EQ_INT(fastembed_generate(text, embedding, dim), 0);
+
+  fastembed_f32_to_f16(embedding, expected, dim);
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, halves, NULL, dim,
+                                             FASTEMBED_QUANT_FP16),
+                0);
+  ASSERT_TRUE(memcmp(halves, expected, sizeof(expected)) == 0,
+              "fp16 generation matches fastembed_f32_to_f16()");
+
+  fastembed_f32_to_bf16(embedding, expected, dim);
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, halves, NULL, dim,
+                                             FASTEMBED_QUANT_BF16),
+                0);
+  ASSERT_TRUE(memcmp(halves, expected, sizeof(expected)) == 0,
+              "bf16 generation matches fastembed_f32_to_bf16()");
+
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, halves, NULL, dim, 5), -1);
+}
+
+/**
+ * Test: Matrix and top-k on half corpora match the widened float corpus
+ */
+static void test_half_search(void) {
+  printf("\n=== Test: Half-Precision Matrix and Top-K ===\n");
+
+  const int formats[] = {FASTEMBED_QUANT_FP16, FASTEMBED_QUANT_BF16};
+  const int metrics[] = {FASTEMBED_METRIC_DOT, FASTEMBED_METRIC_COSINE,
+                         FASTEMBED_METRIC_EUCLIDEAN};
+  const int count = 1023, dim = 100, num_queries = 3, k = 10;
+
+  float *corpus = (float *)malloc((size_t)count * dim * sizeof(float));
+  float *widened = (float *)malloc((size_t)count * dim * sizeof(float));
+  uint16_t *halves =
+      (uint16_t *)malloc((size_t)count * dim * sizeof(uint16_t));
+  float *queries = (float *)malloc((size_t)num_queries * dim * sizeof(float));
+  float *expected = (float *)malloc((size_t)num_queries * count * sizeof(float));
+  float *actual = (float *)malloc((size_t)num_queries * count * sizeof(float));
+  fill_random(corpus, count * dim);
+  fill_random(queries, num_queries * dim);
+
+  for (size_t f = 0; f < 2; f++) {
+    int format = formats[f];
+    const char *name = format == FASTEMBED_QUANT_FP16 ? "fp16" : "bf16";
+    if (format == FASTEMBED_QUANT_FP16) {
+      fastembed_f32_to_f16(corpus, halves, count * dim);
+      fastembed_f16_to_f32(halves, widened, count * dim);
+    } else {
+      fastembed_f32_to_bf16(corpus, halves, count * dim);
+      fastembed_bf16_to_f32(halves, widened, count * dim);
+    }
+
+    for (size_t m = 0; m < 3; m++) {
+      int matrix_ok = 1, topk_ok = 1;
+      fastembed_similarity_matrix_threaded(queries, num_queries, widened,
+                                           count, dim, expected, metrics[m],
+                                           1);
+      for (int threads = 1; threads <= 4; threads += 3) {
+        if (fastembed_similarity_matrix_half(queries, num_queries, halves,
+                                             format, count, dim, actual,
+                                             metrics[m], threads) != 0) {
+          matrix_ok = 0;
+          continue;
+        }
+        for (int i = 0; i < num_queries * count; i++) {
+          if (fabsf(actual[i] - expected[i]) >
+              1e-4f * (1.0f + fabsf(expected[i])))
+            matrix_ok = 0;
+        }
+
+        int ids[10], ref_ids[10];
+        float scores[10], ref_scores[10];
+        int n = fastembed_topk_half(queries, halves, format, count, dim, k,
+                                    ids, scores, metrics[m], threads);
+        int ref = fastembed_topk_threaded(queries, widened, count, dim, k,
+                                          ref_ids, ref_scores, metrics[m], 1);
+        if (n != k || ref != k ||
+            memcmp(ids, ref_ids, sizeof(ids)) != 0 ||
+            memcmp(scores, ref_scores, sizeof(scores)) != 0)
+          topk_ok = 0;
+      }
+
+      char message[96];
+      snprintf(message, sizeof(message),
+               "%s matrix matches widened corpus (metric %d)", name,
+               metrics[m]);
+      ASSERT_TRUE(matrix_ok, message);
+      snprintf(message, sizeof(message),
+               "%s top-k matches widened corpus (metric %d)", name,
+               metrics[m]);
+      ASSERT_TRUE(topk_ok, message);
+    }
+  }
+
+  /* Rounding to half precision barely moves the ranking */
+  int exact_ids[10], half_ids[10];
+  float exact_scores[10], half_scores[10];
+  fastembed_f32_to_f16(corpus, halves, count * dim);
+  fastembed_topk_threaded(queries, corpus, count, dim, k, exact_ids,
+                          exact_scores, FASTEMBED_METRIC_COSINE, 1);
+  fastembed_topk_half(queries, halves, FASTEMBED_QUANT_FP16, count, dim, k,
+                      half_ids, half_scores, FASTEMBED_METRIC_COSINE, 1);
+  int hits = 0;
+  for (int i = 0; i < k; i++)
+    for (int j = 0; j < k; j++)
+      hits += exact_ids[i] == half_ids[j];
+  printf("  fp16 recall@%d vs float: %d/%d\n", k, hits, k);
+  ASSERT_TRUE(hits >= k - 1, "fp16 top-k recall@10 >= 0.9");
+
+  int ids[4];
+  float scores[4];
+  ASSERT_EQ_INT(fastembed_topk_half(queries, halves, 7, count, dim, 4, ids,
+                                    scores, FASTEMBED_METRIC_DOT, 1),
+                -1);
+  ASSERT_EQ_INT(fastembed_topk_half(queries, NULL, FASTEMBED_QUANT_FP16,
+                                    count, dim, 4, ids, scores,
+                                    FASTEMBED_METRIC_DOT, 1),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix_half(
+                    queries, num_queries, halves, FASTEMBED_QUANT_INT8, count,
+                    dim, actual, FASTEMBED_METRIC_DOT, 1),
+                -1);
+  ASSERT_EQ_INT(fastembed_topk_half(queries, halves, FASTEMBED_QUANT_BF16, 3,
+                                    dim, 4, ids, scores,
+                                    FASTEMBED_METRIC_COSINE, 1),
+                3);
+
+  free(corpus);
+  free(widened);
+  free(halves);
+  free(queries);
+  free(expected);
+  free(actual);
+}
+
+/**
+ * Benchmark: half vs float top-k
+ */
+static void benchmark_half_topk(void) {
+  printf("\n=== Benchmark: Half vs Float Top-K ===\n");
+
+  const int count = 20000, dim = 384, k = 10;
+  float *corpus = (float *)malloc((size_t)count * dim * sizeof(float));
+  uint16_t *halves =
+      (uint16_t *)malloc((size_t)count * dim * sizeof(uint16_t));
+  float query[384];
+  int ids[10];
+  float scores[10];
+  fill_random(corpus, count * dim);
+  fill_random(query, dim);
+  fastembed_f32_to_bf16(corpus, halves, count * dim);
+
+  clock_t start = clock();
+  for (int i = 0; i < 10; i++)
+    fastembed_topk_half(query, halves, FASTEMBED_QUANT_BF16, count, dim, k,
+                        ids, scores, FASTEMBED_METRIC_COSINE, 1);
+  double half_seconds = (double)(clock() - start) / CLOCKS_PER_SEC / 10;
+  start = clock();
+  for (int i = 0; i < 10; i++)
+    fastembed_topk(query, corpus, count, dim, k, ids, scores);
+  double float_seconds = (double)(clock() - start) / CLOCKS_PER_SEC / 10;
+  printf("  %d x %d: bf16 top-k %.3f ms (%zu MB), float top-k %.3f ms "
+         "(%zu MB)\n",
+         count, dim, half_seconds * 1e3,
+         (size_t)count * dim * sizeof(uint16_t) >> 20, float_seconds * 1e3,
+         (size_t)count * dim * sizeof(float) >> 20);
+
+  free(corpus);
+  free(halves);
+}
+
+int main() {
+  printf("FastEmbed Half-Precision Tests\n");
+  printf("==============================\n");
+
+  srand(42);
+
+  test_conversions_all_levels();
+  test_special_values();
+  test_generate_half();
+  test_half_search();
+  benchmark_half_topk();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
@@ -5,6 +5,8 @@
  * - positional_hash_asm: Positional hashing with character position weighting
  * - hash_to_float_sqrt_asm: Square Root normalization to [-1, 1] range
  * - generate_combined_hash_asm: Combined hashing for better distribution
+ * - generate_embedding_asm: Single-pass generator matches the per-dimension
+ *   hash functions bit for bit
  *
  * Compile: gcc -o test_hash_functions test_hash_functions.c -L../build
  * -lfastembed -lm -I../include Run: LD_LIBRARY_PATH=.. ./test_hash_functions
@@ -305,6 +307,53 @@ void test_combined_hash_seed_sensitive() {
   printf("  Seed 1 hash: %llu\n", (unsigned long long)hash2);
 }
 
+/**
+ * Test: generate_embedding_asm - Same bits as hashing every dimension
+ */
+void test_embedding_matches_per_dimension_hash() {
+  printf("\n=== Test: generate_embedding_asm - Matches Per-Dimension Hash ===\n");
+
+  static char long_text[8192 + 2];
+  for (int i = 0; i < 8192; i++) {
+    long_text[i] = (char)(32 + (i * 7919) % 95);
+  }
+  long_text[8192] = '\0';
+
+  const char *texts[] = {"a", "hello world",
+                         "the quick brown fox jumps over the lazy dog",
+                         "caf\xc3\xa9 \xff\x80", long_text};
+  int num_texts = sizeof(texts) / sizeof(texts[0]);
+  int dims[] = {128, 256, 512, 768, 1024, 2048};
+  float output[2048];
+
+  int mismatches = 0;
+  for (int t = 0; t < num_texts; t++) {
+    int text_length = (int)strlen(texts[t]);
+    for (int d = 0; d < 6; d++) {
+      if (generate_embedding_asm(texts[t], output, dims[d]) != 0) {
+        mismatches++;
+        continue;
+      }
+      for (int i = 0; i < dims[d]; i++) {
+        float expected = hash_to_float_sqrt_asm(
+            generate_combined_hash_asm(texts[t], text_length, i));
+        if (memcmp(&expected, &output[i], sizeof(float)) != 0) {
+          mismatches++;
+        }
+      }
+    }
+  }
+  ASSERT_EQ_INT(mismatches, 0);
+
+  /* Length limit and invalid arguments */
+  long_text[8192] = 'x';
+  long_text[8193] = '\0';
+  ASSERT_EQ_INT(generate_embedding_asm(long_text, output, 128), -1);
+  ASSERT_EQ_INT(generate_embedding_asm("", output, 128), -1);
+  ASSERT_EQ_INT(generate_embedding_asm("abc", output, 100), -1);
+  ASSERT_EQ_INT(generate_embedding_asm("abc", NULL, 128), -1);
+}
+
 int main() {
   printf("FastEmbed Hash Functions Unit Tests\n");
   printf("===================================\n");
@@ -324,6 +373,9 @@ int main() {
   test_combined_hash_distribution();
   test_combined_hash_seed_sensitive();
 
+  /* Test generate_embedding_asm */
+  test_embedding_matches_per_dimension_hash();
+
   printf("\n=== Test Summary ===\n");
   printf("Tests run: %d\n", tests_run);
   printf("Tests passed: %d\n", tests_passed);
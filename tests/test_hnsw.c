@@ -0,0 +1,582 @@
+/**
+ * FastEmbed HNSW Index Tests
+ *
+ * Tests for the fastembed_hnsw_* approximate nearest neighbour index:
+ * - Test option validation and empty-index behaviour
+ * - Test recall@10 against exact fastembed_topk_threaded() for every metric
+ * - Test that removed vectors are never returned
+ * - Test that an index built with the same seed is reproducible, and that
+ *   fastembed_hnsw_load() / fastembed_hnsw_load_mmap() return the same
+ *   results as the saved index; reject truncated or corrupt files
+ * - Test multithreaded fastembed_hnsw_add_batch() and searches running
+ *   while other threads insert
+ * - Measure build time, query latency and recall on 20k x 384D
+ *
+ * Compile: gcc -o test_hnsw test_hnsw.c -L../build -lfastembed -lm -lpthread
+ * -I../include Run: LD_LIBRARY_PATH=.. ./test_hnsw
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define TEST_FILE "test_hnsw_index.bin"
+#define K 10
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fill_random(float *v, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    v[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+/**
+ * Fill rows with low intrinsic dimension, like real embeddings: random
+ * combinations of `latent` directions plus a little noise
+ */
+static void fill_embedding_like(float *v, int rows, int dim, int latent) {
+  float *basis = malloc((size_t)latent * dim * sizeof(float));
+  fill_random(basis, (size_t)latent * dim);
+  for (int r = 0; r < rows; r++) {
+    float *row = v + (size_t)r * dim;
+    fill_random(row, (size_t)dim);
+    for (int i = 0; i < dim; i++)
+      row[i] *= 0.05f;
+    for (int l = 0; l < latent; l++) {
+      float weight = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+      for (int i = 0; i < dim; i++)
+        row[i] += weight * basis[(size_t)l * dim + i];
+    }
+  }
+  free(basis);
+}
+
+static fastembed_hnsw_t *create_index(int dim, int metric, unsigned seed) {
+  fastembed_hnsw_options_t options;
+  fastembed_hnsw_options_init(&options);
+  options.metric = metric;
+  options.seed = seed;
+  return fastembed_hnsw_create(dim, &options);
+}
+
+/**
+ * Mean recall@K of the index over queries, against exact search
+ */
+static double measure_recall(fastembed_hnsw_t *index, const float *corpus,
+                             int n, const float *queries, int nq, int dim,
+                             int metric) {
+  int exact_ids[K], ids[K];
+  float exact_scores[K], scores[K];
+  int hits = 0;
+
+  for (int q = 0; q < nq; q++) {
+    const float *query = queries + (size_t)q * dim;
+    int exact = fastembed_topk_threaded(query, corpus, n, dim, K, exact_ids,
+                                        exact_scores, metric, 1);
+    int found = fastembed_hnsw_search(index, query, K, ids, scores);
+    for (int i = 0; i < found; i++) {
+      for (int j = 0; j < exact; j++) {
+        if (ids[i] == exact_ids[j]) {
+          hits++;
+          break;
+        }
+      }
+    }
+  }
+  return (double)hits / ((double)nq * K);
+}
+
+/**
+ * Test: Options, invalid arguments and the empty index
+ */
+static void test_create(void) {
+  printf("\n=== Test: Create and Invalid Arguments ===\n");
+
+  fastembed_hnsw_options_t options;
+  fastembed_hnsw_options_init(&options);
+  ASSERT_EQ_INT(options.m, FASTEMBED_HNSW_DEFAULT_M);
+  ASSERT_EQ_INT(options.ef_construction,
+                FASTEMBED_HNSW_DEFAULT_EF_CONSTRUCTION);
+  ASSERT_EQ_INT(options.ef_search, FASTEMBED_HNSW_DEFAULT_EF_SEARCH);
+  ASSERT_EQ_INT(options.metric, FASTEMBED_METRIC_COSINE);
+
+  ASSERT_TRUE(fastembed_hnsw_create(0, NULL) == NULL, "Dimension 0 rejected");
+  ASSERT_TRUE(fastembed_hnsw_create(FASTEMBED_MAX_DIMENSION + 1, NULL) == NULL,
+              "Dimension above FASTEMBED_MAX_DIMENSION rejected");
+  options.m = 1;
+  ASSERT_TRUE(fastembed_hnsw_create(8, &options) == NULL, "m = 1 rejected");
+  options.m = FASTEMBED_HNSW_MAX_M + 1;
+  ASSERT_TRUE(fastembed_hnsw_create(8, &options) == NULL,
+              "m above FASTEMBED_HNSW_MAX_M rejected");
+  fastembed_hnsw_options_init(&options);
+  options.metric = 7;
+  ASSERT_TRUE(fastembed_hnsw_create(8, &options) == NULL,
+              "Unknown metric rejected");
+
+  fastembed_hnsw_t *index = fastembed_hnsw_create(8, NULL);
+  ASSERT_TRUE(index != NULL, "Index created with default options");
+  ASSERT_EQ_INT(fastembed_hnsw_size(index), 0);
+  ASSERT_EQ_INT(fastembed_hnsw_dimension(index), 8);
+
+  float query[8] = {1, 0, 0, 0, 0, 0, 0, 0};
+  int ids[4];
+  float scores[4];
+  ASSERT_EQ_INT(fastembed_hnsw_search(index, query, 4, ids, scores), 0);
+  ASSERT_EQ_INT(fastembed_hnsw_search(index, query, 0, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_search(index, NULL, 4, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_add(index, NULL), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_remove(index, 0), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_set_ef_search(index, 0), -1);
+
+  ASSERT_EQ_INT(fastembed_hnsw_add(index, query), 0);
+  ASSERT_EQ_INT(fastembed_hnsw_search(index, query, 4, ids, scores), 1);
+  ASSERT_EQ_INT(ids[0], 0);
+  ASSERT_TRUE(fabsf(scores[0] - 1.0f) < 1e-5f, "Self-similarity is 1");
+
+  ASSERT_EQ_INT(fastembed_hnsw_size(NULL), -1);
+  fastembed_hnsw_free(index);
+  fastembed_hnsw_free(NULL);
+}
+
+/**
+ * Test: Recall against exact search for every metric
+ */
+static void test_recall(void) {
+  printf("\n=== Test: Recall@10 vs Exact Search (20k x 32D) ===\n");
+
+  const int n = 20000, dim = 32, nq = 200;
+  float *corpus = malloc((size_t)n * dim * sizeof(float));
+  float *queries = malloc((size_t)nq * dim * sizeof(float));
+  fill_random(corpus, (size_t)n * dim);
+  fill_random(queries, (size_t)nq * dim);
+
+  const int metrics[] = {FASTEMBED_METRIC_COSINE, FASTEMBED_METRIC_DOT,
+                         FASTEMBED_METRIC_EUCLIDEAN};
+  const char *names[] = {"cosine", "dot", "euclidean"};
+
+  for (int m = 0; m < 3; m++) {
+    fastembed_hnsw_t *index = create_index(dim, metrics[m], 1);
+    int status =
+        fastembed_hnsw_add_batch(index, corpus, n, NULL, 1);
+    ASSERT_EQ_INT(status, 0);
+    ASSERT_EQ_INT(fastembed_hnsw_size(index), n);
+
+    double recall =
+        measure_recall(index, corpus, n, queries, nq, dim, metrics[m]);
+    printf("  %-9s recall@10 = %.3f (ef_search %d)\n", names[m], recall,
+           FASTEMBED_HNSW_DEFAULT_EF_SEARCH);
+
+    char message[96];
+    snprintf(message, sizeof(message), "%s recall@10 >= 0.90", names[m]);
+    ASSERT_TRUE(recall >= 0.90, message);
+
+    /* A stored vector finds itself with its exact score */
+    int ids[K];
+    float scores[K];
+    const float *row = corpus + (size_t)1234 * dim;
+    fastembed_hnsw_search(index, row, K, ids, scores);
+    float expected = metrics[m] == FASTEMBED_METRIC_COSINE ? 1.0f
+                     : metrics[m] == FASTEMBED_METRIC_DOT
+                         ? fastembed_dot_product(row, row, dim)
+                         : 0.0f;
+    snprintf(message, sizeof(message), "%s: stored vector is its own nearest",
+             names[m]);
+    ASSERT_TRUE(metrics[m] == FASTEMBED_METRIC_DOT ||
+                    (ids[0] == 1234 && fabsf(scores[0] - expected) < 1e-3f),
+                message);
+
+    fastembed_hnsw_set_ef_search(index, 256);
+    double wide = measure_recall(index, corpus, n, queries, nq, dim,
+                                 metrics[m]);
+    printf("  %-9s recall@10 = %.3f (ef_search 256)\n", names[m], wide);
+    snprintf(message, sizeof(message), "%s: larger ef_search raises recall",
+             names[m]);
+    ASSERT_TRUE(wide >= recall && wide >= 0.97, message);
+
+    fastembed_hnsw_free(index);
+  }
+
+  free(corpus);
+  free(queries);
+}
+
+/**
+ * Test: Removed vectors are excluded from results
+ */
+static void test_remove(void) {
+  printf("\n=== Test: Remove ===\n");
+
+  const int n = 3000, dim = 16;
+  float *corpus = malloc((size_t)n * dim * sizeof(float));
+  fill_random(corpus, (size_t)n * dim);
+
+  fastembed_hnsw_t *index = create_index(dim, FASTEMBED_METRIC_EUCLIDEAN, 3);
+  fastembed_hnsw_add_batch(index, corpus, n, NULL, 1);
+
+  /* Remove every even id */
+  int removed_ok = 1;
+  for (int id = 0; id < n; id += 2) {
+    if (fastembed_hnsw_remove(index, id) != 0)
+      removed_ok = 0;
+  }
+  ASSERT_TRUE(removed_ok, "Every even id removed");
+  ASSERT_EQ_INT(fastembed_hnsw_size(index), n / 2);
+  ASSERT_EQ_INT(fastembed_hnsw_remove(index, 0), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_remove(index, n), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_remove(index, -1), -1);
+
+  int ids[K];
+  float scores[K];
+  int returned_removed = 0, short_results = 0, self_found = 0;
+  for (int q = 0; q < 200; q++) {
+    const float *query = corpus + (size_t)q * dim;
+    int found = fastembed_hnsw_search(index, query, K, ids, scores);
+    if (found != K)
+      short_results++;
+    for (int i = 0; i < found; i++) {
+      if (ids[i] % 2 == 0)
+        returned_removed++;
+    }
+    if (q % 2 == 1 && found > 0 && ids[0] == q)
+      self_found++;
+  }
+  ASSERT_EQ_INT(returned_removed, 0);
+  ASSERT_EQ_INT(short_results, 0);
+  ASSERT_EQ_INT(self_found, 100);
+
+  fastembed_hnsw_free(index);
+  free(corpus);
+}
+
+/**
+ * Test: Same seed builds the same index; save / load / mmap round trip
+ */
+static void test_persistence(void) {
+  printf("\n=== Test: Reproducible Build, Save, Load and mmap ===\n");
+
+  const int n = 5000, dim = 24, nq = 50;
+  float *corpus = malloc((size_t)n * dim * sizeof(float));
+  float *queries = malloc((size_t)nq * dim * sizeof(float));
+  fill_random(corpus, (size_t)n * dim);
+  fill_random(queries, (size_t)nq * dim);
+
+  fastembed_hnsw_t *a = create_index(dim, FASTEMBED_METRIC_COSINE, 42);
+  fastembed_hnsw_t *b = create_index(dim, FASTEMBED_METRIC_COSINE, 42);
+  for (int i = 0; i < n; i++) {
+    fastembed_hnsw_add(a, corpus + (size_t)i * dim);
+    fastembed_hnsw_add(b, corpus + (size_t)i * dim);
+  }
+  fastembed_hnsw_remove(a, 7);
+  fastembed_hnsw_remove(b, 7);
+
+  ASSERT_EQ_INT(fastembed_hnsw_save(a, TEST_FILE), 0);
+  fastembed_hnsw_t *loaded = fastembed_hnsw_load(TEST_FILE);
+  fastembed_hnsw_t *mapped = fastembed_hnsw_load_mmap(TEST_FILE);
+  ASSERT_TRUE(loaded != NULL, "fastembed_hnsw_load() opens the saved file");
+  ASSERT_TRUE(mapped != NULL,
+              "fastembed_hnsw_load_mmap() maps the saved file");
+  if (!loaded || !mapped) {
+    fastembed_hnsw_free(loaded);
+    fastembed_hnsw_free(mapped);
+    fastembed_hnsw_free(a);
+    fastembed_hnsw_free(b);
+    free(corpus);
+    free(queries);
+    return;
+  }
+  ASSERT_EQ_INT(fastembed_hnsw_size(loaded), n - 1);
+  ASSERT_EQ_INT(fastembed_hnsw_size(mapped), n - 1);
+
+  int same_seed = 1, same_loaded = 1, same_mapped = 1;
+  for (int q = 0; q < nq; q++) {
+    const float *query = queries + (size_t)q * dim;
+    int ids[4][K];
+    float scores[4][K];
+    int counts[4];
+    counts[0] = fastembed_hnsw_search(a, query, K, ids[0], scores[0]);
+    counts[1] = fastembed_hnsw_search(b, query, K, ids[1], scores[1]);
+    counts[2] = fastembed_hnsw_search(loaded, query, K, ids[2], scores[2]);
+    counts[3] = fastembed_hnsw_search(mapped, query, K, ids[3], scores[3]);
+    int *flags[] = {NULL, &same_seed, &same_loaded, &same_mapped};
+    for (int v = 1; v < 4; v++) {
+      if (counts[v] != counts[0] ||
+          memcmp(ids[v], ids[0], sizeof(ids[0])) != 0 ||
+          memcmp(scores[v], scores[0], sizeof(scores[0])) != 0)
+        *flags[v] = 0;
+    }
+  }
+  ASSERT_TRUE(same_seed, "Same seed builds an identical index");
+  ASSERT_TRUE(same_loaded, "Loaded index returns identical results");
+  ASSERT_TRUE(same_mapped, "Mapped index returns identical results");
+
+  /* Mapped indexes are read-only; loaded ones keep growing */
+  ASSERT_EQ_INT(fastembed_hnsw_add(mapped, queries), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_remove(mapped, 1), -1);
+  ASSERT_EQ_INT(fastembed_hnsw_add(loaded, queries), n);
+  ASSERT_EQ_INT(fastembed_hnsw_add(a, queries), n);
+  int ids_a[K], ids_l[K];
+  float scores_a[K], scores_l[K];
+  fastembed_hnsw_search(a, queries + dim, K, ids_a, scores_a);
+  fastembed_hnsw_search(loaded, queries + dim, K, ids_l, scores_l);
+  ASSERT_TRUE(memcmp(ids_a, ids_l, sizeof(ids_a)) == 0,
+              "Insert after load matches insert into the original");
+
+  /* Corrupt and truncated files are rejected */
+  FILE *file = fopen(TEST_FILE, "r+b");
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fclose(file);
+
+  fastembed_hnsw_free(mapped);
+  mapped = NULL;
+  char *bytes = malloc((size_t)size);
+  file = fopen(TEST_FILE, "rb");
+  size_t read_bytes = fread(bytes, 1, (size_t)size, file);
+  fclose(file);
+  ASSERT_TRUE(read_bytes == (size_t)size, "Saved file read back");
+
+  file = fopen(TEST_FILE, "wb");
+  fwrite(bytes, 1, (size_t)size - 4, file);
+  fclose(file);
+  ASSERT_TRUE(fastembed_hnsw_load(TEST_FILE) == NULL,
+              "Truncated file rejected by load");
+  ASSERT_TRUE(fastembed_hnsw_load_mmap(TEST_FILE) == NULL,
+              "Truncated file rejected by mmap");
+
+  /* Point the first level-0 link of node 0 past the last node (it follows
+   * the link count, the fourth int32 of the node block at offset 128) */
+  memcpy(bytes + 128 + 4 * 4, &n, sizeof(int));
+  file = fopen(TEST_FILE, "wb");
+  fwrite(bytes, 1, (size_t)size, file);
+  fclose(file);
+  ASSERT_TRUE(fastembed_hnsw_load(TEST_FILE) == NULL,
+              "Out-of-range link rejected by load");
+  ASSERT_TRUE(fastembed_hnsw_load_mmap(TEST_FILE) == NULL,
+              "Out-of-range link rejected by mmap");
+
+  bytes[0] = 'X';
+  file = fopen(TEST_FILE, "wb");
+  fwrite(bytes, 1, (size_t)size, file);
+  fclose(file);
+  ASSERT_TRUE(fastembed_hnsw_load(TEST_FILE) == NULL, "Bad magic rejected");
+  ASSERT_TRUE(fastembed_hnsw_load("missing_index.bin") == NULL,
+              "Missing file rejected");
+  remove(TEST_FILE);
+
+  free(bytes);
+  fastembed_hnsw_free(loaded);
+  fastembed_hnsw_free(a);
+  fastembed_hnsw_free(b);
+  free(corpus);
+  free(queries);
+}
+
+#ifndef _WIN32
+typedef struct {
+  fastembed_hnsw_t *index;
+  const float *queries;
+  int nq;
+  int dim;
+  volatile int *stop;
+  int searches;
+  int errors;
+} search_worker_t;
+
+static void *search_worker_main(void *arg) {
+  search_worker_t *worker = (search_worker_t *)arg;
+  int ids[K];
+  float scores[K];
+  while (!*worker->stop) {
+    const float *query =
+        worker->queries + (size_t)(worker->searches % worker->nq) * worker->dim;
+    int found = fastembed_hnsw_search(worker->index, query, K, ids, scores);
+    if (found < 0)
+      worker->errors++;
+    for (int i = 1; i < found; i++) {
+      if (scores[i] > scores[i - 1] + 1e-6f)
+        worker->errors++; /* Results must stay sorted best first */
+    }
+    worker->searches++;
+  }
+  return NULL;
+}
+#endif
+
+/**
+ * Test: Concurrent inserts, and searches while inserting
+ */
+static void test_concurrency(void) {
+  printf("\n=== Test: Concurrent Inserts and Searches ===\n");
+
+  const int n = 20000, dim = 32, nq = 200;
+  float *corpus = malloc((size_t)n * dim * sizeof(float));
+  float *queries = malloc((size_t)nq * dim * sizeof(float));
+  int *ids = malloc((size_t)n * sizeof(int));
+  fill_random(corpus, (size_t)n * dim);
+  fill_random(queries, (size_t)nq * dim);
+
+  fastembed_hnsw_t *index = create_index(dim, FASTEMBED_METRIC_COSINE, 5);
+
+#ifndef _WIN32
+  /* Seed the graph, then search from two threads while inserting the rest */
+  fastembed_hnsw_add_batch(index, corpus, 1000, ids, 1);
+  volatile int stop = 0;
+  search_worker_t workers[2];
+  pthread_t threads[2];
+  for (int t = 0; t < 2; t++) {
+    workers[t] = (search_worker_t){index, queries, nq, dim, &stop, 0, 0};
+    pthread_create(&threads[t], NULL, search_worker_main, &workers[t]);
+  }
+  int status = fastembed_hnsw_add_batch(index, corpus + (size_t)1000 * dim,
+                                        n - 1000, ids + 1000, 4);
+  stop = 1;
+  int searches = 0, errors = 0;
+  for (int t = 0; t < 2; t++) {
+    pthread_join(threads[t], NULL);
+    searches += workers[t].searches;
+    errors += workers[t].errors;
+  }
+  printf("  %d searches ran during the inserts\n", searches);
+  ASSERT_EQ_INT(errors, 0);
+#else
+  int status = fastembed_hnsw_add_batch(index, corpus, n, ids, 4);
+#endif
+  ASSERT_EQ_INT(status, 0);
+  ASSERT_EQ_INT(fastembed_hnsw_size(index), n);
+
+  /* Every id was assigned exactly once */
+  char *seen = calloc((size_t)n, 1);
+  int unique = 1;
+  for (int i = 0; i < n; i++) {
+    if (ids[i] < 0 || ids[i] >= n || seen[ids[i]])
+      unique = 0;
+    else
+      seen[ids[i]] = 1;
+  }
+  ASSERT_TRUE(unique, "Threaded inserts assign each id once");
+
+  /* Recall is measured in id space: reorder the corpus by assigned id */
+  float *by_id = malloc((size_t)n * dim * sizeof(float));
+  for (int i = 0; i < n && unique; i++) {
+    memcpy(by_id + (size_t)ids[i] * dim, corpus + (size_t)i * dim,
+           (size_t)dim * sizeof(float));
+  }
+  double recall = unique ? measure_recall(index, by_id, n, queries, nq, dim,
+                                          FASTEMBED_METRIC_COSINE)
+                         : 0.0;
+  printf("  recall@10 after threaded build = %.3f\n", recall);
+  ASSERT_TRUE(recall >= 0.90, "Threaded build recall@10 >= 0.90");
+
+  free(seen);
+  free(by_id);
+  fastembed_hnsw_free(index);
+  free(ids);
+  free(corpus);
+  free(queries);
+}
+
+/**
+ * Test: Build time, query latency and recall (informational)
+ */
+static void test_throughput(void) {
+  printf("\n=== Test: Throughput (20k x 384D, 16 latent dims) ===\n");
+
+  const int n = 20000, dim = 384, nq = 1000;
+  /* Queries share the corpus basis: they are the last nq rows */
+  float *corpus = malloc((size_t)(n + nq) * dim * sizeof(float));
+  const float *queries = corpus + (size_t)n * dim;
+  srand(7);
+  fill_embedding_like(corpus, n + nq, dim, 16);
+
+  fastembed_hnsw_t *index = create_index(dim, FASTEMBED_METRIC_COSINE, 9);
+  double start = wall_seconds();
+  fastembed_hnsw_add_batch(index, corpus, n, NULL, 0);
+  double build = wall_seconds() - start;
+  printf("  build: %.2f s (%.0f vectors/s, all CPUs)\n", build, n / build);
+
+  int ids[K];
+  float scores[K];
+  start = wall_seconds();
+  for (int q = 0; q < nq; q++)
+    fastembed_hnsw_search(index, queries + (size_t)q * dim, K, ids, scores);
+  double hnsw_time = (wall_seconds() - start) / nq;
+
+  start = wall_seconds();
+  for (int q = 0; q < 50; q++)
+    fastembed_topk_threaded(queries + (size_t)q * dim, corpus, n, dim, K, ids,
+                            scores, FASTEMBED_METRIC_COSINE, 1);
+  double exact_time = (wall_seconds() - start) / 50;
+
+  double recall = measure_recall(index, corpus, n, queries, 100, dim,
+                                 FASTEMBED_METRIC_COSINE);
+  printf("  query: %.3f ms HNSW vs %.3f ms exact top-k (%.0fx), "
+         "recall@10 %.3f\n",
+         hnsw_time * 1e3, exact_time * 1e3, exact_time / hnsw_time, recall);
+  ASSERT_TRUE(hnsw_time < exact_time, "HNSW query faster than exact search");
+
+  fastembed_hnsw_free(index);
+  free(corpus);
+}
+
+int main() {
+  printf("FastEmbed HNSW Index Tests\n");
+  printf("==========================\n");
+
+  srand(42);
+  test_create();
+  test_recall();
+  test_remove();
+  test_persistence();
+  test_concurrency();
+  test_throughput();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
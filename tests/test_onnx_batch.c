@@ -0,0 +1,1284 @@
+/**
+ * FastEmbed ONNX Batch Inference Tests
+ *
+ * Tests for batched ONNX embedding generation:
+ * - Test batch results match per-text results (padding is masked out)
+ * - Test output order across multiple inference groups
+ * - Test output normalization
+ * - Test length-bucketed scheduling under different token budgets
+ * - Test repeated calls reusing inference contexts give identical results
+ * - Test fastembed_model_batch_generate_parallel() matches per-text results
+ *   and reports failing texts per item
+ * - Test fastembed_model_batch_generate_contiguous() matches the pointer-array
+ *   batch and zeroes rows of bad spans
+ * - Test float16 / bfloat16 model outputs are widened and pooled like float
+ * - Test chunked documents: window layout, per-window embeddings, pooled
+ *   document vector, piecewise feeding and callback abort
+ * - Test pipelined batches: output matrix, callback, int8 and store sinks
+ *   against the parallel batch, callback abort and option validation
+ * - Test input validation
+ *
+ * Compile: gcc -o test_onnx_batch test_onnx_batch.c -L../build
+ * -lfastembed -lm -I../include -DUSE_ONNX_RUNTIME Run: LD_LIBRARY_PATH=..
+ * ./test_onnx_batch
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EPSILON 0.0001f
+#define MODEL_PATH "models/test.onnx" /* Placeholder - adjust as needed */
+/* float16 export of MODEL_PATH (e.g. onnxconverter_common.float16) */
+#define HALF_MODEL_PATH "models/test_fp16.onnx"
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_NE_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) != (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s != %d (value: %d)\n", #actual, (int)(expected),     \
+             (int)(actual));                                                   \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s equals %d\n", #actual, (int)(expected));            \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define SKIP(message)                                                          \
+  do {                                                                         \
+    printf("  ⚠ SKIP: %s\n", message);                                        \
+    tests_run++;                                                               \
+    tests_passed++; /* Don't fail if model not available */                    \
+  } while (0)
+
+/**
+ * Returns model dimension, or -1 (and records a skip) if unavailable
+ */
+static int require_model(void) {
+  FILE *f = fopen(MODEL_PATH, "r");
+  if (f == NULL) {
+    printf("  ⚠ SKIP: Test model not found at %s\n", MODEL_PATH);
+    tests_run++;
+    tests_passed++;
+    return -1;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(MODEL_PATH);
+  if (dimension <= 0) {
+    SKIP("Cannot get model dimension");
+    return -1;
+  }
+  return dimension;
+}
+
+/**
+ * Allocates num_texts output vectors of the given dimension
+ */
+static float **alloc_outputs(int num_texts, int dimension) {
+  float **outputs = (float **)calloc(num_texts, sizeof(float *));
+  if (outputs == NULL)
+    return NULL;
+  for (int i = 0; i < num_texts; i++) {
+    outputs[i] = (float *)calloc(dimension, sizeof(float));
+    if (outputs[i] == NULL) {
+      for (int j = 0; j < i; j++)
+        free(outputs[j]);
+      free(outputs);
+      return NULL;
+    }
+  }
+  return outputs;
+}
+
+static void free_outputs(float **outputs, int num_texts) {
+  if (outputs == NULL)
+    return;
+  for (int i = 0; i < num_texts; i++)
+    free(outputs[i]);
+  free(outputs);
+}
+
+/**
+ * Max absolute difference between batch output and per-text generation
+ */
+static float max_diff_vs_single(const char **texts, float **outputs,
+                                int num_texts, int dimension) {
+  float max_diff = 0.0f;
+  float *single = (float *)malloc(dimension * sizeof(float));
+  if (single == NULL)
+    return INFINITY;
+
+  for (int i = 0; i < num_texts; i++) {
+    if (fastembed_onnx_generate(MODEL_PATH, texts[i], single, dimension) != 0) {
+      free(single);
+      return INFINITY;
+    }
+    for (int d = 0; d < dimension; d++) {
+      float diff = fabsf(single[d] - outputs[i][d]);
+      if (diff > max_diff)
+        max_diff = diff;
+    }
+  }
+
+  free(single);
+  return max_diff;
+}
+
+/**
+ * Test: Batch output matches per-text output for mixed lengths
+ */
+void test_batch_matches_single() {
+  printf("\n=== Test: Batch Matches Single-Text Inference ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  const char *texts[] = {
+      "short",
+      "a somewhat longer sentence with several more words in it",
+      "",
+      "medium length text here",
+      "The quick brown fox jumps over the lazy dog, again and again and "
+      "again until the sequence is clearly the longest one in the batch.",
+  };
+  int num_texts = sizeof(texts) / sizeof(texts[0]);
+
+  float **outputs = alloc_outputs(num_texts, dimension);
+  if (outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    return;
+  }
+
+  int result = fastembed_onnx_batch_generate(MODEL_PATH, texts, num_texts,
+                                             outputs, dimension);
+  ASSERT_EQ_INT(result, 0);
+
+  float max_diff = max_diff_vs_single(texts, outputs, num_texts, dimension);
+  printf("  Max difference vs single-text inference: %g\n", max_diff);
+  ASSERT_TRUE(max_diff < EPSILON, "Padded batch matches per-text results");
+
+  free_outputs(outputs, num_texts);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Output order is preserved across several inference groups
+ */
+void test_batch_order_multiple_groups() {
+  printf("\n=== Test: Batch Order Across Multiple Groups ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  /* More texts than fit into one inference group */
+  int num_texts = FASTEMBED_ONNX_MAX_BATCH_SIZE * 2 + 5;
+  char(*storage)[64] = malloc(num_texts * sizeof(*storage));
+  const char **texts = (const char **)malloc(num_texts * sizeof(char *));
+  float **outputs = alloc_outputs(num_texts, dimension);
+  if (storage == NULL || texts == NULL || outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free(storage);
+    free(texts);
+    free_outputs(outputs, num_texts);
+    return;
+  }
+
+  for (int i = 0; i < num_texts; i++) {
+    /* Vary length so every group needs padding */
+    snprintf(storage[i], sizeof(storage[i]), "document %d%s", i,
+             (i % 3 == 0) ? " with a few extra words" : "");
+    texts[i] = storage[i];
+  }
+
+  int result = fastembed_onnx_batch_generate(MODEL_PATH, texts, num_texts,
+                                             outputs, dimension);
+  ASSERT_EQ_INT(result, 0);
+
+  float max_diff = max_diff_vs_single(texts, outputs, num_texts, dimension);
+  printf("  Texts: %d (group size %d), max difference: %g\n", num_texts,
+         FASTEMBED_ONNX_MAX_BATCH_SIZE, max_diff);
+  ASSERT_TRUE(max_diff < EPSILON, "Outputs are returned in input order");
+
+  free(storage);
+  free(texts);
+  free_outputs(outputs, num_texts);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Batch outputs are L2-normalized, auto-detect dimension works
+ */
+void test_batch_normalized() {
+  printf("\n=== Test: Batch Output Normalization ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  const char *texts[] = {"first text", "second text", "third"};
+  int num_texts = 3;
+  float **outputs = alloc_outputs(num_texts, dimension);
+  if (outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    return;
+  }
+
+  /* dimension = 0 auto-detects from the model */
+  int result =
+      fastembed_onnx_batch_generate(MODEL_PATH, texts, num_texts, outputs, 0);
+  ASSERT_EQ_INT(result, 0);
+
+  int all_unit = 1;
+  for (int i = 0; i < num_texts; i++) {
+    float norm = fastembed_vector_norm(outputs[i], dimension);
+    if (fabsf(norm - 1.0f) > 0.001f)
+      all_unit = 0;
+  }
+  ASSERT_TRUE(all_unit, "All batch outputs have unit norm");
+
+  free_outputs(outputs, num_texts);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Length-bucketed scheduling keeps results and order intact
+ */
+void test_batch_length_bucketing() {
+  printf("\n=== Test: Length-Bucketed Scheduling ===\n");
+
+  ASSERT_NE_INT(fastembed_onnx_set_batch_token_budget(-1), 0);
+  ASSERT_EQ_INT(fastembed_onnx_set_batch_token_budget(0), 0);
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  /* Interleave very short queries with long documents */
+  int num_texts = 40;
+  char(*storage)[512] = malloc(num_texts * sizeof(*storage));
+  const char **texts = (const char **)malloc(num_texts * sizeof(char *));
+  float **outputs = alloc_outputs(num_texts, dimension);
+  if (storage == NULL || texts == NULL || outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free(storage);
+    free(texts);
+    free_outputs(outputs, num_texts);
+    return;
+  }
+
+  for (int i = 0; i < num_texts; i++) {
+    if (i % 4 == 1) {
+      int len = snprintf(storage[i], sizeof(storage[i]), "long document %d:", i);
+      for (int w = 0; w < 40 + i && len < 480; w++)
+        len += snprintf(storage[i] + len, sizeof(storage[i]) - len, " word%d",
+                        (w * 7 + i) % 50);
+    } else {
+      snprintf(storage[i], sizeof(storage[i]), "query %d", i);
+    }
+    texts[i] = storage[i];
+  }
+
+  /* Default budget, a tiny budget (one text per run) and a huge one */
+  int budgets[] = {0, 1, 1 << 20};
+  for (int b = 0; b < 3; b++) {
+    ASSERT_EQ_INT(fastembed_onnx_set_batch_token_budget(budgets[b]), 0);
+    for (int i = 0; i < num_texts; i++)
+      memset(outputs[i], 0, dimension * sizeof(float));
+
+    int result = fastembed_onnx_batch_generate(MODEL_PATH, texts, num_texts,
+                                               outputs, dimension);
+    ASSERT_EQ_INT(result, 0);
+
+    float max_diff = max_diff_vs_single(texts, outputs, num_texts, dimension);
+    printf("  Budget %d: max difference vs single-text: %g\n", budgets[b],
+           max_diff);
+    ASSERT_TRUE(max_diff < EPSILON,
+                "Scheduled batches match per-text results in input order");
+  }
+  fastembed_onnx_set_batch_token_budget(0);
+
+  free(storage);
+  free(texts);
+  free_outputs(outputs, num_texts);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Reused inference contexts give identical results
+ *
+ * Alternates lengths, output buffers and batch/single calls so cached
+ * tensors and bindings are rebuilt and reused in every combination.
+ */
+void test_context_reuse() {
+  printf("\n=== Test: Inference Context Reuse ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model handle opened");
+  if (model == NULL)
+    return;
+
+  const char *texts[3] = {"short query",
+                          "a noticeably longer query with many more tokens",
+                          "short query"};
+  float **reference = alloc_outputs(3, dimension);
+  float **outputs = alloc_outputs(3, dimension);
+  if (reference == NULL || outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free_outputs(reference, 3);
+    free_outputs(outputs, 3);
+    fastembed_model_close(model);
+    return;
+  }
+
+  for (int i = 0; i < 3; i++)
+    fastembed_model_generate(model, texts[i], reference[i], dimension);
+  ASSERT_TRUE(memcmp(reference[0], reference[2], dimension * sizeof(float)) ==
+                  0,
+              "Same text after a longer one gives identical output");
+
+  int mismatches = 0;
+  for (int round = 0; round < 20; round++) {
+    int i = round % 3;
+    float *target = outputs[round % 2];
+    if (fastembed_model_generate(model, texts[i], target, dimension) != 0 ||
+        memcmp(target, reference[i], dimension * sizeof(float)) != 0)
+      mismatches++;
+    if (round % 5 == 4) {
+      if (fastembed_model_batch_generate(model, texts, 3, outputs,
+                                         dimension) != 0 ||
+          max_diff_vs_single(texts, outputs, 3, dimension) >= EPSILON)
+        mismatches++;
+    }
+  }
+  ASSERT_EQ_INT(mismatches, 0);
+
+  free_outputs(reference, 3);
+  free_outputs(outputs, 3);
+  fastembed_model_close(model);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Parallel batch matches per-text results and isolates bad texts
+ *
+ * Uses more texts than one inference group so several pool threads each
+ * run their own context, and passes a NULL text that must fail alone.
+ */
+void test_parallel_batch() {
+  printf("\n=== Test: Parallel Batch ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model handle opened");
+  if (model == NULL)
+    return;
+
+  enum { NUM_TEXTS = 3 * FASTEMBED_ONNX_MAX_BATCH_SIZE + 5 };
+  static char storage[NUM_TEXTS][64];
+  const char *texts[NUM_TEXTS];
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    snprintf(storage[i], sizeof(storage[i]), "parallel text %d%s", i,
+             (i % 4 == 0) ? " with a few extra words of padding" : "");
+    texts[i] = storage[i];
+  }
+
+  float **outputs = alloc_outputs(NUM_TEXTS, dimension);
+  int *statuses = (int *)malloc(NUM_TEXTS * sizeof(int));
+  if (outputs == NULL || statuses == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free_outputs(outputs, NUM_TEXTS);
+    free(statuses);
+    fastembed_model_close(model);
+    return;
+  }
+
+  int thread_counts[] = {1, 3, 0};
+  for (int t = 0; t < 3; t++) {
+    int failed = fastembed_model_batch_generate_parallel(
+        model, texts, NUM_TEXTS, outputs, dimension, statuses,
+        thread_counts[t]);
+    ASSERT_EQ_INT(failed, 0);
+    int not_ok = 0;
+    for (int i = 0; i < NUM_TEXTS; i++)
+      not_ok += statuses[i] != FASTEMBED_STATUS_OK;
+    ASSERT_EQ_INT(not_ok, 0);
+    ASSERT_TRUE(max_diff_vs_single(texts, outputs, NUM_TEXTS, dimension) <
+                    EPSILON,
+                "Parallel batch matches single-text embeddings");
+  }
+
+  /* A NULL text fails on its own; the rest of its group is retried */
+  texts[7] = NULL;
+  int failed = fastembed_model_batch_generate_parallel(
+      model, texts, NUM_TEXTS, outputs, dimension, statuses, 0);
+  ASSERT_EQ_INT(failed, 1);
+  ASSERT_EQ_INT(statuses[7], FASTEMBED_STATUS_NULL_INPUT);
+  ASSERT_EQ_INT(statuses[6], FASTEMBED_STATUS_OK);
+  ASSERT_EQ_INT(statuses[8], FASTEMBED_STATUS_OK);
+  ASSERT_TRUE(max_diff_vs_single(texts, outputs, 7, dimension) < EPSILON,
+              "Texts before the NULL entry are still embedded");
+  texts[7] = storage[7];
+
+  ASSERT_EQ_INT(fastembed_model_batch_generate_parallel(
+                    NULL, texts, NUM_TEXTS, outputs, dimension, NULL, 0),
+                -1);
+  ASSERT_EQ_INT(fastembed_model_batch_generate_parallel(
+                    model, texts, NUM_TEXTS, outputs, dimension + 1, NULL, 0),
+                -1);
+
+  free(statuses);
+  free_outputs(outputs, NUM_TEXTS);
+  fastembed_model_close(model);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Contiguous batch rows match the pointer-array batch
+ */
+void test_contiguous_batch() {
+  printf("\n=== Test: Contiguous Batch ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model handle opened");
+  if (model == NULL)
+    return;
+
+  enum { NUM_TEXTS = FASTEMBED_ONNX_MAX_BATCH_SIZE + 9 };
+  char blob[NUM_TEXTS * 48];
+  int32_t offsets[NUM_TEXTS + 1];
+  static char storage[NUM_TEXTS][48];
+  const char *texts[NUM_TEXTS];
+  int32_t offset = 0;
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    int len = snprintf(storage[i], sizeof(storage[i]), "contiguous text %d%s",
+                       i, (i % 3 == 0) ? " plus some more words" : "");
+    texts[i] = storage[i];
+    offsets[i] = offset;
+    memcpy(blob + offset, storage[i], (size_t)len);
+    offset += len;
+  }
+  offsets[NUM_TEXTS] = offset;
+
+  float *matrix = fastembed_alloc_matrix(NUM_TEXTS, dimension);
+  float **reference = alloc_outputs(NUM_TEXTS, dimension);
+  int *statuses = (int *)malloc(NUM_TEXTS * sizeof(int));
+  if (matrix == NULL || reference == NULL || statuses == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    fastembed_free_matrix(matrix);
+    free_outputs(reference, NUM_TEXTS);
+    free(statuses);
+    fastembed_model_close(model);
+    return;
+  }
+
+  ASSERT_EQ_INT(fastembed_model_batch_generate_parallel(
+                    model, texts, NUM_TEXTS, reference, dimension, NULL, 0),
+                0);
+  ASSERT_EQ_INT(fastembed_model_batch_generate_contiguous(
+                    model, blob, offsets, NUM_TEXTS, matrix, 0, statuses, 0),
+                0);
+  float max_diff = 0.0f;
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    for (int d = 0; d < dimension; d++) {
+      float diff = fabsf(matrix[(size_t)i * dimension + d] - reference[i][d]);
+      if (diff > max_diff)
+        max_diff = diff;
+    }
+  }
+  ASSERT_TRUE(max_diff < EPSILON, "Contiguous rows match pointer-array batch");
+
+  /* An empty span fails alone and its row is zeroed */
+  offsets[5] = offsets[4];
+  int failed = fastembed_model_batch_generate_contiguous(
+      model, blob, offsets, NUM_TEXTS, matrix, dimension, statuses, 0);
+  ASSERT_EQ_INT(failed, 1);
+  ASSERT_EQ_INT(statuses[4], FASTEMBED_STATUS_INVALID_TEXT);
+  int zeroed = 1;
+  for (int d = 0; d < dimension; d++)
+    zeroed = zeroed && matrix[(size_t)4 * dimension + d] == 0.0f;
+  ASSERT_TRUE(zeroed, "Row of the empty span is zeroed");
+
+  ASSERT_EQ_INT(fastembed_model_batch_generate_contiguous(
+                    model, blob, offsets, NUM_TEXTS, matrix, dimension + 1,
+                    NULL, 0),
+                -1);
+
+  free(statuses);
+  free_outputs(reference, NUM_TEXTS);
+  fastembed_free_matrix(matrix);
+  fastembed_model_close(model);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: A float16 model gives unit embeddings close to the float model
+ */
+void test_half_precision_model() {
+  printf("\n=== Test: Float16 Model Output ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  FILE *f = fopen(HALF_MODEL_PATH, "r");
+  if (f == NULL) {
+    SKIP("float16 test model not found at " HALF_MODEL_PATH);
+    return;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(HALF_MODEL_PATH);
+  ASSERT_TRUE(dimension > 0, "float16 model dimension detected");
+  if (dimension <= 0)
+    return;
+
+  const char *texts[] = {"half precision", "a longer sentence in float16",
+                         "x"};
+  float **outputs = alloc_outputs(3, dimension);
+  float *single = (float *)malloc(dimension * sizeof(float));
+  if (outputs == NULL || single == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free_outputs(outputs, 3);
+    free(single);
+    return;
+  }
+
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(HALF_MODEL_PATH, texts, 3,
+                                              outputs, dimension),
+                0);
+  float max_diff = 0.0f, max_norm_error = 0.0f;
+  for (int i = 0; i < 3; i++) {
+    if (fastembed_onnx_generate(HALF_MODEL_PATH, texts[i], single,
+                                dimension) != 0) {
+      max_diff = INFINITY;
+      break;
+    }
+    float norm_sq = 0.0f;
+    for (int d = 0; d < dimension; d++) {
+      float diff = fabsf(single[d] - outputs[i][d]);
+      if (diff > max_diff)
+        max_diff = diff;
+      norm_sq += outputs[i][d] * outputs[i][d];
+    }
+    if (fabsf(sqrtf(norm_sq) - 1.0f) > max_norm_error)
+      max_norm_error = fabsf(sqrtf(norm_sq) - 1.0f);
+  }
+  ASSERT_TRUE(max_diff < EPSILON, "float16 batch matches single-text output");
+  ASSERT_TRUE(max_norm_error < 1e-3f, "float16 embeddings are unit length");
+
+  /* Same model in float: half precision only perturbs the embedding */
+  if (fastembed_onnx_get_model_dimension(MODEL_PATH) == dimension &&
+      fastembed_onnx_generate(MODEL_PATH, texts[0], single, dimension) == 0) {
+    float cosine =
+        fastembed_cosine_similarity(single, outputs[0], dimension);
+    printf("  float vs float16 cosine: %.5f\n", cosine);
+    ASSERT_TRUE(cosine > 0.99f, "float16 output close to the float model");
+  }
+
+  free_outputs(outputs, 3);
+  free(single);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+#ifdef USE_ONNX_RUNTIME
+#define DOC_WORDS 3000
+#define DOC_MAX_CHUNKS 128
+
+/** Windows reported by fastembed_document_feed() / finish() */
+typedef struct {
+  int dimension;
+  int count;
+  int offsets[DOC_MAX_CHUNKS];
+  int lengths[DOC_MAX_CHUNKS];
+  float *embeddings; /* DOC_MAX_CHUNKS * dimension */
+  int abort_at;      /* Window index to abort at (-1 = never) */
+  int in_order;
+} ChunkLog;
+
+static int log_chunk(void *user_data, int chunk_index, const float *embedding,
+                     int dimension, int token_offset, int token_count) {
+  ChunkLog *log = (ChunkLog *)user_data;
+  if (chunk_index != log->count || dimension != log->dimension ||
+      log->count >= DOC_MAX_CHUNKS)
+    log->in_order = 0;
+  if (log->count < DOC_MAX_CHUNKS) {
+    log->offsets[log->count] = token_offset;
+    log->lengths[log->count] = token_count;
+    memcpy(log->embeddings + (size_t)log->count * dimension, embedding,
+           dimension * sizeof(float));
+  }
+  log->count++;
+  return chunk_index == log->abort_at;
+}
+
+static void chunk_log_reset(ChunkLog *log) {
+  log->count = 0;
+  log->abort_at = -1;
+  log->in_order = 1;
+}
+
+/** Append word i ("w" + base-26 letters) and a space */
+static size_t append_word(char *text, size_t used, int i) {
+  text[used++] = 'w';
+  do {
+    text[used++] = (char)('a' + i % 26);
+    i /= 26;
+  } while (i > 0);
+  text[used++] = ' ';
+  return used;
+}
+#endif
+
+/**
+ * Test: Long documents are embedded as overlapping windows
+ */
+void test_chunked_document() {
+  printf("\n=== Test: Chunked Documents ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model opened");
+  if (model == NULL)
+    return;
+
+  char *text = (char *)malloc((size_t)DOC_WORDS * 8 + 1);
+  size_t text_bytes = 0;
+  for (int i = 0; i < DOC_WORDS; i++)
+    text_bytes = append_word(text, text_bytes, i);
+  text[text_bytes] = '\0';
+
+  float *single = (float *)malloc(dimension * sizeof(float));
+  float *document = (float *)malloc(dimension * sizeof(float));
+  float *pieces = (float *)malloc(dimension * sizeof(float));
+
+  /* A document that fits in one window embeds like a plain text */
+  const char *short_text = "a short document in a single window";
+  ASSERT_EQ_INT(fastembed_model_embed_document(
+                    model, short_text, strlen(short_text), NULL, document),
+                1);
+  fastembed_model_generate(model, short_text, single, 0);
+  float max_diff = 0.0f;
+  for (int d = 0; d < dimension; d++)
+    if (fabsf(document[d] - single[d]) > max_diff)
+      max_diff = fabsf(document[d] - single[d]);
+  ASSERT_TRUE(max_diff < EPSILON, "Single-window document matches generate");
+
+  ASSERT_EQ_INT(fastembed_model_embed_document(model, "", 0, NULL, document),
+                1);
+  fastembed_model_generate(model, "", single, 0);
+  ASSERT_TRUE(fastembed_cosine_similarity(document, single, dimension) >
+                  0.9999f,
+              "Empty document is one empty window");
+
+  /* Window layout: 62 document tokens per window, 16 shared */
+  fastembed_chunk_options_t options;
+  fastembed_chunk_options_init(&options);
+  ASSERT_EQ_INT(options.window_tokens, FASTEMBED_CHUNK_DEFAULT_WINDOW_TOKENS);
+  options.window_tokens = 64;
+  options.overlap_tokens = 16;
+  options.on_chunk = log_chunk;
+  ChunkLog log;
+  log.dimension = dimension;
+  log.embeddings =
+      (float *)calloc((size_t)DOC_MAX_CHUNKS * dimension, sizeof(float));
+  chunk_log_reset(&log);
+  options.user_data = &log;
+
+  int chunks = fastembed_model_embed_document(model, text, text_bytes,
+                                              &options, document);
+  ASSERT_TRUE(chunks > 1 && chunks == log.count && log.in_order,
+              "Every window reported once, in order");
+  int layout_ok = chunks > 1;
+  for (int c = 0; c < chunks && c < DOC_MAX_CHUNKS; c++) {
+    if (log.offsets[c] != c * 46 || log.lengths[c] > 62 ||
+        (c < chunks - 1 && log.lengths[c] != 62))
+      layout_ok = 0;
+  }
+  int total_tokens = log.offsets[chunks - 1] + log.lengths[chunks - 1];
+  ASSERT_TRUE(layout_ok, "Windows start every 46 tokens and hold 62");
+  ASSERT_TRUE(log.lengths[chunks - 1] > 16,
+              "Last window holds tokens no earlier window covered");
+
+  /* Pooled vector: token-weighted mean of the window embeddings */
+  double *mean = (double *)calloc(dimension, sizeof(double));
+  for (int c = 0; c < chunks && c < DOC_MAX_CHUNKS; c++)
+    for (int d = 0; d < dimension; d++)
+      mean[d] += log.lengths[c] * log.embeddings[(size_t)c * dimension + d];
+  double norm = 0.0;
+  for (int d = 0; d < dimension; d++)
+    norm += mean[d] * mean[d];
+  max_diff = 0.0f;
+  for (int d = 0; d < dimension; d++) {
+    float expected = (float)(mean[d] / sqrt(norm));
+    if (fabsf(document[d] - expected) > max_diff)
+      max_diff = fabsf(document[d] - expected);
+  }
+  ASSERT_TRUE(max_diff < EPSILON, "Document vector is the weighted mean");
+  free(mean);
+
+  /* With the hash tokenizer every word is one token, so a window embeds
+   * like the text of its words */
+  if (fastembed_model_get_tokenizer(model) == NULL) {
+    ASSERT_EQ_INT(total_tokens, DOC_WORDS);
+    int c = chunks / 2;
+    char *window_text = (char *)malloc(62 * 8 + 1);
+    size_t used = 0;
+    for (int i = 0; i < log.lengths[c]; i++)
+      used = append_word(window_text, used, log.offsets[c] + i);
+    window_text[used] = '\0';
+    fastembed_model_generate(model, window_text, single, 0);
+    ASSERT_TRUE(fastembed_cosine_similarity(
+                    single, log.embeddings + (size_t)c * dimension,
+                    dimension) > 0.9999f,
+                "Window embedding matches its text");
+    free(window_text);
+  }
+
+  /* Feeding in small uneven pieces gives the same result */
+  fastembed_document_t *doc = fastembed_document_begin(model, &options);
+  chunk_log_reset(&log);
+  ASSERT_TRUE(doc != NULL, "Document started");
+  int feed_ok = doc != NULL;
+  for (size_t pos = 0, step = 1; feed_ok && pos < text_bytes;
+       pos += step, step = step % 37 + 1) {
+    size_t n = text_bytes - pos < step ? text_bytes - pos : step;
+    feed_ok = fastembed_document_feed(doc, text + pos, n) == 0;
+  }
+  ASSERT_TRUE(feed_ok, "Piecewise feed succeeds");
+  ASSERT_EQ_INT(fastembed_document_finish(doc, pieces), chunks);
+  ASSERT_EQ_INT(fastembed_document_finish(doc, pieces), -1);
+  fastembed_document_free(doc);
+  max_diff = 0.0f;
+  for (int d = 0; d < dimension; d++)
+    if (fabsf(document[d] - pieces[d]) > max_diff)
+      max_diff = fabsf(document[d] - pieces[d]);
+  ASSERT_TRUE(max_diff < EPSILON, "Piecewise feed matches one-shot feed");
+
+  /* A word longer than a segment is split instead of failing */
+  size_t long_bytes = FASTEMBED_CHUNK_SEGMENT_BYTES * 3;
+  char *long_word = (char *)malloc(long_bytes);
+  memset(long_word, 'x', long_bytes);
+  ASSERT_TRUE(fastembed_model_embed_document(model, long_word, long_bytes,
+                                             NULL, single) >= 1,
+              "Whitespace-free text is embedded");
+  free(long_word);
+
+  /* Callback abort fails the document */
+  chunk_log_reset(&log);
+  log.abort_at = 2;
+  ASSERT_EQ_INT(fastembed_model_embed_document(model, text, text_bytes,
+                                               &options, single),
+                -1);
+  ASSERT_EQ_INT(log.count, 3);
+
+  /* The document keeps the model alive after the handle is closed */
+  options.on_chunk = NULL;
+  doc = fastembed_document_begin(model, &options);
+  fastembed_model_close(model);
+  ASSERT_EQ_INT(fastembed_document_feed(doc, text, text_bytes), 0);
+  ASSERT_EQ_INT(fastembed_document_finish(doc, pieces), chunks);
+  fastembed_document_free(doc);
+  max_diff = 0.0f;
+  for (int d = 0; d < dimension; d++)
+    if (fabsf(document[d] - pieces[d]) > max_diff)
+      max_diff = fabsf(document[d] - pieces[d]);
+  ASSERT_TRUE(max_diff < EPSILON, "Document outlives its model handle");
+
+  /* Invalid options */
+  model = fastembed_model_open(MODEL_PATH);
+  fastembed_chunk_options_init(&options);
+  options.window_tokens = 2;
+  ASSERT_TRUE(fastembed_document_begin(model, &options) == NULL,
+              "Window without room for a token rejected");
+  fastembed_chunk_options_init(&options);
+  options.overlap_tokens = options.window_tokens - 2;
+  ASSERT_TRUE(fastembed_document_begin(model, &options) == NULL,
+              "Overlap of a whole window rejected");
+  ASSERT_TRUE(fastembed_document_begin(NULL, NULL) == NULL,
+              "NULL model rejected");
+  ASSERT_EQ_INT(fastembed_document_feed(NULL, "x", 1), -1);
+  ASSERT_EQ_INT(fastembed_document_finish(NULL, document), -1);
+  fastembed_document_free(NULL);
+  fastembed_model_close(model);
+
+  free(log.embeddings);
+  free(single);
+  free(document);
+  free(pieces);
+  free(text);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+#ifdef USE_ONNX_RUNTIME
+/** Batches reported by the pipeline callback */
+typedef struct {
+  int num_texts;
+  int dimension;
+  int batches;
+  int rows;
+  int *seen;      /* Times each text index was reported */
+  float *matrix;  /* Float rows copied from the callback */
+  int abort_at;   /* Batch number to abort at (-1 = never) */
+  int bad_args;
+} PipelineLog;
+
+static int log_pipeline_batch(void *user_data, const int *indices,
+                              const int *statuses, int count,
+                              const void *rows, const float *scales,
+                              int dimension) {
+  PipelineLog *log = (PipelineLog *)user_data;
+  if (count < 1 || count > FASTEMBED_ONNX_MAX_BATCH_SIZE || scales != NULL ||
+      dimension != log->dimension)
+    log->bad_args = 1;
+  for (int b = 0; b < count; b++) {
+    int index = indices[b];
+    if (index < 0 || index >= log->num_texts) {
+      log->bad_args = 1;
+      continue;
+    }
+    log->seen[index]++;
+    if (statuses[b] == FASTEMBED_STATUS_OK && log->matrix != NULL)
+      memcpy(log->matrix + (size_t)index * dimension,
+             (const float *)rows + (size_t)b * dimension,
+             dimension * sizeof(float));
+  }
+  log->rows += count;
+  return log->batches++ == log->abort_at;
+}
+
+/** Max absolute difference between rows of two matrices, skipping one row */
+static float max_row_diff(const float *a, const float *b, int rows,
+                          int dimension, int skip_row) {
+  float max_diff = 0.0f;
+  for (int i = 0; i < rows; i++) {
+    if (i == skip_row)
+      continue;
+    for (int d = 0; d < dimension; d++) {
+      float diff = fabsf(a[(size_t)i * dimension + d] -
+                         b[(size_t)i * dimension + d]);
+      if (diff > max_diff)
+        max_diff = diff;
+    }
+  }
+  return max_diff;
+}
+#endif
+
+/**
+ * Test: Pipelined batches match the parallel batch and deliver every text
+ *
+ * Spans several tokenizer windows, so batches of different windows are in
+ * flight at once, and includes a NULL text that must fail alone.
+ */
+void test_pipelined_batch() {
+  printf("\n=== Test: Pipelined Batch ===\n");
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model handle opened");
+  if (model == NULL)
+    return;
+
+  enum { NUM_TEXTS = 2 * FASTEMBED_PIPELINE_WINDOW + 37, NULL_TEXT = 100 };
+  static char storage[NUM_TEXTS][96];
+  const char *texts[NUM_TEXTS];
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    snprintf(storage[i], sizeof(storage[i]), "pipelined text %d%s", i,
+             (i % 5 == 0)   ? " followed by a longer tail of several words"
+             : (i % 3 == 0) ? " plus a few words"
+                            : "");
+    texts[i] = storage[i];
+  }
+  texts[NULL_TEXT] = NULL;
+
+  size_t floats = (size_t)NUM_TEXTS * dimension;
+  float *expected = (float *)calloc(floats, sizeof(float));
+  float *matrix = (float *)calloc(floats, sizeof(float));
+  float *copied = (float *)calloc(floats, sizeof(float));
+  int8_t *codes = (int8_t *)calloc(floats, 1);
+  int8_t *expected_codes = (int8_t *)calloc(floats, 1);
+  float *scales = (float *)calloc(NUM_TEXTS, sizeof(float));
+  float *expected_scales = (float *)calloc(NUM_TEXTS, sizeof(float));
+  int *statuses = (int *)malloc(NUM_TEXTS * sizeof(int));
+  int *seen = (int *)calloc(NUM_TEXTS, sizeof(int));
+  if (!expected || !matrix || !copied || !codes || !expected_codes ||
+      !scales || !expected_scales || !statuses || !seen) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    goto done;
+  }
+
+  /* Reference: contiguous parallel batch (the NULL text is replaced) */
+  {
+    static char data[NUM_TEXTS * 96];
+    int32_t offsets[NUM_TEXTS + 1];
+    int32_t used = 0;
+    for (int i = 0; i < NUM_TEXTS; i++) {
+      offsets[i] = used;
+      size_t length = strlen(storage[i]);
+      memcpy(data + used, storage[i], length);
+      used += (int32_t)length;
+    }
+    offsets[NUM_TEXTS] = used;
+    ASSERT_EQ_INT(fastembed_model_batch_generate_contiguous(
+                      model, data, offsets, NUM_TEXTS, expected, dimension,
+                      NULL, 0),
+                  0);
+    memset(expected + (size_t)NULL_TEXT * dimension, 0,
+           dimension * sizeof(float));
+  }
+
+  int configs[3][3] = {{1, 1, 1}, {2, 2, 3}, {0, 0, 0}}; /* 0 = default */
+  for (int c = 0; c < 3; c++) {
+    fastembed_pipeline_options_t options;
+    fastembed_pipeline_options_init(&options);
+    if (configs[c][0] > 0) {
+      options.tokenizer_threads = configs[c][0];
+      options.inference_threads = configs[c][1];
+      options.queue_depth = configs[c][2];
+    }
+    PipelineLog log = {NUM_TEXTS, dimension, 0, 0, seen, copied, -1, 0};
+    memset(seen, 0, NUM_TEXTS * sizeof(int));
+    memset(matrix, 0xff, floats * sizeof(float));
+    options.output = matrix;
+    options.on_batch = log_pipeline_batch;
+    options.user_data = &log;
+
+    int failed = fastembed_model_batch_generate_pipelined(
+        model, texts, NUM_TEXTS, 0, statuses, &options);
+    ASSERT_EQ_INT(failed, 1);
+    ASSERT_EQ_INT(statuses[NULL_TEXT], FASTEMBED_STATUS_NULL_INPUT);
+    int not_ok = 0;
+    int seen_once = 0;
+    for (int i = 0; i < NUM_TEXTS; i++) {
+      not_ok += statuses[i] != FASTEMBED_STATUS_OK;
+      seen_once += seen[i] == 1;
+    }
+    ASSERT_EQ_INT(not_ok, 1);
+    ASSERT_EQ_INT(seen_once, NUM_TEXTS);
+    ASSERT_EQ_INT(log.rows, NUM_TEXTS);
+    ASSERT_TRUE(log.batches > 2 && !log.bad_args,
+                "Results arrive batch by batch with valid arguments");
+    ASSERT_TRUE(max_row_diff(matrix, expected, NUM_TEXTS, dimension, -1) <
+                    EPSILON,
+                "Output matrix matches the parallel batch (failed row zero)");
+    ASSERT_TRUE(max_row_diff(copied, expected, NUM_TEXTS, dimension,
+                             NULL_TEXT) < EPSILON,
+                "Callback rows match the output matrix");
+  }
+
+  /* int8 output: same codes as quantizing the float embeddings */
+  {
+    fastembed_pipeline_options_t options;
+    fastembed_pipeline_options_init(&options);
+    options.inference_threads = 2;
+    options.quantization = FASTEMBED_QUANT_INT8;
+    options.output = codes;
+    options.scales = scales;
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, &options),
+                  1);
+    fastembed_quantize_int8(expected, NUM_TEXTS, dimension, expected_codes,
+                            expected_scales);
+    int max_code_diff = 0;
+    for (size_t i = 0; i < floats; i++) {
+      int diff = abs(codes[i] - expected_codes[i]);
+      if (diff > max_code_diff)
+        max_code_diff = diff;
+    }
+    ASSERT_TRUE(max_code_diff <= 1, "int8 rows match quantized embeddings");
+    ASSERT_TRUE(fabsf(scales[0] - expected_scales[0]) < EPSILON &&
+                    scales[NULL_TEXT] == 0.0f,
+                "int8 scales are written per text");
+  }
+
+  /* Store output: successful texts, with their indices as ids */
+  {
+    const char *store_path = "test_onnx_batch_pipeline.store";
+    fastembed_store_writer_t *writer = fastembed_store_writer_open(
+        store_path, dimension, FASTEMBED_QUANT_NONE, FASTEMBED_STORE_IDS);
+    ASSERT_TRUE(writer != NULL, "Store writer opened");
+    if (writer != NULL) {
+      fastembed_pipeline_options_t options;
+      fastembed_pipeline_options_init(&options);
+      options.tokenizer_threads = 2;
+      options.store = writer;
+      ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                        model, texts, NUM_TEXTS, dimension, NULL, &options),
+                    1);
+      ASSERT_EQ_INT(fastembed_store_writer_close(writer), 0);
+
+      fastembed_store_t *store = fastembed_store_open(store_path);
+      ASSERT_TRUE(store != NULL, "Store opened");
+      if (store != NULL) {
+        ASSERT_EQ_INT(fastembed_store_count(store), NUM_TEXTS - 1);
+        const float *vectors = (const float *)fastembed_store_vectors(store);
+        const int64_t *ids = fastembed_store_ids(store);
+        float max_diff = ids != NULL ? 0.0f : INFINITY;
+        for (int r = 0; ids != NULL && r < NUM_TEXTS - 1; r++) {
+          if (ids[r] < 0 || ids[r] >= NUM_TEXTS || ids[r] == NULL_TEXT) {
+            max_diff = INFINITY;
+            break;
+          }
+          for (int d = 0; d < dimension; d++) {
+            float diff = fabsf(vectors[(size_t)r * dimension + d] -
+                               expected[(size_t)ids[r] * dimension + d]);
+            if (diff > max_diff)
+              max_diff = diff;
+          }
+        }
+        ASSERT_TRUE(max_diff < EPSILON, "Store rows match their ids");
+        fastembed_store_close(store);
+      }
+      remove(store_path);
+    }
+  }
+
+  /* A callback abort stops the call */
+  {
+    fastembed_pipeline_options_t options;
+    fastembed_pipeline_options_init(&options);
+    PipelineLog log = {NUM_TEXTS, dimension, 0, 0, seen, NULL, 1, 0};
+    options.on_batch = log_pipeline_batch;
+    options.user_data = &log;
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, &options),
+                  -1);
+    ASSERT_EQ_INT(log.batches, 2);
+    char error[512];
+    fastembed_onnx_get_last_error(error, sizeof(error));
+    ASSERT_TRUE(strstr(error, "aborted") != NULL,
+                "Abort is reported in the last error");
+  }
+
+  /* Invalid arguments */
+  {
+    fastembed_pipeline_options_t options;
+    fastembed_pipeline_options_init(&options);
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, &options),
+                  -1); /* No output, store or callback */
+    options.output = matrix;
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension + 1, NULL, &options),
+                  -1);
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, NULL),
+                  -1);
+    options.inference_threads = 0;
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, &options),
+                  -1);
+    options.inference_threads = 1;
+    options.quantization = FASTEMBED_QUANT_INT8; /* Without scales */
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, &options),
+                  -1);
+    options.quantization = 99;
+    ASSERT_EQ_INT(fastembed_model_batch_generate_pipelined(
+                      model, texts, NUM_TEXTS, dimension, NULL, &options),
+                  -1);
+  }
+
+done:
+  free(seen);
+  free(statuses);
+  free(expected_scales);
+  free(scales);
+  free(expected_codes);
+  free(codes);
+  free(copied);
+  free(matrix);
+  free(expected);
+  fastembed_model_close(model);
+#else
+  printf("  ⚠ SKIP: ONNX Runtime not available (compiled without "
+         "USE_ONNX_RUNTIME)\n");
+  tests_run++;
+  tests_passed++;
+#endif
+}
+
+/**
+ * Test: Invalid parameters are rejected
+ */
+void test_batch_invalid_input() {
+  printf("\n=== Test: Batch Invalid Input ===\n");
+
+  float buffer[8];
+  float *outputs[2] = {buffer, NULL};
+  const char *texts[2] = {"valid", NULL};
+
+  ASSERT_NE_INT(fastembed_onnx_batch_generate(NULL, texts, 1, outputs, 0), 0);
+  ASSERT_NE_INT(fastembed_onnx_batch_generate(MODEL_PATH, NULL, 1, outputs, 0),
+                0);
+  ASSERT_NE_INT(fastembed_onnx_batch_generate(MODEL_PATH, texts, 1, NULL, 0),
+                0);
+  ASSERT_NE_INT(fastembed_onnx_batch_generate(MODEL_PATH, texts, 0, outputs, 0),
+                0);
+
+#ifdef USE_ONNX_RUNTIME
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  /* NULL entry inside the arrays */
+  float **valid_outputs = alloc_outputs(2, dimension);
+  if (valid_outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    return;
+  }
+  ASSERT_NE_INT(
+      fastembed_onnx_batch_generate(MODEL_PATH, texts, 2, valid_outputs, 0), 0);
+
+  /* Dimension mismatch */
+  const char *ok_texts[2] = {"one", "two"};
+  int wrong_dimension = (dimension == 768) ? 512 : 768;
+  float **wrong_outputs = alloc_outputs(2, wrong_dimension);
+  if (wrong_outputs != NULL) {
+    ASSERT_NE_INT(fastembed_onnx_batch_generate(MODEL_PATH, ok_texts, 2,
+                                                wrong_outputs, wrong_dimension),
+                  0);
+    free_outputs(wrong_outputs, 2);
+  }
+  free_outputs(valid_outputs, 2);
+#endif
+}
+
+int main() {
+  printf("FastEmbed ONNX Batch Inference Tests\n");
+  printf("====================================\n");
+
+  test_batch_matches_single();
+  test_batch_order_multiple_groups();
+  test_batch_normalized();
+  test_batch_length_bucketing();
+  test_context_reuse();
+  test_parallel_batch();
+  test_contiguous_batch();
+  test_half_precision_model();
+  test_chunked_document();
+  test_pipelined_batch();
+  test_batch_invalid_input();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
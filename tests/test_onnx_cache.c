@@ -0,0 +1,466 @@
+/**
+ * FastEmbed Embedding Cache Tests
+ *
+ * Tests for the content-addressed embedding cache:
+ * - Test the cache is disabled by default
+ * - Test repeated texts hit in single, batch and parallel calls
+ * - Test batches only send misses to inference
+ * - Test LRU eviction stays within the byte budget
+ * - Test saving the cache and attaching it as a persistent tier
+ * - Test invalid arguments and store files are rejected
+ *
+ * Compile: gcc -o test_onnx_cache test_onnx_cache.c -L../build -lfastembed
+ * -lm -I../include -DUSE_ONNX_RUNTIME Run: LD_LIBRARY_PATH=..
+ * ./test_onnx_cache
+ */
+
+#include "fastembed.h"
+#include "fastembed_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MODEL_PATH "models/test.onnx" /* Placeholder - adjust as needed */
+#define CACHE_STORE_PATH "test_onnx_cache.festore"
+#define PLAIN_STORE_PATH "test_onnx_cache_plain.festore"
+#define NUM_TEXTS 24
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define SKIP(message)                                                          \
+  do {                                                                         \
+    printf("  ⚠ SKIP: %s\n", message);                                        \
+    tests_run++;                                                               \
+    tests_passed++; /* Don't fail if model not available */                    \
+  } while (0)
+
+static int g_dimension = -1;
+static char g_storage[NUM_TEXTS][64];
+static const char *g_texts[NUM_TEXTS];
+static float *g_reference; /* Uncached embeddings [NUM_TEXTS * dimension] */
+
+/**
+ * Returns model dimension, or -1 (and records a skip) if unavailable
+ */
+static int require_model(void) {
+  if (g_dimension > 0)
+    return g_dimension;
+
+  FILE *f = fopen(MODEL_PATH, "r");
+  if (f == NULL) {
+    printf("  ⚠ SKIP: Test model not found at %s\n", MODEL_PATH);
+    tests_run++;
+    tests_passed++;
+    return -1;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(MODEL_PATH);
+  if (dimension <= 0) {
+    SKIP("Cannot get model dimension");
+    return -1;
+  }
+  g_dimension = dimension;
+  return dimension;
+}
+
+static fastembed_embedding_cache_stats_t cache_stats(void) {
+  fastembed_embedding_cache_stats_t stats;
+  fastembed_embedding_cache_get_stats(&stats);
+  return stats;
+}
+
+/** Empty the cache and zero its counters (keeps the budget) */
+static void reset_cache(void) {
+  fastembed_embedding_cache_clear();
+  fastembed_embedding_cache_reset_stats();
+}
+
+static float **alloc_outputs(int count, int dimension) {
+  float **outputs = (float **)calloc(count, sizeof(float *));
+  for (int i = 0; outputs && i < count; i++) {
+    outputs[i] = (float *)calloc(dimension, sizeof(float));
+    if (outputs[i] == NULL) {
+      for (int j = 0; j < i; j++)
+        free(outputs[j]);
+      free(outputs);
+      return NULL;
+    }
+  }
+  return outputs;
+}
+
+static void free_outputs(float **outputs, int count) {
+  if (outputs == NULL)
+    return;
+  for (int i = 0; i < count; i++)
+    free(outputs[i]);
+  free(outputs);
+}
+
+/** Number of outputs[i] that differ from the reference of texts[first + i] */
+static int count_mismatches(float **outputs, int first, int count,
+                            int dimension) {
+  int mismatches = 0;
+  for (int i = 0; i < count; i++) {
+    const float *expected = g_reference + (size_t)(first + i) * dimension;
+    mismatches +=
+        memcmp(outputs[i], expected, (size_t)dimension * sizeof(float)) != 0;
+  }
+  return mismatches;
+}
+
+/**
+ * Test 1: The cache is off by default and does not count lookups
+ */
+void test_cache_disabled_by_default(void) {
+  printf("\nTest 1: Cache disabled by default\n");
+
+  fastembed_embedding_cache_stats_t stats = cache_stats();
+  ASSERT_TRUE(stats.capacity_bytes == 0, "Default capacity is 0");
+  ASSERT_TRUE(stats.entries == 0, "No entries by default");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  /* Reference embeddings computed without the cache */
+  g_reference = (float *)calloc((size_t)NUM_TEXTS * dimension, sizeof(float));
+  ASSERT_TRUE(g_reference != NULL, "Reference buffer allocated");
+  if (g_reference == NULL)
+    return;
+  int ok = 1;
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    snprintf(g_storage[i], sizeof(g_storage[i]), "cached text %d%s", i,
+             (i % 3 == 0) ? " with some longer padding words" : "");
+    g_texts[i] = g_storage[i];
+    ok &= fastembed_onnx_generate(MODEL_PATH, g_texts[i],
+                                  g_reference + (size_t)i * dimension,
+                                  dimension) == 0;
+  }
+  ASSERT_TRUE(ok, "Reference embeddings generated");
+
+  stats = cache_stats();
+  ASSERT_TRUE(stats.hits == 0 && stats.misses == 0,
+              "Disabled cache counts no lookups");
+}
+
+/**
+ * Test 2: Repeated texts hit, batches only run their misses
+ */
+void test_cache_hits(void) {
+  printf("\nTest 2: Cache hits in single, batch and parallel calls\n");
+
+  int dimension = require_model();
+  if (dimension <= 0 || g_reference == NULL)
+    return;
+
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(1 << 20), 0);
+  reset_cache();
+
+  float *single = (float *)calloc(dimension, sizeof(float));
+  float **outputs = alloc_outputs(NUM_TEXTS, dimension);
+  if (single == NULL || outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free(single);
+    free_outputs(outputs, NUM_TEXTS);
+    return;
+  }
+
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[0], single,
+                                        dimension),
+                0);
+  fastembed_embedding_cache_stats_t stats = cache_stats();
+  ASSERT_TRUE(stats.misses == 1 && stats.hits == 0, "First call misses");
+  ASSERT_TRUE(stats.insertions == 1 && stats.entries == 1,
+              "Miss is inserted");
+
+  memset(single, 0, dimension * sizeof(float));
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[0], single,
+                                        dimension),
+                0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.hits == 1 && stats.misses == 1, "Repeated call hits");
+  ASSERT_TRUE(memcmp(single, g_reference, dimension * sizeof(float)) == 0,
+              "Hit returns the uncached embedding");
+
+  /* Texts 0-3 are known to the cache after this call */
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(MODEL_PATH, g_texts, 4, outputs,
+                                              dimension),
+                0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.hits == 2 && stats.misses == 4,
+              "Batch only sends its 3 misses to inference");
+  ASSERT_EQ_INT(count_mismatches(outputs, 0, 4, dimension), 0);
+
+  /* Mixed batch: 4 hits interleaved with misses */
+  const char *mixed[8] = {g_texts[4], g_texts[0], g_texts[5], g_texts[1],
+                          g_texts[6], g_texts[2], g_texts[7], g_texts[3]};
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(MODEL_PATH, mixed, 8, outputs,
+                                              dimension),
+                0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.hits == 6 && stats.misses == 8,
+              "Mixed batch hits 4 and misses 4");
+  int mismatches = 0;
+  for (int i = 0; i < 8; i++) {
+    int text = (i % 2 == 0) ? 4 + i / 2 : i / 2;
+    mismatches += count_mismatches(&outputs[i], text, 1, dimension);
+  }
+  ASSERT_EQ_INT(mismatches, 0);
+
+  /* Handle-based parallel calls share the cache */
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model handle opened");
+  if (model) {
+    fastembed_embedding_cache_reset_stats();
+    ASSERT_EQ_INT(fastembed_model_batch_generate_parallel(
+                      model, g_texts, NUM_TEXTS, outputs, dimension, NULL, 0),
+                  0);
+    stats = cache_stats();
+    ASSERT_TRUE(stats.hits == 8 && stats.misses == NUM_TEXTS - 8,
+                "Parallel batch hits the 8 cached texts");
+    ASSERT_EQ_INT(count_mismatches(outputs, 0, NUM_TEXTS, dimension), 0);
+
+    fastembed_embedding_cache_reset_stats();
+    ASSERT_EQ_INT(fastembed_model_batch_generate(model, g_texts, NUM_TEXTS,
+                                                 outputs, dimension),
+                  0);
+    stats = cache_stats();
+    ASSERT_TRUE(stats.hits == NUM_TEXTS && stats.misses == 0,
+                "Fully cached batch runs no inference");
+    ASSERT_EQ_INT(count_mismatches(outputs, 0, NUM_TEXTS, dimension), 0);
+    fastembed_model_close(model);
+  }
+
+  ASSERT_TRUE(stats.entries == NUM_TEXTS, "One entry per distinct text");
+  ASSERT_TRUE(stats.bytes >= (uint64_t)NUM_TEXTS * dimension * sizeof(float),
+              "Entry bytes include the vectors");
+
+  free(single);
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+/**
+ * Test 3: Least recently used entries are evicted to stay within budget
+ */
+void test_cache_eviction(void) {
+  printf("\nTest 3: LRU eviction within the byte budget\n");
+
+  int dimension = require_model();
+  if (dimension <= 0 || g_reference == NULL)
+    return;
+
+  /* Room for about one entry per shard */
+  size_t entry_bytes = (size_t)dimension * sizeof(float) + 64;
+  size_t capacity = FASTEMBED_EMBEDDING_CACHE_SHARDS * entry_bytes;
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(capacity), 0);
+  fastembed_embedding_cache_stats_t stats = cache_stats();
+  ASSERT_TRUE(stats.bytes <= capacity, "Lowering the capacity evicts");
+  reset_cache();
+
+  float **outputs = alloc_outputs(NUM_TEXTS, dimension);
+  if (outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    return;
+  }
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(MODEL_PATH, g_texts, NUM_TEXTS,
+                                              outputs, dimension),
+                0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.bytes <= capacity, "Cache stays within its budget");
+  ASSERT_TRUE(stats.entries < NUM_TEXTS, "Not every text fits");
+  ASSERT_TRUE(stats.evictions == stats.insertions - stats.entries,
+              "Every dropped entry is counted as an eviction");
+  ASSERT_EQ_INT(count_mismatches(outputs, 0, NUM_TEXTS, dimension), 0);
+
+  /* Too small for any entry: lookups still run, nothing is stored */
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(16), 0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.entries == 0 && stats.bytes == 0,
+              "Tiny budget holds no entries");
+
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+/**
+ * Test 4: Saved caches serve hits from an attached store
+ */
+void test_cache_persistent_tier(void) {
+  printf("\nTest 4: Persistent store tier\n");
+
+  int dimension = require_model();
+  if (dimension <= 0 || g_reference == NULL)
+    return;
+
+  float **outputs = alloc_outputs(NUM_TEXTS, dimension);
+  if (outputs == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    return;
+  }
+
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(1 << 20), 0);
+  reset_cache();
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(MODEL_PATH, g_texts, NUM_TEXTS,
+                                              outputs, dimension),
+                0);
+  ASSERT_EQ_INT(fastembed_embedding_cache_save(CACHE_STORE_PATH, dimension),
+                NUM_TEXTS);
+  ASSERT_EQ_INT(fastembed_embedding_cache_save(CACHE_STORE_PATH ".other",
+                                               dimension + 1),
+                0);
+  remove(CACHE_STORE_PATH ".other");
+
+  fastembed_store_t *store = fastembed_store_open(CACHE_STORE_PATH);
+  ASSERT_TRUE(store != NULL, "Saved cache opens as a store");
+  if (store) {
+    ASSERT_EQ_INT(fastembed_store_count(store), NUM_TEXTS);
+    ASSERT_EQ_INT(fastembed_store_dimension(store), dimension);
+    ASSERT_TRUE(fastembed_store_ids(store) != NULL, "Store has key ids");
+    fastembed_store_close(store);
+  }
+
+  /* Memory tier off: every text comes from the store */
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(0), 0);
+  fastembed_embedding_cache_reset_stats();
+  ASSERT_EQ_INT(fastembed_embedding_cache_attach_store(CACHE_STORE_PATH), 0);
+  for (int i = 0; i < NUM_TEXTS; i++)
+    memset(outputs[i], 0, dimension * sizeof(float));
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(MODEL_PATH, g_texts, NUM_TEXTS,
+                                              outputs, dimension),
+                0);
+  fastembed_embedding_cache_stats_t stats = cache_stats();
+  ASSERT_TRUE(stats.store_hits == NUM_TEXTS && stats.hits == NUM_TEXTS,
+              "All texts answered by the store");
+  ASSERT_TRUE(stats.misses == 0 && stats.stores == 1,
+              "No inference with the store attached");
+  ASSERT_EQ_INT(count_mismatches(outputs, 0, NUM_TEXTS, dimension), 0);
+
+  /* Store hits are promoted into memory */
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(1 << 20), 0);
+  fastembed_embedding_cache_reset_stats();
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[3], outputs[0],
+                                        dimension),
+                0);
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[3], outputs[0],
+                                        dimension),
+                0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.store_hits == 1 && stats.hits == 2,
+              "Second lookup hits the promoted entry");
+  ASSERT_TRUE(stats.insertions == 1, "Store hit inserted into memory");
+
+  /* A text not in the store still runs inference */
+  const char *fresh = "text that was never cached";
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, fresh, outputs[0],
+                                        dimension),
+                0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.misses == 1, "Unknown text misses both tiers");
+
+  fastembed_embedding_cache_detach_stores();
+  stats = cache_stats();
+  ASSERT_EQ_INT(stats.stores, 0);
+
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(0), 0);
+  stats = cache_stats();
+  ASSERT_TRUE(stats.entries == 0 && stats.bytes == 0,
+              "Disabling the cache frees its entries");
+
+  remove(CACHE_STORE_PATH);
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+/**
+ * Test 5: Invalid arguments and stores
+ */
+void test_cache_invalid(void) {
+  printf("\nTest 5: Invalid arguments\n");
+
+  ASSERT_EQ_INT(fastembed_embedding_cache_get_stats(NULL), -1);
+  ASSERT_EQ_INT(fastembed_embedding_cache_save(NULL, 128), -1);
+  ASSERT_EQ_INT(fastembed_embedding_cache_save(CACHE_STORE_PATH, 0), -1);
+  ASSERT_EQ_INT(fastembed_embedding_cache_attach_store(NULL), -1);
+  ASSERT_EQ_INT(fastembed_embedding_cache_attach_store("missing.festore"), -1);
+
+  /* Stores without sorted key ids are not caches */
+  float vector[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+  fastembed_store_writer_t *writer = fastembed_store_writer_open(
+      PLAIN_STORE_PATH, 4, FASTEMBED_QUANT_NONE, 0);
+  ASSERT_TRUE(writer != NULL, "Plain store writer opened");
+  if (writer) {
+    fastembed_store_writer_append(writer, vector, 1, NULL);
+    fastembed_store_writer_close(writer);
+    ASSERT_EQ_INT(fastembed_embedding_cache_attach_store(PLAIN_STORE_PATH),
+                  -1);
+  }
+
+  int64_t ids[2] = {5, 2};
+  float vectors[8] = {0};
+  writer = fastembed_store_writer_open(PLAIN_STORE_PATH, 4,
+                                       FASTEMBED_QUANT_NONE,
+                                       FASTEMBED_STORE_IDS);
+  if (writer) {
+    fastembed_store_writer_append(writer, vectors, 2, ids);
+    fastembed_store_writer_close(writer);
+    ASSERT_EQ_INT(fastembed_embedding_cache_attach_store(PLAIN_STORE_PATH),
+                  -1);
+  }
+  remove(PLAIN_STORE_PATH);
+
+  fastembed_embedding_cache_stats_t stats = cache_stats();
+  ASSERT_EQ_INT(stats.stores, 0);
+}
+
+int main() {
+  printf("FastEmbed Embedding Cache Tests\n");
+  printf("===============================\n");
+
+  test_cache_disabled_by_default();
+  test_cache_hits();
+  test_cache_eviction();
+  test_cache_persistent_tier();
+  test_cache_invalid();
+
+  free(g_reference);
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
@@ -0,0 +1,567 @@
+/**
+ * FastEmbed ONNX Session Options Tests
+ *
+ * Tests for fastembed_model_open_with_options():
+ * - Test option defaults
+ * - Test sessions are cached per model path and options
+ * - Test tuned sessions produce the same embeddings as default sessions
+ * - Test execution provider fallback to CPU
+ * - Test optimized-model cache creation and reuse
+ * - Test tokenizer_path and tokenizer discovery next to the model
+ * - Test pooling modes over [batch, seq_len, hidden] outputs
+ * - Test invalid options are rejected
+ *
+ * Compile: gcc -o test_onnx_options test_onnx_options.c -L../build
+ * -lfastembed -lm -I../include -DUSE_ONNX_RUNTIME Run: LD_LIBRARY_PATH=..
+ * ./test_onnx_options
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <direct.h>
+#define make_directory(path) _mkdir(path)
+#define remove_directory(path) _rmdir(path)
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#define make_directory(path) mkdir(path, 0755)
+#define remove_directory(path) rmdir(path)
+#endif
+
+#define EPSILON 0.0001f
+#define GPU_EPSILON 0.001f /* GPU kernels may round differently */
+#define MODEL_PATH "models/test.onnx" /* Placeholder - adjust as needed */
+#define OPTIMIZED_CACHE_PATH "test_onnx_options.optimized.onnx"
+#define VOCAB_PATH "test_onnx_options.vocab.txt"
+#define DISCOVERY_DIR "test_onnx_options_model"
+#define DISCOVERY_ONNX_DIR DISCOVERY_DIR "/onnx"
+#define DISCOVERY_MODEL_PATH DISCOVERY_ONNX_DIR "/model.onnx"
+#define DISCOVERY_VOCAB_PATH DISCOVERY_DIR "/vocab.txt"
+
+/* Minimal uncased vocabulary (ID = line number) */
+#define TEST_VOCAB "[PAD]\n[UNK]\n[CLS]\n[SEP]\nhello\nworld\n,\n"
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define SKIP(message)                                                          \
+  do {                                                                         \
+    printf("  ⚠ SKIP: %s\n", message);                                        \
+    tests_run++;                                                               \
+    tests_passed++; /* Don't fail if model not available */                    \
+  } while (0)
+
+/**
+ * Returns model dimension, or -1 (and records a skip) if unavailable
+ */
+static int require_model(void) {
+  FILE *f = fopen(MODEL_PATH, "r");
+  if (f == NULL) {
+    printf("  ⚠ SKIP: Test model not found at %s\n", MODEL_PATH);
+    tests_run++;
+    tests_passed++;
+    return -1;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(MODEL_PATH);
+  if (dimension <= 0) {
+    SKIP("Cannot get model dimension");
+    return -1;
+  }
+  return dimension;
+}
+
+/**
+ * Max abs difference between the embeddings of text for two model handles
+ */
+static float embedding_diff(fastembed_model_t *a, fastembed_model_t *b,
+                            const char *text, int dimension) {
+  float *out_a = (float *)calloc(dimension, sizeof(float));
+  float *out_b = (float *)calloc(dimension, sizeof(float));
+  float max_diff = 1e9f;
+
+  if (out_a && out_b && fastembed_model_generate(a, text, out_a, 0) == 0 &&
+      fastembed_model_generate(b, text, out_b, 0) == 0) {
+    max_diff = 0.0f;
+    for (int i = 0; i < dimension; i++) {
+      float diff = fabsf(out_a[i] - out_b[i]);
+      if (diff > max_diff)
+        max_diff = diff;
+    }
+  }
+
+  free(out_a);
+  free(out_b);
+  return max_diff;
+}
+
+/**
+ * Max abs difference between the embeddings of two texts for one model
+ */
+static float text_diff(fastembed_model_t *model, const char *text_a,
+                       const char *text_b, int dimension) {
+  float *out_a = (float *)calloc(dimension, sizeof(float));
+  float *out_b = (float *)calloc(dimension, sizeof(float));
+  float max_diff = 1e9f;
+
+  if (out_a && out_b && fastembed_model_generate(model, text_a, out_a, 0) == 0 &&
+      fastembed_model_generate(model, text_b, out_b, 0) == 0) {
+    max_diff = 0.0f;
+    for (int i = 0; i < dimension; i++) {
+      float diff = fabsf(out_a[i] - out_b[i]);
+      if (diff > max_diff)
+        max_diff = diff;
+    }
+  }
+
+  free(out_a);
+  free(out_b);
+  return max_diff;
+}
+
+/**
+ * Copy a file; returns 0 on success
+ */
+static int copy_file(const char *from, const char *to) {
+  FILE *in = fopen(from, "rb");
+  FILE *out = in ? fopen(to, "wb") : NULL;
+  char buffer[65536];
+  size_t n;
+  int result = (in && out) ? 0 : -1;
+
+  while (result == 0 && (n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    if (fwrite(buffer, 1, n, out) != n)
+      result = -1;
+  }
+
+  if (in)
+    fclose(in);
+  if (out)
+    fclose(out);
+  return result;
+}
+
+/**
+ * Write text to a file; returns 0 on success
+ */
+static int write_text_file(const char *path, const char *text) {
+  FILE *f = fopen(path, "wb");
+  if (f == NULL)
+    return -1;
+  int result = fputs(text, f) >= 0 ? 0 : -1;
+  fclose(f);
+  return result;
+}
+
+/**
+ * Test: fastembed_onnx_options_init() defaults
+ */
+void test_options_defaults(void) {
+  printf("\n=== Test: Option Defaults ===\n");
+
+  fastembed_onnx_options_t options;
+  memset(&options, 0x7f, sizeof(options));
+  fastembed_onnx_options_init(&options);
+
+  ASSERT_EQ_INT(options.intra_op_threads, 0);
+  ASSERT_EQ_INT(options.inter_op_threads, 0);
+  ASSERT_EQ_INT(options.graph_opt_level, FASTEMBED_GRAPH_OPT_ALL);
+  ASSERT_EQ_INT(options.enable_mem_pattern, 1);
+  ASSERT_EQ_INT(options.enable_cpu_mem_arena, 1);
+  ASSERT_EQ_INT(options.num_execution_providers, 0);
+  ASSERT_EQ_INT(options.device_id, 0);
+  ASSERT_TRUE(options.optimized_model_path == NULL,
+              "No optimized model cache by default");
+  ASSERT_TRUE(options.tokenizer_path == NULL,
+              "Tokenizer discovered next to the model by default");
+  ASSERT_EQ_INT(options.pooling, FASTEMBED_POOLING_CLS);
+}
+
+/**
+ * Test: Sessions are keyed by path and options
+ */
+void test_options_registry_key(void) {
+  printf("\n=== Test: Sessions Cached Per Options ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_onnx_options_t defaults;
+  fastembed_onnx_options_init(&defaults);
+
+  fastembed_onnx_options_t tuned;
+  fastembed_onnx_options_init(&tuned);
+  tuned.intra_op_threads = 2;
+  tuned.inter_op_threads = 1;
+  tuned.graph_opt_level = FASTEMBED_GRAPH_OPT_BASIC;
+  tuned.enable_mem_pattern = 0;
+
+  fastembed_model_t *plain = fastembed_model_open(MODEL_PATH);
+  fastembed_model_t *with_defaults =
+      fastembed_model_open_with_options(MODEL_PATH, &defaults);
+  fastembed_model_t *with_tuned =
+      fastembed_model_open_with_options(MODEL_PATH, &tuned);
+  fastembed_model_t *with_tuned_again =
+      fastembed_model_open_with_options(MODEL_PATH, &tuned);
+
+  ASSERT_TRUE(plain != NULL && with_tuned != NULL, "Models opened");
+  ASSERT_TRUE(plain == with_defaults,
+              "Default options share the path-based session");
+  ASSERT_TRUE(with_tuned != plain, "Different options load a new session");
+  ASSERT_TRUE(with_tuned == with_tuned_again,
+              "Same options share one session");
+  ASSERT_TRUE(embedding_diff(plain, with_tuned, "hello world", dimension) <
+                  EPSILON,
+              "Tuned session matches default session");
+
+  fastembed_model_close(with_tuned_again);
+  fastembed_model_close(with_tuned);
+  fastembed_model_close(with_defaults);
+  fastembed_model_close(plain);
+}
+
+/**
+ * Test: Unavailable execution providers fall back to CPU
+ */
+void test_execution_provider_fallback(void) {
+  printf("\n=== Test: Execution Provider Fallback ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_onnx_options_t options;
+  fastembed_onnx_options_init(&options);
+  options.num_execution_providers = 2;
+  options.execution_providers[0] = FASTEMBED_EP_TENSORRT;
+  options.execution_providers[1] = FASTEMBED_EP_CUDA;
+
+  fastembed_model_t *cpu = fastembed_model_open(MODEL_PATH);
+  fastembed_model_t *gpu =
+      fastembed_model_open_with_options(MODEL_PATH, &options);
+
+  ASSERT_TRUE(gpu != NULL, "Model opens with GPU providers requested");
+  if (gpu == NULL) {
+    fastembed_model_close(cpu);
+    return;
+  }
+
+  int provider = fastembed_model_get_execution_provider(gpu);
+  printf("  Selected execution provider: %d\n", provider);
+  ASSERT_TRUE(provider == FASTEMBED_EP_CPU ||
+                  provider == FASTEMBED_EP_TENSORRT ||
+                  provider == FASTEMBED_EP_CUDA,
+              "Provider is a requested one or the CPU fallback");
+  ASSERT_EQ_INT(fastembed_model_get_execution_provider(cpu), FASTEMBED_EP_CPU);
+  ASSERT_TRUE(embedding_diff(cpu, gpu, "machine learning", dimension) <
+                  GPU_EPSILON,
+              "Provider session matches CPU session");
+
+  fastembed_model_close(gpu);
+  fastembed_model_close(cpu);
+}
+
+/**
+ * Test: Optimized model is saved once and reused
+ */
+void test_optimized_model_cache(void) {
+  printf("\n=== Test: Optimized Model Cache ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  remove(OPTIMIZED_CACHE_PATH);
+
+  fastembed_onnx_options_t options;
+  fastembed_onnx_options_init(&options);
+  options.optimized_model_path = OPTIMIZED_CACHE_PATH;
+
+  fastembed_model_t *reference = fastembed_model_open(MODEL_PATH);
+  fastembed_model_t *first =
+      fastembed_model_open_with_options(MODEL_PATH, &options);
+  ASSERT_TRUE(first != NULL, "Model opens with optimized cache path");
+
+  FILE *f = fopen(OPTIMIZED_CACHE_PATH, "rb");
+  ASSERT_TRUE(f != NULL, "Optimized model written to cache path");
+  if (f)
+    fclose(f);
+
+  /* Drop the cached session so the next open loads from the cache file */
+  fastembed_model_close(first);
+  fastembed_onnx_unload();
+
+  fastembed_model_t *second =
+      fastembed_model_open_with_options(MODEL_PATH, &options);
+  ASSERT_TRUE(second != NULL, "Model reopens from optimized cache");
+  if (second != NULL && reference != NULL) {
+    ASSERT_TRUE(embedding_diff(reference, second, "cached graph", dimension) <
+                    EPSILON,
+                "Cached optimized model matches original model");
+  }
+
+  fastembed_model_close(second);
+  fastembed_model_close(reference);
+  remove(OPTIMIZED_CACHE_PATH);
+}
+
+/**
+ * Test: Explicit tokenizer_path
+ */
+void test_tokenizer_path(void) {
+  printf("\n=== Test: Tokenizer Path ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  if (write_text_file(VOCAB_PATH, TEST_VOCAB) != 0) {
+    SKIP("Cannot write test vocabulary");
+    return;
+  }
+
+  fastembed_onnx_options_t options;
+  fastembed_onnx_options_init(&options);
+  options.tokenizer_path = VOCAB_PATH;
+
+  fastembed_model_t *model =
+      fastembed_model_open_with_options(MODEL_PATH, &options);
+  ASSERT_TRUE(model != NULL, "Model opens with tokenizer_path");
+  if (model != NULL) {
+    const fastembed_tokenizer_t *tokenizer = fastembed_model_get_tokenizer(model);
+    ASSERT_TRUE(tokenizer != NULL, "Model uses the given vocabulary");
+    ASSERT_EQ_INT(fastembed_tokenizer_get_vocab_size(tokenizer), 7);
+
+    /* Same WordPiece IDs after lowercasing, accent stripping and splitting */
+    ASSERT_TRUE(text_diff(model, "H\xc3\xa9llo, WORLD", "hello , world",
+                          dimension) < EPSILON,
+                "Normalized texts give identical embeddings");
+    ASSERT_TRUE(text_diff(model, "hello", "world", dimension) > EPSILON,
+                "Different tokens give different embeddings");
+  }
+
+  fastembed_onnx_options_init(&options);
+  options.tokenizer_path = "does_not_exist.vocab.txt";
+  char error[512];
+  ASSERT_TRUE(fastembed_model_open_with_options(MODEL_PATH, &options) == NULL,
+              "Missing tokenizer_path rejected");
+  ASSERT_TRUE(fastembed_onnx_get_last_error(error, sizeof(error)) == 0 &&
+                  strstr(error, "tokenizer") != NULL,
+              "Error names the tokenizer");
+  ASSERT_TRUE(fastembed_model_get_tokenizer(NULL) == NULL,
+              "NULL model has no tokenizer");
+
+  fastembed_model_close(model);
+  remove(VOCAB_PATH);
+}
+
+/**
+ * Test: vocab.txt is discovered in the parent of an onnx/ directory
+ */
+void test_tokenizer_discovery(void) {
+  printf("\n=== Test: Tokenizer Discovery ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  make_directory(DISCOVERY_DIR);
+  make_directory(DISCOVERY_ONNX_DIR);
+  if (copy_file(MODEL_PATH, DISCOVERY_MODEL_PATH) != 0 ||
+      write_text_file(DISCOVERY_VOCAB_PATH, TEST_VOCAB) != 0) {
+    SKIP("Cannot create model directory layout");
+  } else {
+    fastembed_model_t *model = fastembed_model_open(DISCOVERY_MODEL_PATH);
+    ASSERT_TRUE(model != NULL, "Copied model opens");
+    ASSERT_TRUE(model != NULL && fastembed_model_get_tokenizer(model) != NULL,
+                "vocab.txt found in parent directory");
+    fastembed_model_close(model);
+    fastembed_onnx_unload();
+  }
+
+  remove(DISCOVERY_MODEL_PATH);
+  remove(DISCOVERY_VOCAB_PATH);
+  remove_directory(DISCOVERY_ONNX_DIR);
+  remove_directory(DISCOVERY_DIR);
+}
+
+/**
+ * Test: Pooling modes
+ *
+ * Every mode must give unit vectors, and batched results must match
+ * single-text results (padding tokens are excluded from the reduction).
+ */
+void test_pooling_modes(void) {
+  printf("\n=== Test: Pooling Modes ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  static const int modes[] = {FASTEMBED_POOLING_CLS, FASTEMBED_POOLING_MEAN,
+                              FASTEMBED_POOLING_MAX,
+                              FASTEMBED_POOLING_LAST_TOKEN};
+  static const char *texts[3] = {
+      "hello", "a much longer sentence about the weather today", "hello world"};
+  float *single = (float *)calloc(dimension, sizeof(float));
+  float *batch = (float *)calloc((size_t)3 * dimension, sizeof(float));
+  float *pooled = (float *)calloc((size_t)4 * dimension, sizeof(float));
+  if (single == NULL || batch == NULL || pooled == NULL) {
+    printf("  ✗ FAIL: Memory allocation failed\n");
+    tests_run++;
+    free(single);
+    free(batch);
+    free(pooled);
+    return;
+  }
+  float *outputs[3] = {batch, batch + dimension, batch + 2 * dimension};
+
+  for (int m = 0; m < 4; m++) {
+    fastembed_onnx_options_t options;
+    fastembed_onnx_options_init(&options);
+    options.pooling = modes[m];
+    fastembed_model_t *model =
+        fastembed_model_open_with_options(MODEL_PATH, &options);
+    ASSERT_TRUE(model != NULL, "Model opens with pooling mode");
+    if (model == NULL)
+      continue;
+
+    ASSERT_EQ_INT(
+        fastembed_model_batch_generate(model, texts, 3, outputs, dimension), 0);
+    float max_diff = 0.0f;
+    for (int i = 0; i < 3; i++) {
+      if (fastembed_model_generate(model, texts[i], single, dimension) != 0)
+        max_diff = INFINITY;
+      for (int d = 0; d < dimension; d++) {
+        float diff = fabsf(single[d] - outputs[i][d]);
+        max_diff = diff > max_diff ? diff : max_diff;
+      }
+    }
+    printf("  Pooling %d: max difference batch vs single: %g\n", modes[m],
+           max_diff);
+    ASSERT_TRUE(max_diff < EPSILON, "Batched pooling ignores padding");
+
+    double norm = 0.0;
+    for (int d = 0; d < dimension; d++)
+      norm += (double)outputs[1][d] * outputs[1][d];
+    ASSERT_TRUE(fabs(sqrt(norm) - 1.0) < EPSILON, "Pooled embedding is unit");
+
+    memcpy(pooled + (size_t)m * dimension, outputs[1],
+           dimension * sizeof(float));
+    fastembed_model_close(model);
+  }
+
+  for (int m = 1; m < 4; m++) {
+    float max_diff = 0.0f;
+    for (int d = 0; d < dimension; d++) {
+      float diff = fabsf(pooled[d] - pooled[(size_t)m * dimension + d]);
+      max_diff = diff > max_diff ? diff : max_diff;
+    }
+    ASSERT_TRUE(max_diff > EPSILON, "Pooling mode changes the embedding");
+  }
+
+  free(single);
+  free(batch);
+  free(pooled);
+}
+
+/**
+ * Test: Out-of-range options are rejected with an error message
+ */
+void test_invalid_options(void) {
+  printf("\n=== Test: Invalid Options ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_onnx_options_t options;
+  char error[512];
+
+  fastembed_onnx_options_init(&options);
+  options.intra_op_threads = -1;
+  ASSERT_TRUE(fastembed_model_open_with_options(MODEL_PATH, &options) == NULL,
+              "Negative thread count rejected");
+  ASSERT_EQ_INT(fastembed_onnx_get_last_error(error, sizeof(error)), 0);
+
+  fastembed_onnx_options_init(&options);
+  options.graph_opt_level = 7;
+  ASSERT_TRUE(fastembed_model_open_with_options(MODEL_PATH, &options) == NULL,
+              "Unknown graph optimization level rejected");
+
+  fastembed_onnx_options_init(&options);
+  options.num_execution_providers = FASTEMBED_ONNX_MAX_EXECUTION_PROVIDERS + 1;
+  ASSERT_TRUE(fastembed_model_open_with_options(MODEL_PATH, &options) == NULL,
+              "Too many execution providers rejected");
+
+  fastembed_onnx_options_init(&options);
+  options.num_execution_providers = 1;
+  options.execution_providers[0] = 42;
+  ASSERT_TRUE(fastembed_model_open_with_options(MODEL_PATH, &options) == NULL,
+              "Unknown execution provider rejected");
+
+  fastembed_onnx_options_init(&options);
+  options.pooling = FASTEMBED_POOLING_LAST_TOKEN + 1;
+  ASSERT_TRUE(fastembed_model_open_with_options(MODEL_PATH, &options) == NULL,
+              "Unknown pooling mode rejected");
+
+  ASSERT_TRUE(fastembed_model_open_with_options(NULL, NULL) == NULL,
+              "NULL path rejected");
+  ASSERT_EQ_INT(fastembed_model_get_execution_provider(NULL), -1);
+}
+
+int main() {
+  printf("FastEmbed ONNX Session Options Tests\n");
+  printf("====================================\n");
+
+  test_options_defaults();
+  test_options_registry_key();
+  test_execution_provider_fallback();
+  test_optimized_model_cache();
+  test_tokenizer_path();
+  test_tokenizer_discovery();
+  test_pooling_modes();
+  test_invalid_options();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
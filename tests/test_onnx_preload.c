@@ -0,0 +1,327 @@
+/**
+ * FastEmbed Preload and Warmup Tests
+ *
+ * Tests for fastembed_onnx_preload(), the background preload and
+ * fastembed_model_warmup():
+ * - Test invalid arguments and missing models are rejected
+ * - Test a preload loads the session once and runs the warmup shapes
+ * - Test path-based calls reuse the preloaded session
+ * - Test warmup texts stay out of the embedding cache
+ * - Test the background preload, its completion flag and error reporting
+ * - Test preloading with options saves the optimized model
+ *
+ * Compile: gcc -o test_onnx_preload test_onnx_preload.c -L../build
+ * -lfastembed -lm -I../include -DUSE_ONNX_RUNTIME Run: LD_LIBRARY_PATH=..
+ * ./test_onnx_preload
+ */
+
+#include "fastembed.h"
+#include "fastembed_config.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MODEL_PATH "models/test.onnx" /* Placeholder - adjust as needed */
+#define MISSING_MODEL_PATH "models/does_not_exist.onnx"
+#define OPTIMIZED_CACHE_PATH "test_onnx_preload.optimized.onnx"
+#define TEST_TEXT "preloaded sessions answer the first request quickly"
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define SKIP(message)                                                          \
+  do {                                                                         \
+    printf("  ⚠ SKIP: %s\n", message);                                        \
+    tests_run++;                                                               \
+    tests_passed++; /* Don't fail if model not available */                    \
+  } while (0)
+
+static int g_dimension = -1;
+
+/**
+ * Returns model dimension, or -1 (and records a skip) if unavailable
+ */
+static int require_model(void) {
+  if (g_dimension > 0)
+    return g_dimension;
+
+  FILE *f = fopen(MODEL_PATH, "r");
+  if (f == NULL) {
+    printf("  ⚠ SKIP: Test model not found at %s\n", MODEL_PATH);
+    tests_run++;
+    tests_passed++;
+    return -1;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(MODEL_PATH);
+  if (dimension <= 0) {
+    SKIP("Cannot get model dimension");
+    return -1;
+  }
+  g_dimension = dimension;
+  return dimension;
+}
+
+static void sleep_ms(int ms) {
+#ifdef _WIN32
+  Sleep(ms);
+#else
+  usleep(ms * 1000);
+#endif
+}
+
+static int file_exists(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (f == NULL)
+    return 0;
+  fclose(f);
+  return 1;
+}
+
+/**
+ * Test invalid arguments and missing models
+ */
+void test_preload_invalid(void) {
+  printf("\n=== Test: Invalid Arguments ===\n");
+
+  ASSERT_EQ_INT(fastembed_onnx_preload(NULL, NULL), -1);
+  ASSERT_TRUE(fastembed_onnx_preload_async(NULL, NULL) == NULL,
+              "Async preload rejects a NULL path");
+  ASSERT_EQ_INT(fastembed_onnx_preload_done(NULL), -1);
+  ASSERT_EQ_INT(fastembed_onnx_preload_wait(NULL), -1);
+  ASSERT_EQ_INT(fastembed_model_warmup(NULL), -1);
+
+  ASSERT_EQ_INT(fastembed_onnx_preload(MISSING_MODEL_PATH, NULL), -1);
+  char error[512] = {0};
+  ASSERT_EQ_INT(fastembed_onnx_get_last_error(error, sizeof(error)), 0);
+  ASSERT_TRUE(strstr(error, MISSING_MODEL_PATH) != NULL,
+              "Error message names the missing model");
+}
+
+/**
+ * Test a preload loads the session once, runs the warmup shapes and the
+ * next path-based call reuses the session
+ */
+void test_preload_session(void) {
+  printf("\n=== Test: Preload Warms the Path-Based Session ===\n");
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_onnx_unload();
+  fastembed_stats_reset();
+  ASSERT_EQ_INT(fastembed_onnx_preload(MODEL_PATH, NULL), 0);
+
+  fastembed_stats_t stats;
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_LOAD].count, 1);
+  ASSERT_EQ_INT((int)stats.batch_rows.count, 2);
+  ASSERT_EQ_INT((int)stats.batch_rows.min, 1);
+  ASSERT_EQ_INT((int)stats.batch_rows.max, FASTEMBED_ONNX_WARMUP_BATCH_SIZE);
+  ASSERT_TRUE(stats.tokens >= FASTEMBED_ONNX_WARMUP_SHORT_TOKENS +
+                                  (uint64_t)FASTEMBED_ONNX_WARMUP_BATCH_SIZE *
+                                      FASTEMBED_ONNX_WARMUP_LONG_TOKENS,
+              "Warmup texts have the configured token counts");
+  ASSERT_EQ_INT((int)stats.texts, 0); /* Not counted as generate calls */
+
+  /* The first real request finds the session loaded */
+  fastembed_stats_reset();
+  float *preloaded = (float *)calloc((size_t)dimension, sizeof(float));
+  float *cold = (float *)calloc((size_t)dimension, sizeof(float));
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, TEST_TEXT, preloaded,
+                                        dimension),
+                0);
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_LOAD].count, 0);
+
+  /* Same result as a cold session */
+  fastembed_onnx_unload();
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, TEST_TEXT, cold,
+                                        dimension),
+                0);
+  float max_diff = 0.0f;
+  for (int i = 0; i < dimension; i++) {
+    float diff = fabsf(preloaded[i] - cold[i]);
+    if (diff > max_diff)
+      max_diff = diff;
+  }
+  ASSERT_TRUE(max_diff < 1e-6f, "Warmup does not change embeddings");
+
+  /* Preloading a cached session only warms it up again */
+  fastembed_stats_reset();
+  ASSERT_EQ_INT(fastembed_onnx_preload(MODEL_PATH, NULL), 0);
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_LOAD].count, 0);
+
+  free(preloaded);
+  free(cold);
+}
+
+/**
+ * Test warmup texts are not inserted into the embedding cache
+ */
+void test_preload_embedding_cache(void) {
+  printf("\n=== Test: Warmup Bypasses the Embedding Cache ===\n");
+  if (require_model() <= 0)
+    return;
+
+  ASSERT_EQ_INT(fastembed_embedding_cache_set_capacity(1 << 20), 0);
+  fastembed_embedding_cache_reset_stats();
+  ASSERT_EQ_INT(fastembed_onnx_preload(MODEL_PATH, NULL), 0);
+
+  fastembed_embedding_cache_stats_t cache;
+  ASSERT_EQ_INT(fastembed_embedding_cache_get_stats(&cache), 0);
+  ASSERT_EQ_INT((int)cache.entries, 0);
+  ASSERT_EQ_INT((int)(cache.hits + cache.misses), 0);
+
+  fastembed_embedding_cache_set_capacity(0);
+}
+
+/**
+ * Test the background preload and its error reporting
+ */
+void test_preload_async(void) {
+  printf("\n=== Test: Background Preload ===\n");
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_onnx_unload();
+  fastembed_stats_reset();
+  fastembed_preload_t *preload = fastembed_onnx_preload_async(MODEL_PATH, NULL);
+  ASSERT_TRUE(preload != NULL, "Background preload starts");
+  if (preload == NULL)
+    return;
+
+  int done = 0;
+  for (int i = 0; i < 10000 && done == 0; i++) {
+    done = fastembed_onnx_preload_done(preload);
+    if (done == 0)
+      sleep_ms(1);
+  }
+  ASSERT_EQ_INT(done, 1);
+  ASSERT_EQ_INT(fastembed_onnx_preload_wait(preload), 0);
+
+  fastembed_stats_t stats;
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_LOAD].count, 1);
+
+  float *output = (float *)calloc((size_t)dimension, sizeof(float));
+  fastembed_stats_reset();
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, TEST_TEXT, output,
+                                        dimension),
+                0);
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_LOAD].count, 0);
+  free(output);
+
+  /* Errors of the preload thread are reported by the waiting thread */
+  preload = fastembed_onnx_preload_async(MISSING_MODEL_PATH, NULL);
+  ASSERT_TRUE(preload != NULL, "Background preload of a missing model starts");
+  if (preload != NULL) {
+    ASSERT_EQ_INT(fastembed_onnx_preload_wait(preload), -1);
+    char error[512] = {0};
+    ASSERT_EQ_INT(fastembed_onnx_get_last_error(error, sizeof(error)), 0);
+    ASSERT_TRUE(strstr(error, MISSING_MODEL_PATH) != NULL,
+                "Waiting thread sees the preload error");
+  }
+}
+
+/**
+ * Test preloading with options creates the optimized-model cache and warms
+ * the session opened with the same options
+ */
+void test_preload_options(void) {
+  printf("\n=== Test: Preload with Options ===\n");
+  if (require_model() <= 0)
+    return;
+
+  remove(OPTIMIZED_CACHE_PATH);
+  fastembed_onnx_options_t options;
+  fastembed_onnx_options_init(&options);
+  options.intra_op_threads = 1;
+  options.optimized_model_path = OPTIMIZED_CACHE_PATH;
+
+  /* The options are copied: the caller's struct can go away */
+  fastembed_preload_t *preload =
+      fastembed_onnx_preload_async(MODEL_PATH, &options);
+  ASSERT_TRUE(preload != NULL, "Background preload with options starts");
+  options.optimized_model_path = NULL;
+  if (preload != NULL)
+    ASSERT_EQ_INT(fastembed_onnx_preload_wait(preload), 0);
+  ASSERT_TRUE(file_exists(OPTIMIZED_CACHE_PATH),
+              "Preload saves the optimized model");
+
+  /* Opening with the same options reuses the preloaded session */
+  options.optimized_model_path = OPTIMIZED_CACHE_PATH;
+  fastembed_stats_reset();
+  fastembed_model_t *model =
+      fastembed_model_open_with_options(MODEL_PATH, &options);
+  ASSERT_TRUE(model != NULL, "Model opens with the preloaded options");
+  if (model != NULL) {
+    fastembed_stats_t stats;
+    fastembed_stats_snapshot(&stats);
+    ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_LOAD].count, 0);
+    ASSERT_EQ_INT(fastembed_model_warmup(model), 0);
+    fastembed_model_close(model);
+  }
+
+  fastembed_onnx_unload();
+  remove(OPTIMIZED_CACHE_PATH);
+}
+
+int main() {
+  printf("FastEmbed Preload and Warmup Tests\n");
+  printf("==================================\n");
+
+  test_preload_invalid();
+  test_preload_session();
+  test_preload_embedding_cache();
+  test_preload_async();
+  test_preload_options();
+
+  fastembed_onnx_unload();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
@@ -0,0 +1,460 @@
+/**
+ * FastEmbed ONNX Session Registry Tests
+ *
+ * Tests for the thread-safe model session cache and model handles:
+ * - Test opening the same model twice returns the same handle
+ * - Test handle-based inference matches path-based inference
+ * - Test dimension handling for handle-based calls
+ * - Test handles stay valid across fastembed_onnx_unload()
+ * - Test cache capacity validation
+ * - Test concurrent inference from several threads
+ * - Test error messages are per thread
+ *
+ * Compile: gcc -o test_onnx_registry test_onnx_registry.c -L../build
+ * -lfastembed -lm -lpthread -I../include -DUSE_ONNX_RUNTIME Run:
+ * LD_LIBRARY_PATH=.. ./test_onnx_registry
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define EPSILON 0.0001f
+#define MODEL_PATH "models/test.onnx" /* Placeholder - adjust as needed */
+#define MODEL_PATH_ALIAS "./models/test.onnx"
+#define NUM_THREADS 4
+#define CALLS_PER_THREAD 16
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define SKIP(message)                                                          \
+  do {                                                                         \
+    printf("  ⚠ SKIP: %s\n", message);                                        \
+    tests_run++;                                                               \
+    tests_passed++; /* Don't fail if model not available */                    \
+  } while (0)
+
+static const char *thread_texts[] = {
+    "hello world", "machine learning", "a much longer sentence for the model",
+    "short", "embedding vectors are fun"};
+#define NUM_THREAD_TEXTS                                                       \
+  ((int)(sizeof(thread_texts) / sizeof(thread_texts[0])))
+
+/**
+ * Returns model dimension, or -1 (and records a skip) if unavailable
+ */
+static int require_model(void) {
+  FILE *f = fopen(MODEL_PATH, "r");
+  if (f == NULL) {
+    printf("  ⚠ SKIP: Test model not found at %s\n", MODEL_PATH);
+    tests_run++;
+    tests_passed++;
+    return -1;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(MODEL_PATH);
+  if (dimension <= 0) {
+    SKIP("Cannot get model dimension");
+    return -1;
+  }
+  return dimension;
+}
+
+static float max_abs_diff(const float *a, const float *b, int dimension) {
+  float max_diff = 0.0f;
+  for (int i = 0; i < dimension; i++) {
+    float diff = fabsf(a[i] - b[i]);
+    if (diff > max_diff)
+      max_diff = diff;
+  }
+  return max_diff;
+}
+
+/**
+ * Test: Opening the same model returns one shared handle
+ */
+void test_open_same_handle(void) {
+  printf("\n=== Test: Open Same Model Twice ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *first = fastembed_model_open(MODEL_PATH);
+  fastembed_model_t *second = fastembed_model_open(MODEL_PATH);
+  fastembed_model_t *alias = fastembed_model_open(MODEL_PATH_ALIAS);
+
+  ASSERT_TRUE(first != NULL, "Model handle opened");
+  ASSERT_TRUE(first == second, "Same path returns same handle");
+  ASSERT_TRUE(first == alias, "Equivalent path returns same handle");
+  ASSERT_EQ_INT(fastembed_model_get_dimension(first), dimension);
+
+  ASSERT_EQ_INT(fastembed_model_close(alias), 0);
+  ASSERT_EQ_INT(fastembed_model_close(second), 0);
+  ASSERT_EQ_INT(fastembed_model_close(first), 0);
+}
+
+/**
+ * Test: Handle-based inference matches path-based inference
+ */
+void test_handle_matches_path(void) {
+  printf("\n=== Test: Handle Matches Path-Based Inference ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  if (model == NULL) {
+    SKIP("Cannot open model handle");
+    return;
+  }
+
+  float *by_path = (float *)calloc(dimension, sizeof(float));
+  float *by_handle = (float *)calloc(dimension, sizeof(float));
+  float *by_batch = (float *)calloc(dimension, sizeof(float));
+  float **batch_outputs = &by_batch;
+  const char *text = "machine learning";
+
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, text, by_path, dimension),
+                0);
+  ASSERT_EQ_INT(fastembed_model_generate(model, text, by_handle, dimension),
+                0);
+  ASSERT_EQ_INT(
+      fastembed_model_batch_generate(model, &text, 1, batch_outputs, dimension),
+      0);
+
+  ASSERT_TRUE(max_abs_diff(by_path, by_handle, dimension) < EPSILON,
+              "Handle result matches path result");
+  ASSERT_TRUE(max_abs_diff(by_path, by_batch, dimension) < EPSILON,
+              "Handle batch result matches path result");
+
+  free(by_path);
+  free(by_handle);
+  free(by_batch);
+  fastembed_model_close(model);
+}
+
+/**
+ * Test: Dimension 0 uses the model dimension, mismatches are rejected
+ */
+void test_handle_dimension(void) {
+  printf("\n=== Test: Handle Dimension Handling ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  if (model == NULL) {
+    SKIP("Cannot open model handle");
+    return;
+  }
+
+  float *output = (float *)calloc(dimension + 1, sizeof(float));
+  ASSERT_EQ_INT(fastembed_model_generate(model, "test", output, 0), 0);
+  ASSERT_EQ_INT(fastembed_model_generate(model, "test", output, dimension + 1),
+                -1);
+
+  free(output);
+  fastembed_model_close(model);
+}
+
+/**
+ * Test: Open handles survive fastembed_onnx_unload()
+ */
+void test_handle_survives_unload(void) {
+  printf("\n=== Test: Handle Survives Unload ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  if (model == NULL) {
+    SKIP("Cannot open model handle");
+    return;
+  }
+
+  float *before = (float *)calloc(dimension, sizeof(float));
+  float *after = (float *)calloc(dimension, sizeof(float));
+
+  ASSERT_EQ_INT(fastembed_model_generate(model, "unload", before, dimension),
+                0);
+  ASSERT_EQ_INT(fastembed_onnx_unload(), 0);
+  ASSERT_EQ_INT(fastembed_model_generate(model, "unload", after, dimension),
+                0);
+  ASSERT_TRUE(max_abs_diff(before, after, dimension) < EPSILON,
+              "Handle still works after unload");
+
+  /* Path-based calls reload a fresh session */
+  fastembed_model_t *reopened = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(reopened != NULL && reopened != model,
+              "Reopen after unload loads a new session");
+
+  fastembed_model_close(reopened);
+  ASSERT_EQ_INT(fastembed_model_close(model), 0);
+
+  free(before);
+  free(after);
+}
+
+/**
+ * Test: Invalid handles and cache capacities are rejected
+ */
+void test_invalid_input(void) {
+  printf("\n=== Test: Invalid Input ===\n");
+
+  float output[8];
+  const char *text = "test";
+  float *outputs[1] = {output};
+
+  ASSERT_TRUE(fastembed_model_open(NULL) == NULL, "Open NULL path fails");
+  ASSERT_TRUE(fastembed_model_open("nonexistent/model.onnx") == NULL,
+              "Open missing model fails");
+  ASSERT_EQ_INT(fastembed_model_close(NULL), -1);
+  ASSERT_EQ_INT(fastembed_model_get_dimension(NULL), -1);
+  ASSERT_EQ_INT(fastembed_model_generate(NULL, text, output, 8), -1);
+  ASSERT_EQ_INT(fastembed_model_batch_generate(NULL, &text, 1, outputs, 8),
+                -1);
+
+  ASSERT_EQ_INT(fastembed_onnx_set_cache_capacity(0), -1);
+  ASSERT_EQ_INT(fastembed_onnx_set_cache_capacity(-3), -1);
+  ASSERT_EQ_INT(fastembed_onnx_set_cache_capacity(1), 0);
+  ASSERT_EQ_INT(fastembed_onnx_set_cache_capacity(4), 0);
+}
+
+typedef struct {
+  fastembed_model_t *model; /* NULL = use path-based API */
+  int dimension;
+  const float *reference; /* NUM_THREAD_TEXTS * dimension */
+  int failures;
+} WorkerArgs;
+
+static void run_worker(WorkerArgs *args) {
+  float *output = (float *)calloc(args->dimension, sizeof(float));
+  if (output == NULL) {
+    args->failures = CALLS_PER_THREAD;
+    return;
+  }
+
+  for (int i = 0; i < CALLS_PER_THREAD; i++) {
+    int t = i % NUM_THREAD_TEXTS;
+    int result =
+        args->model
+            ? fastembed_model_generate(args->model, thread_texts[t], output,
+                                       args->dimension)
+            : fastembed_onnx_generate(MODEL_PATH, thread_texts[t], output,
+                                      args->dimension);
+    if (result != 0 ||
+        max_abs_diff(output, args->reference + (size_t)t * args->dimension,
+                     args->dimension) >= EPSILON)
+      args->failures++;
+  }
+  free(output);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID arg) {
+  run_worker((WorkerArgs *)arg);
+  return 0;
+}
+#else
+static void *worker_main(void *arg) {
+  run_worker((WorkerArgs *)arg);
+  return NULL;
+}
+#endif
+
+/**
+ * Runs NUM_THREADS workers to completion, returns 0 if all threads started
+ */
+static int run_threads(WorkerArgs *args) {
+#ifdef _WIN32
+  HANDLE threads[NUM_THREADS];
+  for (int i = 0; i < NUM_THREADS; i++) {
+    threads[i] = CreateThread(NULL, 0, worker_main, &args[i], 0, NULL);
+    if (threads[i] == NULL)
+      return -1;
+  }
+  WaitForMultipleObjects(NUM_THREADS, threads, TRUE, INFINITE);
+  for (int i = 0; i < NUM_THREADS; i++)
+    CloseHandle(threads[i]);
+#else
+  pthread_t threads[NUM_THREADS];
+  for (int i = 0; i < NUM_THREADS; i++) {
+    if (pthread_create(&threads[i], NULL, worker_main, &args[i]) != 0)
+      return -1;
+  }
+  for (int i = 0; i < NUM_THREADS; i++)
+    pthread_join(threads[i], NULL);
+#endif
+  return 0;
+}
+
+/**
+ * Test: Concurrent path-based and handle-based calls give correct results
+ */
+void test_concurrent_generate(void) {
+  printf("\n=== Test: Concurrent Inference ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  float *reference =
+      (float *)calloc((size_t)NUM_THREAD_TEXTS * dimension, sizeof(float));
+  for (int t = 0; t < NUM_THREAD_TEXTS; t++) {
+    if (fastembed_onnx_generate(MODEL_PATH, thread_texts[t],
+                                reference + (size_t)t * dimension,
+                                dimension) != 0) {
+      SKIP("Reference embedding failed");
+      free(reference);
+      return;
+    }
+  }
+
+  /* Cold cache: threads race to load the model */
+  fastembed_onnx_unload();
+
+  fastembed_model_t *model = NULL;
+  WorkerArgs args[NUM_THREADS];
+  for (int i = 0; i < NUM_THREADS; i++) {
+    args[i].model = NULL;
+    args[i].dimension = dimension;
+    args[i].reference = reference;
+    args[i].failures = 0;
+  }
+
+  ASSERT_EQ_INT(run_threads(args), 0);
+  int failures = 0;
+  for (int i = 0; i < NUM_THREADS; i++)
+    failures += args[i].failures;
+  ASSERT_EQ_INT(failures, 0);
+
+  /* Shared handle, half the threads path-based */
+  model = fastembed_model_open(MODEL_PATH);
+  for (int i = 0; i < NUM_THREADS; i++) {
+    args[i].model = (i % 2 == 0) ? model : NULL;
+    args[i].failures = 0;
+  }
+
+  ASSERT_EQ_INT(run_threads(args), 0);
+  failures = 0;
+  for (int i = 0; i < NUM_THREADS; i++)
+    failures += args[i].failures;
+  ASSERT_EQ_INT(failures, 0);
+
+  fastembed_model_close(model);
+  free(reference);
+}
+
+typedef struct {
+  int error_result; /* fastembed_onnx_get_last_error() on the worker */
+} ErrorArgs;
+
+#ifdef _WIN32
+static DWORD WINAPI error_worker_main(LPVOID arg) {
+#else
+static void *error_worker_main(void *arg) {
+#endif
+  char buffer[512];
+  ((ErrorArgs *)arg)->error_result =
+      fastembed_onnx_get_last_error(buffer, sizeof(buffer));
+#ifdef _WIN32
+  return 0;
+#else
+  return NULL;
+#endif
+}
+
+/**
+ * Test: An error on one thread is not reported on another thread
+ */
+void test_error_per_thread(void) {
+  printf("\n=== Test: Per-Thread Error Message ===\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+
+  float output[16];
+  ASSERT_EQ_INT(
+      fastembed_onnx_generate("nonexistent/model.onnx", "test", output, 16),
+      -1);
+
+  char buffer[512];
+  ASSERT_EQ_INT(fastembed_onnx_get_last_error(buffer, sizeof(buffer)), 0);
+  ASSERT_TRUE(strlen(buffer) > 0, "Error recorded on failing thread");
+
+  ErrorArgs args = {0};
+#ifdef _WIN32
+  HANDLE thread = CreateThread(NULL, 0, error_worker_main, &args, 0, NULL);
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+#else
+  pthread_t thread;
+  pthread_create(&thread, NULL, error_worker_main, &args);
+  pthread_join(thread, NULL);
+#endif
+  ASSERT_EQ_INT(args.error_result, -1);
+}
+
+int main() {
+  printf("FastEmbed ONNX Session Registry Tests\n");
+  printf("=====================================\n");
+
+  test_open_same_handle();
+  test_handle_matches_path();
+  test_handle_dimension();
+  test_handle_survives_unload();
+  test_invalid_input();
+  test_concurrent_generate();
+  test_error_per_thread();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
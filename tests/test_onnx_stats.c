@@ -0,0 +1,317 @@
+/**
+ * FastEmbed Instrumentation Tests
+ *
+ * Tests for the per-stage latency histograms and counters:
+ * - Test the snapshot rejects invalid arguments
+ * - Test generate calls record every stage, batch rows and padding
+ * - Test histogram summaries are ordered (min <= p50 <= ... <= max)
+ * - Test the JSON snapshot and its truncation
+ * - Test reset and disabling stop recording
+ *
+ * Compile: gcc -o test_onnx_stats test_onnx_stats.c -L../build -lfastembed
+ * -lm -I../include -DUSE_ONNX_RUNTIME Run: LD_LIBRARY_PATH=..
+ * ./test_onnx_stats
+ */
+
+#include "fastembed.h"
+#include "fastembed_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MODEL_PATH "models/test.onnx" /* Placeholder - adjust as needed */
+#define NUM_TEXTS 8
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define SKIP(message)                                                          \
+  do {                                                                         \
+    printf("  ⚠ SKIP: %s\n", message);                                        \
+    tests_run++;                                                               \
+    tests_passed++; /* Don't fail if model not available */                    \
+  } while (0)
+
+static int g_dimension = -1;
+static char g_storage[NUM_TEXTS][96];
+static const char *g_texts[NUM_TEXTS];
+
+/**
+ * Returns model dimension, or -1 (and records a skip) if unavailable
+ */
+static int require_model(void) {
+  if (g_dimension > 0)
+    return g_dimension;
+
+  FILE *f = fopen(MODEL_PATH, "r");
+  if (f == NULL) {
+    printf("  ⚠ SKIP: Test model not found at %s\n", MODEL_PATH);
+    tests_run++;
+    tests_passed++;
+    return -1;
+  }
+  fclose(f);
+
+  int dimension = fastembed_onnx_get_model_dimension(MODEL_PATH);
+  if (dimension <= 0) {
+    SKIP("Cannot get model dimension");
+    return -1;
+  }
+  g_dimension = dimension;
+
+  /* Mixed lengths so length-bucketed batches carry some padding */
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    snprintf(g_storage[i], sizeof(g_storage[i]), "stats text %d%s", i,
+             (i % 2 == 0) ? " with several more words of padding here" : "");
+    g_texts[i] = g_storage[i];
+  }
+  return dimension;
+}
+
+static float **alloc_outputs(int count, int dimension) {
+  float **outputs = (float **)calloc(count, sizeof(float *));
+  for (int i = 0; outputs && i < count; i++) {
+    outputs[i] = (float *)calloc(dimension, sizeof(float));
+    if (outputs[i] == NULL) {
+      for (int j = 0; j < i; j++)
+        free(outputs[j]);
+      free(outputs);
+      return NULL;
+    }
+  }
+  return outputs;
+}
+
+static void free_outputs(float **outputs, int count) {
+  if (outputs == NULL)
+    return;
+  for (int i = 0; i < count; i++)
+    free(outputs[i]);
+  free(outputs);
+}
+
+/** Whether a histogram summary is internally consistent */
+static int histogram_ordered(const fastembed_histogram_t *h) {
+  if (h->count == 0)
+    return h->sum == 0 && h->min == 0 && h->max == 0;
+  return h->min <= h->p50 && h->p50 <= h->p90 && h->p90 <= h->p99 &&
+         h->p99 <= h->p999 && h->p999 <= h->max && h->sum >= h->max;
+}
+
+/**
+ * Test 1: Invalid arguments
+ */
+void test_stats_invalid(void) {
+  printf("\nTest 1: Invalid arguments\n");
+
+  ASSERT_EQ_INT(fastembed_stats_snapshot(NULL), -1);
+  ASSERT_EQ_INT(fastembed_stats_snapshot_json(NULL, 16), -1);
+  ASSERT_TRUE(fastembed_stats_snapshot_json(NULL, 0) > 0,
+              "NULL buffer with size 0 measures the JSON");
+
+  fastembed_stats_t stats;
+  fastembed_stats_reset();
+  ASSERT_EQ_INT(fastembed_stats_snapshot(&stats), 0);
+  ASSERT_EQ_INT(stats.enabled, 1);
+  ASSERT_TRUE(stats.texts == 0 && stats.batch_rows.count == 0,
+              "Reset snapshot is empty");
+}
+
+/**
+ * Test 2: Generate calls record every stage
+ */
+void test_stats_recording(void) {
+  printf("\nTest 2: Generate calls record stages and batches\n");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+  float **outputs = alloc_outputs(NUM_TEXTS, dimension);
+  ASSERT_TRUE(outputs != NULL, "Outputs allocated");
+  if (outputs == NULL)
+    return;
+
+  /* First call may load the model */
+  fastembed_stats_reset();
+  ASSERT_EQ_INT(fastembed_onnx_batch_generate(MODEL_PATH, g_texts, NUM_TEXTS,
+                                              outputs, dimension),
+                0);
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[1], outputs[0],
+                                        dimension),
+                0);
+
+  fastembed_stats_t stats;
+  ASSERT_EQ_INT(fastembed_stats_snapshot(&stats), 0);
+  ASSERT_EQ_INT((int)stats.texts, NUM_TEXTS + 1);
+  ASSERT_EQ_INT((int)stats.errors, 0);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_GENERATE].count, 2);
+  ASSERT_TRUE(stats.stages[FASTEMBED_STAGE_RESOLVE].count >= 2,
+              "Each path call resolves the model");
+  ASSERT_TRUE(stats.stages[FASTEMBED_STAGE_TOKENIZE].count >= 2,
+              "Tokenizing recorded");
+
+  int runs = (int)stats.stages[FASTEMBED_STAGE_RUN].count;
+  ASSERT_TRUE(runs >= 2, "At least one inference call per generate");
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_BIND].count, runs);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_POOL].count, runs);
+  ASSERT_EQ_INT((int)stats.batch_rows.count, runs);
+  ASSERT_EQ_INT((int)stats.batch_rows.sum, NUM_TEXTS + 1);
+  ASSERT_TRUE(stats.batch_rows.max <= FASTEMBED_ONNX_MAX_BATCH_SIZE,
+              "Batch rows within the maximum batch size");
+
+  ASSERT_TRUE(stats.tokens > 0, "Tokens counted");
+  ASSERT_TRUE(stats.padded_tokens >= stats.tokens,
+              "Padded tokens include the real tokens");
+
+  int ordered = 1;
+  for (int s = 0; s < FASTEMBED_STAGE_COUNT; s++)
+    ordered &= histogram_ordered(&stats.stages[s]);
+  ordered &= histogram_ordered(&stats.batch_rows);
+  ASSERT_TRUE(ordered, "Histogram summaries are ordered");
+  ASSERT_TRUE(stats.stages[FASTEMBED_STAGE_GENERATE].max >=
+                  stats.stages[FASTEMBED_STAGE_RUN].min,
+              "A generate call outlasts its fastest inference call");
+
+  /* Model is loaded now: handle calls skip the resolve stage */
+  fastembed_model_t *model = fastembed_model_open(MODEL_PATH);
+  ASSERT_TRUE(model != NULL, "Model opened");
+  if (model != NULL) {
+    fastembed_stats_snapshot(&stats);
+    uint64_t resolves = stats.stages[FASTEMBED_STAGE_RESOLVE].count;
+    ASSERT_EQ_INT(fastembed_model_generate(model, g_texts[2], outputs[0],
+                                           dimension),
+                  0);
+    fastembed_stats_snapshot(&stats);
+    ASSERT_TRUE(stats.stages[FASTEMBED_STAGE_RESOLVE].count == resolves,
+                "Handle calls do not resolve");
+    ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_GENERATE].count, 3);
+    fastembed_model_close(model);
+  }
+
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+/**
+ * Test 3: JSON snapshot
+ */
+void test_stats_json(void) {
+  printf("\nTest 3: JSON snapshot\n");
+
+  char buffer[FASTEMBED_JSON_BUFFER_SIZE];
+  int length = fastembed_stats_snapshot_json(buffer, sizeof(buffer));
+  ASSERT_TRUE(length > 0 && length < (int)sizeof(buffer), "JSON fits");
+  if (length <= 0 || length >= (int)sizeof(buffer))
+    return;
+  ASSERT_EQ_INT((int)strlen(buffer), length);
+  ASSERT_TRUE(buffer[0] == '{' && buffer[length - 1] == '}',
+              "JSON is an object");
+
+  static const char *keys[] = {"\"enabled\":", "\"texts\":",
+                               "\"padded_tokens\":", "\"batch_rows\":",
+                               "\"resolve\":", "\"load\":",
+                               "\"tokenize\":", "\"bind\":",
+                               "\"run\":", "\"pool\":",
+                               "\"generate\":", "\"p999_ns\":"};
+  int found = 1;
+  for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    found &= strstr(buffer, keys[i]) != NULL;
+  ASSERT_TRUE(found, "JSON has every counter and stage");
+
+  /* Truncated output is terminated and reports the full length */
+  char small[16];
+  memset(small, 'x', sizeof(small));
+  ASSERT_EQ_INT(fastembed_stats_snapshot_json(small, sizeof(small)), length);
+  ASSERT_EQ_INT((int)strlen(small), (int)sizeof(small) - 1);
+  ASSERT_TRUE(strncmp(small, buffer, sizeof(small) - 1) == 0,
+              "Truncated JSON is a prefix");
+}
+
+/**
+ * Test 4: Reset and disabling
+ */
+void test_stats_reset_disable(void) {
+  printf("\nTest 4: Reset and disabling\n");
+
+  fastembed_stats_t stats;
+  fastembed_stats_reset();
+  fastembed_stats_snapshot(&stats);
+  int empty = stats.texts == 0 && stats.tokens == 0 &&
+              stats.padded_tokens == 0 && stats.batch_rows.count == 0;
+  for (int s = 0; s < FASTEMBED_STAGE_COUNT; s++)
+    empty &= stats.stages[s].count == 0 && stats.stages[s].max == 0;
+  ASSERT_TRUE(empty, "Reset zeroes every counter");
+
+  int dimension = require_model();
+  if (dimension <= 0)
+    return;
+  float **outputs = alloc_outputs(1, dimension);
+  if (outputs == NULL)
+    return;
+
+  fastembed_stats_set_enabled(0);
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[0], outputs[0],
+                                        dimension),
+                0);
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT(stats.enabled, 0);
+  ASSERT_TRUE(stats.texts == 0 && stats.stages[FASTEMBED_STAGE_RUN].count == 0,
+              "Nothing recorded while disabled");
+
+  fastembed_stats_set_enabled(1);
+  ASSERT_EQ_INT(fastembed_onnx_generate(MODEL_PATH, g_texts[0], outputs[0],
+                                        dimension),
+                0);
+  fastembed_stats_snapshot(&stats);
+  ASSERT_EQ_INT((int)stats.texts, 1);
+  ASSERT_EQ_INT((int)stats.stages[FASTEMBED_STAGE_GENERATE].count, 1);
+
+  free_outputs(outputs, 1);
+}
+
+int main() {
+  printf("FastEmbed Instrumentation Tests\n");
+  printf("===============================\n");
+
+  test_stats_invalid();
+  test_stats_recording();
+  test_stats_json();
+  test_stats_reset_disable();
+
+  fastembed_onnx_unload();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
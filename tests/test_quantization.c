@@ -0,0 +1,587 @@
+/**
+ * FastEmbed Quantization Tests
+ *
+ * Tests for int8 / binary quantized embeddings:
+ * - Test fastembed_quantize_int8() round trip error, code range and scales
+ * - Test fastembed_quantize_binary() bit layout and padding
+ * - Test fastembed_int8_dot_product() and fastembed_hamming_distance()
+ *   against scalar references at every SIMD level the CPU supports,
+ *   including tails, unaligned pointers and extreme values
+ * - Test fastembed_generate_quantized() against quantizing
+ *   fastembed_generate() output
+ * - Test fastembed_topk_int8() / fastembed_topk_binary() against brute force
+ *   and across thread counts
+ * - Test binary shortlist + fastembed_topk_rescore() recall against exact
+ *   float search
+ * - Measure memory per vector and binary vs float search throughput
+ *
+ * Compile: gcc -o test_quantization test_quantization.c -L../build
+ * -lfastembed -lm -I../include Run: LD_LIBRARY_PATH=.. ./test_quantization
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+static const char *level_name(int level) {
+  switch (level) {
+  case FASTEMBED_SIMD_SCALAR:
+    return "scalar";
+  case FASTEMBED_SIMD_SSE:
+    return "SSE";
+  case FASTEMBED_SIMD_NEON:
+    return "NEON";
+  case FASTEMBED_SIMD_AVX2:
+    return "AVX2";
+  case FASTEMBED_SIMD_AVX512:
+    return "AVX-512";
+  default:
+    return "unknown";
+  }
+}
+
+static void fill_random(float *v, int n) {
+  for (int i = 0; i < n; i++)
+    v[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static void normalize_rows(float *rows, int count, int dim) {
+  for (int r = 0; r < count; r++)
+    fastembed_normalize(rows + (size_t)r * dim, dim);
+}
+
+/**
+ * Test: int8 quantization round trip
+ */
+static void test_quantize_int8(void) {
+  printf("\n=== Test: int8 Quantization ===\n");
+
+  const int dim = 384, count = 8;
+  float *vectors = malloc((size_t)count * dim * sizeof(float));
+  float *restored = malloc((size_t)count * dim * sizeof(float));
+  int8_t *codes = malloc((size_t)count * dim);
+  float scales[8];
+
+  fill_random(vectors, count * dim);
+  /* Row 3 is a zero vector */
+  memset(vectors + 3 * dim, 0, dim * sizeof(float));
+
+  ASSERT_EQ_INT(fastembed_quantize_int8(vectors, count, dim, codes, scales), 0);
+  ASSERT_EQ_INT(fastembed_dequantize_int8(codes, scales, count, dim, restored),
+                0);
+
+  int in_range = 1, error_ok = 1, has_extreme = 1;
+  for (int r = 0; r < count; r++) {
+    int extreme = 0;
+    for (int i = 0; i < dim; i++) {
+      int8_t c = codes[(size_t)r * dim + i];
+      if (c < -127)
+        in_range = 0;
+      if (c == 127 || c == -127)
+        extreme = 1;
+      float diff = fabsf(restored[(size_t)r * dim + i] -
+                         vectors[(size_t)r * dim + i]);
+      if (diff > scales[r] * 0.5f + 1e-6f)
+        error_ok = 0;
+    }
+    if (r != 3 && !extreme)
+      has_extreme = 0;
+  }
+  ASSERT_TRUE(in_range, "Codes are in [-127, 127]");
+  ASSERT_TRUE(error_ok, "Round trip error is at most half a step");
+  ASSERT_TRUE(has_extreme, "Largest component maps to +-127");
+  ASSERT_TRUE(scales[3] == 0.0f, "Zero vector has scale 0");
+
+  int zero_codes = 1;
+  for (int i = 0; i < dim; i++)
+    if (codes[3 * dim + i] != 0)
+      zero_codes = 0;
+  ASSERT_TRUE(zero_codes, "Zero vector has all-zero codes");
+
+  ASSERT_EQ_INT(fastembed_quantize_int8(NULL, 1, dim, codes, scales), -1);
+  ASSERT_EQ_INT(fastembed_quantize_int8(vectors, 0, dim, codes, scales), -1);
+  ASSERT_EQ_INT(fastembed_quantize_int8(vectors, 1, dim, codes, NULL), -1);
+  ASSERT_EQ_INT(fastembed_dequantize_int8(codes, NULL, 1, dim, restored), -1);
+
+  free(vectors);
+  free(restored);
+  free(codes);
+}
+
+/**
+ * Test: binary quantization bit layout
+ */
+static void test_quantize_binary(void) {
+  printf("\n=== Test: Binary Quantization ===\n");
+
+  ASSERT_EQ_INT(FASTEMBED_BINARY_BYTES(1), 1);
+  ASSERT_EQ_INT(FASTEMBED_BINARY_BYTES(8), 1);
+  ASSERT_EQ_INT(FASTEMBED_BINARY_BYTES(9), 2);
+  ASSERT_EQ_INT(FASTEMBED_BINARY_BYTES(384), 48);
+
+  const int dim = 13, count = 3;
+  float vectors[39];
+  uint8_t bits[6];
+  fill_random(vectors, count * dim);
+  vectors[0] = 0.0f; /* Zero is not positive */
+
+  memset(bits, 0xFF, sizeof(bits));
+  ASSERT_EQ_INT(fastembed_quantize_binary(vectors, count, dim, bits), 0);
+
+  int layout_ok = 1, padding_ok = 1;
+  for (int r = 0; r < count; r++) {
+    const uint8_t *row = bits + r * FASTEMBED_BINARY_BYTES(dim);
+    for (int i = 0; i < dim; i++) {
+      int bit = (row[i / 8] >> (i % 8)) & 1;
+      if (bit != (vectors[r * dim + i] > 0.0f))
+        layout_ok = 0;
+    }
+    if (row[1] >> (dim - 8))
+      padding_ok = 0;
+  }
+  ASSERT_TRUE(layout_ok, "Bit i is set when component i is positive");
+  ASSERT_TRUE(padding_ok, "Unused bits of the last byte are 0");
+  ASSERT_TRUE((bits[0] & 1) == 0, "Zero component gives a clear bit");
+
+  ASSERT_EQ_INT(fastembed_quantize_binary(vectors, count, 0, bits), -1);
+  ASSERT_EQ_INT(fastembed_quantize_binary(NULL, count, dim, bits), -1);
+
+  printf("  384-dim vector: float32 %d bytes, int8 %d + 4 bytes, binary %d "
+         "bytes\n",
+         384 * 4, 384, FASTEMBED_BINARY_BYTES(384));
+}
+
+static int32_t reference_int8_dot(const int8_t *a, const int8_t *b, int n) {
+  int32_t sum = 0;
+  for (int i = 0; i < n; i++)
+    sum += (int32_t)a[i] * b[i];
+  return sum;
+}
+
+static int reference_hamming(const uint8_t *a, const uint8_t *b, int n) {
+  int distance = 0;
+  for (int i = 0; i < n; i++)
+    for (int bit = 0; bit < 8; bit++)
+      distance += ((a[i] ^ b[i]) >> bit) & 1;
+  return distance;
+}
+
+/**
+ * Check both kernels at the currently installed level
+ *
+ * @return Number of mismatches
+ */
+static int check_kernels(void) {
+  enum { MAX_N = 4200 };
+  static int8_t a[MAX_N + 1], b[MAX_N + 1];
+  static uint8_t x[MAX_N + 1], y[MAX_N + 1];
+  int failures = 0;
+
+  for (int i = 0; i <= MAX_N; i++) {
+    a[i] = (int8_t)(rand() % 256 - 128); /* a may be -128 */
+    b[i] = (int8_t)(rand() % 255 - 127); /* b in [-127, 127] */
+    x[i] = (uint8_t)rand();
+    y[i] = (uint8_t)rand();
+  }
+
+  for (int n = 1; n <= MAX_N; n += (n < 300 ? 1 : 97)) {
+    /* Offset 1 exercises unaligned loads */
+    for (int offset = 0; offset <= 1; offset++) {
+      if (n + offset > MAX_N + 1)
+        continue;
+      int32_t dot = fastembed_int8_dot_product(a + offset, b + offset, n);
+      if (dot != reference_int8_dot(a + offset, b + offset, n)) {
+        printf("    int8 dot mismatch at n %d offset %d\n", n, offset);
+        failures++;
+      }
+      int ham = fastembed_hamming_distance(x + offset, y + offset, n);
+      if (ham != reference_hamming(x + offset, y + offset, n)) {
+        printf("    hamming mismatch at n %d offset %d\n", n, offset);
+        failures++;
+      }
+    }
+  }
+
+  /* Extremes: largest magnitude sums and all bits different */
+  static int8_t hi[2048], lo[2048];
+  static uint8_t ones[2048], zeros[2048];
+  for (int i = 0; i < 2048; i++) {
+    hi[i] = 127;
+    lo[i] = -127;
+    ones[i] = 0xFF;
+    zeros[i] = 0;
+  }
+  if (fastembed_int8_dot_product(hi, hi, 2048) != 127 * 127 * 2048 ||
+      fastembed_int8_dot_product(lo, hi, 2048) != -127 * 127 * 2048 ||
+      fastembed_int8_dot_product(lo, lo, 2048) != 127 * 127 * 2048) {
+    printf("    int8 dot extremes mismatch\n");
+    failures++;
+  }
+  if (fastembed_hamming_distance(ones, zeros, 2048) != 2048 * 8 ||
+      fastembed_hamming_distance(ones, ones, 2048) != 0) {
+    printf("    hamming extremes mismatch\n");
+    failures++;
+  }
+
+  return failures;
+}
+
+/**
+ * Test: Kernels match the scalar reference at every level
+ */
+static void test_kernels_all_levels(void) {
+  printf("\n=== Test: Quantized Kernels Match Reference ===\n");
+
+  int best = fastembed_get_simd_level();
+  const int levels[] = {FASTEMBED_SIMD_SSE, FASTEMBED_SIMD_AVX2,
+                        FASTEMBED_SIMD_AVX512};
+  int checked = 0;
+
+  for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+    if (best < FASTEMBED_SIMD_SSE || best == FASTEMBED_SIMD_NEON)
+      break; /* Single implementation, checked below */
+    if (levels[i] > best)
+      continue;
+    if (fastembed_set_simd_level(levels[i]) != levels[i])
+      continue;
+
+    char message[96];
+    snprintf(message, sizeof(message), "%s int8 / Hamming kernels match",
+             level_name(levels[i]));
+    ASSERT_TRUE(check_kernels() == 0, message);
+    checked++;
+  }
+
+  if (checked == 0) {
+    char message[96];
+    snprintf(message, sizeof(message), "%s int8 / Hamming kernels match",
+             level_name(best));
+    ASSERT_TRUE(check_kernels() == 0, message);
+  }
+
+  fastembed_set_simd_level(FASTEMBED_SIMD_AVX512);
+  ASSERT_EQ_INT(fastembed_get_simd_level(), best);
+
+  int8_t v[4] = {1, 2, 3, 4};
+  ASSERT_EQ_INT(fastembed_int8_dot_product(NULL, v, 4), 0);
+  ASSERT_EQ_INT(fastembed_hamming_distance(NULL, (const uint8_t *)v, 4), -1);
+  ASSERT_EQ_INT(fastembed_hamming_distance((const uint8_t *)v,
+                                           (const uint8_t *)v, 0),
+                -1);
+}
+
+/**
+ * Test: Quantized generation matches quantizing the float embedding
+ */
+static void test_generate_quantized(void) {
+  printf("\n=== Test: Quantized Generation ===\n");
+
+  const char *text = "quantized embeddings are small";
+  const int dim = 768;
+  float embedding[768], scale = 0.0f, expected_scale = 0.0f;
+  int8_t codes[768], expected_codes[768];
+  uint8_t bits[96], expected_bits[96];
+
+  ASSERT_EQ_INT(fastembed_generate(text, embedding, dim), 0);
+  fastembed_quantize_int8(embedding, 1, dim, expected_codes, &expected_scale);
+  fastembed_quantize_binary(embedding, 1, dim, expected_bits);
+
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, codes, &scale, dim,
+                                             FASTEMBED_QUANT_INT8),
+                0);
+  ASSERT_TRUE(memcmp(codes, expected_codes, dim) == 0 &&
+                  scale == expected_scale,
+              "int8 output matches fastembed_quantize_int8()");
+
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, bits, NULL, dim,
+                                             FASTEMBED_QUANT_BINARY),
+                0);
+  ASSERT_TRUE(memcmp(bits, expected_bits, sizeof(bits)) == 0,
+              "Binary output matches fastembed_quantize_binary()");
+
+  /* Dimension 0 = default, as for fastembed_generate() */
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, codes, &scale, 0,
+                                             FASTEMBED_QUANT_INT8),
+                0);
+
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, codes, NULL, dim,
+                                             FASTEMBED_QUANT_INT8),
+                -1);
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, codes, &scale, dim, 0), -1);
+  ASSERT_EQ_INT(fastembed_generate_quantized(text, codes, &scale, 100,
+                                             FASTEMBED_QUANT_INT8),
+                -1);
+  ASSERT_EQ_INT(fastembed_onnx_generate_quantized(NULL, text, codes, &scale,
+                                                  dim, FASTEMBED_QUANT_INT8),
+                -1);
+  ASSERT_EQ_INT(fastembed_onnx_generate_quantized("model.onnx", text, bits,
+                                                  NULL, dim, 99),
+                -1);
+}
+
+/**
+ * Test: Quantized top-k matches brute force, for any thread count
+ */
+static void test_quantized_topk(void) {
+  printf("\n=== Test: Quantized Top-k ===\n");
+
+  const int dim = 256, count = 3000, k = 10;
+  const int row_bytes = FASTEMBED_BINARY_BYTES(dim);
+  float *corpus = malloc((size_t)count * dim * sizeof(float));
+  int8_t *codes = malloc((size_t)count * dim);
+  float *scales = malloc(count * sizeof(float));
+  uint8_t *bits = malloc((size_t)count * row_bytes);
+  float query[256], query_scale;
+  int8_t query_codes[256];
+  uint8_t query_bits[32];
+
+  fill_random(corpus, count * dim);
+  normalize_rows(corpus, count, dim);
+  fill_random(query, dim);
+  fastembed_normalize(query, dim);
+  fastembed_quantize_int8(corpus, count, dim, codes, scales);
+  fastembed_quantize_binary(corpus, count, dim, bits);
+  fastembed_quantize_int8(query, 1, dim, query_codes, &query_scale);
+  fastembed_quantize_binary(query, 1, dim, query_bits);
+
+  /* Binary: distances ascending, ties by row, matching brute force */
+  int ids[10], distances[10], ids4[10], distances4[10];
+  ASSERT_EQ_INT(fastembed_topk_binary(query_bits, bits, count, dim, k, ids,
+                                      distances, 1),
+                k);
+  ASSERT_EQ_INT(fastembed_topk_binary(query_bits, bits, count, dim, k, ids4,
+                                      distances4, 4),
+                k);
+  int sorted = 1, exact = 1;
+  for (int i = 0; i < k; i++) {
+    if (distances[i] != fastembed_hamming_distance(
+                            query_bits, bits + (size_t)ids[i] * row_bytes,
+                            row_bytes))
+      exact = 0;
+    if (i > 0 && (distances[i] < distances[i - 1] ||
+                  (distances[i] == distances[i - 1] && ids[i] < ids[i - 1])))
+      sorted = 0;
+  }
+  int better_rows = 0; /* Rows strictly nearer than the k-th result */
+  for (int r = 0; r < count; r++) {
+    int d = fastembed_hamming_distance(query_bits, bits + (size_t)r * row_bytes,
+                                       row_bytes);
+    if (d < distances[k - 1] ||
+        (d == distances[k - 1] && r < ids[k - 1]))
+      better_rows++;
+  }
+  ASSERT_TRUE(exact, "Binary top-k distances are exact");
+  ASSERT_TRUE(sorted, "Binary top-k is sorted nearest first");
+  ASSERT_EQ_INT(better_rows, k - 1);
+  ASSERT_TRUE(memcmp(ids, ids4, sizeof(ids)) == 0 &&
+                  memcmp(distances, distances4, sizeof(distances)) == 0,
+              "Binary top-k does not depend on thread count");
+
+  /* int8: scores are dequantized dot products close to float cosine */
+  float scores[10], scores4[10];
+  ASSERT_EQ_INT(fastembed_topk_int8(query_codes, query_scale, codes, scales,
+                                    count, dim, k, ids, scores, 1),
+                k);
+  ASSERT_EQ_INT(fastembed_topk_int8(query_codes, query_scale, codes, scales,
+                                    count, dim, k, ids4, scores4, 4),
+                k);
+  int scores_ok = 1;
+  for (int i = 0; i < k; i++) {
+    float expected = (float)reference_int8_dot(
+                         query_codes, codes + (size_t)ids[i] * dim, dim) *
+                     query_scale * scales[ids[i]];
+    float cosine =
+        fastembed_dot_product(query, corpus + (size_t)ids[i] * dim, dim);
+    if (fabsf(scores[i] - expected) > 1e-6f || fabsf(scores[i] - cosine) > 0.02f)
+      scores_ok = 0;
+  }
+  ASSERT_TRUE(scores_ok, "int8 scores match dequantized dot products");
+  ASSERT_TRUE(memcmp(ids, ids4, sizeof(ids)) == 0,
+              "int8 top-k does not depend on thread count");
+
+  int exact_ids[10];
+  float exact_scores[10];
+  fastembed_topk(query, corpus, count, dim, k, exact_ids, exact_scores);
+  int overlap = 0;
+  for (int i = 0; i < k; i++)
+    for (int j = 0; j < k; j++)
+      if (ids[i] == exact_ids[j])
+        overlap++;
+  printf("  int8 recall@%d: %.2f\n", k, (double)overlap / k);
+  ASSERT_TRUE(overlap >= k - 2, "int8 top-k recall@10 >= 0.8");
+
+  /* k larger than the corpus is clamped */
+  ASSERT_EQ_INT(fastembed_topk_binary(query_bits, bits, 5, dim, k, ids,
+                                      distances, 1),
+                5);
+  ASSERT_EQ_INT(fastembed_topk_binary(NULL, bits, count, dim, k, ids,
+                                      distances, 1),
+                -1);
+  ASSERT_EQ_INT(fastembed_topk_int8(query_codes, query_scale, codes, NULL,
+                                    count, dim, k, ids, scores, 1),
+                -1);
+
+  free(corpus);
+  free(codes);
+  free(scales);
+  free(bits);
+}
+
+/**
+ * Test: Binary shortlist + float rescoring recovers exact results
+ */
+static void test_rescore(void) {
+  printf("\n=== Test: Binary Shortlist + Rescore ===\n");
+
+  /* Clustered data, like real embeddings: 200 centres with noise */
+  const int dim = 384, count = 20000, k = 10, shortlist = 100, queries = 50;
+  const int row_bytes = FASTEMBED_BINARY_BYTES(dim);
+  float *centres = malloc((size_t)200 * dim * sizeof(float));
+  float *corpus = malloc((size_t)count * dim * sizeof(float));
+  uint8_t *bits = malloc((size_t)count * row_bytes);
+  fill_random(centres, 200 * dim);
+  for (int r = 0; r < count; r++) {
+    const float *centre = centres + (size_t)(r % 200) * dim;
+    float *row = corpus + (size_t)r * dim;
+    fill_random(row, dim);
+    for (int i = 0; i < dim; i++)
+      row[i] = centre[i] + 0.5f * row[i];
+  }
+  normalize_rows(corpus, count, dim);
+  fastembed_quantize_binary(corpus, count, dim, bits);
+
+  /* All rows as candidates = exact search */
+  int *all = malloc(count * sizeof(int));
+  for (int r = 0; r < count; r++)
+    all[r] = r;
+  const float *query0 = corpus + (size_t)7 * dim;
+  int ids[10], exact_ids[10], candidates[100], distances[100];
+  float scores[10], exact_scores[10];
+  ASSERT_EQ_INT(fastembed_topk_rescore(query0, corpus, count, dim, all, count,
+                                       k, ids, scores, FASTEMBED_METRIC_COSINE),
+                k);
+  fastembed_topk(query0, corpus, count, dim, k, exact_ids, exact_scores);
+  int same = memcmp(ids, exact_ids, sizeof(ids)) == 0;
+  for (int i = 0; i < k; i++)
+    if (fabsf(scores[i] - exact_scores[i]) > 1e-6f)
+      same = 0;
+  ASSERT_TRUE(same, "Rescoring every row equals fastembed_topk()");
+
+  /* Euclidean rescoring returns distances */
+  ASSERT_EQ_INT(fastembed_topk_rescore(query0, corpus, count, dim, all, 100, 1,
+                                       ids, scores,
+                                       FASTEMBED_METRIC_EUCLIDEAN),
+                1);
+  ASSERT_TRUE(ids[0] == 7 && scores[0] < 1e-3f,
+              "Euclidean rescoring finds the query row at distance 0");
+
+  int found = 0;
+  for (int q = 0; q < queries; q++) {
+    float query[384];
+    uint8_t query_bits[48];
+    const float *base = corpus + (size_t)(q * 397 % count) * dim;
+    fill_random(query, dim);
+    for (int i = 0; i < dim; i++)
+      query[i] = base[i] + 0.02f * query[i];
+    fastembed_normalize(query, dim);
+    fastembed_quantize_binary(query, 1, dim, query_bits);
+
+    int n = fastembed_topk_binary(query_bits, bits, count, dim, shortlist,
+                                  candidates, distances, 0);
+    fastembed_topk_rescore(query, corpus, count, dim, candidates, n, k, ids,
+                           scores, FASTEMBED_METRIC_COSINE);
+    fastembed_topk(query, corpus, count, dim, k, exact_ids, exact_scores);
+    for (int i = 0; i < k; i++)
+      for (int j = 0; j < k; j++)
+        if (ids[i] == exact_ids[j])
+          found++;
+  }
+  double recall = (double)found / (queries * k);
+  printf("  Binary top-%d + rescore recall@%d: %.3f\n", shortlist, k, recall);
+  ASSERT_TRUE(recall >= 0.9, "Shortlist + rescore recall@10 >= 0.9");
+
+  candidates[0] = count;
+  ASSERT_EQ_INT(fastembed_topk_rescore(query0, corpus, count, dim, candidates,
+                                       1, k, ids, scores,
+                                       FASTEMBED_METRIC_COSINE),
+                -1);
+  ASSERT_EQ_INT(fastembed_topk_rescore(query0, corpus, count, dim, all, 10, k,
+                                       ids, scores, 7),
+                -1);
+
+  /* Throughput: Hamming scan vs float scan (informational) */
+  uint8_t query_bits[48];
+  fastembed_quantize_binary(query0, 1, dim, query_bits);
+  clock_t start = clock();
+  for (int i = 0; i < 20; i++)
+    fastembed_topk_binary(query_bits, bits, count, dim, shortlist, candidates,
+                          distances, 1);
+  double binary_seconds = (double)(clock() - start) / CLOCKS_PER_SEC / 20;
+  start = clock();
+  for (int i = 0; i < 20; i++)
+    fastembed_topk(query0, corpus, count, dim, k, exact_ids, exact_scores);
+  double float_seconds = (double)(clock() - start) / CLOCKS_PER_SEC / 20;
+  printf("  %d x %d: binary top-k %.3f ms, float top-k %.3f ms\n", count, dim,
+         binary_seconds * 1e3, float_seconds * 1e3);
+
+  free(centres);
+  free(corpus);
+  free(bits);
+  free(all);
+}
+
+int main() {
+  printf("FastEmbed Quantization Tests\n");
+  printf("============================\n");
+
+  srand(42);
+
+  test_quantize_int8();
+  test_quantize_binary();
+  test_kernels_all_levels();
+  test_generate_quantized();
+  test_quantized_topk();
+  test_rescore();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
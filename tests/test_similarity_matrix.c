@@ -0,0 +1,313 @@
+/**
+ * FastEmbed Similarity Matrix Tests
+ *
+ * Tests for fastembed_similarity_matrix() / _threaded():
+ * - Test dot, cosine and Euclidean scores against a double-precision
+ *   pairwise reference for odd query / corpus counts and dimensions
+ * - Test that the threaded path matches the single-threaded result
+ * - Test zero vectors and invalid arguments
+ * - Measure 1 and 8 queries against a 100k-row corpus
+ *
+ * Compile: gcc -o test_similarity_matrix test_similarity_matrix.c -L../build
+ * -lfastembed -lm -lpthread -I../include Run: LD_LIBRARY_PATH=..
+ * ./test_similarity_matrix
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GUARD 8
+#define GUARD_VALUE 12345.0f
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+static void fill_random(float *v, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    v[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static double reference_score(const float *a, const float *b, int dim,
+                              int metric) {
+  double dot = 0.0, sum_a = 0.0, sum_b = 0.0, dist = 0.0;
+  for (int i = 0; i < dim; i++) {
+    dot += (double)a[i] * b[i];
+    sum_a += (double)a[i] * a[i];
+    sum_b += (double)b[i] * b[i];
+    dist += ((double)a[i] - b[i]) * ((double)a[i] - b[i]);
+  }
+  if (metric == FASTEMBED_METRIC_DOT)
+    return dot;
+  if (metric == FASTEMBED_METRIC_EUCLIDEAN)
+    return sqrt(dist);
+  if (sum_a == 0.0 || sum_b == 0.0)
+    return 0.0;
+  return dot / (sqrt(sum_a) * sqrt(sum_b));
+}
+
+/**
+ * Compare one matrix against the pairwise reference
+ *
+ * @return Number of mismatches (also counts writes past the output)
+ */
+static int check_matrix(int nq, int nc, int dim, int metric, int threads) {
+  float *queries = malloc((size_t)nq * dim * sizeof(float));
+  float *corpus = malloc((size_t)nc * dim * sizeof(float));
+  float *out = malloc(((size_t)nq * nc + GUARD) * sizeof(float));
+  int failures = 0;
+
+  fill_random(queries, (size_t)nq * dim);
+  fill_random(corpus, (size_t)nc * dim);
+  for (int i = 0; i < GUARD; i++)
+    out[(size_t)nq * nc + i] = GUARD_VALUE;
+
+  if (fastembed_similarity_matrix_threaded(queries, nq, corpus, nc, dim, out,
+                                           metric, threads) != 0) {
+    printf("    call failed (%dx%d, dim %d)\n", nq, nc, dim);
+    failures++;
+  } else {
+    /* Euclidean uses ||q||^2 + ||c||^2 - 2 q.c, so allow for cancellation */
+    double tolerance = metric == FASTEMBED_METRIC_COSINE ? 1e-4 : 1e-3;
+    for (int q = 0; q < nq && failures == 0; q++) {
+      for (int c = 0; c < nc; c++) {
+        double expected = reference_score(queries + (size_t)q * dim,
+                                          corpus + (size_t)c * dim, dim,
+                                          metric);
+        double actual = out[(size_t)q * nc + c];
+        double scale = fabs(expected) > 1.0 ? fabs(expected) : 1.0;
+        if (fabs(actual - expected) > tolerance * scale) {
+          printf("    metric %d mismatch at (%d, %d): %f vs %f (%dx%d, dim "
+                 "%d)\n",
+                 metric, q, c, actual, expected, nq, nc, dim);
+          failures++;
+          break;
+        }
+      }
+    }
+    for (int i = 0; i < GUARD; i++) {
+      if (out[(size_t)nq * nc + i] != GUARD_VALUE) {
+        printf("    write past end (%dx%d, dim %d)\n", nq, nc, dim);
+        failures++;
+        break;
+      }
+    }
+  }
+
+  free(queries);
+  free(corpus);
+  free(out);
+  return failures;
+}
+
+/**
+ * Test: All metrics match the pairwise reference
+ */
+static void test_matches_reference(void) {
+  printf("\n=== Test: Matrix Matches Pairwise Reference ===\n");
+
+  const int dims[] = {1, 3, 7, 16, 33, 100, 384, 769};
+  const int corpus_sizes[] = {1, 2, 3, 4, 5, 9, 31, 130};
+  const int metrics[] = {FASTEMBED_METRIC_DOT, FASTEMBED_METRIC_COSINE,
+                         FASTEMBED_METRIC_EUCLIDEAN};
+  const char *names[] = {"Dot", "Cosine", "Euclidean"};
+
+  for (int m = 0; m < 3; m++) {
+    int failures = 0, cases = 0;
+    for (size_t d = 0; d < sizeof(dims) / sizeof(dims[0]); d++) {
+      for (size_t c = 0; c < sizeof(corpus_sizes) / sizeof(corpus_sizes[0]);
+           c++) {
+        for (int nq = 1; nq <= 5; nq += 2) {
+          failures += check_matrix(nq, corpus_sizes[c], dims[d], metrics[m], 1);
+          cases++;
+        }
+      }
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "%s matrix matches reference (%d cases)",
+             names[m], cases);
+    ASSERT_TRUE(failures == 0, message);
+  }
+
+  /* Corpus larger than one cache block */
+  ASSERT_TRUE(check_matrix(3, 1031, 128, FASTEMBED_METRIC_COSINE, 1) == 0,
+              "Multi-block corpus matches reference");
+}
+
+/**
+ * Test: Threaded results match single-threaded results
+ */
+static void test_threaded_matches_single(void) {
+  printf("\n=== Test: Threaded Matches Single-Threaded ===\n");
+
+  const int nq = 4, nc = 20003, dim = 96;
+  float *queries = malloc((size_t)nq * dim * sizeof(float));
+  float *corpus = malloc((size_t)nc * dim * sizeof(float));
+  float *single = malloc((size_t)nq * nc * sizeof(float));
+  float *threaded = malloc((size_t)nq * nc * sizeof(float));
+  fill_random(queries, (size_t)nq * dim);
+  fill_random(corpus, (size_t)nc * dim);
+
+  ASSERT_EQ_INT(fastembed_similarity_matrix(queries, nq, corpus, nc, dim,
+                                            single, FASTEMBED_METRIC_COSINE),
+                0);
+
+  const int thread_counts[] = {0, 2, 3, 7};
+  for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+       t++) {
+    memset(threaded, 0, (size_t)nq * nc * sizeof(float));
+    int result = fastembed_similarity_matrix_threaded(
+        queries, nq, corpus, nc, dim, threaded, FASTEMBED_METRIC_COSINE,
+        thread_counts[t]);
+    char message[96];
+    snprintf(message, sizeof(message),
+             "%d thread(s) give identical scores (0 = all CPUs)",
+             thread_counts[t]);
+    ASSERT_TRUE(result == 0 &&
+                    memcmp(single, threaded,
+                           (size_t)nq * nc * sizeof(float)) == 0,
+                message);
+  }
+
+  ASSERT_TRUE(check_matrix(2, 50001, 64, FASTEMBED_METRIC_EUCLIDEAN, 4) == 0,
+              "Threaded Euclidean matches reference");
+
+  free(queries);
+  free(corpus);
+  free(single);
+  free(threaded);
+}
+
+/**
+ * Test: Zero vectors and invalid arguments
+ */
+static void test_edge_cases(void) {
+  printf("\n=== Test: Edge Cases ===\n");
+
+  float zero[8] = {0};
+  float rows[16];
+  float out[2];
+  fill_random(rows, 16);
+
+  ASSERT_EQ_INT(fastembed_similarity_matrix(zero, 1, rows, 2, 8, out,
+                                            FASTEMBED_METRIC_COSINE),
+                0);
+  ASSERT_TRUE(out[0] == 0.0f && out[1] == 0.0f,
+              "Cosine against a zero query is 0");
+
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 1, rows, 2, 8, out,
+                                            FASTEMBED_METRIC_EUCLIDEAN),
+                0);
+  ASSERT_TRUE(out[0] == 0.0f, "Euclidean distance to itself is 0");
+
+  ASSERT_EQ_INT(fastembed_similarity_matrix(NULL, 1, rows, 2, 8, out,
+                                            FASTEMBED_METRIC_DOT),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 1, NULL, 2, 8, out,
+                                            FASTEMBED_METRIC_DOT),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 1, rows, 2, 8, NULL,
+                                            FASTEMBED_METRIC_DOT),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 0, rows, 2, 8, out,
+                                            FASTEMBED_METRIC_DOT),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 1, rows, 0, 8, out,
+                                            FASTEMBED_METRIC_DOT),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 1, rows, 2, 0, out,
+                                            FASTEMBED_METRIC_DOT),
+                -1);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(rows, 1, rows, 2, 8, out, 3), -1);
+}
+
+/**
+ * Test: Queries against a large corpus (informational)
+ */
+static void test_throughput(void) {
+  printf("\n=== Test: Query x Corpus Throughput (100k x 384D) ===\n");
+
+  const int nc = 100000, dim = 384, max_queries = 8, iterations = 5;
+  float *queries = malloc((size_t)max_queries * dim * sizeof(float));
+  float *corpus = malloc((size_t)nc * dim * sizeof(float));
+  float *out = malloc((size_t)max_queries * nc * sizeof(float));
+  fill_random(queries, (size_t)max_queries * dim);
+  fill_random(corpus, (size_t)nc * dim);
+
+  int result = 0;
+  for (int nq = 1; nq <= max_queries; nq *= max_queries) {
+    clock_t start = clock();
+    for (int i = 0; i < iterations; i++)
+      for (int q = 0; q < nq; q++)
+        for (int c = 0; c < nc; c++)
+          out[(size_t)q * nc + c] = fastembed_cosine_similarity(
+              queries + (size_t)q * dim, corpus + (size_t)c * dim, dim);
+    double pairwise = (double)(clock() - start) / CLOCKS_PER_SEC / iterations;
+
+    start = clock();
+    for (int i = 0; i < iterations; i++)
+      result |= fastembed_similarity_matrix(queries, nq, corpus, nc, dim, out,
+                                            FASTEMBED_METRIC_COSINE);
+    double matrix = (double)(clock() - start) / CLOCKS_PER_SEC / iterations;
+
+    printf("  %d quer%s: pairwise cosine loop %.2f ms, similarity matrix "
+           "%.2f ms\n",
+           nq, nq == 1 ? "y" : "ies", pairwise * 1e3, matrix * 1e3);
+  }
+  ASSERT_EQ_INT(result, 0);
+
+  free(queries);
+  free(corpus);
+  free(out);
+}
+
+int main() {
+  printf("FastEmbed Similarity Matrix Tests\n");
+  printf("=================================\n");
+
+  srand(42);
+
+  test_matches_reference();
+  test_threaded_matches_single();
+  test_edge_cases();
+  test_throughput();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
@@ -0,0 +1,470 @@
+/**
+ * FastEmbed Thread Pool Tests
+ *
+ * Tests for fastembed_batch_generate_parallel() and the shared pool:
+ * - Test parallel output is bit-identical to fastembed_generate() for every
+ *   thread count, including batches with very uneven text lengths
+ * - Test per-text statuses for NULL, empty and too-long texts and NULL
+ *   outputs, and that bad texts do not affect their neighbours
+ * - Test invalid argument handling
+ * - Test fastembed_thread_pool_configure() / get_size() / shutdown(),
+ *   including thread pinning and restarting after shutdown
+ * - Test many small jobs with fewer participants than pool threads
+ * - Test concurrent callers sharing the pool
+ * - Measure sequential vs parallel batch throughput
+ *
+ * Compile: gcc -o test_thread_pool test_thread_pool.c -L../build -lfastembed
+ * -lm -lpthread -I../include Run: LD_LIBRARY_PATH=.. ./test_thread_pool
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define DIM 768
+#define NUM_TEXTS 500
+#define NUM_CALLERS 4
+
+static double now_seconds(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Builds NUM_TEXTS texts of very different lengths (1 to ~4000 bytes) so
+ * that ranges finish unevenly and work stealing kicks in
+ */
+static char **make_texts(void) {
+  char **texts = (char **)malloc(NUM_TEXTS * sizeof(char *));
+  if (!texts)
+    return NULL;
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    size_t len = (i % 7 == 0) ? 4000 : (size_t)(1 + (i * 37) % 200);
+    texts[i] = (char *)malloc(len + 1);
+    if (!texts[i])
+      return NULL;
+    for (size_t c = 0; c < len; c++)
+      texts[i][c] = (char)('a' + (i + c * 13) % 26);
+    texts[i][len] = '\0';
+  }
+  return texts;
+}
+
+static void free_texts(char **texts) {
+  for (int i = 0; i < NUM_TEXTS; i++)
+    free(texts[i]);
+  free(texts);
+}
+
+static float **alloc_outputs(int count) {
+  float **outputs = (float **)malloc((size_t)count * sizeof(float *));
+  if (!outputs)
+    return NULL;
+  for (int i = 0; i < count; i++)
+    outputs[i] = (float *)calloc(DIM, sizeof(float));
+  return outputs;
+}
+
+static void free_outputs(float **outputs, int count) {
+  for (int i = 0; i < count; i++)
+    free(outputs[i]);
+  free(outputs);
+}
+
+/**
+ * Returns the number of texts whose parallel output differs from the
+ * sequential reference
+ */
+static int count_mismatches(float **outputs, float *reference, int count) {
+  int mismatches = 0;
+  for (int i = 0; i < count; i++) {
+    if (memcmp(outputs[i], reference + (size_t)i * DIM, DIM * sizeof(float)))
+      mismatches++;
+  }
+  return mismatches;
+}
+
+/**
+ * Test: Parallel batch matches fastembed_generate() for all thread counts
+ */
+static void test_matches_sequential(char **texts, float *reference) {
+  printf("\nTest: Parallel batch matches sequential generation\n");
+
+  int thread_counts[] = {1, 2, 3, 4, 0};
+  float **outputs = alloc_outputs(NUM_TEXTS);
+  int *statuses = (int *)malloc(NUM_TEXTS * sizeof(int));
+
+  for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+       t++) {
+    for (int i = 0; i < NUM_TEXTS; i++) {
+      memset(outputs[i], 0, DIM * sizeof(float));
+      statuses[i] = 12345;
+    }
+
+    int failed =
+        fastembed_batch_generate_parallel((const char **)texts, NUM_TEXTS,
+                                          outputs, DIM, statuses,
+                                          thread_counts[t]);
+    ASSERT_EQ_INT(failed, 0);
+
+    int bad_status = 0;
+    for (int i = 0; i < NUM_TEXTS; i++) {
+      if (statuses[i] != FASTEMBED_STATUS_OK)
+        bad_status++;
+    }
+    char message[96];
+    snprintf(message, sizeof(message),
+             "num_threads=%d: all statuses OK, output bit-identical",
+             thread_counts[t]);
+    ASSERT_TRUE(bad_status == 0 &&
+                    count_mismatches(outputs, reference, NUM_TEXTS) == 0,
+                message);
+  }
+
+  /* statuses is optional */
+  int failed = fastembed_batch_generate_parallel(
+      (const char **)texts, NUM_TEXTS, outputs, DIM, NULL, 0);
+  ASSERT_EQ_INT(failed, 0);
+  ASSERT_TRUE(count_mismatches(outputs, reference, NUM_TEXTS) == 0,
+              "NULL statuses: output bit-identical");
+
+  free(statuses);
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+/**
+ * Test: Bad texts get their own status and do not affect other texts
+ */
+static void test_statuses(void) {
+  printf("\nTest: Per-text statuses\n");
+
+  char *too_long = (char *)malloc(FASTEMBED_MAX_TEXT_LENGTH + 2);
+  memset(too_long, 'x', FASTEMBED_MAX_TEXT_LENGTH + 1);
+  too_long[FASTEMBED_MAX_TEXT_LENGTH + 1] = '\0';
+
+  const char *texts[] = {"first", NULL, "", too_long, "fifth", "sixth"};
+  const int count = 6;
+  float **outputs = alloc_outputs(count);
+  free(outputs[5]);
+  outputs[5] = NULL;
+  int statuses[6];
+
+  int failed =
+      fastembed_batch_generate_parallel(texts, count, outputs, DIM, statuses, 0);
+  ASSERT_EQ_INT(failed, 4);
+  ASSERT_EQ_INT(statuses[0], FASTEMBED_STATUS_OK);
+  ASSERT_EQ_INT(statuses[1], FASTEMBED_STATUS_NULL_INPUT);
+  ASSERT_EQ_INT(statuses[2], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[3], FASTEMBED_STATUS_INVALID_TEXT);
+  ASSERT_EQ_INT(statuses[4], FASTEMBED_STATUS_OK);
+  ASSERT_EQ_INT(statuses[5], FASTEMBED_STATUS_NULL_INPUT);
+
+  float expected[DIM];
+  int ok = fastembed_generate("first", expected, DIM) == 0 &&
+           memcmp(outputs[0], expected, sizeof(expected)) == 0;
+  ok = ok && fastembed_generate("fifth", expected, DIM) == 0 &&
+       memcmp(outputs[4], expected, sizeof(expected)) == 0;
+  ASSERT_TRUE(ok, "Valid texts next to bad ones are still embedded");
+
+  /* a text of exactly FASTEMBED_MAX_TEXT_LENGTH bytes is accepted */
+  too_long[FASTEMBED_MAX_TEXT_LENGTH] = '\0';
+  const char *max_text[] = {too_long};
+  failed =
+      fastembed_batch_generate_parallel(max_text, 1, outputs, DIM, statuses, 0);
+  ASSERT_EQ_INT(failed, 0);
+  ASSERT_EQ_INT(statuses[0], FASTEMBED_STATUS_OK);
+
+  free(too_long);
+  free_outputs(outputs, count);
+}
+
+/**
+ * Test: Invalid arguments are rejected
+ */
+static void test_invalid_arguments(void) {
+  printf("\nTest: Invalid arguments\n");
+
+  const char *texts[] = {"hello"};
+  float buffer[DIM];
+  float *outputs[] = {buffer};
+
+  ASSERT_EQ_INT(fastembed_batch_generate_parallel(NULL, 1, outputs, DIM, NULL,
+                                                  0),
+                -1);
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_parallel(texts, 1, NULL, DIM, NULL, 0), -1);
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_parallel(texts, 0, outputs, DIM, NULL, 0), -1);
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_parallel(texts, 1, outputs, 100, NULL, 0), -1);
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_parallel(texts, 1, outputs, DIM, NULL, -1), -1);
+
+  /* dimension 0 selects the default */
+  ASSERT_EQ_INT(
+      fastembed_batch_generate_parallel(texts, 1, outputs, 0, NULL, 0), 0);
+
+  ASSERT_EQ_INT(fastembed_thread_pool_configure(-1, 0), -1);
+  ASSERT_EQ_INT(
+      fastembed_thread_pool_configure(FASTEMBED_THREAD_POOL_MAX_THREADS + 1, 0),
+      -1);
+}
+
+/**
+ * Test: Pool configuration, pinning and restart after shutdown
+ */
+static void test_configure(char **texts, float *reference) {
+  printf("\nTest: Pool configuration\n");
+
+  int default_size = fastembed_thread_pool_get_size();
+  printf("  Default pool size: %d\n", default_size);
+  ASSERT_TRUE(default_size >= 1 &&
+                  default_size <= FASTEMBED_THREAD_POOL_MAX_THREADS,
+              "Default pool size in [1, FASTEMBED_THREAD_POOL_MAX_THREADS]");
+
+  float **outputs = alloc_outputs(NUM_TEXTS);
+
+  ASSERT_EQ_INT(fastembed_thread_pool_configure(3, 0), 0);
+  ASSERT_EQ_INT(fastembed_thread_pool_get_size(), 3);
+  ASSERT_EQ_INT(fastembed_batch_generate_parallel(
+                    (const char **)texts, NUM_TEXTS, outputs, DIM, NULL, 8),
+                0);
+  ASSERT_TRUE(count_mismatches(outputs, reference, NUM_TEXTS) == 0,
+              "num_threads above the pool size is clamped");
+
+  ASSERT_EQ_INT(fastembed_thread_pool_configure(2, 1), 0);
+  ASSERT_EQ_INT(fastembed_thread_pool_get_size(), 2);
+  ASSERT_EQ_INT(fastembed_batch_generate_parallel(
+                    (const char **)texts, NUM_TEXTS, outputs, DIM, NULL, 0),
+                0);
+  ASSERT_TRUE(count_mismatches(outputs, reference, NUM_TEXTS) == 0,
+              "Pinned pool gives identical output");
+
+  fastembed_thread_pool_shutdown();
+  fastembed_thread_pool_shutdown();
+  ASSERT_EQ_INT(fastembed_batch_generate_parallel(
+                    (const char **)texts, NUM_TEXTS, outputs, DIM, NULL, 0),
+                0);
+  ASSERT_TRUE(count_mismatches(outputs, reference, NUM_TEXTS) == 0,
+              "Pool restarts after shutdown");
+  ASSERT_EQ_INT(fastembed_thread_pool_get_size(), 2);
+
+  ASSERT_EQ_INT(fastembed_thread_pool_configure(0, 0), 0);
+  ASSERT_EQ_INT(fastembed_thread_pool_get_size(), default_size);
+
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+/**
+ * Test: Back-to-back jobs that leave most pool threads idle
+ *
+ * Workers that are not needed still wake for every job and may only see it
+ * after it has finished.
+ */
+static void test_small_jobs(char **texts, float *reference) {
+  printf("\nTest: Small jobs on a larger pool\n");
+
+  const int count = 64;
+  const int iterations = 2000;
+  float **outputs = alloc_outputs(count);
+  int failures = 0;
+
+  ASSERT_EQ_INT(fastembed_thread_pool_configure(8, 0), 0);
+  for (int i = 0; i < iterations; i++) {
+    int threads = 2 + i % 3; /* 2-4 of the 8 pool threads */
+    if (fastembed_batch_generate_parallel((const char **)texts, count,
+                                          outputs, DIM, NULL, threads) != 0 ||
+        count_mismatches(outputs, reference, count) != 0) {
+      failures++;
+    }
+  }
+  ASSERT_TRUE(failures == 0, "2000 jobs with 2-4 of 8 threads match");
+
+  ASSERT_EQ_INT(fastembed_thread_pool_configure(0, 0), 0);
+  free_outputs(outputs, count);
+}
+
+typedef struct {
+  char **texts;
+  float *reference;
+  int failures;
+} CallerArgs;
+
+static void run_caller(CallerArgs *args) {
+  float **outputs = alloc_outputs(NUM_TEXTS);
+  for (int round = 0; round < 5; round++) {
+    if (fastembed_batch_generate_parallel((const char **)args->texts,
+                                          NUM_TEXTS, outputs, DIM, NULL,
+                                          0) != 0 ||
+        count_mismatches(outputs, args->reference, NUM_TEXTS) != 0)
+      args->failures++;
+  }
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI caller_main(LPVOID arg) {
+  run_caller((CallerArgs *)arg);
+  return 0;
+}
+#else
+static void *caller_main(void *arg) {
+  run_caller((CallerArgs *)arg);
+  return NULL;
+}
+#endif
+
+/**
+ * Test: Several threads calling the parallel batch at once
+ */
+static void test_concurrent_callers(char **texts, float *reference) {
+  printf("\nTest: Concurrent callers\n");
+
+  CallerArgs args[NUM_CALLERS];
+  int started = 1;
+  for (int i = 0; i < NUM_CALLERS; i++) {
+    args[i].texts = texts;
+    args[i].reference = reference;
+    args[i].failures = 0;
+  }
+
+#ifdef _WIN32
+  HANDLE threads[NUM_CALLERS];
+  for (int i = 0; i < NUM_CALLERS; i++) {
+    threads[i] = CreateThread(NULL, 0, caller_main, &args[i], 0, NULL);
+    if (threads[i] == NULL)
+      started = 0;
+  }
+  if (started) {
+    WaitForMultipleObjects(NUM_CALLERS, threads, TRUE, INFINITE);
+    for (int i = 0; i < NUM_CALLERS; i++)
+      CloseHandle(threads[i]);
+  }
+#else
+  pthread_t threads[NUM_CALLERS];
+  int created = 0;
+  for (int i = 0; i < NUM_CALLERS; i++) {
+    if (pthread_create(&threads[i], NULL, caller_main, &args[i]) != 0) {
+      started = 0;
+      break;
+    }
+    created++;
+  }
+  for (int i = 0; i < created; i++)
+    pthread_join(threads[i], NULL);
+#endif
+
+  ASSERT_TRUE(started, "Caller threads started");
+  int failures = 0;
+  for (int i = 0; i < NUM_CALLERS; i++)
+    failures += args[i].failures;
+  ASSERT_EQ_INT(failures, 0);
+}
+
+/**
+ * Benchmark: Sequential vs parallel batch throughput
+ */
+static void benchmark_batch(char **texts) {
+  printf("\nBenchmark: Sequential vs parallel batch (%d texts, %dD)\n",
+         NUM_TEXTS, DIM);
+
+  float **outputs = alloc_outputs(NUM_TEXTS);
+  const int iterations = 20;
+
+  double start = now_seconds();
+  for (int it = 0; it < iterations; it++)
+    fastembed_batch_generate((const char **)texts, NUM_TEXTS, outputs, DIM);
+  double sequential = (now_seconds() - start) / iterations;
+
+  start = now_seconds();
+  for (int it = 0; it < iterations; it++)
+    fastembed_batch_generate_parallel((const char **)texts, NUM_TEXTS, outputs,
+                                      DIM, NULL, 0);
+  double parallel = (now_seconds() - start) / iterations;
+
+  printf("  Sequential: %.3f ms/batch\n", sequential * 1e3);
+  printf("  Parallel (%d threads): %.3f ms/batch (%.2fx)\n",
+         fastembed_thread_pool_get_size(), parallel * 1e3,
+         parallel > 0 ? sequential / parallel : 0.0);
+
+  free_outputs(outputs, NUM_TEXTS);
+}
+
+int main() {
+  printf("FastEmbed Thread Pool Tests\n");
+  printf("===========================\n");
+
+  char **texts = make_texts();
+  float *reference = (float *)malloc((size_t)NUM_TEXTS * DIM * sizeof(float));
+  if (!texts || !reference) {
+    printf("✗ Allocation failed\n");
+    return 1;
+  }
+  for (int i = 0; i < NUM_TEXTS; i++) {
+    if (fastembed_generate(texts[i], reference + (size_t)i * DIM, DIM) != 0) {
+      printf("✗ Reference generation failed\n");
+      return 1;
+    }
+  }
+
+  test_matches_sequential(texts, reference);
+  test_statuses();
+  test_invalid_arguments();
+  test_configure(texts, reference);
+  test_small_jobs(texts, reference);
+  test_concurrent_callers(texts, reference);
+  benchmark_batch(texts);
+
+  fastembed_thread_pool_shutdown();
+  free(reference);
+  free_texts(texts);
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
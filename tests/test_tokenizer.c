@@ -0,0 +1,363 @@
+/**
+ * FastEmbed WordPiece Tokenizer Tests
+ *
+ * Tests for fastembed_tokenizer_*():
+ * - Test vocab.txt loading and special token lookup
+ * - Test normalization (lowercasing, accent stripping, control characters)
+ * - Test pre-tokenization (whitespace, punctuation, CJK ideographs)
+ * - Test greedy longest-match WordPiece splitting and [UNK] handling
+ * - Test truncation to max_length
+ * - Test tokenizer.json loading (cased normalizer, string escapes)
+ * - Test unsupported / invalid vocabularies are rejected
+ * - Measure encoding throughput
+ *
+ * Compile: gcc -o test_tokenizer test_tokenizer.c -L../build -lfastembed -lm
+ * -I../include Run: LD_LIBRARY_PATH=.. ./test_tokenizer
+ */
+
+#include "fastembed.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define VOCAB_PATH "test_tokenizer.vocab.txt"
+#define JSON_PATH "test_tokenizer.tokenizer.json"
+#define MAX_IDS 64
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+/* Uncased BERT-style vocabulary: ID = line number */
+static const char *k_vocab_txt = "[PAD]\n"
+                                 "[UNK]\n"
+                                 "[CLS]\n"
+                                 "[SEP]\n"
+                                 "[MASK]\n"
+                                 "hello\n"
+                                 "world\n"
+                                 ",\n"
+                                 "!\n"
+                                 "un\n"
+                                 "##aff\n"
+                                 "##able\n"
+                                 "cafe\n"
+                                 "\xe4\xb8\xad\n" /* 中 */
+                                 "\xe5\x9b\xbd\n" /* 国 */
+                                 "##s\n"
+                                 "test\n"
+                                 ".\n";
+
+enum {
+  ID_PAD = 0,
+  ID_UNK = 1,
+  ID_CLS = 2,
+  ID_SEP = 3,
+  ID_HELLO = 5,
+  ID_WORLD = 6,
+  ID_COMMA = 7,
+  ID_BANG = 8,
+  ID_UN = 9,
+  ID_AFF = 10,
+  ID_ABLE = 11,
+  ID_CAFE = 12,
+  ID_ZHONG = 13,
+  ID_GUO = 14,
+  ID_S = 15,
+  ID_TEST = 16,
+  ID_PERIOD = 17,
+  VOCAB_SIZE = 18
+};
+
+/**
+ * Write contents to path; returns 0 on success
+ */
+static int write_file(const char *path, const char *contents) {
+  FILE *f = fopen(path, "wb");
+  if (f == NULL)
+    return -1;
+  size_t length = strlen(contents);
+  int ok = fwrite(contents, 1, length, f) == length;
+  fclose(f);
+  return ok ? 0 : -1;
+}
+
+/**
+ * Encode text and compare with the expected IDs
+ */
+static int encodes_to(const fastembed_tokenizer_t *tokenizer, const char *text,
+                      int max_length, const int *expected, int count) {
+  int64_t ids[MAX_IDS];
+  int n = fastembed_tokenizer_encode(tokenizer, text, ids, max_length);
+  if (n != count) {
+    printf("    \"%s\": expected %d IDs, got %d\n", text, count, n);
+    return 0;
+  }
+  for (int i = 0; i < n; i++) {
+    if (ids[i] != expected[i]) {
+      printf("    \"%s\": ID %d expected %d, got %lld\n", text, i, expected[i],
+             (long long)ids[i]);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+#define EXPECT_IDS(tokenizer, text, max_length, ...)                           \
+  encodes_to(tokenizer, text, max_length, (const int[]){__VA_ARGS__},          \
+             (int)(sizeof((const int[]){__VA_ARGS__}) / sizeof(int)))
+
+/**
+ * Test: vocab.txt loading
+ */
+void test_vocab_txt_loading(fastembed_tokenizer_t *tokenizer) {
+  printf("\n=== Test: vocab.txt Loading ===\n");
+
+  ASSERT_TRUE(tokenizer != NULL, "vocab.txt loaded");
+  if (tokenizer == NULL)
+    return;
+
+  ASSERT_EQ_INT(fastembed_tokenizer_get_vocab_size(tokenizer), VOCAB_SIZE);
+  ASSERT_EQ_INT(fastembed_tokenizer_get_pad_id(tokenizer), ID_PAD);
+  ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer, "[CLS]"), ID_CLS);
+  ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer, "##aff"), ID_AFF);
+  ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer, "\xe4\xb8\xad"),
+                ID_ZHONG);
+  ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer, "hell"), -1);
+  ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer, "aff"), -1);
+}
+
+/**
+ * Test: Normalization and pre-tokenization
+ */
+void test_normalization(const fastembed_tokenizer_t *tokenizer) {
+  printf("\n=== Test: Normalization ===\n");
+
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "", MAX_IDS, ID_CLS, ID_SEP),
+              "Empty text is [CLS] [SEP]");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "Hello, WORLD!", MAX_IDS, ID_CLS, ID_HELLO,
+                         ID_COMMA, ID_WORLD, ID_BANG, ID_SEP),
+              "Lowercasing and punctuation splitting");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "  hello\t\n world\r\n", MAX_IDS, ID_CLS,
+                         ID_HELLO, ID_WORLD, ID_SEP),
+              "Whitespace runs separate words");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "hel\x01lo", MAX_IDS, ID_CLS, ID_HELLO,
+                         ID_SEP),
+              "Control characters are dropped");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "Caf\xc3\xa9 CAF\xc3\x89", MAX_IDS, ID_CLS,
+                         ID_CAFE, ID_CAFE, ID_SEP),
+              "Precomposed accents are stripped");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "cafe\xcc\x81", MAX_IDS, ID_CLS, ID_CAFE,
+                         ID_SEP),
+              "Combining marks are stripped");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "\xe2\x80\x9cHELLO\xe2\x80\x9d", MAX_IDS,
+                         ID_CLS, ID_UNK, ID_HELLO, ID_UNK, ID_SEP),
+              "Unicode punctuation splits words");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "hello\xe4\xb8\xad\xe5\x9b\xbdworld",
+                         MAX_IDS, ID_CLS, ID_HELLO, ID_ZHONG, ID_GUO, ID_WORLD,
+                         ID_SEP),
+              "CJK ideographs are single tokens");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "hello\xc2\xa0world", MAX_IDS, ID_CLS,
+                         ID_HELLO, ID_WORLD, ID_SEP),
+              "Unicode spaces separate words");
+}
+
+/**
+ * Test: WordPiece splitting
+ */
+void test_wordpiece(const fastembed_tokenizer_t *tokenizer) {
+  printf("\n=== Test: WordPiece Splitting ===\n");
+
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "unaffable", MAX_IDS, ID_CLS, ID_UN, ID_AFF,
+                         ID_ABLE, ID_SEP),
+              "Word split into continuation pieces");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "tests.", MAX_IDS, ID_CLS, ID_TEST, ID_S,
+                         ID_PERIOD, ID_SEP),
+              "Suffix piece and trailing punctuation");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "unaffablex hello", MAX_IDS, ID_CLS, ID_UNK,
+                         ID_HELLO, ID_SEP),
+              "Partially matched word becomes one [UNK]");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "hellohello", MAX_IDS, ID_CLS, ID_UNK,
+                         ID_SEP),
+              "Word pieces require the ## prefix");
+
+  char long_word[256];
+  memset(long_word, 'a', sizeof(long_word) - 1);
+  long_word[sizeof(long_word) - 1] = '\0';
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, long_word, MAX_IDS, ID_CLS, ID_UNK, ID_SEP),
+              "Over-long word becomes [UNK]");
+}
+
+/**
+ * Test: Truncation and invalid arguments
+ */
+void test_truncation(const fastembed_tokenizer_t *tokenizer) {
+  printf("\n=== Test: Truncation ===\n");
+
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "hello world hello world", 4, ID_CLS,
+                         ID_HELLO, ID_WORLD, ID_SEP),
+              "Truncated sequence keeps [SEP]");
+  ASSERT_TRUE(EXPECT_IDS(tokenizer, "hello unaffable", 4, ID_CLS, ID_HELLO,
+                         ID_UN, ID_SEP),
+              "Truncation can split a word");
+  ASSERT_TRUE(
+      EXPECT_IDS(tokenizer, "hello world", 2, ID_CLS, ID_SEP),
+      "max_length 2 gives [CLS] [SEP]");
+
+  int64_t ids[MAX_IDS];
+  ASSERT_EQ_INT(fastembed_tokenizer_encode(tokenizer, "hello", ids, 1), -1);
+  ASSERT_EQ_INT(fastembed_tokenizer_encode(NULL, "hello", ids, MAX_IDS), -1);
+  ASSERT_EQ_INT(fastembed_tokenizer_encode(tokenizer, NULL, ids, MAX_IDS), -1);
+  ASSERT_EQ_INT(fastembed_tokenizer_get_vocab_size(NULL), -1);
+}
+
+/**
+ * Test: tokenizer.json loading
+ */
+void test_tokenizer_json(void) {
+  printf("\n=== Test: tokenizer.json Loading ===\n");
+
+  const char *json =
+      "{\n"
+      "  \"version\": \"1.0\",\n"
+      "  \"added_tokens\": [{\"id\": 0, \"content\": \"[PAD]\"}],\n"
+      "  \"normalizer\": {\"type\": \"BertNormalizer\", \"clean_text\": true,\n"
+      "    \"handle_chinese_chars\": true, \"strip_accents\": null,\n"
+      "    \"lowercase\": false},\n"
+      "  \"pre_tokenizer\": {\"type\": \"BertPreTokenizer\"},\n"
+      "  \"model\": {\n"
+      "    \"type\": \"WordPiece\",\n"
+      "    \"unk_token\": \"[UNK]\",\n"
+      "    \"continuing_subword_prefix\": \"##\",\n"
+      "    \"max_input_chars_per_word\": 100,\n"
+      "    \"vocab\": {\"[PAD]\": 0, \"[UNK]\": 1, \"[CLS]\": 2, \"[SEP]\": 3,\n"
+      "      \"Hello\": 4, \"hello\": 5, \"\\u00e9t\\u00e9\": 6,\n"
+      "      \"\\ud83d\\ude00\": 7, \"##\\\"\": 8}\n"
+      "  }\n"
+      "}\n";
+
+  if (write_file(JSON_PATH, json) != 0) {
+    ASSERT_TRUE(0, "Wrote tokenizer.json");
+    return;
+  }
+
+  fastembed_tokenizer_t *tokenizer = fastembed_tokenizer_load(JSON_PATH);
+  ASSERT_TRUE(tokenizer != NULL, "tokenizer.json loaded");
+  if (tokenizer != NULL) {
+    ASSERT_EQ_INT(fastembed_tokenizer_get_vocab_size(tokenizer), 9);
+    ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer, "##\""), 8);
+    ASSERT_EQ_INT(fastembed_tokenizer_token_to_id(tokenizer,
+                                                  "\xf0\x9f\x98\x80"),
+                  7);
+    ASSERT_TRUE(EXPECT_IDS(tokenizer, "Hello hello", MAX_IDS, 2, 4, 5, 3),
+                "Cased normalizer keeps case");
+    ASSERT_TRUE(EXPECT_IDS(tokenizer, "\xc3\xa9t\xc3\xa9", MAX_IDS, 2, 6, 3),
+                "Cased normalizer keeps accents");
+    fastembed_tokenizer_free(tokenizer);
+  }
+
+  const char *bpe = "{\"model\": {\"type\": \"BPE\", \"vocab\": {\"a\": 0},"
+                    " \"merges\": []}}";
+  if (write_file(JSON_PATH, bpe) == 0)
+    ASSERT_TRUE(fastembed_tokenizer_load(JSON_PATH) == NULL,
+                "BPE tokenizer.json rejected");
+  remove(JSON_PATH);
+}
+
+/**
+ * Test: Invalid vocabularies are rejected
+ */
+void test_invalid_vocab(void) {
+  printf("\n=== Test: Invalid Vocabularies ===\n");
+
+  ASSERT_TRUE(fastembed_tokenizer_load("does_not_exist.vocab.txt") == NULL,
+              "Missing file rejected");
+  ASSERT_TRUE(fastembed_tokenizer_load(NULL) == NULL, "NULL path rejected");
+
+  if (write_file(VOCAB_PATH, "[PAD]\n[UNK]\nhello\n") == 0)
+    ASSERT_TRUE(fastembed_tokenizer_load(VOCAB_PATH) == NULL,
+                "Vocabulary without [CLS] / [SEP] rejected");
+
+  fastembed_tokenizer_free(NULL); /* Must not crash */
+  remove(VOCAB_PATH);
+}
+
+/**
+ * Test: Encoding throughput (informational)
+ */
+void test_throughput(const fastembed_tokenizer_t *tokenizer) {
+  printf("\n=== Test: Encoding Throughput ===\n");
+
+  const char *text = "Hello, world! unaffable tests. Caf\xc3\xa9 "
+                     "\xe4\xb8\xad\xe5\x9b\xbd hello world xyz.";
+  const int iterations = 200000;
+  int64_t ids[MAX_IDS];
+  long long tokens = 0;
+
+  clock_t start = clock();
+  for (int i = 0; i < iterations; i++)
+    tokens += fastembed_tokenizer_encode(tokenizer, text, ids, MAX_IDS);
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("  %lld tokens in %.3f s (%.2f M tokens/s)\n", tokens, seconds,
+         seconds > 0 ? tokens / seconds / 1e6 : 0.0);
+  ASSERT_TRUE(tokens == (long long)iterations * 19, "All iterations encoded");
+}
+
+int main() {
+  printf("FastEmbed WordPiece Tokenizer Tests\n");
+  printf("===================================\n");
+
+  fastembed_tokenizer_t *tokenizer = NULL;
+  if (write_file(VOCAB_PATH, k_vocab_txt) == 0)
+    tokenizer = fastembed_tokenizer_load(VOCAB_PATH);
+  remove(VOCAB_PATH);
+
+  test_vocab_txt_loading(tokenizer);
+  if (tokenizer != NULL) {
+    test_normalization(tokenizer);
+    test_wordpiece(tokenizer);
+    test_truncation(tokenizer);
+    test_throughput(tokenizer);
+  }
+  test_tokenizer_json();
+  test_invalid_vocab();
+
+  fastembed_tokenizer_free(tokenizer);
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
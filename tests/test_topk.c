@@ -0,0 +1,333 @@
+/**
+ * FastEmbed Top-k Search Tests
+ *
+ * Tests for fastembed_topk() / fastembed_topk_threaded():
+ * - Test results against a full sort of the similarity matrix for every
+ *   metric, including k > corpus size and ties
+ * - Test that the threaded search returns the single-threaded results
+ * - Test invalid arguments
+ * - Measure top-10 over a 1M x 384D corpus against matrix + full sort
+ *
+ * Compile: gcc -o test_topk test_topk.c -L../build -lfastembed -lm -lpthread
+ * -I../include Run: LD_LIBRARY_PATH=.. ./test_topk
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fill_random(float *v, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    v[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+/* Sort context for the reference ranking */
+static const float *g_scores;
+static int g_ascending;
+
+static int compare_rank(const void *a, const void *b) {
+  int ia = *(const int *)a, ib = *(const int *)b;
+  float sa = g_scores[ia], sb = g_scores[ib];
+  if (sa != sb)
+    return g_ascending ? (sa < sb ? -1 : 1) : (sa > sb ? -1 : 1);
+  return ia - ib;
+}
+
+/**
+ * Compare fastembed_topk_threaded() with the sorted similarity matrix
+ *
+ * @return Number of mismatches
+ */
+static int check_topk(int nc, int dim, int k, int metric, int threads) {
+  float *query = malloc((size_t)dim * sizeof(float));
+  float *corpus = malloc((size_t)nc * dim * sizeof(float));
+  float *scores = malloc((size_t)nc * sizeof(float));
+  int *order = malloc((size_t)nc * sizeof(int));
+  int *ids = malloc((size_t)k * sizeof(int));
+  float *top = malloc((size_t)k * sizeof(float));
+  int failures = 0;
+
+  fill_random(query, dim);
+  fill_random(corpus, (size_t)nc * dim);
+  fastembed_similarity_matrix(query, 1, corpus, nc, dim, scores, metric);
+  for (int i = 0; i < nc; i++)
+    order[i] = i;
+  g_scores = scores;
+  g_ascending = metric == FASTEMBED_METRIC_EUCLIDEAN;
+  qsort(order, nc, sizeof(int), compare_rank);
+
+  int expected_count = k < nc ? k : nc;
+  int count = fastembed_topk_threaded(query, corpus, nc, dim, k, ids, top,
+                                      metric, threads);
+  if (count != expected_count) {
+    printf("    count %d, expected %d (n %d, k %d)\n", count, expected_count,
+           nc, k);
+    failures++;
+  } else {
+    for (int i = 0; i < count; i++) {
+      /* Scores are computed the same way, so only near-ties may swap */
+      if (ids[i] != order[i] &&
+          fabsf(scores[ids[i]] - scores[order[i]]) > 1e-5f) {
+        printf("    metric %d rank %d: id %d, expected %d (n %d, k %d)\n",
+               metric, i, ids[i], order[i], nc, k);
+        failures++;
+        break;
+      }
+      if (fabsf(top[i] - scores[ids[i]]) > 1e-4f) {
+        printf("    metric %d rank %d: score %f, expected %f\n", metric, i,
+               top[i], scores[ids[i]]);
+        failures++;
+        break;
+      }
+    }
+  }
+
+  free(query);
+  free(corpus);
+  free(scores);
+  free(order);
+  free(ids);
+  free(top);
+  return failures;
+}
+
+/**
+ * Test: Top-k matches a full sort for every metric
+ */
+static void test_matches_sort(void) {
+  printf("\n=== Test: Top-k Matches Full Sort ===\n");
+
+  const int metrics[] = {FASTEMBED_METRIC_DOT, FASTEMBED_METRIC_COSINE,
+                         FASTEMBED_METRIC_EUCLIDEAN};
+  const char *names[] = {"Dot", "Cosine", "Euclidean"};
+  const int corpus_sizes[] = {1, 3, 4, 5, 10, 37, 1000};
+  const int ks[] = {1, 2, 10, 64};
+
+  for (int m = 0; m < 3; m++) {
+    int failures = 0, cases = 0;
+    for (size_t n = 0; n < sizeof(corpus_sizes) / sizeof(corpus_sizes[0]);
+         n++) {
+      for (size_t k = 0; k < sizeof(ks) / sizeof(ks[0]); k++) {
+        failures += check_topk(corpus_sizes[n], 33, ks[k], metrics[m], 1);
+        cases++;
+      }
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "%s top-k matches sort (%d cases)",
+             names[m], cases);
+    ASSERT_TRUE(failures == 0, message);
+  }
+
+  ASSERT_TRUE(check_topk(5000, 384, 500, FASTEMBED_METRIC_COSINE, 1) == 0,
+              "Large k (500 of 5000) matches sort");
+  ASSERT_TRUE(check_topk(7, 16, 7, FASTEMBED_METRIC_DOT, 1) == 0,
+              "k == corpus size returns the whole corpus in order");
+}
+
+/**
+ * Test: Ties are broken towards the lower row index
+ */
+static void test_ties(void) {
+  printf("\n=== Test: Ties ===\n");
+
+  float query[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+  float corpus[6 * 4] = {0};
+  for (int r = 0; r < 6; r++)
+    corpus[r * 4] = r % 2 == 0 ? 1.0f : 0.5f; /* Rows 0, 2, 4 tie */
+  int ids[3];
+  float scores[3];
+
+  ASSERT_EQ_INT(fastembed_topk_threaded(query, corpus, 6, 4, 3, ids, scores,
+                                        FASTEMBED_METRIC_DOT, 1),
+                3);
+  ASSERT_TRUE(ids[0] == 0 && ids[1] == 2 && ids[2] == 4,
+              "Equal scores are ordered by row index");
+}
+
+/**
+ * Test: Threaded search returns the single-threaded results
+ */
+static void test_threaded(void) {
+  printf("\n=== Test: Threaded Top-k ===\n");
+
+  const int nc = 200003, dim = 64, k = 25;
+  float *query = malloc((size_t)dim * sizeof(float));
+  float *corpus = malloc((size_t)nc * dim * sizeof(float));
+  int ids_single[25], ids_threaded[25];
+  float scores_single[25], scores_threaded[25];
+  fill_random(query, dim);
+  fill_random(corpus, (size_t)nc * dim);
+
+  ASSERT_EQ_INT(fastembed_topk(query, corpus, nc, dim, k, ids_single,
+                               scores_single),
+                k);
+
+  const int thread_counts[] = {0, 2, 5};
+  for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+       t++) {
+    int count = fastembed_topk_threaded(query, corpus, nc, dim, k,
+                                        ids_threaded, scores_threaded,
+                                        FASTEMBED_METRIC_COSINE,
+                                        thread_counts[t]);
+    char message[96];
+    snprintf(message, sizeof(message),
+             "%d thread(s) return identical results (0 = all CPUs)",
+             thread_counts[t]);
+    ASSERT_TRUE(count == k &&
+                    memcmp(ids_single, ids_threaded, sizeof(ids_single)) ==
+                        0 &&
+                    memcmp(scores_single, scores_threaded,
+                           sizeof(scores_single)) == 0,
+                message);
+  }
+
+  ASSERT_TRUE(check_topk(100001, 48, 10, FASTEMBED_METRIC_EUCLIDEAN, 4) == 0,
+              "Threaded Euclidean matches sort");
+
+  free(query);
+  free(corpus);
+}
+
+/**
+ * Test: Invalid arguments
+ */
+static void test_invalid_arguments(void) {
+  printf("\n=== Test: Invalid Arguments ===\n");
+
+  float v[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  int ids[2];
+  float scores[2];
+
+  ASSERT_EQ_INT(fastembed_topk(NULL, v, 2, 4, 1, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_topk(v, NULL, 2, 4, 1, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_topk(v, v, 2, 4, 1, NULL, scores), -1);
+  ASSERT_EQ_INT(fastembed_topk(v, v, 2, 4, 1, ids, NULL), -1);
+  ASSERT_EQ_INT(fastembed_topk(v, v, 0, 4, 1, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_topk(v, v, 2, 0, 1, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_topk(v, v, 2, 4, 0, ids, scores), -1);
+  ASSERT_EQ_INT(fastembed_topk_threaded(v, v, 2, 4, 1, ids, scores, 7, 1),
+                -1);
+}
+
+/**
+ * Test: Top-10 over a large corpus (informational)
+ */
+static void test_throughput(void) {
+  printf("\n=== Test: Top-10 Throughput (1M x 384D) ===\n");
+
+  const int nc = 1000000, dim = 384, k = 10;
+  float *query = malloc((size_t)dim * sizeof(float));
+  float *corpus = malloc((size_t)nc * dim * sizeof(float));
+  float *scores = malloc((size_t)nc * sizeof(float));
+  int *order = malloc((size_t)nc * sizeof(int));
+  int ids[10];
+  float top[10];
+  if (!corpus || !scores || !order) {
+    printf("  Skipping: not enough memory\n");
+    free(query);
+    free(corpus);
+    free(scores);
+    free(order);
+    return;
+  }
+  fill_random(query, dim);
+  fill_random(corpus, (size_t)nc * dim);
+
+  double start = wall_seconds();
+  fastembed_similarity_matrix(query, 1, corpus, nc, dim, scores,
+                              FASTEMBED_METRIC_COSINE);
+  for (int i = 0; i < nc; i++)
+    order[i] = i;
+  g_scores = scores;
+  g_ascending = 0;
+  qsort(order, nc, sizeof(int), compare_rank);
+  double sorted = wall_seconds() - start;
+
+  start = wall_seconds();
+  int count = fastembed_topk(query, corpus, nc, dim, k, ids, top);
+  double single = wall_seconds() - start;
+
+  start = wall_seconds();
+  fastembed_topk_threaded(query, corpus, nc, dim, k, ids, top,
+                          FASTEMBED_METRIC_COSINE, 0);
+  double threaded = wall_seconds() - start;
+  double gigabytes = (double)nc * dim * sizeof(float) / 1e9;
+
+  printf("  matrix + full sort: %.1f ms\n", sorted * 1e3);
+  printf("  top-k, 1 thread:    %.1f ms (%.1f GB/s)\n", single * 1e3,
+         gigabytes / single);
+  printf("  top-k, all CPUs:    %.1f ms (%.1f GB/s)\n", threaded * 1e3,
+         gigabytes / threaded);
+  ASSERT_EQ_INT(count, k);
+  int matches = 1;
+  for (int i = 0; i < k; i++)
+    if (fabsf(top[i] - scores[order[i]]) > 1e-5f)
+      matches = 0;
+  ASSERT_TRUE(matches, "Top-10 scores match the full sort");
+
+  free(query);
+  free(corpus);
+  free(scores);
+  free(order);
+}
+
+int main() {
+  printf("FastEmbed Top-k Search Tests\n");
+  printf("============================\n");
+
+  srand(42);
+
+  test_matches_sort();
+  test_ties();
+  test_threaded();
+  test_invalid_arguments();
+  test_throughput();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
@@ -0,0 +1,350 @@
+/**
+ * FastEmbed Vector Kernel Tests
+ *
+ * Tests for the runtime-dispatched vector kernels:
+ * - Test fastembed_get_simd_level() / fastembed_set_simd_level() semantics
+ * - Test dot product, cosine similarity, norm, normalize and add against a
+ *   double-precision reference at every SIMD level the CPU supports
+ * - Test the unit-vector cosine fast path
+ * - Test tail handling for dimensions that are not a multiple of the
+ *   vector width (1-67, odd sizes) as well as common embedding sizes
+ * - Test the dimension-specialized kernels (multiples of 128) on unaligned
+ *   inputs
+ * - Measure dot product and cosine throughput per level and dimension
+ *
+ * Compile: gcc -o test_vector_kernels test_vector_kernels.c -L../build
+ * -lfastembed -lm -I../include Run: LD_LIBRARY_PATH=.. ./test_vector_kernels
+ */
+
+#include "fastembed.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_DIM 4096
+#define GUARD 16
+#define GUARD_VALUE 12345.0f
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+/* Dimensions covering every tail length of the 4/8/16-wide kernels */
+static int g_dims[96];
+static int g_num_dims = 0;
+
+static const char *level_name(int level) {
+  switch (level) {
+  case FASTEMBED_SIMD_SCALAR:
+    return "scalar";
+  case FASTEMBED_SIMD_SSE:
+    return "SSE";
+  case FASTEMBED_SIMD_NEON:
+    return "NEON";
+  case FASTEMBED_SIMD_AVX2:
+    return "AVX2";
+  case FASTEMBED_SIMD_AVX512:
+    return "AVX-512";
+  default:
+    return "unknown";
+  }
+}
+
+static void init_dims(void) {
+  for (int d = 1; d <= 67; d++)
+    g_dims[g_num_dims++] = d;
+  const int extra[] = {127,  128,  129,  255,  256,  383,  384,
+                       511,  512,  640,  768,  1000, 1023, 1024,
+                       1536, 2048, 3968, 4095, 4096};
+  for (size_t i = 0; i < sizeof(extra) / sizeof(extra[0]); i++)
+    g_dims[g_num_dims++] = extra[i];
+}
+
+static void fill_random(float *v, int n) {
+  for (int i = 0; i < n; i++)
+    v[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static int close_enough(double actual, double expected, double scale) {
+  return fabs(actual - expected) <= 1e-4 * (scale > 1.0 ? scale : 1.0);
+}
+
+/**
+ * Check all five operations at the currently installed level
+ *
+ * @return Number of mismatches
+ */
+static int check_kernels(void) {
+  static float a[MAX_DIM + GUARD], b[MAX_DIM + GUARD], r[MAX_DIM + GUARD];
+  static float original[MAX_DIM];
+  int failures = 0;
+
+  for (int t = 0; t < g_num_dims; t++) {
+    int dim = g_dims[t];
+    fill_random(a, dim);
+    fill_random(b, dim);
+    memcpy(original, a, (size_t)dim * sizeof(float));
+
+    double dot = 0.0, sum_a = 0.0, sum_b = 0.0;
+    for (int i = 0; i < dim; i++) {
+      dot += (double)a[i] * b[i];
+      sum_a += (double)a[i] * a[i];
+      sum_b += (double)b[i] * b[i];
+    }
+    double norm_a = sqrt(sum_a), norm_b = sqrt(sum_b);
+    double cosine = dot / (norm_a * norm_b);
+
+    if (!close_enough(fastembed_dot_product(a, b, dim), dot, sqrt(dim))) {
+      printf("    dot mismatch at dim %d\n", dim);
+      failures++;
+    }
+    if (!close_enough(fastembed_cosine_similarity(a, b, dim), cosine, 1.0)) {
+      printf("    cosine mismatch at dim %d\n", dim);
+      failures++;
+    }
+    if (!close_enough(fastembed_vector_norm(a, dim), norm_a, norm_a)) {
+      printf("    norm mismatch at dim %d\n", dim);
+      failures++;
+    }
+
+    /* Add and normalize must not write past dim */
+    for (int i = dim; i < dim + GUARD; i++) {
+      a[i] = GUARD_VALUE;
+      r[i] = GUARD_VALUE;
+    }
+    fastembed_add_vectors(a, b, r, dim);
+    for (int i = 0; i < dim; i++) {
+      if (r[i] != a[i] + b[i]) {
+        printf("    add mismatch at dim %d index %d\n", dim, i);
+        failures++;
+        break;
+      }
+    }
+
+    fastembed_normalize(a, dim);
+    for (int i = 0; i < dim; i++) {
+      if (!close_enough(a[i], original[i] / norm_a, 1.0)) {
+        printf("    normalize mismatch at dim %d index %d\n", dim, i);
+        failures++;
+        break;
+      }
+    }
+
+    /* Unit vectors: the fast path must agree with the full cosine */
+    fastembed_normalize(b, dim);
+    if (!close_enough(fastembed_cosine_similarity_normalized(a, b, dim), cosine,
+                      1.0)) {
+      printf("    normalized cosine mismatch at dim %d\n", dim);
+      failures++;
+    }
+
+    for (int i = dim; i < dim + GUARD; i++) {
+      if (a[i] != GUARD_VALUE || r[i] != GUARD_VALUE) {
+        printf("    write past end at dim %d\n", dim);
+        failures++;
+        break;
+      }
+    }
+  }
+
+  /* Multiples of 128 take the specialized kernels, which must not assume
+   * aligned inputs */
+  const int fixed_dims[] = {128, 256, 384, 768, 1024, 2048};
+  for (size_t t = 0; t < sizeof(fixed_dims) / sizeof(fixed_dims[0]); t++) {
+    int dim = fixed_dims[t];
+    float *ua = a + 1, *ub = b + 3;
+    fill_random(ua, dim);
+    fill_random(ub, dim);
+
+    double dot = 0.0, sum_a = 0.0, sum_b = 0.0;
+    for (int i = 0; i < dim; i++) {
+      dot += (double)ua[i] * ub[i];
+      sum_a += (double)ua[i] * ua[i];
+      sum_b += (double)ub[i] * ub[i];
+    }
+    double norm_a = sqrt(sum_a);
+
+    if (!close_enough(fastembed_dot_product(ua, ub, dim), dot, sqrt(dim)) ||
+        !close_enough(fastembed_cosine_similarity(ua, ub, dim),
+                      dot / (norm_a * sqrt(sum_b)), 1.0) ||
+        !close_enough(fastembed_vector_norm(ua, dim), norm_a, norm_a)) {
+      printf("    unaligned mismatch at dim %d\n", dim);
+      failures++;
+    }
+  }
+
+  /* Zero vectors: cosine is 0 and normalize leaves the input unchanged */
+  float zero[33] = {0};
+  if (fastembed_cosine_similarity(zero, a, 33) != 0.0f) {
+    printf("    cosine of zero vector is not 0\n");
+    failures++;
+  }
+  fastembed_normalize(zero, 33);
+  for (int i = 0; i < 33; i++) {
+    if (zero[i] != 0.0f) {
+      printf("    normalize changed a zero vector\n");
+      failures++;
+      break;
+    }
+  }
+
+  return failures;
+}
+
+/**
+ * Test: Level query and selection
+ */
+static int test_level_selection(void) {
+  printf("\n=== Test: SIMD Level Selection ===\n");
+
+  int best = fastembed_get_simd_level();
+  printf("  Best level: %s (%d)\n", level_name(best), best);
+  ASSERT_TRUE(best >= FASTEMBED_SIMD_SCALAR && best <= FASTEMBED_SIMD_AVX512,
+              "Detected level is a valid fastembed_simd_level_t");
+
+  ASSERT_EQ_INT(fastembed_set_simd_level(-1), -1);
+  ASSERT_EQ_INT(fastembed_set_simd_level(FASTEMBED_SIMD_AVX512 + 1), -1);
+  ASSERT_EQ_INT(fastembed_get_simd_level(), best);
+
+  ASSERT_EQ_INT(fastembed_set_simd_level(FASTEMBED_SIMD_AVX512), best);
+
+  if (best >= FASTEMBED_SIMD_AVX2) {
+    /* x86: levels below AVX2 (and NEON) select the SSE baseline */
+    ASSERT_EQ_INT(fastembed_set_simd_level(FASTEMBED_SIMD_SCALAR),
+                  FASTEMBED_SIMD_SSE);
+    ASSERT_EQ_INT(fastembed_set_simd_level(FASTEMBED_SIMD_NEON),
+                  FASTEMBED_SIMD_SSE);
+    ASSERT_EQ_INT(fastembed_get_simd_level(), FASTEMBED_SIMD_SSE);
+    ASSERT_EQ_INT(fastembed_set_simd_level(FASTEMBED_SIMD_AVX2),
+                  FASTEMBED_SIMD_AVX2);
+    fastembed_set_simd_level(FASTEMBED_SIMD_AVX512);
+  }
+
+  ASSERT_EQ_INT(fastembed_get_simd_level(), best);
+  return best;
+}
+
+/**
+ * Test: Every supported level matches the reference
+ */
+static void test_levels_match_reference(int best) {
+  printf("\n=== Test: Kernels Match Double-Precision Reference ===\n");
+
+  const int levels[] = {FASTEMBED_SIMD_SSE, FASTEMBED_SIMD_AVX2,
+                        FASTEMBED_SIMD_AVX512};
+  int checked = 0;
+
+  for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+    if (best < FASTEMBED_SIMD_SSE || best == FASTEMBED_SIMD_NEON)
+      break; /* Single implementation, checked below */
+    if (levels[i] > best)
+      continue;
+    if (fastembed_set_simd_level(levels[i]) != levels[i])
+      continue;
+
+    char message[96];
+    snprintf(message, sizeof(message), "%s kernels match reference (%d dims)",
+             level_name(levels[i]), g_num_dims);
+    ASSERT_TRUE(check_kernels() == 0, message);
+    checked++;
+  }
+
+  if (checked == 0) {
+    char message[96];
+    snprintf(message, sizeof(message), "%s kernels match reference (%d dims)",
+             level_name(best), g_num_dims);
+    ASSERT_TRUE(check_kernels() == 0, message);
+  }
+
+  fastembed_set_simd_level(FASTEMBED_SIMD_AVX512);
+  ASSERT_EQ_INT(fastembed_get_simd_level(), best);
+}
+
+/**
+ * Test: Dot product and cosine throughput per level (informational)
+ */
+static void test_throughput(int best) {
+  printf("\n=== Test: Similarity Throughput ===\n");
+
+  static float a[2048], b[2048];
+  fill_random(a, 2048);
+  fill_random(b, 2048);
+  const int dims[] = {128, 256, 2048};
+
+  for (int level = FASTEMBED_SIMD_SCALAR; level <= best; level++) {
+    if (fastembed_set_simd_level(level) != level)
+      continue; /* Not available on this CPU / build */
+
+    for (size_t d = 0; d < sizeof(dims) / sizeof(dims[0]); d++) {
+      int dim = dims[d];
+      int iterations = 500000 * (2048 / dim); /* Same floats per dimension */
+
+      volatile float sink = 0.0f;
+      clock_t start = clock();
+      for (int i = 0; i < iterations; i++)
+        sink += fastembed_dot_product(a, b, dim);
+      double dot_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+      start = clock();
+      for (int i = 0; i < iterations; i++)
+        sink += fastembed_cosine_similarity(a, b, dim);
+      double cosine_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+      (void)sink;
+
+      printf("  %-8s %4dD dot %.1f ns/call, cosine %.1f ns/call\n",
+             level_name(level), dim, dot_seconds * 1e9 / iterations,
+             cosine_seconds * 1e9 / iterations);
+    }
+  }
+
+  fastembed_set_simd_level(FASTEMBED_SIMD_AVX512);
+}
+
+int main() {
+  printf("FastEmbed Vector Kernel Tests\n");
+  printf("=============================\n");
+
+  srand(42);
+  init_dims();
+
+  int best = test_level_selection();
+  test_levels_match_reference(best);
+  test_throughput(best);
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}
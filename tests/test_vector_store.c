@@ -0,0 +1,473 @@
+/**
+ * FastEmbed Embedding Store Tests
+ *
+ * Tests for the fastembed_store_* memory-mapped embedding files:
+ * - Test float round-trip over several appends, with and without ids, and
+ *   the FASTEMBED_MATRIX_ALIGNMENT alignment of the mapped vector block
+ * - Test FASTEMBED_STORE_NORMALIZED and FP16 / BF16 stores, with
+ *   fastembed_store_topk() matching fastembed_topk_threaded() /
+ *   fastembed_topk_half()
+ * - Test that mapped vectors feed fastembed_similarity_matrix() and
+ *   fastembed_hnsw_add_batch() directly
+ * - Test empty stores, invalid arguments, and that unfinished, truncated or
+ *   corrupt files are rejected
+ *
+ * Compile: gcc -o test_vector_store test_vector_store.c -L../build
+ * -lfastembed -lm -lpthread -I../include
+ * Run: LD_LIBRARY_PATH=.. ./test_vector_store
+ */
+
+#include "fastembed.h"
+#include "fastembed_config.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int tests_run = 0;
+int tests_passed = 0;
+
+#define ASSERT_EQ_INT(actual, expected)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if ((actual) == (expected)) {                                              \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s == %d\n", #actual, (int)(expected));                \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s (expected %d, got %d)\n", #actual, (int)(expected), \
+             (int)(actual));                                                   \
+    }                                                                          \
+  } while (0)
+
+#define ASSERT_TRUE(condition, message)                                        \
+  do {                                                                         \
+    tests_run++;                                                               \
+    if (condition) {                                                           \
+      tests_passed++;                                                          \
+      printf("  ✓ PASS: %s\n", message);                                      \
+    } else {                                                                   \
+      printf("  ✗ FAIL: %s\n", message);                                      \
+    }                                                                          \
+  } while (0)
+
+#define TEST_FILE "test_vector_store.bin"
+#define DIM 96
+#define ROWS 500
+#define K 10
+
+static float *random_matrix(int rows, int dim) {
+  float *m = (float *)malloc((size_t)rows * dim * sizeof(float));
+  for (int i = 0; i < rows * dim; i++) {
+    m[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+  return m;
+}
+
+/** Write rows [0, ROWS) in three uneven appends */
+static int write_store(const char *path, const float *vectors,
+                       const int64_t *ids, int dtype, int flags) {
+  fastembed_store_writer_t *writer =
+      fastembed_store_writer_open(path, DIM, dtype, flags);
+  if (!writer) {
+    return -1;
+  }
+  const int splits[4] = {0, 1, 317, ROWS};
+  for (int s = 0; s < 3; s++) {
+    int n = splits[s + 1] - splits[s];
+    if (fastembed_store_writer_append(
+            writer, vectors + (size_t)splits[s] * DIM, n,
+            ids ? ids + splits[s] : NULL) != 0) {
+      fastembed_store_writer_close(writer);
+      return -1;
+    }
+  }
+  return fastembed_store_writer_close(writer);
+}
+
+static long file_size(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return -1;
+  }
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fclose(f);
+  return size;
+}
+
+static void test_float_roundtrip(void) {
+  printf("\n=== Test: float round-trip ===\n");
+
+  float *vectors = random_matrix(ROWS, DIM);
+  int64_t ids[ROWS];
+  for (int i = 0; i < ROWS; i++) {
+    ids[i] = (int64_t)1 << 40 | (int64_t)(i * 7);
+  }
+
+  ASSERT_EQ_INT(write_store(TEST_FILE, vectors, ids, FASTEMBED_QUANT_NONE,
+                            FASTEMBED_STORE_IDS),
+                0);
+  fastembed_store_t *store = fastembed_store_open(TEST_FILE);
+  ASSERT_TRUE(store != NULL, "Store with ids opens");
+  if (store) {
+    ASSERT_EQ_INT(fastembed_store_count(store), ROWS);
+    ASSERT_EQ_INT(fastembed_store_dimension(store), DIM);
+    ASSERT_EQ_INT(fastembed_store_dtype(store), FASTEMBED_QUANT_NONE);
+    ASSERT_EQ_INT(fastembed_store_flags(store), FASTEMBED_STORE_IDS);
+
+    const float *mapped = (const float *)fastembed_store_vectors(store);
+    const int64_t *mapped_ids = fastembed_store_ids(store);
+    ASSERT_TRUE(((uintptr_t)mapped % FASTEMBED_MATRIX_ALIGNMENT) == 0,
+                "Vector block is FASTEMBED_MATRIX_ALIGNMENT aligned");
+    ASSERT_TRUE(mapped_ids && ((uintptr_t)mapped_ids % 8) == 0,
+                "Id table is present and aligned");
+    ASSERT_TRUE(memcmp(mapped, vectors, sizeof(float) * ROWS * DIM) == 0,
+                "Vectors round-trip bit-exactly");
+    ASSERT_TRUE(mapped_ids && memcmp(mapped_ids, ids, sizeof(ids)) == 0,
+                "Ids round-trip");
+    fastembed_store_close(store);
+  }
+
+  ASSERT_EQ_INT(write_store(TEST_FILE, vectors, NULL, FASTEMBED_QUANT_NONE,
+                            0),
+                0);
+  ASSERT_EQ_INT((int)file_size(TEST_FILE),
+                128 + (int)(sizeof(float) * ROWS * DIM));
+  store = fastembed_store_open(TEST_FILE);
+  ASSERT_TRUE(store != NULL, "Store without ids opens");
+  if (store) {
+    ASSERT_TRUE(fastembed_store_ids(store) == NULL, "No id table");
+    ASSERT_TRUE(memcmp(fastembed_store_vectors(store), vectors,
+                       sizeof(float) * ROWS * DIM) == 0,
+                "Vectors round-trip without ids");
+    fastembed_store_close(store);
+  }
+
+  free(vectors);
+  remove(TEST_FILE);
+}
+
+static void test_normalized(void) {
+  printf("\n=== Test: FASTEMBED_STORE_NORMALIZED ===\n");
+
+  float *vectors = random_matrix(ROWS, DIM);
+  ASSERT_EQ_INT(write_store(TEST_FILE, vectors, NULL, FASTEMBED_QUANT_NONE,
+                            FASTEMBED_STORE_NORMALIZED),
+                0);
+  fastembed_store_t *store = fastembed_store_open(TEST_FILE);
+  ASSERT_TRUE(store != NULL, "Normalized store opens");
+  if (store) {
+    ASSERT_EQ_INT(fastembed_store_flags(store), FASTEMBED_STORE_NORMALIZED);
+    const float *mapped = (const float *)fastembed_store_vectors(store);
+    float worst = 0.0f;
+    for (int i = 0; i < ROWS; i++) {
+      float norm = fastembed_vector_norm(mapped + (size_t)i * DIM, DIM);
+      if (fabsf(norm - 1.0f) > worst) {
+        worst = fabsf(norm - 1.0f);
+      }
+    }
+    ASSERT_TRUE(worst < 1e-4f, "Every stored row has unit norm");
+
+    /* Dot on the normalized store ranks like cosine on the input */
+    float *query = random_matrix(1, DIM);
+    fastembed_normalize(query, DIM);
+    int ids_a[K], ids_b[K];
+    float scores_a[K], scores_b[K];
+    ASSERT_EQ_INT(fastembed_store_topk(store, query, K, ids_a, scores_a,
+                                       FASTEMBED_METRIC_DOT, 1),
+                  K);
+    ASSERT_EQ_INT(fastembed_topk_threaded(query, vectors, ROWS, DIM, K, ids_b,
+                                          scores_b, FASTEMBED_METRIC_COSINE,
+                                          1),
+                  K);
+    int same = 1;
+    for (int i = 0; i < K; i++) {
+      if (ids_a[i] != ids_b[i] || fabsf(scores_a[i] - scores_b[i]) > 1e-4f) {
+        same = 0;
+      }
+    }
+    ASSERT_TRUE(same, "Dot over the store equals cosine over the input");
+    free(query);
+    fastembed_store_close(store);
+  }
+
+  free(vectors);
+  remove(TEST_FILE);
+}
+
+static void test_half_stores(void) {
+  printf("\n=== Test: FP16 / BF16 stores ===\n");
+
+  float *vectors = random_matrix(ROWS, DIM);
+  float *query = random_matrix(1, DIM);
+  uint16_t *halves = (uint16_t *)malloc(sizeof(uint16_t) * ROWS * DIM);
+  const int formats[2] = {FASTEMBED_QUANT_FP16, FASTEMBED_QUANT_BF16};
+
+  for (int f = 0; f < 2; f++) {
+    int format = formats[f];
+    printf("  format %s\n", format == FASTEMBED_QUANT_FP16 ? "FP16" : "BF16");
+    ASSERT_EQ_INT(write_store(TEST_FILE, vectors, NULL, format, 0), 0);
+    ASSERT_EQ_INT((int)file_size(TEST_FILE),
+                  128 + (int)(sizeof(uint16_t) * ROWS * DIM));
+    if (format == FASTEMBED_QUANT_FP16) {
+      fastembed_f32_to_f16(vectors, halves, ROWS * DIM);
+    } else {
+      fastembed_f32_to_bf16(vectors, halves, ROWS * DIM);
+    }
+
+    fastembed_store_t *store = fastembed_store_open(TEST_FILE);
+    ASSERT_TRUE(store != NULL, "Half-precision store opens");
+    if (!store) {
+      continue;
+    }
+    ASSERT_EQ_INT(fastembed_store_dtype(store), format);
+    ASSERT_TRUE(memcmp(fastembed_store_vectors(store), halves,
+                       sizeof(uint16_t) * ROWS * DIM) == 0,
+                "Rows match the library conversion");
+
+    int ids_a[K], ids_b[K];
+    float scores_a[K], scores_b[K];
+    ASSERT_EQ_INT(fastembed_store_topk(store, query, K, ids_a, scores_a,
+                                       FASTEMBED_METRIC_COSINE, 0),
+                  K);
+    ASSERT_EQ_INT(fastembed_topk_half(query, halves, format, ROWS, DIM, K,
+                                      ids_b, scores_b,
+                                      FASTEMBED_METRIC_COSINE, 1),
+                  K);
+    ASSERT_TRUE(memcmp(ids_a, ids_b, sizeof(ids_a)) == 0 &&
+                    memcmp(scores_a, scores_b, sizeof(scores_a)) == 0,
+                "fastembed_store_topk() matches fastembed_topk_half()");
+    fastembed_store_close(store);
+  }
+
+  free(halves);
+  free(query);
+  free(vectors);
+  remove(TEST_FILE);
+}
+
+static void test_feeds_kernels(void) {
+  printf("\n=== Test: mapped vectors feed the search kernels ===\n");
+
+  float *vectors = random_matrix(ROWS, DIM);
+  float *queries = random_matrix(4, DIM);
+  ASSERT_EQ_INT(write_store(TEST_FILE, vectors, NULL, FASTEMBED_QUANT_NONE,
+                            FASTEMBED_STORE_NORMALIZED),
+                0);
+  fastembed_store_t *store = fastembed_store_open(TEST_FILE);
+  ASSERT_TRUE(store != NULL, "Store opens");
+  if (!store) {
+    free(queries);
+    free(vectors);
+    return;
+  }
+  const float *mapped = (const float *)fastembed_store_vectors(store);
+
+  /* Similarity matrix straight from the mapping */
+  float *out = (float *)malloc(sizeof(float) * 4 * ROWS);
+  ASSERT_EQ_INT(fastembed_similarity_matrix(queries, 4, mapped, ROWS, DIM, out,
+                                            FASTEMBED_METRIC_DOT),
+                0);
+  float worst = 0.0f;
+  for (int q = 0; q < 4; q++) {
+    for (int r = 0; r < ROWS; r += 37) {
+      float expected = fastembed_dot_product(
+          queries + (size_t)q * DIM, mapped + (size_t)r * DIM, DIM);
+      float diff = fabsf(out[(size_t)q * ROWS + r] - expected);
+      if (diff > worst) {
+        worst = diff;
+      }
+    }
+  }
+  ASSERT_TRUE(worst < 1e-4f, "Similarity matrix over the mapped rows");
+  free(out);
+
+  /* HNSW built from the mapping finds exact neighbours */
+  fastembed_hnsw_options_t options;
+  fastembed_hnsw_options_init(&options);
+  options.metric = FASTEMBED_METRIC_DOT;
+  options.seed = 7;
+  fastembed_hnsw_t *index = fastembed_hnsw_create(DIM, &options);
+  ASSERT_TRUE(index != NULL, "HNSW index created");
+  if (index) {
+    ASSERT_EQ_INT(fastembed_hnsw_add_batch(index, mapped, ROWS, NULL, 1), 0);
+    ASSERT_EQ_INT(fastembed_hnsw_size(index), ROWS);
+    int ids[K];
+    float scores[K];
+    fastembed_hnsw_set_ef_search(index, ROWS);
+    ASSERT_EQ_INT(fastembed_hnsw_search(index, mapped + 42 * DIM, K, ids,
+                                        scores),
+                  K);
+    ASSERT_EQ_INT(ids[0], 42);
+    fastembed_hnsw_free(index);
+  }
+
+  fastembed_store_close(store);
+  free(queries);
+  free(vectors);
+  remove(TEST_FILE);
+}
+
+static void test_empty_store(void) {
+  printf("\n=== Test: empty store ===\n");
+
+  fastembed_store_writer_t *writer = fastembed_store_writer_open(
+      TEST_FILE, DIM, FASTEMBED_QUANT_NONE, FASTEMBED_STORE_IDS);
+  ASSERT_TRUE(writer != NULL, "Writer opens");
+  ASSERT_EQ_INT(fastembed_store_writer_append(writer, NULL, 0, NULL), 0);
+  ASSERT_EQ_INT(fastembed_store_writer_close(writer), 0);
+
+  fastembed_store_t *store = fastembed_store_open(TEST_FILE);
+  ASSERT_TRUE(store != NULL, "Empty store opens");
+  if (store) {
+    ASSERT_EQ_INT(fastembed_store_count(store), 0);
+    ASSERT_EQ_INT(fastembed_store_dimension(store), DIM);
+    fastembed_store_close(store);
+  }
+  remove(TEST_FILE);
+}
+
+/** Rewrite a file with a byte changed or its tail cut off */
+static void damage_file(const char *path, long offset, long keep) {
+  long size = file_size(path);
+  unsigned char *data = (unsigned char *)malloc((size_t)size);
+  FILE *f = fopen(path, "rb");
+  size_t n = fread(data, 1, (size_t)size, f);
+  fclose(f);
+  if (offset >= 0) {
+    data[offset] ^= 0xFF;
+  }
+  f = fopen(path, "wb");
+  fwrite(data, 1, keep >= 0 ? (size_t)keep : n, f);
+  fclose(f);
+  free(data);
+}
+
+static void test_rejects_bad_files(void) {
+  printf("\n=== Test: unfinished, truncated and corrupt files ===\n");
+
+  float *vectors = random_matrix(ROWS, DIM);
+  int64_t ids[ROWS];
+  for (int i = 0; i < ROWS; i++) {
+    ids[i] = i;
+  }
+
+  ASSERT_TRUE(fastembed_store_open("nonexistent_store.bin") == NULL,
+              "Missing file rejected");
+
+  /* Writer still open: placeholder header only */
+  fastembed_store_writer_t *writer =
+      fastembed_store_writer_open(TEST_FILE, DIM, FASTEMBED_QUANT_NONE, 0);
+  fastembed_store_writer_append(writer, vectors, ROWS, NULL);
+  FILE *peek = fopen(TEST_FILE, "rb");
+  ASSERT_TRUE(peek != NULL, "File exists while writing");
+  if (peek) {
+    fclose(peek);
+  }
+  ASSERT_TRUE(fastembed_store_open(TEST_FILE) == NULL,
+              "Unfinished file rejected");
+  ASSERT_EQ_INT(fastembed_store_writer_close(writer), 0);
+
+  long size = (long)file_size(TEST_FILE);
+  damage_file(TEST_FILE, -1, size - 4);
+  ASSERT_TRUE(fastembed_store_open(TEST_FILE) == NULL,
+              "Truncated file rejected");
+
+  ASSERT_EQ_INT(write_store(TEST_FILE, vectors, ids, FASTEMBED_QUANT_NONE,
+                            FASTEMBED_STORE_IDS),
+                0);
+  damage_file(TEST_FILE, 0, -1);
+  ASSERT_TRUE(fastembed_store_open(TEST_FILE) == NULL, "Bad magic rejected");
+
+  ASSERT_EQ_INT(write_store(TEST_FILE, vectors, ids, FASTEMBED_QUANT_NONE,
+                            FASTEMBED_STORE_IDS),
+                0);
+  damage_file(TEST_FILE, 20, -1); /* dtype */
+  ASSERT_TRUE(fastembed_store_open(TEST_FILE) == NULL, "Bad dtype rejected");
+
+  damage_file(TEST_FILE, -1, 64);
+  ASSERT_TRUE(fastembed_store_open(TEST_FILE) == NULL,
+              "File shorter than the header rejected");
+
+  free(vectors);
+  remove(TEST_FILE);
+}
+
+static void test_invalid_arguments(void) {
+  printf("\n=== Test: invalid arguments ===\n");
+
+  float vector[DIM] = {1.0f};
+  ASSERT_TRUE(fastembed_store_writer_open(NULL, DIM, FASTEMBED_QUANT_NONE,
+                                          0) == NULL,
+              "NULL path rejected");
+  ASSERT_TRUE(fastembed_store_writer_open(TEST_FILE, 0, FASTEMBED_QUANT_NONE,
+                                          0) == NULL,
+              "Zero dimension rejected");
+  ASSERT_TRUE(fastembed_store_writer_open(TEST_FILE, DIM,
+                                          FASTEMBED_QUANT_INT8, 0) == NULL,
+              "INT8 dtype rejected");
+  ASSERT_TRUE(fastembed_store_writer_open(TEST_FILE, DIM, FASTEMBED_QUANT_NONE,
+                                          0x100) == NULL,
+              "Unknown flag rejected");
+
+  ASSERT_EQ_INT(fastembed_store_writer_append(NULL, vector, 1, NULL), -1);
+  ASSERT_EQ_INT(fastembed_store_writer_close(NULL), -1);
+
+  /* Rejected appends write nothing; the writer stays usable */
+  fastembed_store_writer_t *writer = fastembed_store_writer_open(
+      TEST_FILE, DIM, FASTEMBED_QUANT_FP16, FASTEMBED_STORE_IDS);
+  ASSERT_TRUE(writer != NULL, "Writer opens");
+  int64_t id = 5;
+  ASSERT_EQ_INT(fastembed_store_writer_append(writer, vector, 1, NULL), -1);
+  ASSERT_EQ_INT(fastembed_store_writer_append(writer, NULL, 1, &id), -1);
+  ASSERT_EQ_INT(fastembed_store_writer_append(writer, vector, -1, &id), -1);
+  ASSERT_EQ_INT(fastembed_store_writer_append(writer, vector, 1, &id), 0);
+  ASSERT_EQ_INT(fastembed_store_writer_close(writer), 0);
+  fastembed_store_t *store = fastembed_store_open(TEST_FILE);
+  ASSERT_TRUE(store && fastembed_store_count(store) == 1 &&
+                  fastembed_store_ids(store)[0] == 5,
+              "Only the valid append was stored");
+  fastembed_store_close(store);
+  remove(TEST_FILE);
+
+  ASSERT_EQ_INT(fastembed_store_count(NULL), -1);
+  ASSERT_EQ_INT(fastembed_store_dimension(NULL), -1);
+  ASSERT_EQ_INT(fastembed_store_dtype(NULL), -1);
+  ASSERT_EQ_INT(fastembed_store_flags(NULL), -1);
+  ASSERT_TRUE(fastembed_store_vectors(NULL) == NULL, "NULL store vectors");
+  ASSERT_TRUE(fastembed_store_ids(NULL) == NULL, "NULL store ids");
+  int out_id;
+  float out_score;
+  ASSERT_EQ_INT(fastembed_store_topk(NULL, vector, 1, &out_id, &out_score,
+                                     FASTEMBED_METRIC_COSINE, 1),
+                -1);
+  fastembed_store_close(NULL);
+}
+
+int main() {
+  printf("FastEmbed Embedding Store Tests\n");
+  printf("===============================\n");
+
+  srand(42);
+  test_float_roundtrip();
+  test_normalized();
+  test_half_stores();
+  test_feeds_kernels();
+  test_empty_store();
+  test_rejects_bad_files();
+  test_invalid_arguments();
+
+  printf("\n=== Test Summary ===\n");
+  printf("Tests run: %d\n", tests_run);
+  printf("Tests passed: %d\n", tests_passed);
+  printf("Tests failed: %d\n", tests_run - tests_passed);
+
+  if (tests_passed == tests_run) {
+    printf("\n✓ All tests passed!\n");
+    return 0;
+  } else {
+    printf("\n✗ Some tests failed\n");
+    return 1;
+  }
+}